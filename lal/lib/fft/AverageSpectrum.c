@@ -30,6 +30,7 @@
 #include <lal/Units.h>
 #include <lal/Window.h>
 #include <lal/Date.h>
+#include <lal/TimeSeries.h>
 
 static COMPLEX16 cabs2(COMPLEX16 z)
 {
@@ -1898,6 +1899,468 @@ int XLALPSDRegressorSetPSD(LALPSDRegressor *r, const REAL8FrequencySeries *psd,
 }
 
 
+/*
+ *
+ * Streaming spectrum estimation
+ *
+ */
+
+
+/** Internal state of a LALStreamingPSD object. */
+struct tagLALStreamingPSD
+{
+  UINT4 seglen;                 /* length of each segment */
+  UINT4 stride;                 /* offset of each segment from the previous */
+  UINT4 numseg;                 /* number of most recent segments averaged */
+  REAL8Window *window;          /* copy of the window, or NULL */
+  REAL8FFTPlan *plan;           /* forward plan of length seglen */
+  int started;                  /* has any data been added since reset? */
+  LIGOTimeGPS next;             /* expected epoch of the next input sample */
+  REAL8TimeSeries *segment;     /* the segment being accumulated */
+  UINT4 fill;                   /* number of samples in segment */
+  UINT4 skip;                   /* samples to discard before the next segment */
+  REAL8FrequencySeries *work;   /* the newest periodogram */
+  REAL8Sequence **ring;         /* periodograms, oldest at ring[head] */
+  LIGOTimeGPS *epochs;          /* start times of the periodograms in ring */
+  UINT4 head;
+  UINT4 count;                  /* number of periodograms in ring */
+  UINT8 total;                  /* number of periodograms since reset */
+  REAL8Sequence *sum;           /* sum of the periodograms in ring, by bin */
+  UINT4 adds_since_sum;         /* updates of sum since it was recomputed */
+  REAL8 *sorted[2];             /* sorted bin values of the even/odd periodograms */
+  UINT4 nsorted[2];             /* number of even/odd periodograms in ring */
+  UINT4 maxsorted;              /* room for this many values per bin in sorted */
+};
+
+
+/* position of the first value in sorted array a of length n that is not
+ * less than (upper = 0) or greater than (upper = 1) x */
+static UINT4 streaming_psd_bisect( const REAL8 *a, UINT4 n, REAL8 x, int upper )
+{
+  UINT4 lo = 0;
+  while ( n > 0 )
+  {
+    UINT4 half = n / 2;
+    if ( upper ? a[lo + half] <= x : a[lo + half] < x )
+    {
+      lo += half + 1;
+      n -= half + 1;
+    }
+    else
+      n = half;
+  }
+  return lo;
+}
+
+/* the k-th smallest (from 0) of the values in sorted arrays a and b */
+static REAL8 streaming_psd_select( const REAL8 *a, UINT4 na, const REAL8 *b, UINT4 nb, UINT4 k )
+{
+  UINT4 i = 0;
+  UINT4 j = 0;
+  for ( ; k > 0; --k )
+    if ( j >= nb || ( i < na && a[i] <= b[j] ) )
+      ++i;
+    else
+      ++j;
+  return ( j >= nb || ( i < na && a[i] <= b[j] ) ) ? a[i] : b[j];
+}
+
+/* median of the values in the sorted arrays a and b */
+static REAL8 streaming_psd_median( const REAL8 *a, UINT4 na, const REAL8 *b, UINT4 nb )
+{
+  UINT4 n = na + nb;
+  if ( n % 2 )
+    return streaming_psd_select( a, na, b, nb, n/2 );
+  return 0.5*(streaming_psd_select( a, na, b, nb, n/2 - 1 ) + streaming_psd_select( a, na, b, nb, n/2 ));
+}
+
+/* drop the oldest periodogram from the ring */
+static void streaming_psd_evict( LALStreamingPSD *s )
+{
+  const REAL8Sequence *oldest = s->ring[s->head];
+  const int parity = ( s->total - s->count ) & 1;
+  const UINT4 n = s->nsorted[parity];
+  UINT4 k;
+
+  for ( k = 0; k < oldest->length; ++k )
+  {
+    REAL8 *a = s->sorted[parity] + k * s->maxsorted;
+    UINT4 i = streaming_psd_bisect( a, n, oldest->data[k], 0 );
+    memmove( a + i, a + i + 1, ( n - i - 1 ) * sizeof( *a ) );
+    s->sum->data[k] -= oldest->data[k];
+  }
+
+  s->nsorted[parity]--;
+  s->head = ( s->head + 1 ) % s->numseg;
+  s->count--;
+}
+
+/* append the periodogram in work to the ring */
+static void streaming_psd_push( LALStreamingPSD *s )
+{
+  const REAL8Sequence *newest = s->work->data;
+  const int parity = s->total & 1;
+  UINT4 n;
+  UINT4 slot;
+  UINT4 k;
+
+  if ( s->count == s->numseg )
+    streaming_psd_evict( s );
+
+  n = s->nsorted[parity];
+  slot = ( s->head + s->count ) % s->numseg;
+  memcpy( s->ring[slot]->data, newest->data, newest->length * sizeof( *newest->data ) );
+  s->epochs[slot] = s->work->epoch;
+
+  for ( k = 0; k < newest->length; ++k )
+  {
+    REAL8 *a = s->sorted[parity] + k * s->maxsorted;
+    UINT4 i = streaming_psd_bisect( a, n, newest->data[k], 1 );
+    memmove( a + i + 1, a + i, ( n - i ) * sizeof( *a ) );
+    a[i] = newest->data[k];
+    s->sum->data[k] += newest->data[k];
+  }
+
+  s->nsorted[parity]++;
+  s->count++;
+  s->total++;
+
+  /* the running sum picks up round-off each time a periodogram is
+   * removed from it, so recompute it from scratch every numseg updates */
+  if ( ++s->adds_since_sum >= s->numseg )
+  {
+    UINT4 i;
+    memset( s->sum->data, 0, s->sum->length * sizeof( *s->sum->data ) );
+    for ( i = 0; i < s->count; ++i )
+      for ( k = 0; k < s->sum->length; ++k )
+        s->sum->data[k] += s->ring[( s->head + i ) % s->numseg]->data[k];
+    s->adds_since_sum = 0;
+  }
+}
+
+/* copy the metadata of the spectrum estimate */
+static int streaming_psd_metadata( REAL8FrequencySeries *spectrum, const LALStreamingPSD *s )
+{
+  if ( ! spectrum || ! s )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! spectrum->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( spectrum->data->length != s->seglen/2 + 1 )
+    XLAL_ERROR( XLAL_EBADLEN );
+  if ( ! s->count )
+  {
+    XLALPrintError( "%s(): no segments have been analyzed\n", __func__ );
+    XLAL_ERROR( XLAL_EDATA );
+  }
+
+  spectrum->epoch       = s->epochs[s->head];
+  spectrum->f0          = s->work->f0;
+  spectrum->deltaF      = s->work->deltaF;
+  spectrum->sampleUnits = s->work->sampleUnits;
+
+  return 0;
+}
+
+
+/**
+ * Allocate and initialize a LALStreamingPSD object.
+ *
+ * The LALStreamingPSD object computes the same Welch, median and
+ * median-mean spectrum estimates as XLALREAL8AverageSpectrumWelch(),
+ * XLALREAL8AverageSpectrumMedian() and XLALREAL8AverageSpectrumMedianMean()
+ * do, but for data that arrives a little at a time.  Samples are added to
+ * the object with XLALStreamingPSDAdd().  Each time a segment of seglen
+ * samples is complete its modified periodogram is computed and stored,
+ * and the next segment starts stride samples later;  the periodograms of
+ * the numseg most recent segments are retained.  The spectrum estimates
+ * returned by XLALStreamingPSDGetWelch(), XLALStreamingPSDGetMedian() and
+ * XLALStreamingPSDGetMedianMean() are those of the retained segments,
+ * i.e., once numseg segments are available they are what the batch
+ * functions would compute from the most recent (numseg - 1) * stride +
+ * seglen samples, up to round-off in the Welch estimate.
+ *
+ * Each periodogram is computed only once, and the running sums and the
+ * sorted values of each frequency bin are updated as segments enter and
+ * leave the average, so the cost of updating the estimate does not grow
+ * with the length of the data that has been seen.
+ *
+ * The window may be NULL, in which case no window is applied.  A copy of
+ * the window is made, this function does not take ownership of it.
+ */
+LALStreamingPSD *XLALStreamingPSDNew(UINT4 seglen, UINT4 stride, UINT4 numseg, const REAL8Window *window)
+{
+  LALStreamingPSD *new;
+  UINT4 nbins = seglen/2 + 1;
+  UINT4 i;
+
+  if ( seglen < 1 || stride < 1 || numseg < 1 )
+    XLAL_ERROR_NULL( XLAL_EINVAL );
+  if ( window && ( ! window->data || window->data->length != seglen ) )
+    XLAL_ERROR_NULL( XLAL_EBADLEN );
+
+  new = XLALCalloc( 1, sizeof( *new ) );
+  if ( ! new )
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+
+  new->seglen = seglen;
+  new->stride = stride;
+  new->numseg = numseg;
+  new->maxsorted = ( numseg + 1 )/2;
+
+  if ( window )
+  {
+    REAL8Sequence *data = XLALCopyREAL8Sequence( window->data );
+    if ( data )
+    {
+      new->window = XLALMalloc( sizeof( *new->window ) );
+      if ( new->window )
+      {
+        new->window->data = data;
+        new->window->sumofsquares = window->sumofsquares;
+        new->window->sum = window->sum;
+      }
+      else
+        XLALDestroyREAL8Sequence( data );
+    }
+  }
+  new->plan = XLALCreateForwardREAL8FFTPlan( seglen, 0 );
+  new->segment = XLALCreateREAL8TimeSeries( "segment", &new->next, 0.0, 1.0, &lalDimensionlessUnit, seglen );
+  new->work = XLALCreateREAL8FrequencySeries( "periodogram", &new->next, 0.0, 0.0, &lalDimensionlessUnit, nbins );
+  new->ring = XLALCalloc( numseg, sizeof( *new->ring ) );
+  new->epochs = XLALCalloc( numseg, sizeof( *new->epochs ) );
+  new->sum = XLALCreateREAL8Sequence( nbins );
+  new->sorted[0] = XLALMalloc( nbins * new->maxsorted * sizeof( *new->sorted[0] ) );
+  new->sorted[1] = XLALMalloc( nbins * new->maxsorted * sizeof( *new->sorted[1] ) );
+  if ( ( window && ! new->window ) || ! new->plan || ! new->segment || ! new->work || ! new->ring || ! new->epochs || ! new->sum || ! new->sorted[0] || ! new->sorted[1] )
+  {
+    XLALStreamingPSDFree( new );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  for ( i = 0; i < numseg; ++i )
+  {
+    new->ring[i] = XLALCreateREAL8Sequence( nbins );
+    if ( ! new->ring[i] )
+    {
+      XLALStreamingPSDFree( new );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+  }
+
+  XLALStreamingPSDReset( new );
+
+  return new;
+}
+
+/**
+ * Free all memory associated with a LALStreamingPSD object.  The object
+ * must not be used again after calling this function.
+ */
+void XLALStreamingPSDFree(LALStreamingPSD *s)
+{
+  if ( s )
+  {
+    if ( s->ring )
+    {
+      UINT4 i;
+      for ( i = 0; i < s->numseg; ++i )
+        XLALDestroyREAL8Sequence( s->ring[i] );
+    }
+    XLALFree( s->ring );
+    XLALFree( s->epochs );
+    XLALFree( s->sorted[0] );
+    XLALFree( s->sorted[1] );
+    XLALDestroyREAL8Sequence( s->sum );
+    XLALDestroyREAL8FrequencySeries( s->work );
+    XLALDestroyREAL8TimeSeries( s->segment );
+    if ( s->plan )
+      XLALDestroyREAL8FFTPlan( s->plan );
+    XLALDestroyREAL8Window( s->window );
+  }
+  XLALFree( s );
+}
+
+/**
+ * Reset a LALStreamingPSD object to the newly-allocated state, discarding
+ * all periodograms and any partially accumulated segment.  The next call
+ * to XLALStreamingPSDAdd() may supply data with any start time and sample
+ * rate.
+ */
+void XLALStreamingPSDReset(LALStreamingPSD *s)
+{
+  s->started = 0;
+  s->fill = 0;
+  s->skip = 0;
+  s->head = 0;
+  s->count = 0;
+  s->total = 0;
+  s->adds_since_sum = 0;
+  s->nsorted[0] = s->nsorted[1] = 0;
+  memset( s->sum->data, 0, s->sum->length * sizeof( *s->sum->data ) );
+}
+
+/**
+ * Add samples to a LALStreamingPSD object, and compute the periodograms of
+ * the segments they complete.  The time series must follow on from the
+ * data added previously without a gap and have the same sample interval;
+ * to start over, e.g. after a gap in the data, call
+ * XLALStreamingPSDReset() first.  The time series may be of any length.
+ */
+int XLALStreamingPSDAdd(LALStreamingPSD *s, const REAL8TimeSeries *tseries)
+{
+  UINT4 i = 0;
+
+  if ( ! s || ! tseries )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! tseries->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( tseries->deltaT <= 0.0 )
+    XLAL_ERROR( XLAL_EINVAL );
+
+  if ( ! s->started )
+  {
+    s->segment->deltaT = tseries->deltaT;
+    s->segment->f0 = tseries->f0;
+    s->segment->sampleUnits = tseries->sampleUnits;
+    s->next = tseries->epoch;
+    s->started = 1;
+  }
+  else if ( tseries->deltaT != s->segment->deltaT || fabs( XLALGPSDiff( &tseries->epoch, &s->next ) ) > 0.5 * s->segment->deltaT )
+  {
+    XLALPrintError( "%s(): input does not follow on from previous data\n", __func__ );
+    XLAL_ERROR( XLAL_EDATA );
+  }
+
+  while ( i < tseries->data->length )
+  {
+    UINT4 n;
+
+    /* discard samples between segments */
+    if ( s->skip )
+    {
+      n = tseries->data->length - i < s->skip ? tseries->data->length - i : s->skip;
+      s->skip -= n;
+      i += n;
+      continue;
+    }
+
+    /* append samples to the segment */
+    if ( ! s->fill )
+    {
+      s->segment->epoch = tseries->epoch;
+      XLALGPSAdd( &s->segment->epoch, i * tseries->deltaT );
+    }
+    n = tseries->data->length - i < s->seglen - s->fill ? tseries->data->length - i : s->seglen - s->fill;
+    memcpy( s->segment->data->data + s->fill, tseries->data->data + i, n * sizeof( *tseries->data->data ) );
+    s->fill += n;
+    i += n;
+
+    if ( s->fill < s->seglen )
+      break;
+
+    /* the segment is complete:  compute its periodogram and add it to the
+     * average */
+    if ( XLALREAL8ModifiedPeriodogram( s->work, s->segment, s->window, s->plan ) == XLAL_FAILURE )
+      XLAL_ERROR( XLAL_EFUNC );
+    streaming_psd_push( s );
+
+    /* start the next segment */
+    if ( s->stride < s->seglen )
+    {
+      memmove( s->segment->data->data, s->segment->data->data + s->stride, ( s->seglen - s->stride ) * sizeof( *s->segment->data->data ) );
+      s->fill = s->seglen - s->stride;
+      XLALGPSAdd( &s->segment->epoch, s->stride * s->segment->deltaT );
+    }
+    else
+    {
+      s->fill = 0;
+      s->skip = s->stride - s->seglen;
+    }
+  }
+
+  s->next = tseries->epoch;
+  XLALGPSAdd( &s->next, tseries->data->length * tseries->deltaT );
+
+  return 0;
+}
+
+/**
+ * Return the number of periodograms currently contributing to the
+ * spectrum estimates of a LALStreamingPSD object.  This counts the
+ * segments completed since the object was reset, up to numseg.
+ */
+UINT4 XLALStreamingPSDGetNumSegments(const LALStreamingPSD *s)
+{
+  return s->count;
+}
+
+/**
+ * Compute the Welch (mean) spectrum estimate from the periodograms held by
+ * a LALStreamingPSD object.  The epoch of the result is the start of the
+ * oldest segment.
+ */
+int XLALStreamingPSDGetWelch(REAL8FrequencySeries *spectrum, const LALStreamingPSD *s)
+{
+  UINT4 k;
+
+  if ( streaming_psd_metadata( spectrum, s ) )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  for ( k = 0; k < spectrum->data->length; ++k )
+    spectrum->data->data[k] = s->sum->data[k] / s->count;
+
+  return 0;
+}
+
+/**
+ * Compute the median spectrum estimate from the periodograms held by a
+ * LALStreamingPSD object, corrected for the median bias.  The epoch of
+ * the result is the start of the oldest segment.
+ */
+int XLALStreamingPSDGetMedian(REAL8FrequencySeries *spectrum, const LALStreamingPSD *s)
+{
+  REAL8 normfac;
+  UINT4 k;
+
+  if ( streaming_psd_metadata( spectrum, s ) )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  normfac = 1.0 / XLALMedianBias( s->count );
+
+  for ( k = 0; k < spectrum->data->length; ++k )
+    spectrum->data->data[k] = normfac * streaming_psd_median( s->sorted[0] + k * s->maxsorted, s->nsorted[0], s->sorted[1] + k * s->maxsorted, s->nsorted[1] );
+
+  return 0;
+}
+
+/**
+ * Compute the median-mean spectrum estimate from the periodograms held by
+ * a LALStreamingPSD object.  As for XLALREAL8AverageSpectrumMedianMean(),
+ * the number of periodograms must be even and the stride must be at least
+ * half the segment length.  The epoch of the result is the start of the
+ * oldest segment.
+ */
+int XLALStreamingPSDGetMedianMean(REAL8FrequencySeries *spectrum, const LALStreamingPSD *s)
+{
+  REAL8 normfac;
+  UINT4 k;
+
+  if ( streaming_psd_metadata( spectrum, s ) )
+    XLAL_ERROR( XLAL_EFUNC );
+  if ( s->count % 2 || s->stride < s->seglen/2 )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  /* the even and odd periodograms alternate, so half of those in the ring
+   * are in each of the sorted sets;  the factor of two is from averaging
+   * the two medians */
+  normfac = 1.0 / ( 2.0 * XLALMedianBias( s->count/2 ) );
+
+  for ( k = 0; k < spectrum->data->length; ++k )
+    spectrum->data->data[k] = normfac * ( streaming_psd_median( s->sorted[0] + k * s->maxsorted, s->nsorted[0], NULL, 0 ) + streaming_psd_median( s->sorted[1] + k * s->maxsorted, s->nsorted[1], NULL, 0 ) );
+
+  return 0;
+}
+
+
 /**
  * Compute the two-point spectral correlation function for a whitened
  * frequency series from the window applied to the original time series.
@@ -186,6 +186,12 @@ tagLALPSDRegressor
 }
 LALPSDRegressor;
 
+/**
+ * Incrementally updated Welch, median and median-mean spectrum estimator;
+ * see XLALStreamingPSDNew().
+ */
+typedef struct tagLALStreamingPSD LALStreamingPSD;
+
 /*
  *
  * XLAL Functions
@@ -410,6 +416,49 @@ XLALPSDRegressorSetPSD(
     unsigned weight
 );
 
+LALStreamingPSD *
+XLALStreamingPSDNew(
+    UINT4 seglen,
+    UINT4 stride,
+    UINT4 numseg,
+    const REAL8Window *window
+);
+
+void
+XLALStreamingPSDFree(
+    LALStreamingPSD *s
+);
+
+void
+XLALStreamingPSDReset(
+    LALStreamingPSD *s
+);
+
+int
+XLALStreamingPSDAdd(
+    LALStreamingPSD *s,
+    const REAL8TimeSeries *tseries
+);
+
+UINT4 XLALStreamingPSDGetNumSegments(
+    const LALStreamingPSD *s
+);
+
+int XLALStreamingPSDGetWelch(
+    REAL8FrequencySeries *spectrum,
+    const LALStreamingPSD *s
+);
+
+int XLALStreamingPSDGetMedian(
+    REAL8FrequencySeries *spectrum,
+    const LALStreamingPSD *s
+);
+
+int XLALStreamingPSDGetMedianMean(
+    REAL8FrequencySeries *spectrum,
+    const LALStreamingPSD *s
+);
+
 
 /** @} */
 
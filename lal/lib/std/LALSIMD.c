@@ -87,6 +87,7 @@ static const char *const iset_names[LAL_SIMD_ISET_MAX] = {
   [LAL_SIMD_ISET_SSE4_2]	= "SSE4.2",
   [LAL_SIMD_ISET_AVX]		= "AVX",
   [LAL_SIMD_ISET_AVX2]		= "AVX2",
+  [LAL_SIMD_ISET_AVX512F]	= "AVX512F",
 };
 
 /* pthread locking to make SIMD detection thread-safe */
@@ -224,6 +225,7 @@ static LAL_SIMD_ISET detect_instruction_set(void) {
   if ((abcd[2] & (1 << 28)) == 0) return iset;		/* no AVX */
   iset = LAL_SIMD_ISET_AVX;				/* AVX detected */
 
+  if ((abcd[2] & (1 << 12)) == 0) return iset;		/* no FMA */
 #if HAVE_X86 && defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
   /* GCC's __get_cpuid() fails to detect AVX2, see bug report at https://gcc.gnu.org/bugzilla/show_bug.cgi?id=77756 */
   if (!__builtin_cpu_supports("avx2")) return iset;	/* no AVX2 */
@@ -233,6 +235,15 @@ static LAL_SIMD_ISET detect_instruction_set(void) {
 #endif
   iset = LAL_SIMD_ISET_AVX2;				/* AVX2 detected */
 
+  if ((xgetbv(0) & 0xE6) != 0xE6) return iset;		/* AVX-512 not enabled in O.S. */
+#if HAVE_X86 && defined(__GNUC__) && (__GNUC__ >= 5)
+  if (!__builtin_cpu_supports("avx512f")) return iset;	/* no AVX512F */
+#else
+  cpuid(abcd, 7);					/* call cpuid function 7 for feature flags */
+  if ((abcd[1] & (1 << 16)) == 0) return iset;		/* no AVX512F */
+#endif
+  iset = LAL_SIMD_ISET_AVX512F;				/* AVX512F detected */
+
   return iset;
 
 }
@@ -105,6 +105,72 @@ LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4InitEighthOrderInstead(i
     return integrator;
 }
 
+/* Workspace of the Dormand-Prince integrator */
+struct tagLALAdaptiveRungeKuttaDPWorkspace {
+    REAL8 eps_abs;              /* absolute error tolerance */
+    REAL8 eps_rel;              /* relative error tolerance */
+    REAL8 *work;                /* single block holding all vectors below */
+    REAL8 *k[7];                /* stage derivatives; k[6] is the derivative at the end of the step */
+    REAL8 *y;                   /* current state */
+    REAL8 *ytmp;                /* state at the end of the trial step */
+    REAL8 *yerr;                /* error estimate of the trial step */
+    REAL8 *rcont;               /* 5 x dim coefficients of the dense output polynomial */
+    REAL8Array *buffer;         /* (dim+1) x bufferlength output buffer */
+    size_t bufferlength;
+};
+
+LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKuttaDormandPrinceInit(int dim, int (*dydt) (double t, const double y[], double dydt[], void *params),   /* These are XLAL functions! */
+    int (*stop) (double t, const double y[], double dydt[], void *params), double eps_abs, double eps_rel)
+{
+    LALAdaptiveRungeKuttaIntegrator *integrator;
+    struct tagLALAdaptiveRungeKuttaDPWorkspace *ws;
+
+    if (dim <= 0 || !dydt || eps_abs < 0 || eps_rel < 0 || (eps_abs == 0 && eps_rel == 0)) {
+        XLAL_ERROR_NULL(XLAL_EINVAL);
+    }
+
+    /* allocate our custom integrator structure */
+    if (!(integrator = (LALAdaptiveRungeKuttaIntegrator *) LALCalloc(1, sizeof(LALAdaptiveRungeKuttaIntegrator)))) {
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* no GSL stepper is used, but keep the system to hold dimension and parameters */
+    integrator->sys = (gsl_odeiv_system *) LALCalloc(1, sizeof(gsl_odeiv_system));
+    integrator->dopri = ws = LALCalloc(1, sizeof(*ws));
+
+    /* allocate the workspace once; it is reused by every integration */
+    if (ws)
+        ws->work = LALCalloc(15 * dim, sizeof(REAL8));
+
+    /* if something failed to be allocated, bail out */
+    if (!(integrator->sys) || !ws || !(ws->work)) {
+        XLALAdaptiveRungeKuttaFree(integrator);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    for (int i = 0; i < 7; i++)
+        ws->k[i] = ws->work + i * dim;
+    ws->y = ws->work + 7 * dim;
+    ws->ytmp = ws->work + 8 * dim;
+    ws->yerr = ws->work + 9 * dim;
+    ws->rcont = ws->work + 10 * dim;    /* aliases */
+    ws->eps_abs = eps_abs;
+    ws->eps_rel = eps_rel;
+
+    integrator->dydt = dydt;
+    integrator->stop = stop;
+
+    integrator->sys->function = dydt;
+    integrator->sys->jacobian = NULL;
+    integrator->sys->dimension = dim;
+    integrator->sys->params = NULL;
+
+    integrator->retries = 6;
+    integrator->stopontestonly = 0;
+
+    return integrator;
+}
+
 void XLALAdaptiveRungeKuttaFree(LALAdaptiveRungeKuttaIntegrator * integrator)
 {
     if (!integrator)
@@ -116,6 +182,12 @@ void XLALAdaptiveRungeKuttaFree(LALAdaptiveRungeKuttaIntegrator * integrator)
         XLAL_CALLGSL(gsl_odeiv_control_free(integrator->control));
     if (integrator->step)
         XLAL_CALLGSL(gsl_odeiv_step_free(integrator->step));
+    if (integrator->dopri) {
+        if (integrator->dopri->buffer)
+            XLALDestroyREAL8Array(integrator->dopri->buffer);
+        LALFree(integrator->dopri->work);
+        LALFree(integrator->dopri);
+    }
 
     LALFree(integrator->sys);
     LALFree(integrator);
@@ -1341,3 +1413,296 @@ int XLALAdaptiveRungeKutta4IrregularIntervals(LALAdaptiveRungeKuttaIntegrator *
     *yout = output;
     return outputlen;
 }
+
+/* Dormand-Prince 5(4) coefficients, and the coefficients of its dense output,
+ * from Hairer, Norsett & Wanner, Solving Ordinary Differential Equations I,
+ * 2nd ed., Springer, 1993, Sec. II.5 and II.6 */
+static const REAL8 dp_c[7] = { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 };
+static const REAL8 dp_a[7][6] = {
+    {0},
+    {1.0 / 5.0},
+    {3.0 / 40.0, 9.0 / 40.0},
+    {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0},
+    {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0},
+    {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0},
+    {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0}
+};
+static const REAL8 dp_e[7] = { 71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0 };
+static const REAL8 dp_d[7] = { -12715105075.0 / 11282082432.0, 0.0, 87487479700.0 / 32700410799.0, -10690763975.0 / 1880347072.0,
+    701980252875.0 / 199316789632.0, -1453857185.0 / 822651844.0, 69997945.0 / 29380423.0 };
+
+/* Local function to take a single Dormand-Prince step of size h from (t, ws->y), given
+ * ws->k[0] = dydt(t, ws->y); computes ws->ytmp, ws->yerr, and ws->k[1..6] */
+static int dormandPrinceStep(LALAdaptiveRungeKuttaIntegrator * integrator, void *params, REAL8 t, REAL8 h, size_t dim)
+{
+    struct tagLALAdaptiveRungeKuttaDPWorkspace *ws = integrator->dopri;
+    REAL8 *y = ws->y, *ytmp = ws->ytmp, *yerr = ws->yerr;
+    REAL8 **k = ws->k;
+    int status;
+
+    for (int s = 1; s < 7; s++) {
+        for (size_t i = 0; i < dim; i++) {
+            REAL8 sum = 0;
+            for (int r = 0; r < s; r++)
+                sum += dp_a[s][r] * k[r][i];
+            ytmp[i] = y[i] + h * sum;
+        }
+        /* the last stage is evaluated at the end of the step, and is reused as the first stage of the next step */
+        if ((status = integrator->dydt(t + dp_c[s] * h, ytmp, k[s], params)) != GSL_SUCCESS)
+            return status;
+    }
+
+    for (size_t i = 0; i < dim; i++) {
+        REAL8 sum = 0;
+        for (int r = 0; r < 7; r++)
+            sum += dp_e[r] * k[r][i];
+        yerr[i] = h * sum;
+    }
+
+    return GSL_SUCCESS;
+}
+
+/* Local function to compute the error of the trial step, relative to the tolerances;
+ * the step is acceptable if the return value is at most 1 */
+static REAL8 dormandPrinceError(const struct tagLALAdaptiveRungeKuttaDPWorkspace *ws, size_t dim)
+{
+    REAL8 err = 0;
+
+    for (size_t i = 0; i < dim; i++) {
+        const REAL8 scale = ws->eps_abs + ws->eps_rel * fmax(fabs(ws->y[i]), fabs(ws->ytmp[i]));
+        const REAL8 erri = fabs(ws->yerr[i]) / scale;
+        if (!(erri <= err))     /* also propagates NaNs */
+            err = erri;
+    }
+
+    return err;
+}
+
+/* Local function to make sure the output buffer holds at least len samples; existing samples are kept */
+static int dormandPrinceReserve(struct tagLALAdaptiveRungeKuttaDPWorkspace *ws, size_t dim, size_t count, size_t len)
+{
+    REAL8Array *rebuffer;
+
+    if (ws->buffer && ws->bufferlength >= len)
+        return XLAL_SUCCESS;
+
+    if (!(rebuffer = XLALCreateREAL8ArrayL(2, dim + 1, len)))
+        return XLAL_ENOMEM;
+
+    if (ws->buffer) {
+        for (size_t i = 0; i <= dim; i++)
+            memcpy(&rebuffer->data[i * len], &ws->buffer->data[i * ws->bufferlength], count * sizeof(REAL8));
+        XLALDestroyREAL8Array(ws->buffer);
+    }
+    ws->buffer = rebuffer;
+    ws->bufferlength = len;
+
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Fifth-order Runge-Kutta ODE integrator using Dormand-Prince 5(4) steps with
+ * adaptive step size control, and evenly sampled output.  Intended for use in
+ * time domain waveform generation routines based on EOB models, as a faster
+ * replacement for XLALAdaptiveRungeKutta4().
+ *
+ * The method, and its continuous extension used for the output, are described in
+ *
+ * Hairer, Norsett & Wanner, Solving Ordinary Differential Equations I,
+ * 2nd ed., Springer, 1993, Sections II.5 and II.6
+ *
+ * The trajectory is sampled at times tinit + j*deltat directly from the
+ * fourth-order dense output of each accepted step, so no interpolation pass
+ * over the whole trajectory is needed.  The integrator must have been created
+ * with XLALAdaptiveRungeKuttaDormandPrinceInit(); its workspace and output
+ * buffers are reused by successive calls, so only the returned array is
+ * allocated by each call.
+ *
+ * The stopping conditions and the handling of failed derivative evaluations
+ * are the same as in XLALAdaptiveRungeKutta4().  On return, yinit holds the
+ * state at the last integration step, and the number of output samples is
+ * returned.
+ */
+int XLALAdaptiveRungeKuttaDormandPrince(LALAdaptiveRungeKuttaIntegrator * integrator,   /**< struct holding dydt, stopping test, and workspace */
+    void *params,                                                       /**< params struct used to compute dydt and stopping test */
+    REAL8 * yinit,                                                      /**< pass in initial values of all variables - overwritten to final values */
+    REAL8 tinit,                                                        /**< integration start time */
+    REAL8 tend,                                                         /**< maximum integration time */
+    REAL8 deltat,                                                       /**< step size for evenly sampled output */
+    REAL8Array ** yout                                                  /**< array holding the evenly sampled output */
+    )
+{
+    int errnum = 0;
+    int status; /* used throughout */
+
+    size_t dim, count, needed, retries;
+    REAL8 t, h, err, tgrid;
+    REAL8Array *output = NULL;
+    struct tagLALAdaptiveRungeKuttaDPWorkspace *ws;
+    REAL8 *data, *y, *ytmp, *rcont;     /* aliases */
+    REAL8 **k;
+
+    if (!integrator || !integrator->dopri || !yinit || !yout)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!(deltat > 0) || !(tend >= tinit)) {
+        XLALPrintError("XLAL Error - %s: require deltat > 0 and tend >= tinit\ntend: %f, tinit: %f, deltat: %f\n", __func__, tend, tinit, deltat);
+        XLAL_ERROR(XLAL_EINVAL);
+    }
+
+    /* the user-supplied functions may call GSL */
+    XLAL_BEGINGSL;
+
+    dim = integrator->sys->dimension;
+    ws = integrator->dopri;
+    k = ws->k;
+
+    /* size the output buffer for the expected number of samples; it is only ever grown */
+    if ((errnum = dormandPrinceReserve(ws, dim, 0, (size_t) ((tend - tinit) / deltat) + 2)) != XLAL_SUCCESS)
+        goto bail_out;
+
+    /* set up to get started */
+    integrator->sys->params = params;
+
+    integrator->returncode = 0;
+
+    retries = integrator->retries;
+
+    t = tinit;
+    h = deltat;
+    memcpy(ws->y, yinit, dim * sizeof(REAL8));
+
+    /* store the first data point */
+    ws->buffer->data[0] = t;
+    for (size_t i = 1; i <= dim; i++)
+        ws->buffer->data[i * ws->bufferlength] = ws->y[i - 1];
+    count = 1;
+
+    /* compute derivatives at the initial time, bail out if impossible */
+    if ((status = integrator->dydt(t, ws->y, k[0], params)) != GSL_SUCCESS) {
+        integrator->returncode = status;
+        errnum = XLAL_EFAILED;
+        goto bail_out;
+    }
+
+    while (1) {
+
+        if (!integrator->stopontestonly && t >= tend) {
+            break;
+        }
+
+        if (integrator->stop) {
+            if ((status = integrator->stop(t, ws->y, k[0], params)) != GSL_SUCCESS) {
+                integrator->returncode = status;
+                break;
+            }
+        }
+
+        /* ready to try stepping! */
+      try_step:
+
+        /* if we would be stepping beyond the final time, stop there instead... */
+        if (!integrator->stopontestonly && t + h > tend)
+            h = tend - t;
+
+        /* ...and give up if the step size has underflowed */
+        if (t + h == t) {
+            integrator->returncode = GSL_ETOL;
+            break;
+        }
+
+        status = dormandPrinceStep(integrator, params, t, h, dim);
+
+        /* did we encounter a derivative-evaluation error? */
+        if (status != GSL_SUCCESS) {
+            if (retries--) {
+                h = h / 10.0;   /* if we have singularity retries left, reduce the timestep and try again */
+                goto try_step;
+            } else {
+                integrator->returncode = status;
+                break;  /* otherwise exit the loop */
+            }
+        } else {
+            retries = integrator->retries;      /* we stepped successfully, reset the singularity retries */
+        }
+
+        /* reject the step if the error is too large, and try again with a smaller step */
+        err = dormandPrinceError(ws, dim);
+        if (!(err <= 1.0)) {
+            h *= isnan(err) ? 0.2 : fmax(0.2, 0.9 * pow(err, -0.2));
+            goto try_step;
+        }
+
+        /* make room for all output samples within this step */
+        needed = count + (size_t) (h / deltat) + 2;
+        if (needed > ws->bufferlength) {
+            if ((errnum = dormandPrinceReserve(ws, dim, count, needed > 2 * ws->bufferlength ? needed : 2 * ws->bufferlength)) != XLAL_SUCCESS)
+                goto bail_out;
+        }
+        data = ws->buffer->data;
+
+        /* sample the dense output at all times tinit + count*deltat within (t, t + h] */
+        y = ws->y;
+        ytmp = ws->ytmp;
+        rcont = ws->rcont;
+        tgrid = tinit + count * deltat;
+        if (tgrid <= t + h) {
+            for (size_t i = 0; i < dim; i++) {
+                const REAL8 ydiff = ytmp[i] - y[i];
+                const REAL8 bspl = h * k[0][i] - ydiff;
+                REAL8 sum = 0;
+                for (int r = 0; r < 7; r++)
+                    sum += dp_d[r] * k[r][i];
+                rcont[i] = y[i];
+                rcont[dim + i] = ydiff;
+                rcont[2 * dim + i] = bspl;
+                rcont[3 * dim + i] = ydiff - h * k[6][i] - bspl;
+                rcont[4 * dim + i] = h * sum;
+            }
+            do {
+                const REAL8 theta = (tgrid - t) / h;
+                const REAL8 theta1 = 1.0 - theta;
+                data[count] = tgrid;
+                for (size_t i = 0; i < dim; i++)
+                    data[(i + 1) * ws->bufferlength + count] =
+                        rcont[i] + theta * (rcont[dim + i] + theta1 * (rcont[2 * dim + i] + theta * (rcont[3 * dim + i] + theta1 * rcont[4 * dim + i])));
+                count++;
+                tgrid = tinit + count * deltat;
+            } while (tgrid <= t + h);
+        }
+
+        /* accept the step; the derivative at the end of the step is the first stage of the next one */
+        t += h;
+        ws->y = ytmp;
+        ws->ytmp = y;
+        REAL8 *kswap = k[0];
+        k[0] = k[6];
+        k[6] = kswap;
+
+        /* adjust the step size for the next step */
+        h *= (err > 0) ? fmin(5.0, fmax(0.2, 0.9 * pow(err, -0.2))) : 5.0;
+    }
+
+    /* copy the final state into yinit */
+    memcpy(yinit, ws->y, dim * sizeof(REAL8));
+
+    /* copy the output samples out of the buffer */
+    if (!(output = XLALCreateREAL8ArrayL(2, dim + 1, count))) {
+        errnum = XLAL_ENOMEM;
+        goto bail_out;
+    }
+    for (size_t i = 0; i <= dim; i++)
+        memcpy(&output->data[i * count], &ws->buffer->data[i * ws->bufferlength], count * sizeof(REAL8));
+
+    /* deallocate stuff and return */
+  bail_out:
+
+    XLAL_ENDGSL;
+
+    if (errnum) {
+        *yout = NULL;
+        XLAL_ERROR(errnum);
+    }
+
+    *yout = output;
+    return count;
+}
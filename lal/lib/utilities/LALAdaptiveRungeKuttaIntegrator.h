@@ -48,6 +48,10 @@ extern "C" {
  */
 /** @{ */
 
+#ifndef SWIG /* exclude from SWIG interface */
+struct tagLALAdaptiveRungeKuttaDPWorkspace;
+#endif /* SWIG */
+
 typedef struct tagLALAdaptiveRungeKuttaIntegrator
 {
   gsl_odeiv_step    *step;
@@ -63,6 +67,10 @@ typedef struct tagLALAdaptiveRungeKuttaIntegrator
   int stopontestonly;	/* stop only on test, use tend to size buffers only */
 
   int returncode;
+
+#ifndef SWIG /* exclude from SWIG interface */
+  struct tagLALAdaptiveRungeKuttaDPWorkspace *dopri;	/* Dormand-Prince workspace and output buffers, kept across calls */
+#endif /* SWIG */
 } LALAdaptiveRungeKuttaIntegrator;
 
 LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4Init( int dim,
@@ -85,6 +93,19 @@ LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4InitEighthOrderInstead(
                              );
 /* END OPTIMIZED */
 
+/**
+ * Dormand-Prince 5(4) ODE integrator with adaptive step size control and dense output.
+ * Intended for use in time domain waveform generation routines based on EOB models.
+ * An integrator created with this function can only be used with
+ * XLALAdaptiveRungeKuttaDormandPrince(); its workspace and output buffers are allocated
+ * once and reused by every subsequent integration.
+ */
+LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKuttaDormandPrinceInit( int dim,
+                             int (* dydt) (double t, const double y[], double dydt[], void * params),
+                             int (* stop) (double t, const double y[], double dydt[], void * params),
+                             double eps_abs, double eps_rel
+                             );
+
 void XLALAdaptiveRungeKuttaFree( LALAdaptiveRungeKuttaIntegrator *integrator );
 
 int XLALAdaptiveRungeKutta4( LALAdaptiveRungeKuttaIntegrator *integrator,
@@ -143,6 +164,15 @@ int XLALAdaptiveRungeKutta4IrregularIntervals( LALAdaptiveRungeKuttaIntegrator *
                                     REAL8Array **yout                   /**< array holding the unevenly sampled output */
                                     );
 
+int XLALAdaptiveRungeKuttaDormandPrince( LALAdaptiveRungeKuttaIntegrator *integrator,
+                                         void *params,
+                                         REAL8 *yinit,
+                                         REAL8 tinit,
+                                         REAL8 tend,
+                                         REAL8 deltat,
+                                         REAL8Array **yout
+                                         );
+
 /** @} */
 
 #if 0
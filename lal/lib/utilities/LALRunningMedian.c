@@ -25,6 +25,10 @@
 #include <lal/AVFactories.h>
 #include <lal/LALRunningMedian.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 /*----------------------------------
   A structure to store values and indices
   of elements in an array
@@ -1499,3 +1503,304 @@ void LALSRunningMedian2( LALStatus *status,
   DETATCHSTATUSPTR( status );
   RETURN( status );
 }
+
+
+
+/*----------------------------------
+  XLAL running median: the window is kept
+  in two heaps of fixed size, a max-heap 'lo'
+  holding the lower half and a min-heap 'hi'
+  holding the upper half of the window, so
+  that the median is at the top(s) and each
+  new sample costs O(log blocksize)
+  -----------------------------------*/
+struct tagLALRunningMedian {
+  UINT4 blocksize;              /* number of samples in the window */
+  UINT4 nlo, nhi;               /* sizes of the 'lo' and 'hi' heaps */
+  REAL8 *value;                 /* window samples, indexed by slot */
+  INT4 *pos;                    /* heap position of each slot:
+                                   >=0 in 'lo', <0 at (-pos-1) in 'hi' */
+  UINT4 *lo;                    /* max-heap of slots of the lower half */
+  UINT4 *hi;                    /* min-heap of slots of the upper half */
+  struct rngmed_val_index8 *sortbuf; /* used to sort the first window */
+};
+
+/* put slot at position i of heap 'lo' (upper == 0) or 'hi' (upper != 0) */
+static void rngmed_heap_set(LALRunningMedian *rm, int upper, UINT4 i, UINT4 slot)
+{
+  if (upper) {
+    rm->hi[i] = slot;
+    rm->pos[slot] = -((INT4)i) - 1;
+  } else {
+    rm->lo[i] = slot;
+    rm->pos[slot] = i;
+  }
+}
+
+/* true if slot a belongs above slot b in heap 'lo'/'hi' */
+#define RNGMED_ABOVE(rm, upper, a, b) \
+  ((upper) ? (rm)->value[a] < (rm)->value[b] : (rm)->value[a] > (rm)->value[b])
+
+/* restore the heap property around position i after its value changed */
+static void rngmed_heap_sift(LALRunningMedian *rm, int upper, UINT4 i)
+{
+  UINT4 *heap = upper ? rm->hi : rm->lo;
+  const UINT4 n = upper ? rm->nhi : rm->nlo;
+  const UINT4 slot = heap[i];
+
+  /* sift up */
+  while (i > 0) {
+    const UINT4 parent = (i - 1) / 2;
+    if (!RNGMED_ABOVE(rm, upper, slot, heap[parent]))
+      break;
+    rngmed_heap_set(rm, upper, i, heap[parent]);
+    i = parent;
+  }
+
+  /* sift down */
+  for (;;) {
+    UINT4 child = 2 * i + 1;
+    if (child >= n)
+      break;
+    if (child + 1 < n && RNGMED_ABOVE(rm, upper, heap[child + 1], heap[child]))
+      child++;
+    if (!RNGMED_ABOVE(rm, upper, heap[child], slot))
+      break;
+    rngmed_heap_set(rm, upper, i, heap[child]);
+    i = child;
+  }
+
+  rngmed_heap_set(rm, upper, i, slot);
+}
+
+/* replace the sample in a slot with a new value */
+static void rngmed_replace(LALRunningMedian *rm, UINT4 slot, REAL8 x)
+{
+  const INT4 p = rm->pos[slot];
+
+  rm->value[slot] = x;
+  if (p >= 0)
+    rngmed_heap_sift(rm, 0, p);
+  else
+    rngmed_heap_sift(rm, 1, -p - 1);
+
+  /* at most one sample can have crossed the median */
+  if (rm->nhi > 0 && rm->value[rm->lo[0]] > rm->value[rm->hi[0]]) {
+    const UINT4 a = rm->lo[0], b = rm->hi[0];
+    rngmed_heap_set(rm, 0, 0, b);
+    rngmed_heap_set(rm, 1, 0, a);
+    rngmed_heap_sift(rm, 0, 0);
+    rngmed_heap_sift(rm, 1, 0);
+  }
+}
+
+/* compute the running medians of x8 (or x4 if x8 is NULL) into m8 (or m4) */
+static void rngmed_run(LALRunningMedian *rm, UINT4 length,
+                       const REAL8 *x8, const REAL4 *x4, REAL8 *m8, REAL4 *m4)
+{
+  const UINT4 bsize = rm->blocksize;
+  const BOOLEAN isodd = bsize & 1;
+  UINT4 i;
+
+  /* sort the first window and split it between the heaps; a sorted
+     array read backwards is a max-heap, read forwards a min-heap */
+  for (i = 0; i < bsize; i++) {
+    rm->value[i] = x8 ? x8[i] : x4[i];
+    rm->sortbuf[i].data = rm->value[i];
+    rm->sortbuf[i].index = i;
+  }
+  qsort(rm->sortbuf, bsize, sizeof(rm->sortbuf[0]), rngmed_sortindex8);
+  for (i = 0; i < rm->nlo; i++)
+    rngmed_heap_set(rm, 0, i, rm->sortbuf[rm->nlo - 1 - i].index);
+  for (i = 0; i < rm->nhi; i++)
+    rngmed_heap_set(rm, 1, i, rm->sortbuf[rm->nlo + i].index);
+
+  for (i = 0; ; i++) {
+
+    /* median of the window starting at i; the REAL4 sum is formed in
+       single precision, as in LALSRunningMedian2() */
+    if (m8)
+      m8[i] = isodd ? rm->value[rm->lo[0]]
+        : (rm->value[rm->lo[0]] + rm->value[rm->hi[0]]) / 2.0;
+    else
+      m4[i] = isodd ? (REAL4)rm->value[rm->lo[0]]
+        : ((REAL4)rm->value[rm->lo[0]] + (REAL4)rm->value[rm->hi[0]]) / 2.0;
+
+    if (i + bsize >= length)
+      break;
+
+    /* the oldest sample is in slot i % bsize */
+    rngmed_replace(rm, i % bsize, x8 ? x8[i + bsize] : x4[i + bsize]);
+
+  }
+}
+
+
+LALRunningMedian *XLALCreateRunningMedian(UINT4 blocksize)
+{
+  LALRunningMedian *rm;
+
+  XLAL_CHECK_NULL(blocksize > 0, XLAL_EINVAL, "blocksize must be > 0");
+
+  rm = XLALCalloc(1, sizeof(*rm));
+  XLAL_CHECK_NULL(rm != NULL, XLAL_ENOMEM);
+  rm->blocksize = blocksize;
+  rm->nlo = (blocksize + 1) / 2;
+  rm->nhi = blocksize / 2;
+  rm->value = XLALMalloc(blocksize * sizeof(*rm->value));
+  rm->pos = XLALMalloc(blocksize * sizeof(*rm->pos));
+  rm->lo = XLALMalloc(rm->nlo * sizeof(*rm->lo));
+  rm->hi = XLALMalloc((rm->nhi > 0 ? rm->nhi : 1) * sizeof(*rm->hi));
+  rm->sortbuf = XLALMalloc(blocksize * sizeof(*rm->sortbuf));
+  if (!rm->value || !rm->pos || !rm->lo || !rm->hi || !rm->sortbuf) {
+    XLALDestroyRunningMedian(rm);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+
+  return rm;
+}
+
+
+void XLALDestroyRunningMedian(LALRunningMedian *rm)
+{
+  if (rm) {
+    XLALFree(rm->value);
+    XLALFree(rm->pos);
+    XLALFree(rm->lo);
+    XLALFree(rm->hi);
+    XLALFree(rm->sortbuf);
+    XLALFree(rm);
+  }
+}
+
+
+UINT4 XLALRunningMedianBlocksize(const LALRunningMedian *rm)
+{
+  XLAL_CHECK_VAL(0, rm != NULL, XLAL_EFAULT);
+  return rm->blocksize;
+}
+
+
+int XLALDRunningMedian(LALRunningMedian *rm, REAL8Sequence *medians, const REAL8Sequence *input)
+{
+  XLAL_CHECK(rm != NULL, XLAL_EFAULT);
+  XLAL_CHECK(input != NULL && input->data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(medians != NULL && medians->data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(rm->blocksize <= input->length, XLAL_EBADLEN, "blocksize %u larger than input length %u", rm->blocksize, input->length);
+  XLAL_CHECK(medians->length == input->length - rm->blocksize + 1, XLAL_EBADLEN, "medians must have length %u, not %u", input->length - rm->blocksize + 1, medians->length);
+
+  rngmed_run(rm, input->length, input->data, NULL, medians->data, NULL);
+
+  return XLAL_SUCCESS;
+}
+
+
+int XLALSRunningMedian(LALRunningMedian *rm, REAL4Sequence *medians, const REAL4Sequence *input)
+{
+  XLAL_CHECK(rm != NULL, XLAL_EFAULT);
+  XLAL_CHECK(input != NULL && input->data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(medians != NULL && medians->data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(rm->blocksize <= input->length, XLAL_EBADLEN, "blocksize %u larger than input length %u", rm->blocksize, input->length);
+  XLAL_CHECK(medians->length == input->length - rm->blocksize + 1, XLAL_EBADLEN, "medians must have length %u, not %u", input->length - rm->blocksize + 1, medians->length);
+
+  rngmed_run(rm, input->length, NULL, input->data, NULL, medians->data);
+
+  return XLAL_SUCCESS;
+}
+
+
+/* a contiguous range of rows of a batch, handled by one thread */
+struct rngmed_batch {
+  REAL8VectorSequence *medians;
+  const REAL8VectorSequence *input;
+  UINT4 blocksize;
+  UINT4 first, last;
+  int retn;
+};
+
+static void *rngmed_batch_rows(void *arg)
+{
+  struct rngmed_batch *b = arg;
+  LALRunningMedian *rm = XLALCreateRunningMedian(b->blocksize);
+  UINT4 row;
+
+  if (!rm) {
+    b->retn = XLAL_FAILURE;
+    return NULL;
+  }
+  for (row = b->first; row < b->last; row++)
+    rngmed_run(rm, b->input->vectorLength,
+               b->input->data + (size_t)row * b->input->vectorLength, NULL,
+               b->medians->data + (size_t)row * b->medians->vectorLength, NULL);
+  XLALDestroyRunningMedian(rm);
+  b->retn = XLAL_SUCCESS;
+  return NULL;
+}
+
+
+int XLALDRunningMedianBatch(REAL8VectorSequence *medians, const REAL8VectorSequence *input, UINT4 blocksize, UINT4 nthreads)
+{
+  struct rngmed_batch *batch;
+  UINT4 t;
+  int retn = XLAL_SUCCESS;
+
+  XLAL_CHECK(input != NULL && input->data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(medians != NULL && medians->data != NULL, XLAL_EFAULT);
+  XLAL_CHECK(blocksize > 0, XLAL_EINVAL, "blocksize must be > 0");
+  XLAL_CHECK(blocksize <= input->vectorLength, XLAL_EBADLEN, "blocksize %u larger than input length %u", blocksize, input->vectorLength);
+  XLAL_CHECK(medians->length == input->length, XLAL_EBADLEN, "medians must have %u rows, not %u", input->length, medians->length);
+  XLAL_CHECK(medians->vectorLength == input->vectorLength - blocksize + 1, XLAL_EBADLEN, "medians must have length %u, not %u", input->vectorLength - blocksize + 1, medians->vectorLength);
+
+  if (input->length == 0)
+    return XLAL_SUCCESS;
+#ifndef LAL_PTHREAD_LOCK
+  nthreads = 1;
+#endif
+  if (nthreads < 1)
+    nthreads = 1;
+  if (nthreads > input->length)
+    nthreads = input->length;
+
+  batch = XLALCalloc(nthreads, sizeof(*batch));
+  XLAL_CHECK(batch != NULL, XLAL_ENOMEM);
+  for (t = 0; t < nthreads; t++) {
+    batch[t].medians = medians;
+    batch[t].input = input;
+    batch[t].blocksize = blocksize;
+    batch[t].first = (UINT4)(((UINT8)input->length * t) / nthreads);
+    batch[t].last = (UINT4)(((UINT8)input->length * (t + 1)) / nthreads);
+  }
+
+#ifdef LAL_PTHREAD_LOCK
+  if (nthreads > 1) {
+    pthread_t *threads = XLALMalloc(nthreads * sizeof(*threads));
+    UINT4 nstarted = 0;
+    if (!threads) {
+      XLALFree(batch);
+      XLAL_ERROR(XLAL_ENOMEM);
+    }
+    /* the calling thread handles the first range itself; if a thread
+       cannot be started, its range is also handled here */
+    for (t = 1; t < nthreads; t++) {
+      if (pthread_create(&threads[t], NULL, rngmed_batch_rows, &batch[t]) != 0)
+        break;
+      nstarted = t;
+    }
+    rngmed_batch_rows(&batch[0]);
+    for (t = nstarted + 1; t < nthreads; t++)
+      rngmed_batch_rows(&batch[t]);
+    for (t = 1; t <= nstarted; t++)
+      pthread_join(threads[t], NULL);
+    XLALFree(threads);
+  } else
+#endif
+    rngmed_batch_rows(&batch[0]);
+
+  for (t = 0; t < nthreads; t++)
+    if (batch[t].retn != XLAL_SUCCESS)
+      retn = XLAL_FAILURE;
+  XLALFree(batch);
+  XLAL_CHECK(retn == XLAL_SUCCESS, XLAL_EFUNC);
+
+  return XLAL_SUCCESS;
+}
@@ -54,12 +54,26 @@ extern "C" {
  * <tt>LALDRunningMedian()</tt>, but has proven to be a
  * little faster and more stable. Check if it works for you.
  *
+ * <tt>XLALDRunningMedian()</tt> and <tt>XLALSRunningMedian()</tt> compute the
+ * same medians using a ::LALRunningMedian workspace, created once with
+ * <tt>XLALCreateRunningMedian()</tt> for a given blocksize and reused for any
+ * number of input sequences without further memory allocation. Any blocksize
+ * \>0 is allowed. <tt>XLALDRunningMedianBatch()</tt> computes the running
+ * medians of each row of a REAL8VectorSequence, e.g. the periodograms of a
+ * set of SFTs, sharing the rows between several threads.
+ *
  * ### Algorithm ###
  *
  * For a detailed description of the algorithm see the
  * LIGO document T-030168-00-D, Somya D. Mohanty:
  * Efficient Algorithm for computing a Running Median
  *
+ * The XLAL functions keep the current block in two binary heaps of fixed
+ * size, a max-heap holding its lower half and a min-heap holding its upper
+ * half, so that the median is found at the top(s) of the heaps. Replacing the
+ * oldest sample with the next one takes \f$O(\log b)\f$ operations, compared
+ * to \f$O(\sqrt{b})\f$ for <tt>LALDRunningMedian2()</tt>.
+ *
  */
 /** @{ */
 
@@ -107,6 +121,12 @@ typedef struct tagLALRunningMedianPar
 LALRunningMedianPar;
 
 
+/**
+ * Workspace for the XLAL running median functions
+ */
+typedef struct tagLALRunningMedian LALRunningMedian;
+
+
 /* Function prototypes. */
 
 /** See LALRunningMedian_h for documentation */
@@ -137,6 +157,24 @@ LALSRunningMedian2( LALStatus *status,
 		    const REAL4Sequence *input,
 		    LALRunningMedianPar param);
 
+/** Create a running median workspace for blocks of \c blocksize samples */
+LALRunningMedian *XLALCreateRunningMedian(UINT4 blocksize);
+
+/** Destroy a running median workspace */
+void XLALDestroyRunningMedian(LALRunningMedian *rm);
+
+/** Return the blocksize of a running median workspace */
+UINT4 XLALRunningMedianBlocksize(const LALRunningMedian *rm);
+
+/** See LALRunningMedian_h for documentation */
+int XLALDRunningMedian(LALRunningMedian *rm, REAL8Sequence *medians, const REAL8Sequence *input);
+
+/** See LALRunningMedian_h for documentation */
+int XLALSRunningMedian(LALRunningMedian *rm, REAL4Sequence *medians, const REAL4Sequence *input);
+
+/** See LALRunningMedian_h for documentation */
+int XLALDRunningMedianBatch(REAL8VectorSequence *medians, const REAL8VectorSequence *input, UINT4 blocksize, UINT4 nthreads);
+
 /** @} */
 
 #ifdef  __cplusplus
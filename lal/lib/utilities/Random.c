@@ -20,6 +20,7 @@
 #include <time.h>
 #include <math.h>
 #include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
 #include <lal/Random.h>
 #include <lal/Sequence.h>
 #include <lal/XLALError.h>
@@ -73,6 +74,18 @@
  * This is an implementation of the random number generators \c ran1 and
  * \c gasdev described in Numerical Recipes \cite ptvf1992 .
  *
+ * The routines <tt>XLALCounterUniformDeviate()</tt> and
+ * <tt>XLALCounterNormalDeviate()</tt>, and the bulk routines
+ * <tt>XLALCounterUniformDeviates()</tt> and <tt>XLALCounterNormalDeviates()</tt>,
+ * draw double-precision deviates from a counter-based generator instead.
+ * Deviate \f$n\f$ of stream \f$s\f$ is the Philox4x32-10 block of the
+ * counter \f$(\lfloor n/2\rfloor, s)\f$ and the key \c seed, mapped to two
+ * uniform deviates or a Box-Muller pair of normal deviates, so any deviate
+ * can be computed without the ones before it.  Use
+ * <tt>XLALCounterRandomSeek()</tt> to give each thread or MPI rank its own
+ * stream, or its own range of offsets in a common stream: the results do
+ * not depend on how the work is partitioned.
+ *
  */
 /** @{ */
 
@@ -254,6 +267,244 @@ REAL4 XLALNormalDeviate( RandomParams *params )
   return deviate;
 }
 
+/*
+ *
+ * Counter-based random numbers.
+ *
+ */
+
+/* Philox4x32-10 constants */
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+#define PHILOX_ROUNDS 10
+
+/* number of blocks generated together by the bulk routines */
+#define COUNTER_RANDOM_BLOCKS 64
+
+/*
+ * Apply the Philox rounds in place to n counters held as four arrays of
+ * words; the loop over the counters is innermost so that it vectorises.
+ */
+static void PhiloxRounds( UINT4 *x0, UINT4 *x1, UINT4 *x2, UINT4 *x3, UINT4 n, UINT4 k0, UINT4 k1 )
+{
+  UINT4 round;
+  UINT4 j;
+
+  for ( round = 0; round < PHILOX_ROUNDS; ++round )
+  {
+    if ( round > 0 )
+    {
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+    for ( j = 0; j < n; ++j )
+    {
+      UINT8 p0 = (UINT8)PHILOX_M0 * x0[j];
+      UINT8 p1 = (UINT8)PHILOX_M1 * x2[j];
+      x0[j] = (UINT4)( p1 >> 32 ) ^ x1[j] ^ k0;
+      x1[j] = (UINT4)p1;
+      x2[j] = (UINT4)( p0 >> 32 ) ^ x3[j] ^ k1;
+      x3[j] = (UINT4)p0;
+    }
+  }
+}
+
+/* compute the n blocks of random words starting at block of a stream */
+static void CounterRandomBlocks( UINT4 *x0, UINT4 *x1, UINT4 *x2, UINT4 *x3, UINT4 n, UINT8 block, const CounterRandomParams *params )
+{
+  UINT4 j;
+  for ( j = 0; j < n; ++j )
+  {
+    x0[j] = (UINT4)( block + j );
+    x1[j] = (UINT4)( ( block + j ) >> 32 );
+    x2[j] = (UINT4)params->stream;
+    x3[j] = (UINT4)( params->stream >> 32 );
+  }
+  PhiloxRounds( x0, x1, x2, x3, n, (UINT4)params->seed, (UINT4)( params->seed >> 32 ) );
+}
+
+/* uniform deviate in the open interval (0,1) from 52 bits of two words */
+static REAL8 CounterUniform( UINT4 a, UINT4 b )
+{
+  return ( ( a >> 6 ) * 67108864.0 + ( b >> 6 ) + 0.5 ) * ( 1.0 / 4503599627370496.0 );
+}
+
+/*
+ * Deviate number offset of a stream: it comes from block offset/2, with
+ * the uniform deviates taking words 0,1 (even offsets) or 2,3 (odd
+ * offsets), and the normal deviates being the cosine (even offsets) or
+ * sine (odd offsets) half of a Box-Muller pair made from both.
+ */
+static REAL8 CounterDeviate( UINT4 a, UINT4 b, UINT4 c, UINT4 d, UINT8 offset, int normal )
+{
+  REAL8 r;
+  REAL8 theta;
+
+  if ( ! normal )
+    return offset % 2 ? CounterUniform( c, d ) : CounterUniform( a, b );
+
+  r = sqrt( -2.0 * log( CounterUniform( a, b ) ) );
+  theta = LAL_TWOPI * CounterUniform( c, d );
+  return offset % 2 ? r * sin( theta ) : r * cos( theta );
+}
+
+static REAL8 CounterRandomDeviate( CounterRandomParams *params, int normal )
+{
+  UINT4 x0, x1, x2, x3;
+  UINT8 offset = params->offset++;
+  CounterRandomBlocks( &x0, &x1, &x2, &x3, 1, offset / 2, params );
+  return CounterDeviate( x0, x1, x2, x3, offset, normal );
+}
+
+static int CounterRandomDeviates( REAL8Vector *deviates, CounterRandomParams *params, int normal )
+{
+  UINT4 x0[COUNTER_RANDOM_BLOCKS];
+  UINT4 x1[COUNTER_RANDOM_BLOCKS];
+  UINT4 x2[COUNTER_RANDOM_BLOCKS];
+  UINT4 x3[COUNTER_RANDOM_BLOCKS];
+  REAL8 *data;
+  UINT4 left;
+
+  if ( ! deviates || ! deviates->data || ! params )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! deviates->length )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  data = deviates->data;
+  left = deviates->length;
+
+  /* finish a partly used block */
+  if ( params->offset % 2 )
+  {
+    *data++ = CounterRandomDeviate( params, normal );
+    --left;
+  }
+
+  /* whole blocks */
+  while ( left >= 2 )
+  {
+    UINT4 n = left / 2 < COUNTER_RANDOM_BLOCKS ? left / 2 : COUNTER_RANDOM_BLOCKS;
+    UINT4 j;
+    CounterRandomBlocks( x0, x1, x2, x3, n, params->offset / 2, params );
+    for ( j = 0; j < n; ++j )
+    {
+      *data++ = CounterDeviate( x0[j], x1[j], x2[j], x3[j], 0, normal );
+      *data++ = CounterDeviate( x0[j], x1[j], x2[j], x3[j], 1, normal );
+    }
+    params->offset += 2 * n;
+    left -= 2 * n;
+  }
+
+  /* start of a new block */
+  if ( left )
+    *data = CounterRandomDeviate( params, normal );
+
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Computes one block of the Philox4x32-10 counter-based generator of
+ * Salmon et al. (2011): four random 32-bit words from a 128-bit counter and
+ * a 64-bit key.  The other counter-based routines are built on this.
+ */
+void XLALPhiloxRandom( UINT4 output[4], const UINT4 counter[4], const UINT4 key[2] )
+{
+  UINT4 j;
+  for ( j = 0; j < 4; ++j )
+    output[j] = counter[j];
+  PhiloxRounds( output, output + 1, output + 2, output + 3, 1, key[0], key[1] );
+}
+
+/**
+ * Creates parameters for a counter-based random number stream, positioned
+ * at its start.  Unlike XLALCreateRandomParams() a zero seed is a valid
+ * seed, so that results are always reproducible.
+ */
+CounterRandomParams * XLALCreateCounterRandomParams( UINT8 seed, UINT8 stream )
+{
+  CounterRandomParams *params;
+
+  params = XLALMalloc( sizeof( *params ) );
+  if ( ! params )
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+
+  params->seed = seed;
+  XLALCounterRandomSeek( params, stream, 0 );
+
+  return params;
+}
+
+
+void XLALDestroyCounterRandomParams( CounterRandomParams *params )
+{
+  XLALFree( params );
+}
+
+
+/**
+ * Positions a counter-based random number stream so that the next deviate
+ * is the one at the given offset of the given stream.  This costs nothing,
+ * so threads or MPI ranks may each take a stream, or a range of offsets of
+ * one stream, and obtain the same deviates however the work is divided.
+ */
+void XLALCounterRandomSeek( CounterRandomParams *params, UINT8 stream, UINT8 offset )
+{
+  params->stream = stream;
+  params->offset = offset;
+}
+
+
+/**
+ * Returns the next deviate of a counter-based random number stream,
+ * distributed uniformly in the open interval (0,1).
+ */
+REAL8 XLALCounterUniformDeviate( CounterRandomParams *params )
+{
+  if ( ! params )
+    XLAL_ERROR_REAL8( XLAL_EFAULT );
+  return CounterRandomDeviate( params, 0 );
+}
+
+
+/**
+ * Returns the next deviate of a counter-based random number stream,
+ * distributed normally with zero mean and unit variance.
+ */
+REAL8 XLALCounterNormalDeviate( CounterRandomParams *params )
+{
+  if ( ! params )
+    XLAL_ERROR_REAL8( XLAL_EFAULT );
+  return CounterRandomDeviate( params, 1 );
+}
+
+
+/**
+ * Fills a vector with the next uniform deviates of a counter-based random
+ * number stream; the result is identical to calling
+ * XLALCounterUniformDeviate() once per element.
+ */
+int XLALCounterUniformDeviates( REAL8Vector *deviates, CounterRandomParams *params )
+{
+  if ( CounterRandomDeviates( deviates, params, 0 ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Fills a vector with the next normal deviates of a counter-based random
+ * number stream; the result is identical to calling
+ * XLALCounterNormalDeviate() once per element.
+ */
+int XLALCounterNormalDeviates( REAL8Vector *deviates, CounterRandomParams *params )
+{
+  if ( CounterRandomDeviates( deviates, params, 1 ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
 /*
  *
  * LAL Routines.
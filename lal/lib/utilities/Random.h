@@ -92,6 +92,24 @@ RandomParams;
 
 typedef struct tagMTRandomParams MTRandomParams;
 
+/**
+ * \ingroup Random_h
+ * \brief This structure contains the parameters of a counter-based random
+ * number stream.
+ *
+ * Each deviate is a function only of the seed, the stream and its offset
+ * in the stream, so the structure may be copied freely, e.g. one copy per
+ * thread, and positioned anywhere with XLALCounterRandomSeek().
+ */
+typedef struct
+tagCounterRandomParams
+{
+  UINT8 seed;	/**< key of the generator */
+  UINT8 stream;	/**< stream number */
+  UINT8 offset;	/**< offset of the next deviate in the stream */
+}
+CounterRandomParams;
+
 
 INT4 XLALBasicRandom( INT4 i );
 RandomParams * XLALCreateRandomParams( INT4 seed );
@@ -101,6 +119,17 @@ REAL4 XLALUniformDeviate( RandomParams *params );
 int XLALNormalDeviates( REAL4Vector *deviates, RandomParams *params );
 REAL4 XLALNormalDeviate( RandomParams *params );
 
+#ifndef SWIG /* exclude from SWIG interface */
+void XLALPhiloxRandom( UINT4 output[4], const UINT4 counter[4], const UINT4 key[2] );
+#endif /* SWIG */
+CounterRandomParams * XLALCreateCounterRandomParams( UINT8 seed, UINT8 stream );
+void XLALDestroyCounterRandomParams( CounterRandomParams *params );
+void XLALCounterRandomSeek( CounterRandomParams *params, UINT8 stream, UINT8 offset );
+REAL8 XLALCounterUniformDeviate( CounterRandomParams *params );
+REAL8 XLALCounterNormalDeviate( CounterRandomParams *params );
+int XLALCounterUniformDeviates( REAL8Vector *deviates, CounterRandomParams *params );
+int XLALCounterNormalDeviates( REAL8Vector *deviates, CounterRandomParams *params );
+
 void
 LALCreateRandomParams (
     LALStatus        *status,
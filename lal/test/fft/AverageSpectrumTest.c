@@ -26,11 +26,90 @@
 #include <lal/RealFFT.h>
 #include <lal/Window.h>
 #include <lal/Random.h>
+#include <lal/Units.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
 
 #define TESTSTATUS( s ) \
   if ( (s)->statusCode ) { REPORTSTATUS( s ); exit( 1 ); } else \
 ((void)0)
 
+/* compare the streaming spectrum estimates with the batch ones computed
+ * from the data covered by the streaming estimator's segments */
+static int test_streaming( void )
+{
+  const UINT4 seglen = 256;
+  const UINT4 stride = 128;
+  const UINT4 numseg = 8;
+  const UINT4 length = 20 * stride + seglen;
+  const UINT4 chunk = 100;
+  LIGOTimeGPS epoch = { 1000000000, 0 };
+  REAL8TimeSeries *tseries;
+  REAL8TimeSeries *recent;
+  REAL8FrequencySeries *batch;
+  REAL8FrequencySeries *stream;
+  REAL8FFTPlan *plan;
+  REAL8Window *window;
+  RandomParams *randpar;
+  LALStreamingPSD *psd;
+  REAL8 maxerr[3] = { 0, 0, 0 };
+  UINT4 i, k;
+
+  tseries = XLALCreateREAL8TimeSeries( "x", &epoch, 0, 1.0 / 256, &lalDimensionlessUnit, length );
+  batch = XLALCreateREAL8FrequencySeries( "batch", &epoch, 0, 0, &lalDimensionlessUnit, seglen / 2 + 1 );
+  stream = XLALCreateREAL8FrequencySeries( "stream", &epoch, 0, 0, &lalDimensionlessUnit, seglen / 2 + 1 );
+  plan = XLALCreateForwardREAL8FFTPlan( seglen, 0 );
+  window = XLALCreateHannREAL8Window( seglen );
+  psd = XLALStreamingPSDNew( seglen, stride, numseg, window );
+  randpar = XLALCreateRandomParams( 2 );
+  if ( ! tseries || ! batch || ! stream || ! plan || ! window || ! psd || ! randpar )
+    return 1;
+  for ( i = 0; i < length; ++i )
+    tseries->data->data[i] = XLALNormalDeviate( randpar );
+  XLALDestroyRandomParams( randpar );
+
+  /* feed the data to the streaming estimator in pieces that do not line
+   * up with the segments */
+  for ( i = 0; i < length; i += chunk )
+  {
+    REAL8TimeSeries *piece = XLALCutREAL8TimeSeries( tseries, i, i + chunk < length ? chunk : length - i );
+    if ( ! piece || XLALStreamingPSDAdd( psd, piece ) )
+      return 1;
+    XLALDestroyREAL8TimeSeries( piece );
+  }
+  if ( XLALStreamingPSDGetNumSegments( psd ) != numseg )
+    return 1;
+
+  /* the most recent numseg segments */
+  recent = XLALCutREAL8TimeSeries( tseries, length - ( numseg - 1 ) * stride - seglen, ( numseg - 1 ) * stride + seglen );
+  if ( ! recent )
+    return 1;
+
+  if ( XLALREAL8AverageSpectrumWelch( batch, recent, seglen, stride, window, plan ) || XLALStreamingPSDGetWelch( stream, psd ) )
+    return 1;
+  for ( k = 0; k < batch->data->length; ++k )
+    maxerr[0] = fmax( maxerr[0], fabs( stream->data->data[k] / batch->data->data[k] - 1 ) );
+  if ( XLALREAL8AverageSpectrumMedian( batch, recent, seglen, stride, window, plan ) || XLALStreamingPSDGetMedian( stream, psd ) )
+    return 1;
+  for ( k = 0; k < batch->data->length; ++k )
+    maxerr[1] = fmax( maxerr[1], fabs( stream->data->data[k] / batch->data->data[k] - 1 ) );
+  if ( XLALREAL8AverageSpectrumMedianMean( batch, recent, seglen, stride, window, plan ) || XLALStreamingPSDGetMedianMean( stream, psd ) )
+    return 1;
+  for ( k = 0; k < batch->data->length; ++k )
+    maxerr[2] = fmax( maxerr[2], fabs( stream->data->data[k] / batch->data->data[k] - 1 ) );
+  fprintf( stdout, "streaming:	mean error:	%g	median error:	%g	median-mean error:	%g\n", maxerr[0], maxerr[1], maxerr[2] );
+
+  XLALDestroyREAL8TimeSeries( recent );
+  XLALDestroyREAL8TimeSeries( tseries );
+  XLALDestroyREAL8FrequencySeries( batch );
+  XLALDestroyREAL8FrequencySeries( stream );
+  XLALDestroyREAL8FFTPlan( plan );
+  XLALDestroyREAL8Window( window );
+  XLALStreamingPSDFree( psd );
+
+  return maxerr[0] > 1e-12 || maxerr[1] > 1e-12 || maxerr[2] > 1e-12;
+}
+
 int main( void )
 {
   const UINT4 n = 65536;
@@ -94,6 +173,13 @@ int main( void )
   fprintf( stdout, "mean:\t%e\terror:\t%f%%\n", ave, fabs( ave - 2.0 ) / 0.02 );
 
 
+  /* streaming estimates */
+  if ( test_streaming() )
+  {
+    fprintf( stderr, "streaming spectrum estimates do not agree with batch estimates\n" );
+    return 1;
+  }
+
   /* cleanup */
   XLALDestroyREAL4Window( window );
   XLALDestroyREAL4FFTPlan( plan );
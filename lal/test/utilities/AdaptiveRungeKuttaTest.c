@@ -0,0 +1,123 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <lal/LALStdio.h>
+#include <lal/LALAdaptiveRungeKuttaIntegrator.h>
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+/* Harmonic oscillator, with solution y = (cos t, -sin t) */
+static int dydt( double UNUSED t, const double y[], double dy[], void UNUSED *params )
+{
+  dy[0] = y[1];
+  dy[1] = -y[0];
+  return GSL_SUCCESS;
+}
+
+/* Stop once y[0] has crossed -1/2 */
+static int stop( double UNUSED t, const double y[], double UNUSED dy[], void UNUSED *params )
+{
+  return ( y[0] < -0.5 ) ? 1 : GSL_SUCCESS;
+}
+
+/* Derivatives which cannot be evaluated after t = 2 */
+static int dydt_fail( double t, const double y[], double dy[], void *params )
+{
+  return ( t > 2.0 ) ? GSL_EDOM : dydt( t, y, dy, params );
+}
+
+/* Maximum deviation of evenly-sampled output from the exact solution */
+static REAL8 max_error( const REAL8Array *out, int len, REAL8 deltat )
+{
+  REAL8 err = 0;
+  for ( int j = 0; j < len; ++j ) {
+    const REAL8 t = out->data[j];
+    err = fmax( err, fabs( t - j * deltat ) );
+    err = fmax( err, fabs( out->data[len + j] - cos( t ) ) );
+    err = fmax( err, fabs( out->data[2*len + j] + sin( t ) ) );
+  }
+  return err;
+}
+
+int main( void )
+{
+
+  /* Create integrator */
+  LALAdaptiveRungeKuttaIntegrator *integrator = XLALAdaptiveRungeKuttaDormandPrinceInit( 2, dydt, NULL, 1e-10, 1e-9 );
+  XLAL_CHECK_MAIN( integrator != NULL, XLAL_EFUNC );
+
+  /* Integrate over increasing time spans, reusing the integrator */
+  const REAL8 deltat = 0.01;
+  for ( int n = 1; n <= 3; ++n ) {
+    const REAL8 tend = 10.0 * n;
+    REAL8 y[2] = { 1, 0 };
+    REAL8Array *out = NULL;
+    const int len = XLALAdaptiveRungeKuttaDormandPrince( integrator, NULL, y, 0, tend, deltat, &out );
+    XLAL_CHECK_MAIN( len > 0 && out != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( integrator->returncode == 0, XLAL_EFAILED, "Integration failed with return code %i", integrator->returncode );
+    XLAL_CHECK_MAIN( len == (int) round( tend / deltat ) + 1, XLAL_EFAILED, "Wrong number of output samples %i", len );
+    const REAL8 err = max_error( out, len, deltat );
+    printf( "tend = %g, samples = %i, error = %g\n", tend, len, err );
+    XLAL_CHECK_MAIN( err < 1e-8, XLAL_ETOL, "Output deviates from exact solution by %g", err );
+    XLAL_CHECK_MAIN( fabs( y[0] - cos( tend ) ) < 1e-8 && fabs( y[1] + sin( tend ) ) < 1e-8, XLAL_ETOL, "Wrong final state" );
+    XLALDestroyREAL8Array( out );
+  }
+
+  /* Stop on test only; tend is too short, so output buffers must grow */
+  integrator->stop = stop;
+  integrator->stopontestonly = 1;
+  {
+    REAL8 y[2] = { 1, 0 };
+    REAL8Array *out = NULL;
+    const int len = XLALAdaptiveRungeKuttaDormandPrince( integrator, NULL, y, 0, 0.05, 0.001, &out );
+    XLAL_CHECK_MAIN( len > 0 && out != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( integrator->returncode == 1, XLAL_EFAILED, "Integration did not stop on test" );
+    XLAL_CHECK_MAIN( y[0] < -0.5 && out->data[len-1] > acos( -0.5 ), XLAL_EFAILED, "Integration stopped too early" );
+    const REAL8 err = max_error( out, len, 0.001 );
+    printf( "stop on test: samples = %i, error = %g\n", len, err );
+    XLAL_CHECK_MAIN( err < 1e-8, XLAL_ETOL, "Output deviates from exact solution by %g", err );
+    XLALDestroyREAL8Array( out );
+  }
+
+  /* Derivatives which cannot be evaluated end the integration with an error code */
+  integrator->dydt = dydt_fail;
+  integrator->stop = NULL;
+  integrator->stopontestonly = 0;
+  integrator->retries = 2;
+  {
+    REAL8 y[2] = { 1, 0 };
+    REAL8Array *out = NULL;
+    const int len = XLALAdaptiveRungeKuttaDormandPrince( integrator, NULL, y, 0, 5.0, deltat, &out );
+    XLAL_CHECK_MAIN( len > 0 && out != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( integrator->returncode != 0, XLAL_EFAILED, "Integration did not fail" );
+    XLAL_CHECK_MAIN( out->data[len-1] <= 2.0, XLAL_EFAILED, "Output beyond failure time" );
+    XLALDestroyREAL8Array( out );
+  }
+
+  /* Cleanup */
+  XLALAdaptiveRungeKuttaFree( integrator );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -50,6 +50,8 @@
  * LALRunningMedian functions and compares the results against
  * inividually calculated medians. The test is repeated with
  * blocksize - 1 (to check for even/odd errors).
+ * The XLAL functions are tested in the same way, and the results of
+ * XLALDRunningMedianBatch() are compared against XLALDRunningMedian().
  * The default values for array length and window
  * width are 1024 and 512.
  * If a value for lalDebugLevel is given, the program
@@ -110,9 +112,10 @@ int compare_double( double x, double y );
 int compare_single( float x, float y );
 static int rngmed_sortindex(const void *elem1, const void *elem2);
 int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
-		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl);
+		       LALRunningMedianPar param, BOOLEAN verbose, UINT2 bmimpl);
 int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
-		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl);
+		       LALRunningMedianPar param, BOOLEAN verbose, UINT2 bmimpl);
+int testDRunningMedianBatch(REAL8Sequence *input, UINT4 blocksize);
 
 
 struct rngmed_val_index {
@@ -187,7 +190,7 @@ static int rngmed_sortindex(const void *elem1, const void *elem2){
 
 
 int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
-		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl) {
+		       LALRunningMedianPar param, BOOLEAN verbose, UINT2 bmimpl) {
 /* Test the LALDRunningMedian (REAL8Sequence) function by
    comparing the reults to individually calculated medians */
 
@@ -204,7 +207,14 @@ int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
   }
 
   /* call running median */
-  if (bmimpl)
+  if (bmimpl == 2) {
+    LALRunningMedian *rm = XLALCreateRunningMedian( param.blocksize );
+    if ( rm == NULL || XLALDRunningMedian( rm, medians, input ) != XLAL_SUCCESS ) {
+      printf("ERROR: XLALDRunningMedian failed\n");
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+    XLALDestroyRunningMedian( rm );
+  } else if (bmimpl)
     LALDRunningMedian2( stat, medians, input, param );
   else
     LALDRunningMedian( stat, medians, input, param );
@@ -267,7 +277,7 @@ int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
 
 
 int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
-		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl) {
+		       LALRunningMedianPar param, BOOLEAN verbose, UINT2 bmimpl) {
 /* Test the LALSRunningMedian (REAL4Sequence) function by
    comparing the reults to individually calculated medians */
 
@@ -284,7 +294,14 @@ int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
   }
 
   /* call running median */
-  if (bmimpl)
+  if (bmimpl == 2) {
+    LALRunningMedian *rm = XLALCreateRunningMedian( param.blocksize );
+    if ( rm == NULL || XLALSRunningMedian( rm, medians, input ) != XLAL_SUCCESS ) {
+      printf("ERROR: XLALSRunningMedian failed\n");
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+    XLALDestroyRunningMedian( rm );
+  } else if (bmimpl)
     LALSRunningMedian2( stat, medians, input, param );
   else
     LALSRunningMedian( stat, medians, input, param );
@@ -345,6 +362,59 @@ int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
 
 
 
+int testDRunningMedianBatch(REAL8Sequence *input, UINT4 blocksize) {
+/* Test the XLALDRunningMedianBatch function by comparing the
+   results to those of XLALDRunningMedian for each row */
+
+  const UINT4 nrows = 5, nthreads = 3;
+  const UINT4 length = input->length, nmedians = length - blocksize + 1;
+  REAL8VectorSequence *batchin, *batchout;
+  REAL8Sequence *medians, row;
+  LALRunningMedian *rm;
+  UINT4 i, k;
+
+  batchin = XLALCreateREAL8VectorSequence( nrows, length );
+  batchout = XLALCreateREAL8VectorSequence( nrows, nmedians );
+  medians = XLALCreateREAL8Vector( nmedians );
+  rm = XLALCreateRunningMedian( blocksize );
+  if ( !batchin || !batchout || !medians || !rm ) {
+    EXIT( LALRUNNINGMEDIANTESTC_EALOC, argv0, LALRUNNINGMEDIANTESTC_MSGEALOC );
+  }
+
+  /* each row is a cyclic shift of the input */
+  for(k=0;k<nrows;k++)
+    for(i=0;i<length;i++)
+      batchin->data[k*length+i] = input->data[(i+k*length/nrows)%length];
+
+  if ( XLALDRunningMedianBatch( batchout, batchin, blocksize, nthreads ) != XLAL_SUCCESS ) {
+    printf("ERROR: XLALDRunningMedianBatch failed\n");
+    EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+  }
+
+  for(k=0;k<nrows;k++) {
+    row.length = length;
+    row.data = batchin->data + k*length;
+    if ( XLALDRunningMedian( rm, medians, &row ) != XLAL_SUCCESS ) {
+      printf("ERROR: XLALDRunningMedian failed\n");
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+    for(i=0;i<nmedians;i++)
+      if ( medians->data[i] != batchout->data[k*nmedians+i] ) {
+        printf("ERROR: row:%d index:%d median:% 22.15e batch median:% 22.15e mismatch\n",
+               k, i, medians->data[i], batchout->data[k*nmedians+i]);
+        EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+      }
+  }
+
+  XLALDestroyRunningMedian( rm );
+  XLALDestroyREAL8Vector( medians );
+  XLALDestroyREAL8VectorSequence( batchout );
+  XLALDestroyREAL8VectorSequence( batchin );
+  return(0);
+}
+
+
+
 
 /**************
  **** MAIN ****
@@ -680,6 +750,29 @@ int main( int argc, char **argv )
     printf("  PASS: LALSRunningMedian2(%d,%d)\n",length,param.blocksize);
   }
 
+  /* test the XLAL functions with the two last blocksizes (odd and even) */
+  for(i=0;i<2;i++,param.blocksize++) {
+
+    if(testDRunningMedian(&stat,input8,length,param,verbose,2)) {
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    } else {
+      printf("  PASS: XLALDRunningMedian(%d,%d)\n",length,param.blocksize);
+    }
+
+    if(testSRunningMedian(&stat,input4,length,param,verbose,2)) {
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    } else {
+      printf("  PASS: XLALSRunningMedian(%d,%d)\n",length,param.blocksize);
+    }
+
+    if(testDRunningMedianBatch(input8,param.blocksize)) {
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    } else {
+      printf("  PASS: XLALDRunningMedianBatch(%d,%d)\n",length,param.blocksize);
+    }
+
+  }
+
 
   /* free dummy input memory */
   LALDDestroyVector(&stat,&input8);
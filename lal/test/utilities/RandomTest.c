@@ -173,6 +173,86 @@ main (int argc, char *argv[])
   }
 
 
+  /*
+   *
+   * Check the counter-based generator against the Philox4x32-10 known
+   * answers, and check that its deviates do not depend on how a fill is
+   * split up.
+   *
+   */
+
+
+  if (verbose)
+  {
+    printf ("\n===== Test Counter-Based Random Routines =====\n");
+  }
+
+  {
+    const UINT4 counter[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    const UINT4 key[2] = {0xa4093822, 0x299f31d0};
+    const UINT4 expect[4] = {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+    UINT4 block[4];
+    CounterRandomParams *ctrpar;
+    REAL8Vector *all;
+    REAL8Vector part;
+    UINT4 j;
+
+    XLALPhiloxRandom (block, counter, key);
+    for (i = 0; i < 4; ++i)
+      if (block[i] != expect[i])
+        exit (1);
+
+    ctrpar = XLALCreateCounterRandomParams (42, 3);
+    all = XLALCreateREAL8Vector (numPoints);
+    if (!ctrpar || !all)
+      exit (1);
+    if (XLALCounterNormalDeviates (all, ctrpar))
+      exit (1);
+
+    /* refill in uneven pieces, starting each at its offset */
+    for (i = 0; i < all->length; i += part.length)
+    {
+      part.length = 1 + (7 * i) % 37;
+      if (part.length > all->length - i)
+        part.length = all->length - i;
+      part.data = XLALMalloc (part.length * sizeof (*part.data));
+      XLALCounterRandomSeek (ctrpar, 3, i);
+      if (!part.data || XLALCounterNormalDeviates (&part, ctrpar))
+        exit (1);
+      for (j = 0; j < part.length; ++j)
+        if (part.data[j] != all->data[i + j])
+          exit (1);
+      XLALFree (part.data);
+    }
+
+    /* single deviates */
+    XLALCounterRandomSeek (ctrpar, 3, 0);
+    for (i = 0; i < all->length; ++i)
+      if (XLALCounterNormalDeviate (ctrpar) != all->data[i])
+        exit (1);
+
+    /* uniform deviates lie in (0,1) */
+    if (XLALCounterUniformDeviates (all, ctrpar))
+      exit (1);
+    for (i = 0; i < all->length; ++i)
+      if (!(all->data[i] > 0 && all->data[i] < 1))
+        exit (1);
+
+    if (output)
+    {
+      FILE *fp = fopen ("PrintVector.002", "w");
+      for (i = 0; i < all->length; ++i)
+      {
+        fprintf (fp, "%e\n", all->data[i]);
+      }
+      fclose (fp);
+    }
+
+    XLALDestroyREAL8Vector (all);
+    XLALDestroyCounterRandomParams (ctrpar);
+  }
+
+
   /*
    *
    * Check to make sure that correct error codes are generated.
@@ -55,6 +55,7 @@
 #include <lal/LIGOLwXMLArray.h>
 #include <lal/LIGOLwXMLBurstRead.h>
 #include <lal/LIGOLwXMLRead.h>
+#include <lal/LIGOMetadataColumns.h>
 #include <lal/LIGOMetadataTables.h>
 #include <lal/LIGOMetadataUtils.h>
 #include <lal/Random.h>
@@ -222,6 +223,8 @@ struct options {
 	char *comment;
 	/* safety valve (Hz), 0 == disable */
 	int max_event_rate;
+	/* time-window clustering (s), 0 == disable */
+	double cluster_window;
 	char *output_filename;
 
 	/*
@@ -255,6 +258,7 @@ static struct options *options_new(void)
 	options->max_series_length = 0;	/* default == disable */
 	options->high_pass = -1;	/* impossible */
 	options->max_event_rate = 0;	/* default == disable */
+	options->cluster_window = 0;	/* default == disable */
 	options->output_filename = NULL;	/* impossible */
 	options->injection_filename = NULL;	/* default == disable */
 	options->cache_filename = NULL;	/* default == disable */
@@ -297,6 +301,7 @@ static void print_usage(const char *program)
 "	 --bandwidth <Hz>\n" \
 "	[--calibration-cache <cache file name>]\n" \
 "	 --channel-name <name>\n" \
+"	[--cluster-window <seconds>]\n" \
 "	 --confidence-threshold <confidence>\n" \
 "	[--dump-diagnostics <XML file name>]\n" \
 "	 --filter-corruption <samples>\n" \
@@ -464,6 +469,7 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
 		{"injection-file", required_argument, NULL, 'P'},
 		{"calibration-cache", required_argument, NULL, 'B'},
 		{"channel-name", required_argument, NULL, 'C'},
+		{"cluster-window", required_argument, NULL, 'd'},
 		{"confidence-threshold", required_argument, NULL, 'g'},
 		{"dump-diagnostics", required_argument, NULL, 'X'},
 		{"filter-corruption", required_argument, NULL, 'j'},
@@ -658,6 +664,16 @@ static struct options *parse_command_line(int argc, char *argv[], const ProcessT
 		ADD_PROCESS_PARAM(process, "long");
 		break;
 
+	case 'd':
+		options->cluster_window = atof(LALoptarg);
+		if(options->cluster_window < 0) {
+			sprintf(msg, "must not be negative (%g s specified)", options->cluster_window);
+			print_bad_argument(argv[0], long_options[option_index].name, msg);
+			args_are_bad = 1;
+		}
+		ADD_PROCESS_PARAM(process, "float");
+		break;
+
 	case 'e':
 		options->resample_rate = atoi(LALoptarg);
 		if(options->resample_rate < 2 || options->resample_rate > 16384 || !is_power_of_2(options->resample_rate)) {
@@ -1543,6 +1559,27 @@ int main(int argc, char *argv[])
 		XLALDestroyREAL8TimeSeries(series);
 	}
 
+	/*
+	 * Cluster the events.  This is done on a column table, which sorts
+	 * and clusters the events in a single sweep over contiguous arrays.
+	 */
+
+	if(options->cluster_window > 0 && _sngl_burst_table) {
+		SnglBurstColumns *events = XLALSnglBurstColumnsFromTable(_sngl_burst_table);
+		if(!events || XLALClusterSnglBurstColumns(events, options->cluster_window) < 0) {
+			XLALPrintError("%s: clustering failed\n", argv[0]);
+			exit(1);
+		}
+		XLALDestroySnglBurstTable(_sngl_burst_table);
+		/* clustering always keeps at least one event */
+		_sngl_burst_table = XLALSnglBurstColumnsToTable(events);
+		XLALDestroySnglBurstColumns(events);
+		if(!_sngl_burst_table) {
+			XLALPrintError("%s: clustering failed\n", argv[0]);
+			exit(1);
+		}
+	}
+
 	/*
 	 * Sort the events, and assign IDs.
 	 */
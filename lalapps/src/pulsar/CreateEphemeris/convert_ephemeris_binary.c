@@ -0,0 +1,78 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_Tools
+ * \brief
+ * Convert Earth or Sun ephemeris files (e.g. earth00-40-DE430.dat.gz) into the binary
+ * ephemeris format, which XLALInitBarycenter() memory-maps instead of parsing.
+ *
+ * The binary file can be passed to any code in place of the original ephemeris file.
+ * Its ephemeris type (e.g. DE430) is taken from the name of the input file and
+ * stored in the binary file, so the output file may be named freely.
+ */
+
+/* ---------- includes ---------- */
+#include <lal/UserInput.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/LALString.h>
+
+#include <lalapps.h>
+
+/* ---------- local types ---------- */
+
+typedef struct
+{
+  CHAR *input;		/**< ephemeris file to convert */
+  CHAR *output;		/**< binary ephemeris file to write */
+} UserVariables_t;
+
+/*============================================================
+ * FUNCTION definitions
+ *============================================================*/
+
+int
+main(int argc, char *argv[])
+{
+
+  UserVariables_t XLAL_INIT_DECL(uvar_s);
+  UserVariables_t *uvar = &uvar_s;
+
+  /* register all user-variables */
+  XLALRegisterUvarMember(	input,		STRING, 'i', REQUIRED,	"Earth or Sun ephemeris file to convert (resolved like in XLALInitBarycenter())");
+  XLALRegisterUvarMember(	output,		STRING, 'o', REQUIRED,	"Name of binary ephemeris file to write");
+
+  /* read cmdline & cfgfile  */
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN( XLALUserVarReadAllInput( &should_exit, argc, argv, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    exit(1);
+  }
+
+  /* convert ephemeris file */
+  XLAL_CHECK_MAIN( XLALConvertEphemerisFileToBinary( uvar->output, uvar->input ) == XLAL_SUCCESS, XLAL_EFUNC,
+                   "Failed to convert ephemeris file '%s' to binary ephemeris file '%s'\n", uvar->input, uvar->output );
+
+  /* free memory */
+  XLALDestroyUserVars();
+
+  LALCheckMemoryLeaks();
+
+  return 0;
+
+} /* main() */
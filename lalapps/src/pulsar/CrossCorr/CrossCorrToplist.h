@@ -20,7 +20,7 @@
 #ifndef CROSSCORRTOPLIST_H
 #define CROSSCORRTOPLIST_H
 
-#include "HeapToplist.h"
+#include "../HeapToplistCompat.h"
 #include <lal/LALDatatypes.h>
 
 
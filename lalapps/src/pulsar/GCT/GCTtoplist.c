@@ -24,7 +24,7 @@
 #include <unistd.h>
 #endif
 #include "GCTtoplist.h"
-#include "HeapToplist.h"
+#include "../HeapToplistCompat.h"
 #include <lal/StringInput.h> /* for LAL_REAL8_FORMAT etc. */
 #include <lal/AVFactories.h>
 #include <lal/LALConstants.h>
@@ -73,9 +73,6 @@ static FILE*debugfp = NULL;
 #define min(a,b) ((a)<(b)?(a):(b))
 #endif
 
-/* maximum number of succesive failures before switching off syncing */
-#define SYNC_FAIL_LIMIT 5
-
 /* output file column headings string, globally defined from HSGCT program */
 extern char *global_column_headings_stringp;
 
@@ -247,7 +244,10 @@ int create_gctFstat_toplist(toplist_t**tl, UINT8 length, UINT4 whatToSortBy) {
     return( create_toplist(tl, length, sizeof(GCTtopOutputEntry), gctBtSGLtL_smaller) );
   }
   else {
-    return( create_toplist(tl, length, sizeof(GCTtopOutputEntry), gctFstat_smaller) );
+    /* declare avTwoF as sort key, so that UpdateSemiCohToplists() can insert whole frequency blocks */
+    if ( create_toplist(tl, length, sizeof(GCTtopOutputEntry), gctFstat_smaller) != 0 )
+      return(-1);
+    return( XLALSetToplistKey(*tl, offsetof(GCTtopOutputEntry, avTwoF)) );
   }
 
 }
@@ -632,10 +632,9 @@ static int _atomic_write_gctFstat_toplist_to_file(toplist_t *l, const char *file
 }
 
 
-/* New easier checkpointing - simply dump the whole toplist (plus a counter and
-   a checksum) into a binary file.
-   The heap structure array is hard to dump because it's based on pointers, so it
-   is restored after reading the data back in by sorting the list once.
+/* Checkpointing - simply dump the toplists (plus a counter and a checksum)
+   into a binary file, using the generic toplist checkpoint functions.
+   The toplists given as NULL are skipped.
 */
 
 /** log an I/O error, i.e. source code line no., ferror, errno and strerror, and doserrno on Windows, too */
@@ -657,14 +656,22 @@ static int _atomic_write_gctFstat_toplist_to_file(toplist_t *l, const char *file
 	      mess,filename,__func__,__FILE__,__LINE__,((fp)?(ferror(fp)):0),errno,strerror(errno))
 #endif
 
+/* collect the non-NULL toplists into 'lists', returns their number */
+static size_t collect_gct_toplists(toplist_t*lists[3], toplist_t*tl, toplist_t*t2, toplist_t*t3) {
+  size_t n = 0;
+  lists[n++] = tl;
+  if (t2) lists[n++] = t2;
+  if (t3) lists[n++] = t3;
+  return(n);
+}
+
+/* number of consecutive failed fsync()s of checkpoints, see write_toplist_checkpoint() */
+static UINT4 gct_sync_failures = 0;
+
 /* dumps toplist to a temporary file, then renames the file to filename */
 int write_gct_checkpoint(const char*filename, toplist_t*tl, toplist_t*t2, toplist_t*t3, UINT4 counter, BOOLEAN do_sync) {
-#define TMP_EXT ".tmp"
-  char*tmpfilename;
-  FILE*fp;
-  UINT4 len;
-  UINT4 checksum = 0;
-  static UINT4 sync_fail_counter = 0;
+  toplist_t *lists[3];
+  int ret;
 
   /* do nothing with an empty filename */
   if (!filename) {
@@ -672,226 +679,66 @@ int write_gct_checkpoint(const char*filename, toplist_t*tl, toplist_t*t2, toplis
     return(0);
   }
 
-  /* construct temporary filename */
-  len = strlen(filename)+strlen(TMP_EXT)+1;
-  tmpfilename=LALCalloc(len,sizeof(char));
-  if(!tmpfilename){
-    LogPrintf(LOG_CRITICAL,"Couldn't allocate tmpfilename\n");
-    return(-2);
-  }
-  strcpy(tmpfilename,filename);
-  strcat(tmpfilename,TMP_EXT);
-
-  /* open tempfile */
-  fp=fopen(tmpfilename,"wb");
-  if(!fp) {
-    LOGIOERROR("Couldn't open",tmpfilename);
-    LALFree(tmpfilename);
-    return(-1);
-  }
-
-  /* write number of elements */
-  len = fwrite(&(tl->elems), sizeof(tl->elems), 1, fp);
-  if(len != 1) {
-    LOGIOERROR("Couldn't write elems to", tmpfilename);
-    LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %d\n",len,1);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", tmpfilename);
-    LALFree(tmpfilename);
-    return(-1);
-  }
-
-  /* write data */
-  len = fwrite(tl->data, tl->size, tl->elems, fp);
-  if(len != tl->elems) {
-    LOGIOERROR("Couldn't write data to", tmpfilename);
-    LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %zu\n", len, tl->elems);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", tmpfilename);
-    LALFree(tmpfilename);
-    return(-1);
-  }
-
-  /* dump heap order */
-  for(UINT4 i = 0; i < tl->elems; i++) {
-    UINT4 idx = (tl->heap[i] - tl->data) / tl->size;
-    len = fwrite(&idx, sizeof(idx), 1, fp);
-    if(len != 1) {
-      LOGIOERROR("Couldn't write idx to", tmpfilename);
-      LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %d\n",len,1);
-      if(fclose(fp))
-	LOGIOERROR("In addition: couldn't close", tmpfilename);
-      LALFree(tmpfilename);
-      return(-1);
-    }
-    for(len = 0; len < sizeof(idx); len++)
-      checksum += *(((char*)&idx) + len);
-  }
-
-  if (t2) {
-    /* write number of elements */
-    len = fwrite(&(t2->elems), sizeof(t2->elems), 1, fp);
-    if(len != 1) {
-      LOGIOERROR("Couldn't write elems to", tmpfilename);
-      LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %d\n",len,1);
-      if(fclose(fp))
-	LOGIOERROR("In addition: couldn't close", tmpfilename);
-      LALFree(tmpfilename);
-      return(-1);
-    }
-
-    /* write data */
-    len = fwrite(t2->data, t2->size, t2->elems, fp);
-    if(len != t2->elems) {
-      LOGIOERROR("Couldn't write data to", tmpfilename);
-      LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %zu\n", len, t2->elems);
-      if(fclose(fp))
-	LOGIOERROR("In addition: couldn't close", tmpfilename);
-      LALFree(tmpfilename);
-      return(-1);
-    }
-
-    /* dump heap order */
-    for(UINT4 i = 0; i < t2->elems; i++) {
-      UINT4 idx = (t2->heap[i] - t2->data) / t2->size;
-      len = fwrite(&idx, sizeof(idx), 1, fp);
-      if(len != 1) {
-	LOGIOERROR("Couldn't write idx to", tmpfilename);
-	LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %d\n",len,1);
-	if(fclose(fp))
-	  LOGIOERROR("In addition: couldn't close", tmpfilename);
-	LALFree(tmpfilename);
-	return(-1);
-      }
-      for(len = 0; len < sizeof(idx); len++)
-	checksum += *(((char*)&idx) + len);
-    }
-  } /* if t2 */
-
-  /* FIXME: this is getting silly, put this into a function and call it for the 
-     different toplists */
-
-  if (t3) {
-    /* write number of elements */
-    len = fwrite(&(t3->elems), sizeof(t3->elems), 1, fp);
-    if(len != 1) {
-      LOGIOERROR("Couldn't write elems to", tmpfilename);
-      LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %d\n",len,1);
-      if(fclose(fp))
-        LOGIOERROR("In addition: couldn't close", tmpfilename);
-      LALFree(tmpfilename);
-      return(-1);
-    }
-
-    /* write data */
-    len = fwrite(t3->data, t3->size, t3->elems, fp);
-    if(len != t3->elems) {
-      LOGIOERROR("Couldn't write data to", tmpfilename);
-      LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %zu\n", len, t3->elems);
-      if(fclose(fp))
-        LOGIOERROR("In addition: couldn't close", tmpfilename);
-      LALFree(tmpfilename);
-      return(-1);
-    }
-
-    /* dump heap order */
-    for(UINT4 i = 0; i < t3->elems; i++) {
-      UINT4 idx = (t3->heap[i] - t3->data) / t3->size;
-      len = fwrite(&idx, sizeof(idx), 1, fp);
-      if(len != 1) {
-        LOGIOERROR("Couldn't write idx to", tmpfilename);
-        LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %d\n",len,1);
-        if(fclose(fp))
-          LOGIOERROR("In addition: couldn't close", tmpfilename);
-        LALFree(tmpfilename);
-        return(-1);
-      }
-      for(len = 0; len < sizeof(idx); len++)
-        checksum += *(((char*)&idx) + len);
-    }
-  } /* if t3 */
-
-
-  /* write counter */
-  len = fwrite(&counter, sizeof(counter), 1, fp);
-  if(len != 1) {
-    LOGIOERROR("Couldn't write counter to", tmpfilename);
-    LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %d\n",len,1);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", tmpfilename);
-      LALFree(tmpfilename);
-    return(-1);
-  }
+  if ((ret = write_toplist_checkpoint(filename, lists, collect_gct_toplists(lists, tl, t2, t3), counter, do_sync ? &gct_sync_failures : NULL)))
+    LogPrintf(LOG_CRITICAL, "ERROR: Couldn't write checkpoint %s: %d\n", filename, ret);
+  return(ret);
+} /* write_gct_checkpoint() */
 
-  /* calculate checksum */
-  for(len = 0; len < sizeof(tl->elems); len++)
-    checksum += *(((char*)&(tl->elems)) + len);
-  for(len = 0; len < (tl->elems * tl->size); len++)
-    checksum += *(((char*)tl->data) + len);
-  if (t2) {
-    for(len = 0; len < sizeof(t2->elems); len++)
-      checksum += *(((char*)&(t2->elems)) + len);
-    for(len = 0; len < (t2->elems * t2->size); len++)
-      checksum += *(((char*)t2->data) + len);
-  }
 
-  if (t3) {
-    for(len = 0; len < sizeof(t3->elems); len++)
-      checksum += *(((char*)&(t3->elems)) + len);
-    for(len = 0; len < (t3->elems * t3->size); len++)
-      checksum += *(((char*)t3->data) + len);
-  }
+/* reads a checkpoint in the format written by write_gct_checkpoint() before it
+   used write_toplist_checkpoint(): for each toplist its number of elements,
+   data and heap order, then the counter and a bytewise checksum.
+   Returns 0 on success, -2 if the file is not such a checkpoint of the toplists */
+static int read_gct_checkpoint_old_format(const char*filename, toplist_t*const*lists, size_t nlists, UINT4*counter) {
+  FILE*fp;
+  UINT4 checksum, sum = 0;
+  int ret = -2;
 
-  for(len = 0; len < sizeof(counter); len++)
-    checksum += *(((char*)&counter) + len);
-
-  /* write checksum */
-  len = fwrite(&checksum, sizeof(checksum), 1, fp);
-  if(len != 1) {
-    LOGIOERROR("Couldn't write checksum to", tmpfilename);
-    LogPrintf(LOG_CRITICAL,"fwrite() returned %d, length was %d\n",len,1);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", tmpfilename);
-      LALFree(tmpfilename);
-    return(-1);
-  }
+  if(!(fp = fopen(filename, "rb")))
+    return(-2);
 
-  if ( do_sync && (sync_fail_counter < SYNC_FAIL_LIMIT) ) {
-    /* make sure the data ends up on disk */
-    if(fsync(fileno(fp))) {
-      LOGIOERROR("Couldn't sync", tmpfilename);
-      sync_fail_counter++;
-      if (sync_fail_counter >= SYNC_FAIL_LIMIT)
-        LogPrintf(LOG_NORMAL,"WARNING: syncing disabled\n");
-      } else {
-        sync_fail_counter = 0;
+  for(size_t l = 0; l < nlists; l++) {
+    toplist_t*tl = lists[l];
+    if((fread(&(tl->elems), sizeof(tl->elems), 1, fp) != 1) || (tl->elems > tl->length) ||
+       (fread(tl->data, tl->size, tl->elems, fp) != tl->elems))
+      goto done;
+    for(size_t len = 0; len < sizeof(tl->elems); len++)
+      sum += *(((char*)&(tl->elems)) + len);
+    for(size_t len = 0; len < (tl->elems * tl->size); len++)
+      sum += *(((char*)tl->data) + len);
+    for(UINT4 i = 0; i < tl->elems; i++) {
+      UINT4 idx;
+      if((fread(&idx, sizeof(idx), 1, fp) != 1) || (idx >= tl->elems))
+        goto done;
+      tl->heap[i] = (char*)(tl->data + idx * tl->size);
+      for(size_t len = 0; len < sizeof(idx); len++)
+        sum += *(((char*)&idx) + len);
     }
   }
+  if((fread(counter, sizeof(*counter), 1, fp) != 1) ||
+     (fread(&checksum, sizeof(checksum), 1, fp) != 1) ||
+     (fgetc(fp) != EOF))
+    goto done;
+  for(size_t len = 0; len < sizeof(*counter); len++)
+    sum += *(((char*)counter) + len);
+  if(checksum == sum)
+    ret = 0;
 
-  /* close tempfile */
-  if(fclose(fp)) {
-    LOGIOERROR("Couldn't close", tmpfilename);
-    LALFree(tmpfilename);
-    return(-1);
+ done:
+  fclose(fp);
+  if (ret != 0) {
+    *counter = 0;
+    for(size_t l = 0; l < nlists; l++)
+      clear_toplist(lists[l]);
   }
-
-  /* rename to filename */
-  if(rename(tmpfilename,filename)) {
-    LOGIOERROR("Couldn't rename\n", tmpfilename);
-    LALFree(tmpfilename);
-    return(-1);
-  }
-
-  /* all went well */
-  LALFree(tmpfilename);
-  return(0);
-} /* write_gct_checkpoint() */
+  return(ret);
+} /* read_gct_checkpoint_old_format() */
 
 
 int read_gct_checkpoint(const char*filename, toplist_t*tl, toplist_t*t2, toplist_t*t3, UINT4*counter) {
-  FILE*fp;
-  UINT4 len;
-  UINT4 checksum, indexsum = 0;
+  toplist_t *lists[3];
+  size_t nlists;
+  int ret;
 
   /* counter should be 0 if we couldn't read a checkpoint */
   *counter = 0;
@@ -902,239 +749,29 @@ int read_gct_checkpoint(const char*filename, toplist_t*tl, toplist_t*t2, toplist
     return(0);
   }
 
-  /* try to open file */
-  fp = fopen(filename, "rb");
-  if(!fp) {
-    if(errno == ENOENT) {
-      LogPrintf(LOG_NORMAL,"INFO: No checkpoint %s found - starting from scratch\n", filename);
-      clear_toplist(tl);
-      if (t2) clear_toplist(t2);
-      return(1);
-    } else {
-      LOGIOERROR("Checkpoint found but couldn't open", filename);
-      clear_toplist(tl);
-      if (t2) clear_toplist(t2);
-      return(-1);
-    }
-  }
-
-  /* read number of elements */
-  len = fread(&(tl->elems), sizeof(tl->elems), 1, fp);
-  if(len != 1) {
-    LOGIOERROR("Couldn't read elems from", filename);
-    LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %d\n", len, 1);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", filename);
-    return(-1);
-  }
-  /* sanity check */
-  if (tl->elems > tl->length) {
-    LogPrintf(LOG_CRITICAL,
-	      "Number of elements read larger than length of toplist: %zu > %zu\n",
-	      tl->elems, tl->length);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", filename);
-    return(-2);
-  }
-
-  /* read data */
-  len = fread(tl->data, tl->size, tl->elems, fp);
-  if(len != tl->elems) {
-    LOGIOERROR("Couldn't read data from", filename);
-    LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %zu\n", len, tl->elems);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", filename);
-    clear_toplist(tl);
-    if (t2) clear_toplist(t2);
-    return(-1);
-  }
-
-  /* read heap order */
-  for(UINT4 i = 0; i < tl->elems; i++) {
-    UINT4 idx;
-    len = fread(&idx, sizeof(idx), 1, fp);
-    if(len != 1) {
-      LOGIOERROR("Couldn't read idx from", filename);
-      LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %d\n",len,1);
-      if(fclose(fp))
-	LOGIOERROR("In addition: couldn't close", filename);
-      return(-1);
-    }
-    tl->heap[i] = (char*)(tl->data + idx * tl->size);
-    for(len = 0; len < sizeof(idx); len++)
-      indexsum += *(((char*)&idx) + len);
-  }
-
-  if (t2) {
-    /* read number of elements */
-    len = fread(&(t2->elems), sizeof(t2->elems), 1, fp);
-    if(len != 1) {
-      LOGIOERROR("Couldn't read elems from", filename);
-      LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %d\n", len, 1);
-      if(fclose(fp))
-	LOGIOERROR("In addition: couldn't close", filename);
-      return(-1);
-    }
-    /* sanity check */
-    if (t2->elems > t2->length) {
-      LogPrintf(LOG_CRITICAL,
-		"Number of elements read larger than length of toplist: %zu > %zu\n",
-		t2->elems, t2->length);
-      if(fclose(fp))
-	LOGIOERROR("In addition: couldn't close", filename);
-      return(-2);
-    }
-
-    /* read data */
-    len = fread(t2->data, t2->size, t2->elems, fp);
-    if(len != t2->elems) {
-      LOGIOERROR("Couldn't read data from", filename);
-      LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %zu\n", len, t2->elems);
-      if(fclose(fp))
-	LOGIOERROR("In addition: couldn't close", filename);
-      clear_toplist(tl);
-      clear_toplist(t2);
-      return(-1);
-    }
+  nlists = collect_gct_toplists(lists, tl, t2, t3);
+  ret = read_toplist_checkpoint(filename, lists, nlists, counter);
 
-    /* read heap order */
-    for(UINT4 i = 0; i < t2->elems; i++) {
-      UINT4 idx;
-      len = fread(&idx, sizeof(idx), 1, fp);
-      if(len != 1) {
-	LOGIOERROR("Couldn't read idx from", filename);
-	LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %d\n",len,1);
-	if(fclose(fp))
-	  LOGIOERROR("In addition: couldn't close", filename);
-	return(-1);
-      }
-      t2->heap[i] = (char*)(t2->data + idx * t2->size);
-      for(len = 0; len < sizeof(idx); len++)
-	indexsum += *(((char*)&idx) + len);
-    }
-  } /* if (t2) */
-
-  if (t3) {
-    /* read number of elements */
-    len = fread(&(t3->elems), sizeof(t3->elems), 1, fp);
-    if(len != 1) {
-      LOGIOERROR("Couldn't read elems from", filename);
-      LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %d\n", len, 1);
-      if(fclose(fp))
-        LOGIOERROR("In addition: couldn't close", filename);
-      return(-1);
-    }
-    /* sanity check */
-    if (t3->elems > t3->length) {
-      LogPrintf(LOG_CRITICAL,
-                "Number of elements read larger than length of toplist: %zu > %zu\n",
-                t3->elems, t3->length);
-      if(fclose(fp))
-        LOGIOERROR("In addition: couldn't close", filename);
-      return(-2);
-    }
-
-    /* read data */
-    len = fread(t3->data, t3->size, t3->elems, fp);
-    if(len != t3->elems) {
-      LOGIOERROR("Couldn't read data from", filename);
-      LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %zu\n", len, t3->elems);
-      if(fclose(fp))
-        LOGIOERROR("In addition: couldn't close", filename);
-      clear_toplist(tl);
-      clear_toplist(t2);
-      clear_toplist(t3);
-      return(-1);
-    }
-
-    /* read heap order */
-    for(UINT4 i = 0; i < t3->elems; i++) {
-      UINT4 idx;
-      len = fread(&idx, sizeof(idx), 1, fp);
-      if(len != 1) {
-        LOGIOERROR("Couldn't read idx from", filename);
-        LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %d\n",len,1);
-        if(fclose(fp))
-          LOGIOERROR("In addition: couldn't close", filename);
-        return(-1);
-      }
-      t3->heap[i] = (char*)(t3->data + idx * t3->size);
-      for(len = 0; len < sizeof(idx); len++)
-        indexsum += *(((char*)&idx) + len);
+  /* fall back to checkpoints written by older versions of this program */
+  if (ret == -2) {
+    if (read_gct_checkpoint_old_format(filename, lists, nlists, counter) == 0) {
+      LogPrintf(LOG_NORMAL,"INFO: Read checkpoint %s in the old GCT checkpoint format\n", filename);
+      ret = 0;
+    } else {
+      LogPrintf(LOG_CRITICAL, "ERROR: Incompatible checkpoint format: %s is neither a toplist checkpoint nor an old GCT checkpoint"
+                " matching the %zu toplist(s) of this search, or it is corrupted; delete it to start from scratch\n", filename, nlists);
+      return(ret);
     }
-  } /* if (t3) */
-
-
-  /* read counter */
-  len = fread(counter, sizeof(*counter), 1, fp);
-  if(len != 1) {
-    LOGIOERROR("Couldn't read counter from", filename);
-    LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %d\n", len, 1);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", filename);
-    clear_toplist(tl);
-    if (t2) clear_toplist(t2);
-    if (t3) clear_toplist(t3);
-    return(-1);
   }
 
-  /* read checksum */
-  len = fread(&checksum, sizeof(checksum), 1, fp);
-  if(len != 1) {
-    LOGIOERROR("Couldn't read checksum from", filename);
-    LogPrintf(LOG_CRITICAL,"fread() returned %d, length was %d\n", len, 1);
-    if(fclose(fp))
-      LOGIOERROR("In addition: couldn't close", filename);
-    if (t2) clear_toplist(t2);
-    if (t3) clear_toplist(t3);
-
-    clear_toplist(tl);
-    return(-1);
-  }
-
-  /* close file */
-  if(fclose(fp)) {
-    LOGIOERROR("Couldn't close", filename);
-    clear_toplist(tl);
-    if (t2) clear_toplist(t2);
-    if (t3) clear_toplist(t3);
-
-    return(-1);
-  }
-
-  /* verify checksum */
-  checksum -= indexsum;
-  for(len = 0; len < sizeof(tl->elems); len++)
-    checksum -= *(((char*)&(tl->elems)) + len);
-  for(len = 0; len < (tl->elems * tl->size); len++)
-    checksum -= *(((char*)tl->data) + len);
-  if (t2) {
-    for(len = 0; len < sizeof(t2->elems); len++)
-      checksum -= *(((char*)&(t2->elems)) + len);
-    for(len = 0; len < (t2->elems * t2->size); len++)
-      checksum -= *(((char*)t2->data) + len);
-  }
-  if (t3) {
-    for(len = 0; len < sizeof(t3->elems); len++)
-      checksum -= *(((char*)&(t3->elems)) + len);
-    for(len = 0; len < (t3->elems * t3->size); len++)
-      checksum -= *(((char*)t3->data) + len);
-  }
-  for(len = 0; len < sizeof(*counter); len++)
-    checksum -= *(((char*)counter) + len);
-  if(checksum) {
-    LogPrintf(LOG_CRITICAL,"Checksum error: %d\n", checksum);
-    clear_toplist(tl);
-    if (t2) clear_toplist(t2);
-    if (t3) clear_toplist(t3);
-
-    return(-2);
-  }
-
-  /* all went well */
-  LogPrintf(LOG_DEBUG,"Successfully read checkpoint:%d\n", *counter);
+  if (ret == 1)
+    LogPrintf(LOG_NORMAL,"INFO: No checkpoint %s found - starting from scratch\n", filename);
+  else if (ret < 0)
+    LogPrintf(LOG_CRITICAL, "ERROR: Couldn't read checkpoint %s: %d\n", filename, ret);
+  else
+    LogPrintf(LOG_DEBUG,"Successfully read checkpoint:%d\n", *counter);
 
-  return(0);
+  return(ret);
 } /* read_gct_checkpoint() */
 
 
@@ -20,7 +20,7 @@
 #ifndef GCTFSTATTOPLIST_H
 #define GCTFSTATTOPLIST_H
 
-#include "HeapToplist.h"
+#include "../HeapToplistCompat.h"
 #include <lal/LALDatatypes.h>
 #include <lal/PulsarDataTypes.h>
 
@@ -128,12 +128,10 @@ extern void sort_gctFstat_toplist_strongest(toplist_t*list);
 /** Checkpointing */
 
 /**
- * writes a checkpoint:
- * - constructs temporary filename (by appending .TMP)
- * - writes number of elements ("elems") in toplist to tempfile
- * - dumps data to tempfile
- * - appends counter
- * - appends checksum (of elems, data and counter)
+ * writes a checkpoint of the toplists 'tl' and (if not NULL) 't2' and 't3'
+ * using write_toplist_checkpoint():
+ * - writes header, toplists, counter and checksum to a temporary file (filename + ".tmp")
+ * - syncs the temporary file if 'do_sync' is set
  * - renames tempfile to final name
  * returns
  * -1 in case of an I/O error,
@@ -143,16 +141,17 @@ extern void sort_gctFstat_toplist_strongest(toplist_t*list);
 extern int write_gct_checkpoint(const char*filename, toplist_t*tl, toplist_t*t2, toplist_t*t3,UINT4 counter, BOOLEAN do_sync);
 
 /**
- * tries to read a checkpoint
+ * tries to read a checkpoint using read_toplist_checkpoint()
  * - tries to open the file, returns 1 if no file found
- * - reads elems, data, counter and checksum
- * - verifies checksum
- * - restores the heap by sorting
+ * - reads header, toplists including their heap order, counter and checksum
+ * - verifies header and checksum
+ * - otherwise tries to read it as a checkpoint in the format written by
+ *   earlier versions of write_gct_checkpoint()
  * returns
  * 0 if successfully read a checkpoint
  * 1 if no checkpoint was found
  * -1 in case of an I/O error
- * -2 if the checksum was wrong or elems was unreasonable
+ * -2 if the checksum was wrong or the checkpoint doesn't match the toplists in either format
  */
 extern int read_gct_checkpoint(const char*filename, toplist_t*tl, toplist_t*t2, toplist_t*t3,UINT4*counter);
 
@@ -2757,9 +2757,125 @@ void UpdateSemiCohToplistsOptimTriple ( LALStatus *status,
 
 
 
+/** parameters of FillSemiCohToplistEntry() */
+typedef struct {
+  FineGrid *in;
+  REAL8 f1dot_fg;
+  REAL8 f2dot_fg;
+  REAL8 f3dot_fg;
+  UsefulStageVariables *usefulparams;
+  REAL4 NSegmentsInv;
+  REAL4 *NSegmentsInvX;
+  BOOLEAN have_f3dot;
+} SemiCohToplistEntryParams;
+
+/**
+ * Fill in the toplist entry of fine-grid frequency bin 'ifreq_fg'.
+ * A failure of the line-robust statistics is reported through xlalErrno.
+ * This is a LALHeapToplistFillFunc callback, see XLALInsertBlockIntoToplist().
+ */
+static void FillSemiCohToplistEntry ( void *element, size_t ifreq_fg, void *param )
+{
+  GCTtopOutputEntry *line = (GCTtopOutputEntry *) element;
+  const SemiCohToplistEntryParams *p = (const SemiCohToplistEntryParams *) param;
+  FineGrid *in = p->in;
+
+  line->Freq = in->freqmin_fg + ifreq_fg * in->dfreq_fg; /* NOTE: this is not the final output frequency! For performance reasons, it will only later get correctly extrapolated for the final toplist */
+  line->Alpha = in->alpha;
+  line->Delta = in->delta;
+  line->F1dot = p->f1dot_fg;
+  line->F2dot = p->f2dot_fg;
+  line->F3dot = p->f3dot_fg;
+  line->nc = in->nc[ifreq_fg];
+  line->avTwoF = 0.0; /* will be set to average over segments later */
+  line->maxTwoFl = -1.0; /* initialise this to -1.0, so that it only gets written out by print_gctFstatline_to_str if actually computed */
+  line->maxTwoFlSeg = -1;
+  line->log10BSGL    = -LAL_REAL4_MAX; /* for now, block field with minimal value, needed for output checking in print_gctFstatline_to_str() */
+  line->log10BSGLtL  = -LAL_REAL4_MAX;
+  line->log10BtSGLtL = -LAL_REAL4_MAX;
+
+  line->numDetectors = in->numDetectors;
+  for (UINT4 X = 0; X < PULSAR_MAX_DETECTORS; X++) { /* initialise single-IFO F-stat arrays to zero */
+    line->avTwoFX[X] = 0.0;
+    line->maxTwoFXl[X] = 0.0;
+    line->maxTwoFXlSeg[X] = -1;
+    line->avTwoFXrecalc[X] = 0.0;
+  }
+  line->avTwoFrecalc = -1.0; /* initialise this to -1.0, so that it only gets written out by print_gctFstatline_to_str if later overwritten in recalcToplistStats step */
+  line->log10BSGLrecalc = -LAL_REAL4_MAX; /* for now, block field with minimal value, needed for output checking in print_gctFstatline_to_str() */
+  line->log10BSGLtLrecalc = -LAL_REAL4_MAX; /* for now, block field with minimal value, needed for output checking in print_gctFstatline_to_str() */
+  line->have_f3dot = p->have_f3dot;
+  line->loudestSeg = -1;
+  line->twoFloudestSeg = -1.0;
+  for (UINT4 X = 0; X < PULSAR_MAX_DETECTORS; X++) {
+    line->twoFXloudestSeg[X] = -1.0;
+  }
+
+  /* local placeholders for summed 2F value over segments, not averages yet */
+  REAL4 sumTwoF = in->sumTwoF[ifreq_fg];
+  REAL4 sumTwoFX[PULSAR_MAX_DETECTORS];
+  if ( in->sumTwoFX ) { /* if we already have FX values from the main loop, insert these, and calculate BSGL here */
+    for (UINT4 X = 0; X < in->numDetectors; X++) {
+      sumTwoFX[X] = in->sumTwoFX[FG_FX_INDEX(*in, X, ifreq_fg)]; /* here it's still the summed 2F value over segments, not the average */
+    }
+
+    line->log10BSGL = XLALComputeBSGL ( sumTwoF, sumTwoFX, p->usefulparams->BSGLsetup );
+    if ( xlalErrno != 0 ) {
+      XLALPrintError ("%s line %d : XLALComputeBSGL() failed with xlalErrno = %d.\n\n", __func__, __LINE__, xlalErrno );
+      return;
+    }
+    if ( line->log10BSGL < -LAL_REAL4_MAX*0.1 ) {
+      line->log10BSGL = -LAL_REAL4_MAX*0.1; /* avoid minimum value, needed for output checking in print_gctFstatline_to_str() */
+    }
+  }
+  else {
+    line->log10BSGL = -LAL_REAL4_MAX; /* in non-BSGL case, block field with minimal value, needed for output checking in print_gctFstatline_to_str() */
+  }
+
+  /* take F-stat averages over segments */
+  line->avTwoF = sumTwoF*p->NSegmentsInv; /* average multi-2F by full number of segments */
+  if ( in->sumTwoFX ) {
+    for (UINT4 X = 0; X < in->numDetectors; X++) {
+      line->avTwoFX[X] = sumTwoFX[X]*p->NSegmentsInvX[X]; /* average single-2F by per-IFO number of segments */
+    }
+  }
+
+  if ( in->maxTwoFXl ) { /* if we already have max-per-segment values from the main loop, insert these too */
+    line->maxTwoFl = in->maxTwoFl[ifreq_fg];
+    line->maxTwoFlSeg = in->maxTwoFlIdx[ifreq_fg];
+    for (UINT4 X = 0; X < in->numDetectors; X++) {
+     line->maxTwoFXl[X] = in->maxTwoFXl[FG_FX_INDEX(*in, X, ifreq_fg)];
+     line->maxTwoFXlSeg[X] = in->maxTwoFXlIdx[FG_FX_INDEX(*in, X, ifreq_fg)];
+    }
+
+    line->log10BSGLtL  = XLALComputeBSGLtL ( sumTwoF, sumTwoFX, line->maxTwoFXl, p->usefulparams->BSGLsetup );
+    if ( xlalErrno != 0 ) {
+      XLALPrintError ("%s line %d : XLALComputeBSGLtL() failed with xlalErrno = %d.\n\n", __func__, __LINE__, xlalErrno );
+      return;
+    }
+    if ( line->log10BSGLtL < -LAL_REAL4_MAX*0.1 ) {
+      line->log10BSGLtL = -LAL_REAL4_MAX*0.1; /* avoid minimum value, needed for output checking in print_gctFstatline_to_str() */
+    }
+
+    line->log10BtSGLtL = XLALComputeBtSGLtL ( line->maxTwoFl, sumTwoFX, line->maxTwoFXl, p->usefulparams->BSGLsetup );
+    if ( xlalErrno != 0 ) {
+      XLALPrintError ("%s line %d : XLALComputeBtSGLtL() failed with xlalErrno = %d.\n\n", __func__, __LINE__, xlalErrno );
+      return;
+    }
+    if ( line->log10BtSGLtL < -LAL_REAL4_MAX*0.1 ) {
+      line->log10BtSGLtL = -LAL_REAL4_MAX*0.1; /* avoid minimum value, needed for output checking in print_gctFstatline_to_str() */
+    }
+
+  }
+
+} /* FillSemiCohToplistEntry() */
+
+
 /**
  * Get SemiCoh candidates into toplist(s)
  * This function allows for inserting candidates into up to 3 toplists at once, which might be sorted differently!
+ * A single toplist sorted by 2F is filled with XLALInsertBlockIntoToplist(), so that only
+ * the entries of frequency bins whose 2F is loud enough for the toplist are filled in.
  */
 void UpdateSemiCohToplists ( LALStatus *status,
                              toplist_t *list1,
@@ -2776,9 +2892,9 @@ void UpdateSemiCohToplists ( LALStatus *status,
                              )
 {
 
-  REAL8 freq_fg;
   UINT4 ifreq_fg;
   GCTtopOutputEntry line;
+  SemiCohToplistEntryParams params;
 
   INITSTATUS(status);
   ATTATCHSTATUSPTR (status);
@@ -2787,98 +2903,47 @@ void UpdateSemiCohToplists ( LALStatus *status,
   ASSERT ( in != NULL, status, HIERARCHICALSEARCH_ENULL, HIERARCHICALSEARCH_MSGENULL );
   ASSERT ( usefulparams != NULL, status, HIERARCHICALSEARCH_ENULL, HIERARCHICALSEARCH_MSGENULL );
 
-  /* ---------- Walk through fine-grid and insert candidates into toplist--------------- */
-  for( ifreq_fg = 0; ifreq_fg < in->freqlength; ifreq_fg++ ) {
+  params.in = in;
+  params.f1dot_fg = f1dot_fg;
+  params.f2dot_fg = f2dot_fg;
+  params.f3dot_fg = f3dot_fg;
+  params.usefulparams = usefulparams;
+  params.NSegmentsInv = NSegmentsInv;
+  params.NSegmentsInvX = NSegmentsInvX;
+  params.have_f3dot = have_f3dot;
 
-    freq_fg = in->freqmin_fg + ifreq_fg * in->dfreq_fg;
+  xlalErrno = 0;
 
-    line.Freq = freq_fg; /* NOTE: this is not the final output frequency! For performance reasons, it will only later get correctly extrapolated for the final toplist */
-    line.Alpha = in->alpha;
-    line.Delta = in->delta;
-    line.F1dot = f1dot_fg;
-    line.F2dot = f2dot_fg;
-    line.F3dot = f3dot_fg;
-    line.nc = in->nc[ifreq_fg];
-    line.avTwoF = 0.0; /* will be set to average over segments later */
-    line.maxTwoFl = -1.0; /* initialise this to -1.0, so that it only gets written out by print_gctFstatline_to_str if actually computed */
-    line.maxTwoFlSeg = -1;
-    line.log10BSGL    = -LAL_REAL4_MAX; /* for now, block field with minimal value, needed for output checking in print_gctFstatline_to_str() */
-    line.log10BSGLtL  = -LAL_REAL4_MAX;
-    line.log10BtSGLtL = -LAL_REAL4_MAX;
+  /* ---------- a single toplist sorted by 2F: insert the whole fine-grid frequency block at once --------------- */
+  if ( !list2 && !list3 && list1->key_offset == offsetof(GCTtopOutputEntry, avTwoF) ) {
 
-    line.numDetectors = in->numDetectors;
-    for (UINT4 X = 0; X < PULSAR_MAX_DETECTORS; X++) { /* initialise single-IFO F-stat arrays to zero */
-      line.avTwoFX[X] = 0.0;
-      line.maxTwoFXl[X] = 0.0;
-      line.maxTwoFXlSeg[X] = -1;
-      line.avTwoFXrecalc[X] = 0.0;
-    }
-    line.avTwoFrecalc = -1.0; /* initialise this to -1.0, so that it only gets written out by print_gctFstatline_to_str if later overwritten in recalcToplistStats step */
-    line.log10BSGLrecalc = -LAL_REAL4_MAX; /* for now, block field with minimal value, needed for output checking in print_gctFstatline_to_str() */
-    line.log10BSGLtLrecalc = -LAL_REAL4_MAX; /* for now, block field with minimal value, needed for output checking in print_gctFstatline_to_str() */
-    line.have_f3dot = have_f3dot;
-    line.loudestSeg = -1;
-    line.twoFloudestSeg = -1.0;
-    for (UINT4 X = 0; X < PULSAR_MAX_DETECTORS; X++) {
-      line.twoFXloudestSeg[X] = -1.0;
+    REAL4 *avTwoF = XLALMalloc ( in->freqlength * sizeof(*avTwoF) );
+    if ( avTwoF == NULL ) {
+      ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
     }
-
-    /* local placeholders for summed 2F value over segments, not averages yet */
-    REAL4 sumTwoF = in->sumTwoF[ifreq_fg];
-    REAL4 sumTwoFX[PULSAR_MAX_DETECTORS];
-    if ( in->sumTwoFX ) { /* if we already have FX values from the main loop, insert these, and calculate BSGL here */
-      for (UINT4 X = 0; X < in->numDetectors; X++) {
-        sumTwoFX[X] = in->sumTwoFX[FG_FX_INDEX(*in, X, ifreq_fg)]; /* here it's still the summed 2F value over segments, not the average */
-      }
-      xlalErrno = 0;
-
-      line.log10BSGL = XLALComputeBSGL ( sumTwoF, sumTwoFX, usefulparams->BSGLsetup );
-      if ( xlalErrno != 0 ) {
-        XLALPrintError ("%s line %d : XLALComputeBSGL() failed with xlalErrno = %d.\n\n", __func__, __LINE__, xlalErrno );
-        ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
-      }
-      if ( line.log10BSGL < -LAL_REAL4_MAX*0.1 ) {
-        line.log10BSGL = -LAL_REAL4_MAX*0.1; /* avoid minimum value, needed for output checking in print_gctFstatline_to_str() */
-      }
+    for( ifreq_fg = 0; ifreq_fg < in->freqlength; ifreq_fg++ ) {
+      avTwoF[ifreq_fg] = in->sumTwoF[ifreq_fg]*NSegmentsInv; /* same as the avTwoF of the toplist entry */
     }
-    else {
-      line.log10BSGL = -LAL_REAL4_MAX; /* in non-BSGL case, block field with minimal value, needed for output checking in print_gctFstatline_to_str() */
+    int inserted = XLALInsertBlockIntoToplist ( list1, avTwoF, in->freqlength, FillSemiCohToplistEntry, &params );
+    XLALFree ( avTwoF );
+    if ( inserted < 0 ) {
+      ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
     }
-
-    /* take F-stat averages over segments */
-    line.avTwoF = sumTwoF*NSegmentsInv; /* average multi-2F by full number of segments */
-    if ( in->sumTwoFX ) {
-      for (UINT4 X = 0; X < in->numDetectors; X++) {
-        line.avTwoFX[X] = sumTwoFX[X]*NSegmentsInvX[X]; /* average single-2F by per-IFO number of segments */
-      }
+    if ( xlalErrno != 0 ) {
+      ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
     }
 
-    if ( in->maxTwoFXl ) { /* if we already have max-per-segment values from the main loop, insert these too */
-      line.maxTwoFl = in->maxTwoFl[ifreq_fg];
-      line.maxTwoFlSeg = in->maxTwoFlIdx[ifreq_fg];
-      for (UINT4 X = 0; X < in->numDetectors; X++) {
-       line.maxTwoFXl[X] = in->maxTwoFXl[FG_FX_INDEX(*in, X, ifreq_fg)];
-       line.maxTwoFXlSeg[X] = in->maxTwoFXlIdx[FG_FX_INDEX(*in, X, ifreq_fg)];
-      }
+    DETATCHSTATUSPTR (status);
+    RETURN(status);
 
-      line.log10BSGLtL  = XLALComputeBSGLtL ( sumTwoF, sumTwoFX, line.maxTwoFXl, usefulparams->BSGLsetup );
-      if ( xlalErrno != 0 ) {
-        XLALPrintError ("%s line %d : XLALComputeBSGLtL() failed with xlalErrno = %d.\n\n", __func__, __LINE__, xlalErrno );
-        ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
-      }
-      if ( line.log10BSGLtL < -LAL_REAL4_MAX*0.1 ) {
-        line.log10BSGLtL = -LAL_REAL4_MAX*0.1; /* avoid minimum value, needed for output checking in print_gctFstatline_to_str() */
-      }
+  }
 
-      line.log10BtSGLtL = XLALComputeBtSGLtL ( line.maxTwoFl, sumTwoFX, line.maxTwoFXl, usefulparams->BSGLsetup );
-      if ( xlalErrno != 0 ) {
-        XLALPrintError ("%s line %d : XLALComputeBtSGLtL() failed with xlalErrno = %d.\n\n", __func__, __LINE__, xlalErrno );
-        ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
-      }
-      if ( line.log10BtSGLtL < -LAL_REAL4_MAX*0.1 ) {
-        line.log10BtSGLtL = -LAL_REAL4_MAX*0.1; /* avoid minimum value, needed for output checking in print_gctFstatline_to_str() */
-      }
+  /* ---------- Walk through fine-grid and insert candidates into toplist--------------- */
+  for( ifreq_fg = 0; ifreq_fg < in->freqlength; ifreq_fg++ ) {
 
+    FillSemiCohToplistEntry ( &line, ifreq_fg, &params );
+    if ( xlalErrno != 0 ) {
+      ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
     }
 
     insert_into_gctFstat_toplist( list1, &line);
@@ -0,0 +1,121 @@
+/*
+*  Copyright (C) 2007 Bernd Machenschalk, Reinhard Prix
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+/* The heap toplist now lives in lalpulsar as <lal/HeapToplist.h>, with
+   XLAL conventions. This header maps the names, types and return codes of
+   the former lalapps copies onto it, so that the searches need not be changed. */
+
+#ifndef HEAPTOPLISTCOMPAT_H
+#define HEAPTOPLISTCOMPAT_H
+
+#include <lal/HeapToplist.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+typedef LALHeapToplist toplist_t;
+
+/* return non-zero value iff the passed element would be inserted into
+   the toplist by calling insert_into_toplist, but no actual insertion is done.
+   Can be called with a partially filled element to decide whether
+   further processing of a candidate is even necessary. The field(s) used
+   for sorting the toplist must be filled */
+#define TEST_FSTAT_TOPLIST_INCLUSION(list, element) \
+ ( ( (list)->elems < (list)->length ||( ((list)->smaller)  ((const void *)(element),((list)->heap)[0]) < 0) ) )
+
+/* returns -1 on error (out of memory), else 0 */
+static inline int create_toplist(toplist_t**list, size_t length, size_t size,
+                                 int (*smaller)(const void *, const void *)) {
+  *list = XLALCreateToplist(length, size, smaller);
+  return (*list == NULL) ? -1 : 0;
+}
+
+static inline void free_toplist(toplist_t**list) {
+  XLALDestroyToplist(*list);
+  *list = NULL;
+}
+
+/* returns 1 if the element was actually inserted, 0 if not */
+static inline int insert_into_toplist(toplist_t*list, void *element) {
+  return XLALInsertIntoToplist(list, element);
+}
+
+static inline void clear_toplist(toplist_t*list) {
+  XLALClearToplist(list);
+}
+
+static inline void go_through_toplist(toplist_t*list, void (*handle)(void *)) {
+  XLALGoThroughToplist(list, handle);
+}
+
+static inline void qsort_toplist(toplist_t*list, int (*compare)(const void *, const void *)) {
+  XLALQSortToplist(list, compare);
+}
+
+static inline void qsort_toplist_r(toplist_t*list, int (*compare)(const void *, const void *)) {
+  XLALQSortToplistReverse(list, compare);
+}
+
+/* returns a NULL pointer if the index is out of bounds */
+static inline void* toplist_elem(toplist_t*list, size_t idx) {
+  if ((list == NULL) || (idx >= list->elems))
+    return NULL;
+  return XLALToplistElem(list, idx);
+}
+
+/* returns -1 if list1 is "smaller", 1 if list2 is "smaller", 0 if they are equal,
+   2 if they are uncomparable (different data types or "smaller" functions) */
+static inline int compare_toplists(toplist_t*list1, toplist_t*list2) {
+  int cmp = 0;
+  if ((list1 == NULL) || (list2 == NULL) ||
+      (list1->smaller != list2->smaller) || (list1->size != list2->size))
+    return 2;
+  XLALCompareToplists(&cmp, list1, list2);
+  return cmp;
+}
+
+/* returns -1 in case of an I/O error, -2 if out of memory, 0 otherwise (successful) */
+static inline int write_toplist_checkpoint(const char*filename, toplist_t*const*lists, size_t nlists,
+                                           UINT4 counter, UINT4*sync_failures) {
+  int errnum = 0;
+  XLAL_TRY(XLALWriteToplistCheckpoint(filename, lists, nlists, counter, sync_failures), errnum);
+  if (errnum != 0)
+    return (errnum == XLAL_ENOMEM) ? -2 : -1;
+  return 0;
+}
+
+/* returns 0 if successfully read a checkpoint, 1 if no checkpoint was found,
+   -1 in case of an I/O error, -2 if the checksum was wrong or the checkpoint
+   doesn't match the toplists */
+static inline int read_toplist_checkpoint(const char*filename, toplist_t*const*lists, size_t nlists,
+                                          UINT4*counter) {
+  BOOLEAN found = 0;
+  int errnum = 0;
+  XLAL_TRY(XLALReadToplistCheckpoint(filename, lists, nlists, counter, &found), errnum);
+  if (errnum != 0)
+    return (errnum == XLAL_EIO) ? -1 : -2;
+  return (found || (filename == NULL)) ? 0 : 1;
+}
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* HEAPTOPLISTCOMPAT_H - double inclusion protection */
@@ -1116,9 +1116,13 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
 
   EphemerisData *edat=NULL;
   TimeCorrectionData *tdat=NULL;
-  BarycenterInput baryinput, baryinput2;
-  EarthState earth, earth2;
-  EmissionTime  emit, emit2;
+  BarycenterInput baryinput;
+  EarthState earth;
+  EmissionTime  emit;
+
+  SSBDelayLookupTable *ssbtable = NULL;
+  REAL8Vector *ssbdts = NULL, *ssbdtsdot = NULL;
+  REAL8 ssbdt = 0., ssbdt2 = 0.;
 
   BinaryPulsarInput binInput, binInput2;
   BinaryPulsarOutput binOutput, binOutput2;
@@ -1270,6 +1274,34 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
     fpphase = fopen("phase.txt", "w");
   }
 
+  /* for the fine heterodyne all the data times are known, so interpolate the
+     solar system barycentre delays (and their derivatives, needed for the
+     filter response correction) from a coarse grid of Earth states rather
+     than barycentring every sample */
+  if( ( hetParams.heterodyneflag == 1 || hetParams.heterodyneflag == 2 ||
+    hetParams.heterodyneflag == 4 ) && hetParams.length > 0 ){
+    LIGOTimeGPSVector *gpstimes = NULL;
+    BarycenterInput ssbsource = baryinput;
+
+    dtpos = hetParams.timestamp - posepochu;
+    ssbsource.delta = decu + dtpos*pmdecu;
+    ssbsource.alpha = rau + dtpos*pmrau/cos(ssbsource.delta);
+
+    XLAL_CHECK_VOID( (gpstimes = XLALCreateTimestampVector( hetParams.length )) != NULL, XLAL_EFUNC );
+    for( i=0; i<hetParams.length; i++ ){ XLALGPSSetREAL8( &gpstimes->data[i], times->data[i] ); }
+
+    XLAL_CHECK_VOID( (ssbtable = XLALCreateSSBDelayLookupTable( gpstimes, &hetParams.detector, edat, tdat, hetParams.ttype, 0. )) != NULL, XLAL_EFUNC );
+
+    ssbdts = XLALCreateREAL8Vector( hetParams.length );
+    ssbdtsdot = XLALCreateREAL8Vector( hetParams.length );
+    XLAL_CHECK_VOID( ssbdts != NULL && ssbdtsdot != NULL, XLAL_EFUNC );
+
+    /* the variable GW speed is applied to the whole phase below, so is not passed here */
+    XLAL_CHECK_VOID( XLALSSBDelayLookupTableGetDelays( ssbdts, ssbdtsdot, NULL, ssbtable, gpstimes, &ssbsource, 0., 0., 0., 0. ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    XLALDestroyTimestampVector( gpstimes );
+  }
+
   for(i=0;i<hetParams.length;i++){
 
 /******************************************************************************/
@@ -1400,35 +1432,22 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
       REAL8 tWave1 = 0., tWave2 = 0.;
       phaseWave = 0.;
 
-      /* set up XLALBarycenter */
-      dtpos = hetParams.timestamp - posepochu;
-
-      baryinput.delta = decu + dtpos*pmdecu;
-      baryinput.alpha = rau + dtpos*pmrau/cos(baryinput.delta);
-
       t = times->data[i]; /* get data time */
       t2 = times->data[i] + 1.; /* just add a second to get the gradient */
 
-      baryinput2 = baryinput;
-
-      XLALGPSSetREAL8(&baryinput.tgps, t);
-      XLALGPSSetREAL8(&baryinput2.tgps, t2);
-
-      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, edat,
-        tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_VOID( XLALBarycenter( &emit, &baryinput, &earth ) ==
-                       XLAL_SUCCESS, XLAL_EFUNC );
-
-      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth2, &baryinput2.tgps, edat,
-        tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_VOID( XLALBarycenter( &emit2, &baryinput2, &earth2 ) ==
-                       XLAL_SUCCESS, XLAL_EFUNC );
+      /* interpolated SSB delays at t and t2 */
+      ssbdt = ssbdts->data[i];
+      ssbdt2 = ssbdt + ssbdtsdot->data[i];
 
       /* if binary pulsar add extra time delay */
       if( PulsarCheckParam( hetParams.hetUpdate, "BINARY" ) ){
+        LIGOTimeGPS gps;
+        XLALGPSSetREAL8(&gps, t);
+        XLALGetEarthPosVel( &earth, edat, &gps );
+
         /* input SSB time into binary timing function */
-        binInput.tb = t + emit.deltaT;
-        binInput2.tb = t2 + emit2.deltaT;
+        binInput.tb = t + ssbdt;
+        binInput2.tb = t2 + ssbdt2;
         binInput.earth = binInput2.earth = earth;
 
         /* calculate binary time delay */
@@ -1436,17 +1455,17 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
         XLALBinaryPulsarDeltaTNew( &binOutput2, &binInput2, hetParams.hetUpdate );
 
         /* add binary time delay */
-        tdt = (t - T0Update) + emit.deltaT + binOutput.deltaT;
+        tdt = (t - T0Update) + ssbdt + binOutput.deltaT;
       }
       else{
-        tdt = (t - T0Update) + emit.deltaT;
+        tdt = (t - T0Update) + ssbdt;
         binOutput.deltaT = 0.;
         binOutput2.deltaT = 0.;
       }
 
       /* check if any timing noise whitening is used */
       if ( PulsarCheckParam( hetParams.hetUpdate, "WAVESIN" ) && PulsarCheckParam( hetParams.hetUpdate, "WAVECOS" ) ){
-        REAL8 dtWave = (XLALGPSGetREAL8(&emit.te) - waveepochu)/86400.; /* in days */
+        REAL8 dtWave = (t + ssbdt - waveepochu)/86400.; /* in days */
 
         const REAL8Vector *wavesin = PulsarGetREAL8VectorParam( hetParams.hetUpdate, "WAVESIN" );
         const REAL8Vector *wavecos = PulsarGetREAL8VectorParam( hetParams.hetUpdate, "WAVECOS" );
@@ -1460,7 +1479,7 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
 
       if( filtresp != NULL ){
         /* calculate df  = f*(dt(t2) - dt(t))/(t2 - t) here (t2 - t) is 1 sec */
-        df = fcoarse*(emit2.deltaT - emit.deltaT + binOutput2.deltaT - binOutput.deltaT + tWave2 - tWave1);
+        df = fcoarse*(ssbdt2 - ssbdt + binOutput2.deltaT - binOutput.deltaT + tWave2 - tWave1);
         if ( cgwu > 0. && cgwu < 1. ){ df /= cgwu; }
         df += (ffine - fcoarse);
 
@@ -1546,6 +1565,10 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
       I * (creal(dataTemp)*sin(-deltaphase) + cimag(dataTemp)*cos(-deltaphase));
   }
 
+  XLALDestroySSBDelayLookupTable( ssbtable );
+  if ( ssbdts != NULL ){ XLALDestroyREAL8Vector( ssbdts ); }
+  if ( ssbdtsdot != NULL ){ XLALDestroyREAL8Vector( ssbdtsdot ); }
+
   if(hetParams.heterodyneflag > 0){
     XLALDestroyEphemerisData( edat );
 
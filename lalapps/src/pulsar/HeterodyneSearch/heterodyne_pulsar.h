@@ -55,6 +55,7 @@
 #include <lal/ZPGFilter.h>
 #include <lal/LALBarycenter.h>
 #include <lal/LALInitBarycenter.h>
+#include <lal/HeterodynedPulsarModel.h>
 #include <lal/SkyCoordinates.h>
 #include <lal/DetectorSite.h>
 #include <lal/DetResponse.h>
@@ -23,7 +23,7 @@
 #include <unistd.h>
 #endif
 #include "FstatToplist.h"
-#include "HeapToplist.h"
+#include "../HeapToplistCompat.h"
 #include <lal/StringInput.h> /* for LAL_REAL8_FORMAT etc. */
 
 #include <lal/LALStdio.h>
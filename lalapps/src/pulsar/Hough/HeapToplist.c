@@ -1 +0,0 @@
-../Fstatistic/HeapToplist.c
\ No newline at end of file
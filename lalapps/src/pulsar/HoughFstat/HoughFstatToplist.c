@@ -24,7 +24,7 @@
 #include <unistd.h>
 #endif
 #include "HoughFstatToplist.h"
-#include "HeapToplist.h"
+#include "../HeapToplistCompat.h"
 #include <lal/StringInput.h> /* for LAL_REAL8_FORMAT etc. */
 #include <lal/AVFactories.h> /* for XLALDestroyREAL4Vector */
 
@@ -20,7 +20,7 @@
 #ifndef HOUGHFSTATTOPLIST_H
 #define HOUGHFSTATTOPLIST_H
 
-#include "HeapToplist.h"
+#include "../HeapToplistCompat.h"
 #include <lal/LALDatatypes.h>
 
 
@@ -87,10 +87,13 @@ int main(void) {fputs("disabled, no gsl or no lal frame library support.\n", std
 #include <lal/AVFactories.h>
 #include <lal/LALCache.h>
 #include <lal/LALFrStream.h>
+#include <lal/TimeSeries.h>
 #include <lal/Window.h>
 #include <lal/Calibration.h>
 #include <lal/LALConstants.h>
 #include <lal/BandPassTimeSeries.h>
+#include <lal/IIRFilter.h>
+#include <lal/ZPGFilter.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALConstants.h>
 #include <lal/AVFactories.h>
@@ -106,6 +109,10 @@ int main(void) {fputs("disabled, no gsl or no lal frame library support.\n", std
 #include <XLALPSSInterface.h>
 #endif
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 /* track memory usage under linux */
 #define TRACKMEMUSE 0
 
@@ -119,6 +126,13 @@ int main(void) {fputs("disabled, no gsl or no lal frame library support.\n", std
 #define TESTSTATUS( pstat ) \
   if ( (pstat)->statusCode ) { REPORTSTATUS(pstat); return 100; } else ((void)0)
 
+/* stream-data mode: order of the Butterworth high-pass filter (as used by HighPass()), */
+/* seconds of data read from the frames at a time, and length in cycles of the high-pass */
+/* frequency of the data beyond the end of each SFT used to start the reverse filter */
+#define STREAMHPORDER      10
+#define STREAMBLOCKSEC     256
+#define STREAMHPPADCYCLES  64.0
+
 /***************************************************************************/
 
 /* STRUCTURES */
@@ -146,6 +160,8 @@ struct CommandLineArgsTag {
   REAL8 overlapFraction;   /* 12/28/05 gam; overlap fraction (for use with windows; e.g., use -P 0.5 with -w 3 Hann windows; default is 1.0). */
   BOOLEAN useSingle;       /* 11/19/05 gam; use single rather than double precision */
   char *frameStructType;   /* 01/10/07 gam */
+  BOOLEAN streamData;      /* read the segment once, high pass it continuously, and make all SFTs from it */
+  INT4 numThreads;         /* number of threads windowing, FFTing, and writing SFTs in stream-data mode */
 } CommandLineArgs;
 
 struct headertag {
@@ -155,7 +171,33 @@ struct headertag {
   REAL8 tbase;
   INT4  firstfreqindex;
   INT4  nsamples;
-} header;
+};
+
+/* stream-data mode: SFTs waiting to be windowed, FFTed, and written by the worker threads */
+typedef struct tagStreamSFTJob {
+  LIGOTimeGPS epoch;
+  REAL8Vector *data;
+} StreamSFTJob;
+
+typedef struct tagStreamSFTQueue {
+  struct CommandLineArgsTag CLA;
+  REAL8 deltaT;
+  REAL8Vector *window;         /* window coefficients, or NULL for no window */
+  REAL8 windowRMS;
+  REAL8FFTPlan *fftPlanDouble; /* one plan shared by all workers */
+  REAL4FFTPlan *fftPlanSingle;
+  StreamSFTJob *jobs;          /* circular buffer of jobs */
+  UINT4 size, head, count;
+  INT4 done;                   /* set when no more jobs will be queued */
+  INT4 errcode;                /* first non-zero return code of a worker */
+  INT4 started;                /* set by StreamQueueStart() */
+  UINT4 numWorkers;            /* 0 = process jobs in the reading thread */
+#ifdef LAL_PTHREAD_LOCK
+  pthread_t *workers;
+  pthread_mutex_t lock;
+  pthread_cond_t notEmpty, notFull;
+#endif
+} StreamSFTQueue;
 
 
 /***************************************************************************/
@@ -223,10 +265,21 @@ int CreateSFT(struct CommandLineArgsTag CLA);
 /* writes out an SFT */
 int WriteSFT(struct CommandLineArgsTag CLA);
 int WriteVersion2SFT(struct CommandLineArgsTag CLA);
+int WriteSFTData(struct CommandLineArgsTag CLA, LIGOTimeGPS epoch, REAL8 deltaT, COMPLEX8Vector *fftSingle, COMPLEX16Vector *fftDouble);
+int WriteVersion2SFTData(struct CommandLineArgsTag CLA, LIGOTimeGPS epoch, REAL8 deltaT, REAL8 windowRMS, COMPLEX8Vector *fftSingle, COMPLEX16Vector *fftDouble);
 
 /* Frees the memory */
 int FreeMem(struct CommandLineArgsTag CLA);
 
+/* stream-data mode */
+int MakeSFTsStream(struct CommandLineArgsTag CLA);
+int CreateStreamHighPass(REAL8 HPf, REAL8 deltaT, REAL8IIRFilter **sections);
+int CreateStreamWindow(struct CommandLineArgsTag CLA, UINT4 length, REAL8Vector **window, REAL8 *windowRMS);
+int StreamProcessSFT(const StreamSFTQueue *queue, LIGOTimeGPS epoch, REAL8Vector *data);
+int StreamQueueStart(StreamSFTQueue *queue, UINT4 numThreads);
+int StreamQueuePush(StreamSFTQueue *queue, LIGOTimeGPS epoch, REAL8Vector *data);
+int StreamQueueFinish(StreamSFTQueue *queue);
+
 /* prototypes */
 FILE* tryopen(char *name, const char *mode);
 void getSFTDescField(CHAR *sftDescField, CHAR *numSFTs, CHAR *ifo, CHAR *stringT, CHAR *typeMisc);
@@ -508,6 +561,16 @@ int main(int argc,char *argv[])
   gpsepoch.gpsSeconds = CommandLineArgs.GPSStart;
   gpsepoch.gpsNanoSeconds = 0;
 
+  /* read the whole segment once and make all SFTs from it */
+  if (CommandLineArgs.streamData) {
+    INT4 retval = MakeSFTsStream(CommandLineArgs);
+    if (retval) return retval;
+    LALFrClose(&status,&framestream);
+    TESTSTATUS( &status );
+    LALCheckMemoryLeaks();
+    return 0;
+  }
+
   /* Allocates space for data */
   if (AllocateData(CommandLineArgs)) return 2;
 
@@ -598,6 +661,8 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
     {"window-radius",        required_argument, NULL,          'r'},
     {"overlap-fraction",     required_argument, NULL,          'P'},
     {"td-cleaning",          no_argument,       NULL,          'a'},
+    {"stream-data",          no_argument,       NULL,          600},
+    {"num-threads",          required_argument, NULL,          601},
 #ifdef PSS_ENABLED
     {"pss-freq",             required_argument, NULL,          'b'},
     {"pss-abs",              required_argument, NULL,          512},
@@ -639,6 +704,8 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
   CLA->PSSCleaning = 0;	     /* 1=YES and 0=NO*/
   CLA->PSSCleanHPf = 100.0;  /* Cut frequency for the bilateral highpass filter. It has to be used only if PSSCleaning is YES. defaults to 100Hz */
   CLA->PSSCleanExt = 1;      /* by default, extend the timeseries */
+  CLA->streamData = 0;       /* by default, read and filter the data for each SFT separately */
+  CLA->numThreads = 1;
 
   strcat(allargs, "\nMakeSFTs ");
   strcat(allargs, lalVCSIdentInfo.vcsId);
@@ -775,6 +842,12 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
     case 'b':
       CLA->PSSCleanHPf = atof(LALoptarg);
       break;
+    case 600:
+      CLA->streamData = 1;
+      break;
+    case 601:
+      CLA->numThreads = atoi(LALoptarg);
+      break;
 #ifdef PSS_ENABLED
     case 512:
       XLALPSSParams.abs  = atof(LALoptarg);
@@ -825,6 +898,8 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
       fprintf(stdout,"\tuse-single (-S)\t\tFLAG\t (optional) Use single precision for window, plan, and fft; double precision filtering is always done.\n");
       fprintf(stdout,"\tframe-struct-type (-u)\tSTRING\t (optional) String specifying the input frame structure and data type. Must begin with ADC_ or PROC_ followed by REAL4, REAL8, INT2, INT4, or INT8; default: ADC_REAL4; -H is the same as PROC_REAL8.\n");
       fprintf(stdout,"\ttd-cleaning (-a)\tFLAG\t Use time-domain cleaning with PSS routines\n");
+      fprintf(stdout,"\tstream-data        \tFLAG\t (optional) Read the data from gps-start-time to gps-end-time once, high pass it continuously, and make all SFTs from it; cannot be used with td-cleaning.\n");
+      fprintf(stdout,"\tnum-threads        \tINT\t (optional) Number of threads that window, FFT, and write SFTs in stream-data mode; up to twice this many SFTs of time-domain data are held in memory (default is 1).\n");
 #ifdef PSS_ENABLED
       fprintf(stdout,"\tpss-freq (-b)      \tFLOAT\t Cut frequency for the bilateral highpass filter for time-domain cleaning\n");
       fprintf(stdout,"\tpss-abs            \tFLOAT\t (optional) Set PSS parameter 'abs' for time-domain cleaning\n");
@@ -933,6 +1008,18 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
       fprintf(stderr,"Try %s -h \n", argv[0]);
       return 1;
     }      
+  if(CLA->numThreads < 1)
+    {
+      fprintf(stderr,"Illegal num-threads given.\n");
+      fprintf(stderr,"Try %s -h \n", argv[0]);
+      return 1;
+    }
+  if(CLA->streamData && CLA->PSSCleaning)
+    {
+      fprintf(stderr,"Time-domain cleaning cannot be used with stream-data.\n");
+      fprintf(stderr,"Try %s -h \n", argv[0]);
+      return 1;
+    }
   if(CLA->PSSCleaning)
 #ifdef PSS_ENABLED
     {
@@ -1892,6 +1979,40 @@ int PSSTDCleaningDouble(struct CommandLineArgsTag CLA) {
 /*******************************************************************************/
 int WriteSFT(struct CommandLineArgsTag CLA)
 {
+  int retval;
+
+  /* 11/19/05 gam */
+  if(CLA.useSingle) {
+    if ( (retval = WriteSFTData(CLA, gpsepoch, dataSingle.deltaT, fftDataSingle, NULL)) ) return retval;
+    #if PRINTEXAMPLEDATA
+        printf("\nExample real and imaginary SFT values going to file from fftDataSingle in WriteSFT:\n"); printExampleSFTDataGoingToFile(CLA);
+    #endif
+    LALCDestroyVector( &status, &fftDataSingle );
+    TESTSTATUS( &status );
+    #if TRACKMEMUSE
+      printf("Memory use after destroying fftDataSingle in WriteSFT:\n"); printmemuse();
+    #endif
+  } else {
+    if ( (retval = WriteSFTData(CLA, gpsepoch, dataDouble.deltaT, NULL, fftDataDouble)) ) return retval;
+    #if PRINTEXAMPLEDATA
+        printf("\nExample real and imaginary SFT values going to file from fftDataDouble in WriteSFT:\n"); printExampleSFTDataGoingToFile(CLA);
+    #endif
+    LALZDestroyVector( &status, &fftDataDouble );
+    TESTSTATUS( &status );
+    #if TRACKMEMUSE
+      printf("Memory use after destroying fftDataDouble in WriteSFT:\n"); printmemuse();
+    #endif
+  }
+
+  return 0;
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+/* write out a version 1 SFT from the given FFT data; the stream-data workers call this directly */
+int WriteSFTData(struct CommandLineArgsTag CLA, LIGOTimeGPS epoch, REAL8 deltaT, COMPLEX8Vector *fftSingle, COMPLEX16Vector *fftDouble)
+{
+  struct headertag sftheader;
   char sftname[256];
   char sftnameFinal[256]; /* 01/09/06 gam */
   char numSFTs[2]; /* 12/27/05 gam */
@@ -1914,7 +2035,7 @@ int WriteSFT(struct CommandLineArgsTag CLA)
     strncpy( ifo, CLA.ChannelName, 2 );
   }
   ifo[2] = '\0'; /* null terminate */
-  sprintf(gpstime,"%09d",gpsepoch.gpsSeconds);
+  sprintf(gpstime,"%09d",epoch.gpsSeconds);
 
   strcpy( sftname, CLA.SFTpath );
   /* 12/27/05 gam; add option to make directories based on gps time */
@@ -1948,13 +2069,13 @@ int WriteSFT(struct CommandLineArgsTag CLA)
   fpsft=tryopen(sftname,"w");
 
   /* write header */
-  header.endian=1.0;
-  header.gps_sec=gpsepoch.gpsSeconds;
-  header.gps_nsec=gpsepoch.gpsNanoSeconds;
-  header.tbase=CLA.T;
-  header.firstfreqindex=firstbin;
-  header.nsamples=(INT4)(DF*CLA.T+0.5);
-  if (1!=fwrite((void*)&header,sizeof(header),1,fpsft)){
+  sftheader.endian=1.0;
+  sftheader.gps_sec=epoch.gpsSeconds;
+  sftheader.gps_nsec=epoch.gpsNanoSeconds;
+  sftheader.tbase=CLA.T;
+  sftheader.firstfreqindex=firstbin;
+  sftheader.nsamples=(INT4)(DF*CLA.T+0.5);
+  if (1!=fwrite((void*)&sftheader,sizeof(sftheader),1,fpsft)){
     fprintf(stderr,"Error in writing header into file %s!\n",sftname);
     return 7;
   }
@@ -1962,12 +2083,12 @@ int WriteSFT(struct CommandLineArgsTag CLA)
   /* 11/19/05 gam */
   if(CLA.useSingle) {
     /* Write SFT */
-    for (k=0; k<header.nsamples; k++)
+    for (k=0; k<sftheader.nsamples; k++)
     {
-      rpw=((REAL4)(((REAL8)DF)/(0.5*(REAL8)(1/dataSingle.deltaT))))
-	* crealf(fftDataSingle->data[k+firstbin]);
-      ipw=((REAL4)(((REAL8)DF)/(0.5*(REAL8)(1/dataSingle.deltaT))))
-	* cimagf(fftDataSingle->data[k+firstbin]);
+      rpw=((REAL4)(((REAL8)DF)/(0.5*(REAL8)(1/deltaT))))
+	* crealf(fftSingle->data[k+firstbin]);
+      ipw=((REAL4)(((REAL8)DF)/(0.5*(REAL8)(1/deltaT))))
+	* cimagf(fftSingle->data[k+firstbin]);
       /* 06/26/07 gam; use finite to check that data does not contains a non-FINITE (+/- Inf, NaN) values */
       #if CHECKFORINFINITEANDNANS
         if (!isfinite(rpw) || !isfinite(ipw)) {
@@ -1978,22 +2099,14 @@ int WriteSFT(struct CommandLineArgsTag CLA)
       errorcode1=fwrite((void*)&rpw, sizeof(REAL4),1,fpsft);
       errorcode2=fwrite((void*)&ipw, sizeof(REAL4),1,fpsft);
     }
-    #if PRINTEXAMPLEDATA
-        printf("\nExample real and imaginary SFT values going to file from fftDataSingle in WriteSFT:\n"); printExampleSFTDataGoingToFile(CLA);
-    #endif     
-    LALCDestroyVector( &status, &fftDataSingle );
-    TESTSTATUS( &status );
-    #if TRACKMEMUSE
-      printf("Memory use after destroying fftDataSingle in WriteSFT:\n"); printmemuse();
-    #endif
   } else {    
     /* Write SFT */
-    for (k=0; k<header.nsamples; k++)
+    for (k=0; k<sftheader.nsamples; k++)
     {
-      rpw=(((REAL8)DF)/(0.5*(REAL8)(1/dataDouble.deltaT))) 
-	* creal(fftDataDouble->data[k+firstbin]);
-      ipw=(((REAL8)DF)/(0.5*(REAL8)(1/dataDouble.deltaT))) 
-	* cimag(fftDataDouble->data[k+firstbin]);
+      rpw=(((REAL8)DF)/(0.5*(REAL8)(1/deltaT))) 
+	* creal(fftDouble->data[k+firstbin]);
+      ipw=(((REAL8)DF)/(0.5*(REAL8)(1/deltaT))) 
+	* cimag(fftDouble->data[k+firstbin]);
       /* 06/26/07 gam; use finite to check that data does not contains a non-FINITE (+/- Inf, NaN) values */
       #if CHECKFORINFINITEANDNANS
         if (!isfinite(rpw) || !isfinite(ipw)) {
@@ -2004,14 +2117,6 @@ int WriteSFT(struct CommandLineArgsTag CLA)
       errorcode1=fwrite((void*)&rpw, sizeof(REAL4),1,fpsft);
       errorcode2=fwrite((void*)&ipw, sizeof(REAL4),1,fpsft);
     }
-    #if PRINTEXAMPLEDATA
-        printf("\nExample real and imaginary SFT values going to file from fftDataDouble in WriteSFT:\n"); printExampleSFTDataGoingToFile(CLA);
-    #endif
-    LALZDestroyVector( &status, &fftDataDouble );
-    TESTSTATUS( &status );
-    #if TRACKMEMUSE
-      printf("Memory use after destroying fftDataDouble in WriteSFT:\n"); printmemuse();
-    #endif
   }
 
   /* Check that there were no errors while writing SFTS */
@@ -2034,7 +2139,34 @@ int WriteSFT(struct CommandLineArgsTag CLA)
 
 /*******************************************************************************/
 /* 12/28/05 gam; write out version 2 SFT */
-int WriteVersion2SFT(struct CommandLineArgsTag CLA) 
+int WriteVersion2SFT(struct CommandLineArgsTag CLA)
+{
+  int retval;
+
+  /* 11/19/05 gam */
+  if(CLA.useSingle) {
+    if ( (retval = WriteVersion2SFTData(CLA, gpsepoch, dataSingle.deltaT, winFncRMS, fftDataSingle, NULL)) ) return retval;
+    LALCDestroyVector( &status, &fftDataSingle );
+    TESTSTATUS( &status );
+    #if TRACKMEMUSE
+      printf("Memory use after destroying fftDataSingle in WriteVersion2SFT:\n"); printmemuse();
+    #endif
+  } else {
+    if ( (retval = WriteVersion2SFTData(CLA, gpsepoch, dataDouble.deltaT, winFncRMS, NULL, fftDataDouble)) ) return retval;
+    LALZDestroyVector( &status, &fftDataDouble );
+    TESTSTATUS( &status );
+    #if TRACKMEMUSE
+      printf("Memory use after destroying fftDataDouble in WriteVersion2SFT:\n"); printmemuse();
+    #endif
+  }
+
+  return 0;
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+/* write out a version 2 SFT from the given FFT data; the stream-data workers call this directly */
+int WriteVersion2SFTData(struct CommandLineArgsTag CLA, LIGOTimeGPS epoch, REAL8 deltaT, REAL8 windowRMS, COMPLEX8Vector *fftSingle, COMPLEX16Vector *fftDouble)
 {
   char sftname[256];
   char sftFilename[256];
@@ -2060,7 +2192,7 @@ int WriteVersion2SFT(struct CommandLineArgsTag CLA)
     strncpy( ifo, CLA.ChannelName, 2 );
   }
   ifo[2] = '\0'; /* null terminate */
-  sprintf(gpstime,"%09d",gpsepoch.gpsSeconds);
+  sprintf(gpstime,"%09d",epoch.gpsSeconds);
 
   strcpy( sftname, CLA.SFTpath );
   /* 12/27/05 gam; add option to make directories based on gps time */
@@ -2092,18 +2224,18 @@ int WriteVersion2SFT(struct CommandLineArgsTag CLA)
   
   /* copy the data to oneSFT */
   strcpy(oneSFT->name,ifo);
-  oneSFT->epoch.gpsSeconds=gpsepoch.gpsSeconds;
-  oneSFT->epoch.gpsNanoSeconds=gpsepoch.gpsNanoSeconds;
+  oneSFT->epoch.gpsSeconds=epoch.gpsSeconds;
+  oneSFT->epoch.gpsNanoSeconds=epoch.gpsNanoSeconds;
   oneSFT->f0 = FMIN;
   oneSFT->deltaF = 1.0/((REAL8)CLA.T);
   oneSFT->data->length=nBins;
   
   if(CLA.useSingle) {
     /* singleDeltaT = ((REAL4)dataSingle.deltaT); */ /* 01/05/06 gam; and normalize SFTs using this below */
-    singleDeltaT = (REAL4)(dataSingle.deltaT/winFncRMS); /* include 1 over window function RMS */
+    singleDeltaT = (REAL4)(deltaT/windowRMS); /* include 1 over window function RMS */
     for (k=0; k<nBins; k++)
     {
-      oneSFT->data->data[k] = (((REAL4) singleDeltaT) * fftDataSingle->data[k+firstbin]);
+      oneSFT->data->data[k] = (((REAL4) singleDeltaT) * fftSingle->data[k+firstbin]);
       /* 06/26/07 gam; use finite to check that data does not contains a non-FINITE (+/- Inf, NaN) values */
       #if CHECKFORINFINITEANDNANS
         if (!isfinite(crealf(oneSFT->data->data[k])) || !isfinite(cimagf(oneSFT->data->data[k]))) {
@@ -2115,17 +2247,12 @@ int WriteVersion2SFT(struct CommandLineArgsTag CLA)
     #if PRINTEXAMPLEDATA
         printf("\nExample real and imaginary SFT values going to file from fftDataSingle in WriteVersion2SFT:\n"); printExampleVersion2SFTDataGoingToFile(CLA,oneSFT);
     #endif
-    LALCDestroyVector( &status, &fftDataSingle );
-    TESTSTATUS( &status );
-    #if TRACKMEMUSE
-      printf("Memory use after destroying fftDataSingle in WriteVersion2SFT:\n"); printmemuse();
-    #endif
   } else {
     /*doubleDeltaT = ((REAL8)dataDouble.deltaT); */ /* 01/05/06 gam; and normalize SFTs using this below */
-    doubleDeltaT = (REAL8)(dataDouble.deltaT/winFncRMS); /* include 1 over window function RMS */
+    doubleDeltaT = (REAL8)(deltaT/windowRMS); /* include 1 over window function RMS */
     for (k=0; k<nBins; k++)
     {
-      oneSFT->data->data[k] = crectf( doubleDeltaT*creal(fftDataDouble->data[k+firstbin]), doubleDeltaT*cimag(fftDataDouble->data[k+firstbin]) );
+      oneSFT->data->data[k] = crectf( doubleDeltaT*creal(fftDouble->data[k+firstbin]), doubleDeltaT*cimag(fftDouble->data[k+firstbin]) );
       /* 06/26/07 gam; use finite to check that data does not contains a non-FINITE (+/- Inf, NaN) values */
       #if CHECKFORINFINITEANDNANS
         if (!isfinite(crealf(oneSFT->data->data[k])) || !isfinite(cimagf(oneSFT->data->data[k]))) {
@@ -2137,11 +2264,6 @@ int WriteVersion2SFT(struct CommandLineArgsTag CLA)
     #if PRINTEXAMPLEDATA
         printf("\nExample real and imaginary SFT values going to file from fftDataDouble in WriteVersion2SFT:\n"); printExampleVersion2SFTDataGoingToFile(CLA,oneSFT);
     #endif
-    LALZDestroyVector( &status, &fftDataDouble );
-    TESTSTATUS( &status );
-    #if TRACKMEMUSE
-      printf("Memory use after destroying fftDataDouble in WriteVersion2SFT:\n"); printmemuse();
-    #endif
   }  
 
   /* write the SFT */
@@ -2161,6 +2283,449 @@ int WriteVersion2SFT(struct CommandLineArgsTag CLA)
 }
 /*******************************************************************************/
 
+/*******************************************************************************/
+/* Stream-data mode.  The segment [GPSStart, GPSEnd) is read from the frames once,
+   STREAMBLOCKSEC seconds at a time, and each block is passed forwards through the
+   second-order sections of the high-pass filter, with the filter history carried
+   over from block to block.  The reverse pass of the zero-phase filter is applied
+   to each SFT's data together with STREAMHPPADCYCLES/HPf seconds of the data which
+   follows it, so that its start-up transient has decayed before the SFT ends.
+   Windowing, FFTing, and writing the SFTs is done by a pool of worker threads which
+   share one FFT plan, while the next SFT's data is read and filtered. */
+int MakeSFTsStream(struct CommandLineArgsTag CLA)
+{
+  StreamSFTQueue queue;
+  REAL8IIRFilter *hpSections[STREAMHPORDER/2];
+  UINT4 numSections = 0;
+  REAL8TimeSeries *block = NULL;
+  REAL8Vector *buffer = NULL;   /* forward-filtered data starting at bufferStart */
+  INT8 bufferStart = 0;         /* index of the first sample in buffer, counted from GPSStart */
+  UINT4 bufferLength = 0;       /* number of samples in use in buffer */
+  INT4 readEnd = CLA.GPSStart;  /* GPS time up to which data has been read */
+  INT4 stride = (INT4)((1.0 - CLA.overlapFraction)*((REAL8)CLA.T));
+  INT4 pad = 0;
+  UINT4 nT = 0, i;
+  INT4 retval = 0;
+  LIGOTimeGPS epoch;
+
+  memset(&queue, 0, sizeof(queue));
+  queue.CLA = CLA;
+  queue.windowRMS = 1.0;
+
+  if (CLA.HPf > 0.0) {
+    pad = (INT4)ceil(STREAMHPPADCYCLES/CLA.HPf);
+  }
+
+  epoch.gpsSeconds = CLA.GPSStart;
+  epoch.gpsNanoSeconds = 0;
+  while (epoch.gpsSeconds + CLA.T <= CLA.GPSEnd)
+    {
+      INT4 needEnd = epoch.gpsSeconds + CLA.T + pad;
+      INT8 first, next;
+      UINT4 length;
+      REAL8Vector *segment = NULL;
+
+      if (needEnd > CLA.GPSEnd) needEnd = CLA.GPSEnd;
+
+      /* read and forward-filter data until the lookahead of this SFT has been read */
+      while (readEnd < needEnd)
+        {
+          INT4 duration = STREAMBLOCKSEC;
+          LIGOTimeGPS readStart;
+
+          if (duration < needEnd - readEnd) duration = needEnd - readEnd;
+          if (duration > CLA.GPSEnd - readEnd) duration = CLA.GPSEnd - readEnd;
+          readStart.gpsSeconds = readEnd;
+          readStart.gpsNanoSeconds = 0;
+
+          block = XLALFrStreamInputREAL8TimeSeries(framestream, CLA.ChannelName, &readStart, duration, 0);
+          if (block == NULL) {
+            fprintf(stderr,"Could not read %d s of channel %s at GPS time %d.\n", duration, CLA.ChannelName, readEnd);
+            retval = 3;
+            goto StreamCleanup;
+          }
+
+          /* set up everything that depends on the sample rate on the first block */
+          if (buffer == NULL) {
+            queue.deltaT = block->deltaT;
+            nT = (UINT4)(CLA.T/queue.deltaT + 0.5);
+            if (CLA.HPf > 0.0) {
+              if (CreateStreamHighPass(CLA.HPf, queue.deltaT, hpSections)) {
+                retval = 4;
+                goto StreamCleanup;
+              }
+              numSections = STREAMHPORDER/2;
+            }
+            if (CreateStreamWindow(CLA, nT, &queue.window, &queue.windowRMS)) {
+              retval = 5;
+              goto StreamCleanup;
+            }
+            if (CLA.useSingle) {
+              queue.fftPlanSingle = XLALCreateForwardREAL4FFTPlan( nT, 0 );
+              if (queue.fftPlanSingle == NULL) { retval = 6; goto StreamCleanup; }
+            } else {
+              queue.fftPlanDouble = XLALCreateForwardREAL8FFTPlan( nT, 0 );
+              if (queue.fftPlanDouble == NULL) { retval = 6; goto StreamCleanup; }
+            }
+            buffer = XLALCreateREAL8Vector( (UINT4)((CLA.T + pad + STREAMBLOCKSEC)/queue.deltaT + 0.5) );
+            if (buffer == NULL) { retval = 2; goto StreamCleanup; }
+            if (StreamQueueStart(&queue, CLA.numThreads)) { retval = 2; goto StreamCleanup; }
+          }
+
+          if ( (block->deltaT != queue.deltaT) || (block->data->length != (UINT4)(duration/queue.deltaT + 0.5)) ) {
+            fprintf(stderr,"Data of channel %s at GPS time %d is not contiguous.\n", CLA.ChannelName, readEnd);
+            retval = 3;
+            goto StreamCleanup;
+          }
+
+          for (i = 0; i < numSections; i++) {
+            if (XLALIIRFilterREAL8Vector(block->data, hpSections[i]) != XLAL_SUCCESS) {
+              retval = 4;
+              goto StreamCleanup;
+            }
+          }
+
+          if (bufferLength + block->data->length > buffer->length) {
+            if (XLALResizeREAL8Vector(buffer, bufferLength + block->data->length) == NULL) {
+              retval = 2;
+              goto StreamCleanup;
+            }
+          }
+          memcpy(buffer->data + bufferLength, block->data->data, block->data->length*sizeof(REAL8));
+          bufferLength += block->data->length;
+          readEnd += duration;
+
+          XLALDestroyREAL8TimeSeries(block);
+          block = NULL;
+        }
+
+      /* reverse-filter this SFT's data and its lookahead, then keep the SFT's data */
+      first = (INT8)((epoch.gpsSeconds - CLA.GPSStart)/queue.deltaT + 0.5) - bufferStart;
+      length = (UINT4)((needEnd - epoch.gpsSeconds)/queue.deltaT + 0.5);
+      if ( (segment = XLALCreateREAL8Vector(length)) == NULL ) {
+        retval = 2;
+        goto StreamCleanup;
+      }
+      memcpy(segment->data, buffer->data + first, length*sizeof(REAL8));
+      for (i = numSections; i-- > 0; ) {
+        if (XLALIIRFilterReverseREAL8Vector(segment, hpSections[i]) != XLAL_SUCCESS) {
+          XLALDestroyREAL8Vector(segment);
+          retval = 4;
+          goto StreamCleanup;
+        }
+      }
+      if (XLALResizeREAL8Vector(segment, nT) == NULL) {
+        XLALDestroyREAL8Vector(segment);
+        retval = 2;
+        goto StreamCleanup;
+      }
+
+      /* hand the SFT over to the workers; they destroy segment */
+      if ( (retval = StreamQueuePush(&queue, epoch, segment)) ) {
+        goto StreamCleanup;
+      }
+
+      /* discard the data before the next SFT */
+      epoch.gpsSeconds = epoch.gpsSeconds + stride;
+      next = (INT8)((epoch.gpsSeconds - CLA.GPSStart)/queue.deltaT + 0.5) - bufferStart;
+      if (next >= (INT8)bufferLength) {
+        bufferStart += bufferLength;
+        bufferLength = 0;
+      } else if (next > 0) {
+        memmove(buffer->data, buffer->data + next, (bufferLength - next)*sizeof(REAL8));
+        bufferStart += next;
+        bufferLength -= next;
+      }
+    }
+
+ StreamCleanup:
+  if (queue.started) {
+    INT4 workerretval = StreamQueueFinish(&queue);
+    if (retval == 0) retval = workerretval;
+  }
+  XLALDestroyREAL8TimeSeries(block);
+  XLALDestroyREAL8Vector(buffer);
+  XLALDestroyREAL8Vector(queue.window);
+  if (queue.fftPlanDouble) XLALDestroyREAL8FFTPlan(queue.fftPlanDouble);
+  if (queue.fftPlanSingle) XLALDestroyREAL4FFTPlan(queue.fftPlanSingle);
+  for (i = 0; i < numSections; i++) {
+    XLALDestroyREAL8IIRFilter(hpSections[i]);
+  }
+
+  return retval;
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+/* Make the second-order sections of the Butterworth high-pass filter which
+   LALButterworthREAL8TimeSeries() designs for the parameters used by HighPass():
+   nMax = STREAMHPORDER, f2 = HPf, a2 = 0.5, no f1 and a1. */
+int CreateStreamHighPass(REAL8 HPf, REAL8 deltaT, REAL8IIRFilter **sections)
+{
+  INT4 i, j, n = STREAMHPORDER;
+  REAL8 wc;
+
+  if ( !( (HPf*deltaT > 0.0) && (HPf*deltaT < 0.5) ) ) {
+    fprintf(stderr,"High pass filtering frequency %g Hz is not below the Nyquist frequency %g Hz.\n", HPf, 0.5/deltaT);
+    return 1;
+  }
+  wc = tan(LAL_PI*HPf*deltaT)*pow(1.0/sqrt(0.5) - 1.0, 0.5/((REAL8)n));
+
+  for (i = 0, j = n - 1; i < j; i++, j--) {
+    REAL8 theta = LAL_PI*(i + 0.5)/n;
+    REAL8 ar = wc*cos(theta);
+    REAL8 ai = wc*sin(theta);
+    COMPLEX16ZPGFilter *zpgFilter = NULL;
+
+    XLAL_CHECK( ( zpgFilter = XLALCreateCOMPLEX16ZPGFilter(2, 2) ) != NULL, XLAL_EFUNC );
+    zpgFilter->zeros->data[0] = 0.0;
+    zpgFilter->zeros->data[1] = 0.0;
+    zpgFilter->gain = 1.0;
+    zpgFilter->poles->data[0] = crect( ar, ai );
+    zpgFilter->poles->data[1] = crect( -ar, ai );
+    if (XLALWToZCOMPLEX16ZPGFilter(zpgFilter) == XLAL_SUCCESS) {
+      sections[i] = XLALCreateREAL8IIRFilter(zpgFilter);
+    } else {
+      sections[i] = NULL;
+    }
+    XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
+    if (sections[i] == NULL) {
+      while (i-- > 0) XLALDestroyREAL8IIRFilter(sections[i]);
+      XLAL_ERROR( XLAL_EFUNC );
+    }
+  }
+
+  return 0;
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+/* Get the coefficients and RMS of the window by windowing a series of ones */
+int CreateStreamWindow(struct CommandLineArgsTag CLA, UINT4 length, REAL8Vector **window, REAL8 *windowRMS)
+{
+  struct CommandLineArgsTag CLAdouble = CLA;
+  INT4 retval = 0;
+  UINT4 k;
+
+  *window = NULL;
+  *windowRMS = 1.0;
+  if (CLA.windowOption == 0) return 0;
+
+  XLAL_CHECK( ( dataDouble.data = XLALCreateREAL8Vector(length) ) != NULL, XLAL_EFUNC );
+  for (k = 0; k < length; k++) {
+    dataDouble.data->data[k] = 1.0;
+  }
+
+  CLAdouble.useSingle = 0;
+  if (CLA.windowOption==1) {
+    retval = WindowData(CLAdouble);
+  } else if (CLA.windowOption==2) {
+    retval = WindowDataTukey2(CLAdouble);
+  } else if (CLA.windowOption==3) {
+    retval = WindowDataHann(CLAdouble);
+  }
+  if (retval) {
+    XLALDestroyREAL8Vector(dataDouble.data);
+  } else {
+    *window = dataDouble.data;
+    *windowRMS = winFncRMS;
+  }
+  dataDouble.data = NULL;
+
+  return retval;
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+/* Window, FFT, and write out one SFT, and destroy its data */
+int StreamProcessSFT(const StreamSFTQueue *queue, LIGOTimeGPS epoch, REAL8Vector *data)
+{
+  INT4 retval = 0;
+  UINT4 k;
+
+  if (queue->window) {
+    for (k = 0; k < data->length; k++) {
+      data->data[k] *= queue->window->data[k];
+    }
+  }
+
+  if (queue->CLA.useSingle) {
+    REAL4Vector *dataSingle4 = XLALCreateREAL4Vector(data->length);
+    COMPLEX8Vector *fftSingle = XLALCreateCOMPLEX8Vector(data->length / 2 + 1);
+    if (dataSingle4 == NULL || fftSingle == NULL) {
+      retval = 6;
+    } else {
+      for (k = 0; k < data->length; k++) {
+        dataSingle4->data[k] = data->data[k];
+      }
+      if (XLALREAL4ForwardFFT(fftSingle, dataSingle4, queue->fftPlanSingle) != XLAL_SUCCESS) {
+        retval = 6;
+      } else if (queue->CLA.sftVersion==1) {
+        retval = WriteSFTData(queue->CLA, epoch, queue->deltaT, fftSingle, NULL) ? 7 : 0;
+      } else {
+        retval = WriteVersion2SFTData(queue->CLA, epoch, queue->deltaT, queue->windowRMS, fftSingle, NULL) ? 7 : 0;
+      }
+    }
+    XLALDestroyREAL4Vector(dataSingle4);
+    XLALDestroyCOMPLEX8Vector(fftSingle);
+  } else {
+    COMPLEX16Vector *fftDouble = XLALCreateCOMPLEX16Vector(data->length / 2 + 1);
+    if (fftDouble == NULL || XLALREAL8ForwardFFT(fftDouble, data, queue->fftPlanDouble) != XLAL_SUCCESS) {
+      retval = 6;
+    } else if (queue->CLA.sftVersion==1) {
+      retval = WriteSFTData(queue->CLA, epoch, queue->deltaT, NULL, fftDouble) ? 7 : 0;
+    } else {
+      retval = WriteVersion2SFTData(queue->CLA, epoch, queue->deltaT, queue->windowRMS, NULL, fftDouble) ? 7 : 0;
+    }
+    XLALDestroyCOMPLEX16Vector(fftDouble);
+  }
+
+  XLALDestroyREAL8Vector(data);
+  return retval;
+}
+/*******************************************************************************/
+
+#ifdef LAL_PTHREAD_LOCK
+/*******************************************************************************/
+static void *StreamWorker(void *arg)
+{
+  StreamSFTQueue *queue = (StreamSFTQueue *) arg;
+
+  while (1) {
+    StreamSFTJob job;
+    INT4 skip, retval;
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0 && !queue->done) {
+      pthread_cond_wait(&queue->notEmpty, &queue->lock);
+    }
+    if (queue->count == 0) {
+      pthread_mutex_unlock(&queue->lock);
+      break;
+    }
+    job = queue->jobs[queue->head];
+    queue->head = (queue->head + 1) % queue->size;
+    queue->count--;
+    skip = (queue->errcode != 0);
+    pthread_cond_signal(&queue->notFull);
+    pthread_mutex_unlock(&queue->lock);
+
+    /* after an error, just empty the queue */
+    if (skip) {
+      XLALDestroyREAL8Vector(job.data);
+      continue;
+    }
+
+    retval = StreamProcessSFT(queue, job.epoch, job.data);
+    if (retval) {
+      pthread_mutex_lock(&queue->lock);
+      if (queue->errcode == 0) queue->errcode = retval;
+      pthread_cond_broadcast(&queue->notFull);
+      pthread_mutex_unlock(&queue->lock);
+    }
+  }
+
+  return NULL;
+}
+/*******************************************************************************/
+#endif
+
+/*******************************************************************************/
+/* Start the worker threads; without pthreads, or if no thread could be started,
+   SFTs are processed by StreamQueuePush() in the calling thread */
+int StreamQueueStart(StreamSFTQueue *queue, UINT4 numThreads)
+{
+#ifdef LAL_PTHREAD_LOCK
+  UINT4 i;
+
+  queue->size = numThreads;
+  queue->jobs = XLALCalloc(queue->size, sizeof(*queue->jobs));
+  queue->workers = XLALCalloc(numThreads, sizeof(*queue->workers));
+  if (queue->jobs == NULL || queue->workers == NULL) {
+    XLALFree(queue->jobs);
+    XLALFree(queue->workers);
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  pthread_mutex_init(&queue->lock, NULL);
+  pthread_cond_init(&queue->notEmpty, NULL);
+  pthread_cond_init(&queue->notFull, NULL);
+  for (i = 0; i < numThreads; i++) {
+    if (pthread_create(&queue->workers[i], NULL, StreamWorker, queue) != 0) {
+      fprintf(stderr,"Could only start %u of %u threads.\n", i, numThreads);
+      break;
+    }
+    queue->numWorkers++;
+  }
+#else
+  if (numThreads > 1) {
+    fprintf(stderr,"No thread support; making SFTs in a single thread.\n");
+  }
+#endif
+  queue->started = 1;
+  return 0;
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+/* Queue an SFT for the workers, waiting for room in the queue; returns the
+   return code of the first worker that failed, if any */
+int StreamQueuePush(StreamSFTQueue *queue, LIGOTimeGPS epoch, REAL8Vector *data)
+{
+#ifdef LAL_PTHREAD_LOCK
+  if (queue->numWorkers > 0) {
+    INT4 errcode;
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == queue->size && queue->errcode == 0) {
+      pthread_cond_wait(&queue->notFull, &queue->lock);
+    }
+    errcode = queue->errcode;
+    if (errcode == 0) {
+      StreamSFTJob *job = &queue->jobs[(queue->head + queue->count) % queue->size];
+      job->epoch = epoch;
+      job->data = data;
+      queue->count++;
+      pthread_cond_signal(&queue->notEmpty);
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    if (errcode) XLALDestroyREAL8Vector(data);
+    return errcode;
+  }
+#endif
+  return StreamProcessSFT(queue, epoch, data);
+}
+/*******************************************************************************/
+
+/*******************************************************************************/
+/* Let the workers finish the queued SFTs and stop them */
+int StreamQueueFinish(StreamSFTQueue *queue)
+{
+#ifdef LAL_PTHREAD_LOCK
+  UINT4 i;
+
+  pthread_mutex_lock(&queue->lock);
+  queue->done = 1;
+  pthread_cond_broadcast(&queue->notEmpty);
+  pthread_mutex_unlock(&queue->lock);
+  for (i = 0; i < queue->numWorkers; i++) {
+    pthread_join(queue->workers[i], NULL);
+  }
+
+  pthread_cond_destroy(&queue->notFull);
+  pthread_cond_destroy(&queue->notEmpty);
+  pthread_mutex_destroy(&queue->lock);
+  XLALFree(queue->workers);
+  XLALFree(queue->jobs);
+  queue->workers = NULL;
+  queue->jobs = NULL;
+  queue->numWorkers = 0;
+#endif
+  queue->started = 0;
+  return queue->errcode;
+}
+/*******************************************************************************/
+
 /*******************************************************************************/
 int FreeMem(struct CommandLineArgsTag CLA)
 {
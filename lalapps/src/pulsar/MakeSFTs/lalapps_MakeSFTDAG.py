@@ -98,13 +98,15 @@ Usage: MakeSFTDAG [options]
   -j, --datafind-path        (optional) string specifying a path to look for the gw_data_find executable; if not set, will use LSC_DATAFIND_PATH env variable or system default (in that order).
   -J, --makesfts-path        (optional) string specifying a path to look for the lalapps_MakeSFTs executable; if not set, will use MAKESFTS_PATH env variable or system default (in that order).
   -Y, --request-memory       (optional) memory allocation in MB to request from condor for lalapps_MakeSFTs step
+  -W, --stream-data          (optional) run lalapps_MakeSFTs with --stream-data, so that each job reads its data once and high passes it continuously.
+  -n, --num-threads          (optional) number of threads lalapps_MakeSFTs uses to window, FFT and write SFTs with --stream-data; also the number of CPUs requested from condor (default is 1).
 """
   print(msg)
 
 #
 # FUNCTION THAT WRITE ONE JOB TO DAG FILE
 #
-def writeToDag(dagFID, nodeCount, filterKneeFreq, timeBaseline, outputSFTPath, cachePath, startTimeThisNode, endTimeThisNode, channelName, site, inputDataType, extraDatafindTime, useSingle, useHoT, makeTmpFile, tagString, windowType, overlapFraction, sftVersion, makeGPSDirs, miscDesc, commentField, startFreq, freqBand, frameStructType, IFO):
+def writeToDag(dagFID, nodeCount, filterKneeFreq, timeBaseline, outputSFTPath, cachePath, startTimeThisNode, endTimeThisNode, channelName, site, inputDataType, extraDatafindTime, useSingle, useHoT, makeTmpFile, tagString, windowType, overlapFraction, sftVersion, makeGPSDirs, miscDesc, commentField, startFreq, freqBand, frameStructType, IFO, streamData, numThreads):
   LSCdataFind = 'LSCdataFind_%i' % nodeCount
   MakeSFTs    = 'MakeSFTs_%i' % nodeCount
   startTimeDatafind = startTimeThisNode - extraDatafindTime
@@ -130,6 +132,8 @@ def writeToDag(dagFID, nodeCount, filterKneeFreq, timeBaseline, outputSFTPath, c
   if useSingle: argList = argList + ' -S'
   if useHoT: argList = argList + ' -H'
   if makeTmpFile: argList = argList + ' -Z'
+  if streamData: argList = argList + ' --stream-data'
+  if numThreads != 1: argList = argList + ' --num-threads %s' % numThreads
   dagFID.write('VARS %s argList="%s" tagstring="%s"\n'%(MakeSFTs,argList, tagStringOut))
   dagFID.write('PARENT %s CHILD %s\n'%(LSCdataFind,MakeSFTs))
 
@@ -138,7 +142,7 @@ def writeToDag(dagFID, nodeCount, filterKneeFreq, timeBaseline, outputSFTPath, c
 #
 
 # parse the command line options
-shortop = "s:e:a:b:f:t:G:d:x:M:y:k:T:p:C:O:o:N:i:w:P:u:v:c:F:B:D:X:m:L:g:q:Q:A:U:R:l:hSHZj:J:Y:"
+shortop = "s:e:a:b:f:t:G:d:x:M:y:k:T:p:C:O:o:N:i:w:P:u:v:c:F:B:D:X:m:L:g:q:Q:A:U:R:l:hSHZWj:J:Y:n:"
 longop = [
   "help",
   "gps-start-time=",
@@ -183,7 +187,9 @@ longop = [
   "make-tmp-file",
   "datafind-path=",
   "makesfts-path=",
-  "request-memory="
+  "request-memory=",
+  "stream-data",
+  "num-threads="
   ]
 
 try:
@@ -239,6 +245,8 @@ makeTmpFile = False
 datafindPath = None
 makeSFTsPath = None
 requestMemory = None
+streamData = False
+numThreads = 1
 
 for o, a in opts:
   if o in ("-h", "--help"):
@@ -330,6 +338,10 @@ for o, a in opts:
     makeSFTsPath = a
   elif o in ("-Y", "--request-memory"):
     requestMemory = a
+  elif o in ("-W", "--stream-data"):
+    streamData = True
+  elif o in ("-n", "--num-threads"):
+    numThreads = int(a)
   else:
     print("Unknown option:", o, file=sys.stderr)
     usage()
@@ -589,7 +601,7 @@ MakeSFTsFID.write('output = %s/MakeSFTs_$(tagstring).out\n' % logPath)
 MakeSFTsFID.write('notification = never\n')
 if (requestMemory != None):
     MakeSFTsFID.write('RequestMemory = %s\n' % requestMemory)
-MakeSFTsFID.write('RequestCpus = 1\n')
+MakeSFTsFID.write('RequestCpus = %i\n' % numThreads)
 MakeSFTsFID.write('queue 1\n')
 MakeSFTsFID.close
 
@@ -668,7 +680,7 @@ for seg in segList:
                # END if (useNodeList)
 
                if (nodeCount == 1): startTimeAllNodes = startTimeThisNode
-               writeToDag(dagFID,nodeCount, filterKneeFreq, timeBaseline, outputSFTPath, cachePath, startTimeThisNode, endTimeThisNode, channelName, site, inputDataType, extraDatafindTime, useSingle, useHoT, makeTmpFile, tagString, windowType, overlapFraction, sftVersion, makeGPSDirs, miscDesc, commentField, startFreq, freqBand, frameStructType, IFO)
+               writeToDag(dagFID,nodeCount, filterKneeFreq, timeBaseline, outputSFTPath, cachePath, startTimeThisNode, endTimeThisNode, channelName, site, inputDataType, extraDatafindTime, useSingle, useHoT, makeTmpFile, tagString, windowType, overlapFraction, sftVersion, makeGPSDirs, miscDesc, commentField, startFreq, freqBand, frameStructType, IFO, streamData, numThreads)
                # Update for next node
                numThisNode       = 0
                if overlapFraction != 0.0:
@@ -691,7 +703,7 @@ for seg in segList:
             # END if (useNodeList)
 
             if (nodeCount == 1): startTimeAllNodes = startTimeThisNode
-            writeToDag(dagFID,nodeCount, filterKneeFreq, timeBaseline, outputSFTPath, cachePath, startTimeThisNode, endTimeThisNode, channelName, site, inputDataType, extraDatafindTime, useSingle, useHoT, makeTmpFile, tagString, windowType, overlapFraction, sftVersion, makeGPSDirs, miscDesc, commentField, startFreq, freqBand, frameStructType, IFO)
+            writeToDag(dagFID,nodeCount, filterKneeFreq, timeBaseline, outputSFTPath, cachePath, startTimeThisNode, endTimeThisNode, channelName, site, inputDataType, extraDatafindTime, useSingle, useHoT, makeTmpFile, tagString, windowType, overlapFraction, sftVersion, makeGPSDirs, miscDesc, commentField, startFreq, freqBand, frameStructType, IFO, streamData, numThreads)
     # END while (endTimeAllNodes < analysisEndTime)
 # END for seg in segList
 
@@ -46,3 +46,82 @@ if ! eval "$cmdline"; then
     echo "ERROR: something failed when running '$cmdline'"
     exit 1
 fi
+
+## run MakeSFTs again in stream-data mode, using two threads to window, FFT and write the SFT
+cmdline="lalapps_MakeSFTs -f 0 -t ${Tsft} -p . -C $framecache -s ${tstart} -e ${tend} -N H1:mfdv5 -v 2 -i H1 -u PROC_REAL8 -w 0 -F 0 -B ${Band2} -D 4 -X MSFTstream --stream-data --num-threads 2"
+if ! eval "$cmdline"; then
+    echo "ERROR: something failed when running '$cmdline'"
+    exit 1
+fi
+MSFTstreamsft="./H-1_H1_${Tsft}SFT_MSFTstream-1257/H-1_H1_${Tsft}SFT_MSFTstream-${tstart}-${Tsft}.sft"
+for file in $MSFTstreamsft; do
+    if ! test -f $file; then
+        echo "ERROR: could not find file '$file'"
+        exit 1
+    fi
+done
+
+## compare SFTs produced by MFDv5 and MakeSFTs in stream-data mode
+cmdline="lalapps_compareSFTs -V -e $tol -1 $MFDv5sft -2 $MSFTstreamsft"
+echo "Comparing SFTs produced by MFDv5 and MakeSFTs --stream-data, allowed tolerance=$tol:"
+if ! eval "$cmdline"; then
+    echo "ERROR: something failed when running '$cmdline'"
+    exit 1
+fi
+
+## run MFDv5 again to create a longer fake frame, spanning several SFTs
+Tspan=`echo "3 * ${Tsft}" | bc`
+cmdline="lalapps_Makefakedata_v5 --IFOs H1 --sqrtSX 1e-24 --startTime ${tstart} --duration ${Tspan} --fmin 0 --Band ${Band} --injectionSources '{Alpha=0.1; Delta=0.4; Freq=50; f1dot=1e-10; h0=1e-24; cosi=0.7; refTime=${tstart}}' --outFrameDir ."
+if ! eval "$cmdline"; then
+    echo "ERROR: something failed when running '$cmdline'"
+    exit 1
+fi
+MFDv5longgwf="./H-H1_mfdv5-${tstart}-${Tspan}.gwf"
+if ! test -f $MFDv5longgwf; then
+    echo "ERROR: could not find file '$MFDv5longgwf'"
+    exit 1
+fi
+longframecache="./longframecache"
+echo "H H1_mfdv5 ${tstart} ${Tspan} file://localhost$PWD/$MFDv5longgwf" > $longframecache
+
+## run MakeSFTs over the longer frame with a high-pass filter and half-overlapping Hann windows,
+## once reading and filtering the data for each SFT separately, and once in stream-data mode
+tend=`echo "${tstart} + ${Tspan}" | bc`
+for mode in MSFTHP MSFTHPstream; do
+    cmdline="lalapps_MakeSFTs -f 10 -t ${Tsft} -p . -C $longframecache -s ${tstart} -e ${tend} -N H1:mfdv5 -v 2 -i H1 -u PROC_REAL8 -w 3 -P 0.5 -F 0 -B ${Band2} -D 4 -X $mode"
+    if test $mode = MSFTHPstream; then
+        cmdline="$cmdline --stream-data --num-threads 2"
+    fi
+    if ! eval "$cmdline"; then
+        echo "ERROR: something failed when running '$cmdline'"
+        exit 1
+    fi
+done
+
+## compare SFTs produced by MakeSFTs with and without --stream-data; the outputs are not identical,
+## since without --stream-data the high-pass filter starts afresh at the edges of each SFT, but
+## the start-up transients there last well under a second and are suppressed by the Hann window
+tol=1e-8
+stride=`echo "${Tsft} / 2" | bc`
+numSFTs=0
+for t in `seq ${tstart} ${stride} $(echo "${tend} - ${Tsft}" | bc)`; do
+    MSFTHPsft="./H-1_H1_${Tsft}SFT_MSFTHP-1257/H-1_H1_${Tsft}SFT_MSFTHP-${t}-${Tsft}.sft"
+    MSFTHPstreamsft="./H-1_H1_${Tsft}SFT_MSFTHPstream-1257/H-1_H1_${Tsft}SFT_MSFTHPstream-${t}-${Tsft}.sft"
+    for file in $MSFTHPsft $MSFTHPstreamsft; do
+        if ! test -f $file; then
+            echo "ERROR: could not find file '$file'"
+            exit 1
+        fi
+    done
+    cmdline="lalapps_compareSFTs -V -e $tol -1 $MSFTHPsft -2 $MSFTHPstreamsft"
+    echo "Comparing high-passed SFTs at ${t} produced by MakeSFTs with and without --stream-data, allowed tolerance=$tol:"
+    if ! eval "$cmdline"; then
+        echo "ERROR: something failed when running '$cmdline'"
+        exit 1
+    fi
+    numSFTs=`expr ${numSFTs} + 1`
+done
+if test ${numSFTs} -ne 5; then
+    echo "ERROR: compared ${numSFTs} SFTs, expected 5"
+    exit 1
+fi
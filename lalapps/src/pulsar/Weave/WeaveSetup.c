@@ -45,6 +45,7 @@ int main( int argc, char *argv[] )
     LIGOTimeGPSRange first_segment;
     REAL8 segment_gap;
     UINT4 segment_count, spindowns;
+    BOOLEAN fixed_node_metric;
   } uvar_struct = {
     .detector_motion = XLALStringDuplicate( "spin+orbit" ),
     .ephem_earth = XLALStringDuplicate( "earth00-40-DE405.dat.gz" ),
@@ -121,6 +122,11 @@ int main( int argc, char *argv[] )
     "Must be at least 1. "
     "This option limits the size of the spindown parameter space given to lalapps_Weave. "
     );
+  XLALRegisterUvarMember(
+    fixed_node_metric, BOOLEAN, 0, DEVELOPER,
+    "Integrate the parameter-space metrics of each segment using fixed-node Gauss-Legendre quadrature, instead of adaptive quadrature. "
+    "This is much faster for setups with many segments. "
+    );
 
   // Parse user input
   XLAL_CHECK_MAIN( xlalErrno == 0, XLAL_EFUNC, "A call to XLALRegisterUvarMember() failed" );
@@ -246,7 +252,11 @@ int main( int argc, char *argv[] )
   //   metrics can later be rescaled by search code
   LogPrintf( LOG_NORMAL, "Computing reduced supersky metrics ...\n" );
   const double fiducial_freq = 100.0;
-  setup.metrics = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, uvar->spindowns, &setup.ref_time, setup.segments, fiducial_freq, &detector_info, NULL, detector_motion, setup.ephemerides );
+  if ( uvar->fixed_node_metric ) {
+    setup.metrics = XLALComputeSuperskyMetricsFixedNode( SUPERSKY_METRIC_TYPE, uvar->spindowns, &setup.ref_time, setup.segments, fiducial_freq, &detector_info, NULL, detector_motion, setup.ephemerides );
+  } else {
+    setup.metrics = XLALComputeSuperskyMetrics( SUPERSKY_METRIC_TYPE, uvar->spindowns, &setup.ref_time, setup.segments, fiducial_freq, &detector_info, NULL, detector_motion, setup.ephemerides );
+  }
   XLAL_CHECK_MAIN( setup.metrics != NULL, XLAL_EFUNC );
   LogPrintf( LOG_NORMAL, "Finished computing reduced supersky metrics\n" );
 
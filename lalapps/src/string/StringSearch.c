@@ -78,6 +78,10 @@
 #include <lalapps.h>
 #include <LALAppsVCSInfo.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 #define TESTSTATUS( pstat ) \
   if ( (pstat)->statusCode ) { REPORTSTATUS(pstat); return 100; } else ((void)0)
 
@@ -124,6 +128,7 @@ struct CommandLineArgsTag {
   INT4 printdataflag;         /* flag set to 1 if user wants to print the data */
   INT4 printinjectionflag;    /* flag set to 1 if user wants to print the injection(s) */
   char *comment;              /* for "comment" columns in some tables */
+  INT4 nthreads;              /* number of threads filtering the data */
 };
 
 typedef
@@ -178,7 +183,7 @@ int FindStringBurst(struct CommandLineArgsTag CLA, REAL8TimeSeries *ht, unsigned
 
 /* Finds events above SNR threshold specified  */
 int FindEvents(struct CommandLineArgsTag CLA, const StringTemplate *strtemplate,
-               const REAL8TimeSeries *vector, SnglBurst **head);
+               const REAL8Vector *filtered, REAL8 scale, const LIGOTimeGPS *epoch, REAL8 deltaT, SnglBurst **head);
 
 /* Writes out the xml file with the events it found  */
 int OutputEvents(const struct CommandLineArgsTag *CLA, ProcessTable *proctable, ProcessParamsTable *procparamtable, SnglBurst *events);
@@ -516,38 +521,43 @@ int OutputEvents(const struct CommandLineArgsTag *CLA, ProcessTable *proctable,
 
 /*******************************************************************************/
 
-int FindEvents(struct CommandLineArgsTag CLA, const StringTemplate *strtemplate, const REAL8TimeSeries *vector, SnglBurst **head){
+int FindEvents(struct CommandLineArgsTag CLA, const StringTemplate *strtemplate, const REAL8Vector *filtered, REAL8 scale, const LIGOTimeGPS *epoch, REAL8 deltaT, SnglBurst **head){
+  /* the SNR time series is scale times the filter output;  it is only
+   * evaluated at the samples that are looked at, never stored */
+#define SNR(k) (scale * filtered->data[(k)])
+  const unsigned length = filtered->length;
+  const REAL8 trigoffset = XLALGPSDiff(epoch, &CLA.trigstarttime);
   unsigned p;
   INT4 pmax, pend, pstart;
 
   /* print the snr to stdout */
   if (CLA.printsnrflag)
-    for ( p = vector->data->length/4 ; p < 3*vector->data->length/4; p++ )
-      fprintf(stdout,"%p %e\n", strtemplate, vector->data->data[p]);
+    for ( p = length/4 ; p < 3*length/4; p++ )
+      fprintf(stdout,"%p %e\n", strtemplate, SNR(p));
 
   /* Now find event in the inner half */
-  for ( p = vector->data->length/4 ; p < 3*vector->data->length/4; p++ ){
+  for ( p = length/4 ; p < 3*length/4; p++ ){
     REAL8 maximum_snr = 0.0;
     pmax=p;
 
     /* Do we have the start of a cluster? */
-    if ( (fabs(vector->data->data[p]) > CLA.threshold) && (XLALGPSDiff(&vector->epoch, &CLA.trigstarttime) + p * vector->deltaT >= 0)){
+    if ( (fabs(SNR(p)) > CLA.threshold) && (trigoffset + p * deltaT >= 0)){
       SnglBurst *new;
       REAL8 chi2, ndof;
       int pp;
       pend=p; pstart=p;
 
       /* Clustering in time: While we are above threshold, or within clustering time of the last point above threshold... */
-      while( ((fabs(vector->data->data[p]) > CLA.threshold) || ((p-pend)* vector->deltaT < (float)(CLA.cluster)) )
-	     && p<3*vector->data->length/4){
+      while( ((fabs(SNR(p)) > CLA.threshold) || ((p-pend)* deltaT < (float)(CLA.cluster)) )
+	     && p<3*length/4){
 
 	/* This keeps track of the largest SNR point of the cluster */
-	if(fabs(vector->data->data[p]) > maximum_snr){
-	  maximum_snr=fabs(vector->data->data[p]);
+	if(fabs(SNR(p)) > maximum_snr){
+	  maximum_snr=fabs(SNR(p));
 	  pmax=p;
 	}
 	/* pend is the last point above threshold */
-	if ( (fabs(vector->data->data[p]) > CLA.threshold))
+	if ( (fabs(SNR(p)) > CLA.threshold))
 	  pend =  p;
 
 	p++;
@@ -556,8 +566,8 @@ int FindEvents(struct CommandLineArgsTag CLA, const StringTemplate *strtemplate,
       /* compute \chi^{2} */
       chi2=0, ndof=0;
       for(pp=-strtemplate->chi2_index; pp<strtemplate->chi2_index; pp++){
-        chi2 += (vector->data->data[pmax+pp]-vector->data->data[pmax]*strtemplate->auto_cor->data[vector->data->length/2+pp])*(vector->data->data[pmax+pp]-vector->data->data[pmax]*strtemplate->auto_cor->data[vector->data->length/2+pp]);
-        ndof += (1-strtemplate->auto_cor->data[vector->data->length/2+pp]*strtemplate->auto_cor->data[vector->data->length/2+pp]);
+        chi2 += (SNR(pmax+pp)-SNR(pmax)*strtemplate->auto_cor->data[length/2+pp])*(SNR(pmax+pp)-SNR(pmax)*strtemplate->auto_cor->data[length/2+pp]);
+        ndof += (1-strtemplate->auto_cor->data[length/2+pp]*strtemplate->auto_cor->data[length/2+pp]);
       }
 
       /* Apply the \chi^{2} cut */
@@ -582,74 +592,173 @@ int FindEvents(struct CommandLineArgsTag CLA, const StringTemplate *strtemplate,
 
       /* compute start and peak time and duration, give 1 sample of fuzz on
        * both sides */
-      new->start_time = new->peak_time = vector->epoch;
-      XLALGPSAdd(&new->peak_time, pmax * vector->deltaT);
-      XLALGPSAdd(&new->start_time, (pstart - 1) * vector->deltaT);
-      new->duration = vector->deltaT * ( pend - pstart + 2 );
+      new->start_time = new->peak_time = *epoch;
+      XLALGPSAdd(&new->peak_time, pmax * deltaT);
+      XLALGPSAdd(&new->start_time, (pstart - 1) * deltaT);
+      new->duration = deltaT * ( pend - pstart + 2 );
 
       new->central_freq = (strtemplate->f+CLA.fbankstart)/2.0;
       new->bandwidth    = strtemplate->f-CLA.fbankstart;
       new->snr          = maximum_snr;
-      new->amplitude    = vector->data->data[pmax]/strtemplate->norm;
+      new->amplitude    = SNR(pmax)/strtemplate->norm;
       new->chisq = chi2;
       new->chisq_dof = ndof;
     }
   }
+#undef SNR
 
   return 0;
 }
 
 /*******************************************************************************/
 
+/*
+ * Filtering of one segment with a batch of templates.  The FFT of the
+ * segment is shared by all templates;  each batch owns its workspace and
+ * the event lists of its templates, so batches can run concurrently.
+ */
+
+struct StringFilterBatch {
+  const struct CommandLineArgsTag *CLA;
+  const StringTemplate *strtemplate;
+  const COMPLEX16FrequencySeries *vtilde; /* FFT of the current segment */
+  const REAL8FFTPlan *rplan;
+  int first, stride, NTemplates;    /* templates first, first + stride, ... */
+  REAL8 deltaT;                     /* sample interval of the data */
+  COMPLEX16Vector *product;         /* workspace: filtered FFT of the segment */
+  REAL8Vector *filtered;            /* workspace: filtered segment */
+  SnglBurst **heads;                /* event list of each template */
+  int errcode;
+};
+
+
+static void *FilterSegmentBatch(void *arg){
+  struct StringFilterBatch *batch = arg;
+  const COMPLEX16FrequencySeries *vtilde = batch->vtilde;
+  int m;
+  unsigned p;
+
+  for (m = batch->first; m < batch->NTemplates; m += batch->stride){
+    const REAL8 *filter = batch->strtemplate[m].StringFilter->data->data;
+
+    /* multiply FT of data and String Filter */
+    for ( p = 0 ; p < vtilde->data->length; p++ )
+      batch->product->data[p] = vtilde->data->data[p] * filter[p];
+
+    /* reverse FFT it */
+    if(XLALREAL8ReverseFFT( batch->filtered, batch->product, batch->rplan )){
+      batch->errcode = 1;
+      break;
+    }
+
+    /* find triggers;  the inverse FFT's deltaF, the template normalisation
+       and the factor of 2 from the match-filter definition are applied to
+       the samples as they are examined */
+    if(FindEvents(*batch->CLA, &batch->strtemplate[m], batch->filtered, 2.0 * vtilde->deltaF / batch->strtemplate[m].norm, &vtilde->epoch, batch->deltaT, &batch->heads[m])){
+      batch->errcode = 1;
+      break;
+    }
+  }
+
+  return NULL;
+}
+
+
 int FindStringBurst(struct CommandLineArgsTag CLA, REAL8TimeSeries *ht, unsigned seg_length, const StringTemplate *strtemplate, int NTemplates, REAL8FFTPlan *fplan, REAL8FFTPlan *rplan, SnglBurst **head){
   int i,m;
-  unsigned p;
+  int nbatches = CLA.nthreads < NTemplates ? CLA.nthreads : NTemplates;
+  int nstarted = 1;
+  int errcode = 0;
   COMPLEX16FrequencySeries *vtilde;
+  struct StringFilterBatch *batches;
+  SnglBurst *heads[MAXTEMPLATES] = {NULL};
+#ifdef LAL_PTHREAD_LOCK
+  pthread_t *threads;
+#endif
+
+  /* keep the printed SNR in order */
+  if (CLA.printsnrflag || nbatches < 1)
+    nbatches = 1;
+#ifndef LAL_PTHREAD_LOCK
+  if (nbatches > 1) {
+    fprintf(stderr,"No thread support; filtering in a single thread.\n");
+    nbatches = 1;
+  }
+#endif
 
   /* create vector that will hold FFT of data;  metadata will be populated
    * by FFT function */
   vtilde = XLALCreateCOMPLEX16FrequencySeries( ht->name, &ht->epoch, ht->f0, 0.0, &lalDimensionlessUnit, seg_length / 2 + 1 );
+  batches = XLALCalloc(nbatches, sizeof(*batches));
+#ifdef LAL_PTHREAD_LOCK
+  threads = XLALCalloc(nbatches, sizeof(*threads));
+  if (!threads) errcode = 1;
+#endif
+  if (!vtilde || !batches) errcode = 1;
+  for (m = 0; !errcode && m < nbatches; m++){
+    batches[m].CLA = &CLA;
+    batches[m].strtemplate = strtemplate;
+    batches[m].vtilde = vtilde;
+    batches[m].rplan = rplan;
+    batches[m].first = m;
+    batches[m].stride = nbatches;
+    batches[m].NTemplates = NTemplates;
+    batches[m].deltaT = ht->deltaT;
+    batches[m].heads = heads;
+    batches[m].product = XLALCreateCOMPLEX16Vector( seg_length / 2 + 1 );
+    batches[m].filtered = XLALCreateREAL8Vector( seg_length );
+    if (!batches[m].product || !batches[m].filtered) errcode = 1;
+  }
 
-  /* loop over templates  */
+  /* loop over overlapping chunks */
+  for(i=0; !errcode && i < 2*(ht->data->length*ht->deltaT)/CLA.ShortSegDuration - 1 ;i++){
+    /* extract overlapping chunk of data */
+    REAL8TimeSeries *vector = XLALCutREAL8TimeSeries(ht, i * seg_length / 2, seg_length);
+
+    /* FFT it, once for all templates */
+    if(!vector || XLALREAL8TimeFreqFFT( vtilde, vector, fplan )) errcode = 1;
+    XLALDestroyREAL8TimeSeries( vector );
+    if(errcode) break;
+
+    /* filter it with every template, a batch of templates per thread */
+#ifdef LAL_PTHREAD_LOCK
+    for (nstarted = 1; nstarted < nbatches; nstarted++)
+      if (pthread_create(&threads[nstarted], NULL, FilterSegmentBatch, &batches[nstarted]))
+        break;
+#endif
+    /* this thread does the first batch, and any that could not be given a
+       thread of their own */
+    FilterSegmentBatch(&batches[0]);
+    for (m = nstarted; m < nbatches; m++)
+      FilterSegmentBatch(&batches[m]);
+#ifdef LAL_PTHREAD_LOCK
+    for (m = 1; m < nstarted; m++)
+      pthread_join(threads[m], NULL);
+#endif
+    for (m = 0; m < nbatches; m++)
+      errcode |= batches[m].errcode;
+  }
+
+  /* prepend the triggers to the list, template by template */
   for (m = 0; m < NTemplates; m++){
-    /* loop over overlapping chunks */
-    for(i=0; i < 2*(ht->data->length*ht->deltaT)/CLA.ShortSegDuration - 1 ;i++){
-      /* extract overlapping chunk of data */
-      REAL8TimeSeries *vector = XLALCutREAL8TimeSeries(ht, i * seg_length / 2, seg_length);
-
-      /* FFT it */
-      if(XLALREAL8TimeFreqFFT( vtilde, vector, fplan )) return 1;
-
-      /* multiply FT of data and String Filter */
-      for ( p = 0 ; p < vtilde->data->length; p++ )
-        vtilde->data->data[p] *= strtemplate[m].StringFilter->data->data[p];
-
-      /* reverse FFT it */
-      if(XLALREAL8FreqTimeFFT( vector, vtilde, rplan )) return 1;
-      vector->deltaT = ht->deltaT;	/* gets mucked up by round-off */
-
-      /* normalise the result by template normalisation
-	 factor of 2 is from match-filter definition */
-      for ( p = 0 ; p < vector->data->length; p++ )
-	vector->data->data[p] *= 2.0 / strtemplate[m].norm;
-
-      /* find triggers */
-      if(FindEvents(CLA, &strtemplate[m], vector, head)) return 1;
-
-      /*
-      if(m==10){
-      	for ( int ii = 0 ; ii < vector->data->length; ii++ )
-	  printf("%.3e\n",vector->data->data[ii]);
-      }
-      */
-      /* free chunk */
-      XLALDestroyREAL8TimeSeries( vector );
-    }
+    SnglBurst *tail = heads[m];
+    if (!tail) continue;
+    while (tail->next) tail = tail->next;
+    tail->next = *head;
+    *head = heads[m];
   }
 
+  for (m = 0; batches && m < nbatches; m++){
+    XLALDestroyCOMPLEX16Vector( batches[m].product );
+    XLALDestroyREAL8Vector( batches[m].filtered );
+  }
+  XLALFree( batches );
+#ifdef LAL_PTHREAD_LOCK
+  XLALFree( threads );
+#endif
   XLALDestroyCOMPLEX16FrequencySeries( vtilde );
 
-  return 0;
+  return errcode;
 }
 
 
@@ -1198,10 +1307,11 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA, const
     {"print-data",                no_argument,	NULL,	'y'},
     {"print-injection",           no_argument,	NULL,	'z'},
     {"user-tag",                  required_argument,	NULL,	'j'},
+    {"num-threads",               required_argument,	NULL,	'N'},
     {"help",                      no_argument,	NULL,	'h'},
     {0, 0, 0, 0}
   };
-  char args[] = "hnckwabrxyzlj:f:L:M:D:H:t:F:C:E:S:i:v:d:T:s:g:o:p:A:B:G:K:";
+  char args[] = "hnckwabrxyzlj:f:L:M:D:H:t:F:C:E:S:i:v:d:T:s:g:o:p:A:B:G:K:N:";
 
   LALoptarg = NULL;
 
@@ -1233,6 +1343,7 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA, const
   CLA->printdataflag=0;
   CLA->printinjectionflag=0;
   CLA->comment=default_comment;
+  CLA->nthreads=1;
 
   /* initialise chi2cut */
   memset(CLA->chi2cut, 0, sizeof(CLA->chi2cut));
@@ -1394,6 +1505,11 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA, const
       CLA->comment = LALoptarg;
       ADD_PROCESS_PARAM(process, "string");
       break;
+    case 'N':
+      /* number of threads */
+      CLA->nthreads=atoi(LALoptarg);
+      ADD_PROCESS_PARAM(process, "int");
+      break;
     case 'r':
       /* fake gaussian noise flag */
       CLA->printsnrflag=1;
@@ -1416,7 +1532,7 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA, const
       break;
     case 'h':
       /* print usage/help message */
-      fprintf(stdout,"All arguments are required except -n, -h, -w, -g, -o, -x, -y, -z, -b, -r -a, -l, -p, -T  and -i. One of -k or -c must be specified. They are:\n");
+      fprintf(stdout,"All arguments are required except -n, -h, -w, -g, -o, -x, -y, -z, -b, -r -a, -l, -p, -T, -N  and -i. One of -k or -c must be specified. They are:\n");
       fprintf(stdout,"\t--sample-rate (-s)\t\tFLOAT\t Desired sample rate (Hz).\n");
       fprintf(stdout,"\t--bank-lowest-hifreq-cutoff (-H)\tFLOAT\t Template bank lowest high frequency cut-off.\n");
       fprintf(stdout,"\t--max-mismatch (-M)\tFLOAT\t Maximal mismatch allowed from 1 template to the next.\n");
@@ -1447,6 +1563,7 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA, const
       fprintf(stdout,"\t--print-snr (-x)\tFLAG\t Prints the snr to stdout.\n");
       fprintf(stdout,"\t--print-data (-y)\tFLAG\t Prints the post-processed (HP filtered, downsampled, padding removed, with injections) data to data.txt.\n");
       fprintf(stdout,"\t--print-injection (-z)\tFLAG\t Prints the injeciton data to injection.txt.\n");
+      fprintf(stdout,"\t--num-threads (-N)\tINTEGER\t Number of threads filtering the data with the templates (default 1).\n");
       fprintf(stdout,"\t--help (-h)\t\t\tFLAG\t Print this message.\n");
       fprintf(stdout,"eg %s  --sample-rate 4096 --bank-freq-start 30 --bank-lowest-hifreq-cutoff 200 --settling-time 0.1 --short-segment-duration 4 --cusp-search --cluster-events 0.1 --pad 4 --threshold 4 --output ladida.xml --frame-cache cache/H-H1_RDS_C01_LX-795169179-795171015.cache --channel H1:LSC-STRAIN --gps-start-time 795170318 --gps-end-time 795170396\n", argv[0]);
       exit(0);
@@ -1525,6 +1642,12 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA, const
       fprintf(stderr,"Only integer values allowed for --gps-end-time.\n");
       return 1;
     }
+  if(CLA->nthreads < 1)
+    {
+      fprintf(stderr,"Number of threads must be at least 1.\n");
+      fprintf(stderr,"Try %s -h \n",argv[0]);
+      return 1;
+    }
   if(CLA->ShortSegDuration == 0)
     {
       fprintf(stderr,"Short segment duration not specified (they overlap by 50%s).\n","%");
@@ -44,6 +44,7 @@
 #include <lal/LALMalloc.h>
 #include <lal/LALStdlib.h>
 #include <lal/LIGOLwXMLArray.h>
+#include <lal/LIGOMetadataColumns.h>
 #include <lal/LIGOMetadataTables.h>
 #include <lal/RealFFT.h>
 #include <lal/SnglBurstUtils.h>
@@ -54,6 +55,11 @@
 #include <lal/Window.h>
 
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+
 static double min(double a, double b)
 {
 	return a < b ? a : b;
@@ -378,7 +384,6 @@ typedef struct tagREAL8TimeFrequencyPlane {
 	double deltaF;			/**< TF plane's frequency resolution (channel spacing) */
 	double flow;			/**< low frequency boundary of TF plane */
 	gsl_matrix *channel_data;   	/**< channel data.  each channel is placed into its own column.  channel_data[i * channels + j] corresponds to time epoch + i * deltaT and the frequency band [flow + j * deltaF, flow + (j + 1) * deltaF) */
-	REAL8Sequence *channel_buffer;	/**< re-usable holding area for the data for a single channel */
 	REAL8Sequence *unwhitened_channel_buffer;	/**< UNDOCUMENTED */
 	REAL8TimeFrequencyPlaneTiles tiles;	/**< time-frequency plane's tiling information */
 	REAL8Window *window;		/**< time-domain window applied to input time series for tapering edges to 0 */
@@ -405,7 +410,6 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 {
 	REAL8TimeFrequencyPlane *plane;
 	gsl_matrix *channel_data;
-	REAL8Sequence *channel_buffer;
 	REAL8Sequence *unwhitened_channel_buffer;
 	REAL8Window *tukey;
 	REAL8Sequence *correlation;
@@ -506,7 +510,6 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 
 	plane = XLALMalloc(sizeof(*plane));
 	channel_data = gsl_matrix_alloc(tseries_length, channels);
-	channel_buffer = XLALCreateREAL8Sequence(tseries_length);
 	unwhitened_channel_buffer = XLALCreateREAL8Sequence(tseries_length);
 	tukey = XLALCreateTukeyREAL8Window(tseries_length, (tseries_length - tiling_length) / (double) tseries_length);
 	if(tukey)
@@ -514,11 +517,10 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 	else
 		/* error path */
 		correlation = NULL;
-	if(!plane || !channel_data || !channel_buffer || !unwhitened_channel_buffer || !tukey || !correlation) {
+	if(!plane || !channel_data || !unwhitened_channel_buffer || !tukey || !correlation) {
 		XLALFree(plane);
 		if(channel_data)
 			gsl_matrix_free(channel_data);
-		XLALDestroyREAL8Sequence(channel_buffer);
 		XLALDestroyREAL8Sequence(unwhitened_channel_buffer);
 		XLALDestroyREAL8Window(tukey);
 		XLALDestroyREAL8Sequence(correlation);
@@ -536,7 +538,6 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 	plane->deltaF = deltaF;
 	plane->flow = flow;
 	plane->channel_data = channel_data;
-	plane->channel_buffer = channel_buffer;
 	plane->unwhitened_channel_buffer = unwhitened_channel_buffer;
 	plane->tiles.max_length = max_length;
 	plane->tiles.min_channels = min_channels;
@@ -569,7 +570,6 @@ static void XLALDestroyTFPlane(
 	if(plane) {
 		if(plane->channel_data)
 			gsl_matrix_free(plane->channel_data);
-		XLALDestroyREAL8Sequence(plane->channel_buffer);
 		XLALDestroyREAL8Sequence(plane->unwhitened_channel_buffer);
 		XLALDestroyREAL8Window(plane->window);
 		XLALDestroyREAL8Sequence(plane->two_point_spectral_correlation);
@@ -638,8 +638,8 @@ static int XLALFreqSeriesToTFPlane(
 	const REAL8FFTPlan *reverseplan
 )
 {
-	COMPLEX16Sequence *fcorr;
-	unsigned i;
+	const int channels = plane->channel_data->size2;
+	int errorcode = 0;
 
 	/* check input parameters */
 	if((fmod(plane->deltaF, fseries->deltaF) != 0.0) ||
@@ -651,11 +651,6 @@ static int XLALFreqSeriesToTFPlane(
 	   (plane->flow + plane->channel_data->size2 * plane->deltaF > fseries->f0 + fseries->data->length * fseries->deltaF))
 		XLAL_ERROR(XLAL_EDATA);
 
-	/* create temporary vectors */
-	fcorr = XLALCreateCOMPLEX16Sequence(fseries->data->length);
-	if(!fcorr)
-		XLAL_ERROR(XLAL_EFUNC);
-
 #if 0
 	/* diagnostic code to dump data for the \hat{s}_{k} histogram */
 	{
@@ -691,9 +686,25 @@ static int XLALFreqSeriesToTFPlane(
 	}
 #endif
 
-	/* loop over the time-frequency plane's channels */
-	for(i = 0; i < plane->channel_data->size2; i++) {
+	/* loop over the time-frequency plane's channels.  the channels
+	 * are independent, and are shared out among the threads, each with
+	 * its own work space;  the reverse plan is only read. */
+#pragma omp parallel
+	{
+	COMPLEX16Sequence *fcorr = XLALCreateCOMPLEX16Sequence(fseries->data->length);
+	REAL8Sequence *channel_buffer = XLALCreateREAL8Sequence(plane->channel_data->size1);
+	int i;
+
+	if(!fcorr || !channel_buffer) {
+#pragma omp critical (EPSearch_TFPlane_error)
+		errorcode = XLAL_EFUNC;
+	}
+
+#pragma omp for schedule(static)
+	for(i = 0; i < channels; i++) {
 		unsigned j;
+		if(!fcorr || !channel_buffer)
+			continue;
 		/* cross correlate the input data against the channel
 		 * filter by taking their product in the frequency domain
 		 * and then inverse transforming to the time domain to
@@ -701,17 +712,22 @@ static int XLALFreqSeriesToTFPlane(
 		 * XLALREAL8ReverseFFT() omits the factor of 1 / (N Delta
 		 * t) in the inverse transform. */
 		apply_filter(fcorr, fseries, filter_bank->basis_filters[i].fseries);
-		if(XLALREAL8ReverseFFT(plane->channel_buffer, fcorr, reverseplan)) {
-			XLALDestroyCOMPLEX16Sequence(fcorr);
-			XLAL_ERROR(XLAL_EFUNC);
+		if(XLALREAL8ReverseFFT(channel_buffer, fcorr, reverseplan)) {
+#pragma omp critical (EPSearch_TFPlane_error)
+			errorcode = XLAL_EFUNC;
+			continue;
 		}
 		/* interleave the result into the channel_data array */
-		for(j = 0; j < plane->channel_buffer->length; j++)
-			gsl_matrix_set(plane->channel_data, j, i, plane->channel_buffer->data[j]);
+		for(j = 0; j < channel_buffer->length; j++)
+			gsl_matrix_set(plane->channel_data, j, i, channel_buffer->data[j]);
 	}
 
 	/* clean up */
 	XLALDestroyCOMPLEX16Sequence(fcorr);
+	XLALDestroyREAL8Sequence(channel_buffer);
+	}
+	if(errorcode)
+		XLAL_ERROR(errorcode);
 
 	/* set the name and epoch of the TF plane */
 	strncpy(plane->name, fseries->name, LALNameLength);
@@ -748,11 +764,12 @@ static double compute_unwhitened_mean_square(
 
 
 /*
- * Convert time-frequency tile info to a SnglBurst row.
+ * Fill in a SnglBurst row from time-frequency tile info.
  */
 
 
-static SnglBurst *XLALTFTileToBurstEvent(
+static void XLALTFTileToBurstEvent(
+	SnglBurst *event,
 	const REAL8TimeFrequencyPlane *plane,
 	double tile_start,	/* in samples, allowed to be non-integer */
 	double tile_length,	/* in samples, allowed to be non-integer */
@@ -764,12 +781,6 @@ static SnglBurst *XLALTFTileToBurstEvent(
 	double confidence
 )
 {
-	SnglBurst *event = XLALCreateSnglBurst();
-
-	if(!event)
-		XLAL_ERROR_NULL(XLAL_ENOMEM);
-
-	event->next = NULL;
 	strncpy(event->ifo, plane->name, 2);
 	event->ifo[2] = '\0';
 	strncpy(event->search, "excesspower", LIGOMETA_SEARCH_MAX);
@@ -788,15 +799,22 @@ static SnglBurst *XLALTFTileToBurstEvent(
 	event->snr = E / d - 1;
 	/* -ln P(event | stationary Gaussian white noise) */
 	event->confidence = confidence;
-
-	return event;
 }
 
 
-static SnglBurst *XLALComputeExcessPower(
+/*
+ * Compute the excess power for each time-frequency tile, and append those
+ * tiles whose confidence is above threshold to the column table of
+ * events.  Appending to the columns, rather than allocating a linked list
+ * row for each of what can be very many tiles, keeps the events in a few
+ * contiguous arrays.
+ */
+
+
+static int XLALComputeExcessPower(
 	const REAL8TimeFrequencyPlane *plane,
 	const LALExcessPowerFilterBank *filter_bank,
-	SnglBurst *head,
+	SnglBurstColumns *events,
 	double confidence_threshold
 )
 {
@@ -810,6 +828,9 @@ static SnglBurst *XLALComputeExcessPower(
 	gsl_vector_view filter_output_view;
 	gsl_vector *channel_buffer;
 	gsl_vector *unwhitened_channel_buffer;
+	SnglBurst *event;
+	double *energy;
+	double *uwenergy;
 	unsigned channel;
 	unsigned channels;
 	unsigned channel_end;
@@ -826,12 +847,19 @@ static SnglBurst *XLALComputeExcessPower(
 
 	channel_buffer = gsl_vector_alloc(filter_output.size);
 	unwhitened_channel_buffer = gsl_vector_alloc(filter_output.size);
-	if(!channel_buffer || !unwhitened_channel_buffer) {
+	energy = XLALMalloc((filter_output.size + 1) * sizeof(*energy));
+	uwenergy = XLALMalloc((filter_output.size + 1) * sizeof(*uwenergy));
+	/* scratch row from which events are appended to the columns */
+	event = XLALCreateSnglBurst();
+	if(!channel_buffer || !unwhitened_channel_buffer || !energy || !uwenergy || !event) {
 		if(channel_buffer)
 			gsl_vector_free(channel_buffer);
 		if(unwhitened_channel_buffer)
 			gsl_vector_free(unwhitened_channel_buffer);
-		XLAL_ERROR_NULL(XLAL_ENOMEM);
+		XLALFree(energy);
+		XLALFree(uwenergy);
+		XLALDestroySnglBurst(event);
+		XLAL_ERROR(XLAL_ENOMEM);
 	}
 
 	/*
@@ -889,11 +917,15 @@ static SnglBurst *XLALComputeExcessPower(
 		}
 #endif
 
-		/* square the samples in the channel time series because
-		 * from now on that's all we'll need */
+		/* from now on all we need are sums of the squares of the
+		 * samples over runs of samples, so build the running sums
+		 * of the squares.  the sum over any run is then the
+		 * difference of two of these, and every tile in this
+		 * channel costs the same regardless of its duration */
+		energy[0] = uwenergy[0] = 0;
 		for(i = 0; i < channel_buffer->size; i++) {
-			gsl_vector_set(channel_buffer, i, pow(gsl_vector_get(channel_buffer, i), 2));
-			gsl_vector_set(unwhitened_channel_buffer, i, pow(gsl_vector_get(unwhitened_channel_buffer, i), 2));
+			energy[i + 1] = energy[i] + pow(gsl_vector_get(channel_buffer, i), 2);
+			uwenergy[i + 1] = uwenergy[i] + pow(gsl_vector_get(unwhitened_channel_buffer, i), 2);
 		}
 
 	/* start with at least 2 degrees of freedom */
@@ -901,13 +933,10 @@ static SnglBurst *XLALComputeExcessPower(
 		unsigned start;
 	for(start = 0; start + tile_dof <= channel_buffer->size; start += tile_dof / plane->tiles.inv_fractional_stride) {
 		/* compute sum of squares, and unwhitened sum of squares
-		 * (samples have already been squared) */
-		double sumsquares = 0;
-		double uwsumsquares = 0;
-		for(i = start; i < start + tile_dof; i++) {
-			sumsquares += gsl_vector_get(channel_buffer, i);
-			uwsumsquares += gsl_vector_get(unwhitened_channel_buffer, i);
-		}
+		 * from the running sums */
+		const unsigned end = start + tile_dof;
+		const double sumsquares = energy[end] - energy[start];
+		const double uwsumsquares = uwenergy[end] - uwenergy[start];
 
 		/* compute statistical confidence */
 		/* FIXME:  the 0.62 is an empirically determined
@@ -921,25 +950,28 @@ static SnglBurst *XLALComputeExcessPower(
 		if(XLALIsREAL8FailNaN(confidence)) {
 			gsl_vector_free(channel_buffer);
 			gsl_vector_free(unwhitened_channel_buffer);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
+			XLALFree(energy);
+			XLALFree(uwenergy);
+			XLALDestroySnglBurst(event);
+			XLAL_ERROR(XLAL_EFUNC);
 		}
 
 		/* record tiles whose statistical confidence is above
 		 * threshold and that have real-valued h_rss */
 		if((confidence >= confidence_threshold) && (uwsumsquares >= tile_dof)) {
-			SnglBurst *oldhead = head;
-
 			/* compute h_rss */
 			h_rss = sqrt((uwsumsquares - tile_dof) * (stride * plane->deltaT)) * strain_rms;
 
-			/* add new event to head of linked list */
-			head = XLALTFTileToBurstEvent(plane, plane->tiles.tiling_start + (start - 0.5) * stride, tile_dof * stride, plane->flow + (channel + .5 * channels) * plane->deltaF, channels * plane->deltaF, h_rss, sumsquares, tile_dof, confidence);
-			if(!head) {
+			/* append new event to the columns */
+			XLALTFTileToBurstEvent(event, plane, plane->tiles.tiling_start + (start - 0.5) * stride, tile_dof * stride, plane->flow + (channel + .5 * channels) * plane->deltaF, channels * plane->deltaF, h_rss, sumsquares, tile_dof, confidence);
+			if(XLALSnglBurstColumnsAppend(events, event) < 0) {
 				gsl_vector_free(channel_buffer);
 				gsl_vector_free(unwhitened_channel_buffer);
-				XLAL_ERROR_NULL(XLAL_EFUNC);
+				XLALFree(energy);
+				XLALFree(uwenergy);
+				XLALDestroySnglBurst(event);
+				XLAL_ERROR(XLAL_EFUNC);
 			}
-			head->next = oldhead;
 		}
 	}
 	}
@@ -949,7 +981,10 @@ static SnglBurst *XLALComputeExcessPower(
 	/* success */
 	gsl_vector_free(channel_buffer);
 	gsl_vector_free(unwhitened_channel_buffer);
-	return head;
+	XLALFree(energy);
+	XLALFree(uwenergy);
+	XLALDestroySnglBurst(event);
+	return 0;
 }
 
 
@@ -963,7 +998,8 @@ static SnglBurst *XLALComputeExcessPower(
 
 
 /**
- * Generate a linked list of burst events from a time series.
+ * Generate a linked list of burst events from a time series.  The events
+ * are returned in the order in which they are found.
  */
 SnglBurst *XLALEPSearch(
 	LIGOLwXMLStream *diagnostics,
@@ -978,6 +1014,7 @@ SnglBurst *XLALEPSearch(
 )
 {
 	SnglBurst *head = NULL;
+	SnglBurstColumns *events = NULL;
 	int errorcode = 0;
 	int start_sample;
 	COMPLEX16FrequencySeries *fseries;
@@ -1003,7 +1040,8 @@ SnglBurst *XLALEPSearch(
 	fseries = XLALCreateCOMPLEX16FrequencySeries(tseries->name, &tseries->epoch, 0, 0, &lalDimensionlessUnit, window->data->length / 2 + 1);
 	if(fplan)
 		plane = XLALCreateTFPlane(window->data->length, tseries->deltaT, flow, bandwidth, fractional_stride, maxTileBandwidth, maxTileDuration, fplan);
-	if(!fplan || !rplan || !psd || !fseries || !plane) {
+	events = XLALCreateSnglBurstColumns(0);
+	if(!fplan || !rplan || !psd || !fseries || !plane || !events) {
 		errorcode = XLAL_EFUNC;
 		goto error;
 	}
@@ -1129,15 +1167,25 @@ SnglBurst *XLALEPSearch(
 		 * Compute the excess power for each time-frequency tile
 		 * using the data in the time-frequency plane, and add
 		 * those tiles whose confidence is above threshold to the
-		 * trigger list.  Note that because it is possible for
-		 * there to be 0 triggers found, we can't check for errors
-		 * by testing for head == NULL.
+		 * trigger columns.
 		 */
 
 		XLALPrintInfo("%s(): computing the excess power for each tile\n", __func__);
-		XLALClearErrno();
-		head = XLALComputeExcessPower(plane, filter_bank, head, confidence_threshold);
-		if(xlalErrno) {
+		if(XLALComputeExcessPower(plane, filter_bank, events, confidence_threshold) < 0) {
+			errorcode = XLAL_EFUNC;
+			goto error;
+		}
+	}
+
+	/*
+	 * Convert the trigger columns to a linked list.  Note that because
+	 * it is possible for there to be 0 triggers found, we can't check
+	 * for errors by testing for head == NULL.
+	 */
+
+	if(events->length) {
+		head = XLALSnglBurstColumnsToTable(events);
+		if(!head) {
 			errorcode = XLAL_EFUNC;
 			goto error;
 		}
@@ -1157,6 +1205,7 @@ SnglBurst *XLALEPSearch(
 	XLALDestroyCOMPLEX16FrequencySeries(fseries);
 	XLALDestroyExcessPowerFilterBank(filter_bank);
 	XLALDestroyTFPlane(plane);
+	XLALDestroySnglBurstColumns(events);
 	if(errorcode) {
 		XLALDestroySnglBurstTable(head);
 		XLAL_ERROR_NULL(errorcode);
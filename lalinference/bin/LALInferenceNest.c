@@ -125,7 +125,11 @@ int main(int argc, char *argv[]){
      }
 
   /* Set up the threads */
-  LALInferenceInitCBCThreads(state,1);
+  INT4 nthreads=1;
+  ProcessParamsTable *ppt_threads=LALInferenceGetProcParamVal(procParams,"--Nthreads");
+  if(ppt_threads) nthreads=atoi(ppt_threads->value);
+  if(nthreads<1) nthreads=1;
+  LALInferenceInitCBCThreads(state,nthreads);
 
   /* Init the prior */
   LALInferenceInitCBCPrior(state);
@@ -100,6 +100,7 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     ----------------------------------------------\n\
     (--adapt-temps)     Adapt the spacing between temperatures for uniform swap acceptance\n\
     (--temp-skip N)     Number of steps between temperature swap proposals (100)\n\
+    (--async-swaps)     Swap between neighbouring temperatures without synchronising all processes\n\
     (--tempKill N)      Iteration number to stop temperature swapping (Niter)\n\
     (--ntemps N)         Number of temperature chains in ladder (as many as needed)\n\
     (--temp-min T)      Lowest temperature for parallel tempering (1.0)\n\
@@ -240,6 +241,22 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     if (ppt)
         adapt_temps = 1;
 
+    /* Swap between neighbouring temperatures with point-to-point messages,
+        without synchronising all processes at every swap */
+    INT4 async_swaps = 0;
+    ppt = LALInferenceGetProcParamVal(command_line, "--async-swaps");
+    if (ppt) {
+        INT4 mpi_thread_support;
+        MPI_Query_thread(&mpi_thread_support);
+        if (mpi_thread_support < MPI_THREAD_SERIALIZED) {
+            if (mpi_rank == 0)
+                fprintf(stderr, "WARNING: MPI library does not support MPI_THREAD_SERIALIZED, ignoring --async-swaps.\n");
+        } else {
+            async_swaps = 1;
+            runState->parallelSwap = &LALInferencePTswapAsync;
+        }
+    }
+
     /* Starting temperature of the ladder */
     REAL8 tempMin = 1.0;
     ppt = LALInferenceGetProcParamVal(command_line, "--temp-min");
@@ -296,6 +313,7 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     LALInferenceAddINT4Variable(algorithm_params, "mpisize", mpi_size, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "ntemps", ntemps, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "adapt_temps", adapt_temps, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddINT4Variable(algorithm_params, "async_swaps", async_swaps, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddREAL8Variable(algorithm_params, "temp_min", tempMin, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddREAL8Variable(algorithm_params, "temp_max", tempMax, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "de_buffer_limit", de_buffer_limit, LALINFERENCE_PARAM_OUTPUT);
@@ -666,12 +684,13 @@ ProcessParamsTable *LALInferenceContinueMCMC(char *infileName) {
 
 
 int main(int argc, char *argv[]){
-    INT4 mpirank;
+    INT4 mpirank, mpi_thread_support;
     ProcessParamsTable *procParams = NULL, *ppt = NULL;
     LALInferenceRunState *runState = NULL;
     LALInferenceIFOData *data = NULL;
 
-    MPI_Init(&argc, &argv);
+    /* Asynchronous swaps communicate from within OpenMP threads */
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &mpi_thread_support);
     MPI_Comm_rank(MPI_COMM_WORLD, &mpirank);
 
     if (mpirank == 0) fprintf(stdout," ========== LALInference_MCMC ==========\n");
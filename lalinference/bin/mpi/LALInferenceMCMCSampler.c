@@ -197,6 +197,57 @@ static void install_resume_handler(int checkpoint_exit)
        *I think condor handles this, so didn't add a handler CHECK */
   }
 
+/* Write the checkpoint and samples, retrying in case of filesystem congestion */
+static void checkpoint_mcmc(LALInferenceRunState *runState) {
+    INT4 MPIrank;
+    INT4 saveattempts=0;
+    INT4 retrydelay=5; /* 5 seconds before initial retry */
+    INT4 retcode=XLAL_SUCCESS;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+
+    /* The following checkpoint code is wrapped in do {} while loops
+     * to allow 10 retries, in case of filesystem congestion
+     */
+    do
+    {
+        XLAL_TRY(LALInferenceCheckpointMCMC(runState), retcode);
+        if(retcode!=XLAL_SUCCESS) 
+        {
+            saveattempts+=1;
+            fprintf(stderr,"Process %i failed to write checkpoint file %s \
+            at attempt %i, waiting to retry\n",MPIrank, runState->resumeOutFileName, saveattempts);
+            sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
+        }
+    } while (retcode!=XLAL_SUCCESS && saveattempts<10);
+    if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
+    saveattempts=0;
+    do
+    {
+        XLAL_TRY(LALInferenceWriteMCMCSamples(runState), retcode);
+        if(retcode!=XLAL_SUCCESS) 
+        {
+            saveattempts+=1;
+            fprintf(stderr,"Process %i failed to write samples file %s \
+            at attempt %i, waiting to retry\n",MPIrank, runState->outFileName, saveattempts);
+            sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
+        }
+    } while (retcode!=XLAL_SUCCESS && saveattempts<10);
+    if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
+}
+
+/* Asynchronous parallel tempering, see LALInferencePTswapAsync() */
+enum {PTASYNC_OFFER, PTASYNC_DONE};
+enum {PTASYNC_REJECT, PTASYNC_ACCEPT, PTASYNC_BUSY};
+enum {PTASYNC_NONE, PTASYNC_SAVE, PTASYNC_EXIT, PTASYNC_COMPLETE};
+
+static void ptasync_init(LALInferenceRunState *runState);
+static void ptasync_step(LALInferenceThreadState *thread, INT4 t);
+static void ptasync_send_control(INT4 kind);
+static INT4 ptasync_recv_control(void);
+static void ptasync_barrier(LALInferenceRunState *runState);
+static void ptasync_finish(LALInferenceRunState *runState, int CondorExitCode);
+
 void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     INT4 t=0; //indexes for for() loops
     INT4 runComplete = 0;
@@ -230,6 +281,7 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     INT4 Nskip = LALInferenceGetINT4Variable(algorithm_params, "skip");
     INT4 temp_skip = LALInferenceGetINT4Variable(algorithm_params, "tskip");
     INT4 adapt_temps = LALInferenceGetINT4Variable(algorithm_params, "adapt_temps");
+    INT4 async_swaps = LALInferenceGetINT4Variable(algorithm_params, "async_swaps");
     INT4 de_buffer_limit = LALInferenceGetINT4Variable(algorithm_params, "de_buffer_limit");
     INT4 randomseed = LALInferenceGetINT4Variable(algorithm_params, "random_seed");
 
@@ -368,6 +420,9 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         install_resume_handler(CondorExitCode);
     }
 
+    if (async_swaps)
+        ptasync_init(runState);
+
     fflush(stdout);
     MPI_Barrier(MPI_COMM_WORLD);
 
@@ -385,6 +440,9 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
             thread = &runState->threads[t];
 
             for (i=0; i<temp_skip; i++) {
+                if (async_swaps)
+                    ptasync_step(thread, t);
+
                 /* Increment iteration counter */
                 thread->step += 1;
 
@@ -460,49 +518,48 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
                     local_saveStateFlag=__master_saveStateFlag;
                     local_exitFlag=__master_exitFlag;
 		}
-		MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
-		MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
-        INT4 saveattempts=0;
-        INT4 retrydelay=5; /* 5 seconds before initial retry */
-        INT4 retcode=XLAL_SUCCESS;
-        /* The following checkpoint code is wrapped in do {} while loops
-         * to allow 10 retries, in case of filesystem congestion
-         */
+        if (async_swaps) {
+            /* Only pass on requests, rather than broadcasting every cycle */
+            if (MPIrank == 0) {
+                if (local_exitFlag)
+                    ptasync_send_control(PTASYNC_EXIT);
+                else if (local_saveStateFlag)
+                    ptasync_send_control(PTASYNC_SAVE);
+            } else {
+                switch (ptasync_recv_control()) {
+                    case PTASYNC_EXIT:
+                        local_exitFlag = 1;
+                        local_saveStateFlag = 1;
+                        break;
+                    case PTASYNC_SAVE:
+                        local_saveStateFlag = 1;
+                        break;
+                    case PTASYNC_COMPLETE:
+                        runComplete = 1;
+                        break;
+                }
+            }
+        } else {
+            MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+            MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        }
 		if(local_saveStateFlag!=0)
 		{
-            do
-            {
-                XLAL_TRY(LALInferenceCheckpointMCMC(runState), retcode);
-                if(retcode!=XLAL_SUCCESS) 
-                {
-                    saveattempts+=1;
-                    fprintf(stderr,"Process %i failed to write checkpoint file %s \
-                    at attempt %i, waiting to retry\n",MPIrank, runState->resumeOutFileName, saveattempts);
-                    sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
-                }
-            } while (retcode!=XLAL_SUCCESS && saveattempts<10);
-            if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
-            saveattempts=0;
-            do
-            {
-                XLAL_TRY(LALInferenceWriteMCMCSamples(runState), retcode);
-                if(retcode!=XLAL_SUCCESS) 
-                {
-                    saveattempts+=1;
-                    fprintf(stderr,"Process %i failed to write samples file %s \
-                    at attempt %i, waiting to retry\n",MPIrank, runState->outFileName, saveattempts);
-                    sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
-                }
-            } while (retcode!=XLAL_SUCCESS && saveattempts<10);
-            if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
+            checkpoint_mcmc(runState);
             /* Wait for all processes to save */
-			MPI_Barrier(MPI_COMM_WORLD);
+            if (async_swaps)
+                ptasync_barrier(runState);
+            else
+                MPI_Barrier(MPI_COMM_WORLD);
 			__master_saveStateFlag=0;
             local_saveStateFlag=0;
 		}
 		if(local_exitFlag) {
 				/* Wait for all processes to be ready to exit */
-				MPI_Barrier(MPI_COMM_WORLD);
+                if (async_swaps)
+                    ptasync_barrier(runState);
+                else
+                    MPI_Barrier(MPI_COMM_WORLD);
 				exit(CondorExitCode);
 		}
 
@@ -516,8 +573,9 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         /* Excute swap proposal. */
         runState->parallelSwap(runState, verbose_file);
 
-        /* Modify temperatures to strive for uniform swap acceptance rates */
-        if (adapt_temps)
+        /* Modify temperatures to strive for uniform swap acceptance rates.
+         * Asynchronous swaps adapt each temperature against its neighbour instead. */
+        if (adapt_temps && !async_swaps)
             LALInferenceAdaptLadder(runState);
 
         if (tempVerbose)
@@ -561,8 +619,13 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         }
 
         /* Broadcast the root's decision on run completion */
-        MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (!async_swaps)
+            MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
     }// while (!runComplete)
+
+    if (async_swaps)
+        ptasync_finish(runState, CondorExitCode);
+
     LALInferenceWriteMCMCSamples(runState);
     MPI_Barrier(MPI_COMM_WORLD);
 }
@@ -765,6 +828,56 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
 //-----------------------------------------
 // Swap routines:
 //-----------------------------------------
+/* Propose a swap between two chains held by this process */
+static void swap_local_chains(LALInferenceRunState *runState, INT4 cold_ind, INT4 hot_ind, FILE *swapfile) {
+    INT4 n_local_threads = runState->nthreads;
+    INT4 swapAccepted;
+    REAL8 logThreadSwap, temp_prior, temp_like;
+    LALInferenceThreadState *cold_thread, *hot_thread;
+    LALInferenceVariables *temp_params;
+
+    cold_thread = &runState->threads[cold_ind % n_local_threads];
+    hot_thread = &runState->threads[hot_ind % n_local_threads];
+
+    /* Determine if swap is accepted and tell the other chain */
+    logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
+    logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
+
+    if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+        swapAccepted = 1;
+    else
+        swapAccepted = 0;
+    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+    cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+
+    /* Print to file if verbose is chosen */
+    if (swapfile != NULL) {
+        REAL8 acc_frac = 0.0;
+        for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+            acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+        cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
+        fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
+                cold_thread->step, cold_ind, cold_thread->temperature,
+                hot_ind, hot_thread->temperature,
+                logThreadSwap, cold_thread->currentLikelihood,
+                hot_thread->currentLikelihood, swapAccepted, acc_frac);
+    }
+
+    if (swapAccepted) {
+        temp_params = hot_thread->currentParams;
+        temp_prior = hot_thread->currentPrior;
+        temp_like = hot_thread->currentLikelihood;
+
+        hot_thread->currentParams = cold_thread->currentParams;
+        hot_thread->currentPrior = cold_thread->currentPrior;
+        hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+
+        cold_thread->currentParams = temp_params;
+        cold_thread->currentPrior = temp_prior;
+        cold_thread->currentLikelihood = temp_like;
+    }
+}
+
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     INT4 MPIrank, MPIsize;
     MPI_Status MPIstatus;
@@ -775,10 +888,9 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     INT4 swapAccepted;
     INT4 *cold_inds;
     REAL8 adjCurrentLikelihood, adjCurrentPrior;
-    REAL8 logThreadSwap, temp_prior, temp_like, cold_temp;
+    REAL8 logThreadSwap, cold_temp;
     LALInferenceThreadState *cold_thread = &runState->threads[0];
     LALInferenceThreadState *hot_thread;
-    LALInferenceVariables *temp_params;
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
     MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
@@ -811,49 +923,8 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
         hot_rank = hot_ind/n_local_threads;
 
         if (cold_rank == hot_rank) {
-            if (MPIrank == cold_rank) {
-                cold_thread = &runState->threads[cold_ind % n_local_threads];
-                hot_thread = &runState->threads[hot_ind % n_local_threads];
-
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
-
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    REAL8 acc_frac = 0.0;
-                    for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
-                        acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
-                    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
-                    fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
-                            cold_thread->step, cold_ind, cold_thread->temperature,
-                            hot_ind, hot_thread->temperature,
-                            logThreadSwap, cold_thread->currentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted, acc_frac);
-                }
-
-                if (swapAccepted) {
-                    temp_params = hot_thread->currentParams;
-                    temp_prior = hot_thread->currentPrior;
-                    temp_like = hot_thread->currentLikelihood;
-
-                    hot_thread->currentParams = cold_thread->currentParams;
-                    hot_thread->currentPrior = cold_thread->currentPrior;
-                    hot_thread->currentLikelihood = cold_thread->currentLikelihood;
-
-                    cold_thread->currentParams = temp_params;
-                    cold_thread->currentPrior = temp_prior;
-                    cold_thread->currentLikelihood = temp_like;
-                }
-
-            }
+            if (MPIrank == cold_rank)
+                swap_local_chains(runState, cold_ind, hot_ind, swapfile);
         } else {
             if (MPIrank == cold_rank) {
                 cold_thread = &runState->threads[cold_ind % n_local_threads];
@@ -962,6 +1033,318 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
 }
 
 
+//-----------------------------------------
+// Asynchronous swap routines:
+//-----------------------------------------
+/*
+ * With --async-swaps chains are only coupled to their neighbours in the
+ * ladder, and no process waits on any other except the one it is swapping
+ * with.  Neighbouring temperatures held by the same process swap in
+ * LALInferencePTswapAsync().  Across a process boundary the top chain of
+ * rank r offers its state to the bottom chain of rank r+1 every temp_skip
+ * steps and stops sampling until the reply comes back, which keeps the
+ * swap exact.  The bottom chain answers between its own steps.  Offers
+ * only travel up the ladder and the hottest chain never makes one, so a
+ * chain of waiting processes always ends in one that is still sampling.
+ *
+ * Messages are REAL8 arrays holding a kind, then the sender's temperature,
+ * likelihood, prior, swap acceptance ratio and number of parameters, then
+ * the parameters.  A DONE offer tells rank r+1 that rank r has finished;
+ * a BUSY reply turns an offer down without counting it as a rejection.
+ * Rank 0 forwards checkpoint, exit and completion requests as
+ * point-to-point messages rather than broadcasting its flags every cycle.
+ */
+#define PTASYNC_HEADER 6
+
+typedef struct tagPTAsyncState {
+    INT4 rank;
+    INT4 size;
+    INT4 n_local_threads;
+    INT4 ntemps;
+    INT4 nPar;
+    INT4 msg_len;
+    INT4 temp_skip;
+    INT4 adapt_temps;
+    INT4 adaptLength;
+    REAL8 *offer;           // offer from our top chain to rank+1
+    REAL8 *reply;           // rank+1's reply to it
+    REAL8 *incoming;        // offer from rank-1 to our bottom chain
+    REAL8 *outgoing;        // our reply to it
+    INT4 lower_done;        // rank-1 will make no more offers
+    INT4 complete;          // rank 0 has ended the run
+} PTAsyncState;
+
+static PTAsyncState *ptasync = NULL;
+
+static REAL8 swap_acceptance_ratio(LALInferenceThreadState *thread) {
+    REAL8 acc_ratio = 0.0;
+    for (INT4 i=0; i<thread->temp_swap_window; i++)
+        acc_ratio += (REAL8)thread->temp_swap_accepts[i] / thread->temp_swap_window;
+
+    return acc_ratio;
+}
+
+/* Move a temperature relative to its colder neighbour, following LALInferenceAdaptLadder() */
+static REAL8 adapt_temperature(LALInferenceThreadState *thread, REAL8 cold_temp, REAL8 cold_acc_ratio) {
+    REAL8 steps = ptasync->adaptLength + thread->step;
+    REAL8 decay = ptasync->adaptLength / (steps + ptasync->adaptLength);
+    REAL8 kappa = decay / (10*ptasync->temp_skip);
+    REAL8 dS = kappa * (cold_acc_ratio - swap_acceptance_ratio(thread));
+
+    return cold_temp + (thread->temperature - cold_temp) * exp(dS);
+}
+
+static void ptasync_pack(REAL8 *msg, INT4 kind, LALInferenceThreadState *thread) {
+    msg[0] = kind;
+    msg[1] = thread->temperature;
+    msg[2] = thread->currentLikelihood;
+    msg[3] = thread->currentPrior;
+    msg[4] = swap_acceptance_ratio(thread);
+    msg[5] = ptasync->nPar;
+    LALInferenceCopyVariablesToArray(thread->currentParams, &msg[PTASYNC_HEADER]);
+}
+
+static void ptasync_unpack(REAL8 *msg, LALInferenceThreadState *thread) {
+    if ((INT4)msg[5] != ptasync->nPar) {
+        fprintf(stderr, "Process %i received %i parameters in a swap, expected %i.\n",
+                ptasync->rank, (INT4)msg[5], ptasync->nPar);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    thread->currentLikelihood = msg[2];
+    thread->currentPrior = msg[3];
+    LALInferenceCopyArrayToVariables(&msg[PTASYNC_HEADER], thread->currentParams);
+}
+
+/* MPI calls may come from any OpenMP thread, one at a time */
+static int ptasync_probe(INT4 source, INT4 tag) {
+    int flag = 0;
+
+    #pragma omp critical (LALInferenceMPI)
+    MPI_Iprobe(source, tag, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
+
+    return flag;
+}
+
+/* Answer an offer to the bottom chain from rank-1, if one is waiting.  A busy chain turns it down. */
+static void ptasync_answer(LALInferenceThreadState *thread, INT4 busy) {
+    PTAsyncState *st = ptasync;
+    INT4 swapAccepted = PTASYNC_BUSY;
+    REAL8 logThreadSwap;
+
+    if (st->rank == 0 || st->lower_done || !ptasync_probe(st->rank-1, PT_ASYNC_OFFER_COM))
+        return;
+
+    #pragma omp critical (LALInferenceMPI)
+    MPI_Recv(st->incoming, st->msg_len, MPI_DOUBLE, st->rank-1, PT_ASYNC_OFFER_COM, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    if (st->incoming[0] == PTASYNC_DONE) {
+        st->lower_done = 1;
+        return;
+    }
+
+    if (!busy) {
+        logThreadSwap = 1.0/st->incoming[1] - 1.0/thread->temperature;
+        logThreadSwap *= thread->currentLikelihood - st->incoming[2];
+
+        if ((logThreadSwap > 0) || (log(gsl_rng_uniform(thread->GSLrandom)) < logThreadSwap ))
+            swapAccepted = PTASYNC_ACCEPT;
+        else
+            swapAccepted = PTASYNC_REJECT;
+    }
+
+    /* The colder chain has already posted the receive for this */
+    ptasync_pack(st->outgoing, swapAccepted, thread);
+    #pragma omp critical (LALInferenceMPI)
+    MPI_Send(st->outgoing, st->msg_len, MPI_DOUBLE, st->rank-1, PT_ASYNC_REPLY_COM, MPI_COMM_WORLD);
+
+    if (swapAccepted == PTASYNC_ACCEPT)
+        ptasync_unpack(st->incoming, thread);
+
+    /* Hottest chain doesn't move */
+    if (st->adapt_temps && !busy && thread->id < st->ntemps-1)
+        thread->temperature = adapt_temperature(thread, st->incoming[1], st->incoming[4]);
+}
+
+/* Offer the state of the top chain to rank+1 and hold it until the answer arrives */
+static void ptasync_offer(LALInferenceThreadState *thread) {
+    PTAsyncState *st = ptasync;
+    MPI_Request requests[2];
+    int done = 0;
+
+    ptasync_pack(st->offer, PTASYNC_OFFER, thread);
+
+    #pragma omp critical (LALInferenceMPI)
+    {
+        MPI_Irecv(st->reply, st->msg_len, MPI_DOUBLE, st->rank+1, PT_ASYNC_REPLY_COM, MPI_COMM_WORLD, &requests[0]);
+        MPI_Isend(st->offer, st->msg_len, MPI_DOUBLE, st->rank+1, PT_ASYNC_OFFER_COM, MPI_COMM_WORLD, &requests[1]);
+    }
+
+    while (!done) {
+        /* A lone chain is also the bottom chain, and rank-1 may be waiting on it */
+        if (st->n_local_threads == 1)
+            ptasync_answer(thread, 1);
+
+        #pragma omp critical (LALInferenceMPI)
+        MPI_Testall(2, requests, &done, MPI_STATUSES_IGNORE);
+    }
+
+    if (st->reply[0] != PTASYNC_BUSY) {
+        thread->temp_swap_accepts[thread->temp_swap_counter] = (st->reply[0] == PTASYNC_ACCEPT);
+        thread->temp_swap_counter = (thread->temp_swap_counter + 1) % thread->temp_swap_window;
+    }
+
+    if (st->reply[0] == PTASYNC_ACCEPT)
+        ptasync_unpack(st->reply, thread);
+}
+
+/* Called by each chain before every step */
+static void ptasync_step(LALInferenceThreadState *thread, INT4 t) {
+    PTAsyncState *st = ptasync;
+
+    if (t == 0)
+        ptasync_answer(thread, 0);
+
+    if (t == st->n_local_threads-1 && st->rank < st->size-1 && (thread->step % st->temp_skip) == 0)
+        ptasync_offer(thread);
+}
+
+static void ptasync_init(LALInferenceRunState *runState) {
+    PTAsyncState *st = XLALCalloc(1, sizeof(PTAsyncState));
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &st->rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &st->size);
+
+    st->n_local_threads = runState->nthreads;
+    st->ntemps = st->size * st->n_local_threads;
+    st->nPar = LALInferenceGetVariableDimensionNonFixed(runState->threads[0].currentParams);
+    st->msg_len = PTASYNC_HEADER + st->nPar;
+    st->temp_skip = LALInferenceGetINT4Variable(runState->algorithmParams, "tskip");
+    st->adapt_temps = LALInferenceGetINT4Variable(runState->algorithmParams, "adapt_temps");
+    st->adaptLength = LALInferenceGetINT4Variable(runState->algorithmParams, "adaptLength");
+
+    st->offer = XLALCalloc(4 * st->msg_len, sizeof(REAL8));
+    st->reply = st->offer + st->msg_len;
+    st->incoming = st->reply + st->msg_len;
+    st->outgoing = st->incoming + st->msg_len;
+
+    ptasync = st;
+}
+
+/* Send a checkpoint, exit or completion request from rank 0 to every other process */
+static void ptasync_send_control(INT4 kind) {
+    static int control[] = {PTASYNC_NONE, PTASYNC_SAVE, PTASYNC_EXIT, PTASYNC_COMPLETE};
+    MPI_Request request;
+
+    for (INT4 r = 1; r < ptasync->size; r++) {
+        MPI_Isend(&control[kind], 1, MPI_INT, r, RUN_CONTROL_COM, MPI_COMM_WORLD, &request);
+        MPI_Request_free(&request);
+    }
+
+    if (kind == PTASYNC_COMPLETE)
+        ptasync->complete = 1;
+}
+
+/* Pick up the next request from rank 0, if there is one */
+static INT4 ptasync_recv_control(void) {
+    int kind = PTASYNC_NONE;
+
+    if (ptasync->rank > 0 && ptasync_probe(0, RUN_CONTROL_COM)) {
+        MPI_Recv(&kind, 1, MPI_INT, 0, RUN_CONTROL_COM, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        if (kind == PTASYNC_COMPLETE)
+            ptasync->complete = 1;
+    }
+
+    return kind;
+}
+
+/* Barrier that keeps turning down offers, since rank-1 may be waiting on one */
+static void ptasync_barrier(LALInferenceRunState *runState) {
+    MPI_Request request;
+    int done = 0;
+
+    MPI_Ibarrier(MPI_COMM_WORLD, &request);
+    while (!done) {
+        ptasync_answer(&runState->threads[0], 1);
+        MPI_Test(&request, &done, MPI_STATUS_IGNORE);
+    }
+}
+
+/* Stop making offers, and keep answering rank-1 until it has stopped too */
+static void ptasync_finish(LALInferenceRunState *runState, int CondorExitCode) {
+    PTAsyncState *st = ptasync;
+    MPI_Request request = MPI_REQUEST_NULL;
+    INT4 kind;
+
+    if (st->rank == 0 && !st->complete)
+        ptasync_send_control(PTASYNC_COMPLETE);
+
+    if (st->rank < st->size-1) {
+        ptasync_pack(st->offer, PTASYNC_DONE, &runState->threads[st->n_local_threads-1]);
+        MPI_Isend(st->offer, st->msg_len, MPI_DOUBLE, st->rank+1, PT_ASYNC_OFFER_COM, MPI_COMM_WORLD, &request);
+    }
+
+    /* Requests from rank 0 still have to be honoured, as the other processes are waiting on them */
+    while (st->rank > 0 && !(st->lower_done && st->complete)) {
+        ptasync_answer(&runState->threads[0], 1);
+
+        kind = ptasync_recv_control();
+        if (kind == PTASYNC_SAVE || kind == PTASYNC_EXIT) {
+            checkpoint_mcmc(runState);
+            ptasync_barrier(runState);
+        }
+        if (kind == PTASYNC_EXIT) {
+            ptasync_barrier(runState);
+            exit(CondorExitCode);
+        }
+    }
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    XLALFree(st->offer);
+    XLALFree(st);
+    ptasync = NULL;
+}
+
+/* Swap states between neighbouring chains held by this process, without any communication */
+void LALInferencePTswapAsync(LALInferenceRunState *runState, FILE *swapfile) {
+    INT4 MPIrank;
+    INT4 n_local_threads = runState->nthreads;
+    INT4 ntemps, t, ind;
+    INT4 *cold_inds;
+    LALInferenceThreadState *thread;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+
+    if (n_local_threads > 1) {
+        cold_inds = XLALCalloc(n_local_threads-1, sizeof(INT4));
+        for (t = 0; t < n_local_threads-1; t++)
+            cold_inds[t] = MPIrank*n_local_threads + t;
+
+        gsl_ran_shuffle(runState->GSLrandom, cold_inds, n_local_threads-1, sizeof(INT4));
+
+        for (ind = 0; ind < n_local_threads-1; ind++)
+            swap_local_chains(runState, cold_inds[ind], cold_inds[ind]+1, swapfile);
+
+        XLALFree(cold_inds);
+    }
+
+    /* Adapt the local part of the ladder from the bottom up.  The bottom
+     * chain is adapted against rank-1 when it answers an offer. */
+    if (LALInferenceGetINT4Variable(runState->algorithmParams, "adapt_temps")) {
+        ntemps = ptasync->ntemps;
+        for (t = 1; t < n_local_threads; t++) {
+            thread = &runState->threads[t];
+            if (thread->id < ntemps-1)
+                thread->temperature = adapt_temperature(thread, runState->threads[t-1].temperature,
+                                                        swap_acceptance_ratio(&runState->threads[t-1]));
+        }
+    }
+
+    return;
+}
+
+
 // UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile) {
 //     INT4 MPIrank;
 //     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
@@ -54,7 +54,10 @@ typedef enum {
     PT_COM,          /** Parallel tempering communications */
     LADDER_UPDATE_COM,    /** Update positions across the ladder */
     RUN_PHASE_COM,   /** runPhase passing */
-    RUN_COMPLETE       /** Run complete */
+    RUN_COMPLETE,       /** Run complete */
+    PT_ASYNC_OFFER_COM,   /** Asynchronous swap offers, sent up the ladder */
+    PT_ASYNC_REPLY_COM,   /** Replies to asynchronous swap offers */
+    RUN_CONTROL_COM       /** Checkpoint, exit and completion requests from the root */
 } LALInferenceMPIcomm;
 
 /* Temperature ladder adaptation */
@@ -63,6 +66,9 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState);
 /* Standard parallel temperature swap proposal function */
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile);
 
+/* Swap proposals between neighbouring temperatures without global synchronisation */
+void LALInferencePTswapAsync(LALInferenceRunState *runState, FILE *swapfile);
+
 /* Metropolis-coupled MCMC swap proposal, when the likelihood is not identical between chains */
 //UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile);
 
@@ -2330,38 +2330,109 @@ void LALInferenceLambdaTsEta2Lambdas(REAL8 lambdaT, REAL8 dLambdaT, REAL8 eta, R
   return;
 }
 
-/* Find lambda1,2(m1,2|eos) for 4-piece polytrope EOS model */
-void LALInferenceLogp1GammasMasses2Lambdas(REAL8 logp1,REAL8 gamma1,REAL8 gamma2,REAL8 gamma3, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2){
-// Convert to SI
-REAL8 logp1_si=logp1-1.0;
-double mass1_kg=mass1*LAL_MSUN_SI;
-double mass2_kg=mass2*LAL_MSUN_SI;
+/* Makes the EOS of the EOS parameters key[1...keylen-1]
+ * of a 4-piece polytrope (key[0] = 0) or spectral (key[0] = 1) EOS model */
+static LALSimNeutronStarEOS *LALInferenceEOSFromKey(const double *key, size_t keylen){
+if(key[0] == 0.0)
+  // Convert to SI
+  return XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(key[1]-1.0, key[2], key[3], key[4]);
+else{
+  double gamma[keylen-1];
+  for(size_t i=0; i<keylen-1; i++) gamma[i]=key[i+1];
+  return XLALSimNeutronStarEOSSpectralDecomposition(gamma, keylen-1);
+}
+}
 
-// Make eos
+/* Checks that the mass turnover of an EOS does not happen too soon, so that
+ * its neutron star family contains enough points for interpolation */
+static int LALInferenceEOSHasEnoughPoints(LALSimNeutronStarEOS *eos){
+/* FIXME: This is a little clunky */
+double pdat;
+double mdat;
+double mdat_prev;
+double rdat;
+double kdat;
+
+/* Initialize previous value for mdat comparison, set to something that will always
+   make (mdat <= mdat_prev) == true. */
+mdat_prev = 0.0;
+
+// Ensure mass turnover does not happen too soon
+const double logpmin = 75.5;
+double logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
+double dlogp = (logpmax - logpmin) / 100.;
+// Need at least 8 points
+for (int i = 0; i < 4; ++i) {
+   pdat = exp(logpmin + i * dlogp);
+   XLALSimNeutronStarTOVODEIntegrate(&rdat, &mdat, &kdat, pdat, eos);
+   /* determine if maximum mass has been found */
+   if (mdat <= mdat_prev)
+      return 0;
+   mdat_prev = mdat;
+}
+return 1;
+}
+
+/* Find lambda1,2(m1,2|eos) for the EOS model and parameters in key, taking
+ * the neutron star family from the cache when there is one */
+static void LALInferenceEOSMasses2Lambdas(LALSimNeutronStarFamilyCache *cache, const double *key, size_t keylen, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2){
 LALSimNeutronStarEOS *eos = NULL;
 LALSimNeutronStarFamily *fam = NULL;
-eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si, gamma1, gamma2, gamma3);
-fam = XLALCreateSimNeutronStarFamily(eos);
+int found = cache ? XLALSimNeutronStarFamilyCacheLookup(cache, key, keylen, &eos, &fam) == 1 : 0;
+int cached = found && fam;
+
+// Make eos and family, unless cached; a cached eos without a family was
+// rejected by LALInferenceEOSPhysicalCheckCached(), so make a private one
+if(!cached){
+  eos = LALInferenceEOSFromKey(key, keylen);
+  // Only cache families which LALInferenceEOSPhysicalCheckCached() accepts;
+  // record an eos with too few points as rejected
+  if(cache && !found && !LALInferenceEOSHasEnoughPoints(eos)){
+    XLALSimNeutronStarFamilyCacheInsert(cache, key, keylen, eos, NULL);
+    found = 1;
+    eos = LALInferenceEOSFromKey(key, keylen);
+  }
+  fam = XLALCreateSimNeutronStarFamilyAdaptive(eos, LALINFERENCE_EOS_FAMILY_TOLERANCE);
+}
+
+// Calculate lambda1,2(m1,2|eos); masses outside the family are rejected by
+// LALInferenceEOSPhysicalCheck(), so leave their lambdas zero
+double m_kg[2] = {mass1*LAL_MSUN_SI, mass2*LAL_MSUN_SI};
+double lambda[2] = {0.0, 0.0};
+if(fam){
+  int errnum;
+  XLAL_TRY_SILENT(XLALSimNeutronStarTidalDeformabilities(lambda, NULL, m_kg, 2, fam), errnum);
+  if(errnum != XLAL_SUCCESS)
+    lambda[0] = lambda[1] = 0.0;
+}
+*lambda1 = lambda[0];
+*lambda2 = lambda[1];
 
-// Calculate lambda1(m1|eos)
-double r = XLALSimNeutronStarRadius(mass1_kg, fam);
-double k = XLALSimNeutronStarLoveNumberK2(mass1_kg, fam);
-double c = mass1 * LAL_MRSUN_SI / r;
-*lambda1= (2.0/3.0) * k / pow(c , 5.0);
+// Cache or clean up
+if(cache && !found && fam)
+  XLALSimNeutronStarFamilyCacheInsert(cache, key, keylen, eos, fam);
+else if(!cached){
+  XLALDestroySimNeutronStarFamily(fam);
+  XLALDestroySimNeutronStarEOS(eos);
+}
+}
 
-// Calculate lambda2(m2|eos)
-r = XLALSimNeutronStarRadius(mass2_kg, fam);
-k = XLALSimNeutronStarLoveNumberK2(mass2_kg, fam);
-c = mass2 * LAL_MRSUN_SI / r;
-*lambda2= (2.0/3.0) * k / pow(c , 5.0);
+/* Find lambda1,2(m1,2|eos) for 4-piece polytrope EOS model */
+void LALInferenceLogp1GammasMasses2Lambdas(REAL8 logp1,REAL8 gamma1,REAL8 gamma2,REAL8 gamma3, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2){
+LALInferenceLogp1GammasMasses2LambdasCached(NULL, logp1, gamma1, gamma2, gamma3, mass1, mass2, lambda1, lambda2);
+}
 
-// Clean up
-XLALDestroySimNeutronStarFamily(fam);
-XLALDestroySimNeutronStarEOS(eos);
+void LALInferenceLogp1GammasMasses2LambdasCached(LALSimNeutronStarFamilyCache *cache, REAL8 logp1,REAL8 gamma1,REAL8 gamma2,REAL8 gamma3, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2){
+const double key[] = {0.0, logp1, gamma1, gamma2, gamma3};
+LALInferenceEOSMasses2Lambdas(cache, key, 5, mass1, mass2, lambda1, lambda2);
 }
 
 /* Find lambda1,2(m1,2|eos) for spectral EOS model */
 void LALInferenceSDGammasMasses2Lambdas(REAL8 gamma[], REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2, int size){
+LALInferenceSDGammasMasses2LambdasCached(NULL, gamma, mass1, mass2, lambda1, lambda2, size);
+}
+
+void LALInferenceSDGammasMasses2LambdasCached(LALSimNeutronStarFamilyCache *cache, REAL8 gamma[], REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2, int size){
 
 // If unreasonable gammas, do not find lambdas
 if(LALInferenceSDGammaCheck(gamma, 4) == XLAL_FAILURE){
@@ -2370,31 +2441,10 @@ if(LALInferenceSDGammaCheck(gamma, 4) == XLAL_FAILURE){
 }
 // Else calculate lambdas
 else{
-  // Convert to SI
-  double mass1_kg=mass1*LAL_MSUN_SI;
-  double mass2_kg=mass2*LAL_MSUN_SI;
-
-  // Make eos
-  LALSimNeutronStarEOS *eos = NULL;
-  LALSimNeutronStarFamily *fam = NULL;
-  eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,size);
-  fam = XLALCreateSimNeutronStarFamily(eos);
-
-  // Calculate lambda1(m1|eos)
-  double r = XLALSimNeutronStarRadius(mass1_kg, fam);
-  double k = XLALSimNeutronStarLoveNumberK2(mass1_kg, fam);
-  double c = mass1 * LAL_MRSUN_SI / r;
-  *lambda1= (2.0/3.0) * k / pow(c , 5.0);
-
-  // Calculate lambda2(m1|eos)
-  r = XLALSimNeutronStarRadius(mass2_kg, fam);
-  k = XLALSimNeutronStarLoveNumberK2(mass2_kg, fam);
-  c = mass2 * LAL_MRSUN_SI / r;
-  *lambda2= (2.0/3.0) * k / pow(c , 5.0);
-
-  // Clean up
-  XLALDestroySimNeutronStarFamily(fam);
-  XLALDestroySimNeutronStarEOS(eos);
+  double key[1+size];
+  key[0] = 1.0;
+  for(int i=0; i<size; i++) key[i+1] = gamma[i];
+  LALInferenceEOSMasses2Lambdas(cache, key, 1+size, mass1, mass2, lambda1, lambda2);
 }
 
 }
@@ -2402,43 +2452,40 @@ else{
 
 /* Checks if EOS allows for acausal speed of sound and unphysical maximum masses */
 int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine){
+return LALInferenceEOSPhysicalCheckCached(params, commandLine, NULL);
+}
+
+int LALInferenceEOSPhysicalCheckCached(LALInferenceVariables *params, ProcessParamsTable *commandLine, LALSimNeutronStarFamilyCache *cache){
 int ret;
 
 LALSimNeutronStarEOS *eos=NULL;
 LALSimNeutronStarFamily *fam=NULL;
+double key[5];
 
 // If using 4-piece polytrope eos params...
 if(LALInferenceCheckVariable(params, "logp1") && LALInferenceCheckVariable(params, "gamma1") && LALInferenceCheckVariable(params, "gamma2") && LALInferenceCheckVariable(params, "gamma3"))
 {
   // Retrieve EOS params from params linked list
-  double logp1=*(double *)LALInferenceGetVariable(params,"logp1");
-  double gamma1=*(double *)LALInferenceGetVariable(params,"gamma1");
-  double gamma2=*(double *)LALInferenceGetVariable(params,"gamma2");
-  double gamma3=*(double *)LALInferenceGetVariable(params,"gamma3");
-
-  // Convert to SI
-  REAL8 logp1_si=logp1-1.0;
-
-  // Make 4-piece polytrope eos
-  eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si,gamma1,gamma2,gamma3);
+  key[0]=0.0;
+  key[1]=*(double *)LALInferenceGetVariable(params,"logp1");
+  key[2]=*(double *)LALInferenceGetVariable(params,"gamma1");
+  key[3]=*(double *)LALInferenceGetVariable(params,"gamma2");
+  key[4]=*(double *)LALInferenceGetVariable(params,"gamma3");
 
 // Else if using 4-coeff spectral eos params...
 }
 else if( LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariable(params,"SDgamma1") && LALInferenceCheckVariable(params,"SDgamma2") && LALInferenceCheckVariable(params,"SDgamma3"))
 {
   // Retrieve EOS params from params linked list
-  double SDgamma0=*(double *)LALInferenceGetVariable(params,"SDgamma0");
-  double SDgamma1=*(double *)LALInferenceGetVariable(params,"SDgamma1");
-  double SDgamma2=*(double *)LALInferenceGetVariable(params,"SDgamma2");
-  double SDgamma3=*(double *)LALInferenceGetVariable(params,"SDgamma3");
-  double gamma[]={SDgamma0,SDgamma1,SDgamma2,SDgamma3};
+  key[0]=1.0;
+  key[1]=*(double *)LALInferenceGetVariable(params,"SDgamma0");
+  key[2]=*(double *)LALInferenceGetVariable(params,"SDgamma1");
+  key[3]=*(double *)LALInferenceGetVariable(params,"SDgamma2");
+  key[4]=*(double *)LALInferenceGetVariable(params,"SDgamma3");
 
-  if(LALInferenceSDGammaCheck(gamma, 4) == XLAL_FAILURE)
+  if(LALInferenceSDGammaCheck(key+1, 4) == XLAL_FAILURE)
     return XLAL_FAILURE;
 
-  // Make 4-piece polytrope eos
-  eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,4);
-
 }
 // Else fail, since you need an eos
 else {
@@ -2446,50 +2493,44 @@ else {
   return XLAL_FAILURE;
 }
 
-/* FIXME: This is a little clunky,
-  Check to make sure family will contain
-  enough pts for interpolation */
-double pdat;
-double mdat;
-double mdat_prev;
-double rdat;
-double kdat;
+// Use the cached eos and family if this eos has been seen before; a
+// cached eos without a family has too few points
+if(cache && XLALSimNeutronStarFamilyCacheLookup(cache, key, 5, &eos, &fam) == 1){
+  if(!fam)
+    return XLAL_FAILURE;
+}
+else{
 
-/* Initialize previous value for mdat comparison, set to something that will always
-   make (mdat <= mdat_prev) == true. */
-mdat_prev = 0.0;
+// Make eos
+eos = LALInferenceEOSFromKey(key, 5);
 
-// Ensure mass turnover does not happen too soon
-const double logpmin = 75.5;
-double logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
-double dlogp = (logpmax - logpmin) / 100.;
-// Need at least 8 points
-for (int i = 0; i < 4; ++i) {
-   pdat = exp(logpmin + i * dlogp);
-   XLALSimNeutronStarTOVODEIntegrate(&rdat, &mdat, &kdat, pdat, eos);
-   /* determine if maximum mass has been found */
-   if (mdat <= mdat_prev){
-      fprintf(stdout,"EOS has too few points. Sample rejected.\n");
-      if( LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariable(params,"SDgamma1") && LALInferenceCheckVariable(params,"SDgamma2") && LALInferenceCheckVariable(params,"SDgamma3"))
-      {
-        // Retrieve EOS params from params linked list
-        double SDgamma0=*(double *)LALInferenceGetVariable(params,"SDgamma0");
-        double SDgamma1=*(double *)LALInferenceGetVariable(params,"SDgamma1");
-        double SDgamma2=*(double *)LALInferenceGetVariable(params,"SDgamma2");
-        double SDgamma3=*(double *)LALInferenceGetVariable(params,"SDgamma3");
-        fprintf(stdout,"spectral: %f %f %f %f\n",SDgamma0,SDgamma1,SDgamma2,SDgamma3);
-      }
-      // Clean up
-      XLALDestroySimNeutronStarFamily(fam);
-      XLALDestroySimNeutronStarEOS(eos);
-      return XLAL_FAILURE;
-    }
-    mdat_prev = mdat;
+// Check to make sure family will contain enough pts for interpolation
+if(!LALInferenceEOSHasEnoughPoints(eos)){
+  fprintf(stdout,"EOS has too few points. Sample rejected.\n");
+  if(key[0] == 1.0)
+  {
+    fprintf(stdout,"spectral: %f %f %f %f\n",key[1],key[2],key[3],key[4]);
+  }
+  // Clean up
+  if(cache)
+    XLALSimNeutronStarFamilyCacheInsert(cache, key, 5, eos, NULL);
+  else
+    XLALDestroySimNeutronStarEOS(eos);
+  return XLAL_FAILURE;
 }
 
-
 // Make family
-fam = XLALCreateSimNeutronStarFamily(eos);
+fam = XLALCreateSimNeutronStarFamilyAdaptive(eos, LALINFERENCE_EOS_FAMILY_TOLERANCE);
+if(cache)
+  XLALSimNeutronStarFamilyCacheInsert(cache, key, 5, eos, fam);
+if(!fam){
+  fprintf(stdout,"Could not make neutron star family. Sample rejected.\n");
+  if(!cache)
+    XLALDestroySimNeutronStarEOS(eos);
+  return XLAL_FAILURE;
+}
+
+}
 
 // Determine which mass parameterization is used
 double mass1 = 0.;
@@ -2517,8 +2558,10 @@ else {
   // Else fail
   fprintf(stdout,"ERROR: NO MASS PARAMETERS FOUND\n");
   // Clean up
-  XLALDestroySimNeutronStarFamily(fam);
-  XLALDestroySimNeutronStarEOS(eos);
+  if(!cache){
+    XLALDestroySimNeutronStarFamily(fam);
+    XLALDestroySimNeutronStarEOS(eos);
+  }
   return XLAL_FAILURE;
 }
 
@@ -2554,8 +2597,10 @@ if(mass1_kg <= max_mass_kg && mass2_kg <= max_mass_kg && mass1_kg >= min_mass_kg
 }
 
 // Clean up
-XLALDestroySimNeutronStarFamily(fam);
-XLALDestroySimNeutronStarEOS(eos);
+if(!cache){
+  XLALDestroySimNeutronStarFamily(fam);
+  XLALDestroySimNeutronStarEOS(eos);
+}
 return ret;
 }
 
@@ -2737,34 +2782,14 @@ static void addPtToCellPts(LALInferenceKDTree *cell, REAL8 *pt) {
   size_t npts = cell->npts;
   size_t dim = cell->dim;
 
-  /* copy previous points */
+  /* expand array, keeping the existing points (the top cells of a large
+     tree hold too many points to stage them on the stack) */
   if ( npts == ptsSize ){
-    REAL8 tmpArr[npts][dim];
+    cell->pts = XLALRealloc(cell->pts, 2*ptsSize*sizeof(REAL8 *));
 
-    /* copy points from cell */
-    for( UINT4 i=0; i < npts; i++ ){
-      for( UINT4 j=0; j < dim; j++ ){
-        tmpArr[i][j] = cell->pts[i][j];
-      }
-      XLALFree(cell->pts[i]); /* free column */
-    }
-
-    /* free array */
-    XLALFree(cell->pts);
-
-    /* expand array */
-    cell->pts = XLALCalloc(2*ptsSize, sizeof(REAL8 *));
-
-    /* copy vector into array */
-    for( UINT4 i=0; i < 2*ptsSize; i++ ){
+    for( UINT4 i=ptsSize; i < 2*ptsSize; i++ )
       cell->pts[i] = XLALCalloc(dim, sizeof(REAL8));
 
-      if (i < npts){
-        for( UINT4 j=0; j < dim; j++ )
-          cell->pts[i][j] = tmpArr[i][j];
-      }
-    }
-
     cell->ptsSize *= 2;
   }
 
@@ -3272,6 +3297,49 @@ REAL8 LALInferenceKDLogProposalRatio(LALInferenceKDTree *tree, REAL8 *current,
   return logCurrentCellFactor + logCurrentVolume - logProposedCellFactor - logProposedVolume;
 }
 
+/* Accumulates exp(-d^2/2) for the points of cell within squared distance
+   maxDist2 of pt, skipping cells whose bounds are further away than that. */
+static void kdGaussianKernelSum(LALInferenceKDTree *cell, REAL8 *pt, REAL8 maxDist2, REAL8 *sum) {
+  size_t i, j, dim;
+  REAL8 d2 = 0.0;
+
+  if (cell == NULL || cell->npts == 0) return;
+  dim = cell->dim;
+
+  /* Squared distance from pt to the cell */
+  for (j = 0; j < dim; j++) {
+    REAL8 dx = 0.0;
+    if (pt[j] < cell->lowerLeft[j]) dx = cell->lowerLeft[j] - pt[j];
+    else if (pt[j] > cell->upperRight[j]) dx = pt[j] - cell->upperRight[j];
+    d2 += dx*dx;
+    if (d2 > maxDist2) return;
+  }
+
+  if (cell->left == NULL && cell->right == NULL) {
+    for (i = 0; i < cell->npts; i++) {
+      d2 = 0.0;
+      for (j = 0; j < dim; j++) {
+        REAL8 dx = cell->pts[i][j] - pt[j];
+        d2 += dx*dx;
+      }
+      if (d2 <= maxDist2) *sum += exp(-0.5*d2);
+    }
+  } else {
+    kdGaussianKernelSum(cell->left, pt, maxDist2, sum);
+    kdGaussianKernelSum(cell->right, pt, maxDist2, sum);
+  }
+}
+
+REAL8 LALInferenceKDLogGaussianKernelSum(LALInferenceKDTree *tree, REAL8 *pt, REAL8 maxDist) {
+  REAL8 sum = 0.0;
+
+  if (tree == NULL || pt == NULL) XLAL_ERROR_REAL8(XLAL_EFAULT);
+
+  kdGaussianKernelSum(tree, pt, maxDist*maxDist, &sum);
+
+  return log(sum);
+}
+
 UINT4 LALInferenceCheckPositiveDefinite(
                           gsl_matrix       *matrix,
                           UINT4            dim
@@ -472,6 +472,7 @@ typedef struct tagLALInferenceModel
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
+  LALSimNeutronStarFamilyCache *eos_cache; /** Cache of neutron star families of sampled equation of state parameters */
 
 } LALInferenceModel;
 
@@ -886,15 +887,30 @@ void LALInferenceQ2Eta(double q, double *eta);
 /** Convert from lambdaT, dLambdaT, and eta to lambda1 and lambda2. */
 void LALInferenceLambdaTsEta2Lambdas(REAL8 lambdaT, REAL8 dLambdaT, REAL8 eta, REAL8 *lambda1, REAL8 *lambda2);
 
+/** Number of equations of state whose neutron star families are cached by each model */
+#define LALINFERENCE_EOS_CACHE_SIZE 8
+
+/** Relative tolerance of the adaptive neutron star families made from EOS parameters */
+#define LALINFERENCE_EOS_FAMILY_TOLERANCE 1e-2
+
 /** Calculate lambda1,2(m1,2|eos(logp1,gamma1,gamma2,gamma3)) */
 void LALInferenceLogp1GammasMasses2Lambdas(REAL8 logp1, REAL8 gamma1, REAL8 gamma2, REAL8 gamma3, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2);
 
+/** Calculate lambda1,2(m1,2|eos(logp1,gamma1,gamma2,gamma3)), reusing the neutron star family in cache (if not NULL) */
+void LALInferenceLogp1GammasMasses2LambdasCached(LALSimNeutronStarFamilyCache *cache, REAL8 logp1, REAL8 gamma1, REAL8 gamma2, REAL8 gamma3, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2);
+
 /** Convert from spectral parameters to lambda1, lambda2 */
 void LALInferenceSDGammasMasses2Lambdas(REAL8 gamma[], REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2, int size);
 
+/** Convert from spectral parameters to lambda1, lambda2, reusing the neutron star family in cache (if not NULL) */
+void LALInferenceSDGammasMasses2LambdasCached(LALSimNeutronStarFamilyCache *cache, REAL8 gamma[], REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2, int size);
+
 /** Check for causality violation and mass conflict given masses and eos */
 int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine);
 
+/** Check for causality violation and mass conflict given masses and eos, reusing the neutron star family in cache (if not NULL) */
+int LALInferenceEOSPhysicalCheckCached(LALInferenceVariables *params, ProcessParamsTable *commandLine, LALSimNeutronStarFamilyCache *cache);
+
 /** Specral decomposition of eos's adiabatic index */
 double AdiabaticIndex(double gamma[],double x, int size);
 
@@ -1021,6 +1037,16 @@ void LALInferenceKDDrawEigenFrame(gsl_rng * rng, LALInferenceKDTree *tree, REAL8
 REAL8 LALInferenceKDLogProposalRatio(LALInferenceKDTree *tree, REAL8 *current,
                                      REAL8 *proposed, size_t Npts);
 
+/**
+ * Returns the log of the sum of the unit Gaussian kernels
+ * \f$\exp(-|x - \mathrm{pt}|^2/2)\f$ centred on the points \f$x\f$ of \c
+ * tree that lie within a distance \c maxDist of \c pt.  Cells whose
+ * bounds are further than \c maxDist from \c pt are not visited, so the
+ * cost grows with the number of nearby points rather than with the size
+ * of the tree.
+ */
+REAL8 LALInferenceKDLogGaussianKernelSum(LALInferenceKDTree *tree, REAL8 *pt, REAL8 maxDist);
+
 /** Check matrix is positive definite. dim is matrix dimensions */
 UINT4 LALInferenceCheckPositiveDefinite(
                           gsl_matrix       *matrix,
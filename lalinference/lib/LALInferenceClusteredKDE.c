@@ -486,7 +486,8 @@ void LALInferenceKmeansRun(LALInferenceKmeans *kmeans) {
  *
  * The kmeans is run \a ntrials times, each time with a new random
  *  initialization.  The one that results in the highest Bayes Information
- *  Criteria (BIC) is returned.
+ *  Criteria (BIC) is returned.  The trials are run concurrently when OpenMP is
+ *  enabled, each with its own generator seeded from \a rng.
  * @param[in]  k       The number of clusters to use.
  * @param[in]  samples The (unwhitened) data to cluster.
  * @param[in]  ntrials The number of random initialization to run.
@@ -498,7 +499,7 @@ LALInferenceKmeans *LALInferenceKmeansRunBestOf(INT4 k,
                                                 gsl_matrix *samples,
                                                 INT4 ntrials,
                                                 gsl_rng *rng) {
-    INT4 i;
+    INT4 i, j;
 
     LALInferenceKmeans *best_kmeans = NULL;
     REAL8 best_bic = -INFINITY;
@@ -507,42 +508,73 @@ LALInferenceKmeans *LALInferenceKmeansRunBestOf(INT4 k,
     if (k == 1)
         ntrials = 1;
 
-    #pragma omp parallel
-    {
-        LALInferenceKmeans *kmeans;
-        REAL8 bic = 0;
-        REAL8 error = -INFINITY;
-
-        #pragma omp for
-        for (i = 0; i < ntrials; i++) {
-            kmeans = LALInferenceCreateKmeans(k, samples, rng);
-            if (!kmeans)
-                continue;
-
-            LALInferenceKmeansSeededInitialize(kmeans);
-            LALInferenceKmeansRun(kmeans);
-
-            /* Assume BIC hasn't changed if
-             * error (summed-dist^2 from assigned centroids) hasn't */
-            if (error != kmeans->error) {
-                error = kmeans->error;
-                bic = LALInferenceKmeansBIC(kmeans);
-            }
+    /* Give each trial its own generator, seeded in turn from rng, so the
+     *  trials can run concurrently and the result doesn't depend on the
+     *  number of threads */
+    LALInferenceKmeans **trials = XLALCalloc(ntrials, sizeof(LALInferenceKmeans*));
+    gsl_rng **trial_rngs = XLALCalloc(ntrials, sizeof(gsl_rng*));
+    REAL8 *bics = XLALCalloc(ntrials, sizeof(REAL8));
+    INT4 *same_as = XLALCalloc(ntrials, sizeof(INT4));
+    for (i = 0; i < ntrials; i++) {
+        trial_rngs[i] = gsl_rng_alloc(gsl_rng_mt19937);
+        gsl_rng_set(trial_rngs[i], gsl_rng_get(rng));
+    }
 
-            #pragma omp critical
-            {
-                if (bic > best_bic) {
-                    if (best_kmeans)
-                        LALInferenceKmeansDestroy(best_kmeans);
-                    best_bic = bic;
-                    best_kmeans = kmeans;
-                } else {
-                    LALInferenceKmeansDestroy(kmeans);
-                }
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (i = 0; i < ntrials; i++) {
+        trials[i] = LALInferenceCreateKmeans(k, samples, trial_rngs[i]);
+        if (!trials[i])
+            continue;
+
+        LALInferenceKmeansSeededInitialize(trials[i]);
+        LALInferenceKmeansRun(trials[i]);
+    }
+
+    /* Assume BIC hasn't changed if error (summed-dist^2 from assigned
+     *  centroids) is the same as that of an earlier trial */
+    for (i = 0; i < ntrials; i++) {
+        same_as[i] = i;
+        if (!trials[i])
+            continue;
+        for (j = 0; j < i; j++) {
+            if (trials[j] && trials[j]->error == trials[i]->error) {
+                same_as[i] = j;
+                break;
             }
         }
     }
 
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (i = 0; i < ntrials; i++) {
+        if (trials[i] && same_as[i] == i)
+            bics[i] = LALInferenceKmeansBIC(trials[i]);
+    }
+
+    for (i = 0; i < ntrials; i++) {
+        if (!trials[i])
+            continue;
+
+        if (bics[same_as[i]] > best_bic) {
+            if (best_kmeans)
+                LALInferenceKmeansDestroy(best_kmeans);
+            best_bic = bics[same_as[i]];
+            best_kmeans = trials[i];
+        } else {
+            LALInferenceKmeansDestroy(trials[i]);
+        }
+    }
+
+    /* Hand the caller's generator to the result for later draws */
+    if (best_kmeans)
+        best_kmeans->rng = rng;
+
+    for (i = 0; i < ntrials; i++)
+        gsl_rng_free(trial_rngs[i]);
+    XLALFree(trial_rngs);
+    XLALFree(trials);
+    XLALFree(bics);
+    XLALFree(same_as);
+
     return best_kmeans;
 }
 
@@ -1097,6 +1129,25 @@ REAL8 LALInferenceKmeansPDF(LALInferenceKmeans *kmeans, REAL8 *pt) {
 }
 
 
+/**
+ * Truncate the kernels of the KDEs of a clustered-KDE.
+ *
+ * Builds the cluster KDEs if necessary, and truncates them as described in
+ *  LALInferenceSetKDETruncation().
+ * @param kmeans     The kmeans clustering to truncate the KDEs of.
+ * @param truncation Truncation radius in bandwidths, zero for no truncation.
+ */
+void LALInferenceKmeansSetKDETruncation(LALInferenceKmeans *kmeans, REAL8 truncation) {
+    INT4 j;
+
+    if (kmeans->KDEs == NULL)
+        LALInferenceKmeansBuildKDE(kmeans);
+
+    for (j = 0; j < kmeans->k; j++)
+        LALInferenceSetKDETruncation(kmeans->KDEs[j], truncation);
+}
+
+
 /**
  * Estimate (log) PDF from a clustered-KDE at an already whitened point.
  *
@@ -124,6 +124,9 @@ REAL8 *LALInferenceKmeansDraw(LALInferenceKmeans *kmeans);
 /* Evaluate the estimated (log) PDF from a clustered-KDE at a point. */
 REAL8 LALInferenceKmeansPDF(LALInferenceKmeans *kmeans, REAL8 *pt);
 
+/* Truncate the kernels of the KDEs of a clustered-KDE. */
+void LALInferenceKmeansSetKDETruncation(LALInferenceKmeans *kmeans, REAL8 truncation);
+
 /* Evaluate the estimated (log) PDF from a clustered-KDE at an already whitened point. */
 REAL8 LALInferenceWhitenedKmeansPDF(LALInferenceKmeans *kmeans, REAL8 *pt);
 
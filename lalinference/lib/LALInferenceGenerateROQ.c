@@ -19,13 +19,23 @@
  *  MA  02111-1307  USA
  */
 
+#include <stdio.h>
+#include <string.h>
+
 #include <lal/LALInferenceGenerateROQ.h>
+#include <lal/LALString.h>
 #include <lal/XLALGSL.h>
 
 #ifndef _OPENMP
 #define omp ignore
 #endif
 
+/* number of training set waveforms projected together in the greedy basis generation */
+#define ROQ_BLOCK_ROWS 256
+
+/* identifier at the start of reduced basis generation checkpoint files */
+static const CHAR ROQ_CHECKPOINT_MAGIC[8] = { 'L', 'A', 'L', 'R', 'O', 'Q', 'C', 'K' };
+
 
 /* internal function definitions */
 
@@ -88,6 +98,19 @@ COMPLEX16Array *complex_B_matrix(gsl_matrix_complex *V, gsl_matrix_complex *RB);
 /* find the index of the absolute maximum value for a complex vector */
 int complex_vector_maxabs_index( gsl_vector_complex *c );
 
+/* blocked projections of the training set onto the reduced basis */
+static void weighted_basis(const gsl_vector *weight, const gsl_vector *a, gsl_vector *wa);
+static void complex_weighted_basis(const gsl_vector *weight, const gsl_vector_complex *a, gsl_vector_complex *wa);
+static void update_projection_norms(const gsl_matrix *TS, const gsl_vector *wbasis, const REAL8 *A_row_norms2, REAL8 *projection_norms2, REAL8 *errors);
+static void complex_update_projection_norms(const gsl_matrix_complex *TS, const gsl_vector_complex *wbasis, const REAL8 *A_row_norms2, REAL8 *projection_norms2, REAL8 *errors);
+static int initialise_projection_norms(const gsl_vector *weight, const gsl_matrix *TS, const gsl_matrix *RB, size_t nbases, REAL8 *projection_norms2);
+static int complex_initialise_projection_norms(const gsl_vector *weight, const gsl_matrix_complex *TS, const gsl_matrix_complex *RB, size_t nbases, REAL8 *projection_norms2);
+
+/* checkpointing of the reduced basis generation */
+static UINT8 basis_checkpoint_checksum(const void *data, size_t nbytes);
+static int write_basis_checkpoint(const CHAR *filename, UINT4 elemsize, UINT4 rows, UINT4 cols, UINT8 checksum, const REAL8Vector *delta, REAL8 tolerance, UINT4 dim_RB, const UINT4 *gpts, const void *RBdata);
+static int read_basis_checkpoint(const CHAR *filename, UINT4 elemsize, UINT4 rows, UINT4 cols, UINT8 checksum, const REAL8Vector *delta, REAL8 tolerance, UINT4 *dim_RB, UINT4 *gpts, void **RBdata);
+
 
 /** \brief Function to project the training set onto a given basis vector
  *
@@ -726,6 +749,425 @@ void iterated_modified_gm(gsl_vector *ru,
   gsl_vector_free(r_last);
 }
 
+/** \brief Form the weighted copy of a real basis vector used for projections
+ *
+ * @param[in] weight The weighting(s) in the inner product (e.g. time or frequency step(s) between points)
+ * @param[in] a The basis vector
+ * @param[out] wa The vector \c a multiplied by the weight(s)
+ */
+static void weighted_basis(const gsl_vector *weight, const gsl_vector *a, gsl_vector *wa){
+  gsl_vector_memcpy(wa, a);
+  if ( weight->size == 1 ){ gsl_vector_scale(wa, gsl_vector_get(weight, 0)); }
+  else { gsl_vector_mul(wa, weight); }
+}
+
+
+/** \brief Form the weighted complex conjugate of a complex basis vector used for projections
+ *
+ * @param[in] weight The weighting(s) in the inner product (e.g. time or frequency step(s) between points)
+ * @param[in] a The complex basis vector
+ * @param[out] wa The complex conjugate of \c a multiplied by the weight(s)
+ */
+static void complex_weighted_basis(const gsl_vector *weight, const gsl_vector_complex *a, gsl_vector_complex *wa){
+  gsl_vector_view rview, iview;
+
+  gsl_vector_complex_memcpy(wa, a);
+  rview = gsl_vector_complex_real(wa);
+  iview = gsl_vector_complex_imag(wa);
+  gsl_vector_scale(&iview.vector, -1.0);
+  if ( weight->size == 1 ){ gsl_blas_zdscal(gsl_vector_get(weight, 0), wa); }
+  else {
+    gsl_vector_mul(&rview.vector, weight);
+    gsl_vector_mul(&iview.vector, weight);
+  }
+}
+
+
+/** \brief Add the projections of the training set onto a new basis vector to the projection norms
+ *
+ * The training set is processed in blocks of \c ROQ_BLOCK_ROWS waveforms, each of which is
+ * projected with a single matrix-vector product. Blocks are shared between OpenMP threads.
+ *
+ * @param[in] TS The (normalised) training set
+ * @param[in] wbasis The weighted new basis vector (see \c weighted_basis)
+ * @param[in] A_row_norms2 The squared norms of the training set waveforms
+ * @param[in,out] projection_norms2 The squared norms of the projections of the training set onto the basis
+ * @param[out] errors The projection errors of the training set waveforms
+ */
+static void update_projection_norms(const gsl_matrix *TS,
+                                    const gsl_vector *wbasis,
+                                    const REAL8 *A_row_norms2,
+                                    REAL8 *projection_norms2,
+                                    REAL8 *errors){
+  const size_t rows = TS->size1;
+  const size_t nblocks = (rows + ROQ_BLOCK_ROWS - 1) / ROQ_BLOCK_ROWS;
+
+#pragma omp parallel for schedule(static)
+  for ( size_t b = 0; b < nblocks; b++ ){
+    const size_t i0 = b * ROQ_BLOCK_ROWS;
+    const size_t n = ( rows - i0 < ROQ_BLOCK_ROWS ) ? rows - i0 : ROQ_BLOCK_ROWS;
+    REAL8 coeffs[ROQ_BLOCK_ROWS];
+    gsl_matrix_const_view block = gsl_matrix_const_submatrix(TS, i0, 0, n, TS->size2);
+    gsl_vector_view cview = gsl_vector_view_array(coeffs, n);
+
+    gsl_blas_dgemv(CblasNoTrans, 1.0, &block.matrix, wbasis, 0.0, &cview.vector);
+
+    for ( size_t i = 0; i < n; i++ ){
+      projection_norms2[i0 + i] += coeffs[i] * coeffs[i];
+      errors[i0 + i] = A_row_norms2[i0 + i] - projection_norms2[i0 + i];
+    }
+  }
+}
+
+
+/** \brief Add the projections of the complex training set onto a new basis vector to the projection norms
+ *
+ * The complex equivalent of \c update_projection_norms.
+ *
+ * @param[in] TS The (normalised) complex training set
+ * @param[in] wbasis The weighted conjugate new basis vector (see \c complex_weighted_basis)
+ * @param[in] A_row_norms2 The squared norms of the training set waveforms
+ * @param[in,out] projection_norms2 The squared norms of the projections of the training set onto the basis
+ * @param[out] errors The projection errors of the training set waveforms
+ */
+static void complex_update_projection_norms(const gsl_matrix_complex *TS,
+                                            const gsl_vector_complex *wbasis,
+                                            const REAL8 *A_row_norms2,
+                                            REAL8 *projection_norms2,
+                                            REAL8 *errors){
+  const size_t rows = TS->size1;
+  const size_t nblocks = (rows + ROQ_BLOCK_ROWS - 1) / ROQ_BLOCK_ROWS;
+
+#pragma omp parallel for schedule(static)
+  for ( size_t b = 0; b < nblocks; b++ ){
+    const size_t i0 = b * ROQ_BLOCK_ROWS;
+    const size_t n = ( rows - i0 < ROQ_BLOCK_ROWS ) ? rows - i0 : ROQ_BLOCK_ROWS;
+    REAL8 coeffs[2*ROQ_BLOCK_ROWS];
+    gsl_matrix_complex_const_view block = gsl_matrix_complex_const_submatrix(TS, i0, 0, n, TS->size2);
+    gsl_vector_complex_view cview = gsl_vector_complex_view_array(coeffs, n);
+
+    gsl_blas_zgemv(CblasNoTrans, GSL_COMPLEX_ONE, &block.matrix, wbasis, GSL_COMPLEX_ZERO, &cview.vector);
+
+    for ( size_t i = 0; i < n; i++ ){
+      projection_norms2[i0 + i] += coeffs[2*i] * coeffs[2*i] + coeffs[2*i+1] * coeffs[2*i+1];
+      errors[i0 + i] = A_row_norms2[i0 + i] - projection_norms2[i0 + i];
+    }
+  }
+}
+
+
+/** \brief Calculate the projection norms of the training set onto the first \c nbases basis vectors
+ *
+ * This is used when resuming from a checkpoint, and projects each block of \c ROQ_BLOCK_ROWS
+ * training set waveforms onto all the basis vectors with a single matrix-matrix product.
+ *
+ * @param[in] weight The weighting(s) in the inner product
+ * @param[in] TS The (normalised) training set
+ * @param[in] RB The reduced basis
+ * @param[in] nbases The number of basis vectors (rows of \c RB) to project onto
+ * @param[out] projection_norms2 The squared norms of the projections of the training set onto the basis
+ *
+ * @return \c XLAL_SUCCESS, or an XLAL error code
+ */
+static int initialise_projection_norms(const gsl_vector *weight,
+                                       const gsl_matrix *TS,
+                                       const gsl_matrix *RB,
+                                       size_t nbases,
+                                       REAL8 *projection_norms2){
+  const size_t rows = TS->size1, cols = TS->size2;
+  const size_t nblocks = (rows + ROQ_BLOCK_ROWS - 1) / ROQ_BLOCK_ROWS;
+  const size_t blockrows = ( rows < ROQ_BLOCK_ROWS ) ? rows : ROQ_BLOCK_ROWS;
+
+  for ( size_t i = 0; i < rows; i++ ){ projection_norms2[i] = 0.; }
+  if ( nbases == 0 ){ return XLAL_SUCCESS; }
+
+  /* weighted copy of the basis */
+  gsl_matrix *WRB = gsl_matrix_alloc(nbases, cols);
+  XLAL_CHECK( WRB != NULL, XLAL_ENOMEM );
+  for ( size_t j = 0; j < nbases; j++ ){
+    gsl_vector_const_view rbrow = gsl_matrix_const_row(RB, j);
+    gsl_vector_view wrow = gsl_matrix_row(WRB, j);
+    weighted_basis(weight, &rbrow.vector, &wrow.vector);
+  }
+
+  /* each thread projects its blocks into its own matrix of coefficients */
+  int failed = 0;
+#pragma omp parallel
+  {
+    gsl_matrix *coeffs = gsl_matrix_alloc(blockrows, nbases);
+    if ( coeffs == NULL ){
+#pragma omp critical (ROQ_projection_norms_error)
+      failed = 1;
+    }
+
+#pragma omp for schedule(static)
+    for ( size_t b = 0; b < nblocks; b++ ){
+      if ( coeffs == NULL ){ continue; }
+      const size_t i0 = b * ROQ_BLOCK_ROWS;
+      const size_t n = ( rows - i0 < ROQ_BLOCK_ROWS ) ? rows - i0 : ROQ_BLOCK_ROWS;
+      gsl_matrix_const_view block = gsl_matrix_const_submatrix(TS, i0, 0, n, cols);
+      gsl_matrix_view cblock = gsl_matrix_submatrix(coeffs, 0, 0, n, nbases);
+
+      gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, &block.matrix, WRB, 0.0, &cblock.matrix);
+
+      for ( size_t i = 0; i < n; i++ ){
+        gsl_vector_view crow = gsl_matrix_row(&cblock.matrix, i);
+        REAL8 nrm = gsl_blas_dnrm2(&crow.vector);
+        projection_norms2[i0 + i] = nrm * nrm;
+      }
+    }
+
+    gsl_matrix_free(coeffs);
+  }
+
+  gsl_matrix_free(WRB);
+  XLAL_CHECK( !failed, XLAL_ENOMEM );
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Calculate the projection norms of the complex training set onto the first \c nbases basis vectors
+ *
+ * The complex equivalent of \c initialise_projection_norms.
+ *
+ * @param[in] weight The weighting(s) in the inner product
+ * @param[in] TS The (normalised) complex training set
+ * @param[in] RB The complex reduced basis
+ * @param[in] nbases The number of basis vectors (rows of \c RB) to project onto
+ * @param[out] projection_norms2 The squared norms of the projections of the training set onto the basis
+ *
+ * @return \c XLAL_SUCCESS, or an XLAL error code
+ */
+static int complex_initialise_projection_norms(const gsl_vector *weight,
+                                               const gsl_matrix_complex *TS,
+                                               const gsl_matrix_complex *RB,
+                                               size_t nbases,
+                                               REAL8 *projection_norms2){
+  const size_t rows = TS->size1, cols = TS->size2;
+  const size_t nblocks = (rows + ROQ_BLOCK_ROWS - 1) / ROQ_BLOCK_ROWS;
+  const size_t blockrows = ( rows < ROQ_BLOCK_ROWS ) ? rows : ROQ_BLOCK_ROWS;
+
+  for ( size_t i = 0; i < rows; i++ ){ projection_norms2[i] = 0.; }
+  if ( nbases == 0 ){ return XLAL_SUCCESS; }
+
+  /* weighted conjugate copy of the basis */
+  gsl_matrix_complex *WRB = gsl_matrix_complex_alloc(nbases, cols);
+  XLAL_CHECK( WRB != NULL, XLAL_ENOMEM );
+  for ( size_t j = 0; j < nbases; j++ ){
+    gsl_vector_complex_const_view rbrow = gsl_matrix_complex_const_row(RB, j);
+    gsl_vector_complex_view wrow = gsl_matrix_complex_row(WRB, j);
+    complex_weighted_basis(weight, &rbrow.vector, &wrow.vector);
+  }
+
+  /* each thread projects its blocks into its own matrix of coefficients */
+  int failed = 0;
+#pragma omp parallel
+  {
+    gsl_matrix_complex *coeffs = gsl_matrix_complex_alloc(blockrows, nbases);
+    if ( coeffs == NULL ){
+#pragma omp critical (ROQ_projection_norms_error)
+      failed = 1;
+    }
+
+#pragma omp for schedule(static)
+    for ( size_t b = 0; b < nblocks; b++ ){
+      if ( coeffs == NULL ){ continue; }
+      const size_t i0 = b * ROQ_BLOCK_ROWS;
+      const size_t n = ( rows - i0 < ROQ_BLOCK_ROWS ) ? rows - i0 : ROQ_BLOCK_ROWS;
+      gsl_matrix_complex_const_view block = gsl_matrix_complex_const_submatrix(TS, i0, 0, n, cols);
+      gsl_matrix_complex_view cblock = gsl_matrix_complex_submatrix(coeffs, 0, 0, n, nbases);
+
+      gsl_blas_zgemm(CblasNoTrans, CblasTrans, GSL_COMPLEX_ONE, &block.matrix, WRB, GSL_COMPLEX_ZERO, &cblock.matrix);
+
+      for ( size_t i = 0; i < n; i++ ){
+        gsl_vector_complex_view crow = gsl_matrix_complex_row(&cblock.matrix, i);
+        REAL8 nrm = gsl_blas_dznrm2(&crow.vector);
+        projection_norms2[i0 + i] = nrm * nrm;
+      }
+    }
+
+    gsl_matrix_complex_free(coeffs);
+  }
+
+  gsl_matrix_complex_free(WRB);
+  XLAL_CHECK( !failed, XLAL_ENOMEM );
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Checksum of the normalised training set, used to identify it in checkpoint files
+ *
+ * This is the 64-bit FNV-1a hash, taken over 8-byte words rather than bytes as the training
+ * sets can be very large.
+ *
+ * @param[in] data The training set data
+ * @param[in] nbytes The size of the training set data in bytes (a multiple of 8)
+ *
+ * @return The checksum
+ */
+static UINT8 basis_checkpoint_checksum(const void *data, size_t nbytes){
+  const unsigned char *bytes = (const unsigned char *)data;
+  UINT8 hash = 14695981039346656037ULL;
+
+  for ( size_t i = 0; i + sizeof(UINT8) <= nbytes; i += sizeof(UINT8) ){
+    UINT8 word;
+    memcpy(&word, bytes + i, sizeof(UINT8));
+    hash ^= word;
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+
+/** \brief Write a reduced basis generation checkpoint file
+ *
+ * The checkpoint is first written to a temporary file, which is then renamed, so that an
+ * interrupted write never destroys the previous checkpoint. Along with the basis, the file
+ * records the training set dimensions and checksum, the time/frequency steps and the
+ * tolerance, so that it is only ever used to resume the same basis generation.
+ *
+ * @param[in] filename The checkpoint file name
+ * @param[in] elemsize The size of a basis element (i.e. \c sizeof(REAL8) or \c sizeof(COMPLEX16))
+ * @param[in] rows The number of waveforms in the training set
+ * @param[in] cols The length of the training set waveforms
+ * @param[in] checksum The checksum of the normalised training set
+ * @param[in] delta The time/frequency step(s) used to normalise the training set
+ * @param[in] tolerance The basis generation tolerance
+ * @param[in] dim_RB The number of basis vectors
+ * @param[in] gpts The greedy points (training set rows) used to form the basis
+ * @param[in] RBdata The \c dim_RB by \c cols reduced basis
+ *
+ * @return \c XLAL_SUCCESS, or an XLAL error code
+ */
+static int write_basis_checkpoint(const CHAR *filename,
+                                  UINT4 elemsize,
+                                  UINT4 rows,
+                                  UINT4 cols,
+                                  UINT8 checksum,
+                                  const REAL8Vector *delta,
+                                  REAL8 tolerance,
+                                  UINT4 dim_RB,
+                                  const UINT4 *gpts,
+                                  const void *RBdata){
+  CHAR *tmpfile = XLALStringAppend(XLALStringDuplicate(filename), ".tmp");
+  XLAL_CHECK( tmpfile != NULL, XLAL_EFUNC );
+
+  FILE *fp = fopen(tmpfile, "wb");
+  if ( fp == NULL ){
+    XLALFree(tmpfile);
+    XLAL_ERROR( XLAL_EIO, "Could not open checkpoint file '%s.tmp' for writing", filename );
+  }
+
+  const UINT4 header[4] = { elemsize, rows, cols, dim_RB };
+  int ok = ( fwrite(ROQ_CHECKPOINT_MAGIC, 1, sizeof(ROQ_CHECKPOINT_MAGIC), fp) == sizeof(ROQ_CHECKPOINT_MAGIC) );
+  ok = ok && ( fwrite(header, sizeof(UINT4), 4, fp) == 4 );
+  ok = ok && ( fwrite(&checksum, sizeof(UINT8), 1, fp) == 1 );
+  ok = ok && ( fwrite(&tolerance, sizeof(REAL8), 1, fp) == 1 );
+  ok = ok && ( fwrite(&delta->length, sizeof(UINT4), 1, fp) == 1 );
+  ok = ok && ( fwrite(delta->data, sizeof(REAL8), delta->length, fp) == delta->length );
+  ok = ok && ( fwrite(gpts, sizeof(UINT4), dim_RB, fp) == dim_RB );
+  ok = ok && ( fwrite(RBdata, (size_t)elemsize * cols, dim_RB, fp) == dim_RB );
+  ok = ( fclose(fp) == 0 ) && ok;
+  ok = ok && ( rename(tmpfile, filename) == 0 );
+  XLALFree(tmpfile);
+  XLAL_CHECK( ok, XLAL_EIO, "Could not write checkpoint file '%s'", filename );
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Read a reduced basis generation checkpoint file
+ *
+ * @param[in] filename The checkpoint file name
+ * @param[in] elemsize The size of a basis element (i.e. \c sizeof(REAL8) or \c sizeof(COMPLEX16))
+ * @param[in] rows The number of waveforms in the training set
+ * @param[in] cols The length of the training set waveforms
+ * @param[in] checksum The checksum of the normalised training set
+ * @param[in] delta The time/frequency step(s) used to normalise the training set
+ * @param[in] tolerance The basis generation tolerance
+ * @param[out] dim_RB The number of basis vectors in the checkpoint (zero if there is no checkpoint file)
+ * @param[out] gpts The greedy points used to form the basis (must have room for \c rows values)
+ * @param[out] RBdata A newly allocated \c dim_RB by \c cols reduced basis
+ *
+ * @return \c XLAL_SUCCESS, or an XLAL error code if the file was not made from the same training
+ * set, time/frequency steps and tolerance
+ */
+static int read_basis_checkpoint(const CHAR *filename,
+                                 UINT4 elemsize,
+                                 UINT4 rows,
+                                 UINT4 cols,
+                                 UINT8 checksum,
+                                 const REAL8Vector *delta,
+                                 REAL8 tolerance,
+                                 UINT4 *dim_RB,
+                                 UINT4 *gpts,
+                                 void **RBdata){
+  *dim_RB = 0;
+  *RBdata = NULL;
+
+  FILE *fp = fopen(filename, "rb");
+  if ( fp == NULL ){ return XLAL_SUCCESS; } /* nothing to resume from */
+
+  CHAR magic[sizeof(ROQ_CHECKPOINT_MAGIC)];
+  UINT4 header[4];
+  if ( fread(magic, 1, sizeof(magic), fp) != sizeof(magic) || memcmp(magic, ROQ_CHECKPOINT_MAGIC, sizeof(magic)) != 0
+       || fread(header, sizeof(UINT4), 4, fp) != 4 ){
+    fclose(fp);
+    XLAL_ERROR( XLAL_EIO, "'%s' is not a reduced basis checkpoint file", filename );
+  }
+  if ( header[0] != elemsize || header[1] != rows || header[2] != cols || header[3] == 0 || header[3] > rows ){
+    fclose(fp);
+    XLAL_ERROR( XLAL_EINVAL, "Checkpoint file '%s' does not match the training set", filename );
+  }
+
+  UINT8 ckpt_checksum = 0;
+  REAL8 ckpt_tolerance = 0.;
+  UINT4 ckpt_ndelta = 0;
+  if ( fread(&ckpt_checksum, sizeof(UINT8), 1, fp) != 1 || fread(&ckpt_tolerance, sizeof(REAL8), 1, fp) != 1
+       || fread(&ckpt_ndelta, sizeof(UINT4), 1, fp) != 1 ){
+    fclose(fp);
+    XLAL_ERROR( XLAL_EIO, "Could not read checkpoint file '%s'", filename );
+  }
+  if ( ckpt_checksum != checksum ){
+    fclose(fp);
+    XLAL_ERROR( XLAL_EINVAL, "Checkpoint file '%s' was made from a different training set", filename );
+  }
+  if ( ckpt_tolerance != tolerance ){
+    fclose(fp);
+    XLAL_ERROR( XLAL_EINVAL, "Checkpoint file '%s' was made with tolerance %g, not %g", filename, ckpt_tolerance, tolerance );
+  }
+  int deltaok = ( ckpt_ndelta == delta->length );
+  for ( UINT4 i = 0; deltaok && i < ckpt_ndelta; i++ ){
+    REAL8 ckpt_delta;
+    deltaok = ( fread(&ckpt_delta, sizeof(REAL8), 1, fp) == 1 && ckpt_delta == delta->data[i] );
+  }
+  if ( !deltaok ){
+    fclose(fp);
+    XLAL_ERROR( XLAL_EINVAL, "Checkpoint file '%s' was made with different time/frequency steps", filename );
+  }
+
+  void *data = XLALMalloc((size_t)header[3] * cols * elemsize);
+  if ( data == NULL ){
+    fclose(fp);
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  if ( fread(gpts, sizeof(UINT4), header[3], fp) != header[3] || fread(data, (size_t)elemsize * cols, header[3], fp) != header[3] ){
+    fclose(fp);
+    XLALFree(data);
+    XLAL_ERROR( XLAL_EIO, "Could not read checkpoint file '%s'", filename );
+  }
+  fclose(fp);
+
+  *dim_RB = header[3];
+  *RBdata = data;
+
+  return XLAL_SUCCESS;
+}
+
+
 /* main functions */
 
 /**
@@ -764,6 +1206,39 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
                                                 REAL8 tolerance,
                                                 REAL8Array **TS,
                                                 UINT4Vector **greedypoints){
+  return LALInferenceGenerateREAL8OrthonormalBasisCheckpoint(RBin, delta, tolerance, TS, greedypoints, NULL, 0);
+}
+
+
+/**
+ * \brief Create a orthonormal basis set from a training set of real waveforms, with checkpointing
+ *
+ * This is \c LALInferenceGenerateREAL8OrthonormalBasis, but every \c checkpointinterval new bases
+ * the current reduced basis and greedy points are written to the file \c checkpoint. If that file
+ * already exists when the function is called (with the same training set) the basis generation
+ * resumes from the stored basis rather than starting again.
+ *
+ * @param[out] RBin A \c REAL8Array to return the reduced basis.
+ * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
+ * This can be a vector containing just one value.
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
+ * @param[in] TS A \c REAL8Array matrix containing the training set (see
+ * \c LALInferenceGenerateREAL8OrthonormalBasis). This will be normalised by this function.
+ * @param[out] greedypoints A \c UINT4Vector to return the indices of the training set rows that
+ * have been used to form the reduced basis.
+ * @param[in] checkpoint The checkpoint file name, or \c NULL for no checkpointing.
+ * @param[in] checkpointinterval The number of new bases between checkpoints (0 to only resume
+ * from an existing checkpoint).
+ *
+ * @return A \c REAL8 with the maximum projection error for the final reduced basis.
+ */
+REAL8 LALInferenceGenerateREAL8OrthonormalBasisCheckpoint(REAL8Array **RBin,
+                                                          const REAL8Vector *delta,
+                                                          REAL8 tolerance,
+                                                          REAL8Array **TS,
+                                                          UINT4Vector **greedypoints,
+                                                          const CHAR *checkpoint,
+                                                          UINT4 checkpointinterval){
   REAL8Array *ts = NULL;
   ts = *TS; // pointer to training set
 
@@ -778,17 +1253,21 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
   //REAL8 greedy_err[max_RB];           /* approximate error */
   UINT4Vector *gpts = NULL;
   gpts = XLALCreateUINT4Vector(max_RB); /* selected greedy points (row selection) */
+  XLAL_CHECK_REAL8( gpts != NULL, XLAL_EFUNC );
   *greedypoints = gpts;
 
-  REAL8 worst_err;          /* errors in greedy sweep */
+  int status = XLAL_SUCCESS;
+  const char *fmt = "";
+
+  REAL8 worst_err = 0.;     /* errors in greedy sweep */
   UINT4 worst_app = 0;      /* worst error stored */
   REAL8 tmpc;               /* worst error temp */
 
-  gsl_vector *ts_el, *last_rb, *ortho_basis, *ru;
-  gsl_matrix *R_matrix;
-  REAL8 A_row_norms2[rows];              // || A(i,:) ||^2
-  REAL8 projection_norms2[rows];
-  REAL8 errors[rows];                    // approximation errors at i^{th} sweep
+  gsl_vector *ts_el = NULL, *last_rb = NULL, *wlast_rb = NULL, *ortho_basis = NULL, *ru = NULL;
+  gsl_matrix *R_matrix = NULL;
+  REAL8 *A_row_norms2 = NULL;            // || A(i,:) ||^2
+  REAL8 *projection_norms2 = NULL;
+  REAL8 *errors = NULL;                  // approximation errors at i^{th} sweep
 
   REAL8Array *RB = NULL;
   UINT4Vector *dims = NULL;
@@ -797,15 +1276,27 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
   /* this memory should be freed here */
   ts_el         = gsl_vector_alloc(cols);
   last_rb       = gsl_vector_alloc(cols);
+  wlast_rb      = gsl_vector_alloc(cols);
   ortho_basis   = gsl_vector_alloc(cols);
   ru            = gsl_vector_alloc(max_RB);
 
-  //project_coeff = gsl_matrix_alloc(max_RB,rows);
-  REAL8 projection_coeff;
   R_matrix = gsl_matrix_alloc(max_RB, max_RB);
 
-  /* initialise projection norms with zeros */
-  for(size_t i=0; i<rows; ++i){ projection_norms2[i] = 0; }
+  /* training set sized arrays (allocated on the heap, as training sets can be very large) */
+  A_row_norms2      = XLALCalloc(rows, sizeof(REAL8));
+  projection_norms2 = XLALCalloc(rows, sizeof(REAL8));
+  errors            = XLALCalloc(rows, sizeof(REAL8));
+
+  if ( ts_el == NULL || last_rb == NULL || wlast_rb == NULL || ortho_basis == NULL || ru == NULL || R_matrix == NULL ){
+    status = XLAL_ENOMEM;
+    fmt = "could not allocate GSL vectors and matrices";
+    goto cleanup;
+  }
+  if ( A_row_norms2 == NULL || projection_norms2 == NULL || errors == NULL ){
+    status = XLAL_ENOMEM;
+    fmt = "could not allocate training set norms";
+    goto cleanup;
+  }
 
   gsl_vector_view deltaview;
   XLAL_CALLGSL( deltaview = gsl_vector_view_array(delta->data, delta->length) );
@@ -819,11 +1310,27 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
     A_row_norms2[i] = normalisation(&deltaview.vector, ts_el);
   }
 
+  /* checkpoints are identified by a checksum of the normalised training set */
+  UINT8 tschecksum = 0;
+  if ( checkpoint != NULL ){
+    tschecksum = basis_checkpoint_checksum(ts->data, rows * cols * sizeof(REAL8));
+  }
+
   /* initialize algorithm with first training set value */
   dims = XLALCreateUINT4Vector( 2 );
+  if ( dims == NULL ){
+    status = XLAL_EFUNC;
+    fmt = "could not allocate reduced basis dimensions";
+    goto cleanup;
+  }
   dims->data[0] = 1; /* one row */
   dims->data[1] = cols;
   RB = XLALCreateREAL8Array( dims );
+  if ( RB == NULL ){
+    status = XLAL_EFUNC;
+    fmt = "could not allocate reduced basis";
+    goto cleanup;
+  }
   *RBin = RB;
 
   XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, 1, cols) );
@@ -836,17 +1343,44 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
   UINT4 dim_RB          = 1;
   //greedy_err[0]    = 1.0;
 
+  /* resume from a checkpoint, if there is one */
+  if ( checkpoint != NULL ){
+    UINT4 dim_RB_ckpt = 0;
+    void *RBdata = NULL;
+    if ( read_basis_checkpoint(checkpoint, sizeof(REAL8), rows, cols, tschecksum, delta, tolerance, &dim_RB_ckpt, gpts->data, &RBdata) != XLAL_SUCCESS ){
+      status = XLAL_EFUNC;
+      fmt = "could not resume from checkpoint file";
+      goto cleanup;
+    }
+    if ( dim_RB_ckpt > 0 ){
+      dim_RB = dim_RB_ckpt;
+      dims->data[0] = dim_RB;
+      if ( XLALResizeREAL8Array( RB, dims ) == NULL ){
+        XLALFree(RBdata);
+        status = XLAL_EFUNC;
+        fmt = "could not resize reduced basis";
+        goto cleanup;
+      }
+      memcpy(RB->data, RBdata, (size_t)dim_RB * cols * sizeof(REAL8));
+      XLALFree(RBdata);
+      XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, dim_RB, cols) );
+
+      /* project onto all but the last basis, which is projected onto in the first greedy sweep below */
+      if ( initialise_projection_norms(&deltaview.vector, &TSview.matrix, &RBview.matrix, dim_RB-1, projection_norms2) != XLAL_SUCCESS ){
+        status = XLAL_EFUNC;
+        fmt = "could not project the training set onto the checkpointed basis";
+        goto cleanup;
+      }
+    }
+  }
+
   /* loop to find reduced basis */
   while( 1 ){
     gsl_matrix_get_row(last_rb, &RBview.matrix, dim_RB-1); /* previous basis */
 
     /* Compute overlaps of pieces of training set with rb_new */
-    for(size_t i = 0; i < rows; i++){
-      gsl_matrix_get_row(ts_el, &TSview.matrix, i);
-      projection_coeff = weighted_dot_product(&deltaview.vector, last_rb, ts_el);
-      projection_norms2[i] += (projection_coeff*projection_coeff);
-      errors[i] = A_row_norms2[i] - projection_norms2[i];
-    }
+    weighted_basis(&deltaview.vector, last_rb, wlast_rb);
+    update_projection_norms(&TSview.matrix, wlast_rb, A_row_norms2, projection_norms2, errors);
 
     /* find worst represented training set element, and add to basis */
     worst_err = 0.0;
@@ -902,7 +1436,11 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
 
     /* add to reduced basis */
     dims->data[0] = dim_RB+1; /* add row */
-    RB = XLALResizeREAL8Array( RB, dims );
+    if ( XLALResizeREAL8Array( RB, dims ) == NULL ){
+      status = XLAL_EFUNC;
+      fmt = "could not resize reduced basis";
+      goto cleanup;
+    }
 
     /* add on next basis */
     XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, dim_RB+1, cols) );
@@ -914,16 +1452,41 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
 
     /* decide if another greedy sweep is needed */
     if( (dim_RB == max_RB) || (worst_err < tolerance) || (rows == dim_RB) ){ break; }
+
+    /* save progress so that a long basis generation can be resumed */
+    if ( checkpoint != NULL && checkpointinterval > 0 && dim_RB % checkpointinterval == 0 ){
+      if ( write_basis_checkpoint(checkpoint, sizeof(REAL8), rows, cols, tschecksum, delta, tolerance, dim_RB, gpts->data, RB->data) != XLAL_SUCCESS ){
+        status = XLAL_EFUNC;
+        fmt = "could not write checkpoint file";
+        goto cleanup;
+      }
+    }
   }
 
-  gpts = XLALResizeUINT4Vector( gpts, dim_RB );
+  if ( XLALResizeUINT4Vector( gpts, dim_RB ) == NULL ){
+    status = XLAL_EFUNC;
+    fmt = "could not resize greedy points";
+  }
 
+ cleanup:
   XLALDestroyUINT4Vector(dims);
   gsl_vector_free(ts_el);
   gsl_vector_free(last_rb);
+  gsl_vector_free(wlast_rb);
   gsl_vector_free(ortho_basis);
   gsl_vector_free(ru);
   gsl_matrix_free(R_matrix);
+  XLALFree(A_row_norms2);
+  XLALFree(projection_norms2);
+  XLALFree(errors);
+
+  if ( status != XLAL_SUCCESS ){
+    XLALDestroyREAL8Array(RB);
+    XLALDestroyUINT4Vector(gpts);
+    *RBin = NULL;
+    *greedypoints = NULL;
+    XLAL_ERROR_REAL8(status, "%s", fmt);
+  }
 
   return worst_err;
 }
@@ -970,6 +1533,39 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
                                                     REAL8 tolerance,
                                                     COMPLEX16Array **TS,
                                                     UINT4Vector **greedypoints){
+  return LALInferenceGenerateCOMPLEX16OrthonormalBasisCheckpoint(RBin, delta, tolerance, TS, greedypoints, NULL, 0);
+}
+
+
+/**
+ * \brief Create a orthonormal basis set from a training set of complex waveforms, with checkpointing
+ *
+ * This is \c LALInferenceGenerateCOMPLEX16OrthonormalBasis, but every \c checkpointinterval new bases
+ * the current reduced basis and greedy points are written to the file \c checkpoint. If that file
+ * already exists when the function is called (with the same training set) the basis generation
+ * resumes from the stored basis rather than starting again.
+ *
+ * @param[out] RBin A \c COMPLEX16Array to return the reduced basis.
+ * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
+ * This can be a vector containing just one value.
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
+ * @param[in] TS A \c COMPLEX16Array matrix containing the complex training set (see
+ * \c LALInferenceGenerateCOMPLEX16OrthonormalBasis). This will be normalised by this function.
+ * @param[out] greedypoints A \c UINT4Vector to return the indices of the training set rows that
+ * have been used to form the reduced basis.
+ * @param[in] checkpoint The checkpoint file name, or \c NULL for no checkpointing.
+ * @param[in] checkpointinterval The number of new bases between checkpoints (0 to only resume
+ * from an existing checkpoint).
+ *
+ * @return A \c REAL8 with the maximum projection error for the final reduced basis.
+ */
+REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasisCheckpoint(COMPLEX16Array **RBin,
+                                                              const REAL8Vector *delta,
+                                                              REAL8 tolerance,
+                                                              COMPLEX16Array **TS,
+                                                              UINT4Vector **greedypoints,
+                                                              const CHAR *checkpoint,
+                                                              UINT4 checkpointinterval){
   COMPLEX16Array *ts = NULL;
   ts = *TS; // pointer to training set
 
@@ -983,17 +1579,21 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
 
   UINT4Vector *gpts = NULL;
   gpts = XLALCreateUINT4Vector(max_RB); /* selected greedy points (row selection) */
+  XLAL_CHECK_REAL8( gpts != NULL, XLAL_EFUNC );
   *greedypoints = gpts;
 
-  REAL8 worst_err;          /* errors in greedy sweep */
+  int status = XLAL_SUCCESS;
+  const char *fmt = "";
+
+  REAL8 worst_err = 0.;     /* errors in greedy sweep */
   UINT4 worst_app = 0;      /* worst error stored */
   gsl_complex tmpc;         /* worst error temp */
 
-  gsl_vector_complex *ts_el, *last_rb, *ortho_basis, *ru;
-  gsl_matrix_complex *R_matrix;
-  REAL8 A_row_norms2[rows];              // || A(i,:) ||^2
-  REAL8 projection_norms2[rows];
-  REAL8 errors[rows];                    // approximation errors at i^{th} sweep
+  gsl_vector_complex *ts_el = NULL, *last_rb = NULL, *wlast_rb = NULL, *ortho_basis = NULL, *ru = NULL;
+  gsl_matrix_complex *R_matrix = NULL;
+  REAL8 *A_row_norms2 = NULL;            // || A(i,:) ||^2
+  REAL8 *projection_norms2 = NULL;
+  REAL8 *errors = NULL;                  // approximation errors at i^{th} sweep
 
   COMPLEX16Array *RB = NULL;
   UINT4Vector *dims = NULL;
@@ -1002,15 +1602,27 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   /* this memory should be freed here */
   ts_el         = gsl_vector_complex_alloc(cols);
   last_rb       = gsl_vector_complex_alloc(cols);
+  wlast_rb      = gsl_vector_complex_alloc(cols);
   ortho_basis   = gsl_vector_complex_alloc(cols);
   ru            = gsl_vector_complex_alloc(max_RB);
 
-  //project_coeff = gsl_matrix_complex_alloc(max_RB,rows);
-  gsl_complex projection_coeff;
   R_matrix = gsl_matrix_complex_alloc(max_RB, max_RB);
 
-  /* initialise projection norms with zeros */
-  for(size_t i=0; i<rows; ++i){ projection_norms2[i] = 0; }
+  /* training set sized arrays (allocated on the heap, as training sets can be very large) */
+  A_row_norms2      = XLALCalloc(rows, sizeof(REAL8));
+  projection_norms2 = XLALCalloc(rows, sizeof(REAL8));
+  errors            = XLALCalloc(rows, sizeof(REAL8));
+
+  if ( ts_el == NULL || last_rb == NULL || wlast_rb == NULL || ortho_basis == NULL || ru == NULL || R_matrix == NULL ){
+    status = XLAL_ENOMEM;
+    fmt = "could not allocate GSL vectors and matrices";
+    goto cleanup;
+  }
+  if ( A_row_norms2 == NULL || projection_norms2 == NULL || errors == NULL ){
+    status = XLAL_ENOMEM;
+    fmt = "could not allocate training set norms";
+    goto cleanup;
+  }
 
   gsl_vector_view deltaview;
   XLAL_CALLGSL( deltaview = gsl_vector_view_array(delta->data, delta->length) );
@@ -1024,11 +1636,27 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
     A_row_norms2[i] = complex_normalisation(&deltaview.vector, ts_el);
   }
 
+  /* checkpoints are identified by a checksum of the normalised training set */
+  UINT8 tschecksum = 0;
+  if ( checkpoint != NULL ){
+    tschecksum = basis_checkpoint_checksum(ts->data, rows * cols * sizeof(COMPLEX16));
+  }
+
   /* initialize algorithm with first training set value */
   dims = XLALCreateUINT4Vector( 2 );
+  if ( dims == NULL ){
+    status = XLAL_EFUNC;
+    fmt = "could not allocate reduced basis dimensions";
+    goto cleanup;
+  }
   dims->data[0] = 1; /* one row */
   dims->data[1] = cols;
   RB = XLALCreateCOMPLEX16Array( dims );
+  if ( RB == NULL ){
+    status = XLAL_EFUNC;
+    fmt = "could not allocate reduced basis";
+    goto cleanup;
+  }
   *RBin = RB;
 
   XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, 1, cols) );
@@ -1040,17 +1668,44 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   gpts->data[0] = 0;
   UINT4 dim_RB          = 1;
 
+  /* resume from a checkpoint, if there is one */
+  if ( checkpoint != NULL ){
+    UINT4 dim_RB_ckpt = 0;
+    void *RBdata = NULL;
+    if ( read_basis_checkpoint(checkpoint, sizeof(COMPLEX16), rows, cols, tschecksum, delta, tolerance, &dim_RB_ckpt, gpts->data, &RBdata) != XLAL_SUCCESS ){
+      status = XLAL_EFUNC;
+      fmt = "could not resume from checkpoint file";
+      goto cleanup;
+    }
+    if ( dim_RB_ckpt > 0 ){
+      dim_RB = dim_RB_ckpt;
+      dims->data[0] = dim_RB;
+      if ( XLALResizeCOMPLEX16Array( RB, dims ) == NULL ){
+        XLALFree(RBdata);
+        status = XLAL_EFUNC;
+        fmt = "could not resize reduced basis";
+        goto cleanup;
+      }
+      memcpy(RB->data, RBdata, (size_t)dim_RB * cols * sizeof(COMPLEX16));
+      XLALFree(RBdata);
+      XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, dim_RB, cols) );
+
+      /* project onto all but the last basis, which is projected onto in the first greedy sweep below */
+      if ( complex_initialise_projection_norms(&deltaview.vector, &TSview.matrix, &RBview.matrix, dim_RB-1, projection_norms2) != XLAL_SUCCESS ){
+        status = XLAL_EFUNC;
+        fmt = "could not project the training set onto the checkpointed basis";
+        goto cleanup;
+      }
+    }
+  }
+
   /* loop to find reduced basis */
   while( 1 ){
     gsl_matrix_complex_get_row(last_rb, &RBview.matrix, dim_RB-1); /* previous basis */
 
     /* Compute overlaps of pieces of training set with rb_new */
-    for(size_t i = 0; i < rows; i++){
-      gsl_matrix_complex_get_row(ts_el, &TSview.matrix, i);
-      projection_coeff = complex_weighted_dot_product(&deltaview.vector, last_rb, ts_el);
-      projection_norms2[i] += (projection_coeff.dat[0]*projection_coeff.dat[0] + projection_coeff.dat[1]*projection_coeff.dat[1]);
-      errors[i] = A_row_norms2[i] - projection_norms2[i];
-    }
+    complex_weighted_basis(&deltaview.vector, last_rb, wlast_rb);
+    complex_update_projection_norms(&TSview.matrix, wlast_rb, A_row_norms2, projection_norms2, errors);
 
     /* find worst represented training set element, and add to basis */
     worst_err = 0.0;
@@ -1106,7 +1761,11 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
 
     /* add to reduced basis */
     dims->data[0] = dim_RB+1; /* add row */
-    RB = XLALResizeCOMPLEX16Array( RB, dims );
+    if ( XLALResizeCOMPLEX16Array( RB, dims ) == NULL ){
+      status = XLAL_EFUNC;
+      fmt = "could not resize reduced basis";
+      goto cleanup;
+    }
 
     /* add on next basis */
     XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, dim_RB+1, cols) );
@@ -1118,16 +1777,41 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
 
     /* decide if another greedy sweep is needed */
     if( (dim_RB == max_RB) || (worst_err < tolerance) || (rows == dim_RB) ){ break; }
+
+    /* save progress so that a long basis generation can be resumed */
+    if ( checkpoint != NULL && checkpointinterval > 0 && dim_RB % checkpointinterval == 0 ){
+      if ( write_basis_checkpoint(checkpoint, sizeof(COMPLEX16), rows, cols, tschecksum, delta, tolerance, dim_RB, gpts->data, RB->data) != XLAL_SUCCESS ){
+        status = XLAL_EFUNC;
+        fmt = "could not write checkpoint file";
+        goto cleanup;
+      }
+    }
   }
 
-  gpts = XLALResizeUINT4Vector( gpts, dim_RB );
+  if ( XLALResizeUINT4Vector( gpts, dim_RB ) == NULL ){
+    status = XLAL_EFUNC;
+    fmt = "could not resize greedy points";
+  }
 
+ cleanup:
   XLALDestroyUINT4Vector(dims);
   gsl_vector_complex_free(ts_el);
   gsl_vector_complex_free(last_rb);
+  gsl_vector_complex_free(wlast_rb);
   gsl_vector_complex_free(ortho_basis);
   gsl_vector_complex_free(ru);
   gsl_matrix_complex_free(R_matrix);
+  XLALFree(A_row_norms2);
+  XLALFree(projection_norms2);
+  XLALFree(errors);
+
+  if ( status != XLAL_SUCCESS ){
+    XLALDestroyCOMPLEX16Array(RB);
+    XLALDestroyUINT4Vector(gpts);
+    *RBin = NULL;
+    *greedypoints = NULL;
+    XLAL_ERROR_REAL8(status, "%s", fmt);
+  }
 
   return worst_err;
 }
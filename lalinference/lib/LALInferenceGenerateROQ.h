@@ -65,6 +65,23 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RB,
                                                     COMPLEX16Array **TS,
                                                     UINT4Vector **greedypoints);
 
+/* checkpointing versions of the above functions, which can resume a previous run */
+REAL8 LALInferenceGenerateREAL8OrthonormalBasisCheckpoint(REAL8Array **RB,
+                                                          const REAL8Vector *delta,
+                                                          REAL8 tolerance,
+                                                          REAL8Array **TS,
+                                                          UINT4Vector **greedypoints,
+                                                          const CHAR *checkpoint,
+                                                          UINT4 checkpointinterval);
+
+REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasisCheckpoint(COMPLEX16Array **RB,
+                                                              const REAL8Vector *delta,
+                                                              REAL8 tolerance,
+                                                              COMPLEX16Array **TS,
+                                                              UINT4Vector **greedypoints,
+                                                              const CHAR *checkpoint,
+                                                              UINT4 checkpointinterval);
+
 /* functions to test the basis */
 void LALInferenceValidateREAL8OrthonormalBasis(REAL8Vector **projerr,
                                                const REAL8Vector *delta,
@@ -930,6 +930,7 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
   model->eos_fam = NULL;
+  model->eos_cache = NULL;
 
   UINT4 signal_flag=1;
   ppt = LALInferenceGetProcParamVal(commandLine, "--noiseonly");
@@ -1421,12 +1422,14 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
     LALInferenceRegisterUniformVariableREAL8(state, model->params, "gamma1", zero, gamma1Min, gamma1Max, LALINFERENCE_PARAM_LINEAR);
     LALInferenceRegisterUniformVariableREAL8(state, model->params, "gamma2", zero, gamma2Min, gamma2Max, LALINFERENCE_PARAM_LINEAR);
     LALInferenceRegisterUniformVariableREAL8(state, model->params, "gamma3", zero, gamma3Min, gamma3Max, LALINFERENCE_PARAM_LINEAR);
+    model->eos_cache = XLALCreateSimNeutronStarFamilyCache(LALINFERENCE_EOS_CACHE_SIZE);
   // Pull in spectral decomposition parameters (SDgamma0,SDgamma1,SDgamma2,SDgamma3)
   } else  if(LALInferenceGetProcParamVal(commandLine,"--4SpectralDecomp")){
     LALInferenceRegisterUniformVariableREAL8(state, model->params, "SDgamma0", zero, SDgamma0Min, SDgamma0Max, LALINFERENCE_PARAM_LINEAR);
     LALInferenceRegisterUniformVariableREAL8(state, model->params, "SDgamma1", zero, SDgamma1Min, SDgamma1Max, LALINFERENCE_PARAM_LINEAR);
     LALInferenceRegisterUniformVariableREAL8(state, model->params, "SDgamma2", zero, SDgamma2Min, SDgamma2Max, LALINFERENCE_PARAM_LINEAR);
     LALInferenceRegisterUniformVariableREAL8(state, model->params, "SDgamma3", zero, SDgamma3Min, SDgamma3Max, LALINFERENCE_PARAM_LINEAR);
+    model->eos_cache = XLALCreateSimNeutronStarFamilyCache(LALINFERENCE_EOS_CACHE_SIZE);
   } else if((ppt=LALInferenceGetProcParamVal(commandLine,"--eos"))){
     LALSimNeutronStarEOS *eos=NULL;
     errnum=XLAL_SUCCESS;
@@ -200,6 +200,8 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde) {
         XLALFree(kde->lower_bounds);
         XLALFree(kde->upper_bounds);
 
+        if (kde->tree) LALInferenceKDTreeDelete(kde->tree);
+
         XLALFree(kde);
     }
 }
@@ -237,6 +239,84 @@ INT4 LALInferenceCholeskyDecompose(gsl_matrix *mat) {
 }
 
 
+/* Transform a point to the frame where the kernels are unit Gaussians */
+static void whiten_kde_point(LALInferenceKDE *kde, gsl_vector *pt) {
+    gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit,
+                    kde->cholesky_decomp_cov, pt);
+}
+
+
+/* (Re)build the kD-tree of whitened points used for truncated evaluation */
+static void build_kde_tree(LALInferenceKDE *kde) {
+    INT4 i, p;
+    INT4 dim = kde->dim;
+
+    if (kde->tree) {
+        LALInferenceKDTreeDelete(kde->tree);
+        kde->tree = NULL;
+    }
+
+    if (kde->truncation <= 0. || kde->npts == 0 || isinf(kde->log_norm_factor))
+        return;
+
+    gsl_matrix *wdata = gsl_matrix_alloc(kde->npts, dim);
+    gsl_matrix_memcpy(wdata, kde->data);
+
+    REAL8 *lower = XLALMalloc(dim * sizeof(REAL8));
+    REAL8 *upper = XLALMalloc(dim * sizeof(REAL8));
+    for (p = 0; p < dim; p++) {
+        lower[p] = INFINITY;
+        upper[p] = -INFINITY;
+    }
+
+    for (i = 0; i < kde->npts; i++) {
+        gsl_vector_view x = gsl_matrix_row(wdata, i);
+        whiten_kde_point(kde, &x.vector);
+        for (p = 0; p < dim; p++) {
+            REAL8 val = gsl_vector_get(&x.vector, p);
+            if (val < lower[p]) lower[p] = val;
+            if (val > upper[p]) upper[p] = val;
+        }
+    }
+
+    kde->tree = LALInferenceKDEmpty(lower, upper, dim);
+    for (i = 0; i < kde->npts; i++)
+        LALInferenceKDAddPoint(kde->tree, gsl_matrix_ptr(wdata, i, 0));
+
+    gsl_matrix_free(wdata);
+    XLALFree(lower);
+    XLALFree(upper);
+}
+
+
+/**
+ * Truncate the kernels of a KDE.
+ *
+ * Kernels centred further than \a truncation bandwidths (in the metric of the
+ *  kernel covariance) from the point being evaluated are neglected, and a
+ *  kD-tree of the samples is used to find the remaining ones.  This makes the
+ *  cost of LALInferenceKDEEvaluatePoint() scale with the number of nearby
+ *  samples rather than with the total number of samples.  The kernels are
+ *  searched within truncation + sqrt(dim) bandwidths, since a point drawn
+ *  from a kernel typically lies sqrt(dim) bandwidths from its centre.  Each
+ *  neglected kernel is then smaller than that of the kernel the point was
+ *  drawn from by a factor of at least exp(-truncation^2/2).  The sum of all
+ *  neglected kernels can still be larger than this, since there can be many
+ *  of them, so the result is an approximation rather than a bound.  If no
+ *  kernel lies within the radius, the exact sum is returned.
+ * @param kde        The kernel density estimate to truncate.
+ * @param truncation Truncation radius in bandwidths. Zero, negative or
+ *                    infinite values restore the exact sum over all kernels.
+ */
+void LALInferenceSetKDETruncation(LALInferenceKDE *kde, REAL8 truncation) {
+    if (!(truncation > 0.) || isinf(truncation))
+        truncation = 0.;
+
+    kde->truncation = truncation;
+    build_kde_tree(kde);
+}
+
+
 /**
  * Calculate the bandwidth and normalization factor for a KDE.
  *
@@ -284,6 +364,10 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
     kde->log_norm_factor =
         log(kde->npts * sqrt(pow(2*LAL_PI, kde->dim) * det_cov));
 
+    /* The kD-tree lives in the frame set by the bandwidth */
+    if (kde->truncation > 0.)
+        build_kde_tree(kde);
+
     return;
 }
 
@@ -368,9 +452,43 @@ REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
         }
     }
 
+    REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
+
+    /* Only sum the nearby kernels if the KDE is truncated.  A draw from a
+     * kernel lies about sqrt(dim) bandwidths from its centre, so the radius
+     * grows with the dimension.  If no kernel lies within the radius, fall
+     * back to the exact sum rather than returning -inf. */
+    if (kde->tree) {
+        REAL8 radius = kde->truncation + sqrt(dim);
+        INT4 truncated = 1;
+        gsl_vector *wpt = gsl_vector_alloc(dim);
+
+        for (i = 0; i < n_evals; i++) {
+            gsl_vector_view pt = gsl_matrix_row(points, i);
+            gsl_vector_memcpy(wpt, &pt.vector);
+            whiten_kde_point(kde, wpt);
+            eval_results[i] = LALInferenceKDLogGaussianKernelSum(kde->tree,
+                                    wpt->data, radius) - kde->log_norm_factor;
+            if (isinf(eval_results[i])) {
+                truncated = 0;
+                break;
+            }
+        }
+
+        gsl_vector_free(wpt);
+
+        if (truncated) {
+            REAL8 result = log_add_exps(eval_results, n_evals);
+
+            gsl_matrix_free(points);
+            XLALFree(eval_results);
+
+            return result;
+        }
+    }
+
     /* Loop over list of reflected and cycled points */
     REAL8* results = XLALMalloc(npts * sizeof(REAL8));
-    REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
 
     /* Loop over reflected and cycled set of points */
     for (i = 0; i < n_evals; i++) {
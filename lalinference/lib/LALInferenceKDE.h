@@ -51,6 +51,13 @@ tagKDE
     LALInferenceParamVaryType * upper_bound_types; /**< Array of param boundary types */
     REAL8 * lower_bounds;              /**< Lower param bounds */
     REAL8 * upper_bounds;              /**< Upper param bounds */
+
+    REAL8 truncation;                       /**< Kernels further than this many bandwidths,
+                                                  plus sqrt(dim), from a point are neglected
+                                                  (0 to sum all). */
+    LALInferenceKDTree * tree;              /**< kD-tree of the data in the frame where
+                                                  the kernels are unit Gaussians, used
+                                                  when \a truncation is set. */
 } LALInferenceKDE;
 
 /* Allocate, fill, and tune a Gaussian kernel density estimate given an array of points. */
@@ -68,6 +75,9 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde);
 /* Calculate the bandwidth and normalization factor for a KDE. */
 void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde);
 
+/* Neglect kernels beyond a given number of bandwidths when evaluating a KDE. */
+void LALInferenceSetKDETruncation(LALInferenceKDE *kde, REAL8 truncation);
+
 /* Evaluate the (log) PDF from a KDE at a single point. */
 REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point);
 
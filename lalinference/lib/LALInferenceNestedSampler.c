@@ -27,6 +27,10 @@
 
 #include "logaddexp.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #define PROGRAM_NAME "LALInferenceNestedSampler.c"
 #define CVS_ID_STRING "$Id$"
 #define CVS_REVISION "$Revision$"
@@ -312,6 +316,11 @@ static double logsubexp(double a, double b)
 }
 
 static void SetupEigenProposals(LALInferenceRunState *runState);
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState);
+
+static UINT4 MCMCSamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *GSLrandom, REAL8 logLmin);
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *GSLrandom, REAL8 logLmin, REAL8 *sloppyfrac, REAL8 *accept_rate, REAL8 *sub_accept_rate);
+static UINT4 ReplaceLivePointsParallel(LALInferenceRunState *runState, UINT4 *removed, UINT4 Nreplace, REAL8 logLmin, REAL8 *logLikelihoods);
 
 /**
  * Update the internal state of the integrator after receiving the lowest logL
@@ -435,9 +444,9 @@ static UINT4 UpdateNMCMC(LALInferenceRunState *runState){
         }
         LALInferenceSetVariable(runState->algorithmParams,"Nmcmc",&max);
     }
-    /* Single threaded here */
     if (LALInferenceGetProcParamVal(runState->commandLine,"--proposal-kde"))
-        LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[0]);
+        for(INT4 t=0;t<runState->nthreads;t++)
+            LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[t]);
     return(max);
 }
 
@@ -598,6 +607,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
                                      or OUTFILE_resume and continue if possible\n\
     (--checkpoint-exit-code N)       Exit with code N when checkpoint is complete.\n\
                                      For use with condor's +SuccessCheckpointExitCode option\n\
+    (--Nthreads N)                   Replace the N lowest-likelihood live points in each iteration,\n\
+                                     evolving the replacements in parallel on N threads (1)\n\
     \n";
 
   ProcessParamsTable *ppt=NULL;
@@ -640,15 +651,13 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   INT4 tmpi=0;
   REAL8 tmp=0;
 
-  /* Single thread only */
-  LALInferenceThreadState *threadState = &runState->threads[0];
-
   /* Set up the appropriate functions for the nested sampling algorithm */
   runState->algorithm=&LALInferenceNestedSamplingAlgorithm;
   runState->evolve=&LALInferenceNestedSamplingOneStep;
 
   /* use the ptmcmc proposal to sample prior */
-  threadState->proposal=&LALInferenceCyclicProposal;
+  for(INT4 t=0;t<runState->nthreads;t++)
+    runState->threads[t].proposal=&LALInferenceCyclicProposal;
   REAL8 temp=1.0;
   LALInferenceAddVariable(runState->proposalArgs,"temperature",&temp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_FIXED);
 
@@ -713,6 +722,66 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 }
 
 
+/* Replace the Nreplace live points listed in removed[] in parallel.
+ Each thread evolves a copy of a randomly chosen surviving live point above
+ logLmin with the sloppy sampler, as LALInferenceNestedSamplingOneStep() does
+ for a single point. The live points are only read while the threads run, so
+ they can also serve as the threads' differential evolution buffer.
+ Returns the mean number of attempts per replacement, and sets the mean
+ acceptance rates and sloppy fraction in runState->algorithmParams. */
+static UINT4 ReplaceLivePointsParallel(LALInferenceRunState *runState, UINT4 *removed, UINT4 Nreplace, REAL8 logLmin, REAL8 *logLikelihoods)
+{
+  UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
+  REAL8 sloppyfraction=-1.0; /* Negative selects the default */
+  REAL8 *sloppy=XLALCalloc(Nreplace,sizeof(REAL8));
+  REAL8 *accept=XLALCalloc(Nreplace,sizeof(REAL8));
+  REAL8 *sub_accept=XLALCalloc(Nreplace,sizeof(REAL8));
+  UINT4 *tries=XLALCalloc(Nreplace,sizeof(UINT4));
+  REAL8 accept_rate=0.0,sub_accept_rate=0.0;
+  UINT4 ntries=0,t;
+
+  if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
+    sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+
+  #pragma omp parallel for schedule(dynamic,1)
+  for(t=0;t<Nreplace;t++)
+  {
+    LALInferenceThreadState *threadState=&runState->threads[t];
+    UINT4 j,r;
+    sloppy[t]=sloppyfraction;
+    do{ /* This loop is here in case it is necessary to find a different sample */
+      /* Clone a surviving live point and evolve it */
+      do{
+        j=gsl_rng_uniform_int(threadState->GSLrandom,Nlive);
+        for(r=0;r<Nreplace && removed[r]!=j;r++);
+      }while(r<Nreplace);
+      LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
+      threadState->currentLikelihood=logLikelihoods[j];
+      NestedSamplingSloppySampleThread(runState,threadState,threadState->GSLrandom,logLmin,&sloppy[t],&accept[t],&sub_accept[t]);
+      tries[t]++;
+    }while(threadState->currentLikelihood<=logLmin || accept[t]==0.0);
+  }
+
+  /* Copy the new points into the slots of the removed ones */
+  sloppyfraction=0.0;
+  for(t=0;t<Nreplace;t++)
+  {
+    LALInferenceCopyVariables(runState->threads[t].currentParams,runState->livePoints[removed[t]]);
+    logLikelihoods[removed[t]]=runState->threads[t].currentLikelihood;
+    accept_rate+=accept[t]/(REAL8)Nreplace;
+    sub_accept_rate+=sub_accept[t]/(REAL8)Nreplace;
+    sloppyfraction+=sloppy[t]/(REAL8)Nreplace;
+    ntries+=tries[t];
+  }
+  LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
+  LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+  if(isfinite(logLmin) && LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
+    LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+
+  XLALFree(sloppy); XLALFree(accept); XLALFree(sub_accept); XLALFree(tries);
+  return((ntries+Nreplace-1)/Nreplace);
+}
+
 /* NestedSamplingAlgorithm implements the nested sampling algorithm,
  see e.g. Sivia & Skilling "Data Analysis: A Bayesian Tutorial, 2nd edition.
  REQUIREMENTS:
@@ -725,9 +794,11 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 
 void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 {
-  UINT4 iter=0,i,j,minpos;
-  /* Single thread here */
+  UINT4 iter=0,i,j,k,minpos;
+  /* Thread 0 is used for the serial parts of the algorithm */
   LALInferenceThreadState *threadState = &runState->threads[0];
+  UINT4 Nparallel=1,Nreplace=1;
+  UINT4 *removed=NULL;
   UINT4 HDFOUTPUT=1;
   UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
   UINT4 Nruns=100;
@@ -834,10 +905,26 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   SetupEigenProposals(runState);
 
   /* Use the live points as differential evolution points */
-  /* Single thread here */
   syncLivePointsDifferentialPoints(runState,threadState);
   threadState->differentialPointsSkip=1;
 
+  /* Replace several points per iteration in parallel if there are several
+   threads and the default sampler is used */
+  if(runState->nthreads>1 && runState->evolve==&LALInferenceNestedSamplingOneStep)
+  {
+    Nparallel=(UINT4)runState->nthreads < Nlive-1 ? (UINT4)runState->nthreads : Nlive-1;
+    removed=XLALCalloc(Nparallel,sizeof(UINT4));
+    for(INT4 t=1;t<runState->nthreads;t++)
+    {
+      LALInferenceThreadState *thread=&runState->threads[t];
+      if(thread->differentialPoints!=runState->livePoints) XLALFree(thread->differentialPoints);
+      thread->differentialPoints=runState->livePoints;
+      thread->differentialPointsLength=thread->differentialPointsSize=Nlive;
+      thread->differentialPointsSkip=1;
+    }
+    fprintf(stdout,"Replacing %u live points per iteration on %i threads\n",Nparallel,runState->nthreads);
+  }
+
   if(!LALInferenceCheckVariable(runState->algorithmParams,"Nmcmc")){
     INT4 tmp=MAX_MCMC;
     if(LALInferenceGetProcParamVal(runState->commandLine,"--Nmcmcinitial")){
@@ -945,41 +1032,83 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   /* Iterate until termination condition is met */
   do {
-    /* Find minimum likelihood sample to replace */
-    minpos=0;
-    for(i=1;i<Nlive;i++){
-      if(logLikelihoods[i]<logLikelihoods[minpos])
-	minpos=i;
-    }
-    logLmin=logLikelihoods[minpos];
-    if(samplePrior) logLmin=-INFINITY;
-
-    logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive, logLikelihoods[minpos], s);
-    //deltaZ=logZnew-logZ; - set but not used
-    H=mean(Harray,Nruns);
-    logZ=logZnew;
-    if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
     UINT4 itercounter=0;
+    /* Use the parallel replacement unless there are cached proposals to use up */
+    Nreplace=1;
+    if(Nparallel>1 && (!LALInferenceCheckVariable(runState->algorithmParams,"proposalcachesize")
+        || *(INT4 *)LALInferenceGetVariable(runState->algorithmParams,"proposalcachesize")==0))
+      Nreplace=Nparallel;
 
-    /* Generate a new live point */
-    do{ /* This loop is here in case it is necessary to find a different sample */
-      /* Clone an old live point and evolve it */
-      while((j=gsl_rng_uniform_int(runState->GSLrandom,Nlive))==minpos){};
-      LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
-      threadState->currentLikelihood = logLikelihoods[j];
+    if(Nreplace>1)
+    {
+      /* Find the Nreplace lowest likelihood samples, in ascending order */
+      for(k=0;k<Nreplace;k++){
+        minpos=Nlive;
+        for(i=0;i<Nlive;i++){
+          for(j=0;j<k && removed[j]!=i;j++);
+          if(j<k) continue;
+          if(minpos==Nlive || logLikelihoods[i]<logLikelihoods[minpos])
+            minpos=i;
+        }
+        removed[k]=minpos;
+        /* The k-th lowest of Nlive points is the lowest of the Nlive-k remaining */
+        logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive-k, logLikelihoods[minpos], s);
+        if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
+      }
+      H=mean(Harray,Nruns);
+      logZ=logZnew;
+      logLmin=logLikelihoods[removed[Nreplace-1]];
+      if(samplePrior) logLmin=-INFINITY;
       LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&logLmin);
-      runState->evolve(runState);
-      itercounter++;
-    }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(runState->algorithmParams,"accept_rate")==0.0);
-
-    LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
-    logLikelihoods[minpos]=threadState->currentLikelihood;
 
-  if (threadState->currentLikelihood>logLmax)
-    logLmax=threadState->currentLikelihood;
+      /* Generate the new live points */
+      itercounter=ReplaceLivePointsParallel(runState,removed,Nreplace,logLmin,logLikelihoods);
 
-  logw=mean(logwarray,Nruns);
-  LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+      logw=mean(logwarray,Nruns);
+      for(k=0;k<Nreplace;k++)
+      {
+        if (logLikelihoods[removed[k]]>logLmax)
+          logLmax=logLikelihoods[removed[k]];
+        LALInferenceAddVariable(runState->livePoints[removed[k]],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+      }
+    }
+    else
+    {
+      /* Find minimum likelihood sample to replace */
+      minpos=0;
+      for(i=1;i<Nlive;i++){
+        if(logLikelihoods[i]<logLikelihoods[minpos])
+          minpos=i;
+      }
+      logLmin=logLikelihoods[minpos];
+      if(samplePrior) logLmin=-INFINITY;
+
+      logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive, logLikelihoods[minpos], s);
+      //deltaZ=logZnew-logZ; - set but not used
+      H=mean(Harray,Nruns);
+      logZ=logZnew;
+      if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
+
+      /* Generate a new live point */
+      do{ /* This loop is here in case it is necessary to find a different sample */
+        /* Clone an old live point and evolve it */
+        while((j=gsl_rng_uniform_int(runState->GSLrandom,Nlive))==minpos){};
+        LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
+        threadState->currentLikelihood = logLikelihoods[j];
+        LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&logLmin);
+        runState->evolve(runState);
+        itercounter++;
+      }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(runState->algorithmParams,"accept_rate")==0.0);
+
+      LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
+      logLikelihoods[minpos]=threadState->currentLikelihood;
+
+      if (threadState->currentLikelihood>logLmax)
+        logLmax=threadState->currentLikelihood;
+
+      logw=mean(logwarray,Nruns);
+      LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    }
   dZ=logaddexp(logZ,logLmax-((double) iter)/((double)Nlive))-logZ;
   sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
   if(displayprogress) fprintf(stderr,"%i: accpt: %1.3f Nmcmc: %i sub_accpt: %1.3f slpy: %2.1f%% H: %3.2lf nats logL:%.3lf ->%.3lf logZ: %.3lf deltalogLmax: %.2lf dZ: %.3lf Zratio: %.3lf \n",\
@@ -996,7 +1125,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     dZ,\
     ( logZ - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise"))\
   );
-  iter++;
+  iter+=Nreplace;
 
   /* Save progress */
   if(__ns_saveStateFlag!=0)
@@ -1011,8 +1140,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     exit(CondorExitCode);
   }
 
-  /* Update the proposal */
-  if(!(iter%(Nlive/10))) {
+  /* Update the proposal every Nlive/10 iterations */
+  if(iter/(Nlive/10)!=(iter-Nreplace)/(Nlive/10)) {
     /* Update the covariance matrix */
     if ( LALInferenceCheckVariable( threadState->proposalArgs,"covarianceMatrix" ) ){
       SetupEigenProposals(runState);
@@ -1150,6 +1279,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   
   /* Free memory */
   XLALFree(logtarray); XLALFree(logwarray); XLALFree(logZarray);
+  if(removed) XLALFree(removed);
 }
 
 /* Calculate the autocorrelation function of the sampler (runState->evolve) for each parameter
@@ -1166,8 +1296,8 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
   FILE *acffile=NULL;
   UINT4 i,j;
   UINT4 nPar=0; // = LALInferenceGetVariableDimensionNonFixed(runState->currentParams);
-  REAL8 **data_array=NULL;
-  REAL8 **acf_array=NULL;
+  REAL8 *data_array=NULL;
+  REAL8 *acf_array=NULL;
   LALInferenceVariableItem *this;
   INT4 thinning=1;
   max_iterations/=thinning;
@@ -1241,33 +1371,33 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
   /* Get the location of the sample array */
   LALInferenceVariables **variables_array=*(LALInferenceVariables ***)LALInferenceGetVariable(runState->algorithmParams,"outputarray");
 
-  /* Convert to a 2D array for ACF calculation */
-  data_array=XLALCalloc(nPar,sizeof(REAL8 *));
-  acf_array=XLALCalloc(nPar,sizeof(REAL8 *));
-  for (i=0;i<(UINT4)nPar;i++){
-    data_array[i]=XLALCalloc(max_iterations,sizeof(REAL8));
-    acf_array[i]=XLALCalloc(max_iterations/2,sizeof(REAL8));
-  }
+  /* Convert to a 2D array for ACF calculation, one row per sample */
+  UINT4 nLags=max_iterations/2;
+  data_array=XLALCalloc(max_iterations*nPar,sizeof(REAL8));
+  acf_array=XLALCalloc(nPar*nLags,sizeof(REAL8));
   /* Measure autocorrelation in each dimension */
   /* Not ideal, should be measuring something like the det(autocorrelation-crosscorrelation matrix) */
   for (i=0;i<max_iterations;i++){
-    for(j=0;j<nPar;j++) data_array[j][i]=*(REAL8 *)LALInferenceGetVariable(variables_array[i],param_names[j]);
+    for(j=0;j<nPar;j++) data_array[i*nPar+j]=*(REAL8 *)LALInferenceGetVariable(variables_array[i],param_names[j]);
+  }
+  /* Compute the ACFs of all parameters at once with FFTs */
+  if(nPar>0 && nLags>0 && LALInferenceComputeAutoCorrelationFunctions(acf_array, data_array, max_iterations, nPar, nLags)!=XLAL_SUCCESS)
+  {
+    fprintf(stderr,"Error computing autocorrelation functions\n");
+    exit(1);
   }
   this=myCurrentParams.head;
   for(i=0;i<(UINT4)nPar;i++){
-   /* Subtract the mean */
-   REAL8 this_mean = gsl_stats_mean(&data_array[i][0], 1, max_iterations);
-   for(j=0;j<max_iterations;j++) data_array[i][j]-=this_mean;
+   REAL8 this_mean = gsl_stats_mean(data_array+i, nPar, max_iterations);
    ACL=1;
    int startflag=1;
    ACF=1.;
-   /* Use GSL to compute the ACF */
-   for(UINT4 lag=0;ACF>=ACF_TOLERANCE&&lag<max_iterations/2;lag++){
-      ACF=(REAL8) gsl_stats_correlation(&data_array[i][0], 1, &data_array[i][lag], 1, max_iterations-lag);
+   for(UINT4 lag=0;ACF>=ACF_TOLERANCE&&lag<nLags;lag++){
+      ACF=acf_array[i*nLags+lag];
       if(isnan(ACF)) ACF=1.;
-      acf_array[i][lag]=ACF;
+      acf_array[i*nLags+lag]=ACF;
       ACL+=2.0*ACF;
-      if((ACF<ACF_TOLERANCE && startflag) || lag==max_iterations/2-1){
+      if((ACF<ACF_TOLERANCE && startflag) || lag==nLags-1){
 	    startflag=0;
         ACL*=(REAL8)thinning;
 	    if(ACL>max) max=ACL;
@@ -1282,8 +1412,8 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
   /* Write out the ACF */
   for(j=0;j<(UINT4)nPar;j++) fprintf(acffile,"%s ",param_names[j]);
   fprintf(acffile,"\n");
-  for(i=0;i<max_iterations/2;i++){
-    for(j=0;j<(UINT4)nPar;j++) fprintf(acffile,"%f ",acf_array[j][i]);
+  for(i=0;i<nLags;i++){
+    for(j=0;j<(UINT4)nPar;j++) fprintf(acffile,"%f ",acf_array[j*nLags+i]);
     fprintf(acffile,"\n");
   }
   }
@@ -1317,7 +1447,6 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
   }
 
   /* Clean up */
-  for(i=0;i<(UINT4)nPar;i++) {XLALFree(data_array[i]); XLALFree(acf_array[i]);}
   for (i=0;i<max_iterations;i++){
     LALInferenceClearVariables(variables_array[i]);
     XLALFree(variables_array[i]);
@@ -1335,10 +1464,8 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
 }
 
 /* Perform one MCMC iteration on runState->currentParams. Return 1 if accepted or 0 if not */
-UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
+static UINT4 MCMCSamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *GSLrandom, REAL8 logLmin)
 {
-    /* Single threaded here */
-    LALInferenceThreadState * threadState=&runState->threads[0];
     UINT4 outOfBounds=0;
     UINT4 adaptProp=0;
     //LALInferenceVariables tempParams;
@@ -1346,7 +1473,6 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     //LALInferenceVariables *oldParams=&tempParams;
     LALInferenceVariables proposedParams;
     memset(&proposedParams,0,sizeof(proposedParams));
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
     REAL8 thislogL=-INFINITY;
     UINT4 accepted=0;
 
@@ -1360,7 +1486,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 
     logProposalRatio = threadState->proposal(threadState,threadState->currentParams,&proposedParams);
     REAL8 logPriorNew=runState->prior(runState, &proposedParams, threadState->model);
-    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(runState->GSLrandom)) > (logPriorNew-logPriorOld) + logProposalRatio)
+    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(GSLrandom)) > (logPriorNew-logPriorOld) + logProposalRatio)
     {
 	/* Reject - don't need to copy new params back to currentParams */
         /*LALInferenceCopyVariables(oldParams,runState->currentParams); */
@@ -1387,6 +1513,13 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     return(accepted);
 }
 
+UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
+{
+    /* Single threaded here */
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    return(MCMCSamplePriorThread(runState, &runState->threads[0], runState->GSLrandom, logLmin));
+}
+
 /* Sample the prior N times, returns number of acceptances */
 UINT4 LALInferenceMCMCSamplePriorNTimes(LALInferenceRunState *runState, UINT4 N)
 {
@@ -1482,11 +1615,9 @@ INT4 LALInferenceNestedSamplingCachedSampler(LALInferenceRunState *runState)
    x=LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction")
    */
 
-INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *GSLrandom, REAL8 logLmin, REAL8 *sloppyfrac, REAL8 *accept_rate, REAL8 *sub_accept_rate)
 {
     LALInferenceVariables oldParams;
-    /* Single thread here */
-    LALInferenceThreadState *threadState = &runState->threads[0];
     LALInferenceIFOData *data=runState->data;
     REAL8 tmp;
     REAL8 Target=0.3;
@@ -1494,14 +1625,12 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     REAL8 logLold=*(REAL8 *)LALInferenceGetVariable(threadState->currentParams,"logL");
     memset(&oldParams,0,sizeof(oldParams));
     LALInferenceCopyVariables(threadState->currentParams,&oldParams);
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
     UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
     REAL8 maxsloppyfraction=((REAL8)Nmcmc-1)/(REAL8)Nmcmc ;
     REAL8 sloppyfraction=maxsloppyfraction/2.0;
     REAL8 minsloppyfraction=0.;
     if(Nmcmc==1) maxsloppyfraction=minsloppyfraction=0.0;
-    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
-      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    if (*sloppyfrac>=0.0) sloppyfraction=*sloppyfrac;
     UINT4 mcmc_iter=0,Naccepted=0,sub_accepted=0;
     UINT4 sloppynumber=(UINT4) (sloppyfraction*(REAL8)Nmcmc);
     UINT4 testnumber=Nmcmc-sloppynumber;
@@ -1527,7 +1656,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         /* Draw an independent sample from the prior */
         do{
 
-            sub_accepted+=LALInferenceMCMCSamplePrior(runState);
+            sub_accepted+=MCMCSamplePriorThread(runState,threadState,GSLrandom,logLmin);
             subchain_length++;
             counter+=(1.-sloppyfraction);
         }while(counter<1);
@@ -1597,18 +1726,16 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     }
 
     /* Compute some statistics for information */
-    REAL8 sub_accept_rate=(REAL8)sub_accepted/(REAL8)sub_iter;
-    REAL8 accept_rate=(REAL8)Naccepted/(REAL8)testnumber;
-    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
-    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    *sub_accept_rate=(REAL8)sub_accepted/(REAL8)sub_iter;
+    *accept_rate=(REAL8)Naccepted/(REAL8)testnumber;
     /* Adapt the sloppy fraction toward target acceptance of outer chain */
     if(isfinite(logLmin)){
-        if((REAL8)accept_rate>Target) { sloppyfraction+=5.0/(REAL8)Nmcmc;}
+        if(*accept_rate>Target) { sloppyfraction+=5.0/(REAL8)Nmcmc;}
         else { sloppyfraction-=5.0/(REAL8)Nmcmc;}
         if(sloppyfraction>maxsloppyfraction) sloppyfraction=maxsloppyfraction;
 	if(sloppyfraction<minsloppyfraction) sloppyfraction=minsloppyfraction;
 
-	LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+	*sloppyfrac=sloppyfraction;
     }
     /* Cleanup */
     LALInferenceClearVariables(&oldParams);
@@ -1617,6 +1744,23 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
 }
 
 
+INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
+{
+    /* Single thread here */
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    REAL8 sloppyfraction=-1.0; /* Negative selects the default */
+    REAL8 accept_rate=0.0,sub_accept_rate=0.0;
+    INT4 Naccepted;
+    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
+      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    Naccepted=NestedSamplingSloppySampleThread(runState,&runState->threads[0],runState->GSLrandom,logLmin,&sloppyfraction,&accept_rate,&sub_accept_rate);
+    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
+    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    if(isfinite(logLmin) && LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
+      LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+    return Naccepted;
+}
+
 /* Evolve nested sampling algorithm by one step, i.e.
  evolve runState->currentParams to a new point with higher
  likelihood than currentLikelihood. Uses the MCMC method with sloppy sampling.
@@ -1676,10 +1820,8 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 }
 
 
-static void SetupEigenProposals(LALInferenceRunState *runState)
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState)
 {
-  /* Single thread here */
-  LALInferenceThreadState *threadState = &runState->threads[0];
   gsl_matrix *eVectors=NULL;
   gsl_vector *eValues =NULL;
   REAL8Vector *eigenValues=NULL;
@@ -1737,6 +1879,12 @@ static void SetupEigenProposals(LALInferenceRunState *runState)
   XLALFree(cvm);
 }
 
+static void SetupEigenProposals(LALInferenceRunState *runState)
+{
+  for(INT4 t=0;t<runState->nthreads;t++)
+    SetupEigenProposalsThread(runState,&runState->threads[t]);
+}
+
 
 static int syncLivePointsDifferentialPoints(LALInferenceRunState *state, LALInferenceThreadState *thread)
 {
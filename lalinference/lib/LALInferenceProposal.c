@@ -47,8 +47,13 @@
 #include <lal/LALStdlib.h>
 #include <lal/LALInferenceClusteredKDE.h>
 #include <lal/LALInferenceNestedSampler.h>
+#include <lal/RealFFT.h>
 #include <alloca.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -262,6 +267,7 @@ LALInferenceVariables *LALInferenceParseProposalArgs(LALInferenceRunState *runSt
     INT4 Nskip = 1;
     INT4 noise_only = 0;
     INT4 cyclic_reflective_kde = 0;
+    REAL8 kde_truncation = 0.0;
 
     /* Flags for proposals, initialized with the MCMC defaults */
 
@@ -401,6 +407,12 @@ LALInferenceVariables *LALInferenceParseProposalArgs(LALInferenceRunState *runSt
         cyclic_reflective_kde = 1;
     LALInferenceAddINT4Variable(propArgs, "cyclic_reflective_kde", cyclic_reflective_kde, LALINFERENCE_PARAM_FIXED);
 
+    /* Neglect KDE kernels more than this many bandwidths away */
+    ppt = LALInferenceGetProcParamVal(command_line, "--kde-truncation");
+    if (ppt)
+        kde_truncation = atof(ppt->value);
+    LALInferenceAddREAL8Variable(propArgs, "kde_truncation", kde_truncation, LALINFERENCE_PARAM_FIXED);
+
     if (LALInferenceGetProcParamVal(command_line, "--noiseonly"))
         noise_only = 1;
     LALInferenceAddINT4Variable(propArgs, "noiseonly", noise_only, LALINFERENCE_PARAM_FIXED);
@@ -3140,6 +3152,10 @@ void LALInferenceInitClusteredKDEProposal(LALInferenceThreadState *thread,
     /* Selectivey impose bounds on KDEs */
     LALInferenceKmeansImposeBounds(kde->kmeans, params, thread->priorArgs, cyclic_reflective);
 
+    /* Evaluate the proposal density from nearby kernels only, if requested */
+    if (LALInferenceCheckVariable(thread->proposalArgs, "kde_truncation"))
+        LALInferenceKmeansSetKDETruncation(kde->kmeans, LALInferenceGetREAL8Variable(thread->proposalArgs, "kde_truncation"));
+
     /* Print out clustered samples, assignments, and PDF values if requested */
     if (LALInferenceGetINT4Variable(thread->proposalArgs, "verbose")) {
         printf("Thread %i found %i clusters.\n", thread->id, kde->kmeans->k);
@@ -3500,7 +3516,7 @@ void LALInferenceComputeMaxAutoCorrLenFromDE(LALInferenceThreadState *thread, IN
     LALInferenceBufferToArray(thread, DEarray);
     max_acl = nSkip * LALInferenceComputeMaxAutoCorrLen(DEarray[nPoints/2], nPoints-nPoints/2, nPar);
 
-    if (max_acl == INFINITY)
+    if (max_acl == INFINITY || isnan(max_acl))
         max_acl = INT_MAX;
     else if (max_acl < 1.0)
         max_acl = 1.0;
@@ -3510,8 +3526,204 @@ void LALInferenceComputeMaxAutoCorrLenFromDE(LALInferenceThreadState *thread, IN
     XLALFree(DEarray);
 }
 
+/*
+ * FFT plans for LALInferenceComputeAutoCorrelationFunctions(), indexed by
+ * the base-2 logarithm of the transform length.  Lengths are rounded up to
+ * powers of two, so only a handful of plans are ever made; they are kept
+ * until LALInferenceDestroyAutoCorrPlans() is called.
+ */
+#define ACF_MAX_LOG2_LENGTH 30
+static REAL8FFTPlan *acfForwardPlans[ACF_MAX_LOG2_LENGTH + 1];
+static REAL8FFTPlan *acfReversePlans[ACF_MAX_LOG2_LENGTH + 1];
+
+static INT4 LALInferenceGetAutoCorrPlans(UINT4 log2len, const REAL8FFTPlan **fwdplan, const REAL8FFTPlan **revplan) {
+    INT4 status = XLAL_SUCCESS;
+
+    #pragma omp critical (LALInferenceAutoCorrPlans)
+    {
+        if (!acfForwardPlans[log2len])
+            acfForwardPlans[log2len] = XLALCreateForwardREAL8FFTPlan(1U << log2len, 1);
+        if (!acfReversePlans[log2len])
+            acfReversePlans[log2len] = XLALCreateReverseREAL8FFTPlan(1U << log2len, 1);
+        if (!acfForwardPlans[log2len] || !acfReversePlans[log2len])
+            status = XLAL_FAILURE;
+        *fwdplan = acfForwardPlans[log2len];
+        *revplan = acfReversePlans[log2len];
+    }
+
+    return status;
+}
+
 /**
- * Compute the maximum single-parameter autocorrelation length.  Each
+ * Free the FFT plans cached by LALInferenceComputeAutoCorrelationFunctions().
+ * Must not be called while another thread is computing autocorrelations.
+ */
+void LALInferenceDestroyAutoCorrPlans(void) {
+    UINT4 i;
+
+    #pragma omp critical (LALInferenceAutoCorrPlans)
+    {
+        for (i = 0; i <= ACF_MAX_LOG2_LENGTH; i++) {
+            XLALDestroyREAL8FFTPlan(acfForwardPlans[i]);
+            XLALDestroyREAL8FFTPlan(acfReversePlans[i]);
+            acfForwardPlans[i] = NULL;
+            acfReversePlans[i] = NULL;
+        }
+    }
+}
+
+/**
+ * Compute the normalised autocorrelation functions of all parameters.
+ *
+ * Each parameter's mean-subtracted samples are zero-padded to a power of
+ * two at least twice their length, and the ACF is obtained from the
+ * inverse FFT of the power spectrum, at a cost of O(N log N) per parameter
+ * for all lags.  The standard estimator
+ *
+ * ACF(s) = sum_i x_i x_{i+s} / sum_i x_i^2
+ *
+ * is used, with the sums over all available samples.  A parameter with
+ * zero variance gets an ACF of NaN.  The FFT plans are cached across calls,
+ * and the function may be called from several threads at once.
+ *
+ * @param acf Output array of nPar rows of nLags values; the ACF of
+ *            parameter p at lag s is stored in acf[p*nLags + s].
+ * @param array Array with rows containing samples.
+ * @param nPoints Number of samples (rows).
+ * @param nPar Number of parameters (columns).
+ * @param nLags Number of lags to compute, at most nPoints.
+ * @return XLAL_SUCCESS, or XLAL_FAILURE on error
+ */
+INT4 LALInferenceComputeAutoCorrelationFunctions(REAL8 *acf, const REAL8 *array, INT4 nPoints, INT4 nPar, INT4 nLags) {
+    const REAL8FFTPlan *fwdplan = NULL, *revplan = NULL;
+    REAL8Vector *series = NULL;
+    COMPLEX16Vector *spectrum = NULL;
+    UINT4 log2len, len, k;
+    INT4 par, i;
+    REAL8 mean, norm;
+
+    XLAL_CHECK(acf && array, XLAL_EFAULT);
+    XLAL_CHECK(nPoints > 0 && nPar > 0 && nLags > 0 && nLags <= nPoints, XLAL_EINVAL);
+
+    /* pad to at least 2*nPoints so the circular correlation does not wrap */
+    for (log2len = 1; log2len < ACF_MAX_LOG2_LENGTH && (1U << log2len) < 2 * (UINT4)nPoints; log2len++);
+    len = 1U << log2len;
+    XLAL_CHECK(len >= 2 * (UINT4)nPoints, XLAL_EINVAL, "too many samples: %d", nPoints);
+
+    XLAL_CHECK(LALInferenceGetAutoCorrPlans(log2len, &fwdplan, &revplan) == XLAL_SUCCESS, XLAL_EFUNC);
+    series = XLALCreateREAL8Vector(len);
+    spectrum = XLALCreateCOMPLEX16Vector(len / 2 + 1);
+    if (!series || !spectrum) {
+        XLALDestroyREAL8Vector(series);
+        XLALDestroyCOMPLEX16Vector(spectrum);
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    for (par = 0; par < nPar; par++) {
+        mean = gsl_stats_mean(array + par, nPar, nPoints);
+        for (i = 0; i < nPoints; i++)
+            series->data[i] = array[i*nPar + par] - mean;
+        memset(series->data + nPoints, 0, (len - nPoints) * sizeof(REAL8));
+
+        if (XLALREAL8ForwardFFT(spectrum, series, fwdplan) != XLAL_SUCCESS)
+            break;
+        for (k = 0; k < spectrum->length; k++)
+            spectrum->data[k] = creal(spectrum->data[k]) * creal(spectrum->data[k]) + cimag(spectrum->data[k]) * cimag(spectrum->data[k]);
+        if (XLALREAL8ReverseFFT(series, spectrum, revplan) != XLAL_SUCCESS)
+            break;
+
+        norm = series->data[0];
+        for (i = 0; i < nLags; i++)
+            acf[par*nLags + i] = series->data[i] / norm;
+    }
+
+    XLALDestroyREAL8Vector(series);
+    XLALDestroyCOMPLEX16Vector(spectrum);
+    XLAL_CHECK(par == nPar, XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Compute the maximum single-parameter autocorrelation length.
+ *
+ * The ACFs of all parameters are computed in one batch with
+ * LALInferenceComputeAutoCorrelationFunctions(), and each parameter's
+ * ACL is then found with Sokal's automatic windowing:  the ACL is the
+ * smallest s such that
+ *
+ * 1 + 2*ACF(1) + 2*ACF(2) + ... + 2*ACF(M*s) < s,
+ *
+ * i.e. the ACF is summed over a window at least M times the resulting
+ * ACL.  The window is restricted to N/K lags, as a safety precaution
+ * against relying on the noisy ACF at the extreme lags; if no estimate
+ * is obtained within it, Infinity is returned.  M = 5 and K = 2.
+ *
+ * The result agrees with LALInferenceComputeMaxAutoCorrLenDirect(), up to
+ * the difference between the global ACF estimator used here and the
+ * per-lag correlation coefficients used there.
+ *
+ * @param array Array with rows containing samples.
+ * @param nPoints Number of samples (rows).
+ * @param nPar Number of parameters (columns).
+ * @return The maximum one-dimensional autocorrelation length
+*/
+REAL8 LALInferenceComputeMaxAutoCorrLen(REAL8 *array, INT4 nPoints, INT4 nPar) {
+    INT4 M=5, K=2;
+
+    REAL8 ACL, maxACL=0;
+    INT4 par=0, lag=0, imax, nLags;
+    REAL8 cumACF, s;
+    REAL8 *acf;
+
+    if (nPoints <= 1)
+        return INFINITY;
+
+    imax = nPoints/K;
+    nLags = imax + 1;
+    acf = XLALMalloc(nPar * nLags * sizeof(REAL8));
+    XLAL_CHECK_REAL8(acf, XLAL_ENOMEM);
+    if (LALInferenceComputeAutoCorrelationFunctions(acf, array, nPoints, nPar, nLags) != XLAL_SUCCESS) {
+        XLALFree(acf);
+        XLAL_ERROR_REAL8(XLAL_EFUNC);
+    }
+
+    for (par=0; par<nPar; par++) {
+        const REAL8 *this_acf = acf + par*nLags;
+
+        lag=1;
+        s=1.0/(REAL8)M;
+        cumACF=1.0;
+        while (cumACF >= s) {
+            cumACF += 2.0 * this_acf[lag];
+            lag++;
+            s = (REAL8)lag/(REAL8)M;
+            if (lag > imax) {
+                maxACL = INFINITY; /* this parameter has indeterminate ACL */
+                break;
+            }
+        }
+        if (maxACL == INFINITY)
+            break;
+        ACL = cumACF;
+
+        if (ACL > maxACL)
+            maxACL = ACL;
+        else if (gsl_isnan(ACL)) {
+            maxACL = INFINITY; /* this parameter has indeterminate ACL */
+            break;
+        }
+    }
+
+    XLALFree(acf);
+    return maxACL;
+}
+
+/**
+ * Compute the maximum single-parameter autocorrelation length by direct
+ * summation.  This is the original O(N*lag) estimator, which evaluates
+ * the correlation at each lag separately with gsl_stats_correlation();
+ * it is kept to validate LALInferenceComputeMaxAutoCorrLen().  Each
  * parameter's ACL is the smallest s such that
  *
  * 1 + 2*ACF(1) + 2*ACF(2) + ... + 2*ACF(M*s) < s,
@@ -3534,7 +3746,7 @@ void LALInferenceComputeMaxAutoCorrLenFromDE(LALInferenceThreadState *thread, IN
  * @param nPar UNDOCUMENTED
  * @return The maximum one-dimensional autocorrelation length
 */
-REAL8 LALInferenceComputeMaxAutoCorrLen(REAL8 *array, INT4 nPoints, INT4 nPar) {
+REAL8 LALInferenceComputeMaxAutoCorrLenDirect(REAL8 *array, INT4 nPoints, INT4 nPar) {
     INT4 M=5, K=2;
 
     REAL8 mean, ACL, ACF, maxACL=0;
@@ -314,9 +314,18 @@ void LALInferenceDumpClusteredKDEDraws(LALInferenceClusteredKDE *kde, char *outp
 /* Compute the maximum ACL from the differential evolution buffer. */
 void LALInferenceComputeMaxAutoCorrLenFromDE(LALInferenceThreadState *thread, INT4* maxACL);
 
+/* Compute the normalised autocorrelation functions of all parameters with FFTs. */
+INT4 LALInferenceComputeAutoCorrelationFunctions(REAL8 *acf, const REAL8 *array, INT4 nPoints, INT4 nPar, INT4 nLags);
+
+/* Free the FFT plans cached by LALInferenceComputeAutoCorrelationFunctions(). */
+void LALInferenceDestroyAutoCorrPlans(void);
+
 /* Compute the maximum single-parameter autocorrelation length. */
 REAL8 LALInferenceComputeMaxAutoCorrLen(REAL8 *array, INT4 nPoints, INT4 nPar);
 
+/* Compute the maximum single-parameter autocorrelation length by direct summation, for validation. */
+REAL8 LALInferenceComputeMaxAutoCorrLenDirect(REAL8 *array, INT4 nPoints, INT4 nPar);
+
 /* Update the estimatate of the autocorrelation length. */
 void LALInferenceUpdateMaxAutoCorrLen(LALInferenceThreadState *thread);
 
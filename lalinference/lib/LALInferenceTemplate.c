@@ -388,7 +388,7 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
     gamma2 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma2");
     gamma3 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma3");
     // Find lambda1,2(m1,2|eos)
-    LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
+    LALInferenceLogp1GammasMasses2LambdasCached(model->eos_cache,logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
     XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
     XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
   }
@@ -407,7 +407,7 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
     SDgamma2 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma2");
     SDgamma3 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma3");
     REAL8 gamma[] = {SDgamma0,SDgamma1,SDgamma2,SDgamma3};
-    LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
+    LALInferenceSDGammasMasses2LambdasCached(model->eos_cache,gamma,m1,m2,&lambda1,&lambda2,4);
     XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
     XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
   }
@@ -923,7 +923,7 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveform(LALInferenceModel *model)
     gamma2 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma2");
     gamma3 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma3");
     // Find lambda1,2(m1,2|eos)
-    LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
+    LALInferenceLogp1GammasMasses2LambdasCached(model->eos_cache,logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
     XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
     XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
   }
@@ -942,7 +942,7 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveform(LALInferenceModel *model)
     SDgamma2 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma2");
     SDgamma3 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma3");
     REAL8 gamma[] = {SDgamma0,SDgamma1,SDgamma2,SDgamma3};
-    LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
+    LALInferenceSDGammasMasses2LambdasCached(model->eos_cache,gamma,m1,m2,&lambda1,&lambda2,4);
     XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
     XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
   }
@@ -1465,7 +1465,7 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveformPhaseInterpolated(LALInfer
       gamma2 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma2");
       gamma3 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma3");
       // Find lambda1,2(m1,2|eos)
-      LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
+      LALInferenceLogp1GammasMasses2LambdasCached(model->eos_cache,logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
       XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
       XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
     }
@@ -1483,7 +1483,7 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveformPhaseInterpolated(LALInfer
       SDgamma2 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma2");
       SDgamma3 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma3");
       REAL8 gamma[] = {SDgamma0,SDgamma1,SDgamma2,SDgamma3};
-      LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
+      LALInferenceSDGammasMasses2LambdasCached(model->eos_cache,gamma,m1,m2,&lambda1,&lambda2,4);
       XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
       XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
     }
@@ -3,6 +3,8 @@
 #include <lal/XLALGSL.h>
 #include <gsl/gsl_randist.h>
 
+#include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
 
@@ -31,6 +33,12 @@ double real_model(double frequency, double Mchirp, double modperiod);
 /* model for a complex frequency domain inspiral-like signal */
 COMPLEX16 imag_model(double frequency, double Mchirp, double modperiod);
 
+/* check whether two real reduced bases are the same */
+int compare_real_bases(const REAL8Array *RB1, const UINT4Vector *gp1, const REAL8Array *RB2, const UINT4Vector *gp2);
+
+/* check whether two complex reduced bases are the same */
+int compare_complex_bases(const COMPLEX16Array *RB1, const UINT4Vector *gp1, const COMPLEX16Array *RB2, const UINT4Vector *gp2);
+
 double calc_phase(double frequency, double Mchirp){
   return (-0.25*LAL_PI + ( 3./( 128. * pow(Mchirp*LAL_MTSUN_SI*LAL_PI*frequency, 5./3.) ) ) );
 }
@@ -43,6 +51,24 @@ COMPLEX16 imag_model(double frequency, double Mchirp, double modperiod){
   return ( pow(frequency, -7./6.) * pow(Mchirp*LAL_MTSUN_SI,5./6.) * cexp(I*calc_phase(frequency,Mchirp)) )*sin(LAL_TWOPI*frequency/modperiod);
 }
 
+int compare_real_bases(const REAL8Array *RB1, const UINT4Vector *gp1, const REAL8Array *RB2, const UINT4Vector *gp2){
+  if ( RB1->dimLength->data[0] != RB2->dimLength->data[0] || gp1->length != gp2->length ){ return 1; }
+  if ( memcmp(gp1->data, gp2->data, gp1->length*sizeof(UINT4)) != 0 ){ return 1; }
+  for ( size_t k=0; k < RB1->dimLength->data[0]*RB1->dimLength->data[1]; k++ ){
+    if ( fabs(RB1->data[k] - RB2->data[k]) > 1e-8 ){ return 1; }
+  }
+  return 0;
+}
+
+int compare_complex_bases(const COMPLEX16Array *RB1, const UINT4Vector *gp1, const COMPLEX16Array *RB2, const UINT4Vector *gp2){
+  if ( RB1->dimLength->data[0] != RB2->dimLength->data[0] || gp1->length != gp2->length ){ return 1; }
+  if ( memcmp(gp1->data, gp2->data, gp1->length*sizeof(UINT4)) != 0 ){ return 1; }
+  for ( size_t k=0; k < RB1->dimLength->data[0]*RB1->dimLength->data[1]; k++ ){
+    if ( cabs(RB1->data[k] - RB2->data[k]) > 1e-8 ){ return 1; }
+  }
+  return 0;
+}
+
 int main(void) {
   REAL8Array *TS = NULL, *TSquad = NULL, *cTSquad = NULL;  /* the training set of real waveforms (and quadratic model) */
   COMPLEX16Array *cTS = NULL;              /* the training set of complex waveforms */
@@ -120,12 +146,86 @@ int main(void) {
     }
   }
 
+  /* copies of the training sets for testing checkpointing (as the training sets get normalised) */
+  REAL8Array *TSckpt = XLALCreateREAL8Array( TS->dimLength );
+  REAL8Array *TSresume = XLALCreateREAL8Array( TS->dimLength );
+  REAL8Array *TSother = XLALCreateREAL8Array( TS->dimLength );
+  REAL8Array *TStol = XLALCreateREAL8Array( TS->dimLength );
+  memcpy( TSckpt->data, TS->data, TSsize*wl*sizeof(REAL8) );
+  memcpy( TSresume->data, TS->data, TSsize*wl*sizeof(REAL8) );
+  memcpy( TSother->data, TS->data, TSsize*wl*sizeof(REAL8) );
+  memcpy( TStol->data, TS->data, TSsize*wl*sizeof(REAL8) );
+  TSother->data[wl+1] *= 1.5; /* a slightly different training set */
+  COMPLEX16Array *cTSckpt = XLALCreateCOMPLEX16Array( cTS->dimLength );
+  COMPLEX16Array *cTSresume = XLALCreateCOMPLEX16Array( cTS->dimLength );
+  memcpy( cTSckpt->data, cTS->data, TSsize*wl*sizeof(COMPLEX16) );
+  memcpy( cTSresume->data, cTS->data, TSsize*wl*sizeof(COMPLEX16) );
+
   /* create reduced orthonormal basis from training set for linear part */
   REAL8 maxprojerr = 0.;
   maxprojerr = LALInferenceGenerateREAL8OrthonormalBasis(&RBlinear, fweights, tolerance, &TS, &gdpts);
-  XLALDestroyUINT4Vector( gdpts );
   fprintf(stderr, "No. linear nodes (real) = %d, %d x %d; Maximum projection err. = %le\n", RBlinear->dimLength->data[0], RBlinear->dimLength->data[0], RBlinear->dimLength->data[1], maxprojerr);
+
+  /* create the same basis while checkpointing, and then resume from the last checkpoint */
+  {
+    const CHAR *ckptfile = "LALInferenceGenerateROQTest.ckpt";
+    REAL8Array *RBckpt = NULL, *RBresume = NULL;
+    UINT4Vector *gdptsckpt = NULL, *gdptsresume = NULL;
+    remove( ckptfile );
+    LALInferenceGenerateREAL8OrthonormalBasisCheckpoint(&RBckpt, fweights, tolerance, &TSckpt, &gdptsckpt, ckptfile, 3);
+    LALInferenceGenerateREAL8OrthonormalBasisCheckpoint(&RBresume, fweights, tolerance, &TSresume, &gdptsresume, ckptfile, 0);
+    if ( compare_real_bases(RBlinear, gdpts, RBckpt, gdptsckpt) || compare_real_bases(RBlinear, gdpts, RBresume, gdptsresume) ){
+      fprintf(stderr, "Checkpointed reduced basis differs from original basis\n");
+      return 1;
+    }
+    XLALDestroyREAL8Array( RBresume );
+    XLALDestroyUINT4Vector( gdptsresume );
+
+    /* the checkpoint must not be used to resume with another training set or tolerance */
+    int errnum;
+    XLAL_TRY_SILENT( LALInferenceGenerateREAL8OrthonormalBasisCheckpoint(&RBresume, fweights, tolerance, &TSother, &gdptsresume, ckptfile, 0), errnum );
+    if ( (errnum & ~XLAL_EFUNC) != XLAL_EINVAL || RBresume != NULL || gdptsresume != NULL ){
+      fprintf(stderr, "Checkpoint was not rejected for a different training set\n");
+      return 1;
+    }
+    XLAL_TRY_SILENT( LALInferenceGenerateREAL8OrthonormalBasisCheckpoint(&RBresume, fweights, 2.*tolerance, &TStol, &gdptsresume, ckptfile, 0), errnum );
+    if ( (errnum & ~XLAL_EFUNC) != XLAL_EINVAL || RBresume != NULL || gdptsresume != NULL ){
+      fprintf(stderr, "Checkpoint was not rejected for a different tolerance\n");
+      return 1;
+    }
+    remove( ckptfile );
+
+    XLALDestroyREAL8Array( RBckpt );
+    XLALDestroyUINT4Vector( gdptsckpt );
+    XLALDestroyREAL8Array( TSckpt );
+    XLALDestroyREAL8Array( TSresume );
+    XLALDestroyREAL8Array( TSother );
+    XLALDestroyREAL8Array( TStol );
+  }
+  XLALDestroyUINT4Vector( gdpts );
+
   maxprojerr = LALInferenceGenerateCOMPLEX16OrthonormalBasis(&cRBlinear, fweights, tolerance, &cTS, &gdpts);
+
+  /* the same for the complex basis */
+  {
+    const CHAR *ckptfile = "LALInferenceGenerateROQTest.ckpt";
+    COMPLEX16Array *cRBckpt = NULL, *cRBresume = NULL;
+    UINT4Vector *gdptsckpt = NULL, *gdptsresume = NULL;
+    remove( ckptfile );
+    LALInferenceGenerateCOMPLEX16OrthonormalBasisCheckpoint(&cRBckpt, fweights, tolerance, &cTSckpt, &gdptsckpt, ckptfile, 3);
+    LALInferenceGenerateCOMPLEX16OrthonormalBasisCheckpoint(&cRBresume, fweights, tolerance, &cTSresume, &gdptsresume, ckptfile, 0);
+    remove( ckptfile );
+    if ( compare_complex_bases(cRBlinear, gdpts, cRBckpt, gdptsckpt) || compare_complex_bases(cRBlinear, gdpts, cRBresume, gdptsresume) ){
+      fprintf(stderr, "Checkpointed complex reduced basis differs from original basis\n");
+      return 1;
+    }
+    XLALDestroyCOMPLEX16Array( cRBckpt );
+    XLALDestroyCOMPLEX16Array( cRBresume );
+    XLALDestroyUINT4Vector( gdptsckpt );
+    XLALDestroyUINT4Vector( gdptsresume );
+    XLALDestroyCOMPLEX16Array( cTSckpt );
+    XLALDestroyCOMPLEX16Array( cTSresume );
+  }
   XLALDestroyUINT4Vector( gdpts );
   fprintf(stderr, "No. linear nodes (complex) = %d, %d x %d; Maximum projection err. = %le\n", cRBlinear->dimLength->data[0], cRBlinear->dimLength->data[0], cRBlinear->dimLength->data[1], maxprojerr);
   maxprojerr = LALInferenceGenerateREAL8OrthonormalBasis(&RBquad, fweights, tolerance, &TSquad, &gdpts);
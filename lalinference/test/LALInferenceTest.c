@@ -37,6 +37,13 @@
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceTemplate.h>
 #include <lal/LALInferencePrior.h>
+#include <lal/LALInferenceProposal.h>
+#include <lal/LALInferenceKDE.h>
+#include <lal/LALInferenceNestedSampler.h>
+#include <lal/StringVector.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
 
 #include "LALInferenceTest.h"
 
@@ -59,6 +66,15 @@ int LALInferenceProcessParamLine_TEST_CHARFILE(void);
 /*  LALInferenceExecuteFT tests */
 int LALInferenceExecuteFTTEST_NULLPLAN(void);
 
+/*  LALInferenceComputeMaxAutoCorrLen tests */
+int LALInferenceComputeMaxAutoCorrLenTEST_AR1(void);
+
+/*  LALInferenceKDEEvaluatePoint tests */
+int LALInferenceKDEEvaluatePointTEST_TRUNCATED(void);
+
+/*  LALInferenceNestedSamplingAlgorithm tests */
+int LALInferenceNestedSamplingAlgorithmTEST_GAUSSIAN(void);
+
 int main(void){
     
 	int failureCount = 0;
@@ -77,6 +93,12 @@ int main(void){
 	printf("\n");
 	failureCount += LALInferenceExecuteFTTEST_NULLPLAN();
 	printf("\n");
+	failureCount += LALInferenceComputeMaxAutoCorrLenTEST_AR1();
+	printf("\n");
+	failureCount += LALInferenceKDEEvaluatePointTEST_TRUNCATED();
+	printf("\n");
+	failureCount += LALInferenceNestedSamplingAlgorithmTEST_GAUSSIAN();
+	printf("\n");
 	printf("Test results: %i failure(s).\n", failureCount);
 
 	return failureCount;
@@ -357,6 +379,232 @@ int LALInferenceExecuteFTTEST_NULLPLAN(void){
 }
 
 
+
+
+/*****************     TEST CODE for LALInferenceComputeMaxAutoCorrLen     *****************/
+/* Test the FFT autocorrelation length estimator on AR(1) chains, whose ACL */
+/* (1+phi)/(1-phi) is known, and against the direct-summation estimator. */
+
+int LALInferenceComputeMaxAutoCorrLenTEST_AR1(void){
+
+    TEST_HEADER();
+
+    const INT4 nPoints = 20000, nPar = 2;
+    const REAL8 phi[2] = {0.5, 0.9};
+    const REAL8 expected = (1.0 + phi[1]) / (1.0 - phi[1]);
+    REAL8 *array = XLALMalloc(nPoints * nPar * sizeof(REAL8));
+    REAL8 *acf = XLALMalloc(nPar * 2 * sizeof(REAL8));
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    REAL8 fftACL, directACL;
+    INT4 i, j;
+
+    gsl_rng_set(rng, 42);
+    for (j = 0; j < nPar; j++) {
+        array[j] = gsl_ran_gaussian(rng, 1.0);
+        for (i = 1; i < nPoints; i++)
+            array[i*nPar + j] = phi[j] * array[(i-1)*nPar + j] + gsl_ran_gaussian(rng, 1.0);
+    }
+
+    if (LALInferenceComputeAutoCorrelationFunctions(acf, array, nPoints, nPar, 2) != XLAL_SUCCESS) {
+        TEST_FAIL("Could not compute autocorrelation functions.");
+    } else {
+        for (j = 0; j < nPar; j++) {
+            if (!compareFloats(acf[2*j], 1.0, 1e-12))
+                TEST_FAIL("ACF(0) of parameter %d is %g, not 1.", j, acf[2*j]);
+            if (!compareFloats(acf[2*j + 1], phi[j], 0.05))
+                TEST_FAIL("ACF(1) of parameter %d is %g, expected %g.", j, acf[2*j + 1], phi[j]);
+        }
+    }
+
+    fftACL = LALInferenceComputeMaxAutoCorrLen(array, nPoints, nPar);
+    directACL = LALInferenceComputeMaxAutoCorrLenDirect(array, nPoints, nPar);
+    if (!compareFloats(fftACL, expected, 0.4 * expected))
+        TEST_FAIL("FFT ACL is %g, expected %g.", fftACL, expected);
+    if (!compareFloats(fftACL, directACL, 0.05 * directACL))
+        TEST_FAIL("FFT ACL %g does not match direct ACL %g.", fftACL, directACL);
+
+    /* too few samples to estimate an ACL */
+    if (LALInferenceComputeMaxAutoCorrLen(array, 1, nPar) != INFINITY)
+        TEST_FAIL("ACL of a single sample should be infinite.");
+
+    gsl_rng_free(rng);
+    XLALFree(acf);
+    XLALFree(array);
+    LALInferenceDestroyAutoCorrPlans();
+
+    TEST_FOOTER();
+
+}
+
+
+/*****************     TEST CODE for LALInferenceKDEEvaluatePoint     *****************/
+/* Compare the kD-tree evaluation of a truncated KDE of correlated Gaussian */
+/* samples in 15 dimensions with the exact sum over all kernels, at points */
+/* drawn from the KDE itself as the clustered-KDE proposals do. */
+
+int LALInferenceKDEEvaluatePointTEST_TRUNCATED(void){
+
+    TEST_HEADER();
+
+    const INT4 nPoints = 2000, dim = 15, nDraws = 200;
+    REAL8 *pts = XLALMalloc(nPoints * dim * sizeof(REAL8));
+    REAL8 *point;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    REAL8 exact, truncated;
+    INT4 i, j;
+
+    gsl_rng_set(rng, 42);
+    for (i = 0; i < nPoints; i++) {
+        REAL8 x = gsl_ran_gaussian(rng, 1.0);
+        for (j = 0; j < dim; j++)
+            pts[i*dim + j] = (j % 2 ? 0.8 * x : 0.0) + gsl_ran_gaussian(rng, 0.5 + j);
+    }
+    LALInferenceKDE *kde = LALInferenceNewKDE(pts, nPoints, dim, NULL);
+
+    for (i = 0; i <= nDraws; i++) {
+        point = LALInferenceDrawKDESample(kde, rng);
+        if (i == nDraws)
+            point[2] += 200.0; /* no kernel within the truncation radius */
+
+        LALInferenceSetKDETruncation(kde, 0.0);
+        exact = LALInferenceKDEEvaluatePoint(kde, point);
+        LALInferenceSetKDETruncation(kde, 5.0);
+        truncated = LALInferenceKDEEvaluatePoint(kde, point);
+
+        if (isinf(exact) && i < nDraws)
+            TEST_FAIL("Exact KDE at draw %d is %g.", i, exact);
+        if (!(truncated == exact || compareFloats(truncated, exact, 1e-5)))
+            TEST_FAIL("Truncated KDE %g does not match exact KDE %g at draw %d.", truncated, exact, i);
+
+        XLALFree(point);
+    }
+
+    gsl_rng_free(rng);
+    LALInferenceDestroyKDE(kde);
+    XLALFree(pts);
+
+    TEST_FOOTER();
+
+}
+
+
+/*****************     TEST CODE for LALInferenceNestedSamplingAlgorithm     *****************/
+/* Run the nested sampler on a 2-D Gaussian likelihood in a uniform prior box, whose */
+/* evidence is known analytically, replacing one live point per iteration on a single */
+/* thread and several per iteration in parallel on four threads. */
+
+#define NS_TEST_SIGMA 0.5
+#define NS_TEST_HALFWIDTH 5.0
+#define NS_TEST_NLIVE "200"
+
+static const char *const nsTestNames[2] = {"x", "y"};
+
+static REAL8 NSTestLogLikelihood(LALInferenceVariables *currentParams, LALInferenceIFOData UNUSED *data, LALInferenceModel UNUSED *model)
+{
+    REAL8 r2 = 0.0;
+    for (INT4 i = 0; i < 2; i++) {
+        REAL8 x = LALInferenceGetREAL8Variable(currentParams, nsTestNames[i]);
+        r2 += x * x;
+    }
+    return -r2 / (2.0 * NS_TEST_SIGMA * NS_TEST_SIGMA);
+}
+
+static REAL8 NSTestLogPrior(LALInferenceRunState *runState, LALInferenceVariables *params, LALInferenceModel UNUSED *model)
+{
+    REAL8 min, max, x;
+    for (INT4 i = 0; i < 2; i++) {
+        LALInferenceGetMinMaxPrior(runState->priorArgs, nsTestNames[i], &min, &max);
+        x = LALInferenceGetREAL8Variable(params, nsTestNames[i]);
+        if (x < min || x > max)
+            return -INFINITY;
+    }
+    return 0.0;
+}
+
+/* Set up a run state for the Gaussian likelihood as LALInferenceNest does, */
+/* run the nested sampler on nthreads threads, and return the log evidence */
+static REAL8 NSTestRun(INT4 nthreads, const char *outfile)
+{
+    LALStringVector *args = XLALCreateStringVector("LALInferenceTest", "--Nlive", NS_TEST_NLIVE,
+                                                   "--Nmcmcinitial", "100", "--maxmcmc", "100",
+                                                   "--outfile", outfile, NULL);
+    LALInferenceRunState *runState = XLALCalloc(1, sizeof(LALInferenceRunState));
+    runState->commandLine = LALInferenceParseStringVector(args);
+    XLALDestroyStringVector(args);
+    runState->algorithmParams = XLALCalloc(1, sizeof(LALInferenceVariables));
+    runState->priorArgs = XLALCalloc(1, sizeof(LALInferenceVariables));
+    runState->proposalArgs = XLALCalloc(1, sizeof(LALInferenceVariables));
+    runState->prior = &NSTestLogPrior;
+    runState->likelihood = &NSTestLogLikelihood;
+    runState->GSLrandom = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(runState->GSLrandom, 42);
+
+    REAL8 min = -NS_TEST_HALFWIDTH, max = NS_TEST_HALFWIDTH;
+    for (INT4 i = 0; i < 2; i++)
+        LALInferenceAddMinMaxPrior(runState->priorArgs, nsTestNames[i], &min, &max, LALINFERENCE_REAL8_t);
+
+    runState->nthreads = nthreads;
+    runState->threads = LALInferenceInitThreads(nthreads);
+    for (INT4 t = 0; t < nthreads; t++) {
+        LALInferenceThreadState *thread = &runState->threads[t];
+        thread->parent = runState;
+        thread->model = XLALCalloc(1, sizeof(LALInferenceModel));
+        for (INT4 i = 0; i < 2; i++)
+            LALInferenceAddREAL8Variable(thread->currentParams, nsTestNames[i], 0.0, LALINFERENCE_PARAM_LINEAR);
+        thread->priorArgs = runState->priorArgs;
+        thread->GSLrandom = gsl_rng_alloc(gsl_rng_mt19937);
+        gsl_rng_set(thread->GSLrandom, gsl_rng_get(runState->GSLrandom));
+        thread->cycle = LALInferenceInitProposalCycle();
+        LALInferenceAddProposalToCycle(thread->cycle, LALInferenceInitProposal(&LALInferenceCovarianceEigenvectorJump, "CovarianceEigenvectorJump"), 1);
+        LALInferenceAddProposalToCycle(thread->cycle, LALInferenceInitProposal(&LALInferenceDifferentialEvolutionFull, "DifferentialEvolutionFull"), 1);
+    }
+
+    LALInferenceNestedSamplingAlgorithmInit(runState);
+    LALInferenceAddREAL8Variable(runState->algorithmParams, "logZnoise", 0.0, LALINFERENCE_PARAM_FIXED);
+    LALInferenceSetupLivePointsArray(runState);
+
+    runState->algorithm(runState);
+    REAL8 logZ = LALInferenceGetREAL8Variable(runState->algorithmParams, "logZ");
+
+    for (INT4 t = 0; t < nthreads; t++) {
+        LALInferenceThreadState *thread = &runState->threads[t];
+        for (INT4 i = 0; i < thread->cycle->nProposals; i++)
+            XLALFree(thread->cycle->proposals[i]);
+        LALInferenceDeleteProposalCycle(thread->cycle);
+        XLALFree(thread->cycle);
+        XLALFree(thread->model);
+        gsl_rng_free(thread->GSLrandom);
+    }
+    gsl_rng_free(runState->GSLrandom);
+
+    return logZ;
+}
+
+int LALInferenceNestedSamplingAlgorithmTEST_GAUSSIAN(void){
+
+    TEST_HEADER();
+
+    /* the prior box extends to 10 sigma, so the evidence is the Gaussian */
+    /* normalisation over the prior volume */
+    const REAL8 expected = log(LAL_TWOPI * NS_TEST_SIGMA * NS_TEST_SIGMA / (4.0 * NS_TEST_HALFWIDTH * NS_TEST_HALFWIDTH));
+    /* the statistical error of logZ is sqrt(H/Nlive) ~ 0.13, with the information H ~ 3 */
+    const REAL8 tolerance = 0.5;
+    const INT4 nthreads[2] = {1, 4};
+    const char *outfiles[2] = {"LALInferenceTest_nest1.dat", "LALInferenceTest_nest4.dat"};
+
+    for (INT4 i = 0; i < 2; i++) {
+        remove(outfiles[i]);
+        REAL8 logZ = NSTestRun(nthreads[i], outfiles[i]);
+        printf("Nested sampling on %d thread(s): logZ = %g, expected %g\n", nthreads[i], logZ, expected);
+        if (!compareFloats(logZ, expected, tolerance))
+            TEST_FAIL("logZ = %g on %d thread(s), expected %g.", logZ, nthreads[i], expected);
+    }
+
+    TEST_FOOTER();
+
+}
+
+
 /******************************************
  * 
  * Old tests
@@ -20,6 +20,7 @@
 #include <string.h>
 #include <math.h>
 #include <complex.h>
+#include <lal/LALMalloc.h>
 #include <lal/AVFactories.h>
 #include <lal/ComplexFFT.h>
 #include <lal/XLALError.h>
@@ -27,6 +28,10 @@
 #include <lal/LALInspiralSBankOverlap.h>
 #include <sys/types.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define MAX_NUM_WS 32  /* maximum number of workspaces */
 #define CHECK_OOM(ptr, msg) if (!(ptr)) { XLALPrintError((msg)); XLAL_ERROR_NULL(XLAL_ENOMEM); }
 
@@ -112,6 +117,26 @@ static double vector_peak_interp(const double ym1, const double y, const double
     return y + 0.5 * dy * dy / d2y;
 }
 
+/* maximize |z(t)|^2 and refine the estimate of the maximum */
+static double max_abs2_interp(const COMPLEX8 *zdata, const size_t n) {
+    size_t k = n;
+    ssize_t argmax = -1;
+    REAL8 max = 0.;
+    for (;k--;) {
+        REAL8 temp = abs2(zdata[k]);
+        if (temp > max) {
+            argmax = k;
+            max = temp;
+        }
+    }
+    if (max == 0.) return 0.;
+
+    /* refine estimate of maximum */
+    if (argmax == 0 || argmax == (ssize_t) n - 1)
+        return max;
+    return vector_peak_interp(abs2(zdata[argmax - 1]), abs2(zdata[argmax]), abs2(zdata[argmax + 1]));
+}
+
 /*
  * Returns the match for two whitened, normalized, positive-frequency
  * COMPLEX8FrequencySeries inputs.
@@ -134,25 +159,8 @@ REAL8 XLALInspiralSBankComputeMatch(const COMPLEX8FrequencySeries *inj, const CO
     XLALCOMPLEX8VectorFFT(ws->zt, ws->zf, ws->plan); /* plan is reverse */
 
     /* maximize over |z(t)|^2 */
-    COMPLEX8 *zdata = ws->zt->data;
-    size_t k = n;
-    ssize_t argmax = -1;
-    REAL8 max = 0.;
-    for (;k--;) {
-        REAL8 temp = abs2(zdata[k]);
-        if (temp > max) {
-            argmax = k;
-            max = temp;
-        }
-    }
-    if (max == 0.) return 0.;
-
-    /* refine estimate of maximum */
-    REAL8 result;
-    if (argmax == 0 || argmax == (ssize_t) n - 1)
-        result = max;
-    else
-        result = vector_peak_interp(abs2(zdata[argmax - 1]), abs2(zdata[argmax]), abs2(zdata[argmax + 1]));
+    REAL8 result = max_abs2_interp(ws->zt->data, n);
+    if (result == 0.) return 0.;
 
     /* compute match */
     /* return 4. * inj->deltaF * sqrt(result) / n; */  /* inverse FFT = reverse / n */
@@ -353,3 +361,144 @@ REAL8 XLALInspiralSBankComputeMatchMaxSkyLocNoPhase(const COMPLEX8FrequencySerie
     /* Return match */
     return 4. * proposal->deltaF * sqrt(max);
 }
+
+
+/*
+ * set up blocks of templates for batched match computations
+ */
+
+SBankTemplateBlock *XLALCreateSBankTemplateBlock(const size_t length) {
+    SBankTemplateBlock *block = XLALCalloc(1, sizeof(*block));
+    CHECK_OOM(block, "unable to allocate template block\n");
+    block->length = length;
+    if (length) {
+        block->data = XLALCalloc(length, sizeof(*block->data));
+        if (!block->data) {
+            XLALFree(block);
+            XLALPrintError("unable to allocate template block\n");
+            XLAL_ERROR_NULL(XLAL_ENOMEM);
+        }
+    }
+    return block;
+}
+
+void XLALDestroySBankTemplateBlock(SBankTemplateBlock *block) {
+    if (!block) return;
+    XLALFree(block->data);  /* templates are borrowed, not owned */
+    XLALFree(block);
+}
+
+int XLALSetSBankTemplateBlockEntry(SBankTemplateBlock *block, const size_t k, const COMPLEX8FrequencySeries *tmplt) {
+    XLAL_CHECK(block != NULL, XLAL_EFAULT);
+    XLAL_CHECK(k < block->length, XLAL_EINVAL, "index %zu out of range [0, %zu)", k, block->length);
+    XLAL_CHECK(tmplt != NULL && tmplt->data != NULL, XLAL_EFAULT);
+    block->data[k] = tmplt;
+    return XLAL_SUCCESS;
+}
+
+
+/*
+ * Computes the matches, as returned by XLALInspiralSBankComputeMatch(),
+ * between the proposal and each template in a block of bank templates.
+ *
+ * Before computing the complex SNR time series of a template, the
+ * time-maximized match is bounded from above by 4 df sum_f |h(f)| |p(f)|.
+ * If this bound is already below min_match, the inverse FFT is skipped and
+ * the bound is returned in place of the match. Set min_match <= 0 to
+ * compute every match.
+ *
+ * Inverse FFT plans are shared between templates of the same length, and
+ * the templates are processed in parallel if compiled with OpenMP.
+ */
+int XLALInspiralSBankComputeMatchBatch(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const SBankTemplateBlock *tmplts, const REAL8 min_match, WS *workspace_cache) {
+    XLAL_CHECK(matches != NULL && proposal != NULL && proposal->data != NULL && tmplts != NULL && workspace_cache != NULL, XLAL_EFAULT);
+    XLAL_CHECK(matches->length == tmplts->length, XLAL_EBADLEN, "matches has length %u but there are %zu templates", matches->length, tmplts->length);
+    const size_t num_tmplts = tmplts->length;
+    if (!num_tmplts) return XLAL_SUCCESS;
+
+    /* get workspaces (and thereby FFT plans) serially, as planning is not thread-safe */
+    WS **ws = XLALCalloc(num_tmplts, sizeof(*ws));
+    XLAL_CHECK(ws != NULL, XLAL_ENOMEM, "unable to allocate workspace pointers");
+    size_t max_n = 0;
+    for (size_t j = 0; j < num_tmplts; ++j) {
+        const COMPLEX8FrequencySeries *tmplt = tmplts->data[j];
+        if (!tmplt || !tmplt->data) {
+            XLALFree(ws);
+            XLAL_ERROR(XLAL_EFAULT, "template %zu has not been set", j);
+        }
+        size_t min_len = (proposal->data->length <= tmplt->data->length) ? proposal->data->length : tmplt->data->length;
+        size_t n = 2 * (min_len - 1);   /* no need to integrate implicit zeros */
+        ws[j] = get_workspace(workspace_cache, n);
+        if (!ws[j]) {
+            XLALFree(ws);
+            XLALPrintError("out of space in the workspace_cache\n");
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+        if (n > max_n) max_n = n;
+    }
+
+    /* |p(f)| for bounding the matches */
+    REAL4 *abs_prop = XLALMalloc(proposal->data->length * sizeof(*abs_prop));
+    if (!abs_prop) {
+        XLALFree(ws);
+        XLAL_ERROR(XLAL_ENOMEM, "unable to allocate |p(f)|");
+    }
+    for (size_t k = 0; k < proposal->data->length; ++k)
+        abs_prop[k] = cabsf(proposal->data->data[k]);
+
+    /* per-thread frequency- and time-domain buffers */
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    COMPLEX8 *buffers = XLALMalloc(2 * num_threads * max_n * sizeof(*buffers));
+    if (!buffers) {
+        XLALFree(abs_prop);
+        XLALFree(ws);
+        XLAL_ERROR(XLAL_ENOMEM, "unable to allocate FFT buffers");
+    }
+
+    int errnum = 0;
+    ssize_t j;
+#pragma omp parallel for schedule(dynamic)
+    for (j = 0; j < (ssize_t) num_tmplts; ++j) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        const COMPLEX8FrequencySeries *tmplt = tmplts->data[j];
+        const size_t n = ws[j]->n;
+        const size_t min_len = n / 2 + 1;
+
+        /* bound |z(t)| <= sum_f |h(f)| |p(f)| */
+        REAL8 bound = 0.;
+        for (size_t k = 0; k < min_len; ++k)
+            bound += abs_prop[k] * cabsf(tmplt->data->data[k]);
+        bound *= 4. * proposal->deltaF;
+        if (bound < min_match) {
+            matches->data[j] = bound;
+            continue;
+        }
+
+        /* compute complex SNR time-series in freq-domain, then time-domain */
+        COMPLEX8Vector zf = { .length = n, .data = buffers + 2 * thread * max_n };
+        COMPLEX8Vector zt = { .length = n, .data = zf.data + max_n };
+        multiply_conjugate(zf.data, tmplt->data->data, proposal->data->data, min_len);
+        memset(zf.data + min_len, 0, (n - min_len) * sizeof(*zf.data));
+        if (XLALCOMPLEX8VectorFFT(&zt, &zf, ws[j]->plan) != XLAL_SUCCESS) { /* plan is reverse */
+#pragma omp critical (XLALInspiralSBankComputeMatchBatch)
+            errnum = XLAL_EFUNC;
+            continue;
+        }
+
+        /* maximize over |z(t)|^2 and compute match */
+        matches->data[j] = 4. * proposal->deltaF * sqrt(max_abs2_interp(zt.data, n));
+    }
+
+    XLALFree(buffers);
+    XLALFree(abs_prop);
+    XLALFree(ws);
+    XLAL_CHECK(errnum == 0, errnum, "inverse FFT failed");
+
+    return XLAL_SUCCESS;
+}
@@ -11,6 +11,15 @@ typedef struct tagWS {
     COMPLEX8Vector *zt;
 } WS;
 
+/* a block of whitened, normalized templates, borrowed (not owned) by the block */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IGNORE_MEMBERS(tagSBankTemplateBlock, data));
+#endif /* SWIG */
+typedef struct tagSBankTemplateBlock {
+    size_t length;
+    const COMPLEX8FrequencySeries **data;
+} SBankTemplateBlock;
+
 WS *XLALCreateSBankWorkspaceCache(void);
 void XLALDestroySBankWorkspaceCache(WS *workspace_cache);
 REAL8 XLALInspiralSBankComputeMatch(const COMPLEX8FrequencySeries *inj, const COMPLEX8FrequencySeries *tmplt, WS *workspace_cache);
@@ -20,3 +29,9 @@ REAL8 XLALInspiralSBankComputeRealMatch(const COMPLEX8FrequencySeries *inj, cons
 REAL8 XLALInspiralSBankComputeMatchMaxSkyLoc(const COMPLEX8FrequencySeries *hp, const COMPLEX8FrequencySeries *hc, const REAL8 hphccorr, const COMPLEX8FrequencySeries *proposal, WS *workspace_cache1, WS *workspace_cache2);
 
 REAL8 XLALInspiralSBankComputeMatchMaxSkyLocNoPhase(const COMPLEX8FrequencySeries *hp, const COMPLEX8FrequencySeries *hc, const REAL8 hphccorr, const COMPLEX8FrequencySeries *proposal, WS *workspace_cache1, WS *workspace_cache2);
+
+SBankTemplateBlock *XLALCreateSBankTemplateBlock(const size_t length);
+void XLALDestroySBankTemplateBlock(SBankTemplateBlock *block);
+int XLALSetSBankTemplateBlockEntry(SBankTemplateBlock *block, const size_t k, const COMPLEX8FrequencySeries *tmplt);
+
+int XLALInspiralSBankComputeMatchBatch(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const SBankTemplateBlock *tmplts, const REAL8 min_match, WS *workspace_cache);
@@ -44,7 +44,7 @@ class lazy_nhoods(object):
 
 class Bank(object):
 
-    def __init__(self, noise_model, flow, use_metric=False, cache_waveforms=False, nhood_size=1.0, nhood_param="tau0", coarse_match_df=None, iterative_match_df_max=None, fhigh_max=None, optimize_flow=None, flow_column=None):
+    def __init__(self, noise_model, flow, use_metric=False, cache_waveforms=False, nhood_size=1.0, nhood_param="tau0", coarse_match_df=None, iterative_match_df_max=None, fhigh_max=None, optimize_flow=None, flow_column=None, match_block_size=32):
 
         self.noise_model = noise_model
         self.flow = flow
@@ -66,6 +66,7 @@ class Bank(object):
 
         self.nhood_size = nhood_size
         self.nhood_param = nhood_param
+        self.match_block_size = match_block_size
 
         self._templates = []
         self._nmatch = 0
@@ -159,7 +160,9 @@ class Bank(object):
         Return (max_match, template) where max_match is either (i) the
         best found match if max_match < min_match or (ii) the match of
         the first template found with match >= min_match.  template is
-        the Template() object which yields max_match.
+        the Template() object which yields max_match. If matches are
+        computed in blocks, max_match in case (i) may be an upper bound
+        on the best match.
         """
         max_match = 0
         template = None
@@ -185,6 +188,27 @@ class Bank(object):
             f_max = min(f_max, self.fhigh_max)
         df_start = max(df_end, self.iterative_match_df_max)
 
+        # without match refinement, compute matches in blocks of templates
+        if not self.use_metric and not self.coarse_match_df and df_start == df_end \
+                and getattr(proposal, "brute_match_batch", None) is not None:
+            PSD = get_PSD(df_end, self.flow, f_max, self.noise_model)
+            for low in range(0, len(tmpbank), self.match_block_size):
+                block = tmpbank[low:low + self.match_block_size]
+                self._nmatch += len(block)
+                matches = proposal.brute_match_batch(block, df_end, self._workspace_cache, min_match=min_match, PSD=PSD)
+                if not self.cache_waveforms:
+                    for tmplt in block:
+                        tmplt.clear()
+                for tmplt, match in zip(block, matches):
+                    if match == 0:
+                        raise ValueError("Match is 0. This might indicate that you have the df value too high.")
+                    if match > min_match:
+                        return (match, tmplt)
+                    if match > max_match:
+                        max_match = match
+                        template = tmplt
+            return (max_match, template)
+
         # find and test matches
         for tmplt in tmpbank:
 
@@ -258,7 +282,13 @@ class Bank(object):
         df, ASD = get_neighborhood_ASD(tmpbank + [proposal], self.flow, self.noise_model)
 
         # compute matches
-        matches = [self.compute_match(tmplt, proposal, df, ASD=ASD) for tmplt in tmpbank]
+        if not self.use_metric and getattr(proposal, "brute_match_batch", None) is not None:
+            matches = proposal.brute_match_batch(tmpbank, df, self._workspace_cache, ASD=ASD)
+            if not self.cache_waveforms:
+                for tmplt in tmpbank:
+                    tmplt.clear()
+        else:
+            matches = [self.compute_match(tmplt, proposal, df, ASD=ASD) for tmplt in tmpbank]
         best_tmplt_ind = np.argmax(matches)
         self._nmatch += len(tmpbank)
 
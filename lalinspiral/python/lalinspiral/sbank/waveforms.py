@@ -27,6 +27,7 @@ import lal
 import lalsimulation as lalsim
 from lal import MSUN_SI, MTSUN_SI, PC_SI, PI, CreateREAL8Vector, CreateCOMPLEX8FrequencySeries
 from lalinspiral import InspiralSBankComputeMatch, InspiralSBankComputeRealMatch, InspiralSBankComputeMatchMaxSkyLoc, InspiralSBankComputeMatchMaxSkyLocNoPhase
+from lalinspiral import InspiralSBankComputeMatchBatch, CreateSBankTemplateBlock, SetSBankTemplateBlockEntry
 from lalinspiral.sbank.psds import get_neighborhood_PSD, get_ASD
 from lalinspiral.sbank.tau0tau3 import m1m2_to_tau0tau3
 
@@ -406,6 +407,19 @@ class AlignedSpinTemplate(object):
     def brute_match(self, other, df, workspace_cache, **kwargs):
         return InspiralSBankComputeMatch(self.get_whitened_normalized(df, **kwargs), other.get_whitened_normalized(df, **kwargs), workspace_cache[0])
 
+    def brute_match_batch(self, others, df, workspace_cache, min_match=0., **kwargs):
+        """
+        Return the matches of this proposal against each template in
+        others, as brute_match would. Matches that are bounded below
+        min_match are not computed; the bound is returned instead.
+        """
+        block = CreateSBankTemplateBlock(len(others))
+        for k, other in enumerate(others):
+            SetSBankTemplateBlockEntry(block, k, other.get_whitened_normalized(df, **kwargs))
+        matches = CreateREAL8Vector(len(others))
+        InspiralSBankComputeMatchBatch(matches, self.get_whitened_normalized(df, **kwargs), block, min_match, workspace_cache[0])
+        return matches.data
+
     def clear(self):
         self._wf = {}
 
@@ -610,6 +624,9 @@ class PrecessingSpinTemplate(AlignedSpinTemplate):
          ('polarization', float32), ('inclination', float32),
          ('orbital_phase', float32)]
 
+    # matches maximize over sky location; no batched implementation
+    brute_match_batch = None
+
     def __init__(self, m1, m2, spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, theta, phi, iota, psi, orb_phase, bank, flow=None, duration=None):
 
         AlignedSpinTemplate.__init__(self, m1, m2, spin1z, spin2z, bank,
@@ -0,0 +1,172 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup LALInspiralBank_h
+ *
+ * \brief Tests XLALInspiralSBankComputeMatchBatch() against
+ * XLALInspiralSBankComputeMatch() called for each template in turn.
+ *
+ * The templates are whitened, normalized stationary-phase chirps of
+ * several chirp masses and lengths, so that templates of different
+ * lengths share the workspace cache. Without a minimal match every
+ * batched match must agree with the single-template match; with one,
+ * every match skipped by the batch must be bounded by the returned value.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <complex.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
+#include <lal/LALInspiralSBankOverlap.h>
+
+#define DELTAF 0.25
+#define FLOW 20.0
+#define NUM_TMPLTS 24
+
+/* allowed difference between the batched and single-template matches, which
+ * are computed from single-precision complex SNR time series */
+#define TOLERANCE 1e-5
+
+static COMPLEX8FrequencySeries *create_chirp(REAL8 mchirp, REAL8 tc, size_t length);
+
+int main(void)
+{
+    const size_t lengths[3] = {2049, 1025, 4097};
+
+    COMPLEX8FrequencySeries *proposal = create_chirp(2.0, 0., 2049);
+    XLAL_CHECK_MAIN(proposal != NULL, XLAL_EFUNC);
+
+    COMPLEX8FrequencySeries *tmplts[NUM_TMPLTS];
+    SBankTemplateBlock *block = XLALCreateSBankTemplateBlock(NUM_TMPLTS);
+    XLAL_CHECK_MAIN(block != NULL, XLAL_EFUNC);
+    for (size_t j = 0; j < NUM_TMPLTS; ++j) {
+        /* chirp masses bracketing the proposal's, with the proposal itself among them; the
+         * heaviest end below 100 Hz, so that their matches are bounded below 0.97 */
+        const REAL8 mchirp = 2.0 * pow(1.25, (REAL8) j - NUM_TMPLTS / 2);
+        tmplts[j] = create_chirp(mchirp, 0.25 * (j % 5), lengths[j % 3]);
+        XLAL_CHECK_MAIN(tmplts[j] != NULL, XLAL_EFUNC);
+        XLAL_CHECK_MAIN(XLALSetSBankTemplateBlockEntry(block, j, tmplts[j]) == XLAL_SUCCESS, XLAL_EFUNC);
+    }
+
+    WS *workspace_cache = XLALCreateSBankWorkspaceCache();
+    WS *batch_workspace_cache = XLALCreateSBankWorkspaceCache();
+    XLAL_CHECK_MAIN(workspace_cache != NULL && batch_workspace_cache != NULL, XLAL_EFUNC);
+
+    /* single-template matches */
+    REAL8 exact[NUM_TMPLTS];
+    REAL8 max_exact = 0.;
+    for (size_t j = 0; j < NUM_TMPLTS; ++j) {
+        exact[j] = XLALInspiralSBankComputeMatch(tmplts[j], proposal, workspace_cache);
+        XLAL_CHECK_MAIN(!XLAL_IS_REAL8_FAIL_NAN(exact[j]), XLAL_EFUNC);
+        max_exact = fmax(max_exact, exact[j]);
+    }
+    XLAL_CHECK_MAIN(fabs(max_exact - 1.) <= TOLERANCE, XLAL_ETOL, "Match of the proposal with itself is %g, not 1", max_exact);
+
+    REAL8Vector *matches = XLALCreateREAL8Vector(NUM_TMPLTS);
+    XLAL_CHECK_MAIN(matches != NULL, XLAL_EFUNC);
+
+    /* batched matches without a minimal match agree with the single-template matches */
+    XLAL_CHECK_MAIN(XLALInspiralSBankComputeMatchBatch(matches, proposal, block, 0., batch_workspace_cache) == XLAL_SUCCESS, XLAL_EFUNC);
+    for (size_t j = 0; j < NUM_TMPLTS; ++j) {
+        XLAL_CHECK_MAIN(fabs(matches->data[j] - exact[j]) <= TOLERANCE, XLAL_ETOL,
+                        "Template %zu: batched match %.9f differs from match %.9f", j, matches->data[j], exact[j]);
+    }
+
+    /* with a minimal match, the batched matches above it agree with the single-template
+     * matches, and those below it are upper bounds on the single-template matches */
+    const REAL8 min_matches[2] = {0.5, 0.97};
+    for (size_t i = 0; i < 2; ++i) {
+        size_t num_bounded = 0;
+        XLAL_CHECK_MAIN(XLALInspiralSBankComputeMatchBatch(matches, proposal, block, min_matches[i], batch_workspace_cache) == XLAL_SUCCESS, XLAL_EFUNC);
+        for (size_t j = 0; j < NUM_TMPLTS; ++j) {
+            if (matches->data[j] < min_matches[i]) {
+                XLAL_CHECK_MAIN(exact[j] <= matches->data[j] + TOLERANCE, XLAL_ETOL,
+                                "Template %zu: bound %.9f below match %.9f", j, matches->data[j], exact[j]);
+                num_bounded += (fabs(matches->data[j] - exact[j]) > TOLERANCE);
+            } else {
+                XLAL_CHECK_MAIN(fabs(matches->data[j] - exact[j]) <= TOLERANCE, XLAL_ETOL,
+                                "Template %zu: batched match %.9f differs from match %.9f with minimal match %g", j, matches->data[j], exact[j], min_matches[i]);
+            }
+        }
+        XLALPrintInfo("%s: minimal match %g: %zu of %d matches bounded\n", __func__, min_matches[i], num_bounded, NUM_TMPLTS);
+        XLAL_CHECK_MAIN(i == 0 || num_bounded > 0, XLAL_EFAILED, "No matches bounded with minimal match %g", min_matches[i]);
+    }
+
+    /* unset templates are an error */
+    SBankTemplateBlock *unset = XLALCreateSBankTemplateBlock(NUM_TMPLTS);
+    XLAL_CHECK_MAIN(unset != NULL, XLAL_EFUNC);
+    int errnum = 0;
+    int retn = 0;
+    XLAL_TRY_SILENT(retn = XLALInspiralSBankComputeMatchBatch(matches, proposal, unset, 0., batch_workspace_cache), errnum);
+    XLAL_CHECK_MAIN(retn != XLAL_SUCCESS && errnum == XLAL_EFAULT, XLAL_EFAILED, "Unset templates not rejected");
+    XLALDestroySBankTemplateBlock(unset);
+
+    XLALDestroyREAL8Vector(matches);
+    XLALDestroySBankWorkspaceCache(batch_workspace_cache);
+    XLALDestroySBankWorkspaceCache(workspace_cache);
+    XLALDestroySBankTemplateBlock(block);
+    for (size_t j = 0; j < NUM_TMPLTS; ++j)
+        XLALDestroyCOMPLEX8FrequencySeries(tmplts[j]);
+    XLALDestroyCOMPLEX8FrequencySeries(proposal);
+
+    LALCheckMemoryLeaks();
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Create a whitened, normalized, leading-order stationary-phase chirp with
+ * chirp mass mchirp (in solar masses) and coalescence time tc, cut off at
+ * the innermost stable circular orbit of an equal-mass binary.
+ */
+static COMPLEX8FrequencySeries *create_chirp(REAL8 mchirp, REAL8 tc, size_t length)
+{
+    const LIGOTimeGPS epoch = LIGOTIMEGPSZERO;
+    COMPLEX8FrequencySeries *h = XLALCreateCOMPLEX8FrequencySeries("chirp", &epoch, 0., DELTAF, &lalDimensionlessUnit, length);
+    XLAL_CHECK_NULL(h != NULL, XLAL_EFUNC);
+
+    const REAL8 mc = mchirp * LAL_MTSUN_SI;
+    const REAL8 mtotal = mchirp * pow(4., 0.6) * LAL_MTSUN_SI;
+    const REAL8 fisco = 1. / (pow(6., 1.5) * LAL_PI * mtotal);
+
+    REAL8 norm = 0.;
+    for (size_t k = 0; k < length; ++k) {
+        const REAL8 f = k * DELTAF;
+        if (f < FLOW || f > fisco) {
+            h->data->data[k] = 0.;
+            continue;
+        }
+        const REAL8 psi = LAL_TWOPI * f * tc - LAL_PI_4 + 3. / 128. * pow(LAL_PI * mc * f, -5. / 3.);
+        const REAL8 amp = pow(f, -7. / 6.);
+        h->data->data[k] = amp * cexp(-I * psi);
+        norm += amp * amp;
+    }
+
+    /* normalize so that the match of h with itself is 1 */
+    norm = 1. / sqrt(4. * DELTAF * norm);
+    for (size_t k = 0; k < length; ++k)
+        h->data->data[k] *= norm;
+
+    return h;
+}
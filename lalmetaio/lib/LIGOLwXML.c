@@ -52,6 +52,15 @@
  */
 
 
+#include <float.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
 #include <lal/FileIO.h>
 #include <lal/LALMalloc.h>
 #include <lal/LALVCSInfo.h>
@@ -61,6 +70,507 @@
 #include <LIGOLwXMLHeaders.h>
 
 
+/*
+ * ============================================================================
+ *
+ *                               Row Buffering
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * Table rows are formatted into a large per-table buffer instead of going
+ * through one XLALFilePrintf() per row.  When LAL has pthread support, full
+ * buffers are handed to a background thread that passes them to
+ * XLALFileWrite(), so that gzip compression of one buffer overlaps the
+ * formatting of the next.  The output is byte-for-byte identical to what
+ * XLALFilePrintf() produces.
+ */
+
+
+#define ROW_BUFFER_SIZE (1 << 20)
+#define ROW_BUFFER_FIELD_MAX 40	/* longest formatted number, with room to spare */
+
+
+struct row_buffer {
+	LALFILE *fp;
+	char *storage;
+	char *data[2];	/* buffer being filled, buffer being written */
+	size_t len;	/* bytes used in data[0] */
+	int failed;
+#ifdef LAL_PTHREAD_LOCK
+	int threaded;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	size_t pending;	/* bytes waiting in data[1], 0 when the writer is idle */
+	int done;
+#endif
+};
+
+
+#ifdef LAL_PTHREAD_LOCK
+static void *row_buffer_writer(void *arg)
+{
+	struct row_buffer *buf = arg;
+
+	pthread_mutex_lock(&buf->lock);
+	while(1) {
+		size_t n;
+		int ok;
+		while(!buf->pending && !buf->done)
+			pthread_cond_wait(&buf->cond, &buf->lock);
+		if(!buf->pending)
+			break;
+		n = buf->pending;
+		pthread_mutex_unlock(&buf->lock);
+		ok = XLALFileWrite(buf->data[1], 1, n, buf->fp) == n;
+		/* the XLAL error state of this thread is never seen by the
+		 * caller, so report the failure here */
+		if(!ok)
+			XLALPrintError("%s(): failed to write %zu bytes of table rows\n", __func__, n);
+		pthread_mutex_lock(&buf->lock);
+		if(!ok)
+			buf->failed = 1;
+		buf->pending = 0;
+		pthread_cond_broadcast(&buf->cond);
+	}
+	pthread_mutex_unlock(&buf->lock);
+
+	return NULL;
+}
+#endif
+
+
+/*
+ * Returns non-zero if a write has failed.  The writer thread sets the flag
+ * under the lock.
+ */
+
+
+static int row_buffer_failed(struct row_buffer *buf)
+{
+#ifdef LAL_PTHREAD_LOCK
+	if(buf->threaded) {
+		int failed;
+		pthread_mutex_lock(&buf->lock);
+		failed = buf->failed;
+		pthread_mutex_unlock(&buf->lock);
+		return failed;
+	}
+#endif
+	return buf->failed;
+}
+
+
+static int row_buffer_flush(struct row_buffer *buf)
+{
+#ifdef LAL_PTHREAD_LOCK
+	if(buf->threaded) {
+		char *tmp;
+		int failed;
+		pthread_mutex_lock(&buf->lock);
+		while(buf->pending)
+			pthread_cond_wait(&buf->cond, &buf->lock);
+		if(buf->len) {
+			tmp = buf->data[1];
+			buf->data[1] = buf->data[0];
+			buf->data[0] = tmp;
+			buf->pending = buf->len;
+			pthread_cond_broadcast(&buf->cond);
+		}
+		failed = buf->failed;
+		pthread_mutex_unlock(&buf->lock);
+		buf->len = 0;
+		return failed ? -1 : 0;
+	}
+#endif
+	if(buf->len && XLALFileWrite(buf->data[0], 1, buf->len, buf->fp) != buf->len)
+		buf->failed = 1;
+	buf->len = 0;
+	return buf->failed ? -1 : 0;
+}
+
+
+static struct row_buffer *row_buffer_open(LALFILE *fp)
+{
+	struct row_buffer *buf = XLALMalloc(sizeof(*buf));
+	char *data = XLALMalloc(2 * ROW_BUFFER_SIZE);
+
+	if(!buf || !data) {
+		XLALFree(buf);
+		XLALFree(data);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	buf->fp = fp;
+	buf->storage = data;
+	buf->data[0] = data;
+	buf->data[1] = data + ROW_BUFFER_SIZE;
+	buf->len = 0;
+	buf->failed = 0;
+#ifdef LAL_PTHREAD_LOCK
+	buf->pending = 0;
+	buf->done = 0;
+	pthread_mutex_init(&buf->lock, NULL);
+	pthread_cond_init(&buf->cond, NULL);
+	/* if the thread can't be started, write from this one */
+	buf->threaded = !pthread_create(&buf->thread, NULL, row_buffer_writer, buf);
+#endif
+
+	return buf;
+}
+
+
+/*
+ * Flush and free the buffer.  Returns < 0 if any write failed.
+ */
+
+
+static int row_buffer_close(struct row_buffer *buf)
+{
+	int failed;
+
+	row_buffer_flush(buf);
+#ifdef LAL_PTHREAD_LOCK
+	if(buf->threaded) {
+		pthread_mutex_lock(&buf->lock);
+		buf->done = 1;
+		pthread_cond_broadcast(&buf->cond);
+		pthread_mutex_unlock(&buf->lock);
+		pthread_join(buf->thread, NULL);
+	}
+	pthread_cond_destroy(&buf->cond);
+	pthread_mutex_destroy(&buf->lock);
+#endif
+	failed = buf->failed;
+	XLALFree(buf->storage);
+	XLALFree(buf);
+
+	return failed ? -1 : 0;
+}
+
+
+static char *row_buffer_reserve(struct row_buffer *buf, size_t n)
+{
+	if(buf->len + n > ROW_BUFFER_SIZE)
+		row_buffer_flush(buf);
+	return buf->data[0] + buf->len;
+}
+
+
+static void row_buffer_puts(struct row_buffer *buf, const char *s, size_t n)
+{
+	while(n) {
+		size_t m = ROW_BUFFER_SIZE - buf->len;
+		if(!m) {
+			row_buffer_flush(buf);
+			m = ROW_BUFFER_SIZE;
+		}
+		if(m > n)
+			m = n;
+		memcpy(buf->data[0] + buf->len, s, m);
+		buf->len += m;
+		s += m;
+		n -= m;
+	}
+}
+
+
+/*
+ * Integer conversions.  The digits are generated backwards into a scratch
+ * array and copied out.
+ */
+
+
+static int format_uint(char *s, UINT8 x)
+{
+	char tmp[24];
+	int n = 0, i;
+
+	do {
+		tmp[n++] = '0' + x % 10;
+		x /= 10;
+	} while(x);
+	for(i = 0; i < n; i++)
+		s[i] = tmp[n - 1 - i];
+
+	return n;
+}
+
+
+static int format_int(char *s, INT8 x)
+{
+	if(x < 0) {
+		*s = '-';
+		/* negate in unsigned arithmetic so the most negative value works */
+		return 1 + format_uint(s + 1, -(UINT8) x);
+	}
+	return format_uint(s, x);
+}
+
+
+/*
+ * Floating-point conversion equivalent to printf()'s %.<prec>g.
+ *
+ * The value is scaled by an exactly-representable power of ten so that
+ * its integer part holds prec digits, which costs a single rounding.  As
+ * long as that error is well below half a unit in the last digit, it
+ * cannot change the result except when the value lies within a few ulps
+ * of a rounding tie;  those values, and values outside the range of the
+ * power-of-ten tables, are handed to snprintf() instead, so the result
+ * always matches printf() exactly.  An error slightly below a decade
+ * boundary is harmless:  both choices of decade round to the same
+ * string.  %.8g (REAL4 columns) is done in double precision.  %.16g (REAL8
+ * columns) needs the longer significand of a long double, and uses
+ * snprintf() on platforms where long double is no wider than double.
+ */
+
+
+static int format_g_digits(char *s, int negative, UINT8 digits, int exponent, int prec)
+{
+	char d[24];
+	char *start = s;
+	int nd, i;
+
+	/* the prec digits of the significand, with trailing zeros removed */
+	format_uint(d, digits);
+	for(nd = prec; nd > 1 && d[nd - 1] == '0'; nd--);
+
+	if(negative)
+		*s++ = '-';
+	if(exponent < -4 || exponent >= prec) {
+		*s++ = d[0];
+		if(nd > 1) {
+			*s++ = '.';
+			for(i = 1; i < nd; i++)
+				*s++ = d[i];
+		}
+		*s++ = 'e';
+		*s++ = exponent < 0 ? '-' : '+';
+		if(exponent < 0)
+			exponent = -exponent;
+		if(exponent < 10)
+			*s++ = '0';
+		s += format_uint(s, exponent);
+	} else if(exponent >= 0) {
+		for(i = 0; i <= exponent; i++)
+			*s++ = d[i];
+		if(nd > exponent + 1) {
+			*s++ = '.';
+			for(; i < nd; i++)
+				*s++ = d[i];
+		}
+	} else {
+		*s++ = '0';
+		*s++ = '.';
+		for(i = -1; i > exponent; i--)
+			*s++ = '0';
+		for(i = 0; i < nd; i++)
+			*s++ = d[i];
+	}
+
+	return s - start;
+}
+
+
+static int format_g_fallback(char *s, double x, int prec)
+{
+	return snprintf(s, ROW_BUFFER_FIELD_MAX, "%.*g", prec, x);
+}
+
+
+static const double pow10_double[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+static int format_g_double(char *s, double x, int prec)
+{
+	const int kmax = sizeof(pow10_double) / sizeof(*pow10_double) - 1;
+	const double lo = pow10_double[prec - 1], hi = pow10_double[prec];
+	int negative = signbit(x) != 0;
+	double ax = fabs(x), scaled, tol, frac;
+	UINT8 digits;
+	int exponent, k, pass;
+
+	if(x == 0) {
+		if(negative)
+			*s++ = '-';
+		*s = '0';
+		return negative + 1;
+	}
+	if(!isnormal(x))
+		return format_g_fallback(s, x, prec);
+
+	exponent = (int) floor(log10(ax));
+	for(pass = 0; pass < 2; pass++) {
+		k = prec - 1 - exponent;
+		if(k > kmax || k < -kmax)
+			return format_g_fallback(s, x, prec);
+		scaled = k >= 0 ? ax * pow10_double[k] : ax / pow10_double[-k];
+		if(scaled < lo)
+			exponent--;
+		else if(scaled >= hi)
+			exponent++;
+		else
+			break;
+	}
+	if(pass == 2)
+		return format_g_fallback(s, x, prec);
+
+	/* more than twice the rounding error of the scaling */
+	tol = ldexp(scaled, -(DBL_MANT_DIG - 2));
+
+	frac = scaled - floor(scaled);
+	if(fabs(frac - 0.5) <= tol)
+		return format_g_fallback(s, x, prec);
+	digits = (UINT8) floor(scaled) + (frac > 0.5);
+	if(digits >= (UINT8) hi) {
+		digits /= 10;
+		exponent++;
+	}
+
+	return format_g_digits(s, negative, digits, exponent, prec);
+}
+
+
+#if LDBL_MANT_DIG >= 64
+static const long double pow10_long_double[] = {
+	1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L,
+	1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L,
+	1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+};
+
+
+static int format_g_long_double(char *s, double x, int prec)
+{
+	const int kmax = sizeof(pow10_long_double) / sizeof(*pow10_long_double) - 1;
+	const long double lo = pow10_long_double[prec - 1], hi = pow10_long_double[prec];
+	int negative = signbit(x) != 0;
+	long double ax = fabs(x), scaled, tol, frac;
+	UINT8 digits;
+	int exponent, k, pass;
+
+	if(x == 0) {
+		if(negative)
+			*s++ = '-';
+		*s = '0';
+		return negative + 1;
+	}
+	if(!isnormal(x))
+		return format_g_fallback(s, x, prec);
+
+	exponent = (int) floor(log10(fabs(x)));
+	for(pass = 0; pass < 2; pass++) {
+		k = prec - 1 - exponent;
+		if(k > kmax || k < -kmax)
+			return format_g_fallback(s, x, prec);
+		scaled = k >= 0 ? ax * pow10_long_double[k] : ax / pow10_long_double[-k];
+		if(scaled < lo)
+			exponent--;
+		else if(scaled >= hi)
+			exponent++;
+		else
+			break;
+	}
+	if(pass == 2)
+		return format_g_fallback(s, x, prec);
+
+	tol = ldexpl(scaled, -(LDBL_MANT_DIG - 2));
+
+	frac = scaled - floorl(scaled);
+	if(fabsl(frac - 0.5L) <= tol)
+		return format_g_fallback(s, x, prec);
+	digits = (UINT8) floorl(scaled) + (frac > 0.5L);
+	if(digits >= (UINT8) hi) {
+		digits /= 10;
+		exponent++;
+	}
+
+	return format_g_digits(s, negative, digits, exponent, prec);
+}
+#endif
+
+
+static int format_g(char *s, double x, int prec)
+{
+	/* keep the scaling error below 0.05 units in the last digit */
+	if(prec <= DBL_DIG - 2)
+		return format_g_double(s, x, prec);
+#if LDBL_MANT_DIG >= 64
+	if(prec <= LDBL_DIG - 2)
+		return format_g_long_double(s, x, prec);
+#endif
+	return format_g_fallback(s, x, prec);
+}
+
+
+/*
+ * printf()-alike that formats into the row buffer.  Only the conversions
+ * used by the table writers are understood:  %s, %d, %u, %ld, %lu and
+ * %.<prec>g.  Returns < 0 on an unknown conversion or a failed write.
+ */
+
+
+static int row_buffer_printf(struct row_buffer *buf, const char *fmt, ...)
+{
+	va_list ap;
+	const char *s;
+
+	va_start(ap, fmt);
+	while(*fmt) {
+		char *dst;
+		int prec, is_long;
+
+		/* literal text up to the next conversion */
+		for(s = fmt; *fmt && *fmt != '%'; fmt++);
+		row_buffer_puts(buf, s, fmt - s);
+		if(!*fmt)
+			break;
+		fmt++;
+
+		prec = -1;
+		if(*fmt == '.') {
+			for(prec = 0, fmt++; *fmt >= '0' && *fmt <= '9'; fmt++)
+				prec = 10 * prec + (*fmt - '0');
+		}
+		is_long = *fmt == 'l';
+		if(is_long)
+			fmt++;
+
+		dst = row_buffer_reserve(buf, ROW_BUFFER_FIELD_MAX);
+		switch(*fmt) {
+		case 's':
+			s = va_arg(ap, const char *);
+			row_buffer_puts(buf, s, strlen(s));
+			break;
+		case 'd':
+			buf->len += format_int(dst, is_long ? va_arg(ap, long) : va_arg(ap, int));
+			break;
+		case 'u':
+			buf->len += format_uint(dst, is_long ? va_arg(ap, unsigned long) : va_arg(ap, unsigned));
+			break;
+		case 'g':
+			buf->len += format_g(dst, va_arg(ap, double), prec < 0 ? 6 : prec ? prec : 1);
+			break;
+		case '%':
+			*dst = '%';
+			buf->len++;
+			break;
+		default:
+			va_end(ap);
+			XLAL_ERROR(XLAL_EINVAL, "unsupported conversion in \"%s\"", fmt);
+		}
+		fmt++;
+	}
+	va_end(ap);
+
+	return row_buffer_failed(buf) ? -1 : 0;
+}
+
+
 /**
  * Open an XML file for writing.  The return value is a pointer to a new
  * LIGOLwXMLStream file handle or NULL on failure.
@@ -146,6 +656,7 @@ int XLALWriteLIGOLwXMLProcessTable(
 )
 {
 	const char *row_head = "\n\t\t\t";
+	struct row_buffer *buf;
 
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
@@ -177,8 +688,11 @@ int XLALWriteLIGOLwXMLProcessTable(
 
 	/* rows */
 
+	buf = row_buffer_open(xml->fp);
+	if(!buf)
+		XLAL_ERROR(XLAL_EFUNC);
 	for(; process; process = process->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"%s\",\"%s\",\"%s\",%d,\"%s\",%d,\"%s\",\"%s\",%d,%d,%d,%d,\"%s\",\"%s\",\"process:process_id:%ld\"",
+		if(row_buffer_printf(buf, "%s\"%s\",\"%s\",\"%s\",%d,\"%s\",%d,\"%s\",\"%s\",%d,%d,%d,%d,\"%s\",\"%s\",\"process:process_id:%ld\"",
 			row_head,
 			process->program,
 			process->version,
@@ -195,11 +709,16 @@ int XLALWriteLIGOLwXMLProcessTable(
 			process->domain,
 			process->ifos,
 			process->process_id
-		) < 0)
+		) < 0) {
+			row_buffer_close(buf);
 			XLAL_ERROR(XLAL_EFUNC);
+		}
 		row_head = ",\n\t\t\t";
 	}
 
+	if(row_buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -222,6 +741,7 @@ int XLALWriteLIGOLwXMLProcessParamsTable(
 )
 {
 	const char *row_head = "\n\t\t\t";
+	struct row_buffer *buf;
 
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
@@ -243,19 +763,27 @@ int XLALWriteLIGOLwXMLProcessParamsTable(
 
 	/* rows */
 
+	buf = row_buffer_open(xml->fp);
+	if(!buf)
+		XLAL_ERROR(XLAL_EFUNC);
 	for(; process_params; process_params = process_params->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"%s\",\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\"",
+		if(row_buffer_printf(buf, "%s\"%s\",\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\"",
 			row_head,
 			process_params->program,
 			process_params->process_id,
 			process_params->param,
 			process_params->type,
 			process_params->value
-		) < 0)
+		) < 0) {
+			row_buffer_close(buf);
 			XLAL_ERROR(XLAL_EFUNC);
+		}
 		row_head = ",\n\t\t\t";
 	}
 
+	if(row_buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -278,6 +806,7 @@ int XLALWriteLIGOLwXMLSearchSummaryTable(
 )
 {
 	const char *row_head = "\n\t\t\t";
+	struct row_buffer *buf;
 
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
@@ -310,8 +839,11 @@ int XLALWriteLIGOLwXMLSearchSummaryTable(
 
 	/* rows */
 
+	buf = row_buffer_open(xml->fp);
+	if(!buf)
+		XLAL_ERROR(XLAL_EFUNC);
 	for(; search_summary; search_summary = search_summary->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"standalone\",\"\",\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
+		if(row_buffer_printf(buf, "%s\"process:process_id:%ld\",\"standalone\",\"\",\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
 			row_head,
 			search_summary->process_id,
 			lalVCSInfo.vcsTag,
@@ -327,11 +859,16 @@ int XLALWriteLIGOLwXMLSearchSummaryTable(
 			search_summary->out_end_time.gpsNanoSeconds,
 			search_summary->nevents,
 			search_summary->nnodes
-		) < 0)
+		) < 0) {
+			row_buffer_close(buf);
 			XLAL_ERROR(XLAL_EFUNC);
+		}
 		row_head = ",\n\t\t\t";
 	}
 
+	if(row_buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -354,6 +891,7 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 )
 {
 	const char *row_head = "\n\t\t\t";
+	struct row_buffer *buf;
 
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
@@ -387,8 +925,11 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 
 	/* rows */
 
+	buf = row_buffer_open(xml->fp);
+	if(!buf)
+		XLAL_ERROR(XLAL_EFUNC);
 	for(; sngl_burst; sngl_burst = sngl_burst->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,\"sngl_burst:event_id:%ld\"",
+		if(row_buffer_printf(buf, "%s\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,\"sngl_burst:event_id:%ld\"",
 			row_head,
 			sngl_burst->process_id,
 			sngl_burst->ifo,
@@ -407,11 +948,16 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 			sngl_burst->chisq,
 			sngl_burst->chisq_dof,
 			sngl_burst->event_id
-		) < 0)
+		) < 0) {
+			row_buffer_close(buf);
 			XLAL_ERROR(XLAL_EFUNC);
+		}
 		row_head = ",\n\t\t\t";
 	}
 
+	if(row_buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -428,6 +974,7 @@ int XLALWriteLIGOLwXMLSnglInspiralTable(
 )
 {
 	const char *row_head = "\n\t\t\t";
+	struct row_buffer *buf;
 
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
@@ -508,8 +1055,11 @@ int XLALWriteLIGOLwXMLSnglInspiralTable(
 
 	/* rows */
 
+	buf = row_buffer_open(xml->fp);
+	if(!buf)
+		XLAL_ERROR(XLAL_EFUNC);
 	for(; sngl_inspiral; sngl_inspiral = sngl_inspiral->next) {
-		if(XLALFilePrintf(xml->fp,"%s\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\",%d,%d,%.16g,%d,%d,%.16g,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%u,%.8g,%u,%.8g,%u,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,\"sngl_inspiral:event_id:%ld\"",
+		if(row_buffer_printf(buf, "%s\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\",%d,%d,%.16g,%d,%d,%.16g,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%u,%.8g,%u,%.8g,%u,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,\"sngl_inspiral:event_id:%ld\"",
 			   row_head,
 			   sngl_inspiral->process_id,
 			   sngl_inspiral->ifo,
@@ -574,11 +1124,16 @@ int XLALWriteLIGOLwXMLSnglInspiralTable(
 			   sngl_inspiral->spin2x,
 			   sngl_inspiral->spin2y,
 			   sngl_inspiral->spin2z,
-			   sngl_inspiral->event_id ) < 0)
+			   sngl_inspiral->event_id ) < 0) {
+			row_buffer_close(buf);
 			XLAL_ERROR(XLAL_EFUNC);
+		}
 		row_head = ",\n\t\t\t";
 	}
 
+	if(row_buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
 		XLAL_ERROR(XLAL_EFUNC);
@@ -601,6 +1156,7 @@ int XLALWriteLIGOLwXMLSimBurstTable(
 )
 {
 	const char *row_head = "\n\t\t\t";
+	struct row_buffer *buf;
 
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
@@ -637,8 +1193,11 @@ int XLALWriteLIGOLwXMLSimBurstTable(
 
 	/* rows */
 
+	buf = row_buffer_open(xml->fp);
+	if(!buf)
+		XLAL_ERROR(XLAL_EFUNC);
 	for(; sim_burst; sim_burst = sim_burst->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,\"time_slide:time_slide_id:%ld\",\"sim_burst:simulation_id:%ld\"",
+		if(row_buffer_printf(buf, "%s\"process:process_id:%ld\",\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,\"time_slide:time_slide_id:%ld\",\"sim_burst:simulation_id:%ld\"",
 			row_head,
 			sim_burst->process_id,
 			sim_burst->waveform,
@@ -660,11 +1219,16 @@ int XLALWriteLIGOLwXMLSimBurstTable(
 			sim_burst->waveform_number,
 			sim_burst->time_slide_id,
 			sim_burst->simulation_id
-		) < 0)
+		) < 0) {
+			row_buffer_close(buf);
 			XLAL_ERROR(XLAL_EFUNC);
+		}
 		row_head = ",\n\t\t\t";
 	}
 
+	if(row_buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -687,6 +1251,7 @@ int XLALWriteLIGOLwXMLTimeSlideTable(
 )
 {
 	const char *row_head = "\n\t\t\t";
+	struct row_buffer *buf;
 
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
@@ -707,18 +1272,26 @@ int XLALWriteLIGOLwXMLTimeSlideTable(
 
 	/* rows */
 
+	buf = row_buffer_open(xml->fp);
+	if(!buf)
+		XLAL_ERROR(XLAL_EFUNC);
 	for(; time_slide; time_slide = time_slide->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"time_slide:time_slide_id:%ld\",\"%s\",%.16g",
+		if(row_buffer_printf(buf, "%s\"process:process_id:%ld\",\"time_slide:time_slide_id:%ld\",\"%s\",%.16g",
 			row_head,
 			time_slide->process_id,
 			time_slide->time_slide_id,
 			time_slide->instrument,
 			time_slide->offset
-		) < 0)
+		) < 0) {
+			row_buffer_close(buf);
 			XLAL_ERROR(XLAL_EFUNC);
+		}
 		row_head = ",\n\t\t\t";
 	}
 
+	if(row_buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -740,6 +1313,7 @@ int XLALWriteLIGOLwXMLSegmentTable(
 )
 {
 	const char *row_head = "\n\t\t\t";
+	struct row_buffer *buf;
 
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
@@ -765,8 +1339,11 @@ int XLALWriteLIGOLwXMLSegmentTable(
 
 	/* rows */
 
+	buf = row_buffer_open(xml->fp);
+	if(!buf)
+		XLAL_ERROR(XLAL_EFUNC);
 	for(; segment_table; segment_table = segment_table->next) {
-		if(XLALFilePrintf(xml->fp, "%s%d,\"process:process_id:%ld\",\"segment:segment_id:%ld\",%d,%d,%d,%d,\"segment_def:segment_def_id:%ld\",%d",
+		if(row_buffer_printf(buf, "%s%d,\"process:process_id:%ld\",\"segment:segment_id:%ld\",%d,%d,%d,%d,\"segment_def:segment_def_id:%ld\",%d",
 			row_head,
 			segment_table->creator_db,
 			segment_table->process_id,
@@ -777,11 +1354,16 @@ int XLALWriteLIGOLwXMLSegmentTable(
 			segment_table->end_time.gpsNanoSeconds,
 			segment_table->segment_def_id,
 			segment_table->segment_def_cdb
-		) < 0)
+		) < 0) {
+			row_buffer_close(buf);
 			XLAL_ERROR(XLAL_EFUNC);
+		}
 		row_head = ",\n\t\t\t";
 	}
 
+	if(row_buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
 	/* table footer */
 
 	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
@@ -0,0 +1,816 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/Date.h>
+#include <lal/LALStdlib.h>
+#include <lal/XLALError.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOMetadataColumns.h>
+
+
+/*
+ * ============================================================================
+ *
+ *                      Internal column-generic machinery
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * An array in a column table, and the size of its elements.  Arrays are
+ * listed in order of decreasing element size, so that carving them from
+ * one allocation keeps each of them aligned.
+ */
+
+
+struct column {
+	void **data;
+	size_t size;
+};
+
+
+#define MAX_COLUMNS 16
+
+
+/*
+ * (Re)allocate the arena backing the given arrays to hold capacity
+ * elements each, preserving the first length elements.
+ */
+
+
+static int resize_arena(struct column *columns, int num_columns, void **arena, UINT4 length, UINT4 capacity)
+{
+	size_t bytes = 0;
+	char *new;
+	int j;
+
+	for(j = 0; j < num_columns; j++)
+		bytes += columns[j].size * capacity;
+	new = XLALMalloc(bytes ? bytes : 1);
+	if(!new)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	bytes = 0;
+	for(j = 0; j < num_columns; j++) {
+		if(length)
+			memcpy(new + bytes, *columns[j].data, columns[j].size * length);
+		*columns[j].data = new + bytes;
+		bytes += columns[j].size * capacity;
+	}
+
+	XLALFree(*arena);
+	*arena = new;
+
+	return 0;
+}
+
+
+/*
+ * Replace each array by its elements at the n given indices.  The indices
+ * may be in any order (a permutation or a selection).
+ */
+
+
+static int gather_columns(struct column *columns, int num_columns, const UINT4 *index, UINT4 n)
+{
+	void *scratch = XLALMalloc(n * sizeof(INT8) + 1);
+	UINT4 i;
+	int j;
+
+	if(!scratch)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	for(j = 0; j < num_columns; j++) {
+		switch(columns[j].size) {
+		case sizeof(INT8): {
+			const INT8 *src = *columns[j].data;
+			INT8 *dst = scratch;
+			for(i = 0; i < n; i++)
+				dst[i] = src[index[i]];
+			break;
+		}
+		case sizeof(INT4): {
+			const INT4 *src = *columns[j].data;
+			INT4 *dst = scratch;
+			for(i = 0; i < n; i++)
+				dst[i] = src[index[i]];
+			break;
+		}
+		default:
+			XLALFree(scratch);
+			XLAL_ERROR(XLAL_EINVAL, "unsupported column element size %zu", columns[j].size);
+		}
+		memcpy(*columns[j].data, scratch, n * columns[j].size);
+	}
+
+	XLALFree(scratch);
+	return 0;
+}
+
+
+/*
+ * Indices of the n times in ascending order.  Equal times keep their
+ * relative order.
+ */
+
+
+struct time_key {
+	INT8 t;
+	UINT4 i;
+};
+
+
+static int compare_time_key(const void *a, const void *b)
+{
+	const struct time_key *A = a;
+	const struct time_key *B = b;
+
+	if(A->t != B->t)
+		return A->t > B->t ? +1 : -1;
+	return A->i > B->i ? +1 : (A->i < B->i ? -1 : 0);
+}
+
+
+static int sort_by_time(struct column *columns, int num_columns, const INT8 *t, UINT4 n)
+{
+	struct time_key *keys;
+	UINT4 *index;
+	UINT4 i;
+	int sorted = 1;
+
+	/* nothing to do if already ordered */
+	for(i = 1; i < n; i++)
+		sorted &= t[i - 1] <= t[i];
+	if(sorted)
+		return 0;
+
+	keys = XLALMalloc(n * sizeof(*keys));
+	index = XLALMalloc(n * sizeof(*index));
+	if(!keys || !index) {
+		XLALFree(keys);
+		XLALFree(index);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	for(i = 0; i < n; i++) {
+		keys[i].t = t[i];
+		keys[i].i = i;
+	}
+	qsort(keys, n, sizeof(*keys), compare_time_key);
+	for(i = 0; i < n; i++)
+		index[i] = keys[i].i;
+	XLALFree(keys);
+
+	if(gather_columns(columns, num_columns, index, n) < 0) {
+		XLALFree(index);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	XLALFree(index);
+	return 0;
+}
+
+
+/*
+ * Keep the elements whose indices are selected.  The index list is built
+ * without branches so that the selection loops vectorize.
+ */
+
+
+static int keep_selected(struct column *columns, int num_columns, UINT4 *length, const UINT4 *index, UINT4 n)
+{
+	if(n == *length)
+		return 0;
+	if(gather_columns(columns, num_columns, index, n) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	*length = n;
+	return 0;
+}
+
+
+static int time_cut(struct column *columns, int num_columns, UINT4 *length, const INT8 *t, const LIGOTimeGPS *start, const LIGOTimeGPS *end)
+{
+	const INT8 start_ns = XLALGPSToINT8NS(start);
+	const INT8 end_ns = XLALGPSToINT8NS(end);
+	UINT4 *index = XLALMalloc(*length * sizeof(*index) + 1);
+	UINT4 i, n = 0;
+
+	if(!index)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	for(i = 0; i < *length; i++) {
+		index[n] = i;
+		n += (t[i] >= start_ns) & (t[i] < end_ns);
+	}
+
+	if(keep_selected(columns, num_columns, length, index, n) < 0) {
+		XLALFree(index);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	XLALFree(index);
+	return 0;
+}
+
+
+static int snr_cut(struct column *columns, int num_columns, UINT4 *length, const REAL4 *snr, REAL4 snr_min)
+{
+	UINT4 *index = XLALMalloc(*length * sizeof(*index) + 1);
+	UINT4 i, n = 0;
+
+	if(!index)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	for(i = 0; i < *length; i++) {
+		index[n] = i;
+		n += snr[i] >= snr_min;
+	}
+
+	if(keep_selected(columns, num_columns, length, index, n) < 0) {
+		XLALFree(index);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	XLALFree(index);
+	return 0;
+}
+
+
+/*
+ * Time-window clustering of time-ordered triggers in one sweep:  a trigger
+ * within window of the loudest trigger of the current cluster joins the
+ * cluster, replacing it as the loudest trigger if its SNR is higher;
+ * otherwise it starts a new cluster.  Only the loudest trigger of each
+ * cluster is kept.
+ */
+
+
+static int cluster(struct column *columns, int num_columns, UINT4 *length, const INT8 *t, const REAL4 *snr, REAL8 window)
+{
+	const INT8 window_ns = llround(window * XLAL_BILLION_REAL8);
+	UINT4 *index;
+	UINT4 i, best, n = 0;
+
+	if(*length < 2)
+		return 0;
+
+	index = XLALMalloc(*length * sizeof(*index));
+	if(!index)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	for(best = 0, i = 1; i < *length; i++) {
+		if(t[i] - t[best] < window_ns) {
+			if(snr[i] > snr[best])
+				best = i;
+		} else {
+			index[n++] = best;
+			best = i;
+		}
+	}
+	index[n++] = best;
+
+	if(keep_selected(columns, num_columns, length, index, n) < 0) {
+		XLALFree(index);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	XLALFree(index);
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                sngl_inspiral
+ *
+ * ============================================================================
+ */
+
+
+static int inspiral_columns(SnglInspiralColumns *table, struct column *columns)
+{
+	int j = 0;
+	columns[j++] = (struct column) {(void **) &table->end, sizeof(*table->end)};
+	columns[j++] = (struct column) {(void **) &table->snr, sizeof(*table->snr)};
+	columns[j++] = (struct column) {(void **) &table->chisq, sizeof(*table->chisq)};
+	columns[j++] = (struct column) {(void **) &table->mass1, sizeof(*table->mass1)};
+	columns[j++] = (struct column) {(void **) &table->mass2, sizeof(*table->mass2)};
+	columns[j++] = (struct column) {(void **) &table->mchirp, sizeof(*table->mchirp)};
+	columns[j++] = (struct column) {(void **) &table->eta, sizeof(*table->eta)};
+	columns[j++] = (struct column) {(void **) &table->tau0, sizeof(*table->tau0)};
+	columns[j++] = (struct column) {(void **) &table->tau3, sizeof(*table->tau3)};
+	columns[j++] = (struct column) {(void **) &table->row, sizeof(*table->row)};
+	return j;
+}
+
+
+/**
+ * Create an empty sngl_inspiral column table with room for capacity
+ * triggers.  The table grows as needed when triggers are appended.
+ */
+
+
+SnglInspiralColumns *XLALCreateSnglInspiralColumns(UINT4 capacity)
+{
+	SnglInspiralColumns *table = XLALCalloc(1, sizeof(*table));
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+	num_columns = inspiral_columns(table, columns);
+	table->rows = XLALMalloc((capacity ? capacity : 1) * sizeof(*table->rows));
+	if(!table->rows || resize_arena(columns, num_columns, &table->arena, 0, capacity) < 0) {
+		XLALDestroySnglInspiralColumns(table);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	table->capacity = capacity;
+
+	return table;
+}
+
+
+/**
+ * Destroy a sngl_inspiral column table.
+ */
+
+
+void XLALDestroySnglInspiralColumns(SnglInspiralColumns *table)
+{
+	if(!table)
+		return;
+	XLALFree(table->rows);
+	XLALFree(table->arena);
+	XLALFree(table);
+}
+
+
+/**
+ * Append a copy of a legacy sngl_inspiral row.  The next pointer of the
+ * row is ignored.
+ */
+
+
+int XLALSnglInspiralColumnsAppend(SnglInspiralColumns *table, const SnglInspiralTable *row)
+{
+	UINT4 k;
+
+	XLAL_CHECK(table && row, XLAL_EFAULT);
+
+	if(table->num_rows == table->capacity) {
+		struct column columns[MAX_COLUMNS];
+		int num_columns = inspiral_columns(table, columns);
+		UINT4 capacity = table->capacity ? 2 * table->capacity : 16;
+		SnglInspiralTable *rows = XLALRealloc(table->rows, capacity * sizeof(*rows));
+		XLAL_CHECK(rows, XLAL_ENOMEM);
+		table->rows = rows;
+		XLAL_CHECK(resize_arena(columns, num_columns, &table->arena, table->length, capacity) == 0, XLAL_EFUNC);
+		table->capacity = capacity;
+	}
+
+	table->rows[table->num_rows] = *row;
+	table->rows[table->num_rows].next = NULL;
+
+	k = table->length;
+	table->end[k] = XLALGPSToINT8NS(&row->end);
+	table->snr[k] = row->snr;
+	table->chisq[k] = row->chisq;
+	table->mass1[k] = row->mass1;
+	table->mass2[k] = row->mass2;
+	table->mchirp[k] = row->mchirp;
+	table->eta[k] = row->eta;
+	table->tau0[k] = row->tau0;
+	table->tau3[k] = row->tau3;
+	table->row[k] = table->num_rows;
+
+	table->length++;
+	table->num_rows++;
+
+	return 0;
+}
+
+
+/**
+ * Convert a legacy sngl_inspiral linked list to a column table.  The list
+ * is not modified.
+ */
+
+
+SnglInspiralColumns *XLALSnglInspiralColumnsFromTable(const SnglInspiralTable *head)
+{
+	const SnglInspiralTable *row;
+	SnglInspiralColumns *table;
+	UINT4 n = 0;
+
+	for(row = head; row; row = row->next)
+		n++;
+
+	table = XLALCreateSnglInspiralColumns(n);
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+	for(row = head; row; row = row->next)
+		if(XLALSnglInspiralColumnsAppend(table, row) < 0) {
+			XLALDestroySnglInspiralColumns(table);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		}
+
+	return table;
+}
+
+
+/**
+ * Convert a column table to a newly-allocated legacy sngl_inspiral linked
+ * list, in the order of the table.  Returns NULL for an empty table.
+ */
+
+
+SnglInspiralTable *XLALSnglInspiralColumnsToTable(const SnglInspiralColumns *table)
+{
+	SnglInspiralTable *head = NULL;
+	SnglInspiralTable **next = &head;
+	UINT4 k;
+
+	XLAL_CHECK_NULL(table, XLAL_EFAULT);
+
+	for(k = 0; k < table->length; k++) {
+		SnglInspiralTable *row = XLALMalloc(sizeof(*row));
+		if(!row) {
+			while(head) {
+				SnglInspiralTable *tmp = head->next;
+				XLALFree(head);
+				head = tmp;
+			}
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		}
+		*row = table->rows[table->row[k]];
+		XLALINT8NSToGPS(&row->end, table->end[k]);
+		row->snr = table->snr[k];
+		row->chisq = table->chisq[k];
+		row->mass1 = table->mass1[k];
+		row->mass2 = table->mass2[k];
+		row->mchirp = table->mchirp[k];
+		row->eta = table->eta[k];
+		row->tau0 = table->tau0[k];
+		row->tau3 = table->tau3[k];
+		row->next = NULL;
+		*next = row;
+		next = &row->next;
+	}
+
+	return head;
+}
+
+
+/**
+ * Sort the triggers by end time.  The sort is stable.
+ */
+
+
+int XLALSortSnglInspiralColumnsByTime(SnglInspiralColumns *table)
+{
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	XLAL_CHECK(table, XLAL_EFAULT);
+	num_columns = inspiral_columns(table, columns);
+	XLAL_CHECK(sort_by_time(columns, num_columns, table->end, table->length) == 0, XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * Keep the triggers with start <= end time < end, as
+ * XLALTimeCutSingleInspiral() does for linked lists.
+ */
+
+
+int XLALTimeCutSnglInspiralColumns(SnglInspiralColumns *table, const LIGOTimeGPS *start, const LIGOTimeGPS *end)
+{
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	XLAL_CHECK(table && start && end, XLAL_EFAULT);
+	num_columns = inspiral_columns(table, columns);
+	XLAL_CHECK(time_cut(columns, num_columns, &table->length, table->end, start, end) == 0, XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * Keep the triggers with SNR >= snr_min.
+ */
+
+
+int XLALSNRCutSnglInspiralColumns(SnglInspiralColumns *table, REAL4 snr_min)
+{
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	XLAL_CHECK(table, XLAL_EFAULT);
+	num_columns = inspiral_columns(table, columns);
+	XLAL_CHECK(snr_cut(columns, num_columns, &table->length, table->snr, snr_min) == 0, XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * Cluster the triggers in time, keeping the loudest (by SNR) trigger of
+ * each group of triggers whose end times are less than window seconds
+ * from the group's loudest trigger.  The triggers are sorted by end time
+ * first if they are not already.
+ */
+
+
+int XLALClusterSnglInspiralColumns(SnglInspiralColumns *table, REAL8 window)
+{
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	XLAL_CHECK(table, XLAL_EFAULT);
+	XLAL_CHECK(window >= 0, XLAL_EINVAL, "window must be >= 0: %g given", window);
+	num_columns = inspiral_columns(table, columns);
+	XLAL_CHECK(sort_by_time(columns, num_columns, table->end, table->length) == 0, XLAL_EFUNC);
+	XLAL_CHECK(cluster(columns, num_columns, &table->length, table->end, table->snr, window) == 0, XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                 sngl_burst
+ *
+ * ============================================================================
+ */
+
+
+static int burst_columns(SnglBurstColumns *table, struct column *columns)
+{
+	int j = 0;
+	columns[j++] = (struct column) {(void **) &table->peak, sizeof(*table->peak)};
+	columns[j++] = (struct column) {(void **) &table->snr, sizeof(*table->snr)};
+	columns[j++] = (struct column) {(void **) &table->duration, sizeof(*table->duration)};
+	columns[j++] = (struct column) {(void **) &table->central_freq, sizeof(*table->central_freq)};
+	columns[j++] = (struct column) {(void **) &table->bandwidth, sizeof(*table->bandwidth)};
+	columns[j++] = (struct column) {(void **) &table->amplitude, sizeof(*table->amplitude)};
+	columns[j++] = (struct column) {(void **) &table->confidence, sizeof(*table->confidence)};
+	columns[j++] = (struct column) {(void **) &table->row, sizeof(*table->row)};
+	return j;
+}
+
+
+/**
+ * Create an empty sngl_burst column table with room for capacity
+ * triggers.  The table grows as needed when triggers are appended.
+ */
+
+
+SnglBurstColumns *XLALCreateSnglBurstColumns(UINT4 capacity)
+{
+	SnglBurstColumns *table = XLALCalloc(1, sizeof(*table));
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+	num_columns = burst_columns(table, columns);
+	table->rows = XLALMalloc((capacity ? capacity : 1) * sizeof(*table->rows));
+	if(!table->rows || resize_arena(columns, num_columns, &table->arena, 0, capacity) < 0) {
+		XLALDestroySnglBurstColumns(table);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	table->capacity = capacity;
+
+	return table;
+}
+
+
+/**
+ * Destroy a sngl_burst column table.
+ */
+
+
+void XLALDestroySnglBurstColumns(SnglBurstColumns *table)
+{
+	if(!table)
+		return;
+	XLALFree(table->rows);
+	XLALFree(table->arena);
+	XLALFree(table);
+}
+
+
+/**
+ * Append a copy of a legacy sngl_burst row.  The next pointer of the row
+ * is ignored.
+ */
+
+
+int XLALSnglBurstColumnsAppend(SnglBurstColumns *table, const SnglBurst *row)
+{
+	UINT4 k;
+
+	XLAL_CHECK(table && row, XLAL_EFAULT);
+
+	if(table->num_rows == table->capacity) {
+		struct column columns[MAX_COLUMNS];
+		int num_columns = burst_columns(table, columns);
+		UINT4 capacity = table->capacity ? 2 * table->capacity : 16;
+		SnglBurst *rows = XLALRealloc(table->rows, capacity * sizeof(*rows));
+		XLAL_CHECK(rows, XLAL_ENOMEM);
+		table->rows = rows;
+		XLAL_CHECK(resize_arena(columns, num_columns, &table->arena, table->length, capacity) == 0, XLAL_EFUNC);
+		table->capacity = capacity;
+	}
+
+	table->rows[table->num_rows] = *row;
+	table->rows[table->num_rows].next = NULL;
+
+	k = table->length;
+	table->peak[k] = XLALGPSToINT8NS(&row->peak_time);
+	table->snr[k] = row->snr;
+	table->duration[k] = row->duration;
+	table->central_freq[k] = row->central_freq;
+	table->bandwidth[k] = row->bandwidth;
+	table->amplitude[k] = row->amplitude;
+	table->confidence[k] = row->confidence;
+	table->row[k] = table->num_rows;
+
+	table->length++;
+	table->num_rows++;
+
+	return 0;
+}
+
+
+/**
+ * Convert a legacy sngl_burst linked list to a column table.  The list is
+ * not modified.
+ */
+
+
+SnglBurstColumns *XLALSnglBurstColumnsFromTable(const SnglBurst *head)
+{
+	const SnglBurst *row;
+	SnglBurstColumns *table;
+	UINT4 n = 0;
+
+	for(row = head; row; row = row->next)
+		n++;
+
+	table = XLALCreateSnglBurstColumns(n);
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+	for(row = head; row; row = row->next)
+		if(XLALSnglBurstColumnsAppend(table, row) < 0) {
+			XLALDestroySnglBurstColumns(table);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		}
+
+	return table;
+}
+
+
+/**
+ * Convert a column table to a newly-allocated legacy sngl_burst linked
+ * list, in the order of the table.  Returns NULL for an empty table.
+ */
+
+
+SnglBurst *XLALSnglBurstColumnsToTable(const SnglBurstColumns *table)
+{
+	SnglBurst *head = NULL;
+	SnglBurst **next = &head;
+	UINT4 k;
+
+	XLAL_CHECK_NULL(table, XLAL_EFAULT);
+
+	for(k = 0; k < table->length; k++) {
+		SnglBurst *row = XLALMalloc(sizeof(*row));
+		if(!row) {
+			while(head) {
+				SnglBurst *tmp = head->next;
+				XLALFree(head);
+				head = tmp;
+			}
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		}
+		*row = table->rows[table->row[k]];
+		XLALINT8NSToGPS(&row->peak_time, table->peak[k]);
+		row->snr = table->snr[k];
+		row->duration = table->duration[k];
+		row->central_freq = table->central_freq[k];
+		row->bandwidth = table->bandwidth[k];
+		row->amplitude = table->amplitude[k];
+		row->confidence = table->confidence[k];
+		row->next = NULL;
+		*next = row;
+		next = &row->next;
+	}
+
+	return head;
+}
+
+
+/**
+ * Sort the triggers by peak time.  The sort is stable.
+ */
+
+
+int XLALSortSnglBurstColumnsByTime(SnglBurstColumns *table)
+{
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	XLAL_CHECK(table, XLAL_EFAULT);
+	num_columns = burst_columns(table, columns);
+	XLAL_CHECK(sort_by_time(columns, num_columns, table->peak, table->length) == 0, XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * Keep the triggers with start <= peak time < end.
+ */
+
+
+int XLALTimeCutSnglBurstColumns(SnglBurstColumns *table, const LIGOTimeGPS *start, const LIGOTimeGPS *end)
+{
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	XLAL_CHECK(table && start && end, XLAL_EFAULT);
+	num_columns = burst_columns(table, columns);
+	XLAL_CHECK(time_cut(columns, num_columns, &table->length, table->peak, start, end) == 0, XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * Keep the triggers with SNR >= snr_min.
+ */
+
+
+int XLALSNRCutSnglBurstColumns(SnglBurstColumns *table, REAL4 snr_min)
+{
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	XLAL_CHECK(table, XLAL_EFAULT);
+	num_columns = burst_columns(table, columns);
+	XLAL_CHECK(snr_cut(columns, num_columns, &table->length, table->snr, snr_min) == 0, XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/**
+ * Cluster the triggers in time, keeping the loudest (by SNR) trigger of
+ * each group of triggers whose peak times are less than window seconds
+ * from the group's loudest trigger.  The triggers are sorted by peak time
+ * first if they are not already.
+ */
+
+
+int XLALClusterSnglBurstColumns(SnglBurstColumns *table, REAL8 window)
+{
+	struct column columns[MAX_COLUMNS];
+	int num_columns;
+
+	XLAL_CHECK(table, XLAL_EFAULT);
+	XLAL_CHECK(window >= 0, XLAL_EINVAL, "window must be >= 0: %g given", window);
+	num_columns = burst_columns(table, columns);
+	XLAL_CHECK(sort_by_time(columns, num_columns, table->peak, table->length) == 0, XLAL_EFUNC);
+	XLAL_CHECK(cluster(columns, num_columns, &table->length, table->peak, table->snr, window) == 0, XLAL_EFUNC);
+
+	return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ * \brief Columnar (struct-of-arrays) storage for sngl_inspiral and sngl_burst
+ * triggers.
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/LIGOMetadataColumns.h>
+ * \endcode
+ *
+ * The linked-list tables ::SnglInspiralTable and ::SnglBurst allocate each
+ * row separately, so sorting, cutting and clustering large trigger sets
+ * chase pointers through memory.  The column tables defined here store the
+ * columns used by those operations (times, SNRs, masses, frequencies) as
+ * contiguous arrays carved from a single allocation (the "arena"), and
+ * keep the remaining columns in an array of legacy rows, which is
+ * referenced through the \c row column and never moved.
+ *
+ * The arrays are authoritative for the columns they hold:  converting back
+ * to a linked list copies them over the corresponding fields of the legacy
+ * rows.  Times are stored as integer GPS nanoseconds.
+ *
+ * Sorting is \f$O(n \log n)\f$ and cuts and time-window clustering are
+ * single linear sweeps over the arrays.
+ */
+
+
+#ifndef _LIGOMETADATACOLUMNS_H
+#define _LIGOMETADATACOLUMNS_H
+
+
+#include <lal/LALDatatypes.h>
+#include <lal/LIGOMetadataTables.h>
+
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+}       /* so that editors will match preceding brace */
+#endif
+
+
+/**
+ * Columnar sngl_inspiral triggers.
+ */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IMMUTABLE_MEMBERS(tagSnglInspiralColumns, length, capacity, num_rows));
+SWIGLAL(IGNORE_MEMBERS(tagSnglInspiralColumns, arena, rows));
+#endif /* SWIG */
+typedef struct tagSnglInspiralColumns {
+#ifdef SWIG /* SWIG interface directives */
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, INT8, end, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, REAL4, snr, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, REAL4, chisq, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, REAL4, mass1, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, REAL4, mass2, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, REAL4, mchirp, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, REAL4, eta, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, REAL4, tau0, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, REAL4, tau3, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglInspiralColumns, UINT4, row, UINT4, length));
+#endif /* SWIG */
+	UINT4 length;		/**< number of triggers */
+	UINT4 capacity;		/**< number of triggers that fit in the arena */
+	INT8 *end;		/**< end times, GPS nanoseconds */
+	REAL4 *snr;		/**< SNRs */
+	REAL4 *chisq;		/**< chi^2 values */
+	REAL4 *mass1;		/**< component mass 1 */
+	REAL4 *mass2;		/**< component mass 2 */
+	REAL4 *mchirp;		/**< chirp masses */
+	REAL4 *eta;		/**< symmetric mass ratios */
+	REAL4 *tau0;		/**< chirp time tau0 */
+	REAL4 *tau3;		/**< chirp time tau3 */
+	UINT4 *row;		/**< index into rows of each trigger's legacy row */
+	UINT4 num_rows;		/**< number of legacy rows in use */
+	SnglInspiralTable *rows;	/**< legacy rows holding the remaining columns */
+	void *arena;		/**< single allocation backing the arrays above */
+} SnglInspiralColumns;
+
+
+/**
+ * Columnar sngl_burst triggers.
+ */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IMMUTABLE_MEMBERS(tagSnglBurstColumns, length, capacity, num_rows));
+SWIGLAL(IGNORE_MEMBERS(tagSnglBurstColumns, arena, rows));
+#endif /* SWIG */
+typedef struct tagSnglBurstColumns {
+#ifdef SWIG /* SWIG interface directives */
+	SWIGLAL(ARRAY_1D(SnglBurstColumns, INT8, peak, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglBurstColumns, REAL4, snr, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglBurstColumns, REAL4, duration, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglBurstColumns, REAL4, central_freq, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglBurstColumns, REAL4, bandwidth, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglBurstColumns, REAL4, amplitude, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglBurstColumns, REAL4, confidence, UINT4, length));
+	SWIGLAL(ARRAY_1D(SnglBurstColumns, UINT4, row, UINT4, length));
+#endif /* SWIG */
+	UINT4 length;		/**< number of triggers */
+	UINT4 capacity;		/**< number of triggers that fit in the arena */
+	INT8 *peak;		/**< peak times, GPS nanoseconds */
+	REAL4 *snr;		/**< SNRs */
+	REAL4 *duration;	/**< durations */
+	REAL4 *central_freq;	/**< central frequencies */
+	REAL4 *bandwidth;	/**< bandwidths */
+	REAL4 *amplitude;	/**< amplitudes */
+	REAL4 *confidence;	/**< confidences */
+	UINT4 *row;		/**< index into rows of each trigger's legacy row */
+	UINT4 num_rows;		/**< number of legacy rows in use */
+	SnglBurst *rows;	/**< legacy rows holding the remaining columns */
+	void *arena;		/**< single allocation backing the arrays above */
+} SnglBurstColumns;
+
+
+/*
+ * sngl_inspiral
+ */
+
+
+SnglInspiralColumns *XLALCreateSnglInspiralColumns(UINT4 capacity);
+void XLALDestroySnglInspiralColumns(SnglInspiralColumns *table);
+int XLALSnglInspiralColumnsAppend(SnglInspiralColumns *table, const SnglInspiralTable *row);
+SnglInspiralColumns *XLALSnglInspiralColumnsFromTable(const SnglInspiralTable *head);
+SnglInspiralTable *XLALSnglInspiralColumnsToTable(const SnglInspiralColumns *table);
+int XLALSortSnglInspiralColumnsByTime(SnglInspiralColumns *table);
+int XLALTimeCutSnglInspiralColumns(SnglInspiralColumns *table, const LIGOTimeGPS *start, const LIGOTimeGPS *end);
+int XLALSNRCutSnglInspiralColumns(SnglInspiralColumns *table, REAL4 snr_min);
+int XLALClusterSnglInspiralColumns(SnglInspiralColumns *table, REAL8 window);
+
+
+/*
+ * sngl_burst
+ */
+
+
+SnglBurstColumns *XLALCreateSnglBurstColumns(UINT4 capacity);
+void XLALDestroySnglBurstColumns(SnglBurstColumns *table);
+int XLALSnglBurstColumnsAppend(SnglBurstColumns *table, const SnglBurst *row);
+SnglBurstColumns *XLALSnglBurstColumnsFromTable(const SnglBurst *head);
+SnglBurst *XLALSnglBurstColumnsToTable(const SnglBurstColumns *table);
+int XLALSortSnglBurstColumnsByTime(SnglBurstColumns *table);
+int XLALTimeCutSnglBurstColumns(SnglBurstColumns *table, const LIGOTimeGPS *start, const LIGOTimeGPS *end);
+int XLALSNRCutSnglBurstColumns(SnglBurstColumns *table, REAL4 snr_min);
+int XLALClusterSnglBurstColumns(SnglBurstColumns *table, REAL8 window);
+
+
+#if 0
+{       /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+
+#endif /* _LIGOMETADATACOLUMNS_H */
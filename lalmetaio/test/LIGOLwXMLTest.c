@@ -0,0 +1,417 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+/*
+ * Tests of the buffered table writers against tables written one row at a
+ * time with XLALFilePrintf(), as the writers used to:  the two files must
+ * be identical byte for byte.  The tables are large enough to fill the row
+ * buffer several times, and hold floating-point values that are awkward to
+ * format:  rounding ties, values at decade boundaries, extreme exponents,
+ * subnormals, infinities and NaNs.
+ */
+
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/FileIO.h>
+#include <lal/LALStdlib.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOMetadataTables.h>
+
+
+/* enough rows of each table to fill the 1 MiB row buffer more than once */
+#define NUM_ROWS 6000
+
+
+#define NEW_FILE "LIGOLwXMLTest-new.xml"
+#define OLD_FILE "LIGOLwXMLTest-old.xml"
+
+
+/*
+ * Values that are awkward to format.  The rounding ties are exact in single
+ * precision for %.8g and in double precision for %.16g.
+ */
+
+
+static const double awkward_values[] = {
+	0.0, 1.0, 0.5, 0.1, 1e-5, 1e-4, 9.9999999e-5, 99999999.0, 999999995.0,
+	123456785.0, 1234567.5, 1234567812345678.5, 0.000123456785,
+	9999999999999999.0, 9.999999999999999e22, 1e22, 1e23, 1e-22, 1e-23,
+	1e300, 1e-300, 4.9406564584124654e-324, 1.17549435e-38, 1.4e-45,
+	3.4028235e38, DBL_MAX, DBL_MIN, 5e-324
+};
+#define NUM_AWKWARD_VALUES (sizeof(awkward_values) / sizeof(*awkward_values))
+
+
+static double test_value(int i)
+{
+	double x;
+
+	if(i % 3 == 0)
+		x = awkward_values[(i / 3) % NUM_AWKWARD_VALUES];
+	else if(i % 101 == 1)
+		x = i % 2 ? INFINITY : NAN;
+	else
+		/* random significand and exponent */
+		x = (rand() + (double) rand() / RAND_MAX) * pow(10.0, rand() % 81 - 50);
+
+	return i % 5 == 4 ? -x : x;
+}
+
+
+static REAL4 test_value_real4(int i)
+{
+	double x = test_value(i);
+
+	/* values out of range of REAL4 become infinities */
+	return fabs(x) > FLT_MAX && isfinite(x) ? copysign(INFINITY, x) : x;
+}
+
+
+/*
+ * Linked lists of test rows.
+ */
+
+
+static SnglBurst *make_sngl_bursts(int n)
+{
+	SnglBurst *head = NULL;
+	int i;
+
+	for(i = n - 1; i >= 0; i--) {
+		SnglBurst *row = XLALCalloc(1, sizeof(*row));
+		if(!row)
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		row->next = head;
+		head = row;
+		row->process_id = i % 7 ? i : LONG_MIN;
+		row->event_id = i % 11 ? i : LONG_MAX;
+		snprintf(row->ifo, sizeof(row->ifo), "%s", i % 2 ? "H1" : "L1");
+		snprintf(row->search, sizeof(row->search), "excesspower");
+		snprintf(row->channel, sizeof(row->channel), "LSC-STRAIN_%d", i % 13);
+		row->start_time.gpsSeconds = i % 17 ? 1000000000 + i : INT_MIN;
+		row->start_time.gpsNanoSeconds = (i * 7919) % 1000000000;
+		row->peak_time.gpsSeconds = i % 19 ? -i : INT_MAX;
+		row->peak_time.gpsNanoSeconds = -(i * 104729) % 1000000000;
+		row->duration = test_value_real4(6 * i);
+		row->central_freq = test_value_real4(6 * i + 1);
+		row->bandwidth = test_value_real4(6 * i + 2);
+		row->amplitude = test_value_real4(6 * i + 3);
+		row->snr = test_value_real4(6 * i + 4);
+		row->confidence = test_value_real4(6 * i + 5);
+		row->chisq = test_value(3 * i + 1);
+		row->chisq_dof = test_value(3 * i + 2);
+	}
+
+	return head;
+}
+
+
+static SimBurst *make_sim_bursts(int n)
+{
+	SimBurst *head = NULL;
+	int i;
+
+	for(i = n - 1; i >= 0; i--) {
+		SimBurst *row = XLALCalloc(1, sizeof(*row));
+		if(!row)
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		row->next = head;
+		head = row;
+		row->process_id = i;
+		snprintf(row->waveform, sizeof(row->waveform), "%s", i % 2 ? "SineGaussian" : "BTLWNB");
+		row->ra = test_value(13 * i);
+		row->dec = test_value(13 * i + 1);
+		row->psi = test_value(13 * i + 2);
+		row->time_geocent_gps.gpsSeconds = 1000000000 + i;
+		row->time_geocent_gps.gpsNanoSeconds = (i * 7919) % 1000000000;
+		row->time_geocent_gmst = test_value(13 * i + 3);
+		row->duration = test_value(13 * i + 4);
+		row->frequency = test_value(13 * i + 5);
+		row->bandwidth = test_value(13 * i + 6);
+		row->q = test_value(13 * i + 7);
+		row->pol_ellipse_angle = test_value(13 * i + 8);
+		row->pol_ellipse_e = test_value(13 * i + 9);
+		row->amplitude = test_value(13 * i + 10);
+		row->hrss = test_value(13 * i + 11);
+		row->egw_over_rsquared = test_value(13 * i + 12);
+		row->waveform_number = i % 3 ? (unsigned long) i * 2654435761u : ULONG_MAX;
+		row->time_slide_id = i % 5;
+		row->simulation_id = i;
+	}
+
+	return head;
+}
+
+
+static void free_sngl_bursts(SnglBurst *head)
+{
+	while(head) {
+		SnglBurst *next = head->next;
+		XLALFree(head);
+		head = next;
+	}
+}
+
+
+static void free_sim_bursts(SimBurst *head)
+{
+	while(head) {
+		SimBurst *next = head->next;
+		XLALFree(head);
+		head = next;
+	}
+}
+
+
+/*
+ * The table writers as they were before rows were buffered.
+ */
+
+
+static int old_write_sngl_burst_table(LIGOLwXMLStream *xml, const SnglBurst *sngl_burst)
+{
+	const char *row_head = "\n\t\t\t";
+
+	/* table header */
+
+	XLALClearErrno();
+	XLALFilePuts("\t<Table Name=\"sngl_burst:table\">\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:ifo\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:search\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:channel\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:duration\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:central_freq\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:bandwidth\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:amplitude\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:snr\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:confidence\" Type=\"real_4\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq_dof\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sngl_burst:event_id\" Type=\"ilwd:char\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Stream Name=\"sngl_burst:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	if(XLALGetBaseErrno())
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* rows */
+
+	for(; sngl_burst; sngl_burst = sngl_burst->next) {
+		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,\"sngl_burst:event_id:%ld\"",
+			row_head,
+			sngl_burst->process_id,
+			sngl_burst->ifo,
+			sngl_burst->search,
+			sngl_burst->channel,
+			sngl_burst->start_time.gpsSeconds,
+			sngl_burst->start_time.gpsNanoSeconds,
+			sngl_burst->peak_time.gpsSeconds,
+			sngl_burst->peak_time.gpsNanoSeconds,
+			sngl_burst->duration,
+			sngl_burst->central_freq,
+			sngl_burst->bandwidth,
+			sngl_burst->amplitude,
+			sngl_burst->snr,
+			sngl_burst->confidence,
+			sngl_burst->chisq,
+			sngl_burst->chisq_dof,
+			sngl_burst->event_id
+		) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		row_head = ",\n\t\t\t";
+	}
+
+	/* table footer */
+
+	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
+static int old_write_sim_burst_table(LIGOLwXMLStream *xml, const SimBurst *sim_burst)
+{
+	const char *row_head = "\n\t\t\t";
+
+	/* table header */
+
+	XLALClearErrno();
+	XLALFilePuts("\t<Table Name=\"sim_burst:table\">\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:waveform\" Type=\"lstring\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:ra\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:dec\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:psi\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gps\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gps_ns\" Type=\"int_4s\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gmst\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:duration\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:frequency\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:bandwidth\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:q\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:pol_ellipse_angle\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:pol_ellipse_e\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:amplitude\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:hrss\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:egw_over_rsquared\" Type=\"real_8\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:waveform_number\" Type=\"int_8u\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"time_slide:time_slide_id\" Type=\"ilwd:char\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Column Name=\"sim_burst:simulation_id\" Type=\"ilwd:char\"/>\n", xml->fp);
+	XLALFilePuts("\t\t<Stream Name=\"sim_burst:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	if(XLALGetBaseErrno())
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* rows */
+
+	for(; sim_burst; sim_burst = sim_burst->next) {
+		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,\"time_slide:time_slide_id:%ld\",\"sim_burst:simulation_id:%ld\"",
+			row_head,
+			sim_burst->process_id,
+			sim_burst->waveform,
+			sim_burst->ra,
+			sim_burst->dec,
+			sim_burst->psi,
+			sim_burst->time_geocent_gps.gpsSeconds,
+			sim_burst->time_geocent_gps.gpsNanoSeconds,
+			sim_burst->time_geocent_gmst,
+			sim_burst->duration,
+			sim_burst->frequency,
+			sim_burst->bandwidth,
+			sim_burst->q,
+			sim_burst->pol_ellipse_angle,
+			sim_burst->pol_ellipse_e,
+			sim_burst->amplitude,
+			sim_burst->hrss,
+			sim_burst->egw_over_rsquared,
+			sim_burst->waveform_number,
+			sim_burst->time_slide_id,
+			sim_burst->simulation_id
+		) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		row_head = ",\n\t\t\t";
+	}
+
+	/* table footer */
+
+	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/*
+ * Write the tables to a file with the buffered writers or the old ones.
+ */
+
+
+static int write_tables(const char *path, const SnglBurst *sngl_bursts, const SimBurst *sim_bursts, int old)
+{
+	LIGOLwXMLStream *xml = XLALOpenLIGOLwXMLFile(path);
+	if(!xml)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	if(old) {
+		if(old_write_sngl_burst_table(xml, sngl_bursts) < 0 || old_write_sim_burst_table(xml, sim_bursts) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+	} else {
+		if(XLALWriteLIGOLwXMLSnglBurstTable(xml, sngl_bursts) < 0 || XLALWriteLIGOLwXMLSimBurstTable(xml, sim_bursts) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	if(XLALCloseLIGOLwXMLFile(xml) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/*
+ * Compare two files byte for byte.
+ */
+
+
+static int compare_files(const char *path1, const char *path2)
+{
+	FILE *fp1 = fopen(path1, "rb");
+	FILE *fp2 = fopen(path2, "rb");
+	long offset = 0;
+	int c1, c2;
+
+	if(!fp1 || !fp2) {
+		if(fp1)
+			fclose(fp1);
+		if(fp2)
+			fclose(fp2);
+		XLAL_ERROR(XLAL_EIO, "cannot open %s or %s", path1, path2);
+	}
+
+	do {
+		c1 = getc(fp1);
+		c2 = getc(fp2);
+		offset++;
+	} while(c1 == c2 && c1 != EOF);
+
+	fclose(fp1);
+	fclose(fp2);
+
+	if(c1 != c2)
+		XLAL_ERROR(XLAL_EFAILED, "%s and %s differ at byte %ld", path1, path2, offset);
+	XLALPrintInfo("%s: %s and %s are identical, %ld bytes\n", __func__, path1, path2, offset - 1);
+
+	return 0;
+}
+
+
+int main(void)
+{
+	SnglBurst *sngl_bursts;
+	SimBurst *sim_bursts;
+
+	srand(1234);
+	sngl_bursts = make_sngl_bursts(NUM_ROWS);
+	sim_bursts = make_sim_bursts(NUM_ROWS);
+	XLAL_CHECK_MAIN(sngl_bursts && sim_bursts, XLAL_EFUNC);
+
+	XLAL_CHECK_MAIN(write_tables(NEW_FILE, sngl_bursts, sim_bursts, 0) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(write_tables(OLD_FILE, sngl_bursts, sim_bursts, 1) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(compare_files(NEW_FILE, OLD_FILE) == 0, XLAL_EFUNC);
+
+	/* empty tables */
+	XLAL_CHECK_MAIN(write_tables(NEW_FILE, NULL, NULL, 0) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(write_tables(OLD_FILE, NULL, NULL, 1) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(compare_files(NEW_FILE, OLD_FILE) == 0, XLAL_EFUNC);
+
+	remove(NEW_FILE);
+	remove(OLD_FILE);
+
+	free_sngl_bursts(sngl_bursts);
+	free_sim_bursts(sim_bursts);
+
+	LALCheckMemoryLeaks();
+	return 0;
+}
@@ -0,0 +1,402 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+/*
+ * Tests of the column tables against the linked-list tables they mirror:
+ * round trips through the column tables, growth by appending, and sorting,
+ * cuts and clustering compared with direct computations on the rows.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/Date.h>
+#include <lal/LALStdlib.h>
+#include <lal/LIGOMetadataColumns.h>
+#include <lal/LIGOMetadataTables.h>
+
+
+/* more than the initial capacity of the tables, so that they must grow */
+#define NUM_TRIGGERS 1000
+
+
+/*
+ * Linked lists of test triggers.  The times are scrambled, and repeat so
+ * that sorting has ties to keep in order.
+ */
+
+
+static INT8 trigger_time(int i)
+{
+	return 1000000000 * (INT8) 1000000000 + ((INT8) (i * 7919) % 400) * 12345678 + i % 2;
+}
+
+
+static SnglInspiralTable *make_inspirals(int n)
+{
+	SnglInspiralTable *head = NULL;
+	int i;
+
+	for(i = n - 1; i >= 0; i--) {
+		SnglInspiralTable *row = XLALCalloc(1, sizeof(*row));
+		if(!row)
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		row->next = head;
+		head = row;
+		row->process_id = 7;
+		row->event_id = i;
+		snprintf(row->ifo, sizeof(row->ifo), "%s", i % 2 ? "H1" : "L1");
+		snprintf(row->search, sizeof(row->search), "test");
+		XLALINT8NSToGPS(&row->end, trigger_time(i));
+		row->snr = 5 + (i * 37) % 101 / 10.0;
+		row->chisq = i % 17;
+		row->mass1 = 1 + i % 5;
+		row->mass2 = 1 + i % 3;
+		row->mchirp = 1.2 + i % 7 / 10.0;
+		row->eta = 0.25 - i % 5 / 100.0;
+		row->tau0 = 10 + i % 11;
+		row->tau3 = 1 + i % 13 / 10.0;
+		/* columns not held in arrays */
+		row->coa_phase = i / 10.0;
+		row->eff_distance = 100 + i;
+	}
+
+	return head;
+}
+
+
+static SnglBurst *make_bursts(int n)
+{
+	SnglBurst *head = NULL;
+	int i;
+
+	for(i = n - 1; i >= 0; i--) {
+		SnglBurst *row = XLALCalloc(1, sizeof(*row));
+		if(!row)
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		row->next = head;
+		head = row;
+		row->process_id = 7;
+		row->event_id = i;
+		snprintf(row->ifo, sizeof(row->ifo), "%s", i % 2 ? "H1" : "L1");
+		snprintf(row->search, sizeof(row->search), "excesspower");
+		XLALINT8NSToGPS(&row->peak_time, trigger_time(i));
+		row->start_time = row->peak_time;
+		XLALGPSAdd(&row->start_time, -0.0625);
+		row->snr = 5 + (i * 37) % 101 / 10.0;
+		row->duration = 0.125;
+		row->central_freq = 100 + i % 64;
+		row->bandwidth = 1 << (i % 4);
+		row->amplitude = 1e-21 * (1 + i % 9);
+		row->confidence = 10 + i % 23;
+		/* columns not held in arrays */
+		row->chisq = i % 17;
+		row->chisq_dof = 2;
+	}
+
+	return head;
+}
+
+
+static void free_inspirals(SnglInspiralTable *head)
+{
+	while(head) {
+		SnglInspiralTable *next = head->next;
+		XLALFree(head);
+		head = next;
+	}
+}
+
+
+static void free_bursts(SnglBurst *head)
+{
+	while(head) {
+		SnglBurst *next = head->next;
+		XLALFree(head);
+		head = next;
+	}
+}
+
+
+/*
+ * Row comparisons, covering both the columns held in arrays and the ones
+ * held in the legacy rows.
+ */
+
+
+static int inspirals_equal(const SnglInspiralTable *a, const SnglInspiralTable *b)
+{
+	return a->process_id == b->process_id && a->event_id == b->event_id && !strcmp(a->ifo, b->ifo) && !strcmp(a->search, b->search) && !XLALGPSCmp(&a->end, &b->end) && a->snr == b->snr && a->chisq == b->chisq && a->mass1 == b->mass1 && a->mass2 == b->mass2 && a->mchirp == b->mchirp && a->eta == b->eta && a->tau0 == b->tau0 && a->tau3 == b->tau3 && a->coa_phase == b->coa_phase && a->eff_distance == b->eff_distance;
+}
+
+
+static int bursts_equal(const SnglBurst *a, const SnglBurst *b)
+{
+	return a->process_id == b->process_id && a->event_id == b->event_id && !strcmp(a->ifo, b->ifo) && !strcmp(a->search, b->search) && !XLALGPSCmp(&a->start_time, &b->start_time) && !XLALGPSCmp(&a->peak_time, &b->peak_time) && a->snr == b->snr && a->duration == b->duration && a->central_freq == b->central_freq && a->bandwidth == b->bandwidth && a->amplitude == b->amplitude && a->confidence == b->confidence && a->chisq == b->chisq && a->chisq_dof == b->chisq_dof;
+}
+
+
+/*
+ * The expected results of sorting, cutting and clustering, computed from
+ * an array of the rows.
+ */
+
+
+static int compare_event_id(long a, long b)
+{
+	return a > b ? +1 : (a < b ? -1 : 0);
+}
+
+
+/* stable sort by time:  ties are ordered by event ID, which is the input order */
+static int compare_inspiral_rows(const void *a, const void *b)
+{
+	const SnglInspiralTable *A = *(const SnglInspiralTable * const *) a;
+	const SnglInspiralTable *B = *(const SnglInspiralTable * const *) b;
+	INT8 ta = XLALGPSToINT8NS(&A->end), tb = XLALGPSToINT8NS(&B->end);
+
+	if(ta != tb)
+		return ta > tb ? +1 : -1;
+	return compare_event_id(A->event_id, B->event_id);
+}
+
+
+static int compare_burst_rows(const void *a, const void *b)
+{
+	const SnglBurst *A = *(const SnglBurst * const *) a;
+	const SnglBurst *B = *(const SnglBurst * const *) b;
+	INT8 ta = XLALGPSToINT8NS(&A->peak_time), tb = XLALGPSToINT8NS(&B->peak_time);
+
+	if(ta != tb)
+		return ta > tb ? +1 : -1;
+	return compare_event_id(A->event_id, B->event_id);
+}
+
+
+/* time-window clustering of time-ordered rows */
+static int cluster_rows(const void **rows, int n, const INT8 *t, const REAL4 *snr, INT8 window_ns, const void **kept)
+{
+	int i, best = 0, m = 0;
+
+	for(i = 1; i < n; i++) {
+		if(t[i] - t[best] < window_ns) {
+			if(snr[i] > snr[best])
+				best = i;
+		} else {
+			kept[m++] = rows[best];
+			best = i;
+		}
+	}
+	if(n)
+		kept[m++] = rows[best];
+
+	return m;
+}
+
+
+/*
+ * sngl_inspiral
+ */
+
+
+static int check_inspiral_list(const SnglInspiralTable *head, const SnglInspiralTable **expected, int n, const char *what)
+{
+	int i;
+
+	for(i = 0; i < n; i++, head = head->next)
+		XLAL_CHECK(head && inspirals_equal(head, expected[i]), XLAL_EFAILED, "%s: sngl_inspiral row %d differs", what, i);
+	XLAL_CHECK(!head, XLAL_EFAILED, "%s: too many sngl_inspiral rows", what);
+
+	return 0;
+}
+
+
+static int test_inspiral(void)
+{
+	SnglInspiralTable *head = make_inspirals(NUM_TRIGGERS);
+	const SnglInspiralTable *rows[NUM_TRIGGERS], *kept[NUM_TRIGGERS];
+	const SnglInspiralTable *row;
+	SnglInspiralColumns *table, *grown;
+	SnglInspiralTable *out;
+	INT8 t[NUM_TRIGGERS];
+	REAL4 snr[NUM_TRIGGERS];
+	LIGOTimeGPS start, end;
+	const REAL8 window = 0.05;
+	int i, n, num_cut;
+
+	XLAL_CHECK(head, XLAL_EFUNC);
+	for(i = 0, row = head; row; row = row->next)
+		rows[i++] = row;
+
+	/* round trip */
+	table = XLALSnglInspiralColumnsFromTable(head);
+	XLAL_CHECK(table && table->length == NUM_TRIGGERS, XLAL_EFUNC);
+	out = XLALSnglInspiralColumnsToTable(table);
+	XLAL_CHECK(check_inspiral_list(out, rows, NUM_TRIGGERS, "round trip") == 0, XLAL_EFUNC);
+	free_inspirals(out);
+
+	/* appending to a table with room for one trigger grows it */
+	grown = XLALCreateSnglInspiralColumns(1);
+	XLAL_CHECK(grown, XLAL_EFUNC);
+	for(row = head; row; row = row->next)
+		XLAL_CHECK(XLALSnglInspiralColumnsAppend(grown, row) == 0, XLAL_EFUNC);
+	XLAL_CHECK(grown->length == NUM_TRIGGERS && grown->capacity >= NUM_TRIGGERS, XLAL_EFAILED);
+	out = XLALSnglInspiralColumnsToTable(grown);
+	XLAL_CHECK(check_inspiral_list(out, rows, NUM_TRIGGERS, "append") == 0, XLAL_EFUNC);
+	free_inspirals(out);
+	XLALDestroySnglInspiralColumns(grown);
+
+	/* sorting */
+	qsort(rows, NUM_TRIGGERS, sizeof(*rows), compare_inspiral_rows);
+	XLAL_CHECK(XLALSortSnglInspiralColumnsByTime(table) == 0, XLAL_EFUNC);
+	out = XLALSnglInspiralColumnsToTable(table);
+	XLAL_CHECK(check_inspiral_list(out, rows, NUM_TRIGGERS, "sort") == 0, XLAL_EFUNC);
+	free_inspirals(out);
+
+	/* time and SNR cuts */
+	XLALINT8NSToGPS(&start, trigger_time(0) + (INT8) 100 * 12345678);
+	XLALINT8NSToGPS(&end, trigger_time(0) + (INT8) 300 * 12345678);
+	for(i = n = 0; i < NUM_TRIGGERS; i++)
+		if(XLALGPSCmp(&rows[i]->end, &start) >= 0 && XLALGPSCmp(&rows[i]->end, &end) < 0 && rows[i]->snr >= 8)
+			rows[n++] = rows[i];
+	XLAL_CHECK(XLALTimeCutSnglInspiralColumns(table, &start, &end) == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALSNRCutSnglInspiralColumns(table, 8) == 0, XLAL_EFUNC);
+	out = XLALSnglInspiralColumnsToTable(table);
+	XLAL_CHECK(check_inspiral_list(out, rows, n, "cuts") == 0, XLAL_EFUNC);
+	free_inspirals(out);
+
+	/* clustering */
+	num_cut = n;
+	for(i = 0; i < n; i++) {
+		t[i] = XLALGPSToINT8NS(&rows[i]->end);
+		snr[i] = rows[i]->snr;
+	}
+	n = cluster_rows((const void **) rows, n, t, snr, window * XLAL_BILLION_INT8, (const void **) kept);
+	XLAL_CHECK(XLALClusterSnglInspiralColumns(table, window) == 0, XLAL_EFUNC);
+	out = XLALSnglInspiralColumnsToTable(table);
+	XLAL_CHECK(n > 1 && n < num_cut, XLAL_EFAILED, "clustering test is not sensitive");
+	XLAL_CHECK(check_inspiral_list(out, kept, n, "clustering") == 0, XLAL_EFUNC);
+	free_inspirals(out);
+
+	XLALDestroySnglInspiralColumns(table);
+	free_inspirals(head);
+
+	return 0;
+}
+
+
+/*
+ * sngl_burst
+ */
+
+
+static int check_burst_list(const SnglBurst *head, const SnglBurst **expected, int n, const char *what)
+{
+	int i;
+
+	for(i = 0; i < n; i++, head = head->next)
+		XLAL_CHECK(head && bursts_equal(head, expected[i]), XLAL_EFAILED, "%s: sngl_burst row %d differs", what, i);
+	XLAL_CHECK(!head, XLAL_EFAILED, "%s: too many sngl_burst rows", what);
+
+	return 0;
+}
+
+
+static int test_burst(void)
+{
+	SnglBurst *head = make_bursts(NUM_TRIGGERS);
+	const SnglBurst *rows[NUM_TRIGGERS], *kept[NUM_TRIGGERS];
+	const SnglBurst *row;
+	SnglBurstColumns *table, *grown;
+	SnglBurst *out;
+	INT8 t[NUM_TRIGGERS];
+	REAL4 snr[NUM_TRIGGERS];
+	LIGOTimeGPS start, end;
+	const REAL8 window = 0.05;
+	int i, n, num_cut;
+
+	XLAL_CHECK(head, XLAL_EFUNC);
+	for(i = 0, row = head; row; row = row->next)
+		rows[i++] = row;
+
+	/* round trip */
+	table = XLALSnglBurstColumnsFromTable(head);
+	XLAL_CHECK(table && table->length == NUM_TRIGGERS, XLAL_EFUNC);
+	out = XLALSnglBurstColumnsToTable(table);
+	XLAL_CHECK(check_burst_list(out, rows, NUM_TRIGGERS, "round trip") == 0, XLAL_EFUNC);
+	free_bursts(out);
+
+	/* appending to an empty table grows it */
+	grown = XLALCreateSnglBurstColumns(0);
+	XLAL_CHECK(grown, XLAL_EFUNC);
+	for(row = head; row; row = row->next)
+		XLAL_CHECK(XLALSnglBurstColumnsAppend(grown, row) == 0, XLAL_EFUNC);
+	XLAL_CHECK(grown->length == NUM_TRIGGERS && grown->capacity >= NUM_TRIGGERS, XLAL_EFAILED);
+	out = XLALSnglBurstColumnsToTable(grown);
+	XLAL_CHECK(check_burst_list(out, rows, NUM_TRIGGERS, "append") == 0, XLAL_EFUNC);
+	free_bursts(out);
+	XLALDestroySnglBurstColumns(grown);
+
+	/* sorting */
+	qsort(rows, NUM_TRIGGERS, sizeof(*rows), compare_burst_rows);
+	XLAL_CHECK(XLALSortSnglBurstColumnsByTime(table) == 0, XLAL_EFUNC);
+	out = XLALSnglBurstColumnsToTable(table);
+	XLAL_CHECK(check_burst_list(out, rows, NUM_TRIGGERS, "sort") == 0, XLAL_EFUNC);
+	free_bursts(out);
+
+	/* time and SNR cuts */
+	XLALINT8NSToGPS(&start, trigger_time(0) + (INT8) 100 * 12345678);
+	XLALINT8NSToGPS(&end, trigger_time(0) + (INT8) 300 * 12345678);
+	for(i = n = 0; i < NUM_TRIGGERS; i++)
+		if(XLALGPSCmp(&rows[i]->peak_time, &start) >= 0 && XLALGPSCmp(&rows[i]->peak_time, &end) < 0 && rows[i]->snr >= 8)
+			rows[n++] = rows[i];
+	XLAL_CHECK(XLALTimeCutSnglBurstColumns(table, &start, &end) == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALSNRCutSnglBurstColumns(table, 8) == 0, XLAL_EFUNC);
+	out = XLALSnglBurstColumnsToTable(table);
+	XLAL_CHECK(check_burst_list(out, rows, n, "cuts") == 0, XLAL_EFUNC);
+	free_bursts(out);
+
+	/* clustering */
+	num_cut = n;
+	for(i = 0; i < n; i++) {
+		t[i] = XLALGPSToINT8NS(&rows[i]->peak_time);
+		snr[i] = rows[i]->snr;
+	}
+	n = cluster_rows((const void **) rows, n, t, snr, window * XLAL_BILLION_INT8, (const void **) kept);
+	XLAL_CHECK(XLALClusterSnglBurstColumns(table, window) == 0, XLAL_EFUNC);
+	out = XLALSnglBurstColumnsToTable(table);
+	XLAL_CHECK(n > 1 && n < num_cut, XLAL_EFAILED, "clustering test is not sensitive");
+	XLAL_CHECK(check_burst_list(out, kept, n, "clustering") == 0, XLAL_EFUNC);
+	free_bursts(out);
+
+	XLALDestroySnglBurstColumns(table);
+	free_bursts(head);
+
+	return 0;
+}
+
+
+int main(void)
+{
+	XLAL_CHECK_MAIN(test_inspiral() == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_burst() == 0, XLAL_EFUNC);
+
+	LALCheckMemoryLeaks();
+	return 0;
+}
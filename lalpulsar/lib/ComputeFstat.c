@@ -50,7 +50,7 @@ struct tagFstatInput {
 
 // ---------- Internal prototypes ---------- //
 
-static int XLALSelectBestFstatMethod ( FstatMethodType *method );
+static int XLALSelectBestFstatMethod ( FstatMethodType *method, UINT4 Dterms );
 
 int XLALSetupFstatDemod  ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
 int XLALSetupFstatResamp ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
@@ -66,6 +66,9 @@ static const char *const FstatMethodNames[FMETHOD_END] = {
 
   [FMETHOD_RESAMP_GENERIC]	= "ResampGeneric",
   [FMETHOD_RESAMP_BEST]		= "ResampBest",
+
+  [FMETHOD_DEMOD_AVX2]		= "DemodAVX2",
+  [FMETHOD_DEMOD_AVX512]	= "DemodAVX512",
 };
 
 const FstatOptionalArgs FstatOptionalArgsDefaults = {
@@ -376,7 +379,7 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
   // Check optional Fstat method type argument
   XLAL_CHECK_NULL ( ( FMETHOD_START < optArgs.FstatMethod ) && ( optArgs.FstatMethod < FMETHOD_END ), XLAL_EINVAL );
   XLAL_CHECK_NULL ( FstatMethodNames[optArgs.FstatMethod] != NULL, XLAL_EFAULT );
-  XLAL_CHECK_NULL ( XLALSelectBestFstatMethod( &optArgs.FstatMethod ) == XLAL_SUCCESS, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( XLALSelectBestFstatMethod( &optArgs.FstatMethod, optArgs.Dterms ) == XLAL_SUCCESS, XLAL_EFAULT );
 
   //
   // Parse which F-statistic method to use, and set these variables:
@@ -411,6 +414,13 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
     setupFuncMethod = XLALSetupFstatDemod;
     break;
 
+  case FMETHOD_DEMOD_AVX2:		// Demod: AVX2/FMA hotloop variant
+  case FMETHOD_DEMOD_AVX512:		// Demod: AVX-512 hotloop variant
+    XLAL_CHECK_NULL ( optArgs.Dterms > 0, XLAL_EINVAL );
+    extraBinsMethod = optArgs.Dterms;
+    setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
   case FMETHOD_RESAMP_GENERIC:		// Resamp: generic implementation
     extraBinsMethod = 8;   // use 8 extra bins to give better agreement with Demod(w Dterms=8) near the boundaries
     setupFuncMethod = XLALSetupFstatResamp;
@@ -864,7 +874,7 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
   }
   if ( input->common.isTimeslice )
     {
-      XLAL_CHECK_VOID ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL,
+      XLAL_CHECK_VOID ( XLALFstatMethodIsDemod ( input->method ), XLAL_EINVAL,
                         "Something is wrong: 'isTimeslice==TRUE' for non-LALDemod F-stat method '%s' is not supported!\n", XLALGetFstatInputMethodName(input));
       XLALDestroyFstatInputTimeslice_common ( &input->common );
       XLALDestroyFstatInputTimeslice_Demod ( input->method_data);
@@ -1058,14 +1068,28 @@ XLALComputeFstatFromAtoms ( const MultiFstatAtomVector *multiFstatAtoms,   ///<
 } // XLALComputeFstatFromAtoms()
 
 ///
-/// If user asks for a 'best' #FstatMethodType, find and select it
+/// If user asks for a 'best' #FstatMethodType, find and select it; some \a Demod methods depend on \p Dterms
 ///
 static int
-XLALSelectBestFstatMethod ( FstatMethodType *method )
+XLALSelectBestFstatMethod ( FstatMethodType *method, UINT4 Dterms )
 {
   switch ( *method ) {
 
   case FMETHOD_DEMOD_BEST:
+    // The AVX-512 and AVX2 hotloops work for any Dterms, but are appended after FMETHOD_RESAMP_BEST
+    // (see below), so check for them first; for Dterms == 8, the SSE and Altivec hotloops are preferred
+    if ( Dterms != 8 ) {
+      const FstatMethodType anyDtermsMethods[] = { FMETHOD_DEMOD_AVX512, FMETHOD_DEMOD_AVX2 };
+      for ( size_t i = 0; i < XLAL_NUM_ELEM(anyDtermsMethods); ++i ) {
+        if ( XLALFstatMethodIsAvailable( anyDtermsMethods[i] ) ) {
+          *method = anyDtermsMethods[i];
+          XLALPrintInfo( "%s: Fstat method '%s' is available; selected as best method for Dterms=%u\n", __func__, FstatMethodNames[*method], Dterms );
+          return XLAL_SUCCESS;
+        }
+      }
+    }
+    /* fall through */
+
   case FMETHOD_RESAMP_BEST:
     // If user asks for a 'best' method:
     //   Decrement the current method, then check for the first available Fstat method. This assumes the FstatMethodType enum is ordered as follows:
@@ -1073,6 +1097,7 @@ XLALSelectBestFstatMethod ( FstatMethodType *method )
     //     FMETHOD_..._OPTIMISED,    (always avaiable)
     //     FMETHOD_..._SUPERFAST     (not always available; requires special hardware)
     //     FMETHOD_..._BEST          (must **always** avaiable)
+    //   Methods appended after FMETHOD_RESAMP_BEST must therefore be selected explicitly, as above.
     XLALPrintInfo( "%s: trying to find best available Fstat method for '%s'\n", __func__, FstatMethodNames[*method] );
     while ( !XLALFstatMethodIsAvailable( --( *method ) ) ) {
       XLAL_CHECK ( FMETHOD_START < *method, XLAL_EFAILED );
@@ -1090,6 +1115,24 @@ XLALSelectBestFstatMethod ( FstatMethodType *method )
   return XLAL_SUCCESS;
 }
 
+///
+/// Return true if given #FstatMethodType is a \a Demod method, false otherwise
+///
+int
+XLALFstatMethodIsDemod ( FstatMethodType method )
+{
+  return ( FMETHOD_DEMOD_GENERIC <= method && method <= FMETHOD_DEMOD_BEST ) || method == FMETHOD_DEMOD_AVX2 || method == FMETHOD_DEMOD_AVX512;
+}
+
+///
+/// Return true if given #FstatMethodType is a \a Resamp method, false otherwise
+///
+int
+XLALFstatMethodIsResamp ( FstatMethodType method )
+{
+  return ( FMETHOD_RESAMP_GENERIC <= method && method <= FMETHOD_RESAMP_BEST );
+}
+
 ///
 /// Return true if given #FstatMethodType corresponds to a valid and *available* Fstat method, false otherwise
 ///
@@ -1126,6 +1169,24 @@ XLALFstatMethodIsAvailable ( FstatMethodType method )
     return 0;
 #endif
 
+  case FMETHOD_DEMOD_AVX2:
+    // This method is available only if compiled with AVX2 support,
+    // and AVX2 is available on the current execution machine
+#ifdef HAVE_AVX2_COMPILER
+    return LAL_HAVE_AVX2_RUNTIME();
+#else
+    return 0;
+#endif
+
+  case FMETHOD_DEMOD_AVX512:
+    // This method is available only if compiled with AVX-512 support,
+    // and AVX-512 is available on the current execution machine
+#ifdef HAVE_AVX512F_COMPILER
+    return LAL_HAVE_AVX512F_RUNTIME();
+#else
+    return 0;
+#endif
+
   default:
     return 0;
 
@@ -1162,7 +1223,7 @@ XLALFstatMethodChoices ( void )
             continue;
           }
           FstatMethodType bm = m;
-          XLAL_CHECK_NULL ( XLALSelectBestFstatMethod( &bm ) == XLAL_SUCCESS, XLAL_EFAULT );
+          XLAL_CHECK_NULL ( XLALSelectBestFstatMethod( &bm, FstatOptionalArgsDefaults.Dterms ) == XLAL_SUCCESS, XLAL_EFAULT );
           if ( bm == m ) {
             // add an Fstat method
             choices[i].name = FstatMethodNames[m];
@@ -1199,11 +1260,11 @@ XLALGetFstatTiming ( const FstatInput* input, FstatTimingGeneric *timingGeneric,
   XLAL_CHECK ( timingGeneric != NULL, XLAL_EINVAL );
   XLAL_CHECK ( timingModel != NULL, XLAL_EINVAL );
 
-  if ( input->method >= FMETHOD_DEMOD_GENERIC && input->method <= FMETHOD_DEMOD_BEST)
+  if ( XLALFstatMethodIsDemod ( input->method ) )
     {
       XLAL_CHECK ( XLALGetFstatTiming_Demod ( input->method_data, timingGeneric, timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
-  else if ( input->method >= FMETHOD_RESAMP_GENERIC && input->method <= FMETHOD_RESAMP_BEST)
+  else if ( XLALFstatMethodIsResamp ( input->method ) )
     {
       XLAL_CHECK ( XLALGetFstatTiming_Resamp ( input->method_data, timingGeneric, timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
@@ -1272,7 +1333,7 @@ XLALExtractResampledTimeseries ( MultiCOMPLEX8TimeSeries **multiTimeSeries_SRC_a
 {
   XLAL_CHECK ( input != NULL, XLAL_EINVAL );
   XLAL_CHECK ( ( multiTimeSeries_SRC_a != NULL ) && ( multiTimeSeries_SRC_b != NULL ) , XLAL_EINVAL );
-  XLAL_CHECK ( (input->method >= FMETHOD_RESAMP_GENERIC) && (input->method <= FMETHOD_RESAMP_BEST), XLAL_EINVAL,
+  XLAL_CHECK ( XLALFstatMethodIsResamp ( input->method ), XLAL_EINVAL,
                "%s() only works for resampling-Fstat methods, not with '%s'\n", __func__, XLALGetFstatInputMethodName ( input ) );
 
   XLAL_CHECK ( XLALExtractResampledTimeseries_intern ( multiTimeSeries_SRC_a, multiTimeSeries_SRC_b, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1306,7 +1367,7 @@ XLALFstatInputTimeslice ( FstatInput ** slice,                ///< [out] Address
               LAL_GPS_PRINT(*minStartGPS), LAL_GPS_PRINT(*maxStartGPS) );
 
   // only supported for 'LALDemod' Fstat methods
-  XLAL_CHECK ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL, "This function is not avavible for the chosen FstatMethod '%s'!", XLALGetFstatInputMethodName ( input ) );
+  XLAL_CHECK ( XLALFstatMethodIsDemod ( input->method ), XLAL_EINVAL, "This function is not avavible for the chosen FstatMethod '%s'!", XLALGetFstatInputMethodName ( input ) );
 
   const FstatCommon *common = &(input->common);
   UINT4 numIFOs = common->detectors.length;
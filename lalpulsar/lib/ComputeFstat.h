@@ -116,11 +116,16 @@ typedef enum tagFstatMethodType {
   FMETHOD_DEMOD_OPTC,		///< \a Demod: gptimized C hotloop using Akos' algorithm, only works for \f$\text{Dterms} \lesssim 20\f$
   FMETHOD_DEMOD_ALTIVEC,	///< \a Demod: Altivec hotloop variant, uses fixed \f$\text{Dterms} = 8\f$
   FMETHOD_DEMOD_SSE,		///< \a Demod: SSE hotloop with precalc divisors, uses fixed \f$\text{Dterms} = 8\f$
-  FMETHOD_DEMOD_BEST,		///< \a Demod: best guess of the fastest available hotloop
+  FMETHOD_DEMOD_BEST,		///< \a Demod: best guess of the fastest available hotloop for the given \f$\text{Dterms}\f$
 
   FMETHOD_RESAMP_GENERIC,	///< \a Resamp: generic implementation
   FMETHOD_RESAMP_BEST,		///< \a Resamp: best guess of the fastest available implementation
 
+  // \a Demod hotloops added after the \a Resamp methods, so as not to change the values of existing methods;
+  // use XLALFstatMethodIsDemod() and XLALFstatMethodIsResamp() to classify a method, not comparisons of values
+  FMETHOD_DEMOD_AVX2,		///< \a Demod: AVX2/FMA hotloop variant, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
+  FMETHOD_DEMOD_AVX512,		///< \a Demod: AVX-512 hotloop variant, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
+
   /// \cond DONT_DOXYGEN
   FMETHOD_END
   /// \endcond
@@ -328,6 +333,8 @@ REAL8 XLALFstatMaximumSFTLength ( const REAL8 maxFreq, const REAL8 binaryMaxAsin
 int XLALFstatCheckSFTLengthMismatch ( const REAL8 Tsft, const REAL8 maxFreq, const REAL8 binaryMaxAsini, const REAL8 binaryMinPeriod, const REAL8 allowedMismatch );
 
 int XLALFstatMethodIsAvailable ( FstatMethodType method );
+int XLALFstatMethodIsDemod ( FstatMethodType method );
+int XLALFstatMethodIsResamp ( FstatMethodType method );
 const CHAR *XLALFstatMethodName ( FstatMethodType method );
 const UserChoices *XLALFstatMethodChoices ( void );
 
@@ -0,0 +1,84 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+
+/// [hotloop]
+/** AVX-512 version: sums 8 frequency bins per vector, works for any Dterms */
+{
+  {
+    /* NOTE: the Dirichlet kernel factorises as
+     *   P_alpha_k = [ sin(2pi kappa_star) + i (cos(2pi kappa_star) - 1) ] / x_k,
+     * with x_k = kappa_star + Dterms - 1 - l, so we first accumulate U + iV = sum_k X_alpha_k / x_k
+     * and multiply by the common numerator only once at the end.
+     * The integer part of x_k is formed exactly before kappa_star is added, so that
+     * the divisors closest to zero are not swamped by rounding errors.
+     */
+    const UINT4 numBins = 2 * Dterms;
+    const REAL4 kappa_s = kappa_star;  /* single precision version of kappa_star */
+    const REAL4 n_max = 1.0f * Dterms - 1.0f;
+
+    /* each __m512 holds 8 interleaved (re,im) bins, which share a divisor */
+    const __m512 kappa_v = _mm512_set1_ps ( kappa_s );
+    const __m512 two_v = _mm512_set1_ps ( 2.0f );
+    const __m512 eight_v = _mm512_set1_ps ( 8.0f );
+    __m512 n_v = _mm512_sub_ps ( _mm512_set1_ps ( n_max ),
+                                 _mm512_setr_ps ( 0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f,
+                                                  4.0f, 4.0f, 5.0f, 5.0f, 6.0f, 6.0f, 7.0f, 7.0f ) );
+    __m512 XSum_v = _mm512_setzero_ps();
+
+    for ( UINT4 l = 0; l < numBins; l += 8 )
+      {
+        /* the last, partial vector is masked: masked-out lanes load zeros and contribute nothing */
+        const UINT4 numLeft = numBins - l;
+        const __mmask16 mask = ( numLeft >= 8 ) ? 0xFFFF : (__mmask16) ( ( 1U << ( 2 * numLeft ) ) - 1 );
+        __m512 Xa_v = _mm512_maskz_loadu_ps ( mask, (const float*) (Xalpha_l + l) );
+        __m512 x_v = _mm512_add_ps ( n_v, kappa_v );
+
+        /* 14-bit reciprocal estimate, refined by one Newton-Raphson step to full single precision */
+        __m512 xinv_v = _mm512_maskz_rcp14_ps ( mask, x_v );
+        xinv_v = _mm512_mul_ps ( xinv_v, _mm512_fnmadd_ps ( x_v, xinv_v, two_v ) );
+        XSum_v = _mm512_fmadd_ps ( Xa_v, xinv_v, XSum_v );
+
+        n_v = _mm512_sub_ps ( n_v, eight_v );
+      } /* for l < numBins */
+
+    /* horizontal sum: even lanes hold Re(X)/x, odd lanes Im(X)/x */
+    __m256 XSum_8 = _mm256_add_ps ( _mm512_castps512_ps256 ( XSum_v ),
+                                    _mm256_castpd_ps ( _mm512_extractf64x4_pd ( _mm512_castps_pd ( XSum_v ), 1 ) ) );
+    __m128 XSum_4 = _mm_add_ps ( _mm256_castps256_ps128 ( XSum_8 ), _mm256_extractf128_ps ( XSum_8, 1 ) );
+    XSum_4 = _mm_add_ps ( XSum_4, _mm_movehl_ps ( XSum_4, XSum_4 ) );
+    REAL4 U_alpha = _mm_cvtss_f32 ( XSum_4 );
+    REAL4 V_alpha = _mm_cvtss_f32 ( _mm_shuffle_ps ( XSum_4, XSum_4, _MM_SHUFFLE ( 1, 1, 1, 1 ) ) );
+
+    /* NOTE: sin[ 2pi (Dphi_alpha - k) ] = sin [ 2pi Dphi_alpha ] = sin [ 2pi kappa_star ],
+     * therefore the trig-functions need to be calculated only once!
+     * We choose the value sin[ 2pi kappa_star ] because it is the
+     * closest to zero and will pose no numerical difficulties !
+     * As kappa in [0, 1) we can skip the trimming step.
+     */
+    REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+    XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star );
+    c_alpha -= 1.0f;
+
+    realXP = s_alpha * U_alpha - c_alpha * V_alpha;
+    imagXP = c_alpha * U_alpha + s_alpha * V_alpha;
+  }
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
@@ -0,0 +1,580 @@
+/*
+*  Copyright (C) 2007 Bernd Machenschalk
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+/* This module keeps a "toplist", i.e. a list of the top n elements (accoding to an externally
+   supplied comparison function) in a standard heap structure.
+
+   A Heap is a partially sorted structure that is typically represented as a (binary) tree.
+   A tree is a heap if for all nodes the value of the node is smaller than that of all its
+   successors according to a given comparison function.
+   Footnote: in most other implementation of a heap the order is different from here, i.e.
+   replace "smaller" with "greater" in the above.
+
+   The nice thing about such a heap for our application (and others) is that this heap property
+   doesn't imply any special relation between two nodes in different branches of the tree, so no
+   effort is necessary to keep such a relation. This allows to perform all operations on the heap
+   (including removal and insertion of elements) with O(log n), i.e. at most the depth of the tree.
+
+   Here the tree is a binary tree and stored in an array where the successors succ(n) of a node
+   with index n have indices 2*n+1 and 2*n+2:
+
+            0
+       1          2
+     3   4     5     6
+    7 8 9 10 11 12 13 14
+
+   There's nothing special about that - look for "Heapsort" in the WWW or an algorithms book.
+
+   Bernd Machenschalk
+*/
+
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+#include <lal/LALStdio.h>
+#include <lal/HeapToplist.h>
+
+/* checkpoint file format */
+#define TOPLIST_CHECKPOINT_MAGIC   "HTOPLIST"
+#define TOPLIST_CHECKPOINT_VERSION 1
+#define TOPLIST_CHECKPOINT_TMP_EXT ".tmp"
+
+/* number of consecutive failed fsync()s after which syncing of checkpoints is disabled */
+#define SYNC_FAIL_LIMIT 5
+
+/* this function gets a "partial heap", i.e. a heap where only the top
+   element (potentially) violates the heap property. It "bubbles
+   down" this element so that the heap property is restored */
+static void down_heap(LALHeapToplist*list) {
+  size_t node = 0;
+  size_t succ;
+  char *exch;
+  while ((succ = node+node+1) < list->elems) {
+    if (succ+1 < list->elems)
+      if ((list->smaller)((list->heap)[succ+1], (list->heap)[succ]) > 0)
+	succ++;
+    if ((list->smaller)((list->heap)[succ], (list->heap)[node]) > 0) {
+      exch = (list->heap)[node];
+      (list->heap)[node] = (list->heap)[succ];
+      (list->heap)[succ] = exch;
+      node = succ;
+    } else
+      break;
+  }
+}
+
+
+/* this function gets a "partial heap", i.e. a heap where only an element on
+   the lowest level (potentially) violates the heap property. "node" is the 
+   index of this element. The function "bubbles up" this element so that the
+   heap property is restored */
+static void up_heap(LALHeapToplist*list, size_t node) {
+  size_t pred;
+  char *exch;
+  while (node > 0) {
+    pred = (node-1)/2;
+    if ((list->smaller)((list->heap)[node], (list->heap)[pred]) > 0) {
+      exch = (list->heap)[node];
+      (list->heap)[node] = (list->heap)[pred];
+      (list->heap)[pred] = exch;
+      node = pred;
+    } else
+      break;
+  }
+}
+
+
+/* creates a toplist with length elements */
+LALHeapToplist *XLALCreateToplist(size_t length,
+                                  size_t size,
+                                  int (*smaller)(const void *, const void *)) {
+  XLAL_CHECK_NULL(size > 0, XLAL_EINVAL);
+  XLAL_CHECK_NULL(smaller != NULL, XLAL_EFAULT);
+
+  LALHeapToplist *list = XLALCalloc(1, sizeof(*list));
+  XLAL_CHECK_NULL(list != NULL, XLAL_ENOMEM);
+  if (length > 0) {
+    list->data = XLALMalloc(size * length);
+    list->heap = XLALMalloc(sizeof(char*) * length);
+    if ((list->data == NULL) || (list->heap == NULL)) {
+      XLALDestroyToplist(list);
+      XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+  }
+
+  list->length  = length;
+  list->elems   = 0;
+  list->size    = size;
+  list->smaller = smaller;
+  list->key_offset = LAL_HEAPTOPLIST_NO_KEY;
+
+  return(list);
+}
+
+
+/* clears an existing toplist of all elements inserted so far */
+int XLALClearToplist(LALHeapToplist*list) {
+  XLAL_CHECK(list != NULL, XLAL_EFAULT);
+  list->elems = 0;
+  return(XLAL_SUCCESS);
+}
+
+
+/* frees the space occupied by the toplist */
+void XLALDestroyToplist(LALHeapToplist*list) {
+  if (list == NULL)
+    return;
+  XLALFree(list->heap);
+  XLALFree(list->data);
+  XLALFree(list);
+}
+
+
+/* Inserts an element in to the toplist either if there is space left
+   or the element is larger than the smallest element in the toplist.
+   In the latter case, remove the smallest element from the toplist.
+   Returns 1 if the element was actually inserted, 0 if not. */
+int XLALInsertIntoToplist(LALHeapToplist*list, const void *element) {
+  XLAL_CHECK(list != NULL, XLAL_EFAULT);
+  XLAL_CHECK(element != NULL, XLAL_EFAULT);
+
+  /* if there is room left, add it at the end (and update the heap) */
+  if (list->elems < list->length) {
+    list->heap[list->elems] = list->data + list->elems * list->size;
+    memcpy(list->heap[list->elems], element, list->size);
+    list->elems++;
+    up_heap(list,list->elems-1);
+    return(1);
+
+  /* if it is smaller than the smallest element, simply drop it.
+     if it is bigger, replace the smallest element (root of the heap)
+     and update the heap */
+  } else if ((list->length > 0) && ((list->smaller)(element, (list->heap)[0]) < 0)) {
+    memcpy(list->heap[0], element, list->size);
+    down_heap(list);
+    return(1);
+
+  } else
+    return(0);
+}
+
+
+/* apply the function "handle" to all elements of the list in the current order */
+int XLALGoThroughToplist(LALHeapToplist*list, void (*handle)(void *)) {
+  XLAL_CHECK(list != NULL, XLAL_EFAULT);
+  XLAL_CHECK(handle != NULL, XLAL_EFAULT);
+  for(size_t i=0;i<list->elems;i++)
+    handle(list->heap[i]);
+  return(XLAL_SUCCESS);
+}
+
+void* XLALToplistElem(LALHeapToplist*list, size_t ind) {
+  XLAL_CHECK_NULL(list != NULL, XLAL_EFAULT);
+  XLAL_CHECK_NULL(ind < list->elems, XLAL_EDOM, "Index %zu out of range of toplist of %zu elements", ind, list->elems);
+  return(list->heap[ind]);
+}
+
+int XLALCompareToplists(int *cmp, LALHeapToplist*list1, LALHeapToplist*list2) {
+  size_t i=0;
+  int res=0;
+  XLAL_CHECK(cmp != NULL, XLAL_EFAULT);
+  XLAL_CHECK((list1 != NULL) && (list2 != NULL), XLAL_EFAULT);
+  XLAL_CHECK((list1->smaller == list2->smaller) && (list1->size == list2->size), XLAL_EINVAL,
+             "Toplists have different element sizes or comparison functions");
+  while((i < list1->elems) &&
+	(i < list2->elems) &&
+	(res == 0)) {
+    res = list1->smaller(list1->heap[i],list2->heap[i]);
+    i++;
+  }
+  if (res == 0) {
+    if (list1->elems < list2->elems)
+      res = 1;
+    else if (list1->elems > list2->elems)
+      res = -1;
+  }
+  *cmp = res;
+  return(XLAL_SUCCESS);
+}
+
+
+/* using qsort requires some "global" help */
+
+/* global function pointer for qsort */
+static int (*_qsort_compare1)(const void*, const void*);
+/* wrapper function for qsort */
+static int _qsort_compare2(const void*a, const void*b){
+  return (_qsort_compare1(*(void*const*)a,*(void*const*)b));
+}
+/* inverse wrapper */
+static int _qsort_compare3(const void*b, const void*a){
+  return (_qsort_compare1(*(void*const*)a,*(void*const*)b));
+}
+
+/* sorts the toplist with an arbitrary sorting function
+   (potentially) destroying the heap property */
+int XLALQSortToplist(LALHeapToplist*list, int (*compare)(const void*, const void*)) {
+  XLAL_CHECK(list != NULL, XLAL_EFAULT);
+  XLAL_CHECK(compare != NULL, XLAL_EFAULT);
+  /* point the global function pointer to compare, then call qsort with the wrapper */
+  _qsort_compare1 = compare;
+  qsort(list->heap,list->elems,sizeof(char*),_qsort_compare2);
+  return(XLAL_SUCCESS);
+}
+
+/* qsort function that gives the reverse ordering of the previous */
+int XLALQSortToplistReverse(LALHeapToplist*list, int (*compare)(const void*, const void*)) {
+  XLAL_CHECK(list != NULL, XLAL_EFAULT);
+  XLAL_CHECK(compare != NULL, XLAL_EFAULT);
+  /* point the global function pointer to compare, then call qsort with the wrapper */
+  _qsort_compare1 = compare;
+  qsort(list->heap,list->elems,sizeof(char*),_qsort_compare3);
+  return(XLAL_SUCCESS);
+}
+
+
+/* declare the offset of the REAL4 sort key of the elements */
+int XLALSetToplistKey(LALHeapToplist*list, size_t key_offset) {
+  XLAL_CHECK(list != NULL, XLAL_EFAULT);
+  XLAL_CHECK((key_offset <= list->size) && (list->size - key_offset >= sizeof(REAL4)), XLAL_EINVAL,
+             "REAL4 key at offset %zu does not fit into an element of size %zu", key_offset, list->size);
+  list->key_offset = key_offset;
+  return(XLAL_SUCCESS);
+}
+
+
+/* the smallest key a candidate needs to possibly be inserted into the toplist */
+static REAL4 toplist_key_threshold(const LALHeapToplist*list) {
+  REAL4 key;
+  if (list->elems < list->length)
+    return(-HUGE_VALF);
+  memcpy(&key, list->heap[0] + list->key_offset, sizeof(key));
+  return(key);
+}
+
+
+/* fill in and insert a single candidate of XLALInsertBlockIntoToplist(),
+   and update the insertion threshold */
+static int insert_block_candidate(LALHeapToplist*list, char*element, size_t idx,
+				  LALHeapToplistFillFunc fill, void *param, REAL4 *threshold) {
+  fill(element, idx, param);
+  if (!XLALInsertIntoToplist(list, element))
+    return(0);
+  *threshold = toplist_key_threshold(list);
+  return(1);
+}
+
+
+/* inserts a block of candidates, prefiltered by their keys */
+int XLALInsertBlockIntoToplist(LALHeapToplist*list, const REAL4 *keys, size_t n,
+                               LALHeapToplistFillFunc fill, void *param) {
+  char *element;
+  REAL4 threshold;
+  size_t i = 0;
+  int inserted = 0;
+
+  XLAL_CHECK(list != NULL, XLAL_EFAULT);
+  XLAL_CHECK(list->key_offset != LAL_HEAPTOPLIST_NO_KEY, XLAL_EINVAL, "Toplist has no sort key; call XLALSetToplistKey() first");
+  XLAL_CHECK((keys != NULL) || (n == 0), XLAL_EFAULT);
+  XLAL_CHECK(fill != NULL, XLAL_EFAULT);
+  if ((n == 0) || (list->length == 0))
+    return(0);
+  element = XLALMalloc(list->size);
+  XLAL_CHECK(element != NULL, XLAL_ENOMEM);
+
+  threshold = toplist_key_threshold(list);
+
+#ifdef __SSE__
+  /* compare four keys at a time against the threshold; the threshold only
+     rises while inserting, so a candidate rejected here can never be inserted */
+  for (; i + 4 <= n; i += 4) {
+    int mask = _mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(keys + i), _mm_set1_ps(threshold)));
+    for (int j = 0; mask != 0; j++, mask >>= 1)
+      if ((mask & 1) && (keys[i+j] >= threshold))
+	inserted += insert_block_candidate(list, element, i+j, fill, param, &threshold);
+  }
+#endif
+
+  for (; i < n; i++)
+    if (keys[i] >= threshold)
+      inserted += insert_block_candidate(list, element, i, fill, param, &threshold);
+
+  XLALFree(element);
+  return(inserted);
+}
+
+
+/* merges the toplist 'src' into 'dst' */
+int XLALMergeToplists(LALHeapToplist*dst, const LALHeapToplist*src) {
+  int inserted = 0;
+  XLAL_CHECK((dst != NULL) && (src != NULL), XLAL_EFAULT);
+  XLAL_CHECK(dst != src, XLAL_EINVAL, "Cannot merge a toplist into itself");
+  XLAL_CHECK((dst->size == src->size) && (dst->smaller == src->smaller), XLAL_EINVAL,
+             "Toplists have different element sizes or comparison functions");
+  for(size_t i=0;i<src->elems;i++)
+    inserted += XLALInsertIntoToplist(dst, src->heap[i]);
+  return(inserted);
+}
+
+
+/* running (Fletcher-style) checksum over all bytes of a checkpoint */
+typedef struct {
+  UINT8 sum1, sum2;
+} toplist_checksum_t;
+
+static void update_checksum(toplist_checksum_t *checksum, const void *ptr, size_t len) {
+  const unsigned char *bytes = (const unsigned char *)ptr;
+  size_t i;
+  for(i=0;i<len;i++) {
+    checksum->sum1 += bytes[i];
+    checksum->sum2 += checksum->sum1;
+  }
+}
+
+/* fwrite() 'n' objects of 'size' bytes and update the checksum; returns 0 on success */
+static int checkpoint_write(const void *ptr, size_t size, size_t n, FILE *fp, toplist_checksum_t *checksum) {
+  if (fwrite(ptr, size, n, fp) != n)
+    return(-1);
+  update_checksum(checksum, ptr, size * n);
+  return(0);
+}
+
+/* fread() 'n' objects of 'size' bytes and update the checksum; returns 0 on success */
+static int checkpoint_read(void *ptr, size_t size, size_t n, FILE *fp, toplist_checksum_t *checksum) {
+  if (fread(ptr, size, n, fp) != n)
+    return(-1);
+  update_checksum(checksum, ptr, size * n);
+  return(0);
+}
+
+
+/* writes the toplists to a temporary file, then renames the file to filename */
+int XLALWriteToplistCheckpoint(const char*filename, LALHeapToplist*const*lists, size_t nlists,
+                               UINT4 counter, UINT4 *sync_failures) {
+  toplist_checksum_t checksum = {0, 0};
+  const UINT4 version = TOPLIST_CHECKPOINT_VERSION;
+  const UINT4 nlists4 = nlists;
+  char *tmpfilename;
+  FILE *fp;
+  size_t l, i;
+  int err = 0;
+
+  /* do nothing with an empty filename */
+  if (!filename)
+    return(XLAL_SUCCESS);
+  XLAL_CHECK((lists != NULL) && (nlists > 0), XLAL_EINVAL);
+  for(l=0;l<nlists;l++)
+    XLAL_CHECK(lists[l] != NULL, XLAL_EFAULT);
+
+  /* construct temporary filename */
+  tmpfilename = XLALMalloc(strlen(filename) + strlen(TOPLIST_CHECKPOINT_TMP_EXT) + 1);
+  XLAL_CHECK(tmpfilename != NULL, XLAL_ENOMEM);
+  strcpy(tmpfilename, filename);
+  strcat(tmpfilename, TOPLIST_CHECKPOINT_TMP_EXT);
+
+  /* open tempfile */
+  if (!(fp = fopen(tmpfilename, "wb"))) {
+    XLALPrintError("%s: Couldn't open '%s': %s\n", __func__, tmpfilename, strerror(errno));
+    XLALFree(tmpfilename);
+    XLAL_ERROR(XLAL_EIO);
+  }
+
+  /* write header */
+  err = err || checkpoint_write(TOPLIST_CHECKPOINT_MAGIC, 1, strlen(TOPLIST_CHECKPOINT_MAGIC), fp, &checksum);
+  err = err || checkpoint_write(&version, sizeof(version), 1, fp, &checksum);
+  err = err || checkpoint_write(&nlists4, sizeof(nlists4), 1, fp, &checksum);
+
+  /* write toplists: element size, number of elements, data and heap order */
+  for(l=0;(l<nlists)&&!err;l++) {
+    const LALHeapToplist *tl = lists[l];
+    const UINT8 size = tl->size, elems = tl->elems;
+    err = err || checkpoint_write(&size, sizeof(size), 1, fp, &checksum);
+    err = err || checkpoint_write(&elems, sizeof(elems), 1, fp, &checksum);
+    err = err || checkpoint_write(tl->data, tl->size, tl->elems, fp, &checksum);
+    for(i=0;(i<tl->elems)&&!err;i++) {
+      const UINT4 idx = (tl->heap[i] - tl->data) / tl->size;
+      err = checkpoint_write(&idx, sizeof(idx), 1, fp, &checksum);
+    }
+  }
+
+  /* write counter and checksum */
+  err = err || checkpoint_write(&counter, sizeof(counter), 1, fp, &checksum);
+  if (!err) {
+    const UINT8 sums[2] = {checksum.sum1, checksum.sum2};
+    err = (fwrite(sums, sizeof(sums[0]), 2, fp) != 2);
+  }
+  if (err)
+    XLALPrintError("%s: Couldn't write to '%s': %s\n", __func__, tmpfilename, strerror(errno));
+
+#ifdef HAVE_UNISTD_H
+  /* make sure the data ends up on disk */
+  if (!err && (sync_failures != NULL) && (*sync_failures < SYNC_FAIL_LIMIT)) {
+    if ((fflush(fp) != 0) || (fsync(fileno(fp)) != 0)) {
+      XLALPrintWarning("%s: Couldn't sync '%s': %s\n", __func__, tmpfilename, strerror(errno));
+      (*sync_failures)++;
+      if (*sync_failures >= SYNC_FAIL_LIMIT)
+	XLALPrintWarning("%s: syncing disabled\n", __func__);
+    } else
+      *sync_failures = 0;
+  }
+#else
+  (void)sync_failures;
+#endif
+
+  /* close tempfile */
+  if (fclose(fp) && !err) {
+    XLALPrintError("%s: Couldn't close '%s': %s\n", __func__, tmpfilename, strerror(errno));
+    err = 1;
+  }
+
+  /* rename to filename, replacing the previous checkpoint */
+  if (!err && rename(tmpfilename, filename)) {
+    XLALPrintError("%s: Couldn't rename '%s' to '%s': %s\n", __func__, tmpfilename, filename, strerror(errno));
+    err = 1;
+  }
+
+  XLALFree(tmpfilename);
+  XLAL_CHECK(!err, XLAL_EIO, "Couldn't write checkpoint '%s'", filename);
+  return(XLAL_SUCCESS);
+}
+
+
+/* reads toplists from a checkpoint written by XLALWriteToplistCheckpoint() */
+int XLALReadToplistCheckpoint(const char*filename, LALHeapToplist*const*lists, size_t nlists,
+                              UINT4*counter, BOOLEAN*found) {
+  toplist_checksum_t checksum = {0, 0};
+  char magic[sizeof(TOPLIST_CHECKPOINT_MAGIC) - 1];
+  UINT4 version, nlists4;
+  UINT8 sums[2];
+  FILE *fp;
+  size_t l, i;
+  int errnum = 0;
+
+  XLAL_CHECK(counter != NULL, XLAL_EFAULT);
+  XLAL_CHECK(found != NULL, XLAL_EFAULT);
+
+  /* counter should be 0 if we couldn't read a checkpoint */
+  *counter = 0;
+  *found = 0;
+
+  /* do nothing with an empty filename */
+  if (!filename)
+    return(XLAL_SUCCESS);
+  XLAL_CHECK((lists != NULL) && (nlists > 0), XLAL_EINVAL);
+  for(l=0;l<nlists;l++)
+    XLAL_CHECK(XLALClearToplist(lists[l]) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  /* try to open file */
+  if (!(fp = fopen(filename, "rb"))) {
+    if (errno == ENOENT) {
+      XLALPrintInfo("%s: No checkpoint '%s' found - starting from scratch\n", __func__, filename);
+      return(XLAL_SUCCESS);
+    }
+    XLAL_ERROR(XLAL_EIO, "Checkpoint '%s' found but couldn't open: %s", filename, strerror(errno));
+  }
+  *found = 1;
+
+  /* read and check header */
+  if (checkpoint_read(magic, 1, sizeof(magic), fp, &checksum) ||
+      checkpoint_read(&version, sizeof(version), 1, fp, &checksum) ||
+      checkpoint_read(&nlists4, sizeof(nlists4), 1, fp, &checksum))
+    errnum = XLAL_EIO;
+  else if ((memcmp(magic, TOPLIST_CHECKPOINT_MAGIC, sizeof(magic)) != 0) ||
+	   (version != TOPLIST_CHECKPOINT_VERSION) || (nlists4 != nlists)) {
+    XLALPrintError("%s: '%s' is not a version %d checkpoint of %zu toplists\n",
+		   __func__, filename, TOPLIST_CHECKPOINT_VERSION, nlists);
+    errnum = XLAL_EDATA;
+  }
+
+  /* read toplists */
+  for(l=0;(l<nlists)&&(errnum==0);l++) {
+    LALHeapToplist *tl = lists[l];
+    UINT8 size, elems;
+    if (checkpoint_read(&size, sizeof(size), 1, fp, &checksum) ||
+	checkpoint_read(&elems, sizeof(elems), 1, fp, &checksum)) {
+      errnum = XLAL_EIO;
+      break;
+    }
+    if ((size != tl->size) || (elems > tl->length)) {
+      XLALPrintError("%s: Toplist %zu in '%s' doesn't match: element size %" LAL_UINT8_FORMAT " != %zu, or elements %" LAL_UINT8_FORMAT " > %zu\n",
+		     __func__, l, filename, size, tl->size, elems, tl->length);
+      errnum = XLAL_EDATA;
+      break;
+    }
+    tl->elems = elems;
+    if (checkpoint_read(tl->data, tl->size, tl->elems, fp, &checksum)) {
+      errnum = XLAL_EIO;
+      break;
+    }
+    for(i=0;i<tl->elems;i++) {
+      UINT4 idx;
+      if (checkpoint_read(&idx, sizeof(idx), 1, fp, &checksum)) {
+	errnum = XLAL_EIO;
+	break;
+      }
+      if (idx >= tl->elems) {
+	XLALPrintError("%s: Invalid heap index %u >= %zu in '%s'\n", __func__, idx, tl->elems, filename);
+	errnum = XLAL_EDATA;
+	break;
+      }
+      tl->heap[i] = tl->data + idx * tl->size;
+    }
+  }
+
+  /* read counter and checksum */
+  if (errnum == 0) {
+    if (checkpoint_read(counter, sizeof(*counter), 1, fp, &checksum) ||
+	(fread(sums, sizeof(sums[0]), 2, fp) != 2))
+      errnum = XLAL_EIO;
+    else if ((sums[0] != checksum.sum1) || (sums[1] != checksum.sum2) || (fgetc(fp) != EOF)) {
+      XLALPrintError("%s: Checksum error in '%s'\n", __func__, filename);
+      errnum = XLAL_EDATA;
+    }
+  }
+  if (errnum == XLAL_EIO)
+    XLALPrintError("%s: Couldn't read from '%s': %s\n", __func__, filename, feof(fp) ? "unexpected end of file" : strerror(errno));
+
+  /* close file */
+  if (fclose(fp) && (errnum == 0)) {
+    XLALPrintError("%s: Couldn't close '%s': %s\n", __func__, filename, strerror(errno));
+    errnum = XLAL_EIO;
+  }
+
+  /* don't leave partially read toplists behind */
+  if (errnum != 0) {
+    for(l=0;l<nlists;l++)
+      lists[l]->elems = 0;
+    *counter = 0;
+    XLAL_ERROR(errnum, "Couldn't read checkpoint '%s'", filename);
+  }
+
+  XLALPrintInfo("%s: Successfully read checkpoint: %u\n", __func__, *counter);
+  return(XLAL_SUCCESS);
+}
@@ -0,0 +1,169 @@
+/*
+*  Copyright (C) 2007 Bernd Machenschalk, Reinhard Prix
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#ifndef HEAPTOPLIST_H
+#define HEAPTOPLIST_H
+
+#include <stddef.h>
+#include <lal/LALStdlib.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup HeapToplist_h Header HeapToplist.h
+ * \ingroup lalpulsar_general
+ * \author Bernd Machenschalk, Reinhard Prix
+ *
+ * \brief Keeps a "toplist", i.e. a list of the top n elements (according to an externally
+ * supplied comparison function) in a standard heap structure.
+ *
+ * The functions follow the usual XLAL conventions: on error they set ::xlalErrno and
+ * return #XLAL_FAILURE or \c NULL. The lalapps searches use the names and return codes
+ * of the former lalapps copies of this module through <tt>HeapToplistCompat.h</tt>.
+ */
+/** @{ */
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+/** Value of LALHeapToplist::key_offset if the elements have no \c REAL4 sort key */
+#define LAL_HEAPTOPLIST_NO_KEY ((size_t)-1)
+
+/** A heap toplist */
+typedef struct tagLALHeapToplist {
+  size_t length;	/**< The length (maximal number of entries) of the toplist */
+  size_t elems;		/**< Number of elements currently in the toplist */
+  size_t size;		/**< Size of an element */
+  char   *data;		/**< The actual data array of \c length*size chars */
+  char   **heap;	/**< Array of \c length pointers into \c data */
+  int    (*smaller)(const void *, const void *);	/**< Comparison function */
+  size_t key_offset;	/**< Offset of the \c REAL4 sort key within an element, or #LAL_HEAPTOPLIST_NO_KEY */
+} LALHeapToplist;
+
+/** Callback of XLALInsertBlockIntoToplist(): fill in \c element for the candidate with index \c idx in the block, including its sort key */
+typedef void (*LALHeapToplistFillFunc)(void *element, size_t idx, void *param);
+
+/**
+ * Creates a toplist with \c length elements of size \c size, with ordering based on the
+ * comparison function \c smaller.
+ */
+LALHeapToplist *XLALCreateToplist(size_t length, size_t size, int (*smaller)(const void *, const void *));
+
+/** Frees the space occupied by the toplist; does nothing if \c list is \c NULL */
+void XLALDestroyToplist(LALHeapToplist *list);
+
+/**
+ * Inserts an element into the toplist either if there is space left or the element is larger
+ * than the smallest element in the toplist. In the latter case, the smallest element is removed.
+ * Returns 1 if the element was actually inserted, 0 if not.
+ */
+int XLALInsertIntoToplist(LALHeapToplist *list, const void *element);
+
+/** Clears an existing toplist of all elements inserted so far */
+int XLALClearToplist(LALHeapToplist *list);
+
+/**
+ * Applies the function \c handle to all elements of the list in the current order, e.g. for
+ * writing them out after calling XLALQSortToplist()
+ */
+int XLALGoThroughToplist(LALHeapToplist *list, void (*handle)(void *));
+
+/**
+ * Sorts the toplist with an arbitrary sorting function, (potentially) destroying the heap property.
+ *
+ * Note that a (q-)sorted list is a heap, but due to the interface of qsort() the same comparison
+ * function will give the reverse order than the heap. In order to restore a heap with
+ * XLALQSortToplist() (e.g. to add more elements) you must call it with the inverse function of
+ * the \c smaller function of the heap, or use XLALQSortToplistReverse().
+ */
+int XLALQSortToplist(LALHeapToplist *list, int (*compare)(const void *, const void *));
+
+/**
+ * Sorts the toplist in the reverse order of XLALQSortToplist(), which restores the heap property
+ * with the same comparison function
+ */
+int XLALQSortToplistReverse(LALHeapToplist *list, int (*compare)(const void *, const void *));
+
+/** Returns the element of the toplist with index \c idx, which must be less than LALHeapToplist::elems */
+void *XLALToplistElem(LALHeapToplist *list, size_t idx);
+
+/**
+ * Compares two toplists, which must have the same element size and comparison function.
+ * Sets \c *cmp to -1 if \c list1 is "smaller", 1 if \c list2 is "smaller", and 0 if they are equal.
+ */
+int XLALCompareToplists(int *cmp, LALHeapToplist *list1, LALHeapToplist *list2);
+
+/**
+ * Declares that the elements of the toplist carry a \c REAL4 sort key at byte offset \c key_offset
+ * (e.g. <tt>offsetof(MyCandidate, twoF)</tt>). The \c smaller function must be consistent with the key,
+ * i.e. an element with a smaller key must never compare larger, while elements with equal keys may be
+ * ordered by other fields. This is required by XLALInsertBlockIntoToplist().
+ */
+int XLALSetToplistKey(LALHeapToplist *list, size_t key_offset);
+
+/**
+ * Inserts a whole block of \c n candidates (e.g. all frequency bins of one template) into a keyed
+ * toplist. \c keys[i] must equal the sort key which \c fill writes into the element of candidate \c i.
+ * The keys are first compared against the key of the current smallest element of a full toplist
+ * (using SIMD where available), so that \c fill and the heap insertion are only called for the few
+ * candidates that can make it into the toplist. NaN keys are never inserted.
+ * Returns the number of elements actually inserted.
+ */
+int XLALInsertBlockIntoToplist(LALHeapToplist *list, const REAL4 *keys, size_t n, LALHeapToplistFillFunc fill, void *param);
+
+/**
+ * Merges the toplist \c src into \c dst, e.g. to combine per-thread toplists after a parallel search.
+ * \c src is left unchanged; the toplists must have the same element size and comparison function.
+ * Returns the number of elements of \c src inserted into \c dst.
+ */
+int XLALMergeToplists(LALHeapToplist *dst, const LALHeapToplist *src);
+
+/**
+ * Writes a checkpoint of \c nlists toplists and a counter to \c filename:
+ * - writes a header (format version, number of toplists), then for each toplist its element size,
+ *   number of elements, data and heap order, then the counter;
+ * - appends a checksum of everything written before;
+ * - writes to \c filename with ".tmp" appended, and only then renames it to \c filename,
+ *   so that a crash while writing never damages the previous checkpoint.
+ *
+ * If \c sync_failures is not \c NULL, the checkpoint is fsync()ed before it is renamed, unless
+ * \c *sync_failures has reached a limit; \c *sync_failures counts consecutive failed fsync()s,
+ * and should be kept by the caller between checkpoints. Nothing is written if \c filename is \c NULL.
+ */
+int XLALWriteToplistCheckpoint(const char *filename, LALHeapToplist *const *lists, size_t nlists, UINT4 counter, UINT4 *sync_failures);
+
+/**
+ * Reads a checkpoint written by XLALWriteToplistCheckpoint() into \c nlists toplists, which must have
+ * been created with the same lengths and element sizes. Sets \c *found to whether a checkpoint was
+ * found; if not, the toplists are left empty and \c *counter is set to 0. Fails with #XLAL_EIO on an
+ * I/O error, and with #XLAL_EDATA if the checksum is wrong or the checkpoint doesn't match the toplists;
+ * on any error all toplists are cleared and \c *counter is set to 0.
+ */
+int XLALReadToplistCheckpoint(const char *filename, LALHeapToplist *const *lists, size_t nlists, UINT4 *counter, BOOLEAN *found);
+
+#endif /* SWIG */
+
+/** @} */
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* HEAPTOPLIST_H - double inclusion protection */
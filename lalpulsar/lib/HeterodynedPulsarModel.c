@@ -311,6 +311,70 @@ REAL8Vector *XLALHeterodynedPulsarPhaseDifference( PulsarParameters *params,
 }
 
 
+/**
+ * \brief Get the sky position and delay parameters of a pulsar for barycentring
+ *
+ * Fills in the right ascension and declination (wrapped to \f$[0, 2\pi)\f$
+ * and \f$[-\pi/2, \pi/2]\f$ respectively) and inverse distance of \c bary, and
+ * returns the proper motions, position epoch and gravitational-wave speed.
+ */
+static int ssb_delay_source_params( PulsarParameters *pars,
+                                    BarycenterInput *bary,
+                                    REAL8 *pmra,
+                                    REAL8 *pmdec,
+                                    REAL8 *posepoch,
+                                    REAL8 *cgw ){
+  REAL8 ra = 0.;
+  if ( PulsarCheckParam( pars, "RA" ) ) { ra = PulsarGetREAL8Param( pars, "RA" ); }
+  else if ( PulsarCheckParam( pars, "RAJ" ) ) { ra = PulsarGetREAL8Param( pars, "RAJ" ); }
+  else {
+    XLAL_ERROR( XLAL_EINVAL, "No source right ascension specified!" );
+  }
+  REAL8 dec = 0.;
+  if ( PulsarCheckParam( pars, "DEC" ) ) { dec = PulsarGetREAL8Param( pars, "DEC" ); }
+  else if ( PulsarCheckParam( pars, "DECJ" ) ) { dec = PulsarGetREAL8Param( pars, "DECJ" ); }
+  else {
+    XLAL_ERROR( XLAL_EINVAL, "No source declination specified!" );
+  }
+  *pmra = PulsarGetREAL8ParamOrZero( pars, "PMRA" );
+  *pmdec = PulsarGetREAL8ParamOrZero( pars, "PMDEC" );
+  REAL8 pepoch = PulsarGetREAL8ParamOrZero( pars, "PEPOCH" );
+  *posepoch = PulsarGetREAL8ParamOrZero( pars, "POSEPOCH" );
+
+  *cgw = PulsarGetREAL8ParamOrZero(pars, "CGW");
+
+  REAL8 dist = 0.;  /* distance in light seconds */
+  /* set distance (a DIST param takes precedence over PX) */
+  if ( PulsarCheckParam( pars, "DIST") ){
+    dist = PulsarGetREAL8Param( pars, "DIST" ) / LAL_C_SI;
+  }
+  else if ( PulsarCheckParam( pars, "PX" ) ){
+    dist = (LAL_AU_SI/LAL_C_SI) / PulsarGetREAL8Param( pars, "PX" );
+  }
+
+  /* set the position epoch if not already set */
+  if( *posepoch == 0. && pepoch != 0. ) { *posepoch = pepoch; }
+
+  /* set 1/distance if distance is given */
+  if( dist != 0. ) { bary->dInv = 1. / dist; }
+  else { bary->dInv = 0.; }
+
+  /* make sure ra and dec are wrapped within 0--2pi and -pi.2--pi/2 respectively */
+  ra = fmod(ra, LAL_TWOPI);
+  REAL8 absdec = fabs(dec);
+  if ( absdec > LAL_PI_2 ){
+    UINT4 nwrap = floor((absdec+LAL_PI_2)/LAL_PI);
+    dec = (dec > 0 ? 1. : -1.)*(nwrap%2 == 1 ? -1. : 1.)*(fmod(absdec + LAL_PI_2, LAL_PI) - LAL_PI_2);
+    ra = fmod(ra + (REAL8)nwrap*LAL_PI, LAL_TWOPI); /* move RA by pi */
+  }
+
+  bary->alpha = ra;
+  bary->delta = dec;
+
+  return XLAL_SUCCESS;
+}
+
+
 /**
  * \brief Computes the delay between a GPS time at Earth and the solar system barycentre
  *
@@ -333,6 +397,7 @@ REAL8Vector *XLALHeterodynedPulsarPhaseDifference( PulsarParameters *params,
  *
  * \sa XLALBarycenter
  * \sa XLALBarycenterEarthNew
+ * \sa XLALHeterodynedPulsarGetSSBDelayFromTable
  */
 REAL8Vector *XLALHeterodynedPulsarGetSSBDelay( PulsarParameters *pars,
                                                const LIGOTimeGPSVector *datatimes,
@@ -357,56 +422,15 @@ REAL8Vector *XLALHeterodynedPulsarGetSSBDelay( PulsarParameters *pars,
   bary.site.location[1] = detector->location[1]/LAL_C_SI;
   bary.site.location[2] = detector->location[2]/LAL_C_SI;
 
-  REAL8 ra = 0.;
-  if ( PulsarCheckParam( pars, "RA" ) ) { ra = PulsarGetREAL8Param( pars, "RA" ); }
-  else if ( PulsarCheckParam( pars, "RAJ" ) ) { ra = PulsarGetREAL8Param( pars, "RAJ" ); }
-  else {
-    XLAL_ERROR_NULL( XLAL_EINVAL, "No source right ascension specified!" );
-  }
-  REAL8 dec = 0.;
-  if ( PulsarCheckParam( pars, "DEC" ) ) { dec = PulsarGetREAL8Param( pars, "DEC" ); }
-  else if ( PulsarCheckParam( pars, "DECJ" ) ) { dec = PulsarGetREAL8Param( pars, "DECJ" ); }
-  else {
-    XLAL_ERROR_NULL( XLAL_EINVAL, "No source declination specified!" );
-  }
-  REAL8 pmra = PulsarGetREAL8ParamOrZero( pars, "PMRA" );
-  REAL8 pmdec = PulsarGetREAL8ParamOrZero( pars, "PMDEC" );
-  REAL8 pepoch = PulsarGetREAL8ParamOrZero( pars, "PEPOCH" );
-  REAL8 posepoch = PulsarGetREAL8ParamOrZero( pars, "POSEPOCH" );
-
-  REAL8 cgw = PulsarGetREAL8ParamOrZero(pars, "CGW");
-
-  REAL8 dist = 0.;  /* distance in light seconds */
-  /* set distance (a DIST param takes precedence over PX) */
-  if ( PulsarCheckParam( pars, "DIST") ){
-    dist = PulsarGetREAL8Param( pars, "DIST" ) / LAL_C_SI;
-  }
-  else if ( PulsarCheckParam( pars, "PX" ) ){
-    dist = (LAL_AU_SI/LAL_C_SI) / PulsarGetREAL8Param( pars, "PX" );
-  }
-
-  /* set the position and frequency epochs if not already set */
-  if( pepoch == 0. && posepoch != 0.) { pepoch = posepoch; }
-  else if( posepoch == 0. && pepoch != 0. ) { posepoch = pepoch; }
+  REAL8 pmra = 0., pmdec = 0., posepoch = 0., cgw = 0.;
+  XLAL_CHECK_NULL( ssb_delay_source_params( pars, &bary, &pmra, &pmdec, &posepoch, &cgw ) == XLAL_SUCCESS, XLAL_EFUNC );
+  REAL8 ra = bary.alpha, dec = bary.delta;
 
   length = datatimes->length;
 
   /* allocate memory for times delays */
   dts = XLALCreateREAL8Vector( length );
 
-  /* set 1/distance if distance is given */
-  if( dist != 0. ) { bary.dInv = 1. / dist; }
-  else { bary.dInv = 0.; }
-
-  /* make sure ra and dec are wrapped within 0--2pi and -pi.2--pi/2 respectively */
-  ra = fmod(ra, LAL_TWOPI);
-  REAL8 absdec = fabs(dec);
-  if ( absdec > LAL_PI_2 ){
-    UINT4 nwrap = floor((absdec+LAL_PI_2)/LAL_PI);
-    dec = (dec > 0 ? 1. : -1.)*(nwrap%2 == 1 ? -1. : 1.)*(fmod(absdec + LAL_PI_2, LAL_PI) - LAL_PI_2);
-    ra = fmod(ra + (REAL8)nwrap*LAL_PI, LAL_TWOPI); /* move RA by pi */
-  }
-
   EarthState earth;
   EmissionTime emit;
   for( i=0; i<length; i++){
@@ -434,6 +458,361 @@ REAL8Vector *XLALHeterodynedPulsarGetSSBDelay( PulsarParameters *pars,
 }
 
 
+/**
+ * \brief Create a table of Earth states for interpolating solar system barycentre delays
+ *
+ * Calling \c XLALBarycenterEarthNew and \c XLALBarycenter at every data
+ * sample dominates the cost of computing solar system barycentre delays for
+ * long, densely sampled data sets. The delay is, however, a very smooth
+ * function of time: its fastest varying component is the diurnal Roemer delay
+ * of amplitude \f$R_\oplus/c \approx 21\f$ ms, so its fourth time derivative
+ * is bounded by roughly
+ * \f$M = (R_\oplus/c)\,\omega_\oplus^4 + (1\,{\rm AU}/c)\,\Omega_\oplus^4 \approx 6\times 10^{-19}\,{\rm s}^{-3}\f$,
+ * where \f$\omega_\oplus\f$ and \f$\Omega_\oplus\f$ are the Earth's rotational
+ * and orbital angular frequencies. Four-point (cubic) Lagrange interpolation
+ * on a uniform grid of spacing \f$h\f$ has an error no larger than
+ * \f$\frac{3}{128} h^4 \max|\tau^{(4)}|\f$, so the grid spacing is chosen as
+ * the whole number of seconds for which twice this bound equals \c tolerance
+ * (about 430 s for a tolerance of 1 ns), and is restricted to lie between 1 s
+ * and 1 hour.
+ *
+ * The Earth state, which is the expensive part of the barycentring, does not
+ * depend on the source, so it is only computed once at each grid node that is
+ * needed to interpolate to one of the given \c datatimes. The table can be
+ * shared by all sources observed with the same detector, ephemeris and time
+ * stamps (grid nodes are aligned to integer multiples of the spacing, so
+ * tables for different data sets with the same tolerance also agree), and
+ * delays for a particular source are obtained with
+ * \c XLALSSBDelayLookupTableGetDelays or
+ * \c XLALHeterodynedPulsarGetSSBDelayFromTable .
+ *
+ * \param datatimes [in] A vector of GPS times at Earth
+ * \param detector [in] Information on the detector position on the Earth
+ * \param ephem [in] Information on the solar system ephemeris
+ * \param tdat [in] Information on the time system corrections
+ * \param ttype [in] The type of time system corrections to perform
+ * \param tolerance [in] The maximum allowed interpolation error in seconds
+ * (if this is not positive a value of 1 ns is used)
+ *
+ * \return The look-up table, which must be freed with
+ * \c XLALDestroySSBDelayLookupTable . The \c ephem and \c tdat structures must
+ * remain valid for the lifetime of the table.
+ */
+SSBDelayLookupTable *XLALCreateSSBDelayLookupTable( const LIGOTimeGPSVector *datatimes,
+                                                    const LALDetector *detector,
+                                                    const EphemerisData *ephem,
+                                                    const TimeCorrectionData *tdat,
+                                                    TimeCorrectionType ttype,
+                                                    REAL8 tolerance ){
+  /* check inputs */
+  XLAL_CHECK_NULL( datatimes != NULL, XLAL_EFAULT, "datatimes must not be NULL" );
+  XLAL_CHECK_NULL( datatimes->length > 0, XLAL_EINVAL, "datatimes must not be empty" );
+  XLAL_CHECK_NULL( detector != NULL, XLAL_EFAULT, "LALDetector must not be NULL" );
+  XLAL_CHECK_NULL( ephem != NULL, XLAL_EFAULT, "EphemerisData must not be NULL" );
+
+  UINT4 i = 0, j = 0;
+
+  if ( tolerance <= 0. ){ tolerance = 1e-9; }
+
+  /* bound on the fourth time derivative of the delay (diurnal + annual Roemer terms) */
+  REAL8 omegarot = LAL_TWOPI/LAL_DAYSID_SI, omegaorb = LAL_TWOPI/LAL_YRSID_SI;
+  REAL8 maxd4 = (LAL_REARTH_SI/LAL_C_SI)*SQUARE(SQUARE(omegarot)) + (LAL_AU_SI/LAL_C_SI)*SQUARE(SQUARE(omegaorb));
+
+  /* grid spacing for which twice the cubic interpolation error bound is the tolerance */
+  REAL8 dt = floor(pow(128.*tolerance/(6.*maxd4), 0.25));
+  if ( dt < 1. ){ dt = 1.; }
+  if ( dt > 3600. ){ dt = 3600.; }
+
+  /* get the range of the data times */
+  REAL8 tmin = XLALGPSGetREAL8( &datatimes->data[0] ), tmax = tmin;
+  for ( i = 1; i < datatimes->length; i++ ){
+    REAL8 t = XLALGPSGetREAL8( &datatimes->data[i] );
+    if ( t < tmin ){ tmin = t; }
+    if ( t > tmax ){ tmax = t; }
+  }
+
+  SSBDelayLookupTable *table = XLALCalloc(1, sizeof(*table));
+  XLAL_CHECK_NULL( table != NULL, XLAL_ENOMEM );
+
+  /* nodes are aligned to multiples of the spacing, with two extra nodes
+     before the first time and three after the last, as needed for the
+     interpolation and its error estimate */
+  XLALGPSSetREAL8( &table->t0, (floor(tmin/dt) - 2.)*dt );
+  table->dt = dt;
+  table->length = (UINT4)floor( (tmax - XLALGPSGetREAL8( &table->t0 ))/dt ) + 4;
+  table->tolerance = tolerance;
+  memcpy( &table->site, detector, sizeof(LALDetector) );
+  table->site.location[0] = detector->location[0]/LAL_C_SI;
+  table->site.location[1] = detector->location[1]/LAL_C_SI;
+  table->site.location[2] = detector->location[2]/LAL_C_SI;
+  table->ephem = ephem;
+  table->tdat = tdat;
+  table->ttype = ttype;
+
+  table->earth = XLALCalloc(table->length, sizeof(EarthState));
+  table->computed = XLALCalloc(table->length, sizeof(UINT4));
+  if ( table->earth == NULL || table->computed == NULL ){
+    XLALDestroySSBDelayLookupTable( table );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+
+  /* flag the nodes needed by each data time */
+  for ( i = 0; i < datatimes->length; i++ ){
+    INT4 k = (INT4)floor( XLALGPSDiff( &datatimes->data[i], &table->t0 )/dt );
+    for ( INT4 n = k - 2; n <= k + 3; n++ ){
+      if ( n >= 0 && n < (INT4)table->length ){ table->computed[n] = 1; }
+    }
+  }
+
+  /* compute the Earth states at the flagged nodes */
+  for ( j = 0; j < table->length; j++ ){
+    if ( !table->computed[j] ){ continue; }
+
+    LIGOTimeGPS tnode = table->t0;
+    XLALGPSAdd( &tnode, (REAL8)j*dt );
+    if ( XLALBarycenterEarthNew( &table->earth[j], &tnode, ephem, tdat, ttype ) != XLAL_SUCCESS ){
+      XLALDestroySSBDelayLookupTable( table );
+      XLAL_ERROR_NULL( XLAL_EFUNC, "Barycentring routine failed" );
+    }
+  }
+
+  return table;
+}
+
+
+/** \brief Free memory for a solar system barycentre delay look-up table
+ *
+ * \param table [in] the look-up table structure to be freed
+ */
+void XLALDestroySSBDelayLookupTable( SSBDelayLookupTable *table ){
+  if ( table == NULL ){ return; }
+
+  if ( table->earth ){ XLALFree( table->earth ); }
+  if ( table->computed ){ XLALFree( table->computed ); }
+
+  XLALFree( table );
+}
+
+
+/**
+ * Compute the solar system barycentre delay of a source at GPS time \c tgps,
+ * using the Earth state \c earth if given, or computing it otherwise.
+ */
+static int ssb_delay_at_time( REAL8 *dt,
+                              const SSBDelayLookupTable *table,
+                              const EarthState *earth,
+                              const LIGOTimeGPS *tgps,
+                              const BarycenterInput *source,
+                              REAL8 pmra,
+                              REAL8 pmdec,
+                              REAL8 posepoch,
+                              REAL8 cgw ){
+  BarycenterInput bary;
+  EarthState earthnow;
+  EmissionTime emit;
+
+  if ( earth == NULL ){
+    XLAL_CHECK( XLALBarycenterEarthNew( &earthnow, tgps, table->ephem, table->tdat, table->ttype ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
+    earth = &earthnow;
+  }
+
+  REAL8 realT = XLALGPSGetREAL8( tgps );
+
+  bary.tgps = *tgps;
+  bary.site = table->site;
+  bary.dInv = source->dInv;
+  bary.delta = source->delta + ( realT - posepoch ) * pmdec;
+  bary.alpha = source->alpha + ( realT - posepoch ) * pmra / cos( bary.delta );
+
+  XLAL_CHECK( XLALBarycenter( &emit, &bary, earth ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
+
+  if ( cgw > 0.0 ){
+    /* only account for a different GW speed in the Roemer delay */
+    *dt = (emit.deltaT - emit.roemer) + (emit.roemer / cgw);
+  }
+  else{
+    *dt = emit.deltaT;
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * \brief Interpolate solar system barycentre delays for a source from a look-up table
+ *
+ * For each of the \c datatimes the delay is computed exactly (with
+ * \c XLALBarycenter ) at the six surrounding nodes of \c table , and a cubic
+ * Lagrange polynomial through the four nearest of them is evaluated. Node
+ * delays are computed only once and reused by all data times that need them.
+ *
+ * The interpolation error is certified from the data rather than relying on
+ * the analytic bound used to choose the grid spacing: the fourth differences
+ * \f$\Delta^4\tau\f$ of the node delays estimate \f$h^4\tau^{(4)}\f$, and the
+ * error bound for a data time is taken as twice \f$\frac{3}{128}\f$ of the
+ * largest of the two fourth differences spanning its grid interval. Any data
+ * time for which this bound exceeds the table tolerance (e.g., near a
+ * discontinuity in the time correction tables), or that is not covered by
+ * the table, has its delay computed exactly instead.
+ *
+ * \param dts [out] A vector for the delays (must be the same length as \c datatimes )
+ * \param dtsdot [out] If not NULL, a vector for the time derivatives of the delays
+ * \param maxerr [out] If not NULL, the largest interpolation error bound (in seconds) of any returned delay
+ * \param table [in] The look-up table created by \c XLALCreateSSBDelayLookupTable
+ * \param datatimes [in] A vector of GPS times at Earth
+ * \param source [in] The source right ascension, declination (both in
+ * radians at epoch \c posepoch ) and inverse distance (in 1/s); other fields are ignored
+ * \param pmra [in] The proper motion in right ascension (rad/s)
+ * \param pmdec [in] The proper motion in declination (rad/s)
+ * \param posepoch [in] The epoch of the source position (GPS seconds)
+ * \param cgw [in] The speed of gravitational waves as a fraction of the speed
+ * of light (only applied to the Roemer delay if greater than zero)
+ */
+int XLALSSBDelayLookupTableGetDelays( REAL8Vector *dts,
+                                      REAL8Vector *dtsdot,
+                                      REAL8 *maxerr,
+                                      const SSBDelayLookupTable *table,
+                                      const LIGOTimeGPSVector *datatimes,
+                                      const BarycenterInput *source,
+                                      REAL8 pmra,
+                                      REAL8 pmdec,
+                                      REAL8 posepoch,
+                                      REAL8 cgw ){
+  XLAL_CHECK( dts != NULL, XLAL_EFAULT, "dts must not be NULL" );
+  XLAL_CHECK( table != NULL, XLAL_EFAULT, "table must not be NULL" );
+  XLAL_CHECK( datatimes != NULL, XLAL_EFAULT, "datatimes must not be NULL" );
+  XLAL_CHECK( source != NULL, XLAL_EFAULT, "source must not be NULL" );
+  XLAL_CHECK( dts->length == datatimes->length, XLAL_EBADLEN, "datatimes and dts must be the same length" );
+  XLAL_CHECK( dtsdot == NULL || dtsdot->length == datatimes->length, XLAL_EBADLEN, "datatimes and dtsdot must be the same length" );
+
+  UINT4 i = 0;
+  INT4 n = 0;
+  REAL8 h = table->dt, errmax = 0.;
+
+  /* delays at the nodes, computed when first needed */
+  REAL8 *nodedts = XLALMalloc(table->length*sizeof(REAL8));
+  UINT4 *havenode = XLALCalloc(table->length, sizeof(UINT4));
+  if ( nodedts == NULL || havenode == NULL ){
+    XLALFree( nodedts );
+    XLALFree( havenode );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+
+  for ( i = 0; i < datatimes->length; i++ ){
+    REAL8 x = XLALGPSDiff( &datatimes->data[i], &table->t0 )/h;
+    INT4 k = (INT4)floor(x);
+    REAL8 s = x - (REAL8)k;
+    UINT4 interp = ( k >= 2 && k + 3 < (INT4)table->length );
+
+    for ( n = k - 2; interp && n <= k + 3; n++ ){
+      if ( !table->computed[n] ){ interp = 0; break; }
+      if ( !havenode[n] ){
+        LIGOTimeGPS tnode = table->t0;
+        XLALGPSAdd( &tnode, (REAL8)n*h );
+        if ( ssb_delay_at_time( &nodedts[n], table, &table->earth[n], &tnode, source, pmra, pmdec, posepoch, cgw ) != XLAL_SUCCESS ){
+          XLALFree( nodedts );
+          XLALFree( havenode );
+          XLAL_ERROR( XLAL_EFUNC );
+        }
+        havenode[n] = 1;
+      }
+    }
+
+    if ( interp ){
+      const REAL8 *f = &nodedts[k];
+
+      /* certified error bound from the fourth differences spanning the interval */
+      REAL8 d4a = f[-2] - 4.*f[-1] + 6.*f[0] - 4.*f[1] + f[2];
+      REAL8 d4b = f[-1] - 4.*f[0] + 6.*f[1] - 4.*f[2] + f[3];
+      REAL8 err = 2.*(3./128.)*fmax(fabs(d4a), fabs(d4b));
+
+      if ( err <= table->tolerance ){
+        /* cubic Lagrange weights for nodes k-1, k, k+1, k+2 */
+        REAL8 sm1 = s - 1., sm2 = s - 2., sp1 = s + 1.;
+        dts->data[i] = -s*sm1*sm2*f[-1]/6. + sp1*sm1*sm2*f[0]/2. - sp1*s*sm2*f[1]/2. + sp1*s*sm1*f[2]/6.;
+
+        if ( dtsdot != NULL ){
+          REAL8 s2 = s*s;
+          dtsdot->data[i] = ( -(3.*s2 - 6.*s + 2.)*f[-1]/6. + (3.*s2 - 4.*s - 1.)*f[0]/2.
+                              - (3.*s2 - 2.*s - 2.)*f[1]/2. + (3.*s2 - 1.)*f[2]/6. )/h;
+        }
+
+        if ( err > errmax ){ errmax = err; }
+        continue;
+      }
+    }
+
+    /* fall back to exact barycentring (with a one second finite difference for the derivative) */
+    if ( ssb_delay_at_time( &dts->data[i], table, NULL, &datatimes->data[i], source, pmra, pmdec, posepoch, cgw ) != XLAL_SUCCESS ){
+      XLALFree( nodedts );
+      XLALFree( havenode );
+      XLAL_ERROR( XLAL_EFUNC );
+    }
+    if ( dtsdot != NULL ){
+      LIGOTimeGPS t2 = datatimes->data[i];
+      REAL8 dt2 = 0.;
+      XLALGPSAdd( &t2, 1. );
+      if ( ssb_delay_at_time( &dt2, table, NULL, &t2, source, pmra, pmdec, posepoch, cgw ) != XLAL_SUCCESS ){
+        XLALFree( nodedts );
+        XLALFree( havenode );
+        XLAL_ERROR( XLAL_EFUNC );
+      }
+      dtsdot->data[i] = dt2 - dts->data[i];
+    }
+  }
+
+  XLALFree( nodedts );
+  XLALFree( havenode );
+
+  if ( maxerr != NULL ){ *maxerr = errmax; }
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * \brief Computes the delay between a GPS time at Earth and the solar system barycentre using a look-up table
+ *
+ * This is equivalent to \c XLALHeterodynedPulsarGetSSBDelay , but
+ * interpolates the delays from a table of Earth states created with
+ * \c XLALCreateSSBDelayLookupTable (which must have been created for the same
+ * \c datatimes ), so that, e.g., the delays for many sources or sky positions
+ * can be calculated for the cost of one Earth state per grid node.
+ *
+ * \param pars [in] A set of pulsar parameters
+ * \param datatimes [in] A vector of GPS times at Earth
+ * \param table [in] The look-up table of Earth states
+ * \param maxerr [out] If not NULL, the largest interpolation error bound (in seconds)
+ *
+ * \return A vector of time delays in seconds
+ *
+ * \sa XLALSSBDelayLookupTableGetDelays
+ */
+REAL8Vector *XLALHeterodynedPulsarGetSSBDelayFromTable( PulsarParameters *pars,
+                                                        const LIGOTimeGPSVector *datatimes,
+                                                        const SSBDelayLookupTable *table,
+                                                        REAL8 *maxerr ){
+  /* check inputs */
+  XLAL_CHECK_NULL( pars != NULL, XLAL_EFAULT, "PulsarParameters must not be NULL" );
+  XLAL_CHECK_NULL( datatimes != NULL, XLAL_EFAULT, "datatimes must not be NULL" );
+  XLAL_CHECK_NULL( table != NULL, XLAL_EFAULT, "table must not be NULL" );
+
+  BarycenterInput source;
+  REAL8 pmra = 0., pmdec = 0., posepoch = 0., cgw = 0.;
+  XLAL_CHECK_NULL( ssb_delay_source_params( pars, &source, &pmra, &pmdec, &posepoch, &cgw ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  REAL8Vector *dts = XLALCreateREAL8Vector( datatimes->length );
+  XLAL_CHECK_NULL( dts != NULL, XLAL_EFUNC );
+
+  if ( XLALSSBDelayLookupTableGetDelays( dts, NULL, maxerr, table, datatimes, &source, pmra, pmdec, posepoch, cgw ) != XLAL_SUCCESS ){
+    XLALDestroyREAL8Vector( dts );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  return dts;
+}
+
+
 /**
  * \brief Computes the delay between a pulsar in a binary system and the barycentre of the system
  *
@@ -69,6 +69,25 @@ typedef struct tagDetResponseTimeLookupTable{
 }DetResponseTimeLookupTable;
 
 
+/**
+ * A table of Earth states on a uniform grid of times, from which solar system
+ * barycentre delays for any source can be interpolated (see
+ * XLALCreateSSBDelayLookupTable()).
+ */
+typedef struct tagSSBDelayLookupTable{
+  LIGOTimeGPS t0;                 /**< GPS time of the first grid node */
+  REAL8 dt;                       /**< spacing of the grid nodes in seconds */
+  UINT4 length;                   /**< number of grid nodes */
+  REAL8 tolerance;                /**< maximum allowed interpolation error in seconds */
+  LALDetector site;               /**< detector, with location in light seconds */
+  EarthState *earth;              /**< Earth states at the grid nodes */
+  UINT4 *computed;                /**< non-zero for the nodes at which \c earth has been computed */
+  const EphemerisData *ephem;     /**< solar system ephemeris */
+  const TimeCorrectionData *tdat; /**< time correction data */
+  TimeCorrectionType ttype;       /**< type of time system corrections */
+}SSBDelayLookupTable;
+
+
 /* ---------- Function prototypes ---------- */
 
 REAL8Vector *XLALHeterodynedPulsarPhaseDifference( PulsarParameters *params,
@@ -95,6 +114,31 @@ REAL8Vector *XLALHeterodynedPulsarGetSSBDelay( PulsarParameters *pars,
                                                const TimeCorrectionData *tdat,
                                                TimeCorrectionType ttype );
 
+SSBDelayLookupTable *XLALCreateSSBDelayLookupTable( const LIGOTimeGPSVector *datatimes,
+                                                    const LALDetector *detector,
+                                                    const EphemerisData *ephem,
+                                                    const TimeCorrectionData *tdat,
+                                                    TimeCorrectionType ttype,
+                                                    REAL8 tolerance );
+
+void XLALDestroySSBDelayLookupTable( SSBDelayLookupTable *table );
+
+int XLALSSBDelayLookupTableGetDelays( REAL8Vector *dts,
+                                      REAL8Vector *dtsdot,
+                                      REAL8 *maxerr,
+                                      const SSBDelayLookupTable *table,
+                                      const LIGOTimeGPSVector *datatimes,
+                                      const BarycenterInput *source,
+                                      REAL8 pmra,
+                                      REAL8 pmdec,
+                                      REAL8 posepoch,
+                                      REAL8 cgw );
+
+REAL8Vector *XLALHeterodynedPulsarGetSSBDelayFromTable( PulsarParameters *pars,
+                                                        const LIGOTimeGPSVector *datatimes,
+                                                        const SSBDelayLookupTable *table,
+                                                        REAL8 *maxerr );
+
 REAL8Vector *XLALHeterodynedPulsarGetBSBDelay( PulsarParameters *pars,
                                                const LIGOTimeGPSVector *datatimes,
                                                const REAL8Vector *dts,
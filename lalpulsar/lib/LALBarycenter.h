@@ -133,6 +133,7 @@ typedef struct tagEphemerisData
 #ifdef SWIG /* SWIG interface directives */
   SWIGLAL(ARRAY_1D(EphemerisData, PosVelAcc, ephemE, INT4, nentriesE));
   SWIGLAL(ARRAY_1D(EphemerisData, PosVelAcc, ephemS, INT4, nentriesS));
+  SWIGLAL(IGNORE_MEMBERS(tagEphemerisData, mappedE, mappedLengthE, mappedS, mappedLengthS));
 #endif /* SWIG */
   INT4  nentriesE;      /**< The number of entries in Earth ephemeris table. */
   INT4  nentriesS;      /**< The number of entries in Sun ephemeris table. */
@@ -145,6 +146,11 @@ typedef struct tagEphemerisData
   PosVelAcc *ephemS;    /**< Array with pos, vel and acc for the sun (see ephemE) */
 
   EphemerisType etype;  /**< The ephemeris type e.g. DE405 */
+
+  void *mappedE;        /**< Memory-mapped binary Earth ephemeris file backing \a ephemE, or NULL */
+  size_t mappedLengthE; /**< Length in bytes of \a mappedE */
+  void *mappedS;        /**< Memory-mapped binary Sun ephemeris file backing \a ephemS, or NULL */
+  size_t mappedLengthS; /**< Length in bytes of \a mappedS */
 }
 EphemerisData;
 
@@ -18,6 +18,18 @@
 *  MA  02111-1307  USA
 */
 
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
 #include <lal/FileIO.h>
 #include <lal/LALBarycenter.h>
 #include <lal/LALInitBarycenter.h>
@@ -32,6 +44,11 @@
 #define NORM3D(x) ( SQ( (x)[0]) + SQ( (x)[1] ) + SQ ( (x)[2] ) )
 #define LENGTH3D(x) ( sqrt( NORM3D ( (x) ) ) )
 
+/* binary ephemeris-file format */
+#define EPHEM_BINARY_MAGIC      "LALEPHEM"
+#define EPHEM_BINARY_VERSION    1
+#define EPHEM_BINARY_BYTE_ORDER 0x01020304
+
 /** \endcond */
 
 /* ----- local type definitions ---------- */
@@ -46,9 +63,33 @@ typedef struct
   UINT4 length;      	/**< number of ephemeris-data entries */
   REAL8 dt;      	/**< spacing in seconds between consecutive instants in ephemeris table.*/
   PosVelAcc *data;    	/**< array containing pos,vel,acc as extracted from ephem file. Units are sec, 1, 1/sec respectively */
+  EphemerisType etype;	/**< ephemeris type recorded in a binary ephem file, or EPHEM_NONE if unknown */
+  void *mapped;		/**< memory-mapped binary ephem file that 'data' points into, or NULL if 'data' was allocated */
+  size_t mappedLength;	/**< length in bytes of 'mapped' */
 }
 EphemerisVector;
 
+/**
+ * Header of a binary ephemeris file, as written by XLALConvertEphemerisFileToBinary().
+ * The header is followed directly by 'length' PosVelAcc entries in native byte order,
+ * such that the file can be memory-mapped and the entries used in place.
+ */
+typedef struct
+{
+  CHAR magic[8];	/**< EPHEM_BINARY_MAGIC, without terminating '\0' */
+  UINT4 version;	/**< file-format version, EPHEM_BINARY_VERSION */
+  UINT4 byteOrder;	/**< EPHEM_BINARY_BYTE_ORDER, used to detect a byte order mismatch */
+  INT4 etype;		/**< ephemeris type, see EphemerisType */
+  UINT4 length;		/**< number of ephemeris-data entries */
+  REAL8 dt;		/**< spacing in seconds between consecutive entries */
+  REAL8 gpsStart;	/**< timestamp of the first entry */
+  UINT4 headerSize;	/**< size in bytes of this header, i.e. offset of the first entry */
+  UINT4 recordSize;	/**< size in bytes of one entry, i.e. sizeof(PosVelAcc) */
+  UINT8 checksum;	/**< checksum of the entries, computed by XLALEphemerisBinaryChecksum() */
+  UINT8 reserved;	/**< reserved for future use, set to zero */
+}
+EphemerisBinaryHeader;
+
 /* ----- internal prototypes ---------- */
 EphemerisVector *XLALCreateEphemerisVector ( UINT4 length );
 void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
@@ -56,6 +97,12 @@ void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
 EphemerisVector * XLALReadEphemerisFile ( const CHAR *fname);
 int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3], REAL8 range[3] );
 
+static EphemerisType XLALEphemerisTypeFromFileName ( const CHAR *fname );
+static UINT8 XLALEphemerisBinaryChecksum ( const PosVelAcc *data, UINT4 length );
+static int XLALIsEphemerisBinaryFile ( const CHAR *fname_path );
+static EphemerisVector *XLALReadEphemerisBinaryFile ( const CHAR *fname_path );
+static void XLALFreeEphemerisTable ( PosVelAcc *table, void **mapped, size_t *mappedLength );
+
 /* ----- function definitions ---------- */
 
 /* ========== exported API ========== */
@@ -199,52 +246,23 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
                      const CHAR *sunEphemerisFile            /**< File containing Sun's position. */
                      )
 {
-  EphemerisType sun_etype, earth_etype, etype;
-
   /* check user input consistency */
   if ( !earthEphemerisFile || !sunEphemerisFile )
     XLAL_ERROR_NULL (XLAL_EINVAL, "Invalid NULL input earthEphemerisFile=%p, sunEphemerisFile=%p\n", earthEphemerisFile, sunEphemerisFile );
 
-  /* determine EARTH ephemeris type from file name*/
-  if ( strstr( earthEphemerisFile, "DE200" ) )
-    earth_etype = EPHEM_DE200;
-  else if ( strstr( earthEphemerisFile, "DE405" ) )
-    earth_etype = EPHEM_DE405;
-  else if ( strstr( earthEphemerisFile, "DE414" ) )
-    earth_etype = EPHEM_DE414;
-  else if ( strstr( earthEphemerisFile, "DE421" ) )
-    earth_etype = EPHEM_DE421;
-  else if ( strstr( earthEphemerisFile, "DE430" ) )
-    earth_etype = EPHEM_DE430;
-  else
-    earth_etype = EPHEM_DE405;
-
-  /* determine SUN ephemeris type from file name */
-  if ( strstr( sunEphemerisFile, "DE200" ) )
-    sun_etype = EPHEM_DE200;
-  else if ( strstr( sunEphemerisFile, "DE405" ) )
-    sun_etype = EPHEM_DE405;
-  else if ( strstr( sunEphemerisFile, "DE414" ) )
-    sun_etype = EPHEM_DE414;
-  else if ( strstr( sunEphemerisFile, "DE421" ) )
-    sun_etype = EPHEM_DE421;
-  else if ( strstr( sunEphemerisFile, "DE430" ) )
-    sun_etype = EPHEM_DE430;
-  else
-    sun_etype = EPHEM_DE405;
-
-  // check consistency
-  if ( earth_etype != sun_etype )
-    XLAL_ERROR_NULL (XLAL_EINVAL, "Earth '%s' and Sun '%s' ephemeris-files have inconsistent coordinate-types %d != %d\n",
-                     earthEphemerisFile, sunEphemerisFile, earth_etype, sun_etype );
-  else
-    etype = earth_etype;
+  /* determine EARTH and SUN ephemeris types from file names */
+  EphemerisType earth_etype = XLALEphemerisTypeFromFileName ( earthEphemerisFile );
+  EphemerisType sun_etype = XLALEphemerisTypeFromFileName ( sunEphemerisFile );
 
   EphemerisVector *ephemV;
   /* ----- read EARTH ephemeris file ---------- */
   if ( ( ephemV = XLALReadEphemerisFile ( earthEphemerisFile )) == NULL )
     XLAL_ERROR_NULL (XLAL_EFUNC, "XLALReadEphemerisFile('%s') failed\n", earthEphemerisFile );
 
+  /* a binary ephemeris file records its own ephemeris type */
+  if ( ephemV->etype != EPHEM_NONE )
+    earth_etype = ephemV->etype;
+
   /* typical position, velocity and acceleration and allowed ranged */
   REAL8 avgE[3] = {499.0,  1e-4, 2e-11 };
   REAL8 rangeE[3] = {25.0, 1e-5, 3e-12 };
@@ -264,7 +282,9 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   edat->nentriesE = ephemV->length;
   edat->dtEtable  = ephemV->dt;
   edat->ephemE    = ephemV->data;
-  edat->etype     = etype;
+  edat->mappedE   = ephemV->mapped;
+  edat->mappedLengthE = ephemV->mappedLength;
+  edat->etype     = earth_etype;
   XLALFree ( ephemV );	/* don't use 'destroy', as we linked the data into edat! */
   ephemV = NULL;
 
@@ -275,6 +295,18 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
       XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALReadEphemerisFile('%s') failed\n", sunEphemerisFile );
     }
 
+  if ( ephemV->etype != EPHEM_NONE )
+    sun_etype = ephemV->etype;
+
+  // check consistency
+  if ( earth_etype != sun_etype )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLALDestroyEphemerisData ( edat );
+      XLAL_ERROR_NULL (XLAL_EINVAL, "Earth '%s' and Sun '%s' ephemeris-files have inconsistent coordinate-types %d != %d\n",
+                       earthEphemerisFile, sunEphemerisFile, earth_etype, sun_etype );
+    }
+
   /* typical position, velocity and acceleration and allowed ranged */
   REAL8 avgS[3] = { 2.7, 4.2e-8, 7.0e-16 };
   REAL8 rangeS[3] = { 2.5, 1.4e-8, 2.8e-16 };
@@ -290,6 +322,8 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   edat->nentriesS = ephemV->length;
   edat->dtStable  = ephemV->dt;
   edat->ephemS    = ephemV->data;
+  edat->mappedS   = ephemV->mapped;
+  edat->mappedLengthS = ephemV->mappedLength;
   XLALFree ( ephemV );	/* don't use 'destroy', as we linked the data into edat! */
   ephemV = NULL;
 
@@ -319,11 +353,8 @@ XLALDestroyEphemerisData ( EphemerisData *edat )
   if ( edat->filenameS )
     XLALFree ( edat->filenameS );
 
-  if ( edat->ephemE )
-    XLALFree ( edat->ephemE );
-
-  if ( edat->ephemS )
-    XLALFree ( edat->ephemS );
+  XLALFreeEphemerisTable ( edat->ephemE, &edat->mappedE, &edat->mappedLengthE );
+  XLALFreeEphemerisTable ( edat->ephemS, &edat->mappedS, &edat->mappedLengthS );
 
   XLALFree ( edat );
 
@@ -367,7 +398,7 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
   XLAL_CHECK(new_ephemE != NULL, XLAL_ENOMEM);
   memcpy(new_ephemE, edat->ephemE, edat->nentriesE * sizeof(*new_ephemE));
   edat->ephemE = new_ephemE;
-  XLALFree(old_ephemE);
+  XLALFreeEphemerisTable(old_ephemE, &edat->mappedE, &edat->mappedLengthE);
 
   // Increase 'ephemS' and decrease 'nentriesS' to fit the range ['start', 'end']
   PosVelAcc *const old_ephemS = edat->ephemS;
@@ -387,13 +418,71 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
   XLAL_CHECK(new_ephemS != NULL, XLAL_ENOMEM);
   memcpy(new_ephemS, edat->ephemS, edat->nentriesS * sizeof(*new_ephemS));
   edat->ephemS = new_ephemS;
-  XLALFree(old_ephemS);
+  XLALFreeEphemerisTable(old_ephemS, &edat->mappedS, &edat->mappedLengthS);
 
   return XLAL_SUCCESS;
 
 } /* XLALRestrictEphemerisData() */
 
 
+/**
+ * Convert an ephemeris file, as read by XLALInitBarycenter(), into a binary ephemeris file.
+ *
+ * The binary file consists of a validated header followed by the PosVelAcc entries in native
+ * byte order; XLALInitBarycenter() recognises such files by their header and memory-maps them,
+ * which avoids decompressing and parsing the text tables at every start-up, and lets processes
+ * on the same machine share the ephemeris pages. The ephemeris type is taken from the name of
+ * 'ephemerisFile' in the same way as in XLALInitBarycenter(), and stored in the header.
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALConvertEphemerisFileToBinary ( const CHAR *binaryFile,	/**< [in] Name of binary ephemeris file to write */
+                                   const CHAR *ephemerisFile	/**< [in] Name of ephemeris file to read */
+                                   )
+{
+  XLAL_CHECK ( binaryFile != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( ephemerisFile != NULL, XLAL_EFAULT );
+
+  EphemerisVector *ephemV = XLALReadEphemerisFile ( ephemerisFile );
+  XLAL_CHECK ( ephemV != NULL, XLAL_EFUNC, "XLALReadEphemerisFile('%s') failed\n", ephemerisFile );
+  if ( ephemV->length == 0 )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLAL_ERROR ( XLAL_EDOM, "Ephemeris-file '%s' contains no entries\n", ephemerisFile );
+    }
+
+  /* fill header */
+  EphemerisBinaryHeader XLAL_INIT_DECL(header);
+  memcpy ( header.magic, EPHEM_BINARY_MAGIC, sizeof(header.magic) );
+  header.version = EPHEM_BINARY_VERSION;
+  header.byteOrder = EPHEM_BINARY_BYTE_ORDER;
+  header.etype = ( ephemV->etype != EPHEM_NONE ) ? ephemV->etype : XLALEphemerisTypeFromFileName ( ephemerisFile );
+  header.length = ephemV->length;
+  header.dt = ephemV->dt;
+  header.gpsStart = ephemV->data[0].gps;
+  header.headerSize = sizeof(header);
+  header.recordSize = sizeof(ephemV->data[0]);
+  header.checksum = XLALEphemerisBinaryChecksum ( ephemV->data, ephemV->length );
+
+  /* write header and entries */
+  FILE *fp = fopen ( binaryFile, "wb" );
+  if ( fp == NULL )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLAL_ERROR ( XLAL_EIO, "Failed to open binary ephemeris-file '%s' for writing\n", binaryFile );
+    }
+  int ok = ( fwrite ( &header, sizeof(header), 1, fp ) == 1 );
+  ok = ok && ( fwrite ( ephemV->data, sizeof(ephemV->data[0]), ephemV->length, fp ) == ephemV->length );
+  ok = ( fclose ( fp ) == 0 ) && ok;
+  XLALDestroyEphemerisVector ( ephemV );
+  XLAL_CHECK ( ok, XLAL_EIO, "Failed to write binary ephemeris-file '%s'\n", binaryFile );
+
+  return XLAL_SUCCESS;
+
+} /* XLALConvertEphemerisFileToBinary() */
+
+
 /* ========== internal function definitions ========== */
 
 /** simple creator function for EphemerisVector type */
@@ -425,8 +514,7 @@ XLALDestroyEphemerisVector ( EphemerisVector *ephemV )
   if ( !ephemV )
     return;
 
-  if ( ephemV->data )
-    XLALFree ( ephemV->data );
+  XLALFreeEphemerisTable ( ephemV->data, &ephemV->mapped, &ephemV->mappedLength );
 
   XLALFree ( ephemV );
 
@@ -454,6 +542,9 @@ XLALPulsarFileResolvePath ( const char *fname	  //!< [in] filename or file-path
  *
  * NOTE2: files are searches first locally, then in LAL_DATA_PATH, and finally in PKG_DATA_DIR
  * using XLALPulsarFileResolvePath()
+ *
+ * NOTE3: binary ephemeris files written by XLALConvertEphemerisFileToBinary() are recognised
+ * by their header, and are memory-mapped instead of parsed.
  */
 EphemerisVector *
 XLALReadEphemerisFile ( const CHAR *fname )
@@ -480,6 +571,15 @@ XLALReadEphemerisFile ( const CHAR *fname )
 
   // if we're here, it means we found it
 
+  // binary ephemeris files are mapped directly
+  if ( XLALIsEphemerisBinaryFile ( fname_path ) )
+    {
+      EphemerisVector *ephemV = XLALReadEphemerisBinaryFile ( fname_path );
+      XLALFree ( fname_path );
+      XLAL_CHECK_NULL ( ephemV != NULL, XLAL_EFUNC, "Failed to read binary ephemeris-file '%s'\n", fname );
+      return ephemV;
+    }
+
   // read in whole file (compressed or not) with XLALParseDataFile(), which ignores comment header lines
   LALParsedDataFile *flines = NULL;
   XLAL_CHECK_NULL ( XLALParseDataFile ( &flines, fname_path ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -648,3 +748,228 @@ XLALCheckEphemerisRanges ( const EphemerisVector *ephemV, REAL8 avg[3], REAL8 ra
   return XLAL_SUCCESS;
 
 } /* XLALCheckEphemerisRanges() */
+
+
+/**
+ * Determine the ephemeris type from an ephemeris-file name, defaulting to DE405.
+ */
+static EphemerisType
+XLALEphemerisTypeFromFileName ( const CHAR *fname )
+{
+  if ( strstr( fname, "DE200" ) )
+    return EPHEM_DE200;
+  else if ( strstr( fname, "DE405" ) )
+    return EPHEM_DE405;
+  else if ( strstr( fname, "DE414" ) )
+    return EPHEM_DE414;
+  else if ( strstr( fname, "DE421" ) )
+    return EPHEM_DE421;
+  else if ( strstr( fname, "DE430" ) )
+    return EPHEM_DE430;
+  else
+    return EPHEM_DE405;
+
+} /* XLALEphemerisTypeFromFileName() */
+
+
+/**
+ * Position-dependent (Fletcher-style) checksum over the 64-bit words of the ephemeris entries,
+ * used to detect truncated or corrupted binary ephemeris files.
+ */
+static UINT8
+XLALEphemerisBinaryChecksum ( const PosVelAcc *data, UINT4 length )
+{
+  const unsigned char *bytes = (const unsigned char *) data;
+  const size_t nWords = ( (size_t) length * sizeof(*data) ) / sizeof(UINT8);
+  UINT8 sum1 = 0, sum2 = 0;
+  for ( size_t i = 0; i < nWords; ++i )
+    {
+      UINT8 word;
+      memcpy ( &word, bytes + i * sizeof(word), sizeof(word) );
+      sum1 += word;
+      sum2 += sum1;
+    }
+  return sum1 ^ ( ( sum2 << 32 ) | ( sum2 >> 32 ) );
+
+} /* XLALEphemerisBinaryChecksum() */
+
+
+/**
+ * Return true if the (resolved) file 'fname_path' starts with the binary ephemeris-file magic string.
+ */
+static int
+XLALIsEphemerisBinaryFile ( const CHAR *fname_path )
+{
+  CHAR magic[sizeof(EPHEM_BINARY_MAGIC) - 1];
+  FILE *fp = fopen ( fname_path, "rb" );
+  if ( fp == NULL )
+    return 0;
+  int ret = ( fread ( magic, sizeof(magic), 1, fp ) == 1 ) && ( memcmp ( magic, EPHEM_BINARY_MAGIC, sizeof(magic) ) == 0 );
+  fclose ( fp );
+  return ret;
+
+} /* XLALIsEphemerisBinaryFile() */
+
+
+/**
+ * Read a binary ephemeris file written by XLALConvertEphemerisFileToBinary().
+ * Where supported, the file is memory-mapped and the returned EphemerisVector
+ * points into the mapping; otherwise the entries are read into allocated memory.
+ * The header and the checksum of the entries are validated in both cases.
+ */
+static EphemerisVector *
+XLALReadEphemerisBinaryFile ( const CHAR *fname_path )
+{
+  EphemerisBinaryHeader header;
+  EphemerisVector *ephemV = NULL;
+
+#ifdef HAVE_SYS_MMAN_H
+
+  /* map the whole file; the mapping is private, so pages are shared between processes until written to */
+  int fd = open ( fname_path, O_RDONLY );
+  XLAL_CHECK_NULL ( fd >= 0, XLAL_EIO, "Failed to open binary ephemeris-file '%s'\n", fname_path );
+  struct stat st;
+  if ( fstat ( fd, &st ) != 0 || (size_t) st.st_size < sizeof(header) )
+    {
+      close ( fd );
+      XLAL_ERROR_NULL ( XLAL_EIO, "Binary ephemeris-file '%s' is too short to contain a header\n", fname_path );
+    }
+  const size_t fileLength = st.st_size;
+  void *mapped = mmap ( NULL, fileLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+  close ( fd );
+  XLAL_CHECK_NULL ( mapped != MAP_FAILED, XLAL_EIO, "Failed to memory-map binary ephemeris-file '%s'\n", fname_path );
+  memcpy ( &header, mapped, sizeof(header) );
+
+#else /* !HAVE_SYS_MMAN_H */
+
+  FILE *fp = fopen ( fname_path, "rb" );
+  XLAL_CHECK_NULL ( fp != NULL, XLAL_EIO, "Failed to open binary ephemeris-file '%s'\n", fname_path );
+  if ( fread ( &header, sizeof(header), 1, fp ) != 1 )
+    {
+      fclose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EIO, "Binary ephemeris-file '%s' is too short to contain a header\n", fname_path );
+    }
+
+#endif /* HAVE_SYS_MMAN_H */
+
+  /* validate header */
+  int errnum = XLAL_SUCCESS;
+  if ( memcmp ( header.magic, EPHEM_BINARY_MAGIC, sizeof(header.magic) ) != 0 )
+    {
+      XLALPrintError ( "%s: '%s' is not a binary ephemeris-file\n", __func__, fname_path );
+      errnum = XLAL_EIO;
+    }
+  else if ( header.version != EPHEM_BINARY_VERSION )
+    {
+      XLALPrintError ( "%s: Unsupported version %u of binary ephemeris-file '%s' (expected %u)\n", __func__, header.version, fname_path, EPHEM_BINARY_VERSION );
+      errnum = XLAL_EIO;
+    }
+  else if ( header.byteOrder != EPHEM_BINARY_BYTE_ORDER )
+    {
+      XLALPrintError ( "%s: Binary ephemeris-file '%s' was written with a different byte order\n", __func__, fname_path );
+      errnum = XLAL_EIO;
+    }
+  else if ( header.headerSize != sizeof(header) || header.recordSize != sizeof(PosVelAcc) )
+    {
+      XLALPrintError ( "%s: Binary ephemeris-file '%s' has incompatible header/record sizes %u/%u (expected %zu/%zu)\n",
+                       __func__, fname_path, header.headerSize, header.recordSize, sizeof(header), sizeof(PosVelAcc) );
+      errnum = XLAL_EIO;
+    }
+  else if ( header.length == 0 || header.etype <= EPHEM_NONE || header.etype >= EPHEM_LAST || !( header.dt > 0 ) )
+    {
+      XLALPrintError ( "%s: Binary ephemeris-file '%s' has an invalid header: length=%u, etype=%d, dt=%g\n",
+                       __func__, fname_path, header.length, header.etype, header.dt );
+      errnum = XLAL_EDOM;
+    }
+#ifdef HAVE_SYS_MMAN_H
+  else if ( fileLength < header.headerSize + (size_t) header.length * header.recordSize )
+    {
+      XLALPrintError ( "%s: Binary ephemeris-file '%s' is truncated: %zu bytes, expected %zu\n",
+                       __func__, fname_path, fileLength, header.headerSize + (size_t) header.length * header.recordSize );
+      errnum = XLAL_EIO;
+    }
+#endif
+
+  /* get ephemeris entries */
+  if ( errnum == XLAL_SUCCESS )
+    {
+#ifdef HAVE_SYS_MMAN_H
+      if ( ( ephemV = XLALCalloc ( 1, sizeof(*ephemV) ) ) == NULL )
+        errnum = XLAL_ENOMEM;
+      else
+        {
+          ephemV->length = header.length;
+          ephemV->data = (PosVelAcc *) ( ( (char *) mapped ) + header.headerSize );
+          ephemV->mapped = mapped;
+          ephemV->mappedLength = fileLength;
+          mapped = NULL;
+        }
+#else /* !HAVE_SYS_MMAN_H */
+      if ( ( ephemV = XLALCreateEphemerisVector ( header.length ) ) == NULL )
+        errnum = XLAL_EFUNC;
+      else if ( fread ( ephemV->data, sizeof(ephemV->data[0]), ephemV->length, fp ) != ephemV->length )
+        {
+          XLALPrintError ( "%s: Binary ephemeris-file '%s' is truncated\n", __func__, fname_path );
+          errnum = XLAL_EIO;
+        }
+#endif /* HAVE_SYS_MMAN_H */
+    }
+
+#ifdef HAVE_SYS_MMAN_H
+  if ( mapped != NULL )
+    munmap ( mapped, fileLength );
+#else
+  fclose ( fp );
+#endif
+
+  /* validate entries */
+  if ( errnum == XLAL_SUCCESS )
+    {
+      ephemV->dt = header.dt;
+      ephemV->etype = header.etype;
+      if ( XLALEphemerisBinaryChecksum ( ephemV->data, ephemV->length ) != header.checksum )
+        {
+          XLALPrintError ( "%s: Checksum mismatch in binary ephemeris-file '%s'\n", __func__, fname_path );
+          errnum = XLAL_EIO;
+        }
+      else if ( ephemV->data[0].gps != header.gpsStart )
+        {
+          XLALPrintError ( "%s: Wrong first timestamp in binary ephemeris-file '%s': %le/%le\n", __func__, fname_path, ephemV->data[0].gps, header.gpsStart );
+          errnum = XLAL_EDOM;
+        }
+    }
+
+  if ( errnum != XLAL_SUCCESS )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLAL_ERROR_NULL ( errnum );
+    }
+
+  return ephemV;
+
+} /* XLALReadEphemerisBinaryFile() */
+
+
+/**
+ * Free an ephemeris table, or unmap the binary ephemeris file it was mapped from.
+ * A table which does not point into 'mapped' (e.g. after XLALRestrictEphemerisData())
+ * is freed; any mapping is released in either case. NULL robust.
+ */
+static void
+XLALFreeEphemerisTable ( PosVelAcc *table, void **mapped, size_t *mappedLength )
+{
+  const char *ptable = (const char *) table;
+  const char *pmapped = (const char *) (*mapped);
+  if ( table != NULL && ( pmapped == NULL || ptable < pmapped || ptable >= pmapped + (*mappedLength) ) )
+    XLALFree ( table );
+
+#ifdef HAVE_SYS_MMAN_H
+  if ( pmapped != NULL )
+    munmap ( *mapped, *mappedLength );
+#endif
+  (*mapped) = NULL;
+  (*mappedLength) = 0;
+
+  return;
+
+} /* XLALFreeEphemerisTable() */
@@ -33,6 +33,7 @@ EphemerisData * XLALInitBarycenter ( const CHAR *earthEphemerisFile, const CHAR
 void XLALDestroyEphemerisData ( EphemerisData *edat );
 
 int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS, const LIGOTimeGPS *endGPS );
+int XLALConvertEphemerisFileToBinary ( const CHAR *binaryFile, const CHAR *ephemerisFile );
 
 TimeCorrectionData *XLALInitTimeCorrections ( const CHAR *timeCorrectionFile );
 void XLALDestroyTimeCorrectionData( TimeCorrectionData *tcd );
@@ -59,8 +59,28 @@
  * of SFT vectors and also returns a collection of power-estimates for these vectors using
  * the Running median method.
  *
+ * The vector functions share the SFTs between OpenMP threads, if available; each thread
+ * keeps its own running-median workspace and periodogram buffer, so that no memory is
+ * allocated per SFT.
+ *
  */
 
+/*---------- internal types ----------*/
+
+/* per-thread workspace for computing the running medians of many SFTs */
+typedef struct tagRngmedWorkspace {
+  LALRunningMedian *rm;		/* running-median workspace, NULL if blockSize == 0 */
+  REAL8Vector *periodo;		/* buffer for periodograms of up to periodo->length bins */
+} RngmedWorkspace;
+
+/*---------- internal prototypes ----------*/
+static RngmedWorkspace *CreateRngmedWorkspace ( UINT4 blockSize, UINT4 maxLength );
+static void DestroyRngmedWorkspace ( RngmedWorkspace *ws );
+static int NormalizeSFT ( REAL8FrequencySeries *rngmed, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS, RngmedWorkspace *ws );
+static int SFTtoRngmed ( REAL8FrequencySeries *rngmed, const SFTtype *sft, UINT4 blockSize, RngmedWorkspace *ws );
+static int PeriodoToRngmed ( REAL8FrequencySeries *rngmed, const REAL8FrequencySeries *periodo, UINT4 blockSize, LALRunningMedian *rm );
+
+
 /**
  * Normalize an sft based on RngMed estimated PSD, and returns running-median.
  */
@@ -74,6 +94,27 @@ XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, 	/**< [out] rng-median smoothed
   /* check input argments */
   XLAL_CHECK (sft && sft->data && sft->data->data && sft->data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input in 'sft'" );
 
+  RngmedWorkspace *ws = NULL;
+  if ( assumeSqrtS == 0 ) {
+    XLAL_CHECK ( (ws = CreateRngmedWorkspace ( blockSize, sft->data->length )) != NULL, XLAL_EFUNC );
+  }
+
+  int retn = NormalizeSFT ( rngmed, sft, blockSize, assumeSqrtS, ws );
+  DestroyRngmedWorkspace ( ws );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} /* XLALNormalizeSFT() */
+
+
+/* XLALNormalizeSFT() using the workspace 'ws' */
+static int
+NormalizeSFT ( REAL8FrequencySeries *rngmed, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS, RngmedWorkspace *ws )
+{
+  /* check input argments */
+  XLAL_CHECK (sft && sft->data && sft->data->data && sft->data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input in 'sft'" );
+
   XLAL_CHECK ( rngmed && rngmed->data && rngmed->data->data && rngmed->data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input in 'rngmed'" );
   /* make sure there is no size mismatch */
   UINT4 length = sft->data->length;
@@ -83,7 +124,7 @@ XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, 	/**< [out] rng-median smoothed
 
   if ( assumeSqrtS == 0)
     { /* calculate the rngmed */
-      XLAL_CHECK ( XLALSFTtoRngmed (rngmed, sft, blockSize) == XLAL_SUCCESS, XLAL_EFUNC, "XLALSFTtoRngmed() failed" );
+      XLAL_CHECK ( SFTtoRngmed (rngmed, sft, blockSize, ws) == XLAL_SUCCESS, XLAL_EFUNC, "SFTtoRngmed() failed" );
     }
   else
     {
@@ -113,7 +154,7 @@ XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, 	/**< [out] rng-median smoothed
 
   return XLAL_SUCCESS;
 
-} /* XLALNormalizeSFT() */
+} /* NormalizeSFT() */
 
 
 /**
@@ -131,24 +172,42 @@ XLALNormalizeSFTVect ( SFTVector  *sftVect,		/**< [in/out] pointer to a vector o
   /* memory allocation of rngmed using length of first sft -- assume all sfts have the same length*/
   UINT4 lengthsft = sftVect->data->data->length;
 
-  /* allocate memory for a single rngmed */
-  REAL8FrequencySeries *rngmed;
-  XLAL_CHECK ( ( rngmed = XLALCalloc(1, sizeof(*rngmed))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%zu)", sizeof(*rngmed) );
-  XLAL_CHECK ( ( rngmed->data = XLALCreateREAL8Vector ( lengthsft ) ) != NULL, XLAL_EFUNC, "XLALCreateREAL8Vector ( %d ) failed.", lengthsft );
+  int errnum = 0;
+#pragma omp parallel
+  {
+    /* allocate memory for a single rngmed, and a running-median workspace, per thread */
+    REAL8FrequencySeries XLAL_INIT_DECL(rngmed);
+    RngmedWorkspace *ws = NULL;
+    int errnum_t = 0;
+    if ( ( rngmed.data = XLALCreateREAL8Vector ( lengthsft ) ) == NULL ) {
+      errnum_t = XLAL_EFUNC;
+    } else if ( assumeSqrtS == 0 && ( ws = CreateRngmedWorkspace ( blockSize, lengthsft ) ) == NULL ) {
+      errnum_t = XLAL_EFUNC;
+    }
 
-  /* loop over sfts and normalize them */
-  for (UINT4 j = 0; j < sftVect->length; j++)
-    {
-      SFTtype *sft = &sftVect->data[j];
+    /* loop over sfts and normalize them */
+#pragma omp for schedule(dynamic)
+    for ( INT4 j = 0; j < (INT4)sftVect->length; j++ )
+      {
+        SFTtype *sft = &sftVect->data[j];
+
+        /* call sft normalization function */
+        if ( errnum_t == 0 && NormalizeSFT ( &rngmed, sft, blockSize, assumeSqrtS, ws ) != XLAL_SUCCESS ) {
+          errnum_t = XLAL_EFUNC;
+        }
 
-      /* call sft normalization function */
-      XLAL_CHECK ( XLALNormalizeSFT ( rngmed, sft, blockSize, assumeSqrtS ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALNormalizeSFT() failed." );
+      } /* for j < sftVect->length */
 
-    } /* for j < sftVect->length */
+    /* free memory for psd */
+    XLALDestroyREAL8Vector ( rngmed.data );
+    DestroyRngmedWorkspace ( ws );
 
-  /* free memory for psd */
-  XLALDestroyREAL8Vector ( rngmed->data );
-  XLALFree(rngmed);
+    if ( errnum_t != 0 ) {
+#pragma omp critical (XLALNormalizeSFTVect)
+      errnum = errnum_t;
+    }
+  } /* omp parallel */
+  XLAL_CHECK ( errnum == 0, errnum, "XLALNormalizeSFT() failed." );
 
   return XLAL_SUCCESS;
 
@@ -177,7 +236,8 @@ XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft,		/**< [in/out] multi-vector
   multiPSD->length = numifo;
   XLAL_CHECK_NULL ( ( multiPSD->data = XLALCalloc ( numifo, sizeof(*multiPSD->data))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc ( %d, %zu)", numifo, sizeof(*multiPSD->data) );
 
-  /* loop over ifos */
+  /* loop over ifos and allocate psd vectors */
+  UINT4 maxlengthsft = 0;
   for ( UINT4 X = 0; X < numifo; X++ )
     {
       UINT4 numsft = multsft->data[X]->length;
@@ -192,20 +252,52 @@ XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft,		/**< [in/out] multi-vector
       for ( UINT4 j = 0; j < numsft; j++ )
         {
           SFTtype *sft = &multsft->data[X]->data[j];
+          XLAL_CHECK_NULL ( sft->data != NULL, XLAL_EINVAL, "Invalid NULL pointer in SFT data" );
 
           /* memory allocation of psd vector for this SFT */
           UINT4 lengthsft = sft->data->length;
           XLAL_CHECK_NULL ( (multiPSD->data[X]->data[j].data = XLALCreateREAL8Vector ( lengthsft ) ) != NULL, XLAL_EFUNC, "XLALCreateREAL8Vector(%d) failed.", lengthsft );
-
-          /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
-          const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
-
-          XLAL_CHECK_NULL( XLALNormalizeSFT ( &multiPSD->data[X]->data[j], sft, blockSize, assumeSqrtS ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALNormalizeSFT() failed");
+          if ( lengthsft > maxlengthsft ) {
+            maxlengthsft = lengthsft;
+          }
 
         } /* for j < numsft */
 
     } /* for X < numifo */
 
+  /* loop over ifos and normalize their sfts, sharing the sfts of each ifo between threads */
+  int errnum = 0;
+#pragma omp parallel
+  {
+    /* allocate a running-median workspace per thread */
+    RngmedWorkspace *ws = CreateRngmedWorkspace ( blockSize, maxlengthsft );
+    int errnum_t = ( ws == NULL ) ? XLAL_EFUNC : 0;
+
+    for ( UINT4 X = 0; X < numifo; X++ )
+      {
+        /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
+        const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
+
+#pragma omp for schedule(dynamic)
+        for ( INT4 j = 0; j < (INT4)multsft->data[X]->length; j++ )
+          {
+            SFTtype *sft = &multsft->data[X]->data[j];
+            if ( errnum_t == 0 && NormalizeSFT ( &multiPSD->data[X]->data[j], sft, blockSize, assumeSqrtS, ws ) != XLAL_SUCCESS ) {
+              errnum_t = XLAL_EFUNC;
+            }
+          } /* for j < numsft */
+
+      } /* for X < numifo */
+
+    DestroyRngmedWorkspace ( ws );
+
+    if ( errnum_t != 0 ) {
+#pragma omp critical (XLALNormalizeMultiSFTVect)
+      errnum = errnum_t;
+    }
+  } /* omp parallel */
+  XLAL_CHECK_NULL ( errnum == 0, errnum, "XLALNormalizeSFT() failed" );
+
   return multiPSD;
 
 } /* XLALNormalizeMultiSFTVect() */
@@ -219,6 +311,25 @@ XLALSFTtoRngmed ( REAL8FrequencySeries *rngmed,	/**< [out] running-median smooth
                   const SFTtype *sft,		/**< [in]  input SFT */
                   UINT4 blockSize		/**< Running median block size */
                   )
+{
+  /* check argments */
+  XLAL_CHECK ( sft != NULL && sft->data != NULL, XLAL_EINVAL, "Invalid NULL pointer passed in 'sft'" );
+
+  RngmedWorkspace *ws;
+  XLAL_CHECK ( (ws = CreateRngmedWorkspace ( blockSize, sft->data->length )) != NULL, XLAL_EFUNC );
+
+  int retn = SFTtoRngmed ( rngmed, sft, blockSize, ws );
+  DestroyRngmedWorkspace ( ws );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} /* XLALSFTtoRngmed() */
+
+
+/* XLALSFTtoRngmed() using the workspace 'ws' */
+static int
+SFTtoRngmed ( REAL8FrequencySeries *rngmed, const SFTtype *sft, UINT4 blockSize, RngmedWorkspace *ws )
 {
   /* check argments */
   XLAL_CHECK ( sft != NULL, XLAL_EINVAL, "Invalid NULL pointer passed in 'sft'" );
@@ -231,10 +342,15 @@ XLALSFTtoRngmed ( REAL8FrequencySeries *rngmed,	/**< [out] running-median smooth
                rngmed->data->length, sft->data->length );
   XLAL_CHECK ( rngmed->data->data != NULL, XLAL_EINVAL, "Invalid NULL pointer in rngmed->data->data" );
 
+  XLAL_CHECK ( ws != NULL && ws->periodo != NULL, XLAL_EINVAL, "Invalid NULL running-median workspace" );
+
   UINT4 length = sft->data->length;
+  XLAL_CHECK ( length <= ws->periodo->length, XLAL_EINVAL, "SFT length (%d) exceeds periodogram buffer length (%d)", length, ws->periodo->length );
 
+  /* use the workspace buffer for the periodogram */
   REAL8FrequencySeries periodo;
-  XLAL_CHECK ( (periodo.data = XLALCreateREAL8Vector ( length )) != NULL, XLAL_EFUNC, "Failed to allocate periodo.data of length %d", length);
+  REAL8Vector periodoData = { length, ws->periodo->data };
+  periodo.data = &periodoData;
 
   /* calculate the periodogram */
   XLAL_CHECK ( XLALSFTtoPeriodogram ( &periodo, sft ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to XLALSFTtoPeriodogram() failed.\n");
@@ -242,7 +358,7 @@ XLALSFTtoRngmed ( REAL8FrequencySeries *rngmed,	/**< [out] running-median smooth
   /* calculate the rngmed */
   if ( blockSize > 0 )
     {
-      XLAL_CHECK ( XLALPeriodoToRngmed ( rngmed, &periodo, blockSize ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to XLALPeriodoToRngmed() failed." );
+      XLAL_CHECK ( PeriodoToRngmed ( rngmed, &periodo, blockSize, ws->rm ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to PeriodoToRngmed() failed." );
     }
   else	// blockSize==0 means don't use any running-median, just *copy* the periodogram contents into the output
     {
@@ -254,13 +370,9 @@ XLALSFTtoRngmed ( REAL8FrequencySeries *rngmed,	/**< [out] running-median smooth
       memcpy ( rngmed->data->data, periodo.data->data, periodo.data->length * sizeof(periodo.data->data[0]) );
     }
 
-  /* free memory */
-  XLALFree ( periodo.data->data );
-  XLALFree ( periodo.data );
-
   return XLAL_SUCCESS;
 
-} /* XLALSFTtoRngmed() */
+} /* SFTtoRngmed() */
 
 /**
  * Calculate the "periodogram" of an SFT, ie the modulus-squares of the SFT-data.
@@ -314,6 +426,24 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
                       const REAL8FrequencySeries  *periodo,	/**< [in] input periodogram */
                       UINT4 blockSize				/**< Running median block size */
                       )
+{
+  XLAL_CHECK ( blockSize > 0, XLAL_EINVAL, "'blockSize = %d' must be > 0", blockSize );
+
+  LALRunningMedian *rm;
+  XLAL_CHECK ( (rm = XLALCreateRunningMedian ( blockSize )) != NULL, XLAL_EFUNC );
+
+  int retn = PeriodoToRngmed ( rngmed, periodo, blockSize, rm );
+  XLALDestroyRunningMedian ( rm );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} /* XLALPeriodoToRngmed() */
+
+
+/* XLALPeriodoToRngmed() using the running-median workspace 'rm' */
+static int
+PeriodoToRngmed ( REAL8FrequencySeries *rngmed, const REAL8FrequencySeries *periodo, UINT4 blockSize, LALRunningMedian *rm )
 {
   /* check input argments are not NULL */
   XLAL_CHECK ( periodo != NULL && periodo->data != NULL && periodo->data->data && periodo->data->length > 0,
@@ -325,6 +455,7 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
                XLAL_EINVAL, "'periodo' vector must be same length (%d) as 'rngmed' vector (%d)", periodo->data->length, rngmed->data->length );
   XLAL_CHECK ( blockSize > 0, XLAL_EINVAL, "'blockSize = %d' must be > 0", blockSize );
   XLAL_CHECK( length >= blockSize, XLAL_EINVAL, "Need at least %d bins in SFT (have %d) to perform running median!\n", blockSize, length );
+  XLAL_CHECK ( rm != NULL && XLALRunningMedianBlocksize ( rm ) == blockSize, XLAL_EINVAL, "Invalid running-median workspace for 'blockSize = %d'", blockSize );
 
   /* copy periodogram header */
   strcpy ( rngmed->name, periodo->name );
@@ -334,8 +465,6 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
 
   UINT4 blocks2 = blockSize/2; /* integer division, round down */
 
-  LALRunningMedianPar rngMedPar;
-  rngMedPar.blocksize = blockSize;
   REAL8Sequence mediansV, inputV;
   inputV.length = length;
   inputV.data = periodo->data->data;
@@ -343,9 +472,7 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
   mediansV.length = medianVLength;
   mediansV.data = rngmed->data->data + blocks2;
 
-  LALStatus XLAL_INIT_DECL(status);
-  LALDRunningMedian2 ( &status, &mediansV, &inputV, rngMedPar);
-  XLAL_CHECK ( status.statusCode == 0, XLAL_EFAILED, "LALDRunningMedian2() failed with statusCode = %d", status.statusCode );
+  XLAL_CHECK ( XLALDRunningMedian ( rm, &mediansV, &inputV ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   /* copy values in the wings */
   for ( UINT4 j=0; j<blocks2; j++)
@@ -365,7 +492,37 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
 
   return XLAL_SUCCESS;
 
-} /* XLALPeriodoToRngmed() */
+} /* PeriodoToRngmed() */
+
+
+/* create a running-median workspace for SFTs of up to maxLength bins */
+static RngmedWorkspace *
+CreateRngmedWorkspace ( UINT4 blockSize, UINT4 maxLength )
+{
+  RngmedWorkspace *ws;
+  XLAL_CHECK_NULL ( (ws = XLALCalloc ( 1, sizeof(*ws) )) != NULL, XLAL_ENOMEM );
+  if ( (ws->periodo = XLALCreateREAL8Vector ( maxLength )) == NULL ) {
+    DestroyRngmedWorkspace ( ws );
+    XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALCreateREAL8Vector(%d) failed.", maxLength );
+  }
+  if ( blockSize > 0 && (ws->rm = XLALCreateRunningMedian ( blockSize )) == NULL ) {
+    DestroyRngmedWorkspace ( ws );
+    XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALCreateRunningMedian(%d) failed.", blockSize );
+  }
+  return ws;
+} /* CreateRngmedWorkspace() */
+
+
+/* destroy a running-median workspace */
+static void
+DestroyRngmedWorkspace ( RngmedWorkspace *ws )
+{
+  if ( ws != NULL ) {
+    XLALDestroyRunningMedian ( ws->rm );
+    XLALDestroyREAL8Vector ( ws->periodo );
+    XLALFree ( ws );
+  }
+} /* DestroyRngmedWorkspace() */
 
 
 /**
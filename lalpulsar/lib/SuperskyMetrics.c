@@ -112,7 +112,8 @@ static gsl_matrix *SM_ComputePhaseMetric(
   const MultiLALDetector *detectors,            ///< [in] List of detectors to average metric over
   const MultiNoiseFloor *detector_weights,      ///< [in] Weights used to combine single-detector metrics (default: unit weights)
   const DetectorMotionType detector_motion,     ///< [in] Which detector motion to use
-  const EphemerisData *ephemerides              ///< [in] Earth/Sun ephemerides
+  const EphemerisData *ephemerides,             ///< [in] Earth/Sun ephemerides
+  const DopplerMetricIntegration integration    ///< [in] Method used to integrate the metric
   )
 {
 
@@ -167,6 +168,9 @@ static gsl_matrix *SM_ComputePhaseMetric(
   // Do not include sky-position-dependent Roemer delay in time variable
   par.approxPhase = 1;
 
+  // Set metric integration method
+  par.integration = integration;
+
   // Call XLALComputeDopplerPhaseMetric() and check output
   DopplerPhaseMetric *metric = XLALComputeDopplerPhaseMetric( &par, ephemerides );
   XLAL_CHECK_NULL( metric != NULL && metric->g_ij != NULL, XLAL_EFUNC, "XLALComputeDopplerPhaseMetric() failed" );
@@ -584,16 +588,20 @@ static int SM_ComputeReducedSuperskyMetric(
 
 }
 
-SuperskyMetrics *XLALComputeSuperskyMetrics(
-  const SuperskyMetricType type,
-  const size_t spindowns,
-  const LIGOTimeGPS *ref_time,
-  const LALSegList *segments,
-  const double fiducial_freq,
-  const MultiLALDetector *detectors,
-  const MultiNoiseFloor *detector_weights,
-  const DetectorMotionType detector_motion,
-  const EphemerisData *ephemerides
+///
+/// Compute the supersky metrics, using the given method to integrate the phase metrics of each segment.
+///
+static SuperskyMetrics *SM_ComputeSuperskyMetrics(
+  const SuperskyMetricType type,                ///< [in] Type of supersky metric to compute
+  const size_t spindowns,                       ///< [in] Number of frequency+spindown coordinates
+  const LIGOTimeGPS *ref_time,                  ///< [in] Reference time for the metrics
+  const LALSegList *segments,                   ///< [in] List of segments to compute metrics over
+  const double fiducial_freq,                   ///< [in] Fiducial frequency for sky-position coordinates
+  const MultiLALDetector *detectors,            ///< [in] List of detectors to average metrics over
+  const MultiNoiseFloor *detector_weights,      ///< [in] Weights used to combine single-detector metrics (default: unit weights)
+  const DetectorMotionType detector_motion,     ///< [in] Which detector motion to use
+  const EphemerisData *ephemerides,             ///< [in] Earth/Sun ephemerides
+  const DopplerMetricIntegration integration    ///< [in] Method used to integrate the phase metrics
   )
 {
 
@@ -662,12 +670,12 @@ SuperskyMetrics *XLALComputeSuperskyMetrics(
     const LIGOTimeGPS *end_time_seg = &segments->segs[n].end;
 
     // Compute the unrestricted supersky metric
-    gsl_matrix *ussky_metric_seg = SM_ComputePhaseMetric( &ucoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides );
+    gsl_matrix *ussky_metric_seg = SM_ComputePhaseMetric( &ucoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides, integration );
     XLAL_CHECK_NULL( ussky_metric_seg != NULL, XLAL_EFUNC );
     gsl_matrix_add( ussky_metric_avg, ussky_metric_seg );
 
     // Compute the orbital metric in ecliptic coordinates
-    gsl_matrix *orbital_metric_seg = SM_ComputePhaseMetric( &ocoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides );
+    gsl_matrix *orbital_metric_seg = SM_ComputePhaseMetric( &ocoords, ref_time, start_time_seg, end_time_seg, detectors, detector_weights, detector_motion, ephemerides, integration );
     XLAL_CHECK_NULL( orbital_metric_seg != NULL, XLAL_EFUNC );
     gsl_matrix_add( orbital_metric_avg, orbital_metric_seg );
 
@@ -700,6 +708,40 @@ SuperskyMetrics *XLALComputeSuperskyMetrics(
 
 }
 
+SuperskyMetrics *XLALComputeSuperskyMetrics(
+  const SuperskyMetricType type,
+  const size_t spindowns,
+  const LIGOTimeGPS *ref_time,
+  const LALSegList *segments,
+  const double fiducial_freq,
+  const MultiLALDetector *detectors,
+  const MultiNoiseFloor *detector_weights,
+  const DetectorMotionType detector_motion,
+  const EphemerisData *ephemerides
+  )
+{
+  SuperskyMetrics *metrics = SM_ComputeSuperskyMetrics( type, spindowns, ref_time, segments, fiducial_freq, detectors, detector_weights, detector_motion, ephemerides, DOPPLERMETRIC_INTEGRATION_ADAPTIVE );
+  XLAL_CHECK_NULL( metrics != NULL, XLAL_EFUNC );
+  return metrics;
+}
+
+SuperskyMetrics *XLALComputeSuperskyMetricsFixedNode(
+  const SuperskyMetricType type,
+  const size_t spindowns,
+  const LIGOTimeGPS *ref_time,
+  const LALSegList *segments,
+  const double fiducial_freq,
+  const MultiLALDetector *detectors,
+  const MultiNoiseFloor *detector_weights,
+  const DetectorMotionType detector_motion,
+  const EphemerisData *ephemerides
+  )
+{
+  SuperskyMetrics *metrics = SM_ComputeSuperskyMetrics( type, spindowns, ref_time, segments, fiducial_freq, detectors, detector_weights, detector_motion, ephemerides, DOPPLERMETRIC_INTEGRATION_FIXEDNODE );
+  XLAL_CHECK_NULL( metrics != NULL, XLAL_EFUNC );
+  return metrics;
+}
+
 SuperskyMetrics *XLALCopySuperskyMetrics(
   const SuperskyMetrics *metrics
   )
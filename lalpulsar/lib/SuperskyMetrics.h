@@ -90,6 +90,23 @@ SuperskyMetrics *XLALComputeSuperskyMetrics(
   const EphemerisData *ephemerides              ///< [in] Earth/Sun ephemerides
   );
 
+///
+/// Compute the supersky metrics, as for XLALComputeSuperskyMetrics(), but integrate the phase metric of each
+/// segment using fixed-node Gauss-Legendre quadrature (#DOPPLERMETRIC_INTEGRATION_FIXEDNODE) instead of
+/// adaptive quadrature. This is much faster when computing metrics for many segments.
+///
+SuperskyMetrics *XLALComputeSuperskyMetricsFixedNode(
+  const SuperskyMetricType type,                ///< [in] Type of supersky metric to compute
+  const size_t spindowns,                       ///< [in] Number of frequency+spindown coordinates
+  const LIGOTimeGPS *ref_time,                  ///< [in] Reference time for the metrics
+  const LALSegList *segments,                   ///< [in] List of segments to compute metrics over
+  const double fiducial_freq,                   ///< [in] Fiducial frequency for sky-position coordinates
+  const MultiLALDetector *detectors,            ///< [in] List of detectors to average metrics over
+  const MultiNoiseFloor *detector_weights,      ///< [in] Weights used to combine single-detector metrics (default: unit weights)
+  const DetectorMotionType detector_motion,     ///< [in] Which detector motion to use
+  const EphemerisData *ephemerides              ///< [in] Earth/Sun ephemerides
+  );
+
 ///
 /// Copy a #SuperskyMetrics struct.
 ///
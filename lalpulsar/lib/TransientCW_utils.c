@@ -44,6 +44,7 @@
 #include "ComputeFstat_internal.h"
 
 /* ----- MACRO definitions ---------- */
+#define TRANSIENT_FSTATMAP_BLOCK	64	// number of consecutive start-times t0 computed per thread in XLALComputeTransientFstatMap()
 
 /* ----- module-local fast lookup-table handling of negative exponentials ----- */
 /**
@@ -57,6 +58,26 @@ static gsl_vector *expLUT = NULL; 	/**< module-global lookup-table for negative
 
 static int XLALCreateExpLUT ( void );	/* only ever used internally, destructor is in exported API */
 
+/* ----- module-local types for computing transient F-stat maps ----- */
+/** Sums of F-stat atoms over a transient window */
+typedef struct tagAtomSums_t {
+  REAL8 Ad, Bd, Cd;		/**< antenna-pattern matrix */
+  COMPLEX16 Fa, Fb;		/**< Fa, Fb */
+} AtomSums_t;
+
+/** Recursion state for updating exponential-window atom sums from one start-time to the next */
+typedef struct tagExpWindowState_t {
+  BOOLEAN valid;		/**< whether 'sums' holds valid sums over [i0, i1] */
+  UINT4 i0;			/**< first atom summed */
+  UINT4 i1;			/**< last atom summed */
+  AtomSums_t sums;		/**< atom sums, with window-values relative to atom i0 */
+} ExpWindowState_t;
+
+static int XLALComputeTransientFstatMapBlock ( gsl_matrix *F_mn, REAL8 *maxF_m, UINT4 *n_maxF_m, UINT4 *m_err, UINT4 *n_err,
+                                               const FstatAtomVector *atoms, const AtomSums_t *cumSums, ExpWindowState_t *expStates, const REAL8 *expRatio,
+                                               transientWindowRange_t windowRange, UINT4 m_start, UINT4 m_end, BOOLEAN useFReg );
+static void XLALUpdateExpWindowState ( ExpWindowState_t *state, const FstatAtomVector *atoms, REAL8 r, UINT4 i0, UINT4 i1 );
+
 static const char *transientWindowNames[TRANSIENT_LAST] =
   {
     [TRANSIENT_NONE]	 	= "none",
@@ -628,6 +649,11 @@ XLALComputeTransientPosterior_tau ( transientWindowRange_t windowRange,		/**< [i
  * little practical interest, except for demonstrating that marginalizing (1/D)e^F is *less* sensitive
  * than marginalizing e^F (see transient methods-paper [in prepartion])
  *
+ * Note3: rectangular windows are summed from cumulative sums over the atoms, so each {t0,tau} costs O(1).
+ * Exponential windows are updated recursively from one t0 to the next (in blocks of TRANSIENT_FSTATMAP_BLOCK
+ * start-times), costing O(dt0/TAtom) per {t0,tau}. Blocks of start-times are computed in parallel if
+ * compiled with OpenMP.
+ *
  */
 transientFstatMap_t *
 XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**< [in] multi-IFO F-statistic atoms */
@@ -652,14 +678,22 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
     XLAL_ERROR_NULL ( XLAL_ENOMEM );
   }
 
+  /* internal mem, freed at 'cleanup' on success and on all error paths */
+  int errcode = 0;
+  FstatAtomVector *atoms = NULL;
+  AtomSums_t *cumSums = NULL;
+  ExpWindowState_t *expStates = NULL;
+  REAL8 *expRatio = NULL;
+  REAL8 *maxF_m = NULL;
+  UINT4 *n_maxF_m = NULL;
+
   /* ----- first combine all multi-atoms into a single atoms-vector with *unique* timestamps */
-  FstatAtomVector *atoms;
   UINT4 TAtom = multiFstatAtoms->data[0]->TAtom;
-  UINT4 TAtomHalf = TAtom/2;	/* integer division */
 
   if ( (atoms = XLALmergeMultiFstatAtomsBinned ( multiFstatAtoms, TAtom )) == NULL ) {
     XLALPrintError ("%s: XLALmergeMultiFstatAtomsSorted() failed with code %d\n", __func__, xlalErrno );
-    XLAL_ERROR_NULL ( XLAL_EFUNC );
+    errcode = XLAL_EFUNC;
+    goto cleanup;
   }
   UINT4 numAtoms = atoms->length;
   /* actual data spans [t0_data, t0_data + numAtoms * TAtom] in steps of TAtom */
@@ -703,40 +737,197 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
 
   if ( ( ret->F_mn = gsl_matrix_calloc ( N_t0Range, N_tauRange )) == NULL ) {
     XLALPrintError ("%s: failed ret->F_mn = gsl_matrix_calloc ( %d, %d )\n", __func__, N_tauRange, N_t0Range );
-    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+    errcode = XLAL_ENOMEM;
+    goto cleanup;
   }
 
-  transientWindow_t win_mn;
-  win_mn.type = windowRange.type;
-  ret->maxF = -1.0;	// keep track of loudest F-stat point. Initializing to a negative value ensures that we always update at least once and hence return sane t0_d_ML, tau_d_ML even if there is only a single bin where F=0 happens.
-  UINT4 m, n;
-  /* ----- OUTER loop over start-times [t0,t0+t0Band] ---------- */
-  for ( m = 0; m < N_t0Range; m ++ ) /* m enumerates 'binned' t0 start-time indices  */
+  /* ----- prepare the cumulative atom-sums (rectangular windows) or per-tau recursion states (exponential windows) */
+  UINT4 numBlocks = ( N_t0Range + TRANSIENT_FSTATMAP_BLOCK - 1 ) / TRANSIENT_FSTATMAP_BLOCK;
+  switch ( windowRange.type )
+    {
+    case TRANSIENT_RECTANGULAR:
+      /* cumSums[i] = sum over atoms [0, i), so the sum over [i_t0, i_t1] = cumSums[i_t1+1] - cumSums[i_t0] */
+      if ( (cumSums = XLALCalloc ( numAtoms + 1, sizeof(*cumSums) )) == NULL ) {
+        XLALPrintError ("%s: XLALCalloc(%d,%zu) failed.\n", __func__, numAtoms + 1, sizeof(*cumSums) );
+        errcode = XLAL_ENOMEM;
+        goto cleanup;
+      }
+      for ( UINT4 i = 0; i < numAtoms; i ++ )
+        {
+          const FstatAtom *thisAtom_i = &atoms->data[i];
+          cumSums[i+1].Ad = cumSums[i].Ad + thisAtom_i->a2_alpha;
+          cumSums[i+1].Bd = cumSums[i].Bd + thisAtom_i->b2_alpha;
+          cumSums[i+1].Cd = cumSums[i].Cd + thisAtom_i->ab_alpha;
+          cumSums[i+1].Fa = cumSums[i].Fa + thisAtom_i->Fa_alpha;
+          cumSums[i+1].Fb = cumSums[i].Fb + thisAtom_i->Fb_alpha;
+        }
+      break;
+
+    case TRANSIENT_EXPONENTIAL:
+      /* one recursion state per {block, tau}, and the ratio e^(-TAtom/tau) between neighbouring atoms' window-values */
+      if ( (expStates = XLALCalloc ( numBlocks * N_tauRange, sizeof(*expStates) )) == NULL ) {
+        XLALPrintError ("%s: XLALCalloc(%d,%zu) failed.\n", __func__, numBlocks * N_tauRange, sizeof(*expStates) );
+        errcode = XLAL_ENOMEM;
+        goto cleanup;
+      }
+      if ( (expRatio = XLALCalloc ( N_tauRange, sizeof(*expRatio) )) == NULL ) {
+        XLALPrintError ("%s: XLALCalloc(%d,%zu) failed.\n", __func__, N_tauRange, sizeof(*expRatio) );
+        errcode = XLAL_ENOMEM;
+        goto cleanup;
+      }
+      for ( UINT4 n = 0; n < N_tauRange; n ++ ) {
+        expRatio[n] = exp ( - 1.0 * TAtom / ( windowRange.tau + n * windowRange.dtau ) );
+      }
+      break;
+
+    default:
+      XLALPrintError ("%s: invalid transient window type %d not in [%d, %d].\n",
+                      __func__, windowRange.type, TRANSIENT_NONE, TRANSIENT_LAST -1 );
+      errcode = XLAL_EINVAL;
+      goto cleanup;
+    } /* switch window.type */
+
+  /* per-t0 loudest F-stat value, reduced over all t0 after the (parallel) loop */
+  if ( (maxF_m = XLALCalloc ( N_t0Range, sizeof(*maxF_m) )) == NULL || (n_maxF_m = XLALCalloc ( N_t0Range, sizeof(*n_maxF_m) )) == NULL ) {
+    XLALPrintError ("%s: XLALCalloc(%d,...) failed.\n", __func__, N_t0Range );
+    errcode = XLAL_ENOMEM;
+    goto cleanup;
+  }
+
+  /* ----- OUTER loop over blocks of start-times [t0,t0+t0Band] ---------- */
+  int errnum = 0;
+  UINT4 m_err = 0, n_err = 0;
+  INT4 b;
+#pragma omp parallel for schedule(dynamic,1)
+  for ( b = 0; b < (INT4)numBlocks; b ++ )
+    {
+      UINT4 m_start = b * TRANSIENT_FSTATMAP_BLOCK;
+      UINT4 m_end = m_start + TRANSIENT_FSTATMAP_BLOCK;
+      if ( m_end > N_t0Range ) m_end = N_t0Range;
+      ExpWindowState_t *blockStates = ( expStates != NULL ) ? &expStates[b * N_tauRange] : NULL;
+      UINT4 m_bad = 0, n_bad = 0;
+      int errnum_b = XLALComputeTransientFstatMapBlock ( ret->F_mn, maxF_m, n_maxF_m, &m_bad, &n_bad, atoms, cumSums, blockStates, expRatio,
+                                                         windowRange, m_start, m_end, useFReg );
+      if ( errnum_b != 0 )
+        {
+#pragma omp critical (XLALComputeTransientFstatMap)
+          if ( errnum == 0 || m_bad < m_err )
+            {
+              errnum = errnum_b;
+              m_err = m_bad;
+              n_err = n_bad;
+            }
+        }
+    } /* for b < numBlocks */
+
+  if ( errnum != 0 )
     {
+      /* protection against degenerate 1-atom case: (this implies D=0 and therefore F->inf) */
+      UINT4 win_t0 = windowRange.t0 + m_err * windowRange.dt0;
+      INT4 i_tmp = ( win_t0 - t0_data + TAtom/2 ) / TAtom;
+      UINT4 i_t0 = ( i_tmp < 0 ) ? 0 : ( ( (UINT4)i_tmp >= numAtoms ) ? numAtoms - 1 : (UINT4)i_tmp );
+      XLALPrintError ("%s: encountered a single-atom Fstat-calculation. This is degenerate and cannot be computed!\n", __func__ );
+      XLALPrintError ("Window-values m=%d (t0=%d=t0_data + %d), n=%d (tau=%d) ==> t1_data - t0 = %d\n",
+                      m_err, win_t0, i_t0 * TAtom, n_err, windowRange.tau + n_err * windowRange.dtau, t1_data - win_t0 );
+      XLALPrintError ("The most likely cause is that your t0-range covered all of your data: t0 must stay away *at least* 2*TAtom from the end of the data!\n");
+      errcode = XLAL_EDOM;
+      goto cleanup;
+    }
+
+  /* keep track of loudest F-stat point. Initializing to a negative value ensures that we always update at least once and hence return sane t0_d_ML, tau_d_ML even if there is only a single bin where F=0 happens.
+   * Reducing in order of increasing m returns the same {t0,tau} as a serial loop would.
+   */
+  ret->maxF = -1.0;
+  for ( UINT4 m = 0; m < N_t0Range; m ++ )
+    {
+      if ( maxF_m[m] > ret->maxF )
+        {
+          ret->maxF = maxF_m[m];
+          ret->t0_ML  = windowRange.t0 + m * windowRange.dt0;			/* start-time t0 corresponding to Fmax */
+          ret->tau_ML = windowRange.tau + n_maxF_m[m] * windowRange.dtau;	/* timescale tau corresponding to Fmax */
+        }
+    }
+
+ cleanup:
+  /* free internal mem */
+  XLALFree ( cumSums );
+  XLALFree ( expStates );
+  XLALFree ( expRatio );
+  XLALFree ( maxF_m );
+  XLALFree ( n_maxF_m );
+  XLALDestroyFstatAtomVector ( atoms );
+
+  if ( errcode != 0 ) {
+    XLALDestroyTransientFstatMap ( ret );
+    XLAL_ERROR_NULL ( errcode );
+  }
+
+  /* return end product: F-stat map */
+  return ret;
+
+} /* XLALComputeTransientFstatMap() */
+
+
+/**
+ * Compute rows [m_start, m_end) of the transient F-statistic map F_mn, see XLALComputeTransientFstatMap().
+ *
+ * Rectangular windows are summed from the cumulative sums 'cumSums'. For exponential windows, 'expStates'
+ * holds one recursion state per timescale tau, which is updated from start-time t0_{m+1} to t0_m
+ * by dropping the atoms beyond the new window end and prepending the atoms before the old window start.
+ *
+ * This function is called from within an OpenMP parallel region: it does not raise XLAL errors, but
+ * returns a non-zero error code and the offending {m,n} indices in 'm_err', 'n_err'.
+ */
+static int
+XLALComputeTransientFstatMapBlock ( gsl_matrix *F_mn,			/**< [out] F-stat map, rows [m_start, m_end) are set */
+                                    REAL8 *maxF_m,			/**< [out] loudest F over each row m */
+                                    UINT4 *n_maxF_m,			/**< [out] tau-index n of loudest F over each row m */
+                                    UINT4 *m_err,			/**< [out] t0-index m of degenerate window, if any */
+                                    UINT4 *n_err,			/**< [out] tau-index n of degenerate window, if any */
+                                    const FstatAtomVector *atoms,	/**< [in] binned F-stat atoms */
+                                    const AtomSums_t *cumSums,		/**< [in] cumulative atom sums (rectangular windows) */
+                                    ExpWindowState_t *expStates,	/**< [in/out] per-tau recursion states (exponential windows) */
+                                    const REAL8 *expRatio,		/**< [in] per-tau ratio e^(-TAtom/tau) (exponential windows) */
+                                    transientWindowRange_t windowRange,	/**< [in] type and parameters specifying transient window range */
+                                    UINT4 m_start,			/**< [in] first t0-index to compute */
+                                    UINT4 m_end,			/**< [in] last+1 t0-index to compute */
+                                    BOOLEAN useFReg			/**< [in] compute FReg = F - log(D) instead of F */
+                                    )
+{
+  UINT4 numAtoms = atoms->length;
+  UINT4 TAtom = atoms->TAtom;
+  UINT4 TAtomHalf = TAtom/2;	/* integer division */
+  UINT4 t0_data = atoms->data[0].timestamp;
+  UINT4 N_tauRange = F_mn->size2;
+
+  /* exponential-window recursions run from the last to the first start-time,
+   * so that window-values of atoms already summed are only ever multiplied by factors <= 1
+   */
+  for ( UINT4 mm = m_end; mm > m_start; mm -- )
+    {
+      UINT4 m = mm - 1;	/* m enumerates 'binned' t0 start-time indices  */
+
       /* compute Fstat-atom index i_t0 in [0, numAtoms) */
-      win_mn.t0 = windowRange.t0 + m * windowRange.dt0;
-      INT4 i_tmp = ( win_mn.t0 - t0_data + TAtomHalf ) / TAtom;	// integer round: floor(x+0.5)
+      UINT4 win_t0 = windowRange.t0 + m * windowRange.dt0;
+      INT4 i_tmp = ( win_t0 - t0_data + TAtomHalf ) / TAtom;	// integer round: floor(x+0.5)
       if ( i_tmp < 0 ) i_tmp = 0;
       UINT4 i_t0 = (UINT4)i_tmp;
       if ( i_t0 >= numAtoms ) i_t0 = numAtoms - 1;
 
-      /* ----- INNER loop over timescale-parameter tau ---------- */
-      REAL4 Ad=0, Bd=0, Cd=0;
-      COMPLEX8 Fa=0, Fb=0;
-      UINT4 i_t1_last = i_t0;
+      maxF_m[m] = -1.0;
+      n_maxF_m[m] = 0;
 
-      for ( n = 0; n < N_tauRange; n ++ )
+      /* ----- INNER loop over timescale-parameter tau ---------- */
+      for ( UINT4 n = 0; n < N_tauRange; n ++ )
         {
-          /* translate n into an atoms end-index for this search interval [t0, t0+Tcoh],
-           * giving the index range of atoms to sum over
-           */
-          win_mn.tau = windowRange.tau + n * windowRange.dtau;
-
-          /* get end-time t1 of this transient-window search */
-          UINT4 t0, t1;
-          if ( XLALGetTransientWindowTimespan ( &t0, &t1, win_mn ) != XLAL_SUCCESS ) {
-            XLALPrintError ("%s: XLALGetTransientWindowTimespan() failed.\n", __func__ );
-            XLAL_ERROR_NULL ( XLAL_EFUNC );
+          UINT4 win_tau = windowRange.tau + n * windowRange.dtau;
+
+          /* get end-time t1 of this transient-window search, see XLALGetTransientWindowTimespan() */
+          UINT4 t1;
+          if ( windowRange.type == TRANSIENT_EXPONENTIAL ) {
+            t1 = lround( win_t0 + TRANSIENT_EXP_EFOLDING * win_tau );
+          } else {
+            t1 = win_t0 + win_tau;
           }
 
           /* compute window end-time Fstat-atom index i_t1 in [0, numAtoms) */
@@ -747,90 +938,63 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
 
           /* protection against degenerate 1-atom case: (this implies D=0 and therefore F->inf) */
           if ( i_t1 == i_t0 ) {
-            XLALPrintError ("%s: encountered a single-atom Fstat-calculation. This is degenerate and cannot be computed!\n", __func__ );
-            XLALPrintError ("Window-values m=%d (t0=%d=t0_data + %d), n=%d (tau=%d) ==> t1_data - t0 = %d\n",
-                            m, win_mn.t0, i_t0 * TAtom, n, win_mn.tau, t1_data - win_mn.t0 );
-            XLALPrintError ("The most likely cause is that your t0-range covered all of your data: t0 must stay away *at least* 2*TAtom from the end of the data!\n");
-            XLAL_ERROR_NULL ( XLAL_EDOM );
+            (*m_err) = m;
+            (*n_err) = n;
+            return XLAL_EDOM;
           }
 
           /* now we have two valid atoms-indices [i_t0, i_t1] spanning our Fstat-window to sum over,
            * using weights according to the window-type
            */
-          switch ( windowRange.type )
+          REAL8 Ad, Bd, Cd;
+          COMPLEX16 Fa, Fb;
+          if ( windowRange.type == TRANSIENT_RECTANGULAR )
             {
-            case TRANSIENT_RECTANGULAR:
-#if 0
-              /* 'vanilla' unoptimized method, for sanity checks with 'optimized' method */
-              Ad=0; Bd=0; Cd=0; Fa=0; Fb=0;
-              for ( UINT4 i = i_t0; i <= i_t1; i ++ )
-#else
-              /* special optimiziation in the rectangular-window case: just add on to previous tau values
-               * ie re-use the sum over [i_t0, i_t1_last] from the pevious tau-loop iteration
-               */
-              for ( UINT4 i = i_t1_last; i <= i_t1; i ++ )
-#endif
-                {
-                  FstatAtom *thisAtom_i = &atoms->data[i];
-
-                  /* now add on top of previous values, summed from [i_t0, i_t1_last] */
-                  Ad += thisAtom_i->a2_alpha;
-                  Bd += thisAtom_i->b2_alpha;
-                  Cd += thisAtom_i->ab_alpha;
-
-                  Fa += thisAtom_i->Fa_alpha;
-                  Fb += thisAtom_i->Fb_alpha;
-
-                } /* for i = i_t1_last : i_t1 */
-
-              i_t1_last = i_t1 + 1;		/* keep track of up to where we summed for the next iteration */
-
-              break;
-
-            case TRANSIENT_EXPONENTIAL:
-              /* reset all values */
-              Ad=0; Bd=0; Cd=0; Fa=0; Fb=0;
+              Ad = cumSums[i_t1+1].Ad - cumSums[i_t0].Ad;
+              Bd = cumSums[i_t1+1].Bd - cumSums[i_t0].Bd;
+              Cd = cumSums[i_t1+1].Cd - cumSums[i_t0].Cd;
+              Fa = cumSums[i_t1+1].Fa - cumSums[i_t0].Fa;
+              Fb = cumSums[i_t1+1].Fb - cumSums[i_t0].Fb;
+            }
+          else
+            {
+              /* the exponential window is zero outside of [t0, t1]: restrict [i_t0, i_t1] to atoms inside the window */
+              UINT4 i0 = i_t0, i1 = i_t1;
+              if ( t0_data + i0 * TAtom < win_t0 ) i0 ++;
+              if ( t0_data + i1 * TAtom > t1 ) i1 --;
 
-              for ( UINT4 i = i_t0; i <= i_t1; i ++ )
+              ExpWindowState_t *state = &expStates[n];
+              if ( i0 > i1 )
                 {
-                  FstatAtom *thisAtom_i = &atoms->data[i];
-                  UINT4 t_i = thisAtom_i->timestamp;
-
-                  REAL8 win_i;
-                  win_i = XLALGetExponentialTransientWindowValue ( t_i, t0, t1, win_mn.tau );
-
-                  REAL8 win2_i = win_i * win_i;
-
-                  Ad += thisAtom_i->a2_alpha * win2_i;
-                  Bd += thisAtom_i->b2_alpha * win2_i;
-                  Cd += thisAtom_i->ab_alpha * win2_i;
-
-                  Fa += thisAtom_i->Fa_alpha * win_i;
-                  Fb += thisAtom_i->Fb_alpha * win_i;
-
-                } /* for i in [i_t0, i_t1] */
-              break;
-
-            default:
-              XLALPrintError ("%s: invalid transient window type %d not in [%d, %d].\n",
-                              __func__, windowRange.type, TRANSIENT_NONE, TRANSIENT_LAST -1 );
-              XLAL_ERROR_NULL ( XLAL_EINVAL );
-              break;
-
-            } /* switch window.type */
-
+                  state->valid = 0;
+                  Ad = Bd = Cd = 0;
+                  Fa = Fb = 0;
+                }
+              else
+                {
+                  XLALUpdateExpWindowState ( state, atoms, expRatio[n], i0, i1 );
+
+                  /* window-value of first atom i0, all other window-values are relative to this */
+                  REAL8 win_i0 = exp ( - 1.0 * ( t0_data + i0 * TAtom - win_t0 ) / win_tau );
+                  REAL8 win2_i0 = win_i0 * win_i0;
+                  Ad = state->sums.Ad * win2_i0;
+                  Bd = state->sums.Bd * win2_i0;
+                  Cd = state->sums.Cd * win2_i0;
+                  Fa = state->sums.Fa * win_i0;
+                  Fb = state->sums.Fb * win_i0;
+                }
+            }
 
           /* generic F-stat calculation from A,B,C, Fa, Fb */
           REAL4 Dd = XLALComputeAntennaPatternSqrtDeterminant ( Ad, Bd, Cd, 0 );
           REAL4 DdInv = 1.0f / Dd;
           REAL4 twoF = compute_fstat_from_fa_fb ( Fa, Fb, Ad, Bd, Cd, 0, DdInv );
           REAL4 F = 0.5 * twoF;
-          /* keep track of loudest F-stat value encountered over the m x n matrix */
-          if ( F > ret->maxF )
+          /* keep track of loudest F-stat value encountered over this row */
+          if ( F > maxF_m[m] )
             {
-              ret->maxF = F;
-              ret->t0_ML  = win_mn.t0;	/* start-time t0 corresponding to Fmax */
-              ret->tau_ML = win_mn.tau;	/* timescale tau corresponding to Fmax */
+              maxF_m[m] = F;
+              n_maxF_m[m] = n;
             }
 
           /* if requested: use 'regularized' F-stat: log ( 1/D * e^F ) = F + log(1/D) */
@@ -838,19 +1002,90 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
             F += log( DdInv );
 
           /* and store this in Fstat-matrix as element {m,n} */
-          gsl_matrix_set ( ret->F_mn, m, n, F );
+          gsl_matrix_set ( F_mn, m, n, F );
 
         } /* for n in n[tau] : n[tau+tauBand] */
 
     } /* for m in m[t0] : m[t0+t0Band] */
 
-  /* free internal mem */
-  XLALDestroyFstatAtomVector ( atoms );
+  return 0;
 
-  /* return end product: F-stat map */
-  return ret;
+} /* XLALComputeTransientFstatMapBlock() */
 
-} /* XLALComputeTransientFstatMap() */
+
+/**
+ * Update the exponential-window recursion state to hold the weighted sums over the atoms [i0, i1],
+ * where atom i is weighted by r^(i-i0) (Fa, Fb) and r^(2(i-i0)) (A, B, C).
+ *
+ * If the state holds the sums over [state->i0, state->i1] with i0 <= state->i0 and i1 <= state->i1,
+ * the atoms (i1, state->i1] are subtracted and the atoms [i0, state->i0) are prepended using the recursion
+ * S_i = atom_i + r S_{i+1}. Otherwise, or if this would touch more atoms than summing directly, the sums are
+ * recomputed from scratch.
+ */
+static void
+XLALUpdateExpWindowState ( ExpWindowState_t *state,		/**< [in/out] recursion state */
+                           const FstatAtomVector *atoms,	/**< [in] binned F-stat atoms */
+                           REAL8 r,				/**< [in] ratio e^(-TAtom/tau) of neighbouring window-values */
+                           UINT4 i0,				/**< [in] first atom in window */
+                           UINT4 i1				/**< [in] last atom in window */
+                           )
+{
+  REAL8 r2 = r * r;
+  AtomSums_t *s = &state->sums;
+
+  BOOLEAN recompute = !state->valid || ( i0 > state->i0 ) || ( i1 > state->i1 ) || ( state->i0 > i1 )
+    || ( ( state->i0 - i0 ) + ( state->i1 - i1 ) > ( i1 - i0 + 1 ) );
+
+  if ( recompute )
+    {
+      XLAL_INIT_MEM ( (*s) );
+      for ( UINT4 i = i1 + 1; i > i0; i -- )
+        {
+          const FstatAtom *thisAtom_i = &atoms->data[i-1];
+          s->Ad = thisAtom_i->a2_alpha + r2 * s->Ad;
+          s->Bd = thisAtom_i->b2_alpha + r2 * s->Bd;
+          s->Cd = thisAtom_i->ab_alpha + r2 * s->Cd;
+          s->Fa = thisAtom_i->Fa_alpha + r  * s->Fa;
+          s->Fb = thisAtom_i->Fb_alpha + r  * s->Fb;
+        }
+    }
+  else
+    {
+      /* drop atoms (i1, state->i1] beyond the new window end */
+      if ( i1 < state->i1 )
+        {
+          REAL8 w = pow ( r, i1 + 1 - state->i0 );
+          for ( UINT4 i = i1 + 1; i <= state->i1; i ++ )
+            {
+              const FstatAtom *thisAtom_i = &atoms->data[i];
+              REAL8 w2 = w * w;
+              s->Ad -= thisAtom_i->a2_alpha * w2;
+              s->Bd -= thisAtom_i->b2_alpha * w2;
+              s->Cd -= thisAtom_i->ab_alpha * w2;
+              s->Fa -= thisAtom_i->Fa_alpha * w;
+              s->Fb -= thisAtom_i->Fb_alpha * w;
+              w *= r;
+            }
+        }
+      /* prepend atoms [i0, state->i0) before the old window start */
+      for ( UINT4 i = state->i0; i > i0; i -- )
+        {
+          const FstatAtom *thisAtom_i = &atoms->data[i-1];
+          s->Ad = thisAtom_i->a2_alpha + r2 * s->Ad;
+          s->Bd = thisAtom_i->b2_alpha + r2 * s->Bd;
+          s->Cd = thisAtom_i->ab_alpha + r2 * s->Cd;
+          s->Fa = thisAtom_i->Fa_alpha + r  * s->Fa;
+          s->Fb = thisAtom_i->Fb_alpha + r  * s->Fb;
+        }
+    }
+
+  state->valid = 1;
+  state->i0 = i0;
+  state->i1 = i1;
+
+  return;
+
+} /* XLALUpdateExpWindowState() */
 
 
 
@@ -914,6 +1149,11 @@ XLALmergeMultiFstatAtomsBinned ( const MultiFstatAtomVector *multiAtoms, UINT4 d
 
   atomsOut->TAtom = deltaT;	/* output atoms-vector has new atoms baseline 'deltaT' */
 
+  /* set binned output atoms timestamps, including those of empty bins */
+  for ( UINT4 j = 0; j < NBinnedAtoms; j ++ ) {
+    atomsOut->data[j].timestamp = tMin + j * deltaT;
+  }
+
   /* Step through all input atoms, and sum them together into output bins */
   for ( X=0; X < numDet; X ++ )
     {
@@ -929,7 +1169,6 @@ XLALmergeMultiFstatAtomsBinned ( const MultiFstatAtomVector *multiAtoms, UINT4 d
 
           /* add atoms i to target atoms j */
           FstatAtom *destAtom = &atomsOut->data[j];
-          destAtom->timestamp = tMin + i * deltaT;	/* set binned output atoms timestamp */
 
           destAtom->a2_alpha += atom_X_i->a2_alpha;
           destAtom->b2_alpha += atom_X_i->b2_alpha;
@@ -250,6 +250,25 @@ typedef struct
 } intparams_t;
 
 
+/** number of nodes per integration unit of the Gauss-Legendre rule used in fixed-node metric integration */
+#define FIXEDNODE_NUM_HI 24
+/** number of nodes per integration unit of the lower-order Gauss-Legendre rule used to estimate the fixed-node integration error */
+#define FIXEDNODE_NUM_LO 16
+/** total number of nodes per integration unit at which the integrands are sampled */
+#define FIXEDNODE_NUM (FIXEDNODE_NUM_HI + FIXEDNODE_NUM_LO)
+
+/**
+ * Nodes and weights, on the unit interval, of a pair of Gauss-Legendre rules used in
+ * fixed-node metric integration. The nodes of both rules are stored together, with each
+ * rule assigning zero weight to the nodes of the other rule.
+ */
+typedef struct
+{
+  double x[FIXEDNODE_NUM];		/**< nodes of both rules */
+  double w_hi[FIXEDNODE_NUM];		/**< weights of the higher-order rule */
+  double w_lo[FIXEDNODE_NUM];		/**< weights of the lower-order rule */
+} FixedNodeRules_t;
+
 /*---------- Global variables ----------*/
 
 /* Some local constants. */
@@ -263,6 +282,7 @@ static gsl_matrix* XLALComputeFisherFromAtoms ( const FmetricAtoms_t *atoms, Pul
 
 static double CW_am1_am2_Phi_i_Phi_j ( double tt, void *params );
 static double CW_Phi_i ( double tt, void *params );
+static int CW_Phi_all ( double tt, intparams_t *par, double phi_all[] );
 
 static double XLALAverage_am1_am2_Phi_i_Phi_j ( const intparams_t *params, double *relerr_max );
 static double XLALCovariance_Phi_ij ( const MultiLALDetector *multiIFO, const MultiNoiseFloor *multiNoiseFloor, const LALSegList *segList,
@@ -270,6 +290,13 @@ static double XLALCovariance_Phi_ij ( const MultiLALDetector *multiIFO, const Mu
 
 static UINT4 findHighestGCSpinOrder ( const DopplerCoordinateSystem *coordSys );
 
+static void GaussLegendreRule ( UINT4 n, double x[], double w[] );
+static void InitFixedNodeRules ( FixedNodeRules_t *rules );
+static int SampleFixedNodes ( intparams_t *par, const FixedNodeRules_t *rules, UINT4 intN, UINT4 u, double *phi, double *am_a, double *am_b );
+static int XLALFixedNodeCovariance_Phi_ij ( gsl_matrix *g_ij, double *relerr_max, const MultiLALDetector *multiIFO, const MultiNoiseFloor *multiNoiseFloor,
+                                            const LALSegList *segList, const intparams_t *params );
+static int XLALFixedNodeAtomsForFmetric ( FmetricAtoms_t *atoms, const MultiLALDetector *multiIFO, const MultiNoiseFloor *multiNoiseFloor, const intparams_t *params );
+
 /*==================== FUNCTION DEFINITIONS ====================*/
 
 
@@ -488,6 +515,48 @@ CW_Phi_i ( double tt, void *params )
     return GSL_NAN;
   }
 
+  /* compute the phase derivatives wrt all coordinates in one go */
+  double phi_all[DOPPLERMETRIC_MAX_DIM];
+  if ( CW_Phi_all ( tt, par, phi_all ) != XLAL_SUCCESS ) {
+    return GSL_NAN;
+  }
+
+  /* now compute the requested (possibly linear combination of) phase derivative(s) */
+  REAL8 phase_deriv = 0.0;
+  for ( int coord = 0; coord < (int)par->coordSys->dim; ++coord ) {
+
+    /* get the coefficient used to multiply phase derivative term */
+    REAL8 coeff = 0.0;
+    if ( par->coordTransf != NULL ) {
+      coeff = gsl_matrix_get( par->coordTransf, par->coord, coord );
+    } else if ( par->coord == coord ) {
+      coeff = 1.0;
+    }
+    if ( coeff == 0.0 ) {
+      continue;
+    }
+    coeff *= GET_COORD_SCALE(par->coordSys, coord) / GET_COORD_SCALE(par->coordSys, par->coord);
+
+    phase_deriv += coeff * phi_all[coord];
+
+  }
+
+  return phase_deriv;
+
+} /* CW_Phi_i() */
+
+
+/**
+ * Compute the (unscaled) partial derivatives of the continuous-wave (CW) phase
+ * with respect to all Doppler coordinates of par->coordSys at once, so that the
+ * detector position and velocity need only be computed once per time 'tt'.
+ *
+ * Time is in 'natural units' of Tspan, as for CW_Phi_i(). On failure,
+ * par->errnum is set and an XLAL error code is returned.
+ */
+static int
+CW_Phi_all ( double tt, intparams_t *par, double phi_all[] )
+{
   vect3D_t nn_equ, nn_ecl;	/* skypos unit vector */
   vect3D_t nDeriv_i;	/* derivative of sky-pos vector wrt i */
 
@@ -521,7 +590,7 @@ CW_Phi_i ( double tt, void *params )
   if ( XLALDetectorPosVel ( &spin_posvel, &orbit_posvel, &ttGPS, par->site, par->edat, par->detMotionType ) != XLAL_SUCCESS ) {
     par->errnum = xlalErrno;
     XLALPrintError ( "%s: Call to XLALDetectorPosVel() failed!\n", __func__);
-    return GSL_NAN;
+    return par->errnum;
   }
 
   /* XLALDetectorPosVel() returns detector positions and velocities from XLALBarycenter(),
@@ -600,22 +669,9 @@ CW_Phi_i ( double tt, void *params )
   REAL8 sin2Psi = sin ( 2.0 * orb_phase );
   REAL8 cos2Psi = cos ( 2.0 * orb_phase );
 
-  /* now compute the requested (possibly linear combination of) phase derivative(s) */
-  REAL8 phase_deriv = 0.0;
+  /* now compute the phase derivatives wrt all coordinates */
   for ( int coord = 0; coord < (int)par->coordSys->dim; ++coord ) {
 
-    /* get the coefficient used to multiply phase derivative term */
-    REAL8 coeff = 0.0;
-    if ( par->coordTransf != NULL ) {
-      coeff = gsl_matrix_get( par->coordTransf, par->coord, coord );
-    } else if ( par->coord == coord ) {
-      coeff = 1.0;
-    }
-    if ( coeff == 0.0 ) {
-      continue;
-    }
-    coeff *= GET_COORD_SCALE(par->coordSys, coord) / GET_COORD_SCALE(par->coordSys, par->coord);
-
     /* compute the phase derivative term */
     REAL8 ret = 0.0;
     const DopplerCoordinateID deriv = GET_COORD_ID(par->coordSys, coord);
@@ -746,18 +802,18 @@ CW_Phi_i ( double tt, void *params )
     default:
       par->errnum = XLAL_EINVAL;
       XLALPrintError("%s: Unknown phase-derivative type '%d'\n", __func__, deriv );
-      return GSL_NAN;
+      return par->errnum;
       break;
 
     } /* switch deriv */
 
-    phase_deriv += coeff * ret;
+    phi_all[coord] = ret;
 
   }
 
-  return phase_deriv;
+  return XLAL_SUCCESS;
 
-} /* CW_Phi_i() */
+} /* CW_Phi_all() */
 
 
 /**
@@ -1190,6 +1246,451 @@ XLALCovariance_Phi_ij ( const MultiLALDetector *multiIFO,		//!< [in] detectors t
 } /* XLALCovariance_Phi_ij() */
 
 
+/**
+ * Compute the nodes 'x' and weights 'w' of an 'n'-point Gauss-Legendre quadrature rule on the unit interval [0, 1].
+ * The roots of the Legendre polynomial \f$P_n\f$ are found by Newton iteration, using the recurrence relation for \f$P_n\f$.
+ */
+static void
+GaussLegendreRule ( UINT4 n, double x[], double w[] )
+{
+  for ( UINT4 i = 0; i < ( n + 1 ) / 2; ++i ) {
+
+    /* initial guess for the i'th root of P_n */
+    double z = cos( LAL_PI * ( i + 0.75 ) / ( n + 0.5 ) );
+    double dp = 0;
+    for ( UINT4 iter = 0; iter < 100; ++iter ) {
+
+      /* evaluate P_n(z) and P_{n-1}(z) by recurrence */
+      double p0 = 1.0, p1 = 0.0;
+      for ( UINT4 k = 1; k <= n; ++k ) {
+        const double p2 = p1;
+        p1 = p0;
+        p0 = ( ( 2.0 * k - 1.0 ) * z * p1 - ( k - 1.0 ) * p2 ) / k;
+      }
+
+      /* derivative of P_n(z), and Newton step */
+      dp = n * ( z * p0 - p1 ) / ( z * z - 1.0 );
+      const double dz = p0 / dp;
+      z -= dz;
+      if ( fabs( dz ) < 1e-15 ) {
+        break;
+      }
+
+    }
+
+    /* map nodes and weights from [-1, 1] to [0, 1] */
+    x[i] = 0.5 * ( 1.0 - z );
+    x[n - 1 - i] = 0.5 * ( 1.0 + z );
+    w[i] = w[n - 1 - i] = 1.0 / ( ( 1.0 - z * z ) * dp * dp );
+
+  }
+} /* GaussLegendreRule() */
+
+
+/**
+ * Initialise the pair of Gauss-Legendre rules used in fixed-node metric integration.
+ */
+static void
+InitFixedNodeRules ( FixedNodeRules_t *rules )
+{
+  XLAL_INIT_MEM( (*rules) );
+  GaussLegendreRule( FIXEDNODE_NUM_HI, &rules->x[0], &rules->w_hi[0] );
+  GaussLegendreRule( FIXEDNODE_NUM_LO, &rules->x[FIXEDNODE_NUM_HI], &rules->w_lo[FIXEDNODE_NUM_HI] );
+} /* InitFixedNodeRules() */
+
+
+/**
+ * Sample the scaled phase derivatives wrt all Doppler coordinates, and optionally the antenna-pattern
+ * functions a(t) and b(t), at the nodes of the fixed-node quadrature rules within integration unit 'u'
+ * of 'intN' units covering [0, 1]. The phase derivatives at node 'i' are stored in phi[i*dim + coord].
+ *
+ * NOTE: this function may be called from within parallel regions, and therefore does not raise XLAL errors;
+ * instead, it returns the XLAL error code of any failure.
+ */
+static int
+SampleFixedNodes ( intparams_t *par,			/**< [in] integration parameters */
+                   const FixedNodeRules_t *rules,	/**< [in] quadrature rules */
+                   UINT4 intN,				/**< [in] number of integration units covering [0, 1] */
+                   UINT4 u,				/**< [in] integration unit to sample */
+                   double *phi,				/**< [out] scaled phase derivatives at nodes */
+                   double *am_a,			/**< [out] optional: antenna-pattern function a(t) at nodes */
+                   double *am_b				/**< [out] optional: antenna-pattern function b(t) at nodes */
+                   )
+{
+  const UINT4 dim = par->coordSys->dim;
+
+  SkyPosition skypos;
+  skypos.system = COORDINATESYSTEM_EQUATORIAL;
+  skypos.longitude = par->dopplerPoint->Alpha;
+  skypos.latitude  = par->dopplerPoint->Delta;
+
+  for ( UINT4 i = 0; i < FIXEDNODE_NUM; ++i ) {
+    const double tt = ( u + rules->x[i] ) / intN;
+
+    /* phase derivatives wrt all coordinates, from a single computation of the detector motion */
+    double *phi_i = &phi[i * dim];
+    if ( CW_Phi_all( tt, par, phi_i ) != XLAL_SUCCESS ) {
+      return par->errnum;
+    }
+    for ( int coord = 0; coord < (int)dim; ++coord ) {
+      phi_i[coord] *= GET_COORD_SCALE( par->coordSys, coord );
+    }
+
+    /* antenna-pattern functions, if needed */
+    if ( am_a != NULL && am_b != NULL ) {
+      LIGOTimeGPS ttGPS;
+      XLALGPSSetREAL8( &ttGPS, par->startTime + tt * par->Tspan );
+      int errnum;
+      XLAL_TRY( XLALComputeAntennaPatternCoeffs( &am_a[i], &am_b[i], &skypos, &ttGPS, par->site, par->edat ), errnum );
+      if ( errnum ) {
+        par->errnum = errnum;
+        return errnum;
+      }
+    }
+
+  }
+
+  return XLAL_SUCCESS;
+
+} /* SampleFixedNodes() */
+
+
+/** index of a single fixed-node integration unit within a list of segments and detectors */
+typedef struct {
+  UINT4 k;	/* segment index */
+  UINT4 X;	/* detector index */
+  UINT4 u;	/* integration unit within segment */
+  UINT4 intN;	/* number of integration units of segment */
+} FixedNodeUnit_t;
+
+
+/**
+ * Compute all pure phase-deriv covariances \f$[\phi_i, \phi_j] = \langle phi_i phi_j\rangle - \langle phi_i\rangle\langle phi_j\rangle\f$,
+ * i.e. the full phase metric averaged over segments, using fixed-node Gauss-Legendre quadrature.
+ *
+ * In contrast to XLALCovariance_Phi_ij(), which adaptively integrates a single metric element, the detector motion
+ * and phase derivatives are sampled only once per quadrature node, and all metric elements are then computed together
+ * from the cached samples. Sampling is parallelised (using OpenMP) over segments, detectors, and integration units.
+ * The maximal relative error is estimated from the difference between a higher- and lower-order quadrature rule,
+ * normalised by the diagonal metric elements.
+ *
+ * NOTE: for passing unit noise-weights, set MultiNoiseFloor->length=0 (but multiNoiseFloor==NULL is invalid)
+ */
+static int
+XLALFixedNodeCovariance_Phi_ij ( gsl_matrix *g_ij,				//!< [out] phase metric
+                                 double *relerr_max,				//!< [out] estimate of maximal relative error
+                                 const MultiLALDetector *multiIFO,		//!< [in] detectors to use
+                                 const MultiNoiseFloor *multiNoiseFloor,	//!< [in] corresponding noise floors for weights
+                                 const LALSegList *segList,			//!< [in] segment list
+                                 const intparams_t *params			//!< [in] integration parameters
+                                 )
+{
+  XLAL_CHECK ( g_ij != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( multiIFO != NULL, XLAL_EINVAL );
+  const UINT4 numDet = multiIFO->length;
+  XLAL_CHECK ( numDet > 0, XLAL_EINVAL );
+
+  // either no noise-weights given (multiNoiseFloor->length=0) or same number of detectors
+  XLAL_CHECK ( multiNoiseFloor != NULL, XLAL_EINVAL );
+  BOOLEAN haveNoiseWeights = (multiNoiseFloor->length > 0);
+  XLAL_CHECK ( !haveNoiseWeights || (multiNoiseFloor->length == numDet), XLAL_EINVAL );
+
+  XLAL_CHECK ( segList != NULL, XLAL_EINVAL );
+  const UINT4 Nseg = segList->length;
+  XLAL_CHECK ( Nseg > 0, XLAL_EINVAL );
+
+  const UINT4 dim = params->coordSys->dim;
+  XLAL_CHECK ( g_ij->size1 == dim && g_ij->size2 == dim, XLAL_EINVAL );
+
+  /* sanity-check: don't allow any AM-coeffs being turned on here! */
+  XLAL_CHECK ( params->amcomp1 == AMCOMP_NONE && params->amcomp2 == AMCOMP_NONE, XLAL_EINVAL, "Illegal input, amcomp[12] must be set to AMCOMP_NONE!" );
+
+  /* store normalised detector weights */
+  REAL8 total_weight = 0.0, weights[numDet];
+  for (UINT4 X = 0; X < numDet; X ++) {
+    weights[X] = haveNoiseWeights ? multiNoiseFloor->sqrtSn[X] : 1.0;
+    total_weight += weights[X];
+  }
+  XLAL_CHECK (total_weight > 0, XLAL_EDOM, "Detectors noise-floors given but all zero!" );
+  for (UINT4 X = 0; X < numDet; X ++) {
+    weights[X] /= total_weight;
+  }
+
+  FixedNodeRules_t rules;
+  InitFixedNodeRules( &rules );
+
+  /* ---------- list all integration units over segments and detectors ---------- */
+  UINT4 numUnits = 0;
+  UINT4 intN[Nseg];
+  for ( UINT4 k = 0; k < Nseg; ++k ) {
+    const REAL8 Tspan = XLALGPSDiff( &(segList->segs[k].end), &(segList->segs[k].start) );
+    intN[k] = MYMAX( 1, (UINT4) ceil ( Tspan / params->intT ) );
+    numUnits += numDet * intN[k];
+  }
+  FixedNodeUnit_t *units = XLALCalloc( numUnits, sizeof(*units) );
+  XLAL_CHECK ( units != NULL, XLAL_ENOMEM );
+  {
+    UINT4 indx = 0;
+    for ( UINT4 k = 0; k < Nseg; ++k ) {
+      for ( UINT4 X = 0; X < numDet; ++X ) {
+        for ( UINT4 u = 0; u < intN[k]; ++u ) {
+          units[indx].k = k;
+          units[indx].X = X;
+          units[indx].u = u;
+          units[indx].intN = intN[k];
+          ++indx;
+        }
+      }
+    }
+  }
+
+  /* ---------- sample phase derivatives at all nodes ---------- */
+  const size_t unitSize = FIXEDNODE_NUM * dim;
+  double *phi = XLALMalloc( numUnits * unitSize * sizeof(*phi) );
+  XLAL_CHECK ( phi != NULL, XLAL_ENOMEM );
+  int errnum = XLAL_SUCCESS;
+#pragma omp parallel for schedule(dynamic)
+  for ( UINT4 indx = 0; indx < numUnits; ++indx )
+    {
+      const FixedNodeUnit_t *unit = &units[indx];
+      intparams_t par = (*params);   /* struct-copy, as the 'site' and time fields have to be changeable */
+      par.startTime = XLALGPSGetREAL8 ( &(segList->segs[unit->k].start) );
+      par.Tspan     = XLALGPSDiff( &(segList->segs[unit->k].end), &(segList->segs[unit->k].start) );
+      par.site      = &multiIFO->sites[unit->X];
+      const int errnum_indx = SampleFixedNodes ( &par, &rules, unit->intN, unit->u, &phi[indx * unitSize], NULL, NULL );
+      if ( errnum_indx != XLAL_SUCCESS ) {
+#pragma omp critical (XLALFixedNodeCovariance_Phi_ij)
+        errnum = errnum_indx;
+      }
+    } /* for indx < numUnits */
+  if ( errnum != XLAL_SUCCESS ) {
+    XLALFree( phi );
+    XLALFree( units );
+    XLAL_ERROR ( errnum, "Sampling of phase derivatives at fixed nodes failed" );
+  }
+
+  /* ---------- compute covariances from the samples, for both quadrature rules ---------- */
+  double cov_hi[dim][dim], cov_lo[dim][dim];
+  XLAL_INIT_MEM( cov_hi );
+  XLAL_INIT_MEM( cov_lo );
+  for ( UINT4 indx_k = 0, k = 0; k < Nseg; ++k ) {
+    const UINT4 numUnits_k = numDet * intN[k];
+    const double dT = 1.0 / intN[k];
+
+    /* noise-weighted averages <phi_i> over segment k; the samples are centred on these
+       before forming products, to avoid cancellation in <phi_i phi_j> - <phi_i><phi_j> */
+    double av_hi[dim], av_lo[dim];
+    XLAL_INIT_MEM( av_hi );
+    XLAL_INIT_MEM( av_lo );
+    for ( UINT4 indx = indx_k; indx < indx_k + numUnits_k; ++indx ) {
+      const double weight = weights[units[indx].X] * dT;
+      for ( UINT4 i = 0; i < FIXEDNODE_NUM; ++i ) {
+        const double *phi_i = &phi[indx * unitSize + i * dim];
+        const double w_hi = weight * rules.w_hi[i], w_lo = weight * rules.w_lo[i];
+        for ( UINT4 c = 0; c < dim; ++c ) {
+          av_hi[c] += w_hi * phi_i[c];
+          av_lo[c] += w_lo * phi_i[c];
+        }
+      }
+    }
+
+    /* accumulate <(phi_i - <phi_i>) (phi_j - <phi_j>)> */
+    for ( UINT4 indx = indx_k; indx < indx_k + numUnits_k; ++indx ) {
+      const double weight = weights[units[indx].X] * dT / Nseg;
+      for ( UINT4 i = 0; i < FIXEDNODE_NUM; ++i ) {
+        const double *phi_i = &phi[indx * unitSize + i * dim];
+        const double w_hi = weight * rules.w_hi[i], w_lo = weight * rules.w_lo[i];
+        for ( UINT4 c = 0; c < dim; ++c ) {
+          const double dphi_hi_c = phi_i[c] - av_hi[c], dphi_lo_c = phi_i[c] - av_lo[c];
+          for ( UINT4 d = 0; d <= c; ++d ) {
+            cov_hi[c][d] += w_hi * dphi_hi_c * ( phi_i[d] - av_hi[d] );
+            cov_lo[c][d] += w_lo * dphi_lo_c * ( phi_i[d] - av_lo[d] );
+          }
+        }
+      }
+    }
+
+    indx_k += numUnits_k;
+
+  } // for k < Nseg
+
+  /* ---------- return metric and error estimate ---------- */
+  double relerr = 0;
+  for ( UINT4 c = 0; c < dim; ++c ) {
+    for ( UINT4 d = 0; d <= c; ++d ) {
+      gsl_matrix_set( g_ij, c, d, cov_hi[c][d] );
+      gsl_matrix_set( g_ij, d, c, cov_hi[c][d] );
+      const double norm = sqrt( fabs( cov_hi[c][c] * cov_hi[d][d] ) );
+      relerr = MYMAX( relerr, RELERR( fabs( cov_hi[c][d] - cov_lo[c][d] ), norm ) );
+    }
+  }
+  if ( relerr_max ) {
+    (*relerr_max) = relerr;
+  }
+
+  /* ----- cleanup ----- */
+  XLALFree( phi );
+  XLALFree( units );
+
+  return XLAL_SUCCESS;
+
+} /* XLALFixedNodeCovariance_Phi_ij() */
+
+
+/**
+ * Compute all F-metric 'atoms' for a single segment using fixed-node Gauss-Legendre quadrature.
+ *
+ * The antenna-pattern functions and the phase derivatives wrt all coordinates are sampled once per quadrature node,
+ * in parallel (using OpenMP) over detectors and integration units, and all atoms are then accumulated in one pass
+ * over the cached samples. The maximal relative error is estimated as in XLALFixedNodeCovariance_Phi_ij().
+ *
+ * NOTE: for passing unit noise-weights, set MultiNoiseFloor->length=0 (but multiNoiseFloor==NULL is invalid)
+ */
+static int
+XLALFixedNodeAtomsForFmetric ( FmetricAtoms_t *atoms,				//!< [out] F-metric atoms, allocated by caller
+                               const MultiLALDetector *multiIFO,		//!< [in] detectors to use
+                               const MultiNoiseFloor *multiNoiseFloor,	//!< [in] corresponding noise floors for weights
+                               const intparams_t *params			//!< [in] integration parameters
+                               )
+{
+  XLAL_CHECK ( atoms != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( multiIFO != NULL, XLAL_EINVAL );
+  const UINT4 numDet = multiIFO->length;
+  XLAL_CHECK ( numDet > 0, XLAL_EINVAL );
+  XLAL_CHECK ( multiNoiseFloor != NULL, XLAL_EINVAL );
+  BOOLEAN haveNoiseWeights = (multiNoiseFloor->length > 0);
+  XLAL_CHECK ( !haveNoiseWeights || (multiNoiseFloor->length == numDet), XLAL_EINVAL );
+
+  const UINT4 dim = params->coordSys->dim;
+
+  /* store normalised detector weights */
+  REAL8 total_weight = 0.0, weights[numDet];
+  for (UINT4 X = 0; X < numDet; X ++) {
+    weights[X] = haveNoiseWeights ? multiNoiseFloor->sqrtSn[X] : 1.0;
+    total_weight += weights[X];
+  }
+  XLAL_CHECK (total_weight > 0, XLAL_EDOM, "Detectors noise-floors given but all zero!" );
+  for (UINT4 X = 0; X < numDet; X ++) {
+    weights[X] /= total_weight;
+  }
+
+  FixedNodeRules_t rules;
+  InitFixedNodeRules( &rules );
+
+  /* ---------- sample antenna-pattern functions and phase derivatives at all nodes ---------- */
+  const UINT4 intN = MYMAX( 1, (UINT4) ceil ( params->Tspan / params->intT ) );
+  const UINT4 numUnits = numDet * intN;
+  const size_t unitSize = FIXEDNODE_NUM * dim;
+  double *phi = XLALMalloc( numUnits * unitSize * sizeof(*phi) );
+  double *am_a = XLALMalloc( numUnits * FIXEDNODE_NUM * sizeof(*am_a) );
+  double *am_b = XLALMalloc( numUnits * FIXEDNODE_NUM * sizeof(*am_b) );
+  if ( phi == NULL || am_a == NULL || am_b == NULL ) {
+    XLALFree( phi );
+    XLALFree( am_a );
+    XLALFree( am_b );
+    XLAL_ERROR ( XLAL_ENOMEM );
+  }
+  int errnum = XLAL_SUCCESS;
+#pragma omp parallel for schedule(dynamic)
+  for ( UINT4 indx = 0; indx < numUnits; ++indx )
+    {
+      intparams_t par = (*params);   /* struct-copy, as the 'site' field has to be changeable */
+      par.site = &multiIFO->sites[indx / intN];
+      const int errnum_indx = SampleFixedNodes ( &par, &rules, intN, indx % intN, &phi[indx * unitSize], &am_a[indx * FIXEDNODE_NUM], &am_b[indx * FIXEDNODE_NUM] );
+      if ( errnum_indx != XLAL_SUCCESS ) {
+#pragma omp critical (XLALFixedNodeAtomsForFmetric)
+        errnum = errnum_indx;
+      }
+    } /* for indx < numUnits */
+  if ( errnum != XLAL_SUCCESS ) {
+    XLALFree( phi );
+    XLALFree( am_a );
+    XLALFree( am_b );
+    XLAL_ERROR ( errnum, "Sampling of antenna-pattern functions and phase derivatives at fixed nodes failed" );
+  }
+
+  /* ---------- accumulate all atoms, for both quadrature rules ---------- */
+  /* index 0: higher-order rule, index 1: lower-order rule */
+  double a_a[2] = {0, 0}, a_b[2] = {0, 0}, b_b[2] = {0, 0};
+  double a_a_i[2][dim], a_b_i[2][dim], b_b_i[2][dim];
+  double a_a_i_j[2][dim][dim], a_b_i_j[2][dim][dim], b_b_i_j[2][dim][dim];
+  XLAL_INIT_MEM( a_a_i );
+  XLAL_INIT_MEM( a_b_i );
+  XLAL_INIT_MEM( b_b_i );
+  XLAL_INIT_MEM( a_a_i_j );
+  XLAL_INIT_MEM( a_b_i_j );
+  XLAL_INIT_MEM( b_b_i_j );
+  for ( UINT4 indx = 0; indx < numUnits; ++indx ) {
+    const double weight = weights[indx / intN] / intN;
+    for ( UINT4 i = 0; i < FIXEDNODE_NUM; ++i ) {
+      const double *phi_i = &phi[indx * unitSize + i * dim];
+      const double a = am_a[indx * FIXEDNODE_NUM + i], b = am_b[indx * FIXEDNODE_NUM + i];
+      const double w[2] = { weight * rules.w_hi[i], weight * rules.w_lo[i] };
+      for ( UINT4 r = 0; r < 2; ++r ) {
+        if ( w[r] == 0 ) {
+          continue;
+        }
+        const double waa = w[r] * a * a, wab = w[r] * a * b, wbb = w[r] * b * b;
+        a_a[r] += waa;
+        a_b[r] += wab;
+        b_b[r] += wbb;
+        for ( UINT4 c = 0; c < dim; ++c ) {
+          a_a_i[r][c] += waa * phi_i[c];
+          a_b_i[r][c] += wab * phi_i[c];
+          b_b_i[r][c] += wbb * phi_i[c];
+          for ( UINT4 d = 0; d <= c; ++d ) {
+            const double phi_cd = phi_i[c] * phi_i[d];
+            a_a_i_j[r][c][d] += waa * phi_cd;
+            a_b_i_j[r][c][d] += wab * phi_cd;
+            b_b_i_j[r][c][d] += wbb * phi_cd;
+          }
+        }
+      }
+    }
+  }
+
+  /* ---------- return atoms and error estimate ---------- */
+  /* relative errors are normalised using Cauchy-Schwarz bounds, e.g. |<a b phi_i>| <= sqrt( <a^2> <b^2 phi_i^2> ) */
+#define FIXEDNODE_RELERR(hi, lo, norm2) RELERR( fabs( (hi) - (lo) ), sqrt( fabs( norm2 ) ) )
+  double relerr = 0;
+  atoms->a_a = a_a[0];
+  atoms->a_b = a_b[0];
+  atoms->b_b = b_b[0];
+  relerr = MYMAX( relerr, FIXEDNODE_RELERR( a_a[0], a_a[1], a_a[0] * a_a[0] ) );
+  relerr = MYMAX( relerr, FIXEDNODE_RELERR( a_b[0], a_b[1], a_a[0] * b_b[0] ) );
+  relerr = MYMAX( relerr, FIXEDNODE_RELERR( b_b[0], b_b[1], b_b[0] * b_b[0] ) );
+  for ( UINT4 c = 0; c < dim; ++c ) {
+    gsl_vector_set( atoms->a_a_i, c, a_a_i[0][c] );
+    gsl_vector_set( atoms->a_b_i, c, a_b_i[0][c] );
+    gsl_vector_set( atoms->b_b_i, c, b_b_i[0][c] );
+    relerr = MYMAX( relerr, FIXEDNODE_RELERR( a_a_i[0][c], a_a_i[1][c], a_a[0] * a_a_i_j[0][c][c] ) );
+    relerr = MYMAX( relerr, FIXEDNODE_RELERR( a_b_i[0][c], a_b_i[1][c], a_a[0] * b_b_i_j[0][c][c] ) );
+    relerr = MYMAX( relerr, FIXEDNODE_RELERR( b_b_i[0][c], b_b_i[1][c], b_b[0] * b_b_i_j[0][c][c] ) );
+    for ( UINT4 d = 0; d <= c; ++d ) {
+      gsl_matrix_set( atoms->a_a_i_j, c, d, a_a_i_j[0][c][d] );
+      gsl_matrix_set( atoms->a_a_i_j, d, c, a_a_i_j[0][c][d] );
+      gsl_matrix_set( atoms->a_b_i_j, c, d, a_b_i_j[0][c][d] );
+      gsl_matrix_set( atoms->a_b_i_j, d, c, a_b_i_j[0][c][d] );
+      gsl_matrix_set( atoms->b_b_i_j, c, d, b_b_i_j[0][c][d] );
+      gsl_matrix_set( atoms->b_b_i_j, d, c, b_b_i_j[0][c][d] );
+      relerr = MYMAX( relerr, FIXEDNODE_RELERR( a_a_i_j[0][c][d], a_a_i_j[1][c][d], a_a_i_j[0][c][c] * a_a_i_j[0][d][d] ) );
+      relerr = MYMAX( relerr, FIXEDNODE_RELERR( a_b_i_j[0][c][d], a_b_i_j[1][c][d], a_a_i_j[0][c][c] * b_b_i_j[0][d][d] ) );
+      relerr = MYMAX( relerr, FIXEDNODE_RELERR( b_b_i_j[0][c][d], b_b_i_j[1][c][d], b_b_i_j[0][c][c] * b_b_i_j[0][d][d] ) );
+    }
+  }
+#undef FIXEDNODE_RELERR
+  atoms->maxrelerr = relerr;
+
+  /* ----- cleanup ----- */
+  XLALFree( phi );
+  XLALFree( am_a );
+  XLALFree( am_b );
+
+  return XLAL_SUCCESS;
+
+} /* XLALFixedNodeAtomsForFmetric() */
+
+
 /**
  * Calculate an approximate "phase-metric" with the specified parameters.
  *
@@ -1211,6 +1712,7 @@ XLALComputeDopplerPhaseMetric ( const DopplerMetricParams *metricParams,  	/**<
   XLAL_CHECK_NULL ( metricParams != NULL, XLAL_EINVAL );
   XLAL_CHECK_NULL ( edat != NULL, XLAL_EINVAL );
   XLAL_CHECK_NULL ( XLALSegListIsInitialized ( &(metricParams->segmentList) ), XLAL_EINVAL, "Passed un-initialzied segment list 'metricParams->segmentList'\n");
+  XLAL_CHECK_NULL ( metricParams->integration < DOPPLERMETRIC_INTEGRATION_LAST, XLAL_EINVAL, "Invalid metric integration method %d\n", metricParams->integration );
   UINT4 Nseg = metricParams->segmentList.length;
 
   UINT4 dim = metricParams->coordSys.dim;
@@ -1279,113 +1781,129 @@ XLALComputeDopplerPhaseMetric ( const DopplerMetricParams *metricParams,  	/**<
   metric->maxrelerr = 0;
   double err = 0;
 
-  /* ========== use numerically-robust method to compute metric ========== */
+  if ( metricParams->integration == DOPPLERMETRIC_INTEGRATION_FIXEDNODE ) {
 
-  /* allocate memory for coordinate transform */
-  gsl_matrix *transform = gsl_matrix_alloc(dim, dim);
-  XLAL_CHECK_NULL( transform != NULL, XLAL_ENOMEM );
-  gsl_matrix_set_identity( transform );
-  intparams.coordTransf = transform;
-
-  for ( size_t n = 1; n <= dim; ++n ) {
+    /* ========== use fixed-node quadrature to compute all metric elements in one pass ========== */
 
-    /* NOTE: this level of accuracy is only achievable *without* AM-coefficients involved
-     * which are computed in REAL4 precision. For the current function this is OK, as this
-     * function is only supposed to compute *pure* phase-derivate covariances.
-     */
-    intparams.epsrel = 1e-6;
-    /* we need an abs-cutoff as well, as epsrel can be too restrictive for small integrals */
-    intparams.epsabs = 1e-3;
-    /* NOTE: this numerical integration still runs into problems when integrating over
-     * long durations (~O(23d)), as the integrands are oscillatory functions on order of ~1d
-     * and convergence degrades.
-     * As a solution, we split the integral into 'intN' units of ~1 day duration, and compute
-     * the final integral as a sum over partial integrals.
-     * It is VERY important to ensure that 'intT' is not exactly 1 day, since then an integrand
-     * with period ~1 day may integrate to zero, which is both slower and MUCH more difficult
-     * for the numerical integration functions (since the integrand them becomes small with
-     * respect to any integration errors).
-     */
+    /* split the integral into 'intN' units of ~1 day duration, over which the (oscillatory) integrands
+       are smooth enough to be integrated accurately using a fixed number of nodes */
     intparams.intT = 0.9 * LAL_DAYSID_SI;
+    XLAL_CHECK_NULL( XLALFixedNodeCovariance_Phi_ij( metric->g_ij, &metric->maxrelerr, &metricParams->multiIFO, &metricParams->multiNoiseFloor, &metricParams->segmentList,
+                                                     &intparams ) == XLAL_SUCCESS, XLAL_EFUNC, "%s: fixed-node integration of phase metric failed", __func__ );
 
-    /* allocate memory for Cholesky decomposition */
-    gsl_matrix *cholesky = gsl_matrix_alloc(n, n);
-    XLAL_CHECK_NULL( cholesky != NULL, XLAL_ENOMEM );
+  } else {
 
-    /* create views of n-by-n submatrices of metric and coordinate transform */
-    gsl_matrix_view g_ij_n = gsl_matrix_submatrix( metric->g_ij, 0, 0, n, n );
-    gsl_matrix_view transform_n = gsl_matrix_submatrix( transform, 0, 0, n, n );
-
-    /* try this loop a certain number of times */
-    const size_t max_tries = 64;
-    size_t tries = 0;
-    while ( ++tries <= max_tries ) {
-
-      /* ----- compute last row/column of n-by-n submatrix of metric ----- */
-      for ( size_t i = 0; i < n; ++i ) {
-        const size_t j = n - 1;
-
-        /* g_ij = [Phi_i, Phi_j] */
-        intparams.coord1 = i;
-        intparams.coord2 = j;
-        REAL8 gg = XLALCovariance_Phi_ij ( &metricParams->multiIFO, &metricParams->multiNoiseFloor, &metricParams->segmentList,
-                                           &intparams, &err );
-        XLAL_CHECK_NULL( !gsl_isnan(gg), XLAL_EFUNC, "%s: integration of phase metric g_{i=%zu,j=%zu} failed (n=%zu, tries=%zu)", __func__, i, j, n, tries );
-        gsl_matrix_set (&g_ij_n.matrix, i, j, gg);
-        gsl_matrix_set (&g_ij_n.matrix, j, i, gg);
-        metric->maxrelerr = MYMAX ( metric->maxrelerr, err );
-
-      } /* for i < n */
-
-      /* ----- compute L D L^T Cholesky decomposition of metric ----- */
-      XLAL_CHECK_NULL( XLALCholeskyLDLTDecompMetric( &cholesky, &g_ij_n.matrix ) == XLAL_SUCCESS, XLAL_EFUNC );
-      gsl_vector_view D = gsl_matrix_diagonal( cholesky );
-      if ( ( tries > 1 ) && ( lalDebugLevel & LALINFOBIT ) ) {
-        /* diagnostic / debug output */
-        fprintf(stdout, "%s: n=%zu, try=%zu, Cholesky diagonal =", __func__, n, tries);
-        XLALfprintfGSLvector(stdout, "%0.2e", &D.vector);
-      }
+    /* ========== use numerically-robust method to compute metric ========== */
 
-      /* ----- check that all diagonal elements D are positive after at least 1 try; if so, exit try loop */
-      if ( ( tries > 1 ) && ( gsl_vector_min( &D.vector ) > 0.0 ) ) {
-        break;
-      }
+    /* allocate memory for coordinate transform */
+    gsl_matrix *transform = gsl_matrix_alloc(dim, dim);
+    XLAL_CHECK_NULL( transform != NULL, XLAL_ENOMEM );
+    gsl_matrix_set_identity( transform );
+    intparams.coordTransf = transform;
 
-      /* zero out all but last row of L, since we do not want to coordinates before 'n' */
-      if ( n > 1 ) {
-        gsl_matrix_view cholesky_nm1 = gsl_matrix_submatrix( cholesky, 0, 0, n - 1, n );
-        gsl_matrix_set_identity( &cholesky_nm1.matrix );
-      }
+    for ( size_t n = 1; n <= dim; ++n ) {
+
+      /* NOTE: this level of accuracy is only achievable *without* AM-coefficients involved
+       * which are computed in REAL4 precision. For the current function this is OK, as this
+       * function is only supposed to compute *pure* phase-derivate covariances.
+       */
+      intparams.epsrel = 1e-6;
+      /* we need an abs-cutoff as well, as epsrel can be too restrictive for small integrals */
+      intparams.epsabs = 1e-3;
+      /* NOTE: this numerical integration still runs into problems when integrating over
+       * long durations (~O(23d)), as the integrands are oscillatory functions on order of ~1d
+       * and convergence degrades.
+       * As a solution, we split the integral into 'intN' units of ~1 day duration, and compute
+       * the final integral as a sum over partial integrals.
+       * It is VERY important to ensure that 'intT' is not exactly 1 day, since then an integrand
+       * with period ~1 day may integrate to zero, which is both slower and MUCH more difficult
+       * for the numerical integration functions (since the integrand them becomes small with
+       * respect to any integration errors).
+       */
+      intparams.intT = 0.9 * LAL_DAYSID_SI;
+
+      /* allocate memory for Cholesky decomposition */
+      gsl_matrix *cholesky = gsl_matrix_alloc(n, n);
+      XLAL_CHECK_NULL( cholesky != NULL, XLAL_ENOMEM );
+
+      /* create views of n-by-n submatrices of metric and coordinate transform */
+      gsl_matrix_view g_ij_n = gsl_matrix_submatrix( metric->g_ij, 0, 0, n, n );
+      gsl_matrix_view transform_n = gsl_matrix_submatrix( transform, 0, 0, n, n );
+
+      /* try this loop a certain number of times */
+      const size_t max_tries = 64;
+      size_t tries = 0;
+      while ( ++tries <= max_tries ) {
+
+        /* ----- compute last row/column of n-by-n submatrix of metric ----- */
+        for ( size_t i = 0; i < n; ++i ) {
+          const size_t j = n - 1;
+
+          /* g_ij = [Phi_i, Phi_j] */
+          intparams.coord1 = i;
+          intparams.coord2 = j;
+          REAL8 gg = XLALCovariance_Phi_ij ( &metricParams->multiIFO, &metricParams->multiNoiseFloor, &metricParams->segmentList,
+                                             &intparams, &err );
+          XLAL_CHECK_NULL( !gsl_isnan(gg), XLAL_EFUNC, "%s: integration of phase metric g_{i=%zu,j=%zu} failed (n=%zu, tries=%zu)", __func__, i, j, n, tries );
+          gsl_matrix_set (&g_ij_n.matrix, i, j, gg);
+          gsl_matrix_set (&g_ij_n.matrix, j, i, gg);
+          metric->maxrelerr = MYMAX ( metric->maxrelerr, err );
+
+        } /* for i < n */
+
+        /* ----- compute L D L^T Cholesky decomposition of metric ----- */
+        XLAL_CHECK_NULL( XLALCholeskyLDLTDecompMetric( &cholesky, &g_ij_n.matrix ) == XLAL_SUCCESS, XLAL_EFUNC );
+        gsl_vector_view D = gsl_matrix_diagonal( cholesky );
+        if ( ( tries > 1 ) && ( lalDebugLevel & LALINFOBIT ) ) {
+          /* diagnostic / debug output */
+          fprintf(stdout, "%s: n=%zu, try=%zu, Cholesky diagonal =", __func__, n, tries);
+          XLALfprintfGSLvector(stdout, "%0.2e", &D.vector);
+        }
+
+        /* ----- check that all diagonal elements D are positive after at least 1 try; if so, exit try loop */
+        if ( ( tries > 1 ) && ( gsl_vector_min( &D.vector ) > 0.0 ) ) {
+          break;
+        }
+
+        /* zero out all but last row of L, since we do not want to coordinates before 'n' */
+        if ( n > 1 ) {
+          gsl_matrix_view cholesky_nm1 = gsl_matrix_submatrix( cholesky, 0, 0, n - 1, n );
+          gsl_matrix_set_identity( &cholesky_nm1.matrix );
+        }
+
+        /* multiply transform by inverse of L (with unit diagonal), to transform 'n'th coordinates so that metric is diagonal */
+        gsl_blas_dtrsm( CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0, cholesky, &transform_n.matrix );
+
+        /* decrease relative error tolerances; don't do this too quickly, since
+           too-stringent tolerances may make GSL integration fail to converge */
+        intparams.epsrel = intparams.epsrel * 0.9;
+        /* decrease absolute error tolerances; don't do this too quickly, since
+           too-stringent tolerances may make GSL integration fail to converge,
+           and only after a certain number of tries, otherwise small integrals
+           fail to converge */
+        if ( tries >= 8  ) {
+          intparams.epsabs = intparams.epsabs * 0.9;
+        }
+        /* reduce the length of integration time units, but stop at 900s,
+           and ensure that 'intT' does NOT become divisible by 1/day, for
+           the same reason given at the initialisation of 'intT' above */
+        intparams.intT = MYMAX(900, intparams.intT * 0.9);
 
-      /* multiply transform by inverse of L (with unit diagonal), to transform 'n'th coordinates so that metric is diagonal */
-      gsl_blas_dtrsm( CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0, cholesky, &transform_n.matrix );
-
-      /* decrease relative error tolerances; don't do this too quickly, since
-         too-stringent tolerances may make GSL integration fail to converge */
-      intparams.epsrel = intparams.epsrel * 0.9;
-      /* decrease absolute error tolerances; don't do this too quickly, since
-         too-stringent tolerances may make GSL integration fail to converge,
-         and only after a certain number of tries, otherwise small integrals
-         fail to converge */
-      if ( tries >= 8  ) {
-        intparams.epsabs = intparams.epsabs * 0.9;
       }
-      /* reduce the length of integration time units, but stop at 900s,
-         and ensure that 'intT' does NOT become divisible by 1/day, for
-         the same reason given at the initialisation of 'intT' above */
-      intparams.intT = MYMAX(900, intparams.intT * 0.9);
+      XLAL_CHECK_NULL( tries <= max_tries, XLAL_EMAXITER, "%s: convergence of phase metric failed (n=%zu)", __func__, n );
+
+      /* free memory which is then re-allocated in next loop */
+      gsl_matrix_free( cholesky );
 
     }
-    XLAL_CHECK_NULL( tries <= max_tries, XLAL_EMAXITER, "%s: convergence of phase metric failed (n=%zu)", __func__, n );
 
-    /* free memory which is then re-allocated in next loop */
-    gsl_matrix_free( cholesky );
+    /* apply inverse of transform^T to metric, to get back original coordinates */
+    gsl_matrix_transpose( transform );
+    XLAL_CHECK_NULL( XLALInverseTransformMetric( &metric->g_ij, transform, metric->g_ij ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  }
+    gsl_matrix_free(transform);
 
-  /* apply inverse of transform^T to metric, to get back original coordinates */
-  gsl_matrix_transpose( transform );
-  XLAL_CHECK_NULL( XLALInverseTransformMetric( &metric->g_ij, transform, metric->g_ij ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
 
   /* transform phase metric reference time from midTime to refTime */
   const REAL8 Dtau = XLALGPSDiff( &(metricParams->signalParams.Doppler.refTime), &midTime );
@@ -1418,7 +1936,6 @@ XLALComputeDopplerPhaseMetric ( const DopplerMetricParams *metricParams,  	/**<
 
   /* free memory */
   XLALDestroyVect3Dlist ( intparams.rOrb_n );
-  gsl_matrix_free(transform);
 
   return metric;
 
@@ -1659,6 +2176,7 @@ XLALComputeAtomsForFmetric ( const DopplerMetricParams *metricParams,  	/**< inp
 
   BOOLEAN haveNoiseWeights = (metricParams->multiNoiseFloor.length > 0);
   XLAL_CHECK_NULL ( !haveNoiseWeights || metricParams->multiNoiseFloor.length == numDet, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( metricParams->integration < DOPPLERMETRIC_INTEGRATION_LAST, XLAL_EINVAL, "Invalid metric integration method %d\n", metricParams->integration );
 
   LIGOTimeGPS *startTime = &(metricParams->segmentList.segs[0].start);
   LIGOTimeGPS *endTime   = &(metricParams->segmentList.segs[0].end);
@@ -1713,6 +2231,21 @@ XLALComputeAtomsForFmetric ( const DopplerMetricParams *metricParams,  	/**< inp
 
   }
 
+  /* ----- if requested, compute all atoms in one pass using fixed-node quadrature */
+  if ( metricParams->integration == DOPPLERMETRIC_INTEGRATION_FIXEDNODE )
+    {
+      int errnum = XLALFixedNodeAtomsForFmetric ( ret, &metricParams->multiIFO, &metricParams->multiNoiseFloor, &intparams );
+      XLALDestroyVect3Dlist ( intparams.rOrb_n );
+      if ( errnum != XLAL_SUCCESS || ret->maxrelerr > relerr_thresh )
+        {
+          XLALPrintError ("%s: fixed-node integration of F-metric atoms failed, maximal relative error %.2e\n", __func__, ret->maxrelerr );
+          XLALDestroyFmetricAtoms ( ret );
+          XLAL_ERROR_NULL( XLAL_EFUNC );
+        }
+      XLALPrintInfo ("\nMaximal relative error in F-metric: %.2e\n", ret->maxrelerr );
+      return ret;
+    }
+
   /* ----- integrate antenna-pattern coefficients A, B, C */
   REAL8 sum_weights = 0;
   A = B = C = 0;
@@ -163,6 +163,15 @@ typedef enum tagDopplerCoordinateID {
   DOPPLERCOORD_LAST
 } DopplerCoordinateID;
 
+/**
+ * Method used to integrate the phase-derivative averages from which the Doppler-metrics are computed
+ */
+typedef enum tagDopplerMetricIntegration {
+  DOPPLERMETRIC_INTEGRATION_ADAPTIVE = 0,	/**< Adaptive GSL quadrature of each metric element separately (default) */
+  DOPPLERMETRIC_INTEGRATION_FIXEDNODE,		/**< Fixed-node Gauss-Legendre quadrature of all metric elements in one pass over the detector motion */
+  DOPPLERMETRIC_INTEGRATION_LAST
+} DopplerMetricIntegration;
+
 #define DOPPLERMETRIC_MAX_DIM 60	/**< should be large enough for a long time ... */
 /**
  * type describing a Doppler coordinate system:
@@ -190,6 +199,8 @@ typedef struct tagDopplerMetricParams
   INT4 projectCoord;				/**< project metric onto subspace orthogonal to this axis (-1 = none, 0 = 1st coordinate, etc) */
 
   BOOLEAN approxPhase;				/**< use an approximate phase-model, neglecting Roemer delay in spindown coordinates */
+
+  DopplerMetricIntegration integration;		/**< method used to integrate the metric elements */
 } DopplerMetricParams;
 
 
@@ -279,6 +279,58 @@ main ( int argc, char *argv[] )
       XLAL_ERROR ( XLAL_EFUNC );
     }
 
+  // ----- test Demod hotloops supporting any Dterms against 'Generic', using Dterms which does not fill whole SIMD vectors
+  {
+    const FstatMethodType anyDtermsMethods[] = { FMETHOD_DEMOD_AVX2, FMETHOD_DEMOD_AVX512 };
+    optionalArgs.Dterms = 5;
+    optionalArgs.prevInput = NULL;
+    optionalArgs.FstatMethod = FMETHOD_DEMOD_GENERIC;
+    FstatInput *input_generic = NULL;
+    FstatResults *results_generic = NULL;
+    XLAL_CHECK ( ( input_generic = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( XLALComputeFstat ( &results_generic, input_generic, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < XLAL_NUM_ELEM(anyDtermsMethods); i ++ )
+      {
+        if ( !XLALFstatMethodIsAvailable(anyDtermsMethods[i]) ) {
+          continue;
+        }
+        optionalArgs.FstatMethod = anyDtermsMethods[i];
+        FstatInput *input_anyDterms = NULL;
+        FstatResults *results_anyDterms = NULL;
+        XLAL_CHECK ( ( input_anyDterms = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs ) ) != NULL, XLAL_EFUNC );
+        XLAL_CHECK ( XLALComputeFstat ( &results_anyDterms, input_anyDterms, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLALPrintInfo ("Comparing results between method '%s' and '%s' with Dterms=%d\n", XLALGetFstatInputMethodName(input_generic), XLALGetFstatInputMethodName(input_anyDterms), optionalArgs.Dterms );
+        if ( compareFstatResults ( results_generic, results_anyDterms ) != XLAL_SUCCESS )
+          {
+            XLALPrintError ("Comparison between method '%s' and '%s' failed with Dterms=%d\n", XLALGetFstatInputMethodName(input_generic), XLALGetFstatInputMethodName(input_anyDterms), optionalArgs.Dterms );
+            XLAL_ERROR ( XLAL_EFUNC );
+          }
+        XLALDestroyFstatInput ( input_anyDterms );
+        XLALDestroyFstatResults ( results_anyDterms );
+      }
+    XLALDestroyFstatInput ( input_generic );
+    XLALDestroyFstatResults ( results_generic );
+
+    // 'DemodBest' should select the fastest available of these hotloops for such Dterms
+    FstatMethodType bestMethod = FMETHOD_DEMOD_BEST;
+    for ( UINT4 i = 0; i < XLAL_NUM_ELEM(anyDtermsMethods); i ++ )
+      {
+        if ( XLALFstatMethodIsAvailable(anyDtermsMethods[i]) ) {
+          bestMethod = anyDtermsMethods[i];
+        }
+      }
+    if ( bestMethod != FMETHOD_DEMOD_BEST )
+      {
+        optionalArgs.FstatMethod = FMETHOD_DEMOD_BEST;
+        FstatInput *input_best = NULL;
+        XLAL_CHECK ( ( input_best = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs ) ) != NULL, XLAL_EFUNC );
+        XLAL_CHECK ( strcmp ( XLALGetFstatInputMethodName(input_best), XLALFstatMethodName(bestMethod) ) == 0, XLAL_EFAILED,
+                     "'DemodBest' selected method '%s' instead of '%s' with Dterms=%d\n", XLALGetFstatInputMethodName(input_best), XLALFstatMethodName(bestMethod), optionalArgs.Dterms );
+        XLALDestroyFstatInput ( input_best );
+      }
+    optionalArgs.Dterms = FstatOptionalArgsDefaults.Dterms;
+  }
+
   // free remaining memory
   for ( UINT4 iMethod=FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
     {
@@ -0,0 +1,186 @@
+/*
+*  Copyright (C) 2007 Bernd Machenschalk
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <math.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/HeapToplist.h>
+
+#define NUM_CAND   10000
+#define TOP_LENGTH 100
+
+/* toplist element: a key, and an index to break ties */
+typedef struct {
+  REAL4 key;
+  UINT4 idx;
+} elem_t;
+
+static int smaller(const void*a,const void*b) {
+  const elem_t *ea = (const elem_t *)a, *eb = (const elem_t *)b;
+  if (ea->key < eb->key)
+    return(1);
+  else if (ea->key > eb->key)
+    return(-1);
+  else if (ea->idx > eb->idx)
+    return(1);
+  else if (ea->idx < eb->idx)
+    return(-1);
+  else
+    return(0);
+}
+
+/* block of candidates starting at index 'offset' */
+typedef struct {
+  const REAL4 *keys;
+  UINT4 offset;
+} block_t;
+
+static void fill_elem(void *element, size_t idx, void *param) {
+  const block_t *block = (const block_t *)param;
+  elem_t *e = (elem_t *)element;
+  e->key = block->keys[block->offset + idx];
+  e->idx = block->offset + idx;
+}
+
+/* sets '*cmp' to 0 if the two toplists contain the same elements */
+static int compare_sorted(int *cmp, LALHeapToplist *l1, LALHeapToplist *l2) {
+  XLAL_CHECK( XLALQSortToplist(l1, smaller) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALQSortToplist(l2, smaller) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALCompareToplists(cmp, l1, l2) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+int main(void) {
+
+  static REAL4 keys[NUM_CAND];
+  LALHeapToplist *ref = NULL, *blk = NULL, *part[2] = {NULL, NULL}, *merged = NULL;
+  int cmp = 0, errnum = 0, retn = 0;
+
+  /* candidate keys; some repeated to test ordering of equal keys */
+  srand(1234);
+  for (UINT4 i = 0; i < NUM_CAND; i++)
+    keys[i] = (i % 7 == 0) ? 0.5 : rand() / (REAL4)RAND_MAX;
+
+  XLAL_CHECK_MAIN( (ref = XLALCreateToplist(TOP_LENGTH, sizeof(elem_t), smaller)) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( (blk = XLALCreateToplist(TOP_LENGTH, sizeof(elem_t), smaller)) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( (part[0] = XLALCreateToplist(TOP_LENGTH, sizeof(elem_t), smaller)) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( (part[1] = XLALCreateToplist(TOP_LENGTH, sizeof(elem_t), smaller)) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( (merged = XLALCreateToplist(TOP_LENGTH, sizeof(elem_t), smaller)) != NULL, XLAL_EFUNC );
+
+  /* reference: insert candidates one by one */
+  const block_t all = { keys, 0 };
+  for (UINT4 i = 0; i < NUM_CAND; i++) {
+    elem_t e;
+    fill_elem(&e, i, (void *)&all);
+    XLAL_CHECK_MAIN( XLALInsertIntoToplist(ref, &e) >= 0, XLAL_EFUNC );
+  }
+  XLAL_CHECK_MAIN( ref->elems == TOP_LENGTH, XLAL_EFAILED );
+
+  /* block insertion requires a sort key */
+  XLAL_TRY_SILENT( retn = XLALInsertBlockIntoToplist(blk, keys, NUM_CAND, fill_elem, (void *)&all), errnum );
+  XLAL_CHECK_MAIN( retn == XLAL_FAILURE && errnum == XLAL_EINVAL, XLAL_EFAILED );
+  XLAL_TRY_SILENT( retn = XLALSetToplistKey(blk, sizeof(elem_t)), errnum );
+  XLAL_CHECK_MAIN( retn == XLAL_FAILURE && errnum == XLAL_EINVAL, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALSetToplistKey(blk, offsetof(elem_t, key)) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* block insertion, in blocks of odd length, must give the same toplist */
+  for (UINT4 i = 0; i < NUM_CAND; i += 333) {
+    const block_t block = { keys, i };
+    const UINT4 n = (NUM_CAND - i < 333) ? NUM_CAND - i : 333;
+    XLAL_CHECK_MAIN( XLALInsertBlockIntoToplist(blk, keys + i, n, fill_elem, (void *)&block) >= 0, XLAL_EFAILED );
+  }
+  XLAL_CHECK_MAIN( compare_sorted(&cmp, ref, blk) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( cmp == 0, XLAL_EFAILED, "Block-inserted toplist differs from reference" );
+
+  /* NaN keys are never inserted */
+  const REAL4 nan_key = NAN;
+  const block_t nan_block = { &nan_key, 0 };
+  XLAL_CHECK_MAIN( XLALInsertBlockIntoToplist(blk, &nan_key, 1, fill_elem, (void *)&nan_block) == 0, XLAL_EFAILED );
+
+  /* per-"thread" toplists over halves of the candidates, merged afterwards */
+  for (UINT4 i = 0; i < NUM_CAND; i++) {
+    elem_t e;
+    fill_elem(&e, i, (void *)&all);
+    XLAL_CHECK_MAIN( XLALInsertIntoToplist(part[i % 2], &e) >= 0, XLAL_EFUNC );
+  }
+  XLAL_CHECK_MAIN( XLALMergeToplists(merged, part[0]) >= 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALMergeToplists(merged, part[1]) >= 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( compare_sorted(&cmp, ref, merged) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( cmp == 0, XLAL_EFAILED, "Merged toplist differs from reference" );
+  XLAL_TRY_SILENT( retn = XLALMergeToplists(merged, merged), errnum );
+  XLAL_CHECK_MAIN( retn == XLAL_FAILURE && errnum == XLAL_EINVAL, XLAL_EFAILED );
+
+  /* checkpoint round trip; restored toplists must still work as heaps */
+  const char cptname[] = "HeapToplistTest.cpt";
+  UINT4 counter = 0, sync_failures = 0;
+  BOOLEAN found = 0;
+  XLAL_CHECK_MAIN( XLALWriteToplistCheckpoint(cptname, part, 2, 42, &sync_failures) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALClearToplist(part[0]) == XLAL_SUCCESS && XLALClearToplist(part[1]) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALReadToplistCheckpoint(cptname, part, 2, &counter, &found) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( found && counter == 42, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALClearToplist(merged) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALMergeToplists(merged, part[0]) >= 0 && XLALMergeToplists(merged, part[1]) >= 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( compare_sorted(&cmp, ref, merged) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( cmp == 0, XLAL_EFAILED, "Toplists read from checkpoint differ from reference" );
+
+  /* checkpoint of a different number of toplists is rejected */
+  XLAL_TRY_SILENT( retn = XLALReadToplistCheckpoint(cptname, part, 1, &counter, &found), errnum );
+  XLAL_CHECK_MAIN( retn == XLAL_FAILURE && errnum == XLAL_EDATA, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( counter == 0 && part[0]->elems == 0, XLAL_EFAILED );
+
+  /* corrupted checkpoint is rejected */
+  {
+    FILE *fp = fopen(cptname, "r+b");
+    XLAL_CHECK_MAIN( fp != NULL, XLAL_EIO );
+    XLAL_CHECK_MAIN( fseek(fp, 100, SEEK_SET) == 0, XLAL_EIO );
+    const int c = fgetc(fp);
+    XLAL_CHECK_MAIN( fseek(fp, 100, SEEK_SET) == 0, XLAL_EIO );
+    fputc(c ^ 0x10, fp);
+    fclose(fp);
+  }
+  XLAL_TRY_SILENT( retn = XLALReadToplistCheckpoint(cptname, part, 2, &counter, &found), errnum );
+  XLAL_CHECK_MAIN( retn == XLAL_FAILURE && errnum == XLAL_EDATA, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( counter == 0 && part[0]->elems == 0 && part[1]->elems == 0, XLAL_EFAILED );
+
+  /* missing checkpoint */
+  XLAL_CHECK_MAIN( remove(cptname) == 0, XLAL_EIO );
+  XLAL_CHECK_MAIN( XLALReadToplistCheckpoint(cptname, part, 2, &counter, &found) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( !found && counter == 0, XLAL_EFAILED );
+
+  /* invalid arguments are errors; destroying NULL is not */
+  XLAL_TRY_SILENT( retn = XLALClearToplist(NULL), errnum );
+  XLAL_CHECK_MAIN( retn == XLAL_FAILURE && errnum == XLAL_EFAULT, XLAL_EFAILED );
+  XLAL_TRY_SILENT( retn = XLALInsertIntoToplist(NULL, &found), errnum );
+  XLAL_CHECK_MAIN( retn == XLAL_FAILURE && errnum == XLAL_EFAULT, XLAL_EFAILED );
+  XLALDestroyToplist(NULL);
+
+  XLALDestroyToplist(ref);
+  XLALDestroyToplist(blk);
+  XLALDestroyToplist(part[0]);
+  XLALDestroyToplist(part[1]);
+  XLALDestroyToplist(merged);
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
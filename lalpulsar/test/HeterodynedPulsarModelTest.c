@@ -0,0 +1,250 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Test the solar system barycentre delays interpolated from a
+ * SSBDelayLookupTable against those computed exactly at every time by
+ * XLALHeterodynedPulsarGetSSBDelay(), for several sources and time systems.
+ */
+
+/* ---------- Includes -------------------- */
+#include <math.h>
+#include <stdlib.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/Date.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/LALDetectors.h>
+#include <lal/HeterodynedPulsarModel.h>
+
+/* ---------- Defines -------------------- */
+/* Allowed difference in seconds between the interpolated and exact delays (the default table tolerance) */
+#define DELAY_TOLERANCE 1e-9
+
+/* Allowed difference between the interpolated delay derivatives and central finite differences of the exact delays */
+#define DELAY_DERIV_TOLERANCE 1e-10
+
+/* Allowed difference in seconds between delays computed exactly by the table and by XLALHeterodynedPulsarGetSSBDelay() */
+#define EXACT_TOLERANCE 1e-12
+
+/*---------- internal prototypes ----------*/
+static LIGOTimeGPSVector *create_test_times ( void );
+static PulsarParameters *create_test_source ( UINT4 n );
+static int compare_with_exact ( const LIGOTimeGPSVector *datatimes, const LALDetector *detector, const EphemerisData *edat, const TimeCorrectionData *tdat, TimeCorrectionType ttype );
+
+/* ---------- function definitions ---------- */
+int
+main ( void )
+{
+  EphemerisData *edat = NULL;
+  XLAL_CHECK_MAIN ( ( edat = XLALInitBarycenter ( TEST_PKG_DATA_DIR "earth00-40-DE405.dat.gz", TEST_PKG_DATA_DIR "sun00-40-DE405.dat.gz" ) ) != NULL, XLAL_EFUNC );
+  TimeCorrectionData *tdat = NULL;
+  XLAL_CHECK_MAIN ( ( tdat = XLALInitTimeCorrections ( TEST_PKG_DATA_DIR "te405_2000-2040.dat.gz" ) ) != NULL, XLAL_EFUNC );
+
+  LIGOTimeGPSVector *datatimes = create_test_times ();
+  XLAL_CHECK_MAIN ( datatimes != NULL, XLAL_EFUNC );
+
+  const LALDetector *detector = &lalCachedDetectors[LAL_LHO_4K_DETECTOR];
+
+  XLAL_CHECK_MAIN ( compare_with_exact ( datatimes, detector, edat, NULL, TIMECORRECTION_ORIGINAL ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( compare_with_exact ( datatimes, detector, edat, tdat, TIMECORRECTION_TDB ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLALDestroyTimestampVector ( datatimes );
+  XLALDestroyTimeCorrectionData ( tdat );
+  XLALDestroyEphemerisData ( edat );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} /* main() */
+
+/**
+ * Create two days of one-minute time stamps, with fractional seconds and a
+ * gap, followed by a sparser block of irregular time stamps a week later.
+ */
+static LIGOTimeGPSVector *
+create_test_times ( void )
+{
+  const UINT4 numDense = 2 * 1440, numSparse = 200;
+
+  LIGOTimeGPSVector *datatimes = XLALCreateTimestampVector ( numDense + numSparse );
+  XLAL_CHECK_NULL ( datatimes != NULL, XLAL_EFUNC );
+
+  srand ( 20171017 );
+  UINT4 i = 0;
+  for ( UINT4 j = 0; i < numDense; j ++ )
+    {
+      if ( j >= 600 && j < 900 ) {
+        continue;
+      }
+      XLALGPSSet ( &datatimes->data[i], 1187008882 + 60 * j, 250000000 );
+      i ++;
+    }
+  for ( UINT4 j = 0; j < numSparse; j ++, i ++ )
+    {
+      XLALGPSSetREAL8 ( &datatimes->data[i], 1187008882 + 10 * 86400 + 86400.0 * rand() / RAND_MAX );
+    }
+
+  return datatimes;
+
+} /* create_test_times() */
+
+/**
+ * Create the parameters of test source \c n: a fixed sky position, a sky
+ * position with proper motion and distance, and a sky position with a
+ * gravitational-wave speed different from the speed of light.
+ */
+static PulsarParameters *
+create_test_source ( UINT4 n )
+{
+  PulsarParameters *pars = XLALCalloc ( sizeof ( *pars ), 1 );
+  XLAL_CHECK_NULL ( pars != NULL, XLAL_ENOMEM );
+
+  switch ( n )
+    {
+    case 0:
+      PulsarAddREAL8Param ( pars, "RA", 1.4596725 );
+      PulsarAddREAL8Param ( pars, "DEC", 0.3842177 );
+      break;
+    case 1:
+      PulsarAddREAL8Param ( pars, "RAJ", 5.1241 );
+      PulsarAddREAL8Param ( pars, "DECJ", -1.2107 );
+      PulsarAddREAL8Param ( pars, "PMRA", 1e-15 );
+      PulsarAddREAL8Param ( pars, "PMDEC", -2e-15 );
+      PulsarAddREAL8Param ( pars, "POSEPOCH", 1e9 );
+      PulsarAddREAL8Param ( pars, "PX", 1e-9 );
+      break;
+    case 2:
+      PulsarAddREAL8Param ( pars, "RA", 3.0 );
+      PulsarAddREAL8Param ( pars, "DEC", 0.0 );
+      PulsarAddREAL8Param ( pars, "CGW", 0.9 );
+      break;
+    default:
+      XLAL_ERROR_NULL ( XLAL_EINVAL, "Unknown test source %u", n );
+    }
+
+  return pars;
+
+} /* create_test_source() */
+
+/**
+ * Compare the delays, and delay derivatives, interpolated from a look-up
+ * table with the exact delays for each test source. A look-up table with a
+ * tolerance too small to be met must fall back to the exact delays.
+ */
+static int
+compare_with_exact ( const LIGOTimeGPSVector *datatimes, const LALDetector *detector, const EphemerisData *edat, const TimeCorrectionData *tdat, TimeCorrectionType ttype )
+{
+  const UINT4 numSources = 3;
+  const UINT4 length = datatimes->length;
+
+  SSBDelayLookupTable *table = XLALCreateSSBDelayLookupTable ( datatimes, detector, edat, tdat, ttype, 0 );
+  XLAL_CHECK ( table != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( table->tolerance == DELAY_TOLERANCE && table->dt > 60, XLAL_EFAILED, "Unexpected default table tolerance %g and spacing %g", table->tolerance, table->dt );
+
+  SSBDelayLookupTable *finetable = XLALCreateSSBDelayLookupTable ( datatimes, detector, edat, tdat, ttype, 1e-15 );
+  XLAL_CHECK ( finetable != NULL, XLAL_EFUNC );
+
+  /* times one second either side of each data time, for the finite-difference derivatives */
+  LIGOTimeGPSVector *times_m = XLALCreateTimestampVector ( length );
+  LIGOTimeGPSVector *times_p = XLALCreateTimestampVector ( length );
+  XLAL_CHECK ( times_m != NULL && times_p != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < length; i ++ )
+    {
+      times_m->data[i] = times_p->data[i] = datatimes->data[i];
+      XLALGPSAdd ( &times_m->data[i], -1 );
+      XLALGPSAdd ( &times_p->data[i], 1 );
+    }
+
+  REAL8Vector *dts_interp = XLALCreateREAL8Vector ( length );
+  REAL8Vector *dtsdot_interp = XLALCreateREAL8Vector ( length );
+  XLAL_CHECK ( dts_interp != NULL && dtsdot_interp != NULL, XLAL_EFUNC );
+
+  for ( UINT4 n = 0; n < numSources; n ++ )
+    {
+      PulsarParameters *pars = create_test_source ( n );
+      XLAL_CHECK ( pars != NULL, XLAL_EFUNC );
+
+      REAL8Vector *dts_exact = XLALHeterodynedPulsarGetSSBDelay ( pars, datatimes, detector, edat, tdat, ttype );
+      REAL8Vector *dts_exact_m = XLALHeterodynedPulsarGetSSBDelay ( pars, times_m, detector, edat, tdat, ttype );
+      REAL8Vector *dts_exact_p = XLALHeterodynedPulsarGetSSBDelay ( pars, times_p, detector, edat, tdat, ttype );
+      XLAL_CHECK ( dts_exact != NULL && dts_exact_m != NULL && dts_exact_p != NULL, XLAL_EFUNC );
+
+      /* delays interpolated from the table */
+      REAL8 maxerr = -1;
+      REAL8Vector *dts_table = XLALHeterodynedPulsarGetSSBDelayFromTable ( pars, datatimes, table, &maxerr );
+      XLAL_CHECK ( dts_table != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( maxerr > 0 && maxerr <= DELAY_TOLERANCE, XLAL_ETOL, "Source %u: interpolation error bound %g not within (0, %g]", n, maxerr, DELAY_TOLERANCE );
+
+      /* delays and derivatives interpolated from the table for the same source */
+      BarycenterInput source;
+      source.alpha = PulsarCheckParam ( pars, "RA" ) ? PulsarGetREAL8Param ( pars, "RA" ) : PulsarGetREAL8Param ( pars, "RAJ" );
+      source.delta = PulsarCheckParam ( pars, "DEC" ) ? PulsarGetREAL8Param ( pars, "DEC" ) : PulsarGetREAL8Param ( pars, "DECJ" );
+      source.dInv = PulsarCheckParam ( pars, "PX" ) ? PulsarGetREAL8Param ( pars, "PX" ) * LAL_C_SI / LAL_AU_SI : 0;
+      XLAL_CHECK ( XLALSSBDelayLookupTableGetDelays ( dts_interp, dtsdot_interp, NULL, table, datatimes, &source,
+                                                      PulsarGetREAL8ParamOrZero ( pars, "PMRA" ), PulsarGetREAL8ParamOrZero ( pars, "PMDEC" ),
+                                                      PulsarGetREAL8ParamOrZero ( pars, "POSEPOCH" ), PulsarGetREAL8ParamOrZero ( pars, "CGW" ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      REAL8 maxdiff = 0, maxdiffdot = 0;
+      for ( UINT4 i = 0; i < length; i ++ )
+        {
+          REAL8 diff = fabs ( dts_table->data[i] - dts_exact->data[i] );
+          XLAL_CHECK ( diff <= DELAY_TOLERANCE, XLAL_ETOL, "Source %u, time %d.%09d: interpolated delay %.12f differs from exact delay %.12f by %g s",
+                       n, datatimes->data[i].gpsSeconds, datatimes->data[i].gpsNanoSeconds, dts_table->data[i], dts_exact->data[i], diff );
+          XLAL_CHECK ( dts_interp->data[i] == dts_table->data[i], XLAL_EFAILED, "Source %u, time %d.%09d: XLALSSBDelayLookupTableGetDelays() delay %.12f differs from %.12f",
+                       n, datatimes->data[i].gpsSeconds, datatimes->data[i].gpsNanoSeconds, dts_interp->data[i], dts_table->data[i] );
+          maxdiff = fmax ( maxdiff, diff );
+
+          REAL8 dtsdot_exact = 0.5 * ( dts_exact_p->data[i] - dts_exact_m->data[i] );
+          REAL8 diffdot = fabs ( dtsdot_interp->data[i] - dtsdot_exact );
+          XLAL_CHECK ( diffdot <= DELAY_DERIV_TOLERANCE, XLAL_ETOL, "Source %u, time %d.%09d: interpolated delay derivative %g differs from exact derivative %g by %g",
+                       n, datatimes->data[i].gpsSeconds, datatimes->data[i].gpsNanoSeconds, dtsdot_interp->data[i], dtsdot_exact, diffdot );
+          maxdiffdot = fmax ( maxdiffdot, diffdot );
+        }
+
+      /* a table whose tolerance cannot be met computes every delay exactly */
+      REAL8 maxerr_fine = -1;
+      REAL8Vector *dts_fine = XLALHeterodynedPulsarGetSSBDelayFromTable ( pars, datatimes, finetable, &maxerr_fine );
+      XLAL_CHECK ( dts_fine != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( maxerr_fine == 0, XLAL_EFAILED, "Source %u: unexpected interpolation with error bound %g", n, maxerr_fine );
+      for ( UINT4 i = 0; i < length; i ++ )
+        {
+          XLAL_CHECK ( fabs ( dts_fine->data[i] - dts_exact->data[i] ) <= EXACT_TOLERANCE, XLAL_ETOL, "Source %u, time %d.%09d: delay %.12f differs from exact delay %.12f",
+                       n, datatimes->data[i].gpsSeconds, datatimes->data[i].gpsNanoSeconds, dts_fine->data[i], dts_exact->data[i] );
+        }
+
+      XLALPrintInfo ( "%s: time correction type %d, source %u: error bound %g s, max difference %g s, max derivative difference %g\n", __func__, ttype, n, maxerr, maxdiff, maxdiffdot );
+
+      XLALDestroyREAL8Vector ( dts_fine );
+      XLALDestroyREAL8Vector ( dts_table );
+      XLALDestroyREAL8Vector ( dts_exact_p );
+      XLALDestroyREAL8Vector ( dts_exact_m );
+      XLALDestroyREAL8Vector ( dts_exact );
+      PulsarFreeParams ( pars );
+    }
+
+  XLALDestroyREAL8Vector ( dtsdot_interp );
+  XLALDestroyREAL8Vector ( dts_interp );
+  XLALDestroyTimestampVector ( times_p );
+  XLALDestroyTimestampVector ( times_m );
+  XLALDestroySSBDelayLookupTable ( finetable );
+  XLALDestroySSBDelayLookupTable ( table );
+
+  return XLAL_SUCCESS;
+
+} /* compare_with_exact() */
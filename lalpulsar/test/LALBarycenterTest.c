@@ -55,6 +55,7 @@
 
 /* ----- internal prototype ---------- */
 int compare_ephemeris ( const EphemerisData *edat1, const EphemerisData *edat2 );
+int write_corrupted_copy ( const char *fname, const char *fnameCopy, long flipOffset, long length );
 REAL8 relerr(REAL8 x, REAL8 xapprox);
 
 inline REAL8 relerr ( REAL8 x, REAL8 xapprox )
@@ -210,6 +211,50 @@ main( void )
   XLALPrintError ("XLALBarycenter() 	%g s\n", tau / counter );
   XLALPrintError ("XLALBarycenterOpt()	%g s (= %.1f %%)\n", tau_opt / counter,  - 100 * (tau - tau_opt ) / tau );
 
+  /* ===== test binary ephemeris files ===== */
+  XLALPrintInfo("\n\nTesting XLALConvertEphemerisFileToBinary() ... ");
+  {
+    char eEphFileBin[] = "LALBarycenterTest_earth98.bin";
+    char sEphFileBin[] = "LALBarycenterTest_sun98.bin";
+    XLAL_CHECK( XLALConvertEphemerisFileToBinary( eEphFileBin, eEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALConvertEphemerisFileToBinary( sEphFileBin, sEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    EphemerisData *edatBin = XLALInitBarycenter( eEphFileBin, sEphFileBin );
+    XLAL_CHECK( edatBin != NULL, XLAL_EFUNC );
+    XLAL_CHECK( compare_ephemeris( edat, edatBin ) == XLAL_SUCCESS, XLAL_EFAILED, "\nTest FAILED: binary ephemeris differs from '%s', '%s'\n", eEphFile, sEphFile );
+
+    /* restricting must work on memory-mapped tables as well */
+    LIGOTimeGPS startGPS, endGPS;
+    XLAL_CHECK( XLALGPSSetREAL8(&startGPS, edatBin->ephemS[2].gps) != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALGPSSetREAL8(&endGPS, edatBin->ephemS[edatBin->nentriesS - 3].gps) != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALRestrictEphemerisData(edatBin, &startGPS, &endGPS) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( edatBin->ephemS[0].gps == edat->ephemS[2].gps, XLAL_EFAILED );
+
+    XLALDestroyEphemerisData(edatBin);
+
+    /* corrupted or truncated binary files must be rejected: flip a byte in the
+     * version and the checksum in the header, and in an entry; truncate an entry
+     * and the header */
+    char eEphFileCorrupt[] = "LALBarycenterTest_earth98_corrupt.bin";
+    const long headerSize = 64;
+    const long fileSize = headerSize + edat->nentriesE * (long) sizeof(PosVelAcc);
+    const long corruptions[][2] = {
+      { 8, fileSize },
+      { 48, fileSize },
+      { headerSize + 10 * sizeof(PosVelAcc) + 17, fileSize },
+      { -1, fileSize - sizeof(PosVelAcc) / 2 },
+      { -1, headerSize / 2 },
+    };
+    for ( size_t i = 0; i < XLAL_NUM_ELEM(corruptions); i ++ )
+      {
+        XLAL_CHECK( write_corrupted_copy( eEphFileBin, eEphFileCorrupt, corruptions[i][0], corruptions[i][1] ) == XLAL_SUCCESS, XLAL_EFUNC );
+        int errnum;
+        XLAL_TRY_SILENT( edatBin = XLALInitBarycenter( eEphFileCorrupt, sEphFileBin ), errnum );
+        XLAL_CHECK( edatBin == NULL && errnum != 0, XLAL_EFAILED, "\nTest FAILED: corrupted binary ephemeris (flipped byte %ld, length %ld) not rejected\n", corruptions[i][0], corruptions[i][1] );
+      }
+  }
+  XLALPrintInfo("PASSED\n\n");
+
   /* ===== test XLALRestrictEphemerisData() ===== */
   XLALPrintInfo("\n\nTesting XLALRestrictEphemerisData() ... ");
   {
@@ -417,6 +462,34 @@ compare_ephemeris ( const EphemerisData *edat1, const EphemerisData *edat2 )
 
 } /* compare_ephemeris() */
 
+/* write the first 'length' bytes of a file to a copy, with the byte at 'flipOffset' inverted if >= 0 */
+int
+write_corrupted_copy ( const char *fname, const char *fnameCopy, long flipOffset, long length )
+{
+  FILE *fp = fopen ( fname, "rb" );
+  XLAL_CHECK ( fp != NULL, XLAL_EIO, "Failed to open '%s'\n", fname );
+  char *buf = XLALMalloc ( length );
+  XLAL_CHECK ( buf != NULL, XLAL_ENOMEM );
+  size_t nread = fread ( buf, 1, length, fp );
+  fclose ( fp );
+  XLAL_CHECK ( nread == (size_t) length, XLAL_EIO, "Failed to read %ld bytes from '%s'\n", length, fname );
+
+  if ( flipOffset >= 0 ) {
+    XLAL_CHECK ( flipOffset < length, XLAL_EINVAL );
+    buf[flipOffset] = ~buf[flipOffset];
+  }
+
+  fp = fopen ( fnameCopy, "wb" );
+  XLAL_CHECK ( fp != NULL, XLAL_EIO, "Failed to open '%s'\n", fnameCopy );
+  size_t nwritten = fwrite ( buf, 1, length, fp );
+  fclose ( fp );
+  XLALFree ( buf );
+  XLAL_CHECK ( nwritten == (size_t) length, XLAL_EIO, "Failed to write '%s'\n", fnameCopy );
+
+  return XLAL_SUCCESS;
+
+} /* write_corrupted_copy() */
+
 /* return differences in all fields from EmissionTime struct */
 int
 diffEmissionTime ( EmissionTime *diff, const EmissionTime *emit1, const EmissionTime *emit2 )
@@ -0,0 +1,219 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Test XLALComputeTransientFstatMap() against a brute-force map, which sums
+ * the window-weighted F-stat atoms of every {t0, tau} directly.
+ *
+ * The start-time ranges cover several blocks of the map, and the exponential
+ * windows are tested with start-time steps for which the recursion drops and
+ * prepends atoms, and for which it recomputes the sums from scratch.
+ */
+
+/* ---------- Includes -------------------- */
+#include <math.h>
+#include <stdlib.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/TransientCW_utils.h>
+
+/* ---------- Defines -------------------- */
+#define TATOM 1800
+#define TSTART (500000 * TATOM)
+#define NUM_ATOMS 300
+
+/* Allowed difference in F, relative to max(1, F), between the map and the
+ * brute-force map; F is returned in single precision */
+#define TOLERANCE 1e-4
+
+/*---------- internal prototypes ----------*/
+static MultiFstatAtomVector *create_test_atoms ( void );
+static REAL8 brute_force_F ( const MultiFstatAtomVector *multiAtoms, transientWindowType_t type, UINT4 t0, UINT4 tau );
+static int compare_with_brute_force ( const MultiFstatAtomVector *multiAtoms, transientWindowRange_t windowRange );
+
+/* ---------- function definitions ---------- */
+int
+main ( void )
+{
+  MultiFstatAtomVector *multiAtoms = create_test_atoms ();
+  XLAL_CHECK_MAIN ( multiAtoms != NULL, XLAL_EFUNC );
+
+  transientWindowRange_t windowRange;
+  windowRange.t0 = TSTART;
+  windowRange.tau = 20 * TATOM;
+  windowRange.tauBand = 30 * TATOM;
+  windowRange.dtau = 3 * TATOM;
+
+  /* start-times step by one atom: the exponential-window recursion drops and prepends atoms */
+  windowRange.t0Band = 150 * TATOM;
+  windowRange.dt0 = TATOM;
+  windowRange.type = TRANSIENT_RECTANGULAR;
+  XLAL_CHECK_MAIN ( compare_with_brute_force ( multiAtoms, windowRange ) == XLAL_SUCCESS, XLAL_EFUNC );
+  windowRange.type = TRANSIENT_EXPONENTIAL;
+  XLAL_CHECK_MAIN ( compare_with_brute_force ( multiAtoms, windowRange ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* start-times step by several atoms */
+  windowRange.t0Band = 240 * TATOM;
+  windowRange.dt0 = 3 * TATOM;
+  XLAL_CHECK_MAIN ( compare_with_brute_force ( multiAtoms, windowRange ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* start-times step by more than a window length: the recursion recomputes the sums */
+  windowRange.t0Band = 280 * TATOM;
+  windowRange.dt0 = 70 * TATOM;
+  XLAL_CHECK_MAIN ( compare_with_brute_force ( multiAtoms, windowRange ) == XLAL_SUCCESS, XLAL_EFUNC );
+  windowRange.type = TRANSIENT_RECTANGULAR;
+  XLAL_CHECK_MAIN ( compare_with_brute_force ( multiAtoms, windowRange ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* start-times up to the last atom give a degenerate single-atom window, which is an error */
+  windowRange.t0Band = ( NUM_ATOMS - 1 ) * TATOM;
+  windowRange.dt0 = TATOM;
+  for ( int type = TRANSIENT_RECTANGULAR; type <= TRANSIENT_EXPONENTIAL; type ++ )
+    {
+      windowRange.type = type;
+      transientFstatMap_t *FstatMap = NULL;
+      int errnum;
+      XLAL_TRY_SILENT ( FstatMap = XLALComputeTransientFstatMap ( multiAtoms, windowRange, 0 ), errnum );
+      XLAL_CHECK_MAIN ( errnum == XLAL_EDOM && FstatMap == NULL, XLAL_EFAILED, "Degenerate window not rejected for window type %d", type );
+    }
+
+  XLALDestroyMultiFstatAtomVector ( multiAtoms );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} /* main() */
+
+/**
+ * Create F-stat atoms for two detectors with random values, each with a gap
+ * in the data, and a common gap which leaves empty bins in the merged atoms.
+ */
+static MultiFstatAtomVector *
+create_test_atoms ( void )
+{
+  const UINT4 numDet = 2;
+  const UINT4 gapStart[2] = { 100, 180 };
+  const UINT4 gapLength[2] = { 20, 12 };
+  const UINT4 commonGapStart = 230, commonGapLength = 8;
+
+  MultiFstatAtomVector *multiAtoms = XLALCreateMultiFstatAtomVector ( numDet );
+  XLAL_CHECK_NULL ( multiAtoms != NULL, XLAL_EFUNC );
+
+  srand ( 20170101 );
+  for ( UINT4 X = 0; X < numDet; X ++ )
+    {
+      UINT4 numAtomsX = NUM_ATOMS - gapLength[X] - commonGapLength;
+      XLAL_CHECK_NULL ( ( multiAtoms->data[X] = XLALCreateFstatAtomVector ( numAtomsX ) ) != NULL, XLAL_EFUNC );
+      multiAtoms->data[X]->TAtom = TATOM;
+
+      UINT4 alpha = 0;
+      for ( UINT4 i = 0; i < NUM_ATOMS; i ++ )
+        {
+          if ( ( i >= gapStart[X] && i < gapStart[X] + gapLength[X] ) || ( i >= commonGapStart && i < commonGapStart + commonGapLength ) ) {
+            continue;
+          }
+          FstatAtom *atom = &multiAtoms->data[X]->data[alpha ++];
+          atom->timestamp = TSTART + i * TATOM;
+          atom->a2_alpha = 0.5 + 1.0 * rand() / RAND_MAX;
+          atom->b2_alpha = 0.5 + 1.0 * rand() / RAND_MAX;
+          atom->ab_alpha = 0.6 * rand() / RAND_MAX - 0.3;
+          atom->Fa_alpha = crectf ( 2.0 * rand() / RAND_MAX - 1.0, 2.0 * rand() / RAND_MAX - 1.0 );
+          atom->Fb_alpha = crectf ( 2.0 * rand() / RAND_MAX - 1.0, 2.0 * rand() / RAND_MAX - 1.0 );
+        }
+      XLAL_CHECK_NULL ( alpha == numAtomsX, XLAL_EFAILED );
+    }
+
+  return multiAtoms;
+
+} /* create_test_atoms() */
+
+/**
+ * Compute F for the transient window {t0, tau} by summing, over all detectors, the atoms which lie
+ * entirely within the window [t0, t1], weighted by the window-value at their timestamp.
+ */
+static REAL8
+brute_force_F ( const MultiFstatAtomVector *multiAtoms, transientWindowType_t type, UINT4 t0, UINT4 tau )
+{
+  UINT4 t1 = ( type == TRANSIENT_EXPONENTIAL ) ? lround ( t0 + TRANSIENT_EXP_EFOLDING * tau ) : t0 + tau;
+
+  REAL8 Ad = 0, Bd = 0, Cd = 0;
+  COMPLEX16 Fa = 0, Fb = 0;
+  for ( UINT4 X = 0; X < multiAtoms->length; X ++ )
+    {
+      for ( UINT4 alpha = 0; alpha < multiAtoms->data[X]->length; alpha ++ )
+        {
+          const FstatAtom *atom = &multiAtoms->data[X]->data[alpha];
+          if ( atom->timestamp < t0 || atom->timestamp + TATOM > t1 ) {
+            continue;
+          }
+          REAL8 win = ( type == TRANSIENT_EXPONENTIAL ) ? exp ( - 1.0 * ( atom->timestamp - t0 ) / tau ) : 1.0;
+          Ad += win * win * atom->a2_alpha;
+          Bd += win * win * atom->b2_alpha;
+          Cd += win * win * atom->ab_alpha;
+          Fa += win * atom->Fa_alpha;
+          Fb += win * atom->Fb_alpha;
+        }
+    }
+
+  REAL4 Dd = XLALComputeAntennaPatternSqrtDeterminant ( Ad, Bd, Cd, 0 );
+  return 0.5 * XLALComputeFstatFromFaFb ( Fa, Fb, Ad, Bd, Cd, 0, 1.0f / Dd );
+
+} /* brute_force_F() */
+
+/**
+ * Compare the transient F-stat map, and its maximum, with the brute-force map.
+ */
+static int
+compare_with_brute_force ( const MultiFstatAtomVector *multiAtoms, transientWindowRange_t windowRange )
+{
+  transientFstatMap_t *FstatMap = XLALComputeTransientFstatMap ( multiAtoms, windowRange, 0 );
+  XLAL_CHECK ( FstatMap != NULL, XLAL_EFUNC );
+
+  UINT4 N_t0Range = windowRange.t0Band / windowRange.dt0 + 1;
+  UINT4 N_tauRange = windowRange.tauBand / windowRange.dtau + 1;
+  XLAL_CHECK ( FstatMap->F_mn->size1 == N_t0Range && FstatMap->F_mn->size2 == N_tauRange, XLAL_EFAILED );
+
+  REAL8 maxdiff = 0, maxF_bf = -1;
+  for ( UINT4 m = 0; m < N_t0Range; m ++ )
+    {
+      UINT4 t0 = windowRange.t0 + m * windowRange.dt0;
+      for ( UINT4 n = 0; n < N_tauRange; n ++ )
+        {
+          UINT4 tau = windowRange.tau + n * windowRange.dtau;
+          REAL8 F = gsl_matrix_get ( FstatMap->F_mn, m, n );
+          REAL8 F_bf = brute_force_F ( multiAtoms, windowRange.type, t0, tau );
+          REAL8 diff = fabs ( F - F_bf ) / fmax ( 1.0, F_bf );
+          XLAL_CHECK ( diff <= TOLERANCE, XLAL_ETOL, "Window type %d, t0=%d, tau=%d: F=%g differs from brute-force F=%g", windowRange.type, t0, tau, F, F_bf );
+          maxdiff = fmax ( maxdiff, diff );
+          maxF_bf = fmax ( maxF_bf, F_bf );
+        }
+    }
+
+  /* the maximum-likelihood {t0, tau} point to the maximum of the map */
+  XLAL_CHECK ( fabs ( FstatMap->maxF - maxF_bf ) <= TOLERANCE * fmax ( 1.0, maxF_bf ), XLAL_ETOL, "maxF=%g differs from brute-force maxF=%g", FstatMap->maxF, maxF_bf );
+  UINT4 m_ML = ( FstatMap->t0_ML - windowRange.t0 ) / windowRange.dt0;
+  UINT4 n_ML = ( FstatMap->tau_ML - windowRange.tau ) / windowRange.dtau;
+  XLAL_CHECK ( m_ML < N_t0Range && n_ML < N_tauRange && (REAL4) gsl_matrix_get ( FstatMap->F_mn, m_ML, n_ML ) == (REAL4) FstatMap->maxF, XLAL_EFAILED,
+               "Maximum-likelihood t0=%d, tau=%d do not point to maxF=%g", FstatMap->t0_ML, FstatMap->tau_ML, FstatMap->maxF );
+
+  XLALPrintInfo ( "%s: window type %d, %d x %d windows: max relative difference %g\n", __func__, windowRange.type, N_t0Range, N_tauRange, maxdiff );
+
+  XLALDestroyTransientFstatMap ( FstatMap );
+
+  return XLAL_SUCCESS;
+
+} /* compare_with_brute_force() */
@@ -507,6 +507,48 @@ test_XLALComputeDopplerMetrics ( void )
   } // end: Round 6 + 7 (binary orbital metrics)
 
 
+  XLALPrintWarning("\n---------- ROUND 8: fixed-node vs adaptive integration of multi-IFO, segment-averaged phase and F-stat metrics ----------\n");
+  {
+    DopplerPhaseMetric *metricAdP, *metricFnP;
+    DopplerFstatMetric *metricAdF, *metricFnF;
+    REAL8 diff_fn_ad, tolFixedNode = 1e-3;
+
+    DopplerMetricParams pars2 = master_pars2;
+
+    const UINT4 Nseg = 4;
+    LALSegList XLAL_INIT_DECL(NsegList);
+    XLAL_CHECK ( XLALSegListInitSimpleSegments ( &NsegList, startTimeGPS, Nseg, Tseg ) == XLAL_SUCCESS, XLAL_EFUNC );
+    pars2.segmentList = NsegList;
+
+    // 1) compute metrics using adaptive integration
+    pars2.integration = DOPPLERMETRIC_INTEGRATION_ADAPTIVE;
+    XLAL_CHECK ( (metricAdP = XLALComputeDopplerPhaseMetric ( &pars2, edat )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( (metricAdF = XLALComputeDopplerFstatMetric ( &pars2, edat )) != NULL, XLAL_EFUNC );
+
+    // 2) compute metrics using fixed-node integration
+    pars2.integration = DOPPLERMETRIC_INTEGRATION_FIXEDNODE;
+    XLAL_CHECK ( (metricFnP = XLALComputeDopplerPhaseMetric ( &pars2, edat )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( (metricFnF = XLALComputeDopplerFstatMetric ( &pars2, edat )) != NULL, XLAL_EFUNC );
+
+    GPMAT( metricAdP->g_ij, "%0.8e" );
+    GPMAT( metricFnP->g_ij, "%0.8e" );
+
+    // compare metrics against each other:
+    XLAL_CHECK ( (diff_fn_ad = XLALCompareMetrics ( metricFnP->g_ij, metricAdP->g_ij )) < tolFixedNode, XLAL_ETOL, "Error(gFn,gAd)= %e exceeds tolerance of %e\n", diff_fn_ad, tolFixedNode );
+    XLALPrintWarning ("g:    diff_fn_ad = %e, maxrelerr = %e\n", diff_fn_ad, metricFnP->maxrelerr );
+    XLAL_CHECK ( (diff_fn_ad = XLALCompareMetrics ( metricFnF->gF_ij, metricAdF->gF_ij )) < tolFixedNode, XLAL_ETOL, "Error(gFFn,gFAd)= %e exceeds tolerance of %e\n", diff_fn_ad, tolFixedNode );
+    XLALPrintWarning ("gF:   diff_fn_ad = %e, maxrelerr = %e\n", diff_fn_ad, metricFnF->maxrelerr );
+    XLAL_CHECK ( (diff_fn_ad = XLALCompareMetrics ( metricFnF->gFav_ij, metricAdF->gFav_ij )) < tolFixedNode, XLAL_ETOL, "Error(gFavFn,gFavAd)= %e exceeds tolerance of %e\n", diff_fn_ad, tolFixedNode );
+    XLALPrintWarning ("gFav: diff_fn_ad = %e\n", diff_fn_ad );
+
+    XLALDestroyDopplerPhaseMetric ( metricAdP );
+    XLALDestroyDopplerPhaseMetric ( metricFnP );
+    XLALDestroyDopplerFstatMetric ( metricAdF );
+    XLALDestroyDopplerFstatMetric ( metricFnF );
+    XLALSegListClear ( &NsegList );
+  }
+
+
   // ----- clean up memory
   XLALSegListClear ( &segList );
   XLALDestroyEphemerisData ( edat );
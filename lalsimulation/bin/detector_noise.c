@@ -173,6 +173,7 @@ int main(int argc, char *argv[])
 	size_t n;
 	REAL8FrequencySeries *psd = NULL;
 	REAL8TimeSeries *seg = NULL;
+	LALSimNoiseGenerator *gen = NULL;
 	gsl_rng *rng;
 
 	XLALSetErrorHandler(XLALAbortErrorHandler);
@@ -236,7 +237,8 @@ int main(int argc, char *argv[])
 
 	n = duration * srate;
 	seg = XLALCreateREAL8TimeSeries("STRAIN", &tstart, 0.0, 1.0/srate, &lalStrainUnit, length);
-	XLALSimNoise(seg, 0, psd, rng); // first time to initialize
+	gen = XLALSimNoiseGeneratorCreate(length, &psd, 1);
+	XLALSimNoiseGeneratorNext(gen, &seg, 0, rng); // first time to initialize
 	fprintf(stdout, "# time (s)\tNOISE (strain)\n");
 	while (1) { // infinite loop
 		size_t j;
@@ -246,10 +248,11 @@ int main(int argc, char *argv[])
 				goto end;
 			fprintf(stdout, "%s\t%.18e\n", XLALGPSToStr(tstr, XLALGPSAdd(&t, j * seg->deltaT)), seg->data->data[j]);
 		}
-		XLALSimNoise(seg, stride, psd, rng); // make more data
+		XLALSimNoiseGeneratorNext(gen, &seg, stride, rng); // make more data
 	}
 
 end:
+	XLALSimNoiseGeneratorDestroy(gen);
 	XLALDestroyREAL8TimeSeries(seg);
 	XLALDestroyREAL8FrequencySeries(psd);
 	LALCheckMemoryLeaks();
@@ -113,6 +113,7 @@ int main(int argc, char *argv[])
 	size_t i, n;
 	REAL8FrequencySeries *OmegaGW = NULL;
 	REAL8TimeSeries **seg = NULL;
+	LALSimSGWBGenerator *gen = NULL;
 	LIGOTimeGPS epoch;
 	gsl_rng *rng;
 
@@ -136,7 +137,8 @@ int main(int argc, char *argv[])
 	}
 	printf("\n");
 
-	XLALSimSGWB(seg, detectors, numDetectors, 0, OmegaGW, H0, rng); // first time to initilize
+	gen = XLALSimSGWBGeneratorCreate(detectors, numDetectors, length, OmegaGW, H0);
+	XLALSimSGWBGeneratorNext(gen, seg, 0, rng); // first time to initilize
 
 	while (1) { // infinite loop
 		size_t j;
@@ -149,10 +151,11 @@ int main(int argc, char *argv[])
 				printf("\t%.18e", seg[i]->data->data[j]);
 			printf("\n");
 		}
-		XLALSimSGWB(seg, detectors, numDetectors, stride, OmegaGW, H0, rng); // make more data
+		XLALSimSGWBGeneratorNext(gen, seg, stride, rng); // make more data
 	}
 
 end:
+	XLALSimSGWBGeneratorDestroy(gen);
 	for (i = 0; i < numDetectors; ++i)
 		XLALDestroyREAL8TimeSeries(seg[i]);
 	XLALFree(seg);
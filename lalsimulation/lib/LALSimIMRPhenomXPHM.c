@@ -31,6 +31,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef _OPENMP
 #define omp ignore
@@ -49,10 +50,56 @@
 #include "LALSimIMRPhenomXPHM.h"
 
 
+/*
+  Number of frequency points twisted up together.
+  The Euler angles, Wigner-d coefficients and transfer functions of a block are stored as structures of arrays
+  so that the loops over a block can be vectorised.
+*/
+#define TWISTUP_BLOCK_LENGTH 64
+
+/*
+  Euler angles of a block of frequency points, stored as a structure of arrays.
+  alpha enters the twisting up only through exp(i*alpha), beta through cos(beta/2) and sin(beta/2)
+  and epsilon through exp(-i*mprime*epsilon), so these are what is stored.
+*/
+typedef struct tagIMRPhenomXPHMEulerAngles {
+  UINT4 length;                                   /**< Number of frequency points in the block */
+  REAL8 Mf[TWISTUP_BLOCK_LENGTH];                 /**< Frequencies (geometric units) */
+  REAL8 cexp_i_alpha_re[TWISTUP_BLOCK_LENGTH];    /**< Real part of \f$e^{i \alpha}\f$ */
+  REAL8 cexp_i_alpha_im[TWISTUP_BLOCK_LENGTH];    /**< Imaginary part of \f$e^{i \alpha}\f$ */
+  REAL8 cBetah[TWISTUP_BLOCK_LENGTH];             /**< \f$\cos(\beta/2)\f$ */
+  REAL8 sBetah[TWISTUP_BLOCK_LENGTH];             /**< \f$\sin(\beta/2)\f$ */
+  REAL8 cexp_mi_epsilon_re[TWISTUP_BLOCK_LENGTH]; /**< Real part of \f$e^{-i m' \epsilon}\f$ */
+  REAL8 cexp_mi_epsilon_im[TWISTUP_BLOCK_LENGTH]; /**< Imaginary part of \f$e^{-i m' \epsilon}\f$ */
+} IMRPhenomXPHMEulerAngles;
+
+
+
+/* Euler angles of the non-precessing mode (l, mprime) for a block of frequencies. */
+static int IMRPhenomXPHM_EulerAnglesBlock(
+  IMRPhenomXPHMEulerAngles *angles,        /**< [out] Euler angles of the block */
+  const REAL8 *Mf,                         /**< Frequencies (geometric units) */
+  UINT4 length,                            /**< Number of frequencies, at most TWISTUP_BLOCK_LENGTH */
+  INT4 mprime,                             /**< Second index of the non-precessing (l,mprime) mode */
+  IMRPhenomXWaveformStruct *pWF,           /**< IMRPhenomX Waveform Struct */
+  IMRPhenomXPrecessionStruct *pPrec        /**< IMRPhenomXP Precession Struct */
+);
+
+/* Euler angles for a block of frequencies from the complex exponentials interpolated by the multibanding. */
+static int IMRPhenomXPHM_EulerAnglesBlockMB(
+  IMRPhenomXPHMEulerAngles *angles,        /**< [out] Euler angles of the block */
+  const REAL8 *Mf,                         /**< Frequencies (geometric units) */
+  const COMPLEX16 *cexp_i_alpha,           /**< \f$e^{i \alpha}\f$ at each frequency */
+  const COMPLEX16 *cexp_i_epsilon,         /**< \f$e^{i \epsilon}\f$ at each frequency */
+  const COMPLEX16 *cexp_i_betah,           /**< \f$e^{i \beta/2}\f$ at each frequency */
+  UINT4 length,                            /**< Number of frequencies, at most TWISTUP_BLOCK_LENGTH */
+  INT4 mprime                              /**< Second index of the non-precessing (l,mprime) mode */
+);
+
 /* Generic routine for twisting up higher multipole models */
 static int IMRPhenomXPHMTwistUp(
-  const REAL8 Mf,                           /**< Frequency (Hz) */
-  const COMPLEX16 hHM,                      /**< Underlying aligned-spin IMRPhenomXAS waveform*/
+  const COMPLEX16 *hHM,                     /**< Underlying aligned-spin IMRPhenomXHM waveform at each frequency of the block */
+  const IMRPhenomXPHMEulerAngles *angles,   /**< Euler angles of the block */
   IMRPhenomXWaveformStruct *pWF,            /**< IMRPhenomX Waveform Struct */
   IMRPhenomXPrecessionStruct *pPrec,        /**< IMRPhenomXP Precession Struct */
   INT4  ell,                                /**< l index of the (l,m) mode */
@@ -63,18 +110,18 @@ static int IMRPhenomXPHMTwistUp(
 
 /*
   Core twisting up routine for one single mode.
-  Twist the waveform in the precessing L-frame to the inertial J-frame for one frequency point.
-  This function will be inside a loop of frequencies insid a loop over mprime >0 up to l.
+  Twist the waveform in the precessing L-frame to the inertial J-frame for a block of frequency points.
+  This function will be inside a loop over blocks of frequencies inside a loop over mprime >0 up to l.
 */
 static int IMRPhenomXPHMTwistUpOneMode(
-  const REAL8 Mf,                          /**< Frequency (Mf geometric units) */
-  const COMPLEX16 hlmprime,                /**< Underlying aligned-spin IMRPhenomXHM waveform. The loop is with mprime positive, but the mode has to be the negative one for positive frequencies.*/
-  IMRPhenomXWaveformStruct *pWF,           /**< IMRPhenomX Waveform Struct */
+  const COMPLEX16 *hlmprime,               /**< Underlying aligned-spin IMRPhenomXHM waveform at each frequency of the block. The loop is with mprime positive, but the mode has to be the negative one for positive frequencies.*/
+  const IMRPhenomXPHMEulerAngles *angles,  /**< Euler angles of the block */
   IMRPhenomXPrecessionStruct *pPrec,       /**< IMRPhenomXP Precession Struct */
   UINT4  l,                                /**< l index of the (l,m) (non-)precessing mode */
   UINT4  mprime,                           /**< second index of the (l,mprime) non-precessing mode  */
   INT4   m,                                /**< second index of the (l,m) precessing mode */
-  COMPLEX16Sequence *hlminertial           /**< [out] hlm for one frequency in the inertial frame (precessing mode)  */
+  COMPLEX16 *hlmpos,                       /**< [out] hlm in the inertial J-frame, positive frequencies */
+  COMPLEX16 *hlmneg                        /**< [out] hlm in the inertial J-frame, negative frequencies */
 );
 
 
@@ -879,8 +926,9 @@ int XLALSimIMRPhenomXPHMFromModes(
        */
               
        
-       /* Variable to store the non-precessing waveform in one frequency point. */
-       COMPLEX16 hlmcoprec;
+       /* Euler angles of one block of frequency points. */
+       IMRPhenomXPHMEulerAngles angles;
+       REAL8 Mf_block[TWISTUP_BLOCK_LENGTH];
 
        /* No Multibanding for the angles. */
        if(pPrec->MBandPrecVersion == 0)
@@ -891,17 +939,21 @@ int XLALSimIMRPhenomXPHMFromModes(
          printf("\n****************************************************************\n");
          #endif
 
-         for (UINT4 idx = 0; idx < freqs->length; idx++)
+         /* Twist up the co-precessing waveform block by block. */
+         for (UINT4 idx = 0; idx < freqs->length; idx += TWISTUP_BLOCK_LENGTH)
          {
-           double Mf             = pWF->M_sec * freqs->data[idx];
-           hlmcoprec             = htildelm->data->data[idx + offset];  /* Co-precessing waveform for one freq point */
-           COMPLEX16 hplus       = 0.0;  /* h_+ */
-           COMPLEX16 hcross      = 0.0;  /* h_x */
+           UINT4 block_length = freqs->length - idx < TWISTUP_BLOCK_LENGTH ? freqs->length - idx : TWISTUP_BLOCK_LENGTH;
+           for (UINT4 k = 0; k < block_length; k++)
+           {
+             Mf_block[k] = pWF->M_sec * freqs->data[idx + k];
+           }
 
-           IMRPhenomXPHMTwistUp(Mf, hlmcoprec, pWF, pPrec, ell, emmprime, &hplus, &hcross);
+           status = IMRPhenomXPHM_EulerAnglesBlock(&angles, Mf_block, block_length, emmprime, pWF, pPrec);
+           XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "IMRPhenomXPHM_EulerAnglesBlock failed.");
 
-           (*hptilde)->data->data[idx + offset] += hplus;
-           (*hctilde)->data->data[idx + offset] += hcross;
+           status = IMRPhenomXPHMTwistUp(htildelm->data->data + idx + offset, &angles, pWF, pPrec, ell, emmprime,
+                                         (*hptilde)->data->data + idx + offset, (*hctilde)->data->data + idx + offset);
+           XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "IMRPhenomXPHMTwistUp failed.");
          }
        }
        else
@@ -1084,23 +1136,20 @@ int XLALSimIMRPhenomXPHMFromModes(
         #endif
 
          /************** TWISTING UP in the fine grid *****************/
-         for (UINT4 idx = 0; idx < fine_count; idx++)
+         for (UINT4 idx = 0; idx < fine_count; idx += TWISTUP_BLOCK_LENGTH)
          {
-           double Mf   = pWF->M_sec * (idx + offset)*pWF->deltaF;
-
-           hlmcoprec   = htildelm->data->data[idx + offset];  /* Co-precessing waveform */
-
-           COMPLEX16 hplus       = 0.0;  /* h_+ */
-           COMPLEX16 hcross      = 0.0;  /* h_x */
-
-           pPrec->cexp_i_alpha   = cexp_i_alpha[idx];
-           pPrec->cexp_i_epsilon = cexp_i_epsilon[idx];
-           pPrec->cexp_i_betah   = cexp_i_betah[idx];
+           UINT4 block_length = fine_count - idx < TWISTUP_BLOCK_LENGTH ? fine_count - idx : TWISTUP_BLOCK_LENGTH;
+           for (UINT4 k = 0; k < block_length; k++)
+           {
+             Mf_block[k] = pWF->M_sec * (idx + k + offset)*pWF->deltaF;
+           }
 
-           IMRPhenomXPHMTwistUp(Mf, hlmcoprec, pWF, pPrec, ell, emmprime, &hplus, &hcross);
+           status = IMRPhenomXPHM_EulerAnglesBlockMB(&angles, Mf_block, cexp_i_alpha + idx, cexp_i_epsilon + idx, cexp_i_betah + idx, block_length, emmprime);
+           XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "IMRPhenomXPHM_EulerAnglesBlockMB failed.");
 
-           (*hptilde)->data->data[idx + offset] += hplus;
-           (*hctilde)->data->data[idx + offset] += hcross;
+           status = IMRPhenomXPHMTwistUp(htildelm->data->data + idx + offset, &angles, pWF, pPrec, ell, emmprime,
+                                         (*hptilde)->data->data + idx + offset, (*hctilde)->data->data + idx + offset);
+           XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "IMRPhenomXPHMTwistUp failed.");
          }
 
          XLALDestroyREAL8Sequence(coarseFreqs);
@@ -1303,321 +1352,426 @@ static int IMRPhenomXPHM_hplushcross_from_modes(
 
 
 /*
-  Core twisting up routine to get hptilde and hctilde.
-  Twist one h_lmprime waveform in the precessing L-frame to the inertial J-frame for one frequency point
-  as described in section III of Precessing paper.
-  The explicit formula used implemented in this function correspond to eqs. E18, E19 in Precessing paper.
-  This function is used inside a loop over frequencies inside a loop over mprime >0 up to l.
+  Evaluate the Euler angles of the non-precessing mode (l, mprime) for a block of frequencies.
+  The angle models are evaluated point by point; the trigonometric functions of the angles are then
+  computed in vectorisable loops over the block.
 */
-static int IMRPhenomXPHMTwistUp(
-  const REAL8 Mf,                          /**< Frequency (Hz) */
-  const COMPLEX16 hlmprime,                /**< Underlying aligned-spin IMRPhenomXHM waveform. The loop is with mprime positive, but the mode has to be the negative one for positive frequencies.*/
+static int IMRPhenomXPHM_EulerAnglesBlock(
+  IMRPhenomXPHMEulerAngles *angles,        /**< [out] Euler angles of the block */
+  const REAL8 *Mf,                         /**< Frequencies (geometric units) */
+  UINT4 length,                            /**< Number of frequencies, at most TWISTUP_BLOCK_LENGTH */
+  INT4 mprime,                             /**< Second index of the non-precessing (l,mprime) mode */
   IMRPhenomXWaveformStruct *pWF,           /**< IMRPhenomX Waveform Struct */
-  IMRPhenomXPrecessionStruct *pPrec,       /**< IMRPhenomXP Precession Struct */
-  INT4  l,                                 /**< First index of the non-precessing (l,mprime) mode */
-  INT4  mprime,                            /**< Second index of the non-precessing (l,mprime) mode */
-  COMPLEX16 *hp,                           /**< [out] h_+ polarization \f$\tilde h_+\f$ */
-  COMPLEX16 *hc                            /**< [out] h_x polarization \f$\tilde h_x\f$ */
+  IMRPhenomXPrecessionStruct *pPrec        /**< IMRPhenomXP Precession Struct */
 )
 {
-  XLAL_CHECK(hp  != NULL, XLAL_EFAULT);
-  XLAL_CHECK(hc  != NULL, XLAL_EFAULT);
-
-  /* Euler angles */
-  double alpha       = 0.0;
-  double epsilon     = 0.0;
-
-  double cBetah      = 0.0;
-  double sBetah      = 0.0;
+  XLAL_CHECK(angles != NULL, XLAL_EFAULT);
+  XLAL_CHECK(Mf != NULL, XLAL_EFAULT);
+  XLAL_CHECK(length <= TWISTUP_BLOCK_LENGTH, XLAL_EINVAL, "Block length %u exceeds %u.", length, TWISTUP_BLOCK_LENGTH);
 
-  COMPLEX16 cexp_i_alpha, cexp_i_epsilon = 1;
+  REAL8 alpha[TWISTUP_BLOCK_LENGTH];
+  REAL8 epsilon[TWISTUP_BLOCK_LENGTH];
+  REAL8 *cBetah = angles->cBetah;
+  REAL8 *sBetah = angles->sBetah;
 
-  if(pPrec->MBandPrecVersion == 0) /* No multibanding for angles */
+  switch(pPrec->IMRPhenomXPrecVersion)
   {
-    switch(pPrec->IMRPhenomXPrecVersion)
+    case 101:    /* Post-Newtonian Euler angles. Single spin approximantion. See sections IV-B and IV-C in Precessing paper. */
+    case 102:    /* The different number 10i means different PN order. */
+    case 103:
+    case 104:
     {
-      case 101:    /* Post-Newtonian Euler angles. Single spin approximantion. See sections IV-B and IV-C in Precessing paper. */
-      case 102:    /* The different number 10i means different PN order. */
-      case 103:
-      case 104:
+      for(UINT4 k = 0; k < length; k++)
       {
-        Get_alpha_beta_epsilon(&alpha, &cBetah, &sBetah, &epsilon, mprime, Mf, pPrec, pWF);
-        break;
+        INT4 status = Get_alpha_beta_epsilon(&alpha[k], &cBetah[k], &sBetah[k], &epsilon[k], mprime, Mf[k], pPrec, pWF);
+        XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "Call to Get_alpha_beta_epsilon failed.");
       }
-      case 220:    /* Use MSA angles. See section IV-D in Precessing paper. */
-      case 221:
-      case 222:
-      case 223:
-      case 224:
+      break;
+    }
+    case 220:    /* Use MSA angles. See section IV-D in Precessing paper. */
+    case 221:
+    case 222:
+    case 223:
+    case 224:
+    {
+      /* Get the offset for the Euler angles alpha and epsilon. */
+      REAL8 alpha_offset_mprime = 0, epsilon_offset_mprime = 0;
+      Get_alpha_epsilon_offset(&alpha_offset_mprime, &epsilon_offset_mprime, mprime, pPrec);
+
+      for(UINT4 k = 0; k < length; k++)
       {
-        /* Get Euler angles. */
-        const double v        = cbrt (LAL_PI * Mf * (2.0 / mprime) );
+        const double v        = cbrt (LAL_PI * Mf[k] * (2.0 / mprime) );
         const vector vangles  = IMRPhenomX_Return_phi_zeta_costhetaL_MSA(v,pWF,pPrec);
-        double beta               = 0.0;
-
-        /* Get the offset for the Euler angles alpha and epsilon. */
-        REAL8 alpha_offset_mprime = 0, epsilon_offset_mprime = 0;
-        Get_alpha_epsilon_offset(&alpha_offset_mprime, &epsilon_offset_mprime, mprime, pPrec);
 
-        alpha       = vangles.x - alpha_offset_mprime;
-        epsilon     = vangles.y - epsilon_offset_mprime;
-
-        beta        = acos(vangles.z);
-        cBetah      = cos(beta/2.);
-        sBetah      = sin(beta/2.);
-
-        break;
+        alpha[k]   = vangles.x - alpha_offset_mprime;
+        epsilon[k] = vangles.y - epsilon_offset_mprime;
+        cBetah[k]  = vangles.z;
       }
-      default:
+
+      /* Half-angle formulae for beta = acos(cos(beta)) in [0, pi]. */
+      #pragma omp simd
+      for(UINT4 k = 0; k < length; k++)
       {
-        XLAL_ERROR(XLAL_EINVAL,"Error. IMRPhenomXPrecVersion not recognized. Recommended default is 223.\n");
-        break;
+        const REAL8 cosbeta = cBetah[k];
+        cBetah[k] = sqrt(0.5 * (1.0 + cosbeta));
+        sBetah[k] = sqrt(0.5 * (1.0 - cosbeta));
       }
+      break;
     }
-
-    cexp_i_alpha   = cexp(+I*alpha);
-
-    #if DEBUG == 1
-    // Used for writing angles to file in debug mode.
-    cexp_i_epsilon = cexp(+I*epsilon);
-    pPrec->cexp_i_betah = cBetah + I*sBetah;
-    #endif
-
-   } // End of no multibanding
-   else{ /*  For Multibanding  */
-     cexp_i_alpha   = pPrec->cexp_i_alpha;
-     cexp_i_epsilon = pPrec->cexp_i_epsilon;
-     cBetah = (pPrec->cexp_i_betah + 1./pPrec->cexp_i_betah)*0.5;
-     sBetah = (pPrec->cexp_i_betah - 1./pPrec->cexp_i_betah)*0.5/I;
-   } // End of Multibanding-specific
-
-  /* Useful powers of the Wigner coefficients */
-  REAL8 cBetah2 = cBetah * cBetah;
-  REAL8 cBetah3 = cBetah * cBetah2;
-  REAL8 cBetah4 = cBetah * cBetah3;
-  REAL8 cBetah5 = cBetah * cBetah4;
-  REAL8 cBetah6 = cBetah * cBetah5;
-  REAL8 cBetah7 = cBetah * cBetah6;
-  REAL8 cBetah8 = cBetah * cBetah7;
-
-  REAL8 sBetah2 = sBetah * sBetah;
-  REAL8 sBetah3 = sBetah * sBetah2;
-  REAL8 sBetah4 = sBetah * sBetah3;
-  REAL8 sBetah5 = sBetah * sBetah4;
-  REAL8 sBetah6 = sBetah * sBetah5;
-  REAL8 sBetah7 = sBetah * sBetah6;
-  REAL8 sBetah8 = sBetah * sBetah7;
-
-  /*
-      The following expressions for the Wigner-d coefficients correspond to those in appendix A of the Precessing paper.
-      They are the same expressions used in IMRPhenomXPHMTwistUpOneMode.
-  */
-
-  COMPLEX16 hp_sum  = 0;
-  COMPLEX16 hc_sum  = 0;
-
-  /* Sum over l = 2 modes */
-  if (l == 2 && mprime == 2){
-    /* Sum up contributions to \tilde{h}_+ and \tilde{h}_x */
-    /* Precompute powers of e^{i m alpha} */
-    COMPLEX16 cexp_2i_alpha     = cexp_i_alpha  * cexp_i_alpha;
-
-    COMPLEX16 cexp_mi_alpha     = 1.0 / cexp_i_alpha;
-    COMPLEX16 cexp_m2i_alpha    = cexp_mi_alpha * cexp_mi_alpha;
-
-    COMPLEX16 cexp_im_alpha_l2[5]  = {cexp_m2i_alpha, cexp_mi_alpha, 1.0, cexp_i_alpha, cexp_2i_alpha};
-
-    COMPLEX16 Y2mA[5] = {pPrec->Y2m2, pPrec->Y2m1, pPrec->Y20, pPrec->Y21, pPrec->Y22};
-
-    //                  d^2_{-2,2}    d^2_{-1,2}             d^2_{0,2}                   d^2_{1,2}       d^2_{2,2}
-    COMPLEX16 d22[5]   = {sBetah4, 2.0*cBetah*sBetah3, pPrec->sqrt6*sBetah2*cBetah2, 2.0*cBetah3*sBetah, cBetah4};
-    //                  d^2_{-2,-2}  d^2_{-1,-2}  d^2_{0,-2}  d^2_{1,-2}  d^2_{2,-2}
-    COMPLEX16 d2m2[5]  = {d22[4],    -d22[3],      d22[2],     -d22[1],     d22[0]}; /* Exploit symmetry d^2_{-m,-2} = (-1)^m d^2_{-m,2}. See eq. A2 of Precessing paper */
-
-    for(int m=-2; m<=2; m++)
+    default:
     {
-      /* Transfer functions, see eqs. 3.5-3.7 in Precessing paper */
-      COMPLEX16 A2m2emm  = cexp_im_alpha_l2[-m+2] * d2m2[m+2]  * Y2mA[m+2];
-      COMPLEX16 A22emmstar = cexp_im_alpha_l2[m+2] * d22[m+2] *  conj(Y2mA[m+2]);
-      hp_sum +=    A2m2emm + A22emmstar;
-      hc_sum += I*(A2m2emm - A22emmstar);
+      XLAL_ERROR(XLAL_EINVAL,"Error. IMRPhenomXPrecVersion not recognized. Recommended default is 223.\n");
+      break;
     }
   }
 
-  if (l == 2 && mprime == 1){
-    /* Sum up contributions to \tilde{h}_+ and \tilde{h}_x */
-    /* Precompute powers of e^{i m alpha} */
-    COMPLEX16 cexp_2i_alpha     = cexp_i_alpha  * cexp_i_alpha;
-
-    COMPLEX16 cexp_mi_alpha     = 1.0 / cexp_i_alpha;
-    COMPLEX16 cexp_m2i_alpha    = cexp_mi_alpha * cexp_mi_alpha;
-
-    COMPLEX16 cexp_im_alpha_l2[5]  = {cexp_m2i_alpha, cexp_mi_alpha, 1.0, cexp_i_alpha, cexp_2i_alpha};
-
-    COMPLEX16 Y2mA[5] = {pPrec->Y2m2, pPrec->Y2m1, pPrec->Y20, pPrec->Y21, pPrec->Y22};
-
-    //                    d^2_{-2,1}          d^2_{-1,1}                       d^2_{0,1}                                       d^2_{1,1}                        d^2_{2,1}
-    COMPLEX16 d21[5]   = {2.0*cBetah*sBetah3, 3.0*cBetah2*sBetah2 - sBetah4, pPrec->sqrt6*(cBetah3*sBetah - cBetah*sBetah3), cBetah2*(cBetah2 - 3.0*sBetah2), -2.0*cBetah3*sBetah};
-    //                  d^2_{-2,-1}  d^2_{-1,-1}  d^2_{0,-1}  d^2_{1,-1}  d^2_{2,-1}
-    COMPLEX16 d2m1[5]  = {-d21[4],   d21[3],     -d21[2],    d21[1],     -d21[0]}; /* Exploit symmetry d^2_{-m,-1} = -(-1)^m d^2_{m,1}.  See eq. A2 of Precessing paper.  */
-
-
-    for(int m=-2; m<=2; m++)
-    {
-      /* Transfer functions, see eqs. 3.5-3.7 in Precessing paper. */
-      COMPLEX16 A2m1emm  = cexp_im_alpha_l2[-m+2]  * d2m1[m+2]  * Y2mA[m+2];
-      COMPLEX16 A21emmstar = cexp_im_alpha_l2[m+2] * d21[m+2] *  conj(Y2mA[m+2]);
-      hp_sum +=    A2m1emm + A21emmstar;
-      hc_sum += I*(A2m1emm - A21emmstar);
-     }
-
+  #pragma omp simd
+  for(UINT4 k = 0; k < length; k++)
+  {
+    angles->Mf[k]                 = Mf[k];
+    angles->cexp_i_alpha_re[k]    = cos(alpha[k]);
+    angles->cexp_i_alpha_im[k]    = sin(alpha[k]);
+    angles->cexp_mi_epsilon_re[k] = cos(mprime * epsilon[k]);
+    angles->cexp_mi_epsilon_im[k] = -sin(mprime * epsilon[k]);
   }
+  angles->length = length;
 
-  /* Sum over l = 3 modes */
-  if (l == 3 && mprime == 3){
-    /* Sum up contributions to \tilde{h}_+ and \tilde{h}_x */
-    /* Precompute powers of e^{i m alpha} */
-    COMPLEX16 cexp_2i_alpha     = cexp_i_alpha  * cexp_i_alpha;
-    COMPLEX16 cexp_3i_alpha     = cexp_i_alpha  * cexp_2i_alpha;
-
-    COMPLEX16 cexp_mi_alpha     = 1.0 / cexp_i_alpha;
-    COMPLEX16 cexp_m2i_alpha    = cexp_mi_alpha * cexp_mi_alpha;
-    COMPLEX16 cexp_m3i_alpha    = cexp_mi_alpha * cexp_m2i_alpha;
-
-    COMPLEX16 cexp_im_alpha_l3[7]  = {cexp_m3i_alpha, cexp_m2i_alpha, cexp_mi_alpha, 1.0, cexp_i_alpha, cexp_2i_alpha, cexp_3i_alpha};
+  return XLAL_SUCCESS;
+}
 
-    COMPLEX16 Y3mA[7] = {pPrec->Y3m3, pPrec->Y3m2, pPrec->Y3m1, pPrec->Y30, pPrec->Y31, pPrec->Y32, pPrec->Y33};
 
-    //                  d^3_{-3,3}    d^3_{-2,3}                 d^3_{-1,3}                    d^3_{0,3}                         d^3_{1,3}                      d^3_{2,3}                   d^3_{3,3}
-    COMPLEX16 d33[7]   = {sBetah6, pPrec->sqrt6*cBetah*sBetah5, pPrec->sqrt15*cBetah2*sBetah4, 2.0*pPrec->sqrt5*cBetah3*sBetah3, pPrec->sqrt15*cBetah4*sBetah2, pPrec->sqrt6*cBetah5*sBetah, cBetah6};
-    //                  d^3_{-3,-3}  d^3_{-2,-3}  d^3_{-1,-3}  d^3_{0,-3}  d^3_{1,-3}  d^3_{2,-3}  d^3_{3,-3}
-    COMPLEX16 d3m3[7]  = {d33[6],    -d33[5],     d33[4],      -d33[3],    d33[2],     -d33[1],    d33[0]}; /* Exploit symmetry d^3_{-m,-3} = -(-1)^m d^3_{m,3}. See eq. A2 of Precessing paper. */
+/*
+  Fill a block of Euler angles from the complex exponentials interpolated by the multibanding of the angles.
+  The exponentials are built by iterated products (eq. 2.32 in arXiv:2001.10897) and can drift slightly off the unit circle,
+  so they are inverted exactly rather than conjugated, as in the scalar code this replaces.
+*/
+static int IMRPhenomXPHM_EulerAnglesBlockMB(
+  IMRPhenomXPHMEulerAngles *angles,        /**< [out] Euler angles of the block */
+  const REAL8 *Mf,                         /**< Frequencies (geometric units) */
+  const COMPLEX16 *cexp_i_alpha,           /**< \f$e^{i \alpha}\f$ at each frequency */
+  const COMPLEX16 *cexp_i_epsilon,         /**< \f$e^{i \epsilon}\f$ at each frequency */
+  const COMPLEX16 *cexp_i_betah,           /**< \f$e^{i \beta/2}\f$ at each frequency */
+  UINT4 length,                            /**< Number of frequencies, at most TWISTUP_BLOCK_LENGTH */
+  INT4 mprime                              /**< Second index of the non-precessing (l,mprime) mode */
+)
+{
+  XLAL_CHECK(angles != NULL, XLAL_EFAULT);
+  XLAL_CHECK(length <= TWISTUP_BLOCK_LENGTH, XLAL_EINVAL, "Block length %u exceeds %u.", length, TWISTUP_BLOCK_LENGTH);
 
-    for(int m=-3; m<=3; m++)
+  for(UINT4 k = 0; k < length; k++)
+  {
+    angles->Mf[k]              = Mf[k];
+    angles->cexp_i_alpha_re[k] = creal(cexp_i_alpha[k]);
+    angles->cexp_i_alpha_im[k] = cimag(cexp_i_alpha[k]);
+
+    /* cos(beta/2) = Re[(z + 1/z)/2] and sin(beta/2) = Re[(z - 1/z)/(2i)] with z = exp(i*beta/2). */
+    const REAL8 x = creal(cexp_i_betah[k]);
+    const REAL8 y = cimag(cexp_i_betah[k]);
+    const REAL8 inorm2 = 1.0 / (x*x + y*y);
+    angles->cBetah[k] = 0.5 * x * (1.0 + inorm2);
+    angles->sBetah[k] = 0.5 * y * (1.0 + inorm2);
+
+    /* exp(-i*mprime*epsilon) = 1/exp(i*epsilon)^mprime */
+    COMPLEX16 exp_imprime_epsilon = cexp_i_epsilon[k];
+    for(INT4 i = 1; i < mprime; i++)
     {
-      /* Transfer functions */
-      COMPLEX16 A3m3emm  = cexp_im_alpha_l3[-m+3]  * d3m3[m+3]  * Y3mA[m+3];
-      COMPLEX16 A33emmstar   = cexp_im_alpha_l3[m+3] * d33[m+3] *  conj(Y3mA[m+3]);
-      hp_sum +=    A3m3emm - A33emmstar;
-      hc_sum += I*(A3m3emm + A33emmstar);
+      exp_imprime_epsilon *= cexp_i_epsilon[k];
     }
+    const REAL8 er = creal(exp_imprime_epsilon);
+    const REAL8 ei = cimag(exp_imprime_epsilon);
+    const REAL8 enorm2 = er*er + ei*ei;
+    angles->cexp_mi_epsilon_re[k] = er / enorm2;
+    angles->cexp_mi_epsilon_im[k] = -ei / enorm2;
   }
+  angles->length = length;
 
-  /* Sum over l = 3 modes */
-  if (l == 3 && mprime == 2){
-    /* Sum up contributions to \tilde{h}_+ and \tilde{h}_x */
-    /* Precompute powers of e^{i m alpha} */
-    COMPLEX16 cexp_2i_alpha     = cexp_i_alpha  * cexp_i_alpha;
-    COMPLEX16 cexp_3i_alpha     = cexp_i_alpha  * cexp_2i_alpha;
-
-    COMPLEX16 cexp_mi_alpha     = 1.0 / cexp_i_alpha;
-    COMPLEX16 cexp_m2i_alpha    = cexp_mi_alpha * cexp_mi_alpha;
-    COMPLEX16 cexp_m3i_alpha    = cexp_mi_alpha * cexp_m2i_alpha;
-
-    COMPLEX16 cexp_im_alpha_l3[7]  = {cexp_m3i_alpha, cexp_m2i_alpha, cexp_mi_alpha, 1.0, cexp_i_alpha, cexp_2i_alpha, cexp_3i_alpha};
-
-    COMPLEX16 Y3mA[7] = {pPrec->Y3m3, pPrec->Y3m2, pPrec->Y3m1, pPrec->Y30, pPrec->Y31, pPrec->Y32, pPrec->Y33};
-
-    //                    d^3_{-3,2}                     d^3_{-2,2}                     d^3_{-1,21}                                            d^3_{0,2}                                         d^3_{1,2}                                              d^3_{2,2}                        d^3_{3,2}
-    COMPLEX16 d32[7]   = {pPrec->sqrt6*cBetah*sBetah5, sBetah4*(5.0*cBetah2 - sBetah2), pPrec->sqrt10*sBetah3*(2.0*cBetah3 - cBetah*sBetah2), pPrec->sqrt30*cBetah2*(cBetah2 - sBetah2)*sBetah2, pPrec->sqrt10*cBetah3*(cBetah2*sBetah - 2.0*sBetah3), cBetah4*(cBetah2 - 5.0*sBetah2), -1.0*pPrec->sqrt6*cBetah5*sBetah};
-    //                  d^3_{-3,-2}  d^3_{-2,-2}  d^3_{-1,-2}  d^3_{0,-2}  d^3_{1,-2}  d^3_{2,-2}  d^3_{3,-2}
-    COMPLEX16 d3m2[7]  = {-d32[6],   d32[5],      -d32[4],     d32[3],     -d32[2],    d32[1],     -d32[0]}; /* Exploit symmetry d^3_{-m,-2} = (-1)^m d^3_{m,2}. See eq. A2 of Precessing paper.  */
+  return XLAL_SUCCESS;
+}
 
 
-    for(int m=-3; m<=3; m++)
+/*
+  Wigner-d coefficients d^l_{m,mprime}(beta), m = -l...l, for a block of Euler angles. Row m+l of d holds d^l_{m,mprime}.
+  The expressions correspond to those in appendix A of the Precessing paper.
+  The coefficients d^l_{m,-mprime} follow from the symmetry d^l_{m,-mprime} = (-1)^(m+mprime) d^l_{-m,mprime}, eq. A2 of Precessing paper.
+  Modes (l,mprime) without coefficients here do not contribute to the twisting up and get zero coefficients.
+*/
+static void IMRPhenomXPHM_WignerdBlock(
+  REAL8 d[][TWISTUP_BLOCK_LENGTH],          /**< [out] Wigner-d coefficients, 2l+1 rows */
+  const IMRPhenomXPHMEulerAngles *angles,   /**< Euler angles of the block */
+  INT4 l,                                   /**< First index of the non-precessing (l,mprime) mode */
+  INT4 mprime,                              /**< Second index of the non-precessing (l,mprime) mode */
+  const IMRPhenomXPrecessionStruct *pPrec   /**< IMRPhenomXP Precession Struct */
+)
+{
+  const UINT4 length = angles->length;
+  const REAL8 *cBetah = angles->cBetah;
+  const REAL8 *sBetah = angles->sBetah;
+
+  const REAL8 sqrt2  = pPrec->sqrt2;
+  const REAL8 sqrt5  = pPrec->sqrt5;
+  const REAL8 sqrt6  = pPrec->sqrt6;
+  const REAL8 sqrt7  = pPrec->sqrt7;
+  const REAL8 sqrt10 = pPrec->sqrt10;
+  const REAL8 sqrt14 = pPrec->sqrt14;
+  const REAL8 sqrt15 = pPrec->sqrt15;
+  const REAL8 sqrt30 = pPrec->sqrt30;
+  const REAL8 sqrt70 = pPrec->sqrt70;
+
+  switch(10*l + mprime)
+  {
+    case 22:
     {
-      /* Transfer functions, see eqs. 3.5-3.7 in Precessing paper. */
-      COMPLEX16 A3m2emm  =  cexp_im_alpha_l3[-m+3]  * d3m2[m+3] * Y3mA[m+3];
-      COMPLEX16 A32emmstar  =  cexp_im_alpha_l3[m+3] * d32[m+3] *  conj(Y3mA[m+3]);
-      hp_sum +=    A3m2emm - A32emmstar;
-      hc_sum += I*(A3m2emm + A32emmstar);
+      #pragma omp simd
+      for(UINT4 k = 0; k < length; k++)
+      {
+        const REAL8 c1 = cBetah[k], c2 = c1*c1, c3 = c1*c2, c4 = c1*c3;
+        const REAL8 s1 = sBetah[k], s2 = s1*s1, s3 = s1*s2, s4 = s1*s3;
+        d[0][k] = s4;                 /* d^2_{-2,2} */
+        d[1][k] = 2.0*c1*s3;          /* d^2_{-1,2} */
+        d[2][k] = sqrt6*s2*c2;        /* d^2_{0,2}  */
+        d[3][k] = 2.0*c3*s1;          /* d^2_{1,2}  */
+        d[4][k] = c4;                 /* d^2_{2,2}  */
+      }
+      break;
+    }
+    case 21:
+    {
+      #pragma omp simd
+      for(UINT4 k = 0; k < length; k++)
+      {
+        const REAL8 c1 = cBetah[k], c2 = c1*c1, c3 = c1*c2;
+        const REAL8 s1 = sBetah[k], s2 = s1*s1, s3 = s1*s2, s4 = s1*s3;
+        d[0][k] = 2.0*c1*s3;                 /* d^2_{-2,1} */
+        d[1][k] = 3.0*c2*s2 - s4;            /* d^2_{-1,1} */
+        d[2][k] = sqrt6*(c3*s1 - c1*s3);     /* d^2_{0,1}  */
+        d[3][k] = c2*(c2 - 3.0*s2);          /* d^2_{1,1}  */
+        d[4][k] = -2.0*c3*s1;                /* d^2_{2,1}  */
+      }
+      break;
+    }
+    case 33:
+    {
+      #pragma omp simd
+      for(UINT4 k = 0; k < length; k++)
+      {
+        const REAL8 c1 = cBetah[k], c2 = c1*c1, c3 = c1*c2, c4 = c1*c3, c5 = c1*c4, c6 = c1*c5;
+        const REAL8 s1 = sBetah[k], s2 = s1*s1, s3 = s1*s2, s4 = s1*s3, s5 = s1*s4, s6 = s1*s5;
+        d[0][k] = s6;                 /* d^3_{-3,3} */
+        d[1][k] = sqrt6*c1*s5;        /* d^3_{-2,3} */
+        d[2][k] = sqrt15*c2*s4;       /* d^3_{-1,3} */
+        d[3][k] = 2.0*sqrt5*c3*s3;    /* d^3_{0,3}  */
+        d[4][k] = sqrt15*c4*s2;       /* d^3_{1,3}  */
+        d[5][k] = sqrt6*c5*s1;        /* d^3_{2,3}  */
+        d[6][k] = c6;                 /* d^3_{3,3}  */
+      }
+      break;
+    }
+    case 32:
+    {
+      #pragma omp simd
+      for(UINT4 k = 0; k < length; k++)
+      {
+        const REAL8 c1 = cBetah[k], c2 = c1*c1, c3 = c1*c2, c4 = c1*c3, c5 = c1*c4;
+        const REAL8 s1 = sBetah[k], s2 = s1*s1, s3 = s1*s2, s4 = s1*s3, s5 = s1*s4;
+        d[0][k] = sqrt6*c1*s5;                     /* d^3_{-3,2} */
+        d[1][k] = s4*(5.0*c2 - s2);                /* d^3_{-2,2} */
+        d[2][k] = sqrt10*s3*(2.0*c3 - c1*s2);      /* d^3_{-1,2} */
+        d[3][k] = sqrt30*c2*(c2 - s2)*s2;          /* d^3_{0,2}  */
+        d[4][k] = sqrt10*c3*(c2*s1 - 2.0*s3);      /* d^3_{1,2}  */
+        d[5][k] = c4*(c2 - 5.0*s2);                /* d^3_{2,2}  */
+        d[6][k] = -1.0*sqrt6*c5*s1;                /* d^3_{3,2}  */
+      }
+      break;
+    }
+    case 44:
+    {
+      #pragma omp simd
+      for(UINT4 k = 0; k < length; k++)
+      {
+        const REAL8 c1 = cBetah[k], c2 = c1*c1, c3 = c1*c2, c4 = c1*c3, c5 = c1*c4, c6 = c1*c5, c7 = c1*c6, c8 = c1*c7;
+        const REAL8 s1 = sBetah[k], s2 = s1*s1, s3 = s1*s2, s4 = s1*s3, s5 = s1*s4, s6 = s1*s5, s7 = s1*s6, s8 = s1*s7;
+        d[0][k] = s8;                   /* d^4_{-4,4} */
+        d[1][k] = 2.0*sqrt2*c1*s7;      /* d^4_{-3,4} */
+        d[2][k] = 2.0*sqrt7*c2*s6;      /* d^4_{-2,4} */
+        d[3][k] = 2.0*sqrt14*c3*s5;     /* d^4_{-1,4} */
+        d[4][k] = sqrt70*c4*s4;         /* d^4_{0,4}  */
+        d[5][k] = 2.0*sqrt14*c5*s3;     /* d^4_{1,4}  */
+        d[6][k] = 2.0*sqrt7*c6*s2;      /* d^4_{2,4}  */
+        d[7][k] = 2.0*sqrt2*c7*s1;      /* d^4_{3,4}  */
+        d[8][k] = c8;                   /* d^4_{4,4}  */
+      }
+      break;
+    }
+    case 43:    /* This is only used when twisting PhenomHM. */
+    {
+      #pragma omp simd
+      for(UINT4 k = 0; k < length; k++)
+      {
+        const REAL8 c1 = cBetah[k], c2 = c1*c1, c3 = c1*c2, c4 = c1*c3, c5 = c1*c4, c6 = c1*c5, c7 = c1*c6, c8 = c1*c7;
+        const REAL8 s1 = sBetah[k], s2 = s1*s1, s3 = s1*s2, s4 = s1*s3, s5 = s1*s4, s6 = s1*s5, s7 = s1*s6, s8 = s1*s7;
+        d[0][k] = 2*sqrt2*c1*s7;                                  /* d^4_{-4,3} */
+        d[1][k] = 7*c2*s6 - s8;                                   /* d^4_{-3,3} */
+        d[2][k] = sqrt14*(3*c3*s5 - c1*s7);                       /* d^4_{-2,3} */
+        d[3][k] = sqrt7*(5*c4*s4 - 3*c2*s6);                      /* d^4_{-1,3} */
+        d[4][k] = 2*5.916079783099616*(c5*s3 - c3*s5);            /* d^4_{0,3}  */
+        d[5][k] = sqrt7*(3*c6*s2 - 5*c4*s4);                      /* d^4_{1,3}  */
+        d[6][k] = sqrt14*(c7*s1 - 3*c5*s3);                       /* d^4_{2,3}  */
+        d[7][k] = c8 - 7*c6*s2;                                   /* d^4_{3,3}  */
+        d[8][k] = -2.*sqrt2*c7*s1;                                /* d^4_{4,3}  */
+      }
+      break;
+    }
+    default:
+    {
+      for(INT4 j = 0; j <= 2*l; j++)
+      {
+        memset(d[j], 0, length * sizeof(REAL8));
+      }
+      break;
     }
-
   }
+}
 
-  /* Sum over l = 4 modes */
-  if (l == 4 && mprime == 4){
-    /* Sum up contributions to \tilde{h}_+ and \tilde{h}_x */
-    /* Precompute powers of e^{i m alpha} */
-    COMPLEX16 cexp_2i_alpha     = cexp_i_alpha  * cexp_i_alpha;
-    COMPLEX16 cexp_3i_alpha     = cexp_i_alpha  * cexp_2i_alpha;
-    COMPLEX16 cexp_4i_alpha     = cexp_i_alpha  * cexp_3i_alpha;
-
-    COMPLEX16 cexp_mi_alpha     = 1.0 / cexp_i_alpha;
-    COMPLEX16 cexp_m2i_alpha    = cexp_mi_alpha * cexp_mi_alpha;
-    COMPLEX16 cexp_m3i_alpha    = cexp_mi_alpha * cexp_m2i_alpha;
-    COMPLEX16 cexp_m4i_alpha    = cexp_mi_alpha * cexp_m3i_alpha;
-
-    COMPLEX16 cexp_im_alpha_l4[9]  = {cexp_m4i_alpha, cexp_m3i_alpha, cexp_m2i_alpha, cexp_mi_alpha, 1.0, cexp_i_alpha, cexp_2i_alpha, cexp_3i_alpha, cexp_4i_alpha};
 
-    COMPLEX16 Y4mA[9] = {pPrec->Y4m4, pPrec->Y4m3, pPrec->Y4m2, pPrec->Y4m1, pPrec->Y40, pPrec->Y41, pPrec->Y42, pPrec->Y43, pPrec->Y44};
+/* Powers exp(i*m*alpha), m = -l...l, for a block of Euler angles. Row m+l holds exp(i*m*alpha). */
+static void IMRPhenomXPHM_AlphaPowersBlock(
+  REAL8 cexp_im_alpha_re[][TWISTUP_BLOCK_LENGTH],  /**< [out] Real parts, 2l+1 rows */
+  REAL8 cexp_im_alpha_im[][TWISTUP_BLOCK_LENGTH],  /**< [out] Imaginary parts, 2l+1 rows */
+  const IMRPhenomXPHMEulerAngles *angles,          /**< Euler angles of the block */
+  INT4 l                                           /**< Maximum |m| */
+)
+{
+  const UINT4 length = angles->length;
 
-    //                    d^4_{-4,4}         d^4_{-3,4}               d^4_{-2,4}                         d^4_{-1,4}                          d^4_{0,4}                       d^4_{1,4}                           d^4_{2,4}                          d^4_{3,4}                  d^4_{44}
-    COMPLEX16 d44[9]   = {sBetah8, 2.0*pPrec->sqrt2*cBetah*sBetah7, 2.0*pPrec->sqrt7*cBetah2*sBetah6, 2.0*pPrec->sqrt14*cBetah3*sBetah5, pPrec->sqrt70*cBetah4*sBetah4, 2.0*pPrec->sqrt14*cBetah5*sBetah3, 2.0*pPrec->sqrt7*cBetah6*sBetah2, 2.0*pPrec->sqrt2*cBetah7*sBetah, cBetah8};
-      //                  d^4_{4,-4}  d^4_{-3,-4}  d^4_{-2,-4}  d^4_{-1,-4}  d^4_{0,-4}  d^4_{1,-4}  d^4_{2,-4}  d^4_{3,-4}  d^4_{4-4}
-    COMPLEX16 d4m4[9]  = {d44[8],     -d44[7],     d44[6],      -d44[5],     d44[4],    -d44[3],     d44[2],     -d44[1],    d44[0]}; /* Exploit symmetry d^4_{-m,-4} = (-1)^m d^4_{m,4}. See eq. A2 of Precessing paper.  */
+  #pragma omp simd
+  for(UINT4 k = 0; k < length; k++)
+  {
+    const REAL8 x = angles->cexp_i_alpha_re[k];
+    const REAL8 y = angles->cexp_i_alpha_im[k];
+    const REAL8 inorm2 = 1.0 / (x*x + y*y);
+    cexp_im_alpha_re[l][k]   = 1.0;
+    cexp_im_alpha_im[l][k]   = 0.0;
+    cexp_im_alpha_re[l+1][k] = x;
+    cexp_im_alpha_im[l+1][k] = y;
+    cexp_im_alpha_re[l-1][k] = x * inorm2;
+    cexp_im_alpha_im[l-1][k] = -y * inorm2;
+  }
 
-    for(int m=-4; m<=4; m++)
+  for(INT4 m = 2; m <= l; m++)
+  {
+    const REAL8 *pr = cexp_im_alpha_re[l+1], *pi = cexp_im_alpha_im[l+1];
+    const REAL8 *mr = cexp_im_alpha_re[l-1], *mi = cexp_im_alpha_im[l-1];
+    #pragma omp simd
+    for(UINT4 k = 0; k < length; k++)
     {
-      /* Transfer functions, see eqs. 3.5-3.7 in Precessing paper. */
-      COMPLEX16 A4m4emm  =  cexp_im_alpha_l4[-m+4]  * d4m4[m+4]  * Y4mA[m+4];
-      COMPLEX16 A44emmstar  =  cexp_im_alpha_l4[m+4] * d44[m+4] *  conj(Y4mA[m+4]);
-      hp_sum +=    A4m4emm + A44emmstar;
-      hc_sum += I*(A4m4emm - A44emmstar);
+      const REAL8 ar = cexp_im_alpha_re[l+m-1][k], ai = cexp_im_alpha_im[l+m-1][k];
+      const REAL8 br = cexp_im_alpha_re[l-m+1][k], bi = cexp_im_alpha_im[l-m+1][k];
+      cexp_im_alpha_re[l+m][k] = ar*pr[k] - ai*pi[k];
+      cexp_im_alpha_im[l+m][k] = ar*pi[k] + ai*pr[k];
+      cexp_im_alpha_re[l-m][k] = br*mr[k] - bi*mi[k];
+      cexp_im_alpha_im[l-m][k] = br*mi[k] + bi*mr[k];
     }
   }
+}
 
-  /* Sum over l = 4 modes. This is only used when twisting PhenomHM. */
-  if (l == 4 && mprime == 3){
-    /* Sum up contributions to \tilde{h}_+ and \tilde{h}_x */
-    /* Precompute powers of e^{i m alpha} */
-    COMPLEX16 cexp_2i_alpha     = cexp_i_alpha  * cexp_i_alpha;
-    COMPLEX16 cexp_3i_alpha     = cexp_i_alpha  * cexp_2i_alpha;
-    COMPLEX16 cexp_4i_alpha     = cexp_i_alpha  * cexp_3i_alpha;
-
-    COMPLEX16 cexp_mi_alpha     = 1.0 / cexp_i_alpha;
-    COMPLEX16 cexp_m2i_alpha    = cexp_mi_alpha * cexp_mi_alpha;
-    COMPLEX16 cexp_m3i_alpha    = cexp_mi_alpha * cexp_m2i_alpha;
-    COMPLEX16 cexp_m4i_alpha    = cexp_mi_alpha * cexp_m3i_alpha;
-
-    COMPLEX16 cexp_im_alpha_l4[9]  = {cexp_m4i_alpha, cexp_m3i_alpha, cexp_m2i_alpha, cexp_mi_alpha, 1.0, cexp_i_alpha, cexp_2i_alpha, cexp_3i_alpha, cexp_4i_alpha};
 
-    COMPLEX16 Y4mA[9] = {pPrec->Y4m4, pPrec->Y4m3, pPrec->Y4m2, pPrec->Y4m1, pPrec->Y40, pPrec->Y41, pPrec->Y42, pPrec->Y43, pPrec->Y44};
+/*
+  Core twisting up routine to get hptilde and hctilde.
+  Twist one h_lmprime waveform in the precessing L-frame to the inertial J-frame for a block of frequency points
+  as described in section III of Precessing paper, adding the result to hp and hc.
+  The explicit formula implemented in this function correspond to eqs. E18, E19 in Precessing paper.
+  This function is used inside a loop over blocks of frequencies inside a loop over mprime >0 up to l.
+*/
+static int IMRPhenomXPHMTwistUp(
+  const COMPLEX16 *hlmprime,               /**< Underlying aligned-spin IMRPhenomXHM waveform at each frequency of the block. The loop is with mprime positive, but the mode has to be the negative one for positive frequencies.*/
+  const IMRPhenomXPHMEulerAngles *angles,  /**< Euler angles of the block */
+  UNUSED IMRPhenomXWaveformStruct *pWF,    /**< IMRPhenomX Waveform Struct */
+  IMRPhenomXPrecessionStruct *pPrec,       /**< IMRPhenomXP Precession Struct */
+  INT4  l,                                 /**< First index of the non-precessing (l,mprime) mode */
+  INT4  mprime,                            /**< Second index of the non-precessing (l,mprime) mode */
+  COMPLEX16 *hp,                           /**< [out] h_+ polarization \f$\tilde h_+\f$, added to */
+  COMPLEX16 *hc                            /**< [out] h_x polarization \f$\tilde h_x\f$, added to */
+)
+{
+  XLAL_CHECK(hlmprime != NULL, XLAL_EFAULT);
+  XLAL_CHECK(hp  != NULL, XLAL_EFAULT);
+  XLAL_CHECK(hc  != NULL, XLAL_EFAULT);
+  XLAL_CHECK(l >= 2 && l <= L_MAX, XLAL_EINVAL, "l = %i not supported.", l);
 
-    //                    d^4_{-4,3}         d^4_{-3,3}               d^4_{-2,3}                         d^4_{-1,3}                          d^4_{0,3}                       d^4_{1,3}                           d^4_{2,3}                          d^4_{3,3}                  d^4_{43}
-    COMPLEX16 d43[9]   = {2*pPrec->sqrt2*cBetah*sBetah7, 7*cBetah2*sBetah6-sBetah8, pPrec->sqrt14*(3*cBetah3*sBetah5-cBetah*sBetah7), pPrec->sqrt7*(5*cBetah4*sBetah4-3*cBetah2*sBetah6), 2*5.916079783099616*(cBetah5*sBetah3-cBetah3*sBetah5), pPrec->sqrt7*(3*cBetah6*sBetah2-5*cBetah4*sBetah4), pPrec->sqrt14*(cBetah7*sBetah-3*cBetah5*sBetah3), cBetah8-7*cBetah6*sBetah2, -2.*pPrec->sqrt2*cBetah7*sBetah};
-      //                  d^4_{4,-3}  d^4_{-3,-3}  d^4_{-2,-3}  d^4_{-1,-3}  d^4_{0,-3}  d^4_{1,-3}  d^4_{2,-3}  d^4_{3,-3}  d^4_{4-3}
-    COMPLEX16 d4m3[9]  = {-d43[8],     d43[7],     -d43[6],      d43[5],     -d43[4],    d43[3],     -d43[2],     d43[1],    -d43[0]}; /* Exploit symmetry d^4_{-m,-3} = -(-1)^m d^4_{m,3}. See eq. A2 of Precessing paper.  */
+  const UINT4 length = angles->length;
 
-    for(int m=-4; m<=4; m++)
+  /* Spherical harmonics Y_lm(thetaJN, 0), m = -l...l */
+  COMPLEX16 YlmA[2*L_MAX+1];
+  switch(l)
+  {
+    case 2:
     {
-      /* Transfer functions, see eqs. 3.5-3.7 in Precessing paper. */
-      COMPLEX16 A4m3emm  =  cexp_im_alpha_l4[-m+4]  * d4m3[m+4]  * Y4mA[m+4];
-      COMPLEX16 A43emmstar  =  cexp_im_alpha_l4[m+4] * d43[m+4] *  conj(Y4mA[m+4]);
-      hp_sum +=    A4m3emm + A43emmstar;
-      hc_sum += I*(A4m3emm - A43emmstar);
+      COMPLEX16 Y2mA[5] = {pPrec->Y2m2, pPrec->Y2m1, pPrec->Y20, pPrec->Y21, pPrec->Y22};
+      memcpy(YlmA, Y2mA, sizeof(Y2mA));
+      break;
+    }
+    case 3:
+    {
+      COMPLEX16 Y3mA[7] = {pPrec->Y3m3, pPrec->Y3m2, pPrec->Y3m1, pPrec->Y30, pPrec->Y31, pPrec->Y32, pPrec->Y33};
+      memcpy(YlmA, Y3mA, sizeof(Y3mA));
+      break;
+    }
+    default:
+    {
+      COMPLEX16 Y4mA[9] = {pPrec->Y4m4, pPrec->Y4m3, pPrec->Y4m2, pPrec->Y4m1, pPrec->Y40, pPrec->Y41, pPrec->Y42, pPrec->Y43, pPrec->Y44};
+      memcpy(YlmA, Y4mA, sizeof(Y4mA));
+      break;
     }
   }
 
-  COMPLEX16 eps_phase_hP_lmprime;
+  REAL8 d[2*L_MAX+1][TWISTUP_BLOCK_LENGTH];
+  REAL8 cexp_im_alpha_re[2*L_MAX+1][TWISTUP_BLOCK_LENGTH];
+  REAL8 cexp_im_alpha_im[2*L_MAX+1][TWISTUP_BLOCK_LENGTH];
+  IMRPhenomXPHM_WignerdBlock(d, angles, l, mprime, pPrec);
+  IMRPhenomXPHM_AlphaPowersBlock(cexp_im_alpha_re, cexp_im_alpha_im, angles, l);
+
+  REAL8 hp_sum_re[TWISTUP_BLOCK_LENGTH] = {0}, hp_sum_im[TWISTUP_BLOCK_LENGTH] = {0};
+  REAL8 hc_sum_re[TWISTUP_BLOCK_LENGTH] = {0}, hc_sum_im[TWISTUP_BLOCK_LENGTH] = {0};
 
-  if(pPrec->MBandPrecVersion == 0) // No multibanding
+  /* The contributions of A_{l,-mprime,m} and A_{l,mprime,m}^* enter h_+ and h_x with relative sign (-1)^l. */
+  const REAL8 minus1l = (l % 2 == 0) ? 1.0 : -1.0;
+
+  for(INT4 m = -l; m <= l; m++)
   {
-     eps_phase_hP_lmprime = cexp(-1.*mprime*I*epsilon) * hlmprime / 2.0;
-  }
-  else{          // With multibanding
-    COMPLEX16 exp_imprime_epsilon = cexp_i_epsilon;
-    for(INT4 i=1; i<mprime; i++)
+    /* d^l_{m,-mprime} = (-1)^(m+mprime) d^l_{-m,mprime}. See eq. A2 of Precessing paper. */
+    const REAL8 minus1mmprime = ((m + mprime + 2*L_MAX) % 2 == 0) ? 1.0 : -1.0;
+    const REAL8 Yr = creal(YlmA[m+l]), Yi = cimag(YlmA[m+l]);
+    const REAL8 *dneg = d[l-m], *dpos = d[l+m];
+    const REAL8 *enr = cexp_im_alpha_re[l-m], *eni = cexp_im_alpha_im[l-m];
+    const REAL8 *epr = cexp_im_alpha_re[l+m], *epi = cexp_im_alpha_im[l+m];
+
+    #pragma omp simd
+    for(UINT4 k = 0; k < length; k++)
     {
-      exp_imprime_epsilon *= cexp_i_epsilon;
+      /* Transfer functions, see eqs. 3.5-3.7 in Precessing paper:
+         A_{l,-mprime,m} = e^{-i m alpha} d^l_{m,-mprime} Y_lm and A_{l,mprime,m}^* = e^{i m alpha} d^l_{m,mprime} Y_lm^* */
+      const REAL8 dn = minus1mmprime * dneg[k];
+      const REAL8 Ar = dn * (enr[k]*Yr - eni[k]*Yi);
+      const REAL8 Ai = dn * (enr[k]*Yi + eni[k]*Yr);
+      const REAL8 Br = minus1l * dpos[k] * (epr[k]*Yr + epi[k]*Yi);
+      const REAL8 Bi = minus1l * dpos[k] * (epi[k]*Yr - epr[k]*Yi);
+      hp_sum_re[k] += Ar + Br;
+      hp_sum_im[k] += Ai + Bi;
+      hc_sum_re[k] -= Ai - Bi;
+      hc_sum_im[k] += Ar - Br;
     }
-    eps_phase_hP_lmprime = 1./exp_imprime_epsilon * hlmprime / 2.0;
   }
 
+  for(UINT4 k = 0; k < length; k++)
+  {
+    /* e^{-i mprime epsilon} h_lmprime / 2 */
+    const REAL8 hr = 0.5 * creal(hlmprime[k]), hi = 0.5 * cimag(hlmprime[k]);
+    const REAL8 er = angles->cexp_mi_epsilon_re[k], ei = angles->cexp_mi_epsilon_im[k];
+    const REAL8 pr = er*hr - ei*hi, pi = er*hi + ei*hr;
 
-  /* Return h_+ and h_x */
-  *hp += eps_phase_hP_lmprime * hp_sum;
-  *hc += eps_phase_hP_lmprime * hc_sum;
+    hp[k] += (pr*hp_sum_re[k] - pi*hp_sum_im[k]) + I*(pr*hp_sum_im[k] + pi*hp_sum_re[k]);
+    hc[k] += (pr*hc_sum_re[k] - pi*hc_sum_im[k]) + I*(pr*hc_sum_im[k] + pi*hc_sum_re[k]);
+  }
 
   #if DEBUG == 1
   /* Save angles in output file.  */
@@ -1634,7 +1788,11 @@ static int IMRPhenomXPHMTwistUp(
   }
   fileangle = fopen(fileSpec,"a");
 
-  fprintf(fileangle, "%.16e  %.16e  %.16e  %.16e  %.16e  %.16e  %.16e\n",  XLALSimIMRPhenomXUtilsMftoHz(Mf, pWF->Mtot), creal(cexp_i_alpha), cimag(cexp_i_alpha), creal(cexp_i_epsilon), cimag(cexp_i_epsilon), creal(pPrec->cexp_i_betah), cimag(pPrec->cexp_i_betah));
+  /* Columns: f (Hz), e^{i alpha}, e^{-i mprime epsilon}, cos(beta/2), sin(beta/2). */
+  for(UINT4 k = 0; k < length; k++)
+  {
+    fprintf(fileangle, "%.16e  %.16e  %.16e  %.16e  %.16e  %.16e  %.16e\n",  XLALSimIMRPhenomXUtilsMftoHz(angles->Mf[k], pWF->Mtot), angles->cexp_i_alpha_re[k], angles->cexp_i_alpha_im[k], angles->cexp_mi_epsilon_re[k], angles->cexp_mi_epsilon_im[k], angles->cBetah[k], angles->sBetah[k]);
+  }
   fclose(fileangle);
   #endif
 
@@ -2089,17 +2247,26 @@ static int IMRPhenomXPHM_OneMode(
        }
      }
      else{
-       /* Loop over frequencies. Only where waveform is non zero. */
-       for (UINT4 idx = 0; idx < freqs->length; idx++)
+       /* Euler angles of one block of frequency points. */
+       IMRPhenomXPHMEulerAngles angles;
+       REAL8 Mf_block[TWISTUP_BLOCK_LENGTH];
+
+       /* Loop over blocks of frequencies. Only where waveform is non zero. */
+       for (UINT4 idx = 0; idx < freqs->length; idx += TWISTUP_BLOCK_LENGTH)
        {
-          REAL8 Mf = pWF->M_sec*freqs->data[idx];
-          hlmcoprec  = htildelm->data->data[idx + offset];  /* Co-precessing waveform */
-          COMPLEX16Sequence *hlm;
-          hlm = XLALCreateCOMPLEX16Sequence(2);
-          IMRPhenomXPHMTwistUpOneMode(Mf, hlmcoprec, pWF, pPrec, ell, emmprime, m, hlm);
-          (*hlmpos)->data->data[idx + offset] += hlm->data[0];     // Positive frequencies. Freqs do 0, df, 2df, ...., fmax
-          (*hlmneg)->data->data[idx + offset] += hlm->data[1];     // Negative frequencies. Freqs do 0, -df, -2df, ...., -fmax
-          XLALDestroyCOMPLEX16Sequence(hlm);
+          UINT4 block_length = freqs->length - idx < TWISTUP_BLOCK_LENGTH ? freqs->length - idx : TWISTUP_BLOCK_LENGTH;
+          for (UINT4 k = 0; k < block_length; k++)
+          {
+            Mf_block[k] = pWF->M_sec*freqs->data[idx + k];
+          }
+
+          status = IMRPhenomXPHM_EulerAnglesBlock(&angles, Mf_block, block_length, emmprime, pWF, pPrec);
+          XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "IMRPhenomXPHM_EulerAnglesBlock failed.");
+
+          /* Positive frequencies go to hlmpos (0, df, 2df, ...., fmax), negative frequencies to hlmneg (0, -df, -2df, ...., -fmax). */
+          status = IMRPhenomXPHMTwistUpOneMode(htildelm->data->data + idx + offset, &angles, pPrec, ell, emmprime, m,
+                                               (*hlmpos)->data->data + idx + offset, (*hlmneg)->data->data + idx + offset);
+          XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC, "IMRPhenomXPHMTwistUpOneMode failed.");
         }
      }
 
@@ -2128,176 +2295,52 @@ return XLAL_SUCCESS;
 
 /*
   Core twisting up routine to get one single precessing mode.
-  Twist the waveform in the precessing L-frame to the inertial J-frame for one frequency point.
-  This function will be inside a loop of frequencies insid a loop over the non-precessing modes.
+  Twist the waveform in the precessing L-frame to the inertial J-frame for a block of frequency points,
+  adding the result to the positive and negative frequency parts of the (l,m) mode.
   It carries out the operation specified in eqs. E3-E4 in the Precessing paper.
+  This function will be inside a loop over blocks of frequencies inside a loop over the non-precessing modes.
 */
 static int IMRPhenomXPHMTwistUpOneMode(
-  const REAL8 Mf,                          /**< Frequency (Mf geometric units) */
-  const COMPLEX16 hlmprime,                /**< Underlying aligned-spin IMRPhenomXHM waveform. The loop is with mprime positive, but the mode has to be the negative one for positive frequencies.*/
-  IMRPhenomXWaveformStruct *pWF,           /**< IMRPhenomX Waveform Struct */
+  const COMPLEX16 *hlmprime,               /**< Underlying aligned-spin IMRPhenomXHM waveform at each frequency of the block. The loop is with mprime positive, but the mode has to be the negative one for positive frequencies.*/
+  const IMRPhenomXPHMEulerAngles *angles,  /**< Euler angles of the block */
   IMRPhenomXPrecessionStruct *pPrec,       /**< IMRPhenomXP Precession Struct */
   UINT4  l,                                /**< l index of the (l,m) (non-)precessing mode */
   UINT4  mprime,                           /**< second index of the (l,mprime) non-precessing mode  */
   INT4   m,                                /**< second index of the (l,m) precessing mode */
-  COMPLEX16Sequence *hlminertial           /**< [out] hlm in the inertial J-frame for one frequency point, precessing waveform  */
+  COMPLEX16 *hlmpos,                       /**< [out] hlm in the inertial J-frame, positive frequencies, added to */
+  COMPLEX16 *hlmneg                        /**< [out] hlm in the inertial J-frame, negative frequencies, added to */
 )
 {
-  XLAL_CHECK(hlminertial  != NULL, XLAL_EFAULT);
-
-  /* Euler angles */
-  double alpha       = 0.0;
-  double epsilon     = 0.0;
-
-  double cBetah      = 0.0;
-  double sBetah      = 0.0;
-
-
-  switch(pPrec->IMRPhenomXPrecVersion)
+  XLAL_CHECK(hlmprime != NULL, XLAL_EFAULT);
+  XLAL_CHECK(hlmpos != NULL, XLAL_EFAULT);
+  XLAL_CHECK(hlmneg != NULL, XLAL_EFAULT);
+  XLAL_CHECK(l >= 2 && l <= L_MAX, XLAL_EINVAL, "l = %u not supported.", l);
+  XLAL_CHECK(abs(m) <= (INT4)l, XLAL_EINVAL, "m = %i not supported for l = %u.", m, l);
+
+  const UINT4 length = angles->length;
+
+  REAL8 d[2*L_MAX+1][TWISTUP_BLOCK_LENGTH];
+  REAL8 cexp_im_alpha_re[2*L_MAX+1][TWISTUP_BLOCK_LENGTH];
+  REAL8 cexp_im_alpha_im[2*L_MAX+1][TWISTUP_BLOCK_LENGTH];
+  IMRPhenomXPHM_WignerdBlock(d, angles, l, mprime, pPrec);
+  IMRPhenomXPHM_AlphaPowersBlock(cexp_im_alpha_re, cexp_im_alpha_im, angles, l);
+
+  /* d^l_{m,-mprime} = (-1)^(m+mprime) d^l_{-m,mprime}. See eq. A2 of Precessing paper. */
+  const REAL8 minus1mmprime = ((m + (INT4)mprime + 2*L_MAX) % 2 == 0) ? 1.0 : -1.0;
+  const REAL8 minus1l = (l % 2 == 0) ? 1.0 : -1.0;
+  const REAL8 *dneg = d[(INT4)l-m], *dpos = d[(INT4)l+m];
+  const REAL8 *enr = cexp_im_alpha_re[(INT4)l-m], *eni = cexp_im_alpha_im[(INT4)l-m];
+
+  for(UINT4 k = 0; k < length; k++)
   {
-    case 101:        /* Post-Newtonian Euler angles. Single spin approximantion. See sections IV-B and IV-C in Precessing paper. */
-    case 102:        /* The different number 10i means different PN order. */
-    case 103:
-    case 104:
-    {
-      /* NNLO PN Euler Angles */
-      Get_alpha_beta_epsilon(&alpha, &cBetah, &sBetah, &epsilon, mprime, Mf, pPrec, pWF);
-      break;
-    }
-    case 220:
-    case 221:
-    case 222:
-    case 223:
-    case 224:
-    {
-      /* ~~~~~ Euler Angles from Chatziioannou et al, PRD 95, 104004, (2017)  ~~~~~ */
-      const double v            = cbrt(LAL_PI * Mf * (2.0/mprime) );
-      const vector vangles      = IMRPhenomX_Return_phi_zeta_costhetaL_MSA(v,pWF,pPrec);
-      double beta               = 0.0;
-
-      REAL8 alpha_offset_mprime = 0, epsilon_offset_mprime = 0;
-      Get_alpha_epsilon_offset(&alpha_offset_mprime, &epsilon_offset_mprime, mprime, pPrec);
-
-      alpha    = vangles.x - alpha_offset_mprime;
-      epsilon  = vangles.y - epsilon_offset_mprime;
-      beta     = acos(vangles.z);
-
-
-      cBetah   = cos(beta/2.0);
-      sBetah   = sin(beta/2.0);
-
-      break;
-    }
-    default:
-    {
-      XLAL_ERROR(XLAL_EINVAL,"Error. IMRPhenomXPrecVersion not recognized. Recommended default is 223.\n");
-      break;
-    }
-  }
-
-
-  /* Useful powers of the Wigner coefficients */
-  REAL8 cBetah2 = cBetah * cBetah;
-  REAL8 cBetah3 = cBetah * cBetah2;
-  REAL8 cBetah4 = cBetah * cBetah3;
-  REAL8 cBetah5 = cBetah * cBetah4;
-  REAL8 cBetah6 = cBetah * cBetah5;
-  REAL8 cBetah7 = cBetah * cBetah6;
-  REAL8 cBetah8 = cBetah * cBetah7;
-
-  REAL8 sBetah2 = sBetah * sBetah;
-  REAL8 sBetah3 = sBetah * sBetah2;
-  REAL8 sBetah4 = sBetah * sBetah3;
-  REAL8 sBetah5 = sBetah * sBetah4;
-  REAL8 sBetah6 = sBetah * sBetah5;
-  REAL8 sBetah7 = sBetah * sBetah6;
-  REAL8 sBetah8 = sBetah * sBetah7;
-
-  /*
-      The following expressions for the Wigner-d coefficients correspond to those in appendix A of the Precessing paper.
-      They are the same expressions used in IMRPhenomXPHMTwistUp.
-  */
-
-  COMPLEX16 hlm = 0, hlmneg = 0;
-  INT4 minus1l = 1;
-
-  /* Sum over l = 2 modes */
-  if (l == 2 && mprime == 2){
-    //                  d^2_{-2,2}    d^2_{-1,2}             d^2_{0,2}                   d^2_{1,2}       d^2_{2,2}
-    COMPLEX16 d22[5]   = {sBetah4, 2.0*cBetah*sBetah3, pPrec->sqrt6*sBetah2*cBetah2, 2.0*cBetah3*sBetah, cBetah4};
-    //                  d^2_{-2,-2}  d^2_{-1,-2}  d^2_{0,-2}  d^2_{1,-2}    d^2_{2,-2}
-    COMPLEX16 d2m2[5]  = {d22[4],    -d22[3],      d22[2],     -d22[1],     d22[0]}; /* Exploit symmetry d^2_{-m,-2} = (-1)^m d^2_{-m,2}. See eq. A2 of Precessing paper */
-
     /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
-    hlm += cexp_im_alpha * d2m2[m+2];
-    hlmneg += cexp_im_alpha * d22[m+2];
-  }
+    const COMPLEX16 cexp_im_alpha = enr[k] + I*eni[k];
+    const COMPLEX16 cexp_mimprime_epsilon = angles->cexp_mi_epsilon_re[k] + I*angles->cexp_mi_epsilon_im[k];
 
-  /* Case (l, mprime) = (2, 1) */
-  if (l == 2 && mprime == 1){
-    //                    d^2_{-2,1}          d^2_{-1,1}                       d^2_{0,1}                                       d^2_{1,1}                        d^2_{2,1}
-    COMPLEX16 d21[5]   = {2.0*cBetah*sBetah3, 3.0*sBetah2*cBetah2 - sBetah4, pPrec->sqrt6*(cBetah3*sBetah - cBetah*sBetah3), cBetah2*(cBetah2 - 3.0*sBetah2), -2.0*cBetah3*sBetah};
-    //                  d^2_{-2,-1}  d^2_{-1,-1}  d^2_{0,-1}  d^2_{1,-1}  d^2_{2,-1}
-    COMPLEX16 d2m1[5]  = {-d21[4],   d21[3],     -d21[2],    d21[1],     -d21[0]}; /* Exploit symmetry d^2_{-m,-1} = -(-1)^m d^2_{m,1}.  See eq. A2 of Precessing paper.  */
-
-    /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
-    hlm += cexp_im_alpha * d2m1[m+2];
-    hlmneg += cexp_im_alpha * d21[m+2];
+    hlmpos[k] += cexp_mimprime_epsilon * hlmprime[k] * cexp_im_alpha * (minus1mmprime * dneg[k]);
+    hlmneg[k] += conj(cexp_mimprime_epsilon) * minus1l * conj(hlmprime[k]) * cexp_im_alpha * dpos[k];
   }
 
-  /* Case (l, mprime) = (3, 3) */
-  if (l == 3 && mprime == 3){
-    minus1l = -1;
-    //                  d^3_{-3,3}    d^3_{-2,3}                 d^3_{-1,3}                    d^3_{0,3}                         d^3_{1,3}                      d^3_{2,3}                   d^3_{3,3}
-    COMPLEX16 d33[7]   = {sBetah6, pPrec->sqrt6*cBetah*sBetah5, pPrec->sqrt15*cBetah2*sBetah4, 2.0*pPrec->sqrt5*cBetah3*sBetah3, pPrec->sqrt15*cBetah4*sBetah2, pPrec->sqrt6*cBetah5*sBetah, cBetah6};
-    //                  d^3_{-3,-3}  d^3_{-2,-3}  d^3_{-1,-3}  d^3_{0,-3}  d^3_{1,-3}  d^3_{2,-3}  d^3_{3,-3}
-    COMPLEX16 d3m3[7]  = {d33[6],    -d33[5],     d33[4],      -d33[3],    d33[2],     -d33[1],    d33[0]}; /* Exploit symmetry d^3_{-m,-3} = -(-1)^m d^3_{m,3}. See eq. A2 of Precessing paper. */
-
-    /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
-    hlm += cexp_im_alpha * d3m3[m+3];
-    hlmneg += cexp_im_alpha * d33[m+3];
-  }
-
-  /* Case (l, mprime) = (3, 2) */
-  if (l == 3 && mprime == 2){
-    minus1l = -1;
-    //                    d^3_{-3,2}                     d^3_{-2,2}                     d^3_{-1,21}                                            d^3_{0,2}                                         d^3_{1,2}                                              d^3_{2,2}                        d^3_{3,2}
-    COMPLEX16 d32[7]   = {pPrec->sqrt6*cBetah*sBetah5, sBetah4*(5.0*cBetah2 - sBetah2), pPrec->sqrt10*sBetah3*(2.0*cBetah3 - cBetah*sBetah2), pPrec->sqrt30*cBetah2*(cBetah2 - sBetah2)*sBetah2, pPrec->sqrt10*cBetah3*(cBetah2*sBetah - 2.0*sBetah3), cBetah4*(cBetah2 - 5.0*sBetah2), -1.0*pPrec->sqrt6*cBetah5*sBetah};
-    //                  d^3_{-3,-2}  d^3_{-2,-2}  d^3_{-1,-2}  d^3_{0,-2}  d^3_{1,-2}  d^3_{2,-2}  d^3_{3,-2}
-    COMPLEX16 d3m2[7]  = {-d32[6],   d32[5],     -d32[4],      d32[3],     -d32[2],    d32[1],    -d32[0]}; /* Exploit symmetry d^3_{-m,-2} = (-1)^m d^3_{m,2}. See eq. A2 of Precessing paper.  */
-
-    /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
-    hlm += cexp_im_alpha * d3m2[m+3];
-    hlmneg += cexp_im_alpha * d32[m+3];
-  }
-
-  /* Case (l, mprime) = (4, 4) */
-  if (l == 4 && mprime == 4){
-    //                    d^4_{-4,4}         d^4_{-3,4}               d^4_{-2,4}                         d^4_{-1,4}                          d^4_{0,4}                       d^4_{1,4}                           d^4_{2,4}                          d^4_{3,4}                  d^4_{44}
-    COMPLEX16 d44[9]   = {sBetah8, 2.0*pPrec->sqrt2*cBetah*sBetah7, 2.0*pPrec->sqrt7*cBetah2*sBetah6, 2.0*pPrec->sqrt14*cBetah3*sBetah5, pPrec->sqrt70*cBetah4*sBetah4, 2.0*pPrec->sqrt14*cBetah5*sBetah3, 2.0*pPrec->sqrt7*cBetah6*sBetah2, 2.0*pPrec->sqrt2*cBetah7*sBetah, cBetah8};
-    //                  d^4_{4,-4}  d^4_{-3,-4}  d^4_{-2,-4}  d^4_{-1,-4}  d^4_{0,-4}  d^4_{1,-4}  d^4_{2,-4}  d^4_{3,-4}  d^4_{4-4}
-    COMPLEX16 d4m4[9]  = {d44[8],   -d44[7],      d44[6],     -d44[5],     d44[4],    -d44[3],     d44[2],    -d44[1],     d44[0]}; /* Exploit symmetry d^4_{-m,-4} = (-1)^m d^4_{m,4}. See eq. A2 of Precessing paper.  */
-
-    /* See eqs. E3-E4 in Precessing paper. */
-    COMPLEX16 cexp_im_alpha = cexp(-1.*I*m*alpha);
-    hlm += cexp_im_alpha * d4m4[m+4];
-    hlmneg += cexp_im_alpha * d44[m+4];
-  }
-
-  /* See eqs. E3-E4 in Precessing paper. */
-  COMPLEX16 exp_imprime_epsilon = cexp(mprime*I*epsilon);
-  COMPLEX16 eps_phase_hP_lmprime = 1./exp_imprime_epsilon * hlmprime;
-  COMPLEX16 eps_phase_hP_lmprime_neg = exp_imprime_epsilon * minus1l * conj(hlmprime);
-
- /* Return h_lminertail */
- (hlminertial)->data[0] = eps_phase_hP_lmprime * hlm;
- (hlminertial)->data[1] = eps_phase_hP_lmprime_neg * hlmneg;
-
-
   return XLAL_SUCCESS;
 }
 
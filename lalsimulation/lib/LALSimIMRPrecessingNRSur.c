@@ -250,12 +250,16 @@ static int PrecessingNRSur_Init(
         if (i < 3) {j = 2*i;} else {j = i+3;}
         snprintf(sub_name, 15, "ds_node_%d", j);
         sub = XLALH5GroupOpen(file, sub_name);
-        PrecessingNRSur_LoadDynamicsNode(ds_node_data, sub, i, PrecessingNRSurVersion);
+        if (PrecessingNRSur_LoadDynamicsNode(ds_node_data, sub, i, PrecessingNRSurVersion) != XLAL_SUCCESS) {
+            XLAL_ERROR(XLAL_EFUNC, "Failed to load dynamics node %d\n", j);
+        }
 
         if (i < 3) {
             snprintf(sub_name, 15, "ds_node_%d", j+1);
             sub = XLALH5GroupOpen(file, sub_name);
-            PrecessingNRSur_LoadDynamicsNode(ds_half_node_data, sub, i, PrecessingNRSurVersion);
+            if (PrecessingNRSur_LoadDynamicsNode(ds_half_node_data, sub, i, PrecessingNRSurVersion) != XLAL_SUCCESS) {
+                XLAL_ERROR(XLAL_EFUNC, "Failed to load dynamics node %d\n", j+1);
+            }
         }
     }
     XLALFree(sub_name);
@@ -270,7 +274,9 @@ static int PrecessingNRSur_Init(
     // Load coorbital waveform surrogate data
     WaveformFixedEllModeData **coorbital_mode_data = XLALMalloc( (NRSUR_LMAX - 1) * sizeof(*coorbital_mode_data) );
     for (int ell_idx=0; ell_idx < NRSUR_LMAX-1; ell_idx++) {
-        PrecessingNRSur_LoadCoorbitalEllModes(coorbital_mode_data, file, ell_idx);
+        if (PrecessingNRSur_LoadCoorbitalEllModes(coorbital_mode_data, file, ell_idx) != XLAL_SUCCESS) {
+            XLAL_ERROR(XLAL_EFUNC, "Failed to load coorbital modes with ell=%d\n", ell_idx+2);
+        }
     }
     data->coorbital_mode_data = coorbital_mode_data;
 
@@ -336,11 +342,179 @@ static void NRSur7dq4_LoadVectorFitData(
     }
 }
 
+/**
+ * Frees a PackedFitData struct.
+ */
+static void PrecessingNRSur_DestroyPackedFitData(
+    PackedFitData *packed   /**< Packed fits; may be NULL */
+) {
+    if (packed == NULL) return;
+    XLALFree(packed->fit_start);
+    XLALFree(packed->coefs);
+    XLALFree(packed->bfA_index);
+    XLALFree(packed->bfB_index);
+    XLALFree(packed);
+}
+
+/**
+ * Allocates a PackedFitData struct for n_fits fits with n_coefs terms in total.
+ */
+static PackedFitData *PrecessingNRSur_AllocPackedFitData(
+    int n_fits,     /**< Number of fits */
+    int n_coefs     /**< Total number of terms of all fits */
+) {
+    PackedFitData *packed = XLALCalloc(1, sizeof(PackedFitData));
+    if (packed == NULL) XLAL_ERROR_NULL(XLAL_ENOMEM);
+    packed->n_fits = n_fits;
+    packed->fit_start = XLALMalloc((n_fits + 1) * sizeof(int));
+    // Allocate at least one term, so that fits without terms are not mistaken for a failure
+    packed->coefs = XLALMalloc((n_coefs > 0 ? n_coefs : 1) * sizeof(REAL8));
+    packed->bfA_index = XLALMalloc((n_coefs > 0 ? n_coefs : 1) * sizeof(int));
+    packed->bfB_index = XLALMalloc((n_coefs > 0 ? n_coefs : 1) * sizeof(int));
+    if (packed->fit_start == NULL || packed->coefs == NULL
+            || packed->bfA_index == NULL || packed->bfB_index == NULL) {
+        PrecessingNRSur_DestroyPackedFitData(packed);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    packed->fit_start[0] = 0;
+    return packed;
+}
+
+/**
+ * Packs the terms of a fit as fit k of a PackedFitData struct.
+ * Fits 0, ..., k-1 must have been packed already. On failure, fit k is left
+ * with no terms.
+ */
+static int PrecessingNRSur_PackFitTerms(
+    PackedFitData *packed,      /**< Packed fits */
+    int k,                      /**< Index of the packed fit */
+    const gsl_vector *coefs,    /**< Coefficients of the fit. May be NULL if the fit has no terms. */
+    const gsl_matrix_long *orders,  /**< matrix of (n_coefs x 7) basis function orders of the fit */
+    const gsl_vector_long *componentIndices, /**< For NRSur7dq2 vector fits, the component of each term; NULL otherwise */
+    long component              /**< For NRSur7dq2 vector fits, the component to pack */
+) {
+    int n = packed->fit_start[k];
+    const size_t n_coefs = (coefs == NULL) ? 0 : coefs->size;
+    packed->fit_start[k+1] = n;
+
+    for (size_t i=0; i < n_coefs; i++) {
+        if (componentIndices != NULL && gsl_vector_long_get(componentIndices, i) != component) {
+            continue;
+        }
+
+        // Index of the product of basis functions in the mass ratio and chiA components
+        long order = gsl_matrix_long_get(orders, i, 0);
+        if (order < 0 || order >= NRSUR_FIT_Q_ORDERS) {
+            XLAL_ERROR(XLAL_EINVAL, "Mass ratio basis function order %ld out of range\n", order);
+        }
+        int bfA = order;
+        int bfB = 0;
+        for (int j=1; j<7; j++) {
+            order = gsl_matrix_long_get(orders, i, j);
+            if (order < 0 || order >= NRSUR_FIT_CHI_ORDERS) {
+                XLAL_ERROR(XLAL_EINVAL, "Spin basis function order %ld out of range\n", order);
+            }
+            if (j < 4) {
+                bfA = bfA * NRSUR_FIT_CHI_ORDERS + order;
+            } else {
+                // Index of the product of basis functions in the chiB components
+                bfB = bfB * NRSUR_FIT_CHI_ORDERS + order;
+            }
+        }
+
+        packed->coefs[n] = gsl_vector_get(coefs, i);
+        packed->bfA_index[n] = bfA;
+        packed->bfB_index[n] = bfB;
+        n++;
+    }
+
+    packed->fit_start[k+1] = n;
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Packs n_fits scalar fits into a PackedFitData struct.
+ */
+static PackedFitData *PrecessingNRSur_PackFits(
+    FitData **fit_data,     /**< The fits to pack */
+    int n_fits              /**< Number of fits */
+) {
+    int n_coefs = 0;
+    for (int k=0; k < n_fits; k++) {
+        n_coefs += fit_data[k]->n_coefs;
+    }
+
+    PackedFitData *packed = PrecessingNRSur_AllocPackedFitData(n_fits, n_coefs);
+    if (packed == NULL) XLAL_ERROR_NULL(XLAL_EFUNC);
+    for (int k=0; k < n_fits; k++) {
+        if (PrecessingNRSur_PackFitTerms(packed, k, fit_data[k]->coefs,
+                fit_data[k]->basisFunctionOrders, NULL, 0) != XLAL_SUCCESS) {
+            PrecessingNRSur_DestroyPackedFitData(packed);
+            XLAL_ERROR_NULL(XLAL_EFUNC, "Failed to pack fit %d\n", k);
+        }
+    }
+    return packed;
+}
+
+/**
+ * Packs all fits of a dynamics node, so that they can be evaluated in one pass
+ * during the ODE integration.
+ * The packed fits are omega, omega_copr, chiA_dot and chiB_dot, in that order.
+ */
+static int PrecessingNRSur_PackDynamicsNode(
+    DynamicsNodeFitData *ds_node,   /**< Dynamics node data */
+    UINT4 PrecessingNRSurVersion    /**< 0 for NRSur7dq2, 1 for NRSur7dq4 */
+) {
+    VectorFitData *vector_fits[3] = {ds_node->omega_copr_data,
+        ds_node->chiA_dot_data, ds_node->chiB_dot_data};
+    int v, i, k;
+
+    // Count the terms of all fits
+    int n_coefs = ds_node->omega_data->n_coefs;
+    for (v=0; v<3; v++) {
+        if (PrecessingNRSurVersion == 0) {
+            n_coefs += vector_fits[v]->n_coefs;
+        } else {
+            for (i=0; i < vector_fits[v]->vec_dim; i++) {
+                n_coefs += vector_fits[v]->fit_data[i]->n_coefs;
+            }
+        }
+    }
+
+    PackedFitData *packed = PrecessingNRSur_AllocPackedFitData(NRSUR_DS_NODE_N_FITS, n_coefs);
+    if (packed == NULL) XLAL_ERROR(XLAL_EFUNC);
+    int ret;
+    k = 0;
+    ret = PrecessingNRSur_PackFitTerms(packed, k++, ds_node->omega_data->coefs,
+            ds_node->omega_data->basisFunctionOrders, NULL, 0);
+    for (v=0; v<3 && ret == XLAL_SUCCESS; v++) {
+        for (i=0; i < vector_fits[v]->vec_dim && ret == XLAL_SUCCESS; i++) {
+            if (PrecessingNRSurVersion == 0) {
+                // NRSur7dq2 vector fits share their terms between components
+                ret = PrecessingNRSur_PackFitTerms(packed, k++, vector_fits[v]->coefs,
+                        vector_fits[v]->basisFunctionOrders,
+                        vector_fits[v]->componentIndices, i);
+            } else {
+                ret = PrecessingNRSur_PackFitTerms(packed, k++, vector_fits[v]->fit_data[i]->coefs,
+                        vector_fits[v]->fit_data[i]->basisFunctionOrders, NULL, 0);
+            }
+        }
+    }
+    if (ret != XLAL_SUCCESS) {
+        PrecessingNRSur_DestroyPackedFitData(packed);
+        XLAL_ERROR(XLAL_EFUNC, "Failed to pack fit %d of dynamics node\n", k-1);
+    }
+    assert(k == NRSUR_DS_NODE_N_FITS);
+
+    ds_node->packed_data = packed;
+    return XLAL_SUCCESS;
+}
+
 /**
  * Loads the data for a single dynamics node into a DynamicsNodeFitData struct.
  * This is only called during the initialization of the surrogate data through PrecessingNRSur_Init.
  */
-static void PrecessingNRSur_LoadDynamicsNode(
+static int PrecessingNRSur_LoadDynamicsNode(
     DynamicsNodeFitData **ds_node_data, /**< Entry i should be NULL; Will malloc space and load data into it. */
     LALH5File *sub,                     /**< Subgroup containing data for dynamics node i. */
     int i,                               /**< Dynamics node index. */
@@ -422,6 +596,11 @@ static void PrecessingNRSur_LoadDynamicsNode(
         NRSur7dq4_LoadVectorFitData(&chiB_dot_data, sub, "chiB", 3);
         ds_node_data[i]->chiB_dot_data = chiB_dot_data;
     }
+
+    if (PrecessingNRSur_PackDynamicsNode(ds_node_data[i], PrecessingNRSurVersion) != XLAL_SUCCESS) {
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+    return XLAL_SUCCESS;
 }
 
 
@@ -429,7 +608,7 @@ static void PrecessingNRSur_LoadDynamicsNode(
  * Load the WaveformFixedEllModeData from file for a single value of ell.
  * This is only called during the initialization of the surrogate data through PrecessingNRSur_Init.
  */
-static void PrecessingNRSur_LoadCoorbitalEllModes(
+static int PrecessingNRSur_LoadCoorbitalEllModes(
     WaveformFixedEllModeData **coorbital_mode_data, /**< Entry i should be NULL; will malloc space and load data into it.*/
     LALH5File *file, /**< The open hdf5 file */
     int i /**< The index of coorbital_mode_data. Equivalently, ell-2. */
@@ -444,12 +623,18 @@ static void PrecessingNRSur_LoadCoorbitalEllModes(
     // Real part of m=0 mode
     snprintf(sub_name, str_size, "hCoorb_%d_0_real", i+2);
     sub = XLALH5GroupOpen(file, sub_name);
-    PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->m0_real_data), false);
+    if (PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->m0_real_data), false) != XLAL_SUCCESS) {
+        XLALFree(sub_name);
+        XLAL_ERROR(XLAL_EFUNC, "Failed to load the m=0 mode with ell=%d\n", i+2);
+    }
 
     // Imag part of m=0 mode
     snprintf(sub_name, str_size, "hCoorb_%d_0_imag", i+2);
     sub = XLALH5GroupOpen(file, sub_name);
-    PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->m0_imag_data), false);
+    if (PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->m0_imag_data), false) != XLAL_SUCCESS) {
+        XLALFree(sub_name);
+        XLAL_ERROR(XLAL_EFUNC, "Failed to load the m=0 mode with ell=%d\n", i+2);
+    }
 
     // NOTE:
     // In the paper https://arxiv.org/abs/1705.07089, Eq. 16 uses
@@ -472,26 +657,39 @@ static void PrecessingNRSur_LoadCoorbitalEllModes(
     for (int m=1; m<=(i+2); m++) {
         snprintf(sub_name, str_size, "hCoorb_%d_%d_Re+", i+2, m);
         sub = XLALH5GroupOpen(file, sub_name);
-        PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->X_real_plus_data[m-1]), false);
+        if (PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->X_real_plus_data[m-1]), false) != XLAL_SUCCESS) {
+            XLALFree(sub_name);
+            XLAL_ERROR(XLAL_EFUNC, "Failed to load the m=%d mode with ell=%d\n", m, i+2);
+        }
         snprintf(sub_name, str_size, "hCoorb_%d_%d_Re-", i+2, m);
         sub = XLALH5GroupOpen(file, sub_name);
-        PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->X_real_minus_data[m-1]), true);
+        if (PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->X_real_minus_data[m-1]), true) != XLAL_SUCCESS) {
+            XLALFree(sub_name);
+            XLAL_ERROR(XLAL_EFUNC, "Failed to load the m=%d mode with ell=%d\n", m, i+2);
+        }
         snprintf(sub_name, str_size, "hCoorb_%d_%d_Im+", i+2, m);
         sub = XLALH5GroupOpen(file, sub_name);
-        PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->X_imag_plus_data[m-1]), true);
+        if (PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->X_imag_plus_data[m-1]), true) != XLAL_SUCCESS) {
+            XLALFree(sub_name);
+            XLAL_ERROR(XLAL_EFUNC, "Failed to load the m=%d mode with ell=%d\n", m, i+2);
+        }
         snprintf(sub_name, str_size, "hCoorb_%d_%d_Im-", i+2, m);
         sub = XLALH5GroupOpen(file, sub_name);
-        PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->X_imag_minus_data[m-1]), false);
+        if (PrecessingNRSur_LoadWaveformDataPiece(sub, &(mode_data->X_imag_minus_data[m-1]), false) != XLAL_SUCCESS) {
+            XLALFree(sub_name);
+            XLAL_ERROR(XLAL_EFUNC, "Failed to load the m=%d mode with ell=%d\n", m, i+2);
+        }
     }
     XLALFree(sub_name);
     coorbital_mode_data[i] = mode_data;
+    return XLAL_SUCCESS;
 }
 
 /**
  * Loads a single NRSur coorbital waveform data piece from file into a WaveformDataPiece.
  * This is only called during the initialization of the surrogate data through PrecessingNRSur_Init.
  */
-static void PrecessingNRSur_LoadWaveformDataPiece(
+static int PrecessingNRSur_LoadWaveformDataPiece(
     LALH5File *sub,             /**< HDF5 group containing data for this waveform data piece */
     WaveformDataPiece **data,   /**< Output - *data should be NULL. Space will be allocated. */
     bool invert_sign            /**< If true, multiply the empirical interpolation matrix by -1. */
@@ -527,6 +725,11 @@ static void PrecessingNRSur_LoadWaveformDataPiece(
         node_data->n_coefs = node_data->coefs->size;
         (*data)->fit_data[i] = node_data;
     }
+    XLALFree(sub_name);
+
+    (*data)->packed_fit_data = PrecessingNRSur_PackFits((*data)->fit_data, n_nodes);
+    if ((*data)->packed_fit_data == NULL) XLAL_ERROR(XLAL_EFUNC);
+    return XLAL_SUCCESS;
 }
 
 
@@ -604,49 +807,6 @@ REAL8 NRSur7dq2_eval_fit(
     return res;
 }
 
-/*
- * This is very similar to NRSur7dq2_eval_fit except that the result is a
- * 2d or 3d vector instead of a scalar. Each fit coefficient now applies to
- * just a single component of the result.
- */
-static void NRSur7dq2_eval_vector_fit(
-    REAL8 *res,            /**< Result */
-    VectorFitData *data,    /**< Data for fit */
-    REAL8 *x               /**< size 7, giving mass ratio q, and dimensionless spin components */
-) {
-    REAL8 x_powers[22]; // 3 per spin component, 4 for mass ratio
-    REAL8 prod;
-    int i, j;
-
-    // Initialize the result
-    for (i=0; i < data->vec_dim; i++) {
-        res[i] = 0.0;
-    }
-
-    // The fits were constructed using this rather than using q directly
-    REAL8 q_fit = NRSUR7DQ2_Q_FIT_OFFSET + NRSUR7DQ2_Q_FIT_SLOPE*x[0];
-
-    // Compute powers of components of x
-    for (i=0; i<22; i++) {
-        if (i%7==0) {
-            x_powers[i] = ipow(q_fit, i/7);
-        } else {
-            x_powers[i] = ipow(x[i%7], i/7);
-        }
-    }
-
-    // Sum up fit terms
-    for (i=0; i < data->n_coefs; i++) {
-        // Initialize with q basis function:
-        prod = x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, 0)];
-        // Multiply with spin basis functions:
-        for (j=1; j<7; j++) {
-            prod *= x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, j) + j];
-        }
-        res[gsl_vector_long_get(data->componentIndices, i)] += gsl_vector_get(data->coefs, i) * prod;
-    }
-}
-
 /*
  * Computes effective spins chiHat and chi_a.
  * chiHat is defined in Eq.(3) of 1508.07253.
@@ -725,23 +885,6 @@ REAL8 NRSur7dq4_eval_fit(
     return res;
 }
 
-/*
- * This is very similar to NRSur7dq4_eval_fit except that the result is a
- * 2d or 3d vector instead of a scalar. Each fit coefficient now applies to
- * just a single component of the result.
- */
-static void NRSur7dq4_eval_vector_fit(
-    REAL8 *res,            /**< Result */
-    VectorFitData *data,    /**< Data for fit */
-    REAL8 *x               /**< size 7, giving mass ratio q, and dimensionless spin components */
-) {
-    // loop over vector indices
-    for (int i=0; i < data->vec_dim; i++) {
-        res[i] = NRSur7dq4_eval_fit((*data).fit_data[i], x);
-    }
-}
-
-
 /*
  * Wrapper for NRSur7dq2_eval_fit and NRSur7dq4_eval_fit
  */
@@ -760,23 +903,120 @@ REAL8 PrecessingNRSur_eval_fit(
 }
 
 /*
- * Wrapper for NRSur7dq2_eval_vector_fit and NRSur7dq4_eval_vector_fit
+ * Computes the tables of products of basis functions used by packed fits.
+ * Entry ((k_0*3 + k_1)*3 + k_2)*3 + k_3 of bfA is the product of the basis
+ * functions of orders k_0 in the mass ratio and k_1, k_2, k_3 in the chiA
+ * components, and entry (k_4*3 + k_5)*3 + k_6 of bfB is the product of the
+ * basis functions of orders k_4, k_5, k_6 in the chiB components.
+ * These are the same basis functions as used by NRSur7dq2_eval_fit and
+ * NRSur7dq4_eval_fit.
  */
-static void PrecessingNRSur_eval_vector_fit(
-    REAL8 *res,            /**< Result */
-    VectorFitData *data,    /**< Data for fit */
-    REAL8 *x,               /**< size 7, giving mass ratio q, and dimensionless spin components */
-    PrecessingNRSurData *__sur_data   /**< Loaded surrogate data */
+static void PrecessingNRSur_fit_basis_products(
+    REAL8 *bfA,         /**< Output: NRSUR_FIT_BFA_SIZE products of mass ratio and chiA basis functions */
+    REAL8 *bfB,         /**< Output: NRSUR_FIT_BFB_SIZE products of chiB basis functions */
+    const REAL8 *x,     /**< size 7, giving mass ratio q, and dimensionless spin components */
+    UINT4 PrecessingNRSurVersion    /**< 0 for NRSur7dq2, 1 for NRSur7dq4 */
 ) {
-    if (__sur_data->PrecessingNRSurVersion == 0) {
-        return NRSur7dq2_eval_vector_fit(res, data, x);
-    } else if (__sur_data->PrecessingNRSurVersion == 1) {
-        return NRSur7dq4_eval_vector_fit(res, data, x);
+    REAL8 fit_params[7];
+    int i, j, k, l, n;
+
+    if (PrecessingNRSurVersion == 0) {
+        // The fits were constructed using this rather than using q directly
+        fit_params[0] = NRSUR7DQ2_Q_FIT_OFFSET + NRSUR7DQ2_Q_FIT_SLOPE*x[0];
+        for (i=1; i<7; i++) {
+            fit_params[i] = x[i];
+        }
+    } else if (PrecessingNRSurVersion == 1) {
+        // Convert from [q, chi1x, chi1y, chi1z, chi2x, chi2y, chi2z]
+        // to [f(log(q)), chi1x, chi1y, chiHat, chi2x, chi2y, chi_a]
+        REAL8 chiHat, chi_a;
+        NRSur7dq4_effective_spins(&chiHat, &chi_a, x[0], x[3], x[6]);
+        fit_params[0] = NRSUR7DQ4_Q_FIT_OFFSET + NRSUR7DQ4_Q_FIT_SLOPE*log(x[0]);
+        fit_params[1] = x[1];
+        fit_params[2] = x[2];
+        fit_params[3] = chiHat;
+        fit_params[4] = x[4];
+        fit_params[5] = x[5];
+        fit_params[6] = chi_a;
     } else {
         XLAL_ERROR_VOID(XLAL_FAILURE, "Only 0 or 1 are currently allowed for PrecessingNRSurVersion\n");
     }
+
+    // Compute powers of the fit parameters
+    REAL8 powers[7][NRSUR_FIT_Q_ORDERS];
+    for (i=0; i<7; i++) {
+        powers[i][0] = 1.0;
+        powers[i][1] = fit_params[i];
+        powers[i][2] = fit_params[i]*fit_params[i];
+    }
+    powers[0][3] = powers[0][2]*fit_params[0];
+
+    // Products of mass ratio and chiA basis functions
+    n = 0;
+    for (i=0; i<NRSUR_FIT_Q_ORDERS; i++) {
+        for (j=0; j<NRSUR_FIT_CHI_ORDERS; j++) {
+            const REAL8 prod_ij = powers[0][i] * powers[1][j];
+            for (k=0; k<NRSUR_FIT_CHI_ORDERS; k++) {
+                const REAL8 prod_ijk = prod_ij * powers[2][k];
+                for (l=0; l<NRSUR_FIT_CHI_ORDERS; l++) {
+                    bfA[n++] = prod_ijk * powers[3][l];
+                }
+            }
+        }
+    }
+
+    // Products of chiB basis functions
+    n = 0;
+    for (j=0; j<NRSUR_FIT_CHI_ORDERS; j++) {
+        for (k=0; k<NRSUR_FIT_CHI_ORDERS; k++) {
+            const REAL8 prod_jk = powers[4][j] * powers[5][k];
+            for (l=0; l<NRSUR_FIT_CHI_ORDERS; l++) {
+                bfB[n++] = prod_jk * powers[6][l];
+            }
+        }
+    }
 }
 
+/*
+ * Sums up the terms of packed fit k, given the tables of basis function products.
+ */
+static inline REAL8 PrecessingNRSur_sum_packed_fit(
+    const PackedFitData *data,  /**< Packed fits */
+    int k,                      /**< Index of the fit */
+    const REAL8 *bfA,           /**< Products of mass ratio and chiA basis functions */
+    const REAL8 *bfB            /**< Products of chiB basis functions */
+) {
+    const REAL8 *coefs = data->coefs;
+    const int *bfA_index = data->bfA_index;
+    const int *bfB_index = data->bfB_index;
+    const int start = data->fit_start[k];
+    const int end = data->fit_start[k+1];
+    REAL8 res = 0.0;
+
+    for (int i=start; i < end; i++) {
+        res += coefs[i] * bfA[bfA_index[i]] * bfB[bfB_index[i]];
+    }
+
+    return res;
+}
+
+/*
+ * Evaluates all packed fits at the same point.
+ * This is used to evaluate all fits at a dynamics node at once; the basis
+ * functions are only computed once, and are shared by all fits.
+ */
+static void PrecessingNRSur_eval_packed_fits(
+    REAL8 *res,                 /**< Result, one entry per packed fit */
+    const PackedFitData *data,  /**< Packed fits */
+    const REAL8 *x,             /**< size 7, giving mass ratio q, and dimensionless spin components */
+    PrecessingNRSurData *__sur_data  /**< Loaded surrogate data */
+) {
+    REAL8 bfA[NRSUR_FIT_BFA_SIZE], bfB[NRSUR_FIT_BFB_SIZE];
+    PrecessingNRSur_fit_basis_products(bfA, bfB, x, __sur_data->PrecessingNRSurVersion);
+    for (int k=0; k < data->n_fits; k++) {
+        res[k] = PrecessingNRSur_sum_packed_fit(data, k, bfA, bfB);
+    }
+}
 
 /* During the ODE integration, the norm of the spins will change due to
  * integration errors and fit modeling errors. Keep them normalized.
@@ -1126,16 +1366,10 @@ static void PrecessingNRSur_get_time_deriv_from_index(
         ds_node = __sur_data->ds_half_node_data[-1*i0 - 1];
     }
 
-    // Evaluate fits
-    REAL8 omega, Omega_coorb_xy[2], chiA_dot[3], chiB_dot[3];
-    omega = PrecessingNRSur_eval_fit(ds_node->omega_data, x, __sur_data);
-    PrecessingNRSur_eval_vector_fit(Omega_coorb_xy, ds_node->omega_copr_data,
-            x, __sur_data);
-    PrecessingNRSur_eval_vector_fit(chiA_dot, ds_node->chiA_dot_data,
-            x, __sur_data);
-    PrecessingNRSur_eval_vector_fit(chiB_dot, ds_node->chiB_dot_data,
-            x, __sur_data);
-    PrecessingNRSur_assemble_dydt(dydt, y, Omega_coorb_xy, omega, chiA_dot, chiB_dot);
+    // Evaluate fits: omega, Omega_coorb_xy[2], chiA_dot[3], chiB_dot[3]
+    REAL8 fits[NRSUR_DS_NODE_N_FITS];
+    PrecessingNRSur_eval_packed_fits(fits, ds_node->packed_data, x, __sur_data);
+    PrecessingNRSur_assemble_dydt(dydt, y, fits + 1, fits[0], fits + 3, fits + 6);
 }
 
 /**
@@ -1614,6 +1848,7 @@ static void PrecessingNRSur_eval_data_piece(
 
     gsl_vector *nodes = gsl_vector_alloc(data->n_nodes);
     REAL8 x[7];
+    REAL8 bfA[NRSUR_FIT_BFA_SIZE], bfB[NRSUR_FIT_BFB_SIZE];
     int i, j, node_index;
 
     // Evaluate the fits at the empirical nodes, using the spins at the empirical node times
@@ -1624,7 +1859,8 @@ static void PrecessingNRSur_eval_data_piece(
             x[1+j] = gsl_vector_get(chiA[j], node_index);
             x[4+j] = gsl_vector_get(chiB[j], node_index);
         }
-        gsl_vector_set(nodes, i, PrecessingNRSur_eval_fit(data->fit_data[i], x, __sur_data));
+        PrecessingNRSur_fit_basis_products(bfA, bfB, x, __sur_data->PrecessingNRSurVersion);
+        gsl_vector_set(nodes, i, PrecessingNRSur_sum_packed_fit(data->packed_fit_data, i, bfA, bfB));
     }
 
     // Evaluate the empirical interpolant
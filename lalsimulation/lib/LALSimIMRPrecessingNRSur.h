@@ -69,6 +69,19 @@ static const double NRSUR7DQ4_START_TIME = -4299.99999999; // The first time nod
 
 static const int NRSUR_LMAX = 4;
 
+// Fits are polynomials of order at most 3 in the mass ratio, and at most 2 in
+// each spin component. Packed fits look up the product of the basis functions
+// of each term in two tables, one over the mass ratio and chiA orders, and one
+// over the chiB orders.
+#define NRSUR_FIT_Q_ORDERS 4
+#define NRSUR_FIT_CHI_ORDERS 3
+#define NRSUR_FIT_BFA_SIZE (NRSUR_FIT_Q_ORDERS * NRSUR_FIT_CHI_ORDERS * NRSUR_FIT_CHI_ORDERS * NRSUR_FIT_CHI_ORDERS)
+#define NRSUR_FIT_BFB_SIZE (NRSUR_FIT_CHI_ORDERS * NRSUR_FIT_CHI_ORDERS * NRSUR_FIT_CHI_ORDERS)
+
+// Number of scalar fits at each dynamics node: omega, 2 omega_copr components,
+// 3 chiA_dot components, and 3 chiB_dot components.
+#define NRSUR_DS_NODE_N_FITS 9
+
 // Surrogate model data, in LAL_DATA_PATH. File available in lalsuite-extra or at
 // https://www.black-holes.org/surrogates
 static const char NRSUR7DQ2_DATAFILE[] = "NRSur7dq2.h5";
@@ -104,6 +117,20 @@ typedef struct tagVectorFitData {
     FitData **fit_data;            /**< Vector of FitData */
 } VectorFitData;
 
+/**
+ * Several scalar fits packed into contiguous arrays, so that they can be
+ * evaluated together. Each term is given by its coefficient and by the indices
+ * of the products of its basis functions in the tables computed by
+ * PrecessingNRSur_fit_basis_products(), which are shared by all fits.
+ */
+typedef struct tagPackedFitData {
+    int n_fits;         /**< Number of packed fits */
+    int *fit_start;     /**< The terms of fit k are fit_start[k] <= i < fit_start[k+1]; length n_fits+1 */
+    REAL8 *coefs;       /**< Coefficients of all terms */
+    int *bfA_index;     /**< Index of each term in the table of mass ratio and chiA basis function products */
+    int *bfB_index;     /**< Index of each term in the table of chiB basis function products */
+} PackedFitData;
+
 /**
  * Data for a single dynamics node
  */
@@ -115,6 +142,8 @@ typedef struct tagDynamicsNodeFitData {
                                          time derivative of chiA taken in the coprecessing frame */
     VectorFitData *chiB_dot_data;   /**< A 3d vector fit for the coorbital components of the
                                          time derivative of chiB taken in the coprecessing frame */
+    PackedFitData *packed_data;     /**< All of the above fits packed together, in the order
+                                         omega, omega_copr, chiA_dot, chiB_dot */
 } DynamicsNodeFitData;
 
 /**
@@ -125,6 +154,7 @@ typedef struct tagDynamicsNodeFitData {
 typedef struct tagWaveformDataPiece {
     int n_nodes;                                /**< Number of empirical nodes */
     FitData **fit_data;                         /**< FitData at each empirical node */
+    PackedFitData *packed_fit_data;             /**< fit_data packed together */
     gsl_matrix *empirical_interpolant_basis;    /**< The empirical interpolation matrix */
     gsl_vector_long *empirical_node_indices;    /**< The empirical node indices */
 } WaveformDataPiece;
@@ -171,34 +201,46 @@ static void NRSur7dq4_Init_LALDATA(void);
 static int PrecessingNRSur_Init(PrecessingNRSurData *data, LALH5File *file, UINT4 PrecessingNRSurVersion);
 static void PrecessingNRSur_LoadFitData(FitData **fit_data, LALH5File *sub, const char *name);
 static void NRSur7dq4_LoadVectorFitData(VectorFitData **vector_fit_data, LALH5File *sub, const char *name, const size_t size);
-static void PrecessingNRSur_LoadDynamicsNode(DynamicsNodeFitData **ds_node_data, LALH5File *sub, int i, UINT4 PrecessingNRSurVersion);
-static void PrecessingNRSur_LoadCoorbitalEllModes(WaveformFixedEllModeData **coorbital_mode_data, LALH5File *file, int i);
-static void PrecessingNRSur_LoadWaveformDataPiece(LALH5File *sub, WaveformDataPiece **data, bool invert_sign);
+static int PrecessingNRSur_LoadDynamicsNode(DynamicsNodeFitData **ds_node_data, LALH5File *sub, int i, UINT4 PrecessingNRSurVersion);
+static int PrecessingNRSur_LoadCoorbitalEllModes(WaveformFixedEllModeData **coorbital_mode_data, LALH5File *file, int i);
+static int PrecessingNRSur_LoadWaveformDataPiece(LALH5File *sub, WaveformDataPiece **data, bool invert_sign);
+static void PrecessingNRSur_DestroyPackedFitData(PackedFitData *packed);
+static PackedFitData *PrecessingNRSur_AllocPackedFitData(int n_fits, int n_coefs);
+static int PrecessingNRSur_PackFitTerms(
+    PackedFitData *packed,
+    int k,
+    const gsl_vector *coefs,
+    const gsl_matrix_long *orders,
+    const gsl_vector_long *componentIndices,
+    long component
+);
+static PackedFitData *PrecessingNRSur_PackFits(FitData **fit_data, int n_fits);
+static int PrecessingNRSur_PackDynamicsNode(DynamicsNodeFitData *ds_node, UINT4 PrecessingNRSurVersion);
 static bool NRSur7dq2_IsSetup(void);
 static bool NRSur7dq4_IsSetup(void);
 static double ipow(double base, int exponent); // integer powers
 
 static double NRSur7dq2_eval_fit(FitData *data, double *x);
 
-static void NRSur7dq2_eval_vector_fit(
-    double *res, // Result
-    VectorFitData *data, // Data for fit
-    double *x // size 7, giving mass ratio q, and dimensionless spin components
-);
-
 static int NRSur7dq4_effective_spins(REAL8 *chiHat, REAL8 *chi_a,
         const double q, const double chi1z, const double chi2z);
 static double NRSur7dq4_eval_fit(FitData *data, double *x);
 
-static void NRSur7dq4_eval_vector_fit(
-    double *res, // Result
-    VectorFitData *data, // Data for fit
-    double *x // size 7, giving mass ratio q, and dimensionless spin components
-);
-
 double PrecessingNRSur_eval_fit(FitData *data, double *x, PrecessingNRSurData *__sur_data);
 
-static void PrecessingNRSur_eval_vector_fit(double *res, VectorFitData *data, double *x, PrecessingNRSurData *__sur_data);
+static void PrecessingNRSur_fit_basis_products(
+    double *bfA, // Output: products of mass ratio and chiA basis functions
+    double *bfB, // Output: products of chiB basis functions
+    const double *x, // size 7, giving mass ratio q, and dimensionless spin components
+    UINT4 PrecessingNRSurVersion
+);
+
+static void PrecessingNRSur_eval_packed_fits(
+    double *res, // Result, one entry per packed fit
+    const PackedFitData *data, // Packed fits
+    const double *x, // size 7, giving mass ratio q, and dimensionless spin components
+    PrecessingNRSurData *__sur_data
+);
 
 static void PrecessingNRSur_normalize_y(
     double chiANorm,
@@ -69,6 +69,7 @@
 #define UNUSED
 #endif
 
+static int SpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus, REAL8TimeSeries ** hcross, const REAL8 phiC, REAL8 deltaT, const REAL8 m1SI, const REAL8 m2SI, const REAL8 fMin, const REAL8 r, const REAL8 inc, const REAL8 spin1z, const REAL8 spin2z, UINT4 SpinAlignedEOBversion, const REAL8 lambda2Tidal1, const REAL8 lambda2Tidal2, const REAL8 omega02Tidal1, const REAL8 omega02Tidal2, const REAL8 lambda3Tidal1, const REAL8 lambda3Tidal2, const REAL8 omega03Tidal1, const REAL8 omega03Tidal2, const REAL8 quadparam1, const REAL8 quadparam2, REAL8Vector *nqcCoeffsInput, const INT4 nqcFlag, LALValue *ModeArray, const INT4 useDormandPrince);
 
 /**
  * ModeArray is a structure which allows to select the modes to include
@@ -576,6 +577,9 @@ XLALSimIMRSpinAlignedEOBWaveform (REAL8TimeSeries ** hplus,	     /**<< OUTPUT, +
   quadparam1 = 1. + XLALSimInspiralWaveformParamsLookupdQuadMon1(LALParams);
   quadparam2 = 1. + XLALSimInspiralWaveformParamsLookupdQuadMon2(LALParams);
 
+  /* Opt-in to the Dormand-Prince integrator with dense output, XLALAdaptiveRungeKutta4() otherwise */
+  const INT4 useDormandPrince = XLALSimInspiralWaveformParamsLookupEOBUseDormandPrince(LALParams);
+
   LALValue *ModeArray = XLALSimInspiralWaveformParamsLookupModeArray(LALParams);
   /*ModeArray includes the modes chosen by the user
   */
@@ -606,8 +610,8 @@ XLALSimIMRSpinAlignedEOBWaveform (REAL8TimeSeries ** hplus,	     /**<< OUTPUT, +
 #if debugOutput
       printf("First run SEOBNRv4 to compute NQCs\n");
 #endif
-      ret = XLALSimIMRSpinAlignedEOBWaveformAll (hplus, hcross, phiC, 1./32768, m1BH, m2BH, 2*pow(10.,-1.5)/(2.*LAL_PI)/((m1BH + m2BH)*LAL_MTSUN_SI/LAL_MSUN_SI), r, inc, spin1z, spin2z, 400,
-					 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, nqcCoeffsInput, nqcFlag, ModeArray);
+      ret = SpinAlignedEOBWaveformAll (hplus, hcross, phiC, 1./32768, m1BH, m2BH, 2*pow(10.,-1.5)/(2.*LAL_PI)/((m1BH + m2BH)*LAL_MTSUN_SI/LAL_MSUN_SI), r, inc, spin1z, spin2z, 400,
+					 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, nqcCoeffsInput, nqcFlag, ModeArray, useDormandPrince);
       if (ret == XLAL_FAILURE){
         if ( nqcCoeffsInput ) XLALDestroyREAL8Vector( nqcCoeffsInput );
         if(ModeArray) XLALDestroyValue(ModeArray);
@@ -621,14 +625,14 @@ XLALSimIMRSpinAlignedEOBWaveform (REAL8TimeSeries ** hplus,	     /**<< OUTPUT, +
     {
       //REAL8Vector *nqcCoeffsInput = XLALCreateREAL8Vector(10);
       //INT4 nqcFlag = 0;
-      ret = XLALSimIMRSpinAlignedEOBWaveformAll (hplus, hcross,
+      ret = SpinAlignedEOBWaveformAll (hplus, hcross,
                                                  phiC, deltaT, m1SI, m2SI, fMin, r, inc, spin1z, spin2z, SpinAlignedEOBversion,
                                                  lambda2Tidal1, lambda2Tidal2,
                                                  omega02Tidal1, omega02Tidal2,
                                                  lambda3Tidal1, lambda3Tidal2,
                                                  omega03Tidal1, omega03Tidal2,
                                                  quadparam1, quadparam2,
-                                                 nqcCoeffsInput, nqcFlag, ModeArray);
+                                                 nqcCoeffsInput, nqcFlag, ModeArray, useDormandPrince);
      if (ret == XLAL_FAILURE){
        if ( nqcCoeffsInput ) XLALDestroyREAL8Vector( nqcCoeffsInput );
        if (ModeArray) XLALDestroyValue(ModeArray);
@@ -669,8 +673,8 @@ XLALSimIMRSpinAlignedEOBWaveform (REAL8TimeSeries ** hplus,	     /**<< OUTPUT, +
  * The initial conditions solver can also fail for low starting frequencies,
  * with a failure rate of ~0.3% at fmin=10Hz for M=3Msol.
  */
-int
-XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
+static int
+SpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
 				     /**<< OUTPUT, mode hlm */
              //SM
              REAL8Vector ** dynamics_out, /**<< OUTPUT, low-sampling dynamics */
@@ -714,8 +718,10 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
                      /**<< parameter kappa_2 of the spin-induced quadrupole for body 2, quadrupole is Q_A = -kappa_A m_A^3 chi_A^2 */
                      REAL8Vector *nqcCoeffsInput,
                      /**<< Input NQC coeffs */
-                     const INT4 nqcFlag
+                     const INT4 nqcFlag,
                      /**<< Flag to tell the code to use the NQC coeffs input thorugh nqcCoeffsInput */
+                     const INT4 useDormandPrince
+                     /**<< 1 to evolve the dynamics with XLALAdaptiveRungeKuttaDormandPrince() instead of XLALAdaptiveRungeKutta4(); ignored by SEOBNRv2_opt and SEOBNRv4_opt */
   )
 {
   REAL8 STEP_SIZE = STEP_SIZE_CALCOMEGA;
@@ -1440,9 +1446,13 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
     if ( use_tidal == 1 ) {
         if (!
             (integrator =
-             XLALAdaptiveRungeKutta4Init (4, XLALSpinAlignedHcapDerivative,
-                                          XLALSpinAlignedNSNSStopCondition,
-                                          EPS_ABS, EPS_REL)))
+             (useDormandPrince ?
+              XLALAdaptiveRungeKuttaDormandPrinceInit (4, XLALSpinAlignedHcapDerivative,
+                                                       XLALSpinAlignedNSNSStopCondition,
+                                                       EPS_ABS, EPS_REL) :
+              XLALAdaptiveRungeKutta4Init (4, XLALSpinAlignedHcapDerivative,
+                                           XLALSpinAlignedNSNSStopCondition,
+                                           EPS_ABS, EPS_REL))))
         {
             XLALDestroyREAL8Vector (values);
             XLAL_ERROR (XLAL_EFUNC);
@@ -1466,9 +1476,13 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
         {
             if (!
                 (integrator =
-                 XLALAdaptiveRungeKutta4Init (4, XLALSpinAlignedHcapDerivative,
-					XLALEOBSpinAlignedStopCondition,
-					EPS_ABS, EPS_REL)))
+                 (useDormandPrince ?
+                  XLALAdaptiveRungeKuttaDormandPrinceInit (4, XLALSpinAlignedHcapDerivative,
+                                                           XLALEOBSpinAlignedStopCondition,
+                                                           EPS_ABS, EPS_REL) :
+                  XLALAdaptiveRungeKutta4Init (4, XLALSpinAlignedHcapDerivative,
+                                               XLALEOBSpinAlignedStopCondition,
+                                               EPS_ABS, EPS_REL))))
             {
                 XLALDestroyREAL8Vector (values);
                 XLAL_ERROR (XLAL_EFUNC);
@@ -1499,6 +1513,13 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
 						 &dynamics);
       /* END OPTIMIZED */
     }
+  else if (useDormandPrince)
+    {
+      retLen =
+	XLALAdaptiveRungeKuttaDormandPrince (integrator, &seobParams, values->data, 0.,
+					     20. / mTScaled, deltaT / mTScaled,
+					     &dynamics);
+    }
   else
     {
       retLen =
@@ -1597,6 +1618,13 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
 						 &dynamicsHi);
       /* END OPTIMIZED */
     }
+  else if (useDormandPrince)
+    {
+      retLen =
+	XLALAdaptiveRungeKuttaDormandPrince (integrator, &seobParams, values->data, 0.,
+					     20. / mTScaled, deltaTHigh / mTScaled,
+					     &dynamicsHi);
+    }
   else
     {
       retLen =
@@ -3134,11 +3162,51 @@ for ( UINT4 k = 0; k<nModes; k++) {
     }
 
 /**
- * This function takes the modes from the function XLALSimIMRSpinAlignedEOBModes and combine them into h+ and hx
+ * Generates the SEOBNRv1,2,2opt,4,4opt,2T,4T,4HM modes hlm as described in SpinAlignedEOBModes(),
+ * evolving the dynamics with XLALAdaptiveRungeKutta4().
  */
-
 int
-XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
+XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
+             REAL8Vector ** dynamics_out,
+             REAL8Vector ** dynamicsHi_out,
+				     REAL8 deltaT,
+				     const REAL8 m1SI,
+				     const REAL8 m2SI,
+				     const REAL8 fMin,
+				     const REAL8 r,
+				     const REAL8 spin1z,
+				     const REAL8 spin2z,
+                     UINT4 SpinAlignedEOBversion,
+				     const REAL8 lambda2Tidal1,
+				     const REAL8 lambda2Tidal2,
+				     const REAL8 omega02Tidal1,
+				     const REAL8 omega02Tidal2,
+				     const REAL8 lambda3Tidal1,
+				     const REAL8 lambda3Tidal2,
+				     const REAL8 omega03Tidal1,
+				     const REAL8 omega03Tidal2,
+             const REAL8 quadparam1,
+				     const REAL8 quadparam2,
+                     REAL8Vector *nqcCoeffsInput,
+                     const INT4 nqcFlag
+  )
+{
+  return SpinAlignedEOBModes (hlmmode, dynamics_out, dynamicsHi_out,
+                              deltaT, m1SI, m2SI, fMin, r, spin1z, spin2z, SpinAlignedEOBversion,
+                              lambda2Tidal1, lambda2Tidal2,
+                              omega02Tidal1, omega02Tidal2,
+                              lambda3Tidal1, lambda3Tidal2,
+                              omega03Tidal1, omega03Tidal2,
+                              quadparam1, quadparam2,
+                              nqcCoeffsInput, nqcFlag, 0);
+}
+
+/**
+ * This function takes the modes from the function SpinAlignedEOBModes and combine them into h+ and hx
+ */
+
+static int
+SpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
 				     /**<< OUTPUT, real part of the modes */
 				     REAL8TimeSeries ** hcross,
 				     /**<< OUTPUT, complex part of the modes */
@@ -3186,8 +3254,10 @@ XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
                      /**<< Input NQC coeffs */
                      const INT4 nqcFlag,
                      /**<< Flag to tell the code to use the NQC coeffs input thorugh nqcCoeffsInput */
-            LALValue *ModeArray
+            LALValue *ModeArray,
             /**<< Structure containing the modes to use in the waveform */
+                     const INT4 useDormandPrince
+                     /**<< 1 to evolve the dynamics with XLALAdaptiveRungeKuttaDormandPrince() instead of XLALAdaptiveRungeKutta4() */
   )
   {
 
@@ -3199,9 +3269,9 @@ XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
     REAL8Vector *dynamicsHi = NULL;
     //SM
 
-    //RC: XLALSimIMRSpinAlignedEOBModes computes the modes and put them into hlm
+    //RC: SpinAlignedEOBModes computes the modes and put them into hlm
 
-    if(XLALSimIMRSpinAlignedEOBModes (&hlms,
+    if(SpinAlignedEOBModes (&hlms,
                                    //SM
                                    &dynamics, &dynamicsHi,
                                    //SM
@@ -3211,7 +3281,7 @@ XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
                                                lambda3Tidal1, lambda3Tidal2,
                                                omega03Tidal1, omega03Tidal2,
                                                quadparam1, quadparam2,
-                                               nqcCoeffsInput, nqcFlag) == XLAL_FAILURE){
+                                               nqcCoeffsInput, nqcFlag, useDormandPrince) == XLAL_FAILURE){
                                                  if(dynamics) XLALDestroyREAL8Vector(dynamics);
                                                  if(dynamicsHi) XLALDestroyREAL8Vector(dynamicsHi);
                                                  XLAL_ERROR (XLAL_EFUNC);
@@ -3272,4 +3342,46 @@ XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
     return XLAL_SUCCESS;
   }
 
+/**
+ * Combines the SEOBNRv1,2,2opt,4,4opt,2T,4T,4HM modes into h+ and hx as described in
+ * SpinAlignedEOBWaveformAll(), evolving the dynamics with XLALAdaptiveRungeKutta4().
+ */
+int
+XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
+				     REAL8TimeSeries ** hcross,
+				     const REAL8 phiC,
+				     REAL8 deltaT,
+				     const REAL8 m1SI,
+				     const REAL8 m2SI,
+				     const REAL8 fMin,
+				     const REAL8 r,
+				     const REAL8 inc,
+				     const REAL8 spin1z,
+				     const REAL8 spin2z,
+                     UINT4 SpinAlignedEOBversion,
+				     const REAL8 lambda2Tidal1,
+				     const REAL8 lambda2Tidal2,
+				     const REAL8 omega02Tidal1,
+				     const REAL8 omega02Tidal2,
+				     const REAL8 lambda3Tidal1,
+				     const REAL8 lambda3Tidal2,
+				     const REAL8 omega03Tidal1,
+				     const REAL8 omega03Tidal2,
+             const REAL8 quadparam1,
+				     const REAL8 quadparam2,
+                     REAL8Vector *nqcCoeffsInput,
+                     const INT4 nqcFlag,
+            LALValue *ModeArray
+  )
+{
+  return SpinAlignedEOBWaveformAll (hplus, hcross, phiC, deltaT, m1SI, m2SI, fMin, r, inc,
+                                    spin1z, spin2z, SpinAlignedEOBversion,
+                                    lambda2Tidal1, lambda2Tidal2,
+                                    omega02Tidal1, omega02Tidal2,
+                                    lambda3Tidal1, lambda3Tidal2,
+                                    omega03Tidal1, omega03Tidal2,
+                                    quadparam1, quadparam2,
+                                    nqcCoeffsInput, nqcFlag, ModeArray, 0);
+}
+
 /** @} */
@@ -152,6 +152,9 @@ DEFINE_INSERT_FUNC(NLTidesF2, REAL8, "nlTidesF2", 0)
 /* SEOBNRv4P */
 DEFINE_INSERT_FUNC(EOBChooseNumOrAnalHamDer, INT4, "EOBChooseNumOrAnalHamDer", 1)
 
+/* SEOBNRv2, SEOBNRv4, SEOBNRv4HM, SEOBNRv2T and SEOBNRv4T */
+DEFINE_INSERT_FUNC(EOBUseDormandPrince, INT4, "EOBUseDormandPrince", 0)
+
 /* IMRPhenomX Parameters */
 DEFINE_INSERT_FUNC(PhenomXInspiralPhaseVersion, INT4, "InsPhaseVersion", 104)
 DEFINE_INSERT_FUNC(PhenomXInspiralAmpVersion, INT4, "InsAmpVersion", 103)
@@ -293,6 +296,9 @@ DEFINE_LOOKUP_FUNC(NLTidesF2, REAL8, "nlTidesF2", 0)
 /* SEOBNRv4P */
 DEFINE_LOOKUP_FUNC(EOBChooseNumOrAnalHamDer, INT4, "EOBChooseNumOrAnalHamDer", 1)
 
+/* SEOBNRv2, SEOBNRv4, SEOBNRv4HM, SEOBNRv2T and SEOBNRv4T */
+DEFINE_LOOKUP_FUNC(EOBUseDormandPrince, INT4, "EOBUseDormandPrince", 0)
+
 /* IMRPhenomX Parameters */
 DEFINE_LOOKUP_FUNC(PhenomXInspiralPhaseVersion, INT4, "InsPhaseVersion", 104)
 DEFINE_LOOKUP_FUNC(PhenomXInspiralAmpVersion, INT4, "InsAmpVersion", 103)
@@ -417,6 +423,9 @@ DEFINE_ISDEFAULT_FUNC(NonGRLIVAlpha, REAL8, "nonGR_alpha", 0)
 /* SEOBNRv4P */
 DEFINE_ISDEFAULT_FUNC(EOBChooseNumOrAnalHamDer, INT4, "EOBChooseNumOrAnalHamDer", 1)
 
+/* SEOBNRv2, SEOBNRv4, SEOBNRv4HM, SEOBNRv2T and SEOBNRv4T */
+DEFINE_ISDEFAULT_FUNC(EOBUseDormandPrince, INT4, "EOBUseDormandPrince", 0)
+
 /* IMRPhenomX Parameters */
 DEFINE_ISDEFAULT_FUNC(PhenomXInspiralPhaseVersion, INT4, "InsPhaseVersion", 104)
 DEFINE_ISDEFAULT_FUNC(PhenomXInspiralAmpVersion, INT4, "InsAmpVersion", 103)
@@ -139,6 +139,9 @@ int XLALSimInspiralWaveformParamsInsertNLTidesF2(LALDict *params, REAL8 value);
 /* SEOBNRv4P */
 INT4 XLALSimInspiralWaveformParamsInsertEOBChooseNumOrAnalHamDer(LALDict *params, INT4 value);
 
+/* SEOBNRv2, SEOBNRv4, SEOBNRv4HM, SEOBNRv2T and SEOBNRv4T */
+INT4 XLALSimInspiralWaveformParamsInsertEOBUseDormandPrince(LALDict *params, INT4 value);
+
 INT4 XLALSimInspiralWaveformParamsLookupModesChoice(LALDict *params);
 INT4 XLALSimInspiralWaveformParamsLookupFrameAxis(LALDict *params);
 INT4 XLALSimInspiralWaveformParamsLookupSideband(LALDict *params);
@@ -267,6 +270,9 @@ REAL8 XLALSimInspiralWaveformParamsLookupNLTidesF2(LALDict *params);
 /* SEOBNRv4P */
 INT4 XLALSimInspiralWaveformParamsLookupEOBChooseNumOrAnalHamDer(LALDict *params);
 
+/* SEOBNRv2, SEOBNRv4, SEOBNRv4HM, SEOBNRv2T and SEOBNRv4T */
+INT4 XLALSimInspiralWaveformParamsLookupEOBUseDormandPrince(LALDict *params);
+
 int XLALSimInspiralWaveformParamsModesChoiceIsDefault(LALDict *params);
 int XLALSimInspiralWaveformParamsFrameAxisIsDefault(LALDict *params);
 int XLALSimInspiralWaveformParamsSidebandIsDefault(LALDict *params);
@@ -384,6 +390,9 @@ int XLALSimInspiralWaveformParamsNonGRLIVAlphaIsDefault(LALDict *params);
 /* SEOBNRv4P */
 INT4 XLALSimInspiralWaveformParamsEOBChooseNumOrAnalHamDerIsDefault(LALDict *params);
 
+/* SEOBNRv2, SEOBNRv4, SEOBNRv4HM, SEOBNRv2T and SEOBNRv4T */
+INT4 XLALSimInspiralWaveformParamsEOBUseDormandPrinceIsDefault(LALDict *params);
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
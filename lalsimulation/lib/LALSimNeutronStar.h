@@ -61,6 +61,9 @@ extern const char * const lalSimNeutronStarEOSNames[65];
 /** Incomplete type for a neutron star family having a particular EOS. */
 typedef struct tagLALSimNeutronStarFamily LALSimNeutronStarFamily;
 
+/** Incomplete type for a cache of neutron star families. */
+typedef struct tagLALSimNeutronStarFamilyCache LALSimNeutronStarFamilyCache;
+
 void XLALDestroySimNeutronStarEOS(LALSimNeutronStarEOS * eos);
 char *XLALSimNeutronStarEOSName(LALSimNeutronStarEOS * eos);
 
@@ -123,6 +126,8 @@ int XLALSimNeutronStarTOVODEIntegrate(double *radius, double *mass,
 void XLALDestroySimNeutronStarFamily(LALSimNeutronStarFamily * fam);
 LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     LALSimNeutronStarEOS * eos);
+LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamilyAdaptive(
+    LALSimNeutronStarEOS * eos, double tol);
 
 double XLALSimNeutronStarFamMinimumMass(LALSimNeutronStarFamily * fam);
 double XLALSimNeutronStarMaximumMass(LALSimNeutronStarFamily * fam);
@@ -130,6 +135,19 @@ double XLALSimNeutronStarCentralPressure(double m,
     LALSimNeutronStarFamily * fam);
 double XLALSimNeutronStarRadius(double m, LALSimNeutronStarFamily * fam);
 double XLALSimNeutronStarLoveNumberK2(double m, LALSimNeutronStarFamily * fam);
+int XLALSimNeutronStarTidalDeformabilities(double *lambda, double *r,
+    const double *m, size_t n, LALSimNeutronStarFamily * fam);
+
+void XLALDestroySimNeutronStarFamilyCache(LALSimNeutronStarFamilyCache *
+    cache);
+LALSimNeutronStarFamilyCache * XLALCreateSimNeutronStarFamilyCache(size_t
+    size);
+int XLALSimNeutronStarFamilyCacheLookup(LALSimNeutronStarFamilyCache *
+    cache, const double *key, size_t keylen, LALSimNeutronStarEOS ** eos,
+    LALSimNeutronStarFamily ** fam);
+int XLALSimNeutronStarFamilyCacheInsert(LALSimNeutronStarFamilyCache *
+    cache, const double *key, size_t keylen, LALSimNeutronStarEOS * eos,
+    LALSimNeutronStarFamily * fam);
 
 #endif /* _LALSIMNEUTRONSTAR_H */
 
@@ -115,7 +115,8 @@ const char * const lalSimNeutronStarEOSNames[65] = {
  */
 void XLALDestroySimNeutronStarEOS(LALSimNeutronStarEOS * eos)
 {
-    eos->free(eos);
+    if (eos)
+        eos->free(eos);
     return;
 }
 
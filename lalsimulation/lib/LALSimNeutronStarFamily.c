@@ -25,12 +25,14 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_min.h>
 GSL_VAR const gsl_interp_type * lal_gsl_interp_steffen;
 
 #include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
 #include <lal/LALSimNeutronStar.h>
 
 /** @cond */
@@ -50,6 +52,19 @@ struct tagLALSimNeutronStarFamily {
     gsl_interp_accel *k_of_m_acc;
 };
 
+/* Contents of the neutron star family cache structure. */
+struct tagLALSimNeutronStarFamilyCache {
+    size_t size;
+    unsigned long clock;
+    struct {
+        double *key;
+        size_t keylen;
+        unsigned long used;
+        LALSimNeutronStarEOS *eos;
+        LALSimNeutronStarFamily *fam;
+    } *entry;
+};
+
 /* gsl function for use in finding the maximum neutron star mass */
 static double fminimizer_gslfunction(double x, void * params);
 static double fminimizer_gslfunction(double x, void * params)
@@ -60,6 +75,116 @@ static double fminimizer_gslfunction(double x, void * params)
     return -m; /* maximum mass is minimum negative mass */
 }
 
+/* replaces point i, which has passed the maximum mass, with the maximum
+ * mass found from the bracket formed by points i-2, i-1 and i */
+static void maximum_mass_point(double *pdat, double *mdat, double *rdat,
+    double *kdat, size_t i, LALSimNeutronStarEOS * eos)
+{
+    const double epsabs = 0.0, epsrel = 1e-6;
+    double a = pdat[i - 2];
+    double x = pdat[i - 1];
+    double b = pdat[i];
+    double fa = -mdat[i - 2];
+    double fx = -mdat[i - 1];
+    double fb = -mdat[i];
+    int status;
+    gsl_function F;
+    gsl_min_fminimizer * s;
+    F.function = &fminimizer_gslfunction;
+    F.params = eos;
+    s = gsl_min_fminimizer_alloc(gsl_min_fminimizer_brent);
+    gsl_min_fminimizer_set_with_values(s, &F, x, fx, a, fa, b, fb);
+    do {
+        status = gsl_min_fminimizer_iterate(s);
+        x = gsl_min_fminimizer_x_minimum(s);
+        a = gsl_min_fminimizer_x_lower(s);
+        b = gsl_min_fminimizer_x_upper(s);
+        status = gsl_min_test_interval(a, b, epsabs, epsrel);
+    } while (status == GSL_CONTINUE);
+    gsl_min_fminimizer_free(s);
+    pdat[i] = x;
+    XLALSimNeutronStarTOVODEIntegrate(&rdat[i], &mdat[i], &kdat[i], pdat[i],
+        eos);
+    return;
+}
+
+/* sets up the interpolators of a family whose data tables are filled */
+static int setup_interpolators(LALSimNeutronStarFamily * fam)
+{
+    size_t ndat = fam->ndat;
+
+    fam->p_of_m_acc = gsl_interp_accel_alloc();
+    fam->r_of_m_acc = gsl_interp_accel_alloc();
+    fam->k_of_m_acc = gsl_interp_accel_alloc();
+
+    fam->p_of_m_interp = gsl_interp_alloc(gsl_interp_cspline, ndat);
+    fam->r_of_m_interp = gsl_interp_alloc(lal_gsl_interp_steffen, ndat);
+    fam->k_of_m_interp = gsl_interp_alloc(lal_gsl_interp_steffen, ndat);
+
+    if (!fam->p_of_m_acc || !fam->r_of_m_acc || !fam->k_of_m_acc
+        || !fam->p_of_m_interp || !fam->r_of_m_interp || !fam->k_of_m_interp)
+        XLAL_ERROR(XLAL_ENOMEM);
+
+    gsl_interp_init(fam->p_of_m_interp, fam->mdat, fam->pdat, ndat);
+    gsl_interp_init(fam->r_of_m_interp, fam->mdat, fam->rdat, ndat);
+    gsl_interp_init(fam->k_of_m_interp, fam->mdat, fam->kdat, ndat);
+
+    return 0;
+}
+
+/* relative error of the linear interpolation y of y0 */
+static double relative_error(double y, double y0)
+{
+    return y0 == 0.0 ? fabs(y) : fabs((y - y0) / y0);
+}
+
+/*
+ * Recursively bisects (in log central pressure) the interval between point
+ * n-1 of the tables and the point (p1, m1, r1, k1), appending the interior
+ * points it computes but not the end point.  An interval is bisected
+ * again if linear interpolation of mass, radius or Love number across it
+ * misses the midpoint by more than the relative tolerance tol.
+ */
+static void refine_interval(double *pdat, double *mdat, double *rdat,
+    double *kdat, size_t *n, size_t nmax, double p1, double m1, double r1,
+    double k1, double tol, double minlogdp, LALSimNeutronStarEOS * eos)
+{
+    double p0 = pdat[*n - 1];
+    double m0 = mdat[*n - 1];
+    double r0 = rdat[*n - 1];
+    double k0 = kdat[*n - 1];
+    double p, m, r, k;
+    int refine;
+
+    if (*n >= nmax || log(p1 / p0) < 2.0 * minlogdp)
+        return;
+
+    p = sqrt(p0 * p1); /* midpoint in log pressure */
+    XLALSimNeutronStarTOVODEIntegrate(&r, &m, &k, p, eos);
+
+    /* keep the tables monotonic in mass: near the maximum mass this
+     * may fail, in which case there is nothing more to be done */
+    if (!(m > m0 && m < m1))
+        return;
+
+    refine = relative_error(0.5 * (m0 + m1), m) > tol
+        || relative_error(0.5 * (r0 + r1), r) > tol
+        || relative_error(0.5 * (k0 + k1), k) > tol;
+
+    if (refine)
+        refine_interval(pdat, mdat, rdat, kdat, n, nmax - 1, p, m, r, k, tol,
+            minlogdp, eos);
+    pdat[*n] = p;
+    mdat[*n] = m;
+    rdat[*n] = r;
+    kdat[*n] = k;
+    ++(*n);
+    if (refine)
+        refine_interval(pdat, mdat, rdat, kdat, n, nmax, p1, m1, r1, k1, tol,
+            minlogdp, eos);
+    return;
+}
+
 /** @endcond */
 
 /**
@@ -131,31 +256,8 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
 
     if (i < ndat) {
         /* replace the ith point with the maximum mass */
-        const double epsabs = 0.0, epsrel = 1e-6;
-        double a = fam->pdat[i - 2];
-        double x = fam->pdat[i - 1];
-        double b = fam->pdat[i];
-        double fa = -fam->mdat[i - 2];
-        double fx = -fam->mdat[i - 1];
-        double fb = -fam->mdat[i];
-        int status;
-        gsl_function F;
-        gsl_min_fminimizer * s;
-        F.function = &fminimizer_gslfunction;
-        F.params = eos;
-        s = gsl_min_fminimizer_alloc(gsl_min_fminimizer_brent);
-        gsl_min_fminimizer_set_with_values(s, &F, x, fx, a, fa, b, fb);
-        do {
-            status = gsl_min_fminimizer_iterate(s);
-            x = gsl_min_fminimizer_x_minimum(s);
-            a = gsl_min_fminimizer_x_lower(s);
-            b = gsl_min_fminimizer_x_upper(s);
-            status = gsl_min_test_interval(a, b, epsabs, epsrel);
-        } while (status == GSL_CONTINUE);
-        gsl_min_fminimizer_free(s);
-        fam->pdat[i] = x;
-        XLALSimNeutronStarTOVODEIntegrate(&fam->rdat[i], &fam->mdat[i],
-            &fam->kdat[i], fam->pdat[i], eos);
+        maximum_mass_point(fam->pdat, fam->mdat, fam->rdat, fam->kdat, i,
+            eos);
 
         /* resize arrays */
         if(fam->pdat[i] <= fam->pdat[i-1]){
@@ -174,18 +276,136 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     fam->ndat = ndat;
 
     /* setup interpolators */
+    if (setup_interpolators(fam) < 0) {
+        XLALDestroySimNeutronStarFamily(fam);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
 
-    fam->p_of_m_acc = gsl_interp_accel_alloc();
-    fam->r_of_m_acc = gsl_interp_accel_alloc();
-    fam->k_of_m_acc = gsl_interp_accel_alloc();
+    return fam;
+}
 
-    fam->p_of_m_interp = gsl_interp_alloc(gsl_interp_cspline, ndat);
-    fam->r_of_m_interp = gsl_interp_alloc(lal_gsl_interp_steffen, ndat);
-    fam->k_of_m_interp = gsl_interp_alloc(lal_gsl_interp_steffen, ndat);
+/**
+ * @brief Creates a neutron star family structure for a given equation of
+ * state, placing the central pressures adaptively.
+ * @details
+ * This is an alternative to XLALCreateSimNeutronStarFamily() that usually
+ * needs far fewer integrations of the TOV equations, which dominate the
+ * cost when a family is needed for every sample of an equation of state
+ * parameter space.  A coarse grid of central pressures, uniform in log
+ * pressure, is integrated until the mass turns over; the maximum mass is
+ * then located as in XLALCreateSimNeutronStarFamily(), and each interval of
+ * the grid is bisected in log pressure, recursively, wherever linear
+ * interpolation of the mass, radius or Love number across the interval
+ * misses the value at its midpoint by more than the relative tolerance
+ * @a tol.  Since the family interpolates with splines, its actual errors
+ * are usually much smaller than @a tol.
+ * @param eos Pointer to the Equation of State structure.
+ * @param tol Relative tolerance of the interpolation across grid intervals.
+ * @return A pointer to the neutron star family structure.
+ */
+LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamilyAdaptive(
+    LALSimNeutronStarEOS * eos, double tol)
+{
+    LALSimNeutronStarFamily * fam;
+    double pdat[16], mdat[16], rdat[16], kdat[16]; /* coarse grid */
+    const size_t ncoarse = sizeof(pdat) / sizeof(*pdat);
+    const size_t nfine = 64; /* finest subdivision of a coarse interval */
+    const size_t ndatmax = 256;
+    const double logpmin = 75.5;
+    double logpmax;
+    double dlogp;
+    size_t ndat;
+    size_t i, j;
 
-    gsl_interp_init(fam->p_of_m_interp, fam->mdat, fam->pdat, ndat);
-    gsl_interp_init(fam->r_of_m_interp, fam->mdat, fam->rdat, ndat);
-    gsl_interp_init(fam->k_of_m_interp, fam->mdat, fam->kdat, ndat);
+    if (!eos)
+        XLAL_ERROR_NULL(XLAL_EFAULT);
+    if (!(tol > 0.0))
+        XLAL_ERROR_NULL(XLAL_EINVAL, "Tolerance must be positive");
+
+    /* compute coarse grid up to the maximum mass */
+    /* this spans the same pressures as XLALCreateSimNeutronStarFamily() */
+    logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
+    dlogp = 0.99 * (logpmax - logpmin) / (ncoarse - 1);
+    for (i = 0; i < ncoarse; ++i) {
+        pdat[i] = exp(logpmin + i * dlogp);
+        XLALSimNeutronStarTOVODEIntegrate(&rdat[i], &mdat[i], &kdat[i],
+            pdat[i], eos);
+        /* determine if maximum mass has been found */
+        if (i > 0 && mdat[i] <= mdat[i-1])
+            break;
+    }
+
+    /* if the maximum mass lies before the second point of the coarse
+     * grid, bisect the first interval until it is bracketed */
+    for (j = 0; i == 1 && j < 8; ++j) {
+        pdat[2] = pdat[1];
+        mdat[2] = mdat[1];
+        rdat[2] = rdat[1];
+        kdat[2] = kdat[1];
+        pdat[1] = sqrt(pdat[0] * pdat[2]);
+        XLALSimNeutronStarTOVODEIntegrate(&rdat[1], &mdat[1], &kdat[1],
+            pdat[1], eos);
+        if (mdat[1] > mdat[0])
+            i = 2;
+    }
+    if (i == 1)
+        XLAL_ERROR_NULL(XLAL_EFAILED, "Could not bracket maximum mass");
+
+    ndat = i;
+    if (i < ncoarse) {
+        /* replace the ith point with the maximum mass */
+        maximum_mass_point(pdat, mdat, rdat, kdat, i, eos);
+        if (pdat[i] <= pdat[i-1]) {
+            pdat[i-1] = pdat[i];
+            mdat[i-1] = mdat[i];
+            rdat[i-1] = rdat[i];
+            kdat[i-1] = kdat[i];
+        } else
+            ndat = i + 1;
+    }
+
+    /* allocate memory */
+    fam = LALCalloc(1, sizeof(*fam));
+    if (!fam)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    fam->pdat = LALMalloc(ndatmax * sizeof(*fam->pdat));
+    fam->mdat = LALMalloc(ndatmax * sizeof(*fam->mdat));
+    fam->rdat = LALMalloc(ndatmax * sizeof(*fam->rdat));
+    fam->kdat = LALMalloc(ndatmax * sizeof(*fam->kdat));
+    if (!fam->pdat || !fam->mdat || !fam->rdat || !fam->kdat) {
+        XLALDestroySimNeutronStarFamily(fam);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* refine each interval of the coarse grid, leaving room for the
+     * remaining points of the coarse grid */
+    fam->pdat[0] = pdat[0];
+    fam->mdat[0] = mdat[0];
+    fam->rdat[0] = rdat[0];
+    fam->kdat[0] = kdat[0];
+    fam->ndat = 1;
+    for (j = 1; j < ndat; ++j) {
+        refine_interval(fam->pdat, fam->mdat, fam->rdat, fam->kdat,
+            &fam->ndat, ndatmax - (ndat - j), pdat[j], mdat[j], rdat[j],
+            kdat[j], tol, dlogp / nfine, eos);
+        fam->pdat[fam->ndat] = pdat[j];
+        fam->mdat[fam->ndat] = mdat[j];
+        fam->rdat[fam->ndat] = rdat[j];
+        fam->kdat[fam->ndat] = kdat[j];
+        ++fam->ndat;
+    }
+
+    /* resize arrays */
+    fam->pdat = LALRealloc(fam->pdat, fam->ndat * sizeof(*fam->pdat));
+    fam->mdat = LALRealloc(fam->mdat, fam->ndat * sizeof(*fam->mdat));
+    fam->rdat = LALRealloc(fam->rdat, fam->ndat * sizeof(*fam->rdat));
+    fam->kdat = LALRealloc(fam->kdat, fam->ndat * sizeof(*fam->kdat));
+
+    /* setup interpolators */
+    if (setup_interpolators(fam) < 0) {
+        XLALDestroySimNeutronStarFamily(fam);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
 
     return fam;
 }
@@ -253,4 +473,189 @@ double XLALSimNeutronStarLoveNumberK2(double m, LALSimNeutronStarFamily * fam)
     return k;
 }
 
+/**
+ * @brief Computes the radii and the dimensionless tidal deformabilities of
+ * neutron stars of several masses.
+ * @details
+ * The dimensionless tidal deformability is
+ * \f$\Lambda = (2/3) k_2 (c^2 R / G M)^5\f$.  Unlike the single-mass
+ * routines, this routine does not use the interpolation accelerators stored
+ * in the family, so it may be called on the same family from several
+ * threads at once.
+ * @param[out] lambda Array of @a n tidal deformabilities.
+ * @param[out] r Array of @a n radii (m), or NULL if not wanted.
+ * @param[in] m Array of @a n masses (kg).
+ * @param[in] n The number of neutron stars.
+ * @param[in] fam Pointer to the neutron star family structure.
+ * @return 0 on success, or an error code if a mass is outside the family.
+ */
+int XLALSimNeutronStarTidalDeformabilities(double *lambda, double *r,
+    const double *m, size_t n, LALSimNeutronStarFamily * fam)
+{
+    size_t i;
+
+    if (!lambda || !m || !fam)
+        XLAL_ERROR(XLAL_EFAULT);
+
+    for (i = 0; i < n; ++i) {
+        gsl_interp_accel acc;
+        double ri, ki, c;
+        if (m[i] < fam->mdat[0] || m[i] > fam->mdat[fam->ndat - 1])
+            XLAL_ERROR(XLAL_EDOM, "Mass %g kg outside neutron star family", m[i]);
+        /* the accelerator passes the index found for the radius on to
+         * the Love number */
+        gsl_interp_accel_reset(&acc);
+        ri = gsl_interp_eval(fam->r_of_m_interp, fam->mdat, fam->rdat, m[i],
+            &acc);
+        ki = gsl_interp_eval(fam->k_of_m_interp, fam->mdat, fam->kdat, m[i],
+            &acc);
+        c = m[i] / LAL_MSUN_SI * LAL_MRSUN_SI / ri;
+        lambda[i] = (2.0 / 3.0) * ki / pow(c, 5.0);
+        if (r)
+            r[i] = ri;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Frees the memory associated with a neutron star family cache,
+ * including the equations of state and families it holds.
+ * @param cache Pointer to the neutron star family cache to be freed.
+ */
+void XLALDestroySimNeutronStarFamilyCache(LALSimNeutronStarFamilyCache *
+    cache)
+{
+    size_t i;
+    if (cache) {
+        if (cache->entry)
+            for (i = 0; i < cache->size; ++i) {
+                XLALDestroySimNeutronStarFamily(cache->entry[i].fam);
+                XLALDestroySimNeutronStarEOS(cache->entry[i].eos);
+                LALFree(cache->entry[i].key);
+            }
+        LALFree(cache->entry);
+        LALFree(cache);
+    }
+    return;
+}
+
+/**
+ * @brief Creates a cache of neutron star families.
+ * @details
+ * The cache holds up to @a size pairs of equation of state and neutron
+ * star family, keyed on a vector of numbers (typically the parameters of
+ * the equation of state), and discards the least recently used pair when
+ * it is full.  This avoids recomputing a family when the same equation of
+ * state is needed repeatedly, e.g., while a sampler changes only the other
+ * parameters of a signal.  A cache is not thread-safe: each thread should
+ * have its own.
+ * @param size The maximum number of entries of the cache.
+ * @return A pointer to the neutron star family cache.
+ */
+LALSimNeutronStarFamilyCache * XLALCreateSimNeutronStarFamilyCache(size_t
+    size)
+{
+    LALSimNeutronStarFamilyCache *cache;
+
+    if (size == 0)
+        XLAL_ERROR_NULL(XLAL_EINVAL, "Cache size must be positive");
+
+    cache = LALCalloc(1, sizeof(*cache));
+    if (!cache)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    cache->entry = LALCalloc(size, sizeof(*cache->entry));
+    if (!cache->entry) {
+        LALFree(cache);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    cache->size = size;
+
+    return cache;
+}
+
+/**
+ * @brief Looks up an entry of a neutron star family cache.
+ * @details
+ * The equation of state and family returned remain owned by the cache and
+ * are valid until the next call of XLALSimNeutronStarFamilyCacheInsert().
+ * @param[in] cache Pointer to the neutron star family cache.
+ * @param[in] key Array of @a keylen numbers identifying the entry.
+ * @param[in] keylen The number of elements of @a key.
+ * @param[out] eos Set to the cached equation of state, if found.
+ * @param[out] fam Set to the cached family, if found.
+ * @return 1 if the entry was found, 0 if not, or an error code.
+ */
+int XLALSimNeutronStarFamilyCacheLookup(LALSimNeutronStarFamilyCache *
+    cache, const double *key, size_t keylen, LALSimNeutronStarEOS ** eos,
+    LALSimNeutronStarFamily ** fam)
+{
+    size_t i;
+
+    if (!cache || !key || !eos || !fam)
+        XLAL_ERROR(XLAL_EFAULT);
+
+    for (i = 0; i < cache->size; ++i)
+        if (cache->entry[i].key && cache->entry[i].keylen == keylen
+            && memcmp(cache->entry[i].key, key, keylen * sizeof(*key)) == 0) {
+            cache->entry[i].used = ++cache->clock;
+            *eos = cache->entry[i].eos;
+            *fam = cache->entry[i].fam;
+            return 1;
+        }
+
+    return 0;
+}
+
+/**
+ * @brief Inserts an entry into a neutron star family cache.
+ * @details
+ * The cache takes ownership of @a eos and @a fam, either of which may be
+ * NULL (e.g., to remember that no family could be made), and discards the
+ * least recently used entry if it is full.  The key must not already be in
+ * the cache.
+ * @param cache Pointer to the neutron star family cache.
+ * @param key Array of @a keylen numbers identifying the entry.
+ * @param keylen The number of elements of @a key.
+ * @param eos Pointer to the equation of state to be cached.
+ * @param fam Pointer to the neutron star family to be cached.
+ * @return 0 on success, or an error code.
+ */
+int XLALSimNeutronStarFamilyCacheInsert(LALSimNeutronStarFamilyCache *
+    cache, const double *key, size_t keylen, LALSimNeutronStarEOS * eos,
+    LALSimNeutronStarFamily * fam)
+{
+    double *newkey;
+    size_t i, oldest = 0;
+
+    if (!cache || !key)
+        XLAL_ERROR(XLAL_EFAULT);
+
+    newkey = LALMalloc(keylen * sizeof(*newkey));
+    if (!newkey)
+        XLAL_ERROR(XLAL_ENOMEM);
+    memcpy(newkey, key, keylen * sizeof(*key));
+
+    /* find an empty or the least recently used entry */
+    for (i = 0; i < cache->size; ++i) {
+        if (!cache->entry[i].key) {
+            oldest = i;
+            break;
+        }
+        if (cache->entry[i].used < cache->entry[oldest].used)
+            oldest = i;
+    }
+
+    XLALDestroySimNeutronStarFamily(cache->entry[oldest].fam);
+    XLALDestroySimNeutronStarEOS(cache->entry[oldest].eos);
+    LALFree(cache->entry[oldest].key);
+    cache->entry[oldest].key = newkey;
+    cache->entry[oldest].keylen = keylen;
+    cache->entry[oldest].used = ++cache->clock;
+    cache->entry[oldest].eos = eos;
+    cache->entry[oldest].fam = fam;
+
+    return 0;
+}
+
 /** @} */
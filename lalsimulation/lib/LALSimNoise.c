@@ -34,42 +34,64 @@
 #include <lal/LALSimNoise.h>
 
 
+/* state of a coloured-noise generator for one or more detectors */
+struct tagLALSimNoiseGenerator {
+	size_t length;		/* length of the noise segments */
+	size_t numDetectors;	/* number of detectors */
+	double *sigma;		/* numDetectors x (length/2 + 1) frequency-domain standard deviations */
+	double *psdDeltaF;	/* frequency resolution of each detector's psd */
+	LALUnit *psdUnits;	/* units of each detector's psd */
+	REAL8FFTPlan *plan;	/* reverse FFT plan of the segment length */
+	COMPLEX16FrequencySeries *stilde;	/* frequency-domain workspace */
+	REAL8Vector *overlap;	/* storage for the overlap between segments */
+	REAL8Vector *x, *y;	/* feathering weights for an overlap of x->length points */
+	gsl_rng *rng;		/* default RNG, allocated if no RNG is passed */
+};
+
 /* 
  * This routine generates a single segment of data.  Note that this segment is
  * generated in the frequency domain and is inverse Fourier transformed into
  * the time domain; consequently the data is periodic in the time domain.
  */
-static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gsl_rng *rng)
+static int XLALSimNoiseGeneratorSegment(LALSimNoiseGenerator *gen, size_t detector, REAL8TimeSeries *s, gsl_rng *rng)
 {
+	COMPLEX16FrequencySeries *stilde = gen->stilde;
+	const double *sigma = gen->sigma + detector * stilde->data->length;
 	size_t k;
-	REAL8FFTPlan *plan;
-	COMPLEX16FrequencySeries *stilde;
 
-	plan = XLALCreateReverseREAL8FFTPlan(s->data->length, 0);
-	if (! plan)
-		XLAL_ERROR(XLAL_EFUNC);
-
-	stilde = XLALCreateCOMPLEX16FrequencySeries("STILDE", &s->epoch, 0.0, 1.0/(s->data->length * s->deltaT), &lalDimensionlessUnit, s->data->length/2 + 1);
-	if (! stilde) {
-		XLALDestroyREAL8FFTPlan(plan);
-		XLAL_ERROR(XLAL_EFUNC);
-	}
+	stilde->epoch = s->epoch;
+	stilde->deltaF = 1.0/(s->data->length * s->deltaT);
 
 	/* correct units: [stilde] = sqrt([psd] * seconds) */
-	XLALUnitMultiply(&stilde->sampleUnits, &psd->sampleUnits, &lalSecondUnit);
+	XLALUnitMultiply(&stilde->sampleUnits, &gen->psdUnits[detector], &lalSecondUnit);
 	XLALUnitSqrt(&stilde->sampleUnits, &stilde->sampleUnits);
 
-	stilde->data->data[0] = 0.0;
-	for (k = 0; k < s->data->length/2 + 1; ++k) {
-		double sigma = 0.5 * sqrt(psd->data->data[k] / psd->deltaF);
-		stilde->data->data[k] = gsl_ran_gaussian_ziggurat(rng, sigma);
-		stilde->data->data[k] += I * gsl_ran_gaussian_ziggurat(rng, sigma);
+	for (k = 0; k < stilde->data->length; ++k) {
+		stilde->data->data[k] = gsl_ran_gaussian_ziggurat(rng, sigma[k]);
+		stilde->data->data[k] += I * gsl_ran_gaussian_ziggurat(rng, sigma[k]);
 	}
 
-	XLALREAL8FreqTimeFFT(s, stilde, plan);
+	if (XLALREAL8FreqTimeFFT(s, stilde, gen->plan))
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
 
-	XLALDestroyCOMPLEX16FrequencySeries(stilde);
-	XLALDestroyREAL8FFTPlan(plan);
+/* make sure the feathering weights are for an overlap of n points */
+static int XLALSimNoiseGeneratorFeather(LALSimNoiseGenerator *gen, size_t n)
+{
+	size_t j;
+	if (gen->x && gen->x->length == n)
+		return 0;
+	XLALDestroyREAL8Sequence(gen->x);
+	XLALDestroyREAL8Sequence(gen->y);
+	gen->x = XLALCreateREAL8Sequence(n);
+	gen->y = XLALCreateREAL8Sequence(n);
+	if (! gen->x || ! gen->y)
+		XLAL_ERROR(XLAL_EFUNC);
+	for (j = 0; j < n; ++j) {
+		gen->x->data[j] = cos(LAL_PI*j/(2.0 * n));
+		gen->y->data[j] = sin(LAL_PI*j/(2.0 * n));
+	}
 	return 0;
 }
 
@@ -80,6 +102,163 @@ static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gs
  * @{
  */
 
+/**
+ * @brief Creates a noise generator that produces sequential segments of
+ * coloured noise for one or more detectors.
+ *
+ * The generator holds the FFT plan, the frequency-domain standard deviations
+ * derived from the power spectra, and the overlap and feathering storage, so
+ * that streaming noise with XLALSimNoiseGeneratorNext() does no further setup
+ * or memory allocation.  The power spectra are copied and need not be kept.
+ */
+LALSimNoiseGenerator *XLALSimNoiseGeneratorCreate(
+	size_t length,			/**< [in] length of the noise segments (samples) */
+	REAL8FrequencySeries **psds,	/**< [in] power spectrum of each detector */
+	size_t numDetectors		/**< [in] number of detectors */
+)
+{
+	LALSimNoiseGenerator *gen;
+	LIGOTimeGPS epoch = LIGOTIMEGPSZERO;
+	size_t i, k;
+
+	if (! psds)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (length == 0 || numDetectors == 0)
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+	for (i = 0; i < numDetectors; ++i) {
+		if (! psds[i])
+			XLAL_ERROR_NULL(XLAL_EFAULT);
+		if (psds[i]->data->length != length/2 + 1)
+			XLAL_ERROR_NULL(XLAL_EINVAL);
+	}
+
+	gen = LALCalloc(1, sizeof(*gen));
+	if (! gen)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	gen->length = length;
+	gen->numDetectors = numDetectors;
+	gen->sigma = LALMalloc(numDetectors * (length/2 + 1) * sizeof(*gen->sigma));
+	gen->psdDeltaF = LALMalloc(numDetectors * sizeof(*gen->psdDeltaF));
+	gen->psdUnits = LALMalloc(numDetectors * sizeof(*gen->psdUnits));
+	gen->plan = XLALCreateReverseREAL8FFTPlan(length, 0);
+	gen->stilde = XLALCreateCOMPLEX16FrequencySeries("STILDE", &epoch, 0.0, psds[0]->deltaF, &lalDimensionlessUnit, length/2 + 1);
+	gen->overlap = XLALCreateREAL8Sequence(length);
+	if (! gen->sigma || ! gen->psdDeltaF || ! gen->psdUnits || ! gen->plan || ! gen->stilde || ! gen->overlap) {
+		XLALSimNoiseGeneratorDestroy(gen);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	for (i = 0; i < numDetectors; ++i) {
+		double *sigma = gen->sigma + i * (length/2 + 1);
+		for (k = 0; k < length/2 + 1; ++k)
+			sigma[k] = 0.5 * sqrt(psds[i]->data->data[k] / psds[i]->deltaF);
+		gen->psdDeltaF[i] = psds[i]->deltaF;
+		gen->psdUnits[i] = psds[i]->sampleUnits;
+	}
+
+	return gen;
+}
+
+/**
+ * @brief Destroys a noise generator.
+ */
+void XLALSimNoiseGeneratorDestroy(LALSimNoiseGenerator *gen)
+{
+	if (gen) {
+		LALFree(gen->sigma);
+		LALFree(gen->psdDeltaF);
+		LALFree(gen->psdUnits);
+		XLALDestroyREAL8FFTPlan(gen->plan);
+		XLALDestroyCOMPLEX16FrequencySeries(gen->stilde);
+		XLALDestroyREAL8Sequence(gen->overlap);
+		XLALDestroyREAL8Sequence(gen->x);
+		XLALDestroyREAL8Sequence(gen->y);
+		if (gen->rng)
+			gsl_rng_free(gen->rng);
+		LALFree(gen);
+	}
+}
+
+/**
+ * @brief Generates the next segment of noise for each detector of a noise
+ * generator.
+ *
+ * This routine behaves exactly as calling XLALSimNoise() with the same stride
+ * and RNG for s[0], s[1], ... in turn, with the power spectra that the
+ * generator was created with, and produces bit-identical data; see
+ * XLALSimNoise() for the calling instructions.  The time series must all have
+ * the length of the generator.
+ *
+ * @warning Only the first stride points are valid.
+ */
+int XLALSimNoiseGeneratorNext(
+	LALSimNoiseGenerator *gen,	/**< [in] noise generator */
+	REAL8TimeSeries **s,		/**< [in/out] noise time series of each detector */
+	size_t stride,			/**< [in] stride (samples) */
+	gsl_rng *rng			/**< [in] GSL random number generator */
+)
+{
+	const size_t length = gen ? gen->length : 0;
+	size_t i, j;
+
+	if (! gen || ! s)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	/* Use a default RNG if a NULL pointer was passed in */
+	if (! rng) {
+		if (! gen->rng)
+			gen->rng = gsl_rng_alloc(gsl_rng_default);
+		rng = gen->rng;
+	}
+
+	/* make sure that the resolution of the frequency series is
+	 * commensurate with the requested time series */
+	for (i = 0; i < gen->numDetectors; ++i)
+		if (! s[i] || s[i]->data->length != length
+				|| (size_t)floor(0.5 + 1.0/(s[i]->deltaT * gen->psdDeltaF[i])) != length)
+			XLAL_ERROR(XLAL_EINVAL);
+
+	/* stride cannot be longer than data length */
+	if (stride > length)
+		XLAL_ERROR(XLAL_EINVAL);
+
+	for (i = 0; i < gen->numDetectors; ++i) {
+		size_t stride_i = stride;
+		size_t numOverlap;
+
+		if (stride_i == 0) { /* generate segment with no feathering */
+			if (XLALSimNoiseGeneratorSegment(gen, i, s[i], rng))
+				XLAL_ERROR(XLAL_EFUNC);
+			continue;
+		} else if (stride_i == length) {
+			/* will generate two independent noise realizations
+			 * and feather them together with full overlap */
+			if (XLALSimNoiseGeneratorSegment(gen, i, s[i], rng))
+				XLAL_ERROR(XLAL_EFUNC);
+			stride_i = 0;
+		}
+		numOverlap = length - stride_i;
+
+		/* copy overlap region between the old and the new data to temporary storage */
+		memcpy(gen->overlap->data, s[i]->data->data + stride_i, numOverlap*sizeof(*gen->overlap->data));
+
+		/* generate the new data */
+		if (XLALSimNoiseGeneratorSegment(gen, i, s[i], rng))
+			XLAL_ERROR(XLAL_EFUNC);
+
+		/* feather old data in overlap region with new data */
+		if (XLALSimNoiseGeneratorFeather(gen, numOverlap))
+			XLAL_ERROR(XLAL_EFUNC);
+		for (j = 0; j < numOverlap; ++j)
+			s[i]->data->data[j] = gen->x->data[j]*gen->overlap->data[j] + gen->y->data[j]*s[i]->data->data[j];
+
+		/* advance time */
+		XLALGPSAdd(&s[i]->epoch, stride_i * s[i]->deltaT);
+	}
+
+	return 0;
+}
+
 /**
  * @brief Routine that may be used to generate sequential segments of data with
  * a specified stride from one segment to the next.
@@ -139,6 +318,11 @@ static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gs
  *   noise by generating two different realizations and feathering them
  *   together.
  *
+ * Each call sets up an FFT plan and the noise colouring from scratch; to
+ * stream noise for one or more detectors, use a generator created with
+ * XLALSimNoiseGeneratorCreate() and XLALSimNoiseGeneratorNext() instead,
+ * which produce the same data.
+ *
  * @warning Only the first stride points are valid.
  */
 int XLALSimNoise(
@@ -148,52 +332,21 @@ int XLALSimNoise(
 	gsl_rng *rng			/**< [in] GSL random number generator */
 )
 {
-	REAL8Vector *overlap;
-	size_t j;
-
-	/* Use a default RNG if a NULL pointer was passed in */
-	if (!rng)
-		rng = gsl_rng_alloc(gsl_rng_default);
+	LALSimNoiseGenerator *gen;
 
-	/* make sure that the resolution of the frequency series is
-	 * commensurate with the requested time series */
-	if (s->data->length/2 + 1 != psd->data->length
-			|| (size_t)floor(0.5 + 1.0/(s->deltaT * psd->deltaF)) != s->data->length)
-		XLAL_ERROR(XLAL_EINVAL);
+	if (! s || ! psd)
+		XLAL_ERROR(XLAL_EFAULT);
 
-	/* stride cannot be longer than data length */
-	if (stride > s->data->length)
-		XLAL_ERROR(XLAL_EINVAL);
-
-	if (stride == 0) { /* generate segment with no feathering */
-		XLALSimNoiseSegment(s, psd, rng);
-		return 0;
-	} else if (stride == s->data->length) {
-		/* will generate two independent noise realizations
-		 * and feather them together with full overlap */
-		XLALSimNoiseSegment(s, psd, rng);
-		stride = 0;
-	}
-
-	overlap = XLALCreateREAL8Sequence(s->data->length - stride);
-
-	/* copy overlap region between the old and the new data to temporary storage */
-	memcpy(overlap->data, s->data->data + stride, overlap->length*sizeof(*overlap->data));
-	
-	/* generate the new data */
-	XLALSimNoiseSegment(s, psd, rng);
+	gen = XLALSimNoiseGeneratorCreate(s->data->length, &psd, 1);
+	if (! gen)
+		XLAL_ERROR(XLAL_EFUNC);
 
-	/* feather old data in overlap region with new data */
-	for (j = 0; j < overlap->length; ++j) {
-		double x = cos(LAL_PI*j/(2.0 * overlap->length));
-		double y = sin(LAL_PI*j/(2.0 * overlap->length));
-		s->data->data[j] = x*overlap->data[j] + y*s->data->data[j];
+	if (XLALSimNoiseGeneratorNext(gen, &s, stride, rng)) {
+		XLALSimNoiseGeneratorDestroy(gen);
+		XLAL_ERROR(XLAL_EFUNC);
 	}
 
-	XLALDestroyREAL8Sequence(overlap);
-
-	/* advance time */
-	XLALGPSAdd(&s->epoch, stride * s->deltaT);
+	XLALSimNoiseGeneratorDestroy(gen);
 	return 0;
 }
 
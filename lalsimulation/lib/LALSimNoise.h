@@ -70,6 +70,13 @@ SWIGLAL(FUNCTION_POINTER(aLIGOQuantumHighFrequency, XLALSimNoisePSDAdvVirgo,
 
 int XLALSimNoise(REAL8TimeSeries *s, size_t stride, REAL8FrequencySeries *psd, gsl_rng *rng);
 
+/** Incomplete type for a coloured-noise generator for one or more detectors. */
+typedef struct tagLALSimNoiseGenerator LALSimNoiseGenerator;
+
+LALSimNoiseGenerator *XLALSimNoiseGeneratorCreate(size_t length, REAL8FrequencySeries **psds, size_t numDetectors);
+void XLALSimNoiseGeneratorDestroy(LALSimNoiseGenerator *gen);
+int XLALSimNoiseGeneratorNext(LALSimNoiseGenerator *gen, REAL8TimeSeries **s, size_t stride, gsl_rng *rng);
+
 
 /*
  * PSD GENERATION FUNCTIONS
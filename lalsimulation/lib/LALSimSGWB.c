@@ -33,60 +33,49 @@
 #include <lal/Units.h>
 #include <lal/LALSimSGWB.h>
 
-/* 
- * This routine generates a single segment of data.  Note that this segment is
- * generated in the frequency domain and is inverse Fourier transformed into
- * the time domain; consequently the data is periodic in the time domain.
+/* state of a stochastic-background generator for a network of detectors */
+struct tagLALSimSGWBGenerator {
+	size_t length;		/* length of the segments */
+	size_t numDetectors;	/* number of detectors in network */
+	LALDetector *detectors;	/* detectors in network */
+	REAL8Vector *OmegaGW;	/* sgwb spectrum */
+	double OmegaGWDeltaF;	/* frequency resolution of the sgwb spectrum */
+	double H0;		/* Hubble's constant (s) */
+	double deltaF;		/* frequency resolution of sigma and chol, or 0 */
+	double *sigma;		/* standard deviation at each frequency */
+	double *chol;		/* packed lower Cholesky factor of the correlation matrix at each frequency */
+	REAL8FFTPlan *plan;	/* reverse FFT plan of the segment length */
+	COMPLEX16FrequencySeries **htilde;	/* frequency-domain workspace of each detector */
+	REAL8Vector *overlap;	/* storage for the overlap between segments of all detectors */
+	REAL8Vector *x, *y;	/* feathering weights for an overlap of x->length points */
+};
+
+/* index of element (i,j), i >= j, of a packed lower-triangular matrix */
+#define CHOL_INDEX(i, j) ((i) * ((i) + 1) / 2 + (j))
+
+/*
+ * This routine computes the standard deviation and the Cholesky decomposition
+ * of the correlation matrix of the detectors at each frequency; these only
+ * depend on the frequency resolution, so are only recomputed if it changes.
  */
-static int XLALSimSGWBSegment(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, const REAL8FrequencySeries *OmegaGW, double H0, gsl_rng *rng)
+static int XLALSimSGWBGeneratorSetDeltaF(LALSimSGWBGenerator *gen, double deltaF)
 {
-#	define CLEANUP_AND_RETURN(errnum) do { \
-		if (htilde) for (i = 0; i < numDetectors; ++i) XLALDestroyCOMPLEX16FrequencySeries(htilde[i]); \
-		XLALFree(htilde); XLALDestroyREAL8FFTPlan(plan); gsl_matrix_free(R); \
-		if (errnum) XLAL_ERROR(errnum); else return 0; \
-		} while (0)
-	REAL8FFTPlan *plan = NULL;
-	COMPLEX16FrequencySeries **htilde = NULL;
-	gsl_matrix *R = NULL;
-	LIGOTimeGPS epoch;
+	const size_t numDetectors = gen->numDetectors;
+	const size_t numChol = numDetectors * (numDetectors + 1) / 2;
+	gsl_matrix *R;
 	double psdfac;
-	double deltaF;
-	size_t length;
 	size_t i, j, k;
 
-	epoch = h[0]->epoch;
-	length = h[0]->data->length;
-	deltaF = 1.0 / (length * h[0]->deltaT);
-	psdfac = 0.3 * pow(H0 / LAL_PI, 2.0);
+	psdfac = 0.3 * pow(gen->H0 / LAL_PI, 2.0);
 
 	R = gsl_matrix_alloc(numDetectors, numDetectors);
 	if (! R)
-		CLEANUP_AND_RETURN(XLAL_ENOMEM);
-
-	plan = XLALCreateReverseREAL8FFTPlan(length, 0);
-	if (! plan)
-		CLEANUP_AND_RETURN(XLAL_EFUNC);
-
-	/* allocate frequency series for the various detector strains */
-	htilde = LALCalloc(numDetectors, sizeof(*htilde));
-	if (! htilde)
-		CLEANUP_AND_RETURN(XLAL_ENOMEM);
-	for (i = 0; i < numDetectors; ++i) {
-		htilde[i] = XLALCreateCOMPLEX16FrequencySeries(h[i]->name, &epoch, 0.0, deltaF, &lalSecondUnit, length/2 + 1);
-		if (! htilde[i])
-			CLEANUP_AND_RETURN(XLAL_EFUNC);
-
-		/* correct units */
-		XLALUnitMultiply(&htilde[i]->sampleUnits, &htilde[i]->sampleUnits, &h[i]->sampleUnits);
-
-		/* set data to zero */
-		memset(htilde[i]->data->data, 0, htilde[i]->data->length * sizeof(*htilde[i]->data->data));
-	}
+		XLAL_ERROR(XLAL_ENOMEM);
 
 	/* compute frequencies (excluding DC and Nyquist) */
-	for (k = 1; k < length/2; ++k) {
+	for (k = 1; k < gen->length/2; ++k) {
 		double f = k * deltaF;
-		double sigma = 0.5 * sqrt(psdfac * OmegaGW->data->data[k] * pow(f, -3.0) / deltaF);
+		gen->sigma[k] = 0.5 * sqrt(psdfac * gen->OmegaGW->data[k] * pow(f, -3.0) / deltaF);
 
 		/* construct correlation matrix at this frequency */
 		/* diagonal elements of correlation matrix are unity */
@@ -94,7 +83,7 @@ static int XLALSimSGWBSegment(REAL8TimeSeries **h, const LALDetector *detectors,
 		/* now do the off-diagonal elements */
 		for (i = 0; i < numDetectors; ++i)
 			for (j = i + 1; j < numDetectors; ++j) {
-				double Rij = XLALSimSGWBOverlapReductionFunction(f, &detectors[i], &detectors[j]);
+				double Rij = XLALSimSGWBOverlapReductionFunction(f, &gen->detectors[i], &gen->detectors[j]);
 				/* if the two sites are the same, the overlap reduciton
 				 * function will be unity, but this will cause problems
 				 * for the cholesky decomposition; a hack is to make it
@@ -109,27 +98,99 @@ static int XLALSimSGWBSegment(REAL8TimeSeries **h, const LALDetector *detectors,
 		/* perform Cholesky decomposition */
 		gsl_linalg_cholesky_decomp(R);
 
+		/* keep the lower-diagonal part */
+		for (j = 0; j < numDetectors; ++j)
+			for (i = j; i < numDetectors; ++i)
+				gen->chol[k * numChol + CHOL_INDEX(i, j)] = gsl_matrix_get(R, i, j);
+	}
+
+	gsl_matrix_free(R);
+	gen->deltaF = deltaF;
+	return 0;
+}
+
+/* 
+ * This routine generates a single segment of data.  Note that this segment is
+ * generated in the frequency domain and is inverse Fourier transformed into
+ * the time domain; consequently the data is periodic in the time domain.
+ */
+static int XLALSimSGWBGeneratorSegment(LALSimSGWBGenerator *gen, REAL8TimeSeries **h, gsl_rng *rng)
+{
+	const size_t numDetectors = gen->numDetectors;
+	const size_t numChol = numDetectors * (numDetectors + 1) / 2;
+	COMPLEX16FrequencySeries **htilde = gen->htilde;
+	LIGOTimeGPS epoch;
+	double deltaF;
+	size_t length;
+	size_t i, j, k;
+
+	epoch = h[0]->epoch;
+	length = h[0]->data->length;
+	deltaF = 1.0 / (length * h[0]->deltaT);
+
+	if (deltaF != gen->deltaF)
+		if (XLALSimSGWBGeneratorSetDeltaF(gen, deltaF))
+			XLAL_ERROR(XLAL_EFUNC);
+
+	/* set up frequency series for the various detector strains */
+	for (i = 0; i < numDetectors; ++i) {
+		htilde[i]->epoch = epoch;
+		htilde[i]->deltaF = deltaF;
+
+		/* correct units */
+		htilde[i]->sampleUnits = lalSecondUnit;
+		XLALUnitMultiply(&htilde[i]->sampleUnits, &htilde[i]->sampleUnits, &h[i]->sampleUnits);
+
+		/* set data to zero */
+		memset(htilde[i]->data->data, 0, htilde[i]->data->length * sizeof(*htilde[i]->data->data));
+	}
+
+	/* compute frequencies (excluding DC and Nyquist) */
+	for (k = 1; k < length/2; ++k) {
+		double sigma = gen->sigma[k];
+		const double *L = gen->chol + k * numChol;
+
 		/* generate numDetector random numbers (both re and im parts) and use
  		 * lower-diagonal part of Cholesky decomposition to create correlations */
 		for (j = 0; j < numDetectors; ++j) {
 			double re = gsl_ran_gaussian_ziggurat(rng, sigma);
 			double im = gsl_ran_gaussian_ziggurat(rng, sigma);
 			for (i = j; i < numDetectors; ++i) {
-				htilde[i]->data->data[k] += gsl_matrix_get(R, i, j) * re;
-				htilde[i]->data->data[k] += I * gsl_matrix_get(R, i, j) * im;
+				htilde[i]->data->data[k] += L[CHOL_INDEX(i, j)] * re;
+				htilde[i]->data->data[k] += I * L[CHOL_INDEX(i, j)] * im;
 			}
 		}
 	}
 
 	/* now go back to the time domain */
 	for (i = 0; i < numDetectors; ++i)
-		XLALREAL8FreqTimeFFT(h[i], htilde[i], plan);
+		if (XLALREAL8FreqTimeFFT(h[i], htilde[i], gen->plan))
+			XLAL_ERROR(XLAL_EFUNC);
 
-	/* normal exit */
-	CLEANUP_AND_RETURN(0);
-#	undef CLEANUP_AND_RETURN
+	return 0;
 }
 
+/* make sure the feathering weights are for an overlap of n points */
+static int XLALSimSGWBGeneratorFeather(LALSimSGWBGenerator *gen, size_t n)
+{
+	size_t j;
+	if (gen->x && gen->x->length == n)
+		return 0;
+	XLALDestroyREAL8Sequence(gen->x);
+	XLALDestroyREAL8Sequence(gen->y);
+	gen->x = XLALCreateREAL8Sequence(n);
+	gen->y = XLALCreateREAL8Sequence(n);
+	if (! gen->x || ! gen->y)
+		XLAL_ERROR(XLAL_EFUNC);
+	for (j = 0; j < n; ++j) {
+		gen->x->data[j] = cos(LAL_PI*j/(2.0 * n));
+		gen->y->data[j] = sin(LAL_PI*j/(2.0 * n));
+	}
+	return 0;
+}
+
+#undef CHOL_INDEX
+
 /**
  * @addtogroup LALSimSGWB_c
  * @brief Routines to compute a stochastic gravitational-wave background
@@ -269,6 +330,11 @@ REAL8FrequencySeries *XLALSimSGWBOmegaGWPowerLawSpectrum(
  *   noise by generating two different realizations and feathering them
  *   together.
  *
+ * To generate many segments it is more efficient to create a generator with
+ * XLALSimSGWBGeneratorCreate() and call XLALSimSGWBGeneratorNext(), which
+ * produces the same data without setting up the FFT plan and the correlation
+ * matrices on every call.
+ *
  * @warning Only the first stride points are valid.
  */
 int XLALSimSGWB(
@@ -281,17 +347,134 @@ int XLALSimSGWB(
 	gsl_rng *rng				/**< [in] GSL random number generator */
 )
 {
-#	define CLEANUP_AND_RETURN(errnum) do { \
-		if (overlap) for (i = 0; i < numDetectors; ++i) XLALDestroyREAL8Sequence(overlap[i]); \
-		XLALFree(overlap); \
-		if (errnum) XLAL_ERROR(errnum); else return 0; \
-		} while (0)
-	REAL8Vector **overlap = NULL;
+	LALSimSGWBGenerator *gen;
+
+	gen = XLALSimSGWBGeneratorCreate(detectors, numDetectors, h[0]->data->length, OmegaGW, H0);
+	if (! gen)
+		XLAL_ERROR(XLAL_EFUNC);
+	if (XLALSimSGWBGeneratorNext(gen, h, stride, rng)) {
+		XLALSimSGWBGeneratorDestroy(gen);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	XLALSimSGWBGeneratorDestroy(gen);
+	return 0;
+}
+
+
+/**
+ * Creates a generator that produces sequential segments of stochastic
+ * background gravitational wave signals for a network of detectors.
+ *
+ * The generator holds the FFT plan, the frequency-domain workspace, the
+ * overlap and feathering storage and, once the first segment has been made,
+ * the overlap reduction functions and their Cholesky decompositions at all
+ * frequencies, so that streaming data with XLALSimSGWBGeneratorNext() does no
+ * further setup or memory allocation.  The detectors and the spectrum are
+ * copied and need not be kept.
+ */
+LALSimSGWBGenerator *XLALSimSGWBGeneratorCreate(
+	const LALDetector *detectors,		/**< [in] array of detectors in network */
+	size_t numDetectors,			/**< [in] number of detectors in network */
+	size_t length,				/**< [in] length of the segments (samples) */
+	const REAL8FrequencySeries *OmegaGW,	/**< [in] sgwb spectrum frequeny series */
+	double H0				/**< [in] Hubble's constant (s) */
+)
+{
+	LALSimSGWBGenerator *gen;
+	LIGOTimeGPS epoch = LIGOTIMEGPSZERO;
+	size_t i;
+
+	if (! detectors || ! OmegaGW)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (numDetectors == 0 || length == 0 || OmegaGW->data->length != length/2 + 1)
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+
+	gen = LALCalloc(1, sizeof(*gen));
+	if (! gen)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	gen->length = length;
+	gen->numDetectors = numDetectors;
+	gen->OmegaGWDeltaF = OmegaGW->deltaF;
+	gen->H0 = H0;
+	gen->detectors = LALMalloc(numDetectors * sizeof(*gen->detectors));
+	gen->OmegaGW = XLALCreateREAL8Sequence(OmegaGW->data->length);
+	gen->sigma = LALMalloc((length/2 + 1) * sizeof(*gen->sigma));
+	gen->chol = LALMalloc((length/2 + 1) * numDetectors * (numDetectors + 1) / 2 * sizeof(*gen->chol));
+	gen->plan = XLALCreateReverseREAL8FFTPlan(length, 0);
+	gen->htilde = LALCalloc(numDetectors, sizeof(*gen->htilde));
+	gen->overlap = XLALCreateREAL8Sequence(numDetectors * length);
+	if (! gen->detectors || ! gen->OmegaGW || ! gen->sigma || ! gen->chol || ! gen->plan || ! gen->htilde || ! gen->overlap) {
+		XLALSimSGWBGeneratorDestroy(gen);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	for (i = 0; i < numDetectors; ++i) {
+		gen->htilde[i] = XLALCreateCOMPLEX16FrequencySeries("HTILDE", &epoch, 0.0, OmegaGW->deltaF, &lalSecondUnit, length/2 + 1);
+		if (! gen->htilde[i]) {
+			XLALSimSGWBGeneratorDestroy(gen);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		}
+	}
+
+	memcpy(gen->detectors, detectors, numDetectors * sizeof(*gen->detectors));
+	memcpy(gen->OmegaGW->data, OmegaGW->data->data, OmegaGW->data->length * sizeof(*gen->OmegaGW->data));
+
+	return gen;
+}
+
+
+/**
+ * Destroys a stochastic background generator.
+ */
+void XLALSimSGWBGeneratorDestroy(LALSimSGWBGenerator *gen)
+{
+	size_t i;
+	if (gen) {
+		if (gen->htilde)
+			for (i = 0; i < gen->numDetectors; ++i)
+				XLALDestroyCOMPLEX16FrequencySeries(gen->htilde[i]);
+		LALFree(gen->htilde);
+		LALFree(gen->detectors);
+		XLALDestroyREAL8Sequence(gen->OmegaGW);
+		LALFree(gen->sigma);
+		LALFree(gen->chol);
+		XLALDestroyREAL8FFTPlan(gen->plan);
+		XLALDestroyREAL8Sequence(gen->overlap);
+		XLALDestroyREAL8Sequence(gen->x);
+		XLALDestroyREAL8Sequence(gen->y);
+		LALFree(gen);
+	}
+}
+
+
+/**
+ * Generates the next segment of stochastic background gravitational wave
+ * signals for the network of detectors of a generator.
+ *
+ * This routine behaves exactly as XLALSimSGWB() called with the detectors,
+ * spectrum and Hubble's constant that the generator was created with, and
+ * produces bit-identical data for the same RNG; see XLALSimSGWB() for the
+ * calling instructions.  The time series must all have the length of the
+ * generator.
+ *
+ * @warning Only the first stride points are valid.
+ */
+int XLALSimSGWBGeneratorNext(
+	LALSimSGWBGenerator *gen,		/**< [in] sgwb generator */
+	REAL8TimeSeries **h,			/**< [in/out] array of sgwb timeseries for detector network */
+	size_t stride,				/**< [in] stride (samples) */
+	gsl_rng *rng				/**< [in] GSL random number generator */
+)
+{
 	LIGOTimeGPS epoch;
+	size_t numDetectors;
 	size_t length;
 	double deltaT;
 	size_t i, j;
 
+	if (! gen || ! h)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	numDetectors = gen->numDetectors;
 	length = h[0]->data->length;
 	deltaT = h[0]->deltaT;
 	epoch = h[0]->epoch;
@@ -305,8 +488,8 @@ int XLALSimSGWB(
 
 	/* make sure that the resolution of the frequency series is
 	 * commensurate with the requested time series */
-	if (length/2 + 1 != OmegaGW->data->length
-			|| (size_t)floor(0.5 + 1.0/(deltaT * OmegaGW->deltaF)) != length)
+	if (length != gen->length
+			|| (size_t)floor(0.5 + 1.0/(deltaT * gen->OmegaGWDeltaF)) != length)
 		XLAL_ERROR(XLAL_EINVAL);
 
 	/* stride cannot be longer than data length */
@@ -314,44 +497,39 @@ int XLALSimSGWB(
 		XLAL_ERROR(XLAL_EINVAL);
 
 	if (stride == 0) { /* generate segment with no feathering */
-		XLALSimSGWBSegment(h, detectors, numDetectors, OmegaGW, H0, rng);
+		if (XLALSimSGWBGeneratorSegment(gen, h, rng))
+			XLAL_ERROR(XLAL_EFUNC);
 		return 0;
 	} else if (stride == length) {
 		/* will generate two independent noise realizations
 		 * and feather them together with full overlap */
-		XLALSimSGWBSegment(h, detectors, numDetectors, OmegaGW, H0, rng);
+		if (XLALSimSGWBGeneratorSegment(gen, h, rng))
+			XLAL_ERROR(XLAL_EFUNC);
 		stride = 0;
 	}
 
-	overlap = LALCalloc(numDetectors, sizeof(*overlap));
-	if (! overlap)
-		XLAL_ERROR(XLAL_ENOMEM);
-	for (i = 0; i < numDetectors; ++i) {
-		overlap[i] = XLALCreateREAL8Sequence(length - stride);
-		if (! overlap[i])
-			CLEANUP_AND_RETURN(XLAL_EFUNC);
-		/* copy overlap region between the old and the new data to temporary storage */
-		memcpy(overlap[i]->data, h[i]->data->data + stride, overlap[i]->length*sizeof(*overlap[i]->data));
-	}
+	/* copy overlap region between the old and the new data to temporary storage */
+	for (i = 0; i < numDetectors; ++i)
+		memcpy(gen->overlap->data + i * length, h[i]->data->data + stride, (length - stride)*sizeof(*gen->overlap->data));
 
-	if (XLALSimSGWBSegment(h, detectors, numDetectors, OmegaGW, H0, rng))
-		CLEANUP_AND_RETURN(XLAL_EFUNC);
+	if (XLALSimSGWBGeneratorSegment(gen, h, rng))
+		XLAL_ERROR(XLAL_EFUNC);
 
 	/* feather old data in overlap region with new data */
+	if (XLALSimSGWBGeneratorFeather(gen, length - stride))
+		XLAL_ERROR(XLAL_EFUNC);
 	for (j = 0; j < length - stride; ++j) {
-		double x = cos(LAL_PI*j/(2.0 * (length - stride)));
-		double y = sin(LAL_PI*j/(2.0 * (length - stride)));
+		double x = gen->x->data[j];
+		double y = gen->y->data[j];
 		for (i = 0; i < numDetectors; ++i)
-			h[i]->data->data[j] = x*overlap[i]->data[j] + y*h[i]->data->data[j];
+			h[i]->data->data[j] = x*gen->overlap->data[i * length + j] + y*h[i]->data->data[j];
 	}
 
 	/* advance time */
 	for (i = 0; i < numDetectors; ++i)
 		XLALGPSAdd(&h[i]->epoch, stride * deltaT);
 
-	/* success */
-	CLEANUP_AND_RETURN(0);
-#	undef CLEANUP_AND_RETURN
+	return 0;
 }
 
 
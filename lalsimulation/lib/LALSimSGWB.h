@@ -69,6 +69,13 @@ int XLALSimSGWB(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDet
 int XLALSimSGWBFlatSpectrum(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, size_t stride, double Omega0, double flow, double H0, gsl_rng *rng);
 int XLALSimSGWBPowerLawSpectrum(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, size_t stride, double Omegaref, double alpha, double fref, double flow, double H0, gsl_rng *rng);
 
+/** Incomplete type for a stochastic background generator for a network of detectors. */
+typedef struct tagLALSimSGWBGenerator LALSimSGWBGenerator;
+
+LALSimSGWBGenerator *XLALSimSGWBGeneratorCreate(const LALDetector *detectors, size_t numDetectors, size_t length, const REAL8FrequencySeries *OmegaGW, double H0);
+void XLALSimSGWBGeneratorDestroy(LALSimSGWBGenerator *gen);
+int XLALSimSGWBGeneratorNext(LALSimSGWBGenerator *gen, REAL8TimeSeries **h, size_t stride, gsl_rng *rng);
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
@@ -0,0 +1,180 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests of the adaptive neutron star families against the fixed-grid
+ * families, and of the neutron star family cache.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALSimNeutronStar.h>
+
+/* Midpoint tolerance of the adaptive families, as used by LALInference */
+#define FAMILY_TOLERANCE 1e-2
+
+/*
+ * Allowed relative differences between the adaptive and fixed-grid
+ * families, for masses from 1 solar mass to 98% of the maximum mass.  The
+ * measured differences are at most 4e-3 in Lambda and 2e-4 in R, which is
+ * also the size of the interpolation error of the fixed-grid families.
+ * Both are far below the statistical uncertainties of parameter estimation,
+ * which are tens of percent in Lambda and several percent in R.  Just below
+ * the maximum mass, Lambda is a steep function of mass and the two families
+ * may differ by more.
+ */
+#define LAMBDA_TOLERANCE 1e-2
+#define RADIUS_TOLERANCE 1e-3
+#define MAX_MASS_TOLERANCE 1e-3
+
+/* 4-parameter piecewise polytropes (log10 p1 in cgs units, Gamma1-3) */
+static const struct {
+    const char *name;
+    double logp1, gamma1, gamma2, gamma3;
+} polytropes[] = {
+    {"SLy", 34.384, 3.005, 2.988, 2.851},
+    {"APR4", 34.269, 2.830, 3.445, 3.348},
+    {"MPA1", 34.495, 3.446, 3.572, 2.887},
+    {"H4", 34.669, 2.909, 2.246, 2.144},
+    {"MS1", 34.858, 3.224, 3.033, 1.325},
+    {"WFF1", 34.031, 2.519, 3.791, 3.660},
+};
+
+static int compare_families(const char *name, LALSimNeutronStarEOS *eos)
+{
+    LALSimNeutronStarFamily *fixed = XLALCreateSimNeutronStarFamily(eos);
+    LALSimNeutronStarFamily *adaptive = XLALCreateSimNeutronStarFamilyAdaptive(eos, FAMILY_TOLERANCE);
+    XLAL_CHECK(fixed && adaptive, XLAL_EFUNC);
+
+    const double mmax = XLALSimNeutronStarMaximumMass(fixed);
+    const double mmax_adaptive = XLALSimNeutronStarMaximumMass(adaptive);
+    XLAL_CHECK(fabs(mmax_adaptive / mmax - 1.0) < MAX_MASS_TOLERANCE, XLAL_ETOL,
+        "%s: maximum masses %g and %g differ", name, mmax / LAL_MSUN_SI, mmax_adaptive / LAL_MSUN_SI);
+
+    const size_t n = 100;
+    double m[n], lambda[n], r[n], lambda_adaptive[n], r_adaptive[n];
+    const double mlo = 1.0 * LAL_MSUN_SI, mhi = 0.98 * fmin(mmax, mmax_adaptive);
+    for (size_t i = 0; i < n; ++i)
+        m[i] = mlo + (mhi - mlo) * i / (n - 1);
+    XLAL_CHECK(XLALSimNeutronStarTidalDeformabilities(lambda, r, m, n, fixed) == 0, XLAL_EFUNC);
+    XLAL_CHECK(XLALSimNeutronStarTidalDeformabilities(lambda_adaptive, r_adaptive, m, n, adaptive) == 0, XLAL_EFUNC);
+
+    double dlambda = 0.0, dr = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        dlambda = fmax(dlambda, fabs(lambda_adaptive[i] / lambda[i] - 1.0));
+        dr = fmax(dr, fabs(r_adaptive[i] / r[i] - 1.0));
+        /* the single-mass routines agree with the batch routine */
+        XLAL_CHECK(XLALSimNeutronStarRadius(m[i], fixed) == r[i], XLAL_EFAILED, "%s: radius mismatch", name);
+    }
+    printf("%-5s Mmax = %.4f Msun, max |dLambda/Lambda| = %.2e, max |dR/R| = %.2e\n", name, mmax / LAL_MSUN_SI, dlambda, dr);
+    XLAL_CHECK(dlambda < LAMBDA_TOLERANCE, XLAL_ETOL, "%s: adaptive and fixed Lambda differ by %g", name, dlambda);
+    XLAL_CHECK(dr < RADIUS_TOLERANCE, XLAL_ETOL, "%s: adaptive and fixed R differ by %g", name, dr);
+
+    /* masses outside the family are an error */
+    const double mbad = 1.01 * mmax_adaptive;
+    int errnum;
+    XLAL_TRY_SILENT(XLALSimNeutronStarTidalDeformabilities(lambda, NULL, &mbad, 1, adaptive), errnum);
+    XLAL_CHECK(errnum == XLAL_EDOM, XLAL_EFAILED, "%s: mass above maximum mass not rejected", name);
+
+    XLALDestroySimNeutronStarFamily(adaptive);
+    XLALDestroySimNeutronStarFamily(fixed);
+    return XLAL_SUCCESS;
+}
+
+static int test_cache(void)
+{
+    LALSimNeutronStarFamilyCache *cache = XLALCreateSimNeutronStarFamilyCache(2);
+    XLAL_CHECK(cache, XLAL_EFUNC);
+
+    const double key[3][2] = {{0, 1}, {0, 2}, {0, 3}};
+    LALSimNeutronStarEOS *eos[3];
+    LALSimNeutronStarFamily *fam[3];
+    LALSimNeutronStarEOS *found_eos;
+    LALSimNeutronStarFamily *found_fam;
+    for (int i = 0; i < 3; ++i) {
+        eos[i] = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(polytropes[i].logp1 - 1.0,
+            polytropes[i].gamma1, polytropes[i].gamma2, polytropes[i].gamma3);
+        XLAL_CHECK(eos[i], XLAL_EFUNC);
+    }
+    fam[0] = XLALCreateSimNeutronStarFamilyAdaptive(eos[0], FAMILY_TOLERANCE);
+    fam[1] = NULL; /* a rejected equation of state */
+    fam[2] = XLALCreateSimNeutronStarFamilyAdaptive(eos[2], FAMILY_TOLERANCE);
+    XLAL_CHECK(fam[0] && fam[2], XLAL_EFUNC);
+
+    /* empty cache */
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheLookup(cache, key[0], 2, &found_eos, &found_fam) == 0, XLAL_EFAILED);
+
+    /* hits return the cached pointers, including a missing family */
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheInsert(cache, key[0], 2, eos[0], fam[0]) == 0, XLAL_EFUNC);
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheInsert(cache, key[1], 2, eos[1], fam[1]) == 0, XLAL_EFUNC);
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheLookup(cache, key[1], 2, &found_eos, &found_fam) == 1, XLAL_EFAILED);
+    XLAL_CHECK(found_eos == eos[1] && found_fam == NULL, XLAL_EFAILED);
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheLookup(cache, key[0], 2, &found_eos, &found_fam) == 1, XLAL_EFAILED);
+    XLAL_CHECK(found_eos == eos[0] && found_fam == fam[0], XLAL_EFAILED);
+
+    /* keys of a different length never match */
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheLookup(cache, key[0], 1, &found_eos, &found_fam) == 0, XLAL_EFAILED);
+
+    /* inserting into a full cache evicts the least recently used entry,
+     * which is key[1] since key[0] was looked up last */
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheInsert(cache, key[2], 2, eos[2], fam[2]) == 0, XLAL_EFUNC);
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheLookup(cache, key[1], 2, &found_eos, &found_fam) == 0, XLAL_EFAILED,
+        "Least recently used entry was not evicted");
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheLookup(cache, key[0], 2, &found_eos, &found_fam) == 1, XLAL_EFAILED,
+        "Recently used entry was evicted");
+    XLAL_CHECK(found_eos == eos[0] && found_fam == fam[0], XLAL_EFAILED);
+    XLAL_CHECK(XLALSimNeutronStarFamilyCacheLookup(cache, key[2], 2, &found_eos, &found_fam) == 1, XLAL_EFAILED);
+    XLAL_CHECK(found_eos == eos[2] && found_fam == fam[2], XLAL_EFAILED);
+
+    /* a cached family is still usable */
+    const double m = 1.4 * LAL_MSUN_SI;
+    double lambda;
+    XLAL_CHECK(XLALSimNeutronStarTidalDeformabilities(&lambda, NULL, &m, 1, found_fam) == 0, XLAL_EFUNC);
+    XLAL_CHECK(lambda > 0.0, XLAL_EFAILED);
+
+    /* the cache owns, and frees, the remaining equations of state and families */
+    XLALDestroySimNeutronStarFamilyCache(cache);
+    return XLAL_SUCCESS;
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < XLAL_NUM_ELEM(polytropes); ++i) {
+        LALSimNeutronStarEOS *eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(polytropes[i].logp1 - 1.0,
+            polytropes[i].gamma1, polytropes[i].gamma2, polytropes[i].gamma3);
+        XLAL_CHECK_MAIN(eos, XLAL_EFUNC);
+        XLAL_CHECK_MAIN(compare_families(polytropes[i].name, eos) == XLAL_SUCCESS, XLAL_EFUNC);
+        XLALDestroySimNeutronStarEOS(eos);
+    }
+
+    /* spectral decomposition */
+    double gamma[4] = {0.8651, 0.1548, -0.0151, -0.0002};
+    LALSimNeutronStarEOS *eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma, 4);
+    XLAL_CHECK_MAIN(eos, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(compare_families("SD", eos) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLALDestroySimNeutronStarEOS(eos);
+
+    XLAL_CHECK_MAIN(test_cache() == XLAL_SUCCESS, XLAL_EFUNC);
+
+    LALCheckMemoryLeaks();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,323 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests that the coloured-noise and stochastic-background generators produce
+ * the same data, bit for bit, as repeated calls to XLALSimNoise() and
+ * XLALSimSGWB() and as the original implementations of these routines, which
+ * set up the FFT plan and the correlation matrices on every call, for the
+ * same seed of the random number generator.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+#include <lal/Date.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDetectors.h>
+#include <lal/LALStdlib.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Sequence.h>
+#include <lal/TimeSeries.h>
+#include <lal/TimeFreqFFT.h>
+#include <lal/Units.h>
+#include <lal/LALSimNoise.h>
+#include <lal/LALSimSGWB.h>
+
+#define SEED 20170817
+#define SRATE 1024.0
+#define DURATION 4.0
+#define LENGTH ((size_t)(SRATE * DURATION))
+#define FLOW 10.0
+#define NUM_NOISE_DETECTORS 2
+#define NUM_SGWB_DETECTORS 3
+
+/* strides of successive calls: initialise, then overlapping segments of
+ * different lengths, a single non-periodic segment, and a final stride */
+static const size_t strides[] = {0, LENGTH / 2, LENGTH / 4, 3 * LENGTH / 4, LENGTH, LENGTH / 2};
+
+/*
+ * The original implementation of XLALSimNoise(), which creates an FFT plan
+ * and computes the noise colouring for every segment.
+ */
+static int reference_noise_segment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gsl_rng *rng)
+{
+	REAL8FFTPlan *plan = XLALCreateReverseREAL8FFTPlan(s->data->length, 0);
+	COMPLEX16FrequencySeries *stilde = XLALCreateCOMPLEX16FrequencySeries("STILDE", &s->epoch, 0.0, 1.0/(s->data->length * s->deltaT), &lalDimensionlessUnit, s->data->length/2 + 1);
+	size_t k;
+	XLAL_CHECK(plan && stilde, XLAL_EFUNC);
+	XLALUnitMultiply(&stilde->sampleUnits, &psd->sampleUnits, &lalSecondUnit);
+	XLALUnitSqrt(&stilde->sampleUnits, &stilde->sampleUnits);
+	for (k = 0; k < s->data->length/2 + 1; ++k) {
+		double sigma = 0.5 * sqrt(psd->data->data[k] / psd->deltaF);
+		stilde->data->data[k] = gsl_ran_gaussian_ziggurat(rng, sigma);
+		stilde->data->data[k] += I * gsl_ran_gaussian_ziggurat(rng, sigma);
+	}
+	XLAL_CHECK(XLALREAL8FreqTimeFFT(s, stilde, plan) == 0, XLAL_EFUNC);
+	XLALDestroyCOMPLEX16FrequencySeries(stilde);
+	XLALDestroyREAL8FFTPlan(plan);
+	return 0;
+}
+
+static int reference_noise(REAL8TimeSeries *s, size_t stride, REAL8FrequencySeries *psd, gsl_rng *rng)
+{
+	REAL8Vector *overlap;
+	size_t j;
+	if (stride == 0)
+		return reference_noise_segment(s, psd, rng);
+	if (stride == s->data->length) {
+		XLAL_CHECK(reference_noise_segment(s, psd, rng) == 0, XLAL_EFUNC);
+		stride = 0;
+	}
+	overlap = XLALCreateREAL8Sequence(s->data->length - stride);
+	XLAL_CHECK(overlap, XLAL_EFUNC);
+	memcpy(overlap->data, s->data->data + stride, overlap->length * sizeof(*overlap->data));
+	XLAL_CHECK(reference_noise_segment(s, psd, rng) == 0, XLAL_EFUNC);
+	for (j = 0; j < overlap->length; ++j) {
+		double x = cos(LAL_PI*j/(2.0 * overlap->length));
+		double y = sin(LAL_PI*j/(2.0 * overlap->length));
+		s->data->data[j] = x*overlap->data[j] + y*s->data->data[j];
+	}
+	XLALDestroyREAL8Sequence(overlap);
+	XLALGPSAdd(&s->epoch, stride * s->deltaT);
+	return 0;
+}
+
+/*
+ * The original implementation of XLALSimSGWB(), which creates an FFT plan and
+ * computes the overlap reduction functions and their Cholesky decompositions
+ * for every segment.
+ */
+static int reference_sgwb_segment(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, const REAL8FrequencySeries *OmegaGW, double H0, gsl_rng *rng)
+{
+	const size_t length = h[0]->data->length;
+	const double deltaF = 1.0 / (length * h[0]->deltaT);
+	const double psdfac = 0.3 * pow(H0 / LAL_PI, 2.0);
+	gsl_matrix *R = gsl_matrix_alloc(numDetectors, numDetectors);
+	REAL8FFTPlan *plan = XLALCreateReverseREAL8FFTPlan(length, 0);
+	COMPLEX16FrequencySeries *htilde[NUM_SGWB_DETECTORS];
+	size_t i, j, k;
+	XLAL_CHECK(R && plan && numDetectors <= NUM_SGWB_DETECTORS, XLAL_EFUNC);
+	for (i = 0; i < numDetectors; ++i) {
+		htilde[i] = XLALCreateCOMPLEX16FrequencySeries(h[i]->name, &h[0]->epoch, 0.0, deltaF, &lalSecondUnit, length/2 + 1);
+		XLAL_CHECK(htilde[i], XLAL_EFUNC);
+		XLALUnitMultiply(&htilde[i]->sampleUnits, &htilde[i]->sampleUnits, &h[i]->sampleUnits);
+		memset(htilde[i]->data->data, 0, htilde[i]->data->length * sizeof(*htilde[i]->data->data));
+	}
+	for (k = 1; k < length/2; ++k) {
+		double f = k * deltaF;
+		double sigma = 0.5 * sqrt(psdfac * OmegaGW->data->data[k] * pow(f, -3.0) / deltaF);
+		gsl_matrix_set_identity(R);
+		for (i = 0; i < numDetectors; ++i)
+			for (j = i + 1; j < numDetectors; ++j) {
+				double Rij = XLALSimSGWBOverlapReductionFunction(f, &detectors[i], &detectors[j]);
+				if (fabs(Rij - 1.0) < LAL_REAL4_EPS)
+					Rij = 1.0 - LAL_REAL4_EPS;
+				gsl_matrix_set(R, i, j, Rij);
+				gsl_matrix_set(R, j, i, Rij);
+			}
+		gsl_linalg_cholesky_decomp(R);
+		for (j = 0; j < numDetectors; ++j) {
+			double re = gsl_ran_gaussian_ziggurat(rng, sigma);
+			double im = gsl_ran_gaussian_ziggurat(rng, sigma);
+			for (i = j; i < numDetectors; ++i) {
+				htilde[i]->data->data[k] += gsl_matrix_get(R, i, j) * re;
+				htilde[i]->data->data[k] += I * gsl_matrix_get(R, i, j) * im;
+			}
+		}
+	}
+	for (i = 0; i < numDetectors; ++i) {
+		XLAL_CHECK(XLALREAL8FreqTimeFFT(h[i], htilde[i], plan) == 0, XLAL_EFUNC);
+		XLALDestroyCOMPLEX16FrequencySeries(htilde[i]);
+	}
+	XLALDestroyREAL8FFTPlan(plan);
+	gsl_matrix_free(R);
+	return 0;
+}
+
+static int reference_sgwb(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, size_t stride, const REAL8FrequencySeries *OmegaGW, double H0, gsl_rng *rng)
+{
+	const size_t length = h[0]->data->length;
+	REAL8Vector *overlap[NUM_SGWB_DETECTORS];
+	size_t i, j;
+	if (stride == 0)
+		return reference_sgwb_segment(h, detectors, numDetectors, OmegaGW, H0, rng);
+	if (stride == length) {
+		XLAL_CHECK(reference_sgwb_segment(h, detectors, numDetectors, OmegaGW, H0, rng) == 0, XLAL_EFUNC);
+		stride = 0;
+	}
+	for (i = 0; i < numDetectors; ++i) {
+		overlap[i] = XLALCreateREAL8Sequence(length - stride);
+		XLAL_CHECK(overlap[i], XLAL_EFUNC);
+		memcpy(overlap[i]->data, h[i]->data->data + stride, overlap[i]->length * sizeof(*overlap[i]->data));
+	}
+	XLAL_CHECK(reference_sgwb_segment(h, detectors, numDetectors, OmegaGW, H0, rng) == 0, XLAL_EFUNC);
+	for (j = 0; j < length - stride; ++j) {
+		double x = cos(LAL_PI*j/(2.0 * (length - stride)));
+		double y = sin(LAL_PI*j/(2.0 * (length - stride)));
+		for (i = 0; i < numDetectors; ++i)
+			h[i]->data->data[j] = x*overlap[i]->data[j] + y*h[i]->data->data[j];
+	}
+	for (i = 0; i < numDetectors; ++i) {
+		XLALDestroyREAL8Sequence(overlap[i]);
+		XLALGPSAdd(&h[i]->epoch, stride * h[i]->deltaT);
+	}
+	return 0;
+}
+
+/* time series must have the same epoch and bit-identical data, which is
+ * finite and not all zero */
+static int compare_series(const char *what, size_t call, const REAL8TimeSeries *a, const REAL8TimeSeries *b)
+{
+	size_t j, nonzero = 0;
+	for (j = 0; j < a->data->length; ++j) {
+		XLAL_CHECK(isfinite(a->data->data[j]), XLAL_EFPINVAL, "%s, call %zu: data of %s not finite", what, call, a->name);
+		nonzero += a->data->data[j] != 0.0;
+	}
+	XLAL_CHECK(nonzero > 0, XLAL_EFAILED, "%s, call %zu: data of %s all zero", what, call, a->name);
+	XLAL_CHECK(XLALGPSCmp(&a->epoch, &b->epoch) == 0, XLAL_EFAILED, "%s, call %zu: epochs of %s differ", what, call, a->name);
+	XLAL_CHECK(memcmp(a->data->data, b->data->data, a->data->length * sizeof(*a->data->data)) == 0, XLAL_EFAILED, "%s, call %zu: data of %s differ", what, call, a->name);
+	return 0;
+}
+
+static int test_noise(void)
+{
+	const LIGOTimeGPS epoch = {1000000000, 0};
+	const char *names[NUM_NOISE_DETECTORS] = {"H1:STRAIN", "L1:STRAIN"};
+	REAL8FrequencySeries *psd[NUM_NOISE_DETECTORS];
+	REAL8TimeSeries *gen_s[NUM_NOISE_DETECTORS], *wrap_s[NUM_NOISE_DETECTORS], *ref_s[NUM_NOISE_DETECTORS];
+	gsl_rng *gen_rng = gsl_rng_alloc(gsl_rng_mt19937);
+	gsl_rng *wrap_rng = gsl_rng_alloc(gsl_rng_mt19937);
+	gsl_rng *ref_rng = gsl_rng_alloc(gsl_rng_mt19937);
+	LALSimNoiseGenerator *gen;
+	size_t i, n;
+
+	XLAL_CHECK(gen_rng && wrap_rng && ref_rng, XLAL_ENOMEM);
+	gsl_rng_set(gen_rng, SEED);
+	gsl_rng_set(wrap_rng, SEED);
+	gsl_rng_set(ref_rng, SEED);
+
+	for (i = 0; i < NUM_NOISE_DETECTORS; ++i) {
+		psd[i] = XLALCreateREAL8FrequencySeries("PSD", &epoch, 0.0, 1.0 / DURATION, &lalSecondUnit, LENGTH/2 + 1);
+		XLAL_CHECK(psd[i], XLAL_EFUNC);
+		XLAL_CHECK(XLALSimNoisePSD(psd[i], FLOW, i ? XLALSimNoisePSDiLIGOSRD : XLALSimNoisePSDaLIGOZeroDetHighPower) == 0, XLAL_EFUNC);
+		gen_s[i] = XLALCreateREAL8TimeSeries(names[i], &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+		wrap_s[i] = XLALCreateREAL8TimeSeries(names[i], &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+		ref_s[i] = XLALCreateREAL8TimeSeries(names[i], &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+		XLAL_CHECK(gen_s[i] && wrap_s[i] && ref_s[i], XLAL_EFUNC);
+	}
+
+	gen = XLALSimNoiseGeneratorCreate(LENGTH, psd, NUM_NOISE_DETECTORS);
+	XLAL_CHECK(gen, XLAL_EFUNC);
+
+	/* the generator fills the detectors in turn, as calling XLALSimNoise() for each would */
+	for (n = 0; n < XLAL_NUM_ELEM(strides); ++n) {
+		XLAL_CHECK(XLALSimNoiseGeneratorNext(gen, gen_s, strides[n], gen_rng) == 0, XLAL_EFUNC);
+		for (i = 0; i < NUM_NOISE_DETECTORS; ++i) {
+			XLAL_CHECK(XLALSimNoise(wrap_s[i], strides[n], psd[i], wrap_rng) == 0, XLAL_EFUNC);
+			XLAL_CHECK(reference_noise(ref_s[i], strides[n], psd[i], ref_rng) == 0, XLAL_EFUNC);
+			XLAL_CHECK(compare_series("XLALSimNoise", n, gen_s[i], wrap_s[i]) == 0, XLAL_EFUNC);
+			XLAL_CHECK(compare_series("reference noise", n, gen_s[i], ref_s[i]) == 0, XLAL_EFUNC);
+		}
+	}
+
+	XLALSimNoiseGeneratorDestroy(gen);
+	for (i = 0; i < NUM_NOISE_DETECTORS; ++i) {
+		XLALDestroyREAL8FrequencySeries(psd[i]);
+		XLALDestroyREAL8TimeSeries(gen_s[i]);
+		XLALDestroyREAL8TimeSeries(wrap_s[i]);
+		XLALDestroyREAL8TimeSeries(ref_s[i]);
+	}
+	gsl_rng_free(gen_rng);
+	gsl_rng_free(wrap_rng);
+	gsl_rng_free(ref_rng);
+	return 0;
+}
+
+static int test_sgwb(void)
+{
+	const LIGOTimeGPS epoch = {1000000000, 0};
+	const double H0 = 0.72 * LAL_H0FAC_SI;
+	const LALDetector detectors[NUM_SGWB_DETECTORS] = {
+		lalCachedDetectors[LAL_LHO_4K_DETECTOR],
+		lalCachedDetectors[LAL_LLO_4K_DETECTOR],
+		lalCachedDetectors[LAL_VIRGO_DETECTOR]
+	};
+	const char *names[NUM_SGWB_DETECTORS] = {"H1:STRAIN", "L1:STRAIN", "V1:STRAIN"};
+	REAL8FrequencySeries *OmegaGW;
+	REAL8TimeSeries *gen_h[NUM_SGWB_DETECTORS], *wrap_h[NUM_SGWB_DETECTORS], *ref_h[NUM_SGWB_DETECTORS];
+	gsl_rng *gen_rng = gsl_rng_alloc(gsl_rng_mt19937);
+	gsl_rng *wrap_rng = gsl_rng_alloc(gsl_rng_mt19937);
+	gsl_rng *ref_rng = gsl_rng_alloc(gsl_rng_mt19937);
+	LALSimSGWBGenerator *gen;
+	size_t i, n;
+
+	XLAL_CHECK(gen_rng && wrap_rng && ref_rng, XLAL_ENOMEM);
+	gsl_rng_set(gen_rng, SEED);
+	gsl_rng_set(wrap_rng, SEED);
+	gsl_rng_set(ref_rng, SEED);
+
+	OmegaGW = XLALSimSGWBOmegaGWFlatSpectrum(1e-6, FLOW, 1.0 / DURATION, LENGTH/2 + 1);
+	XLAL_CHECK(OmegaGW, XLAL_EFUNC);
+	for (i = 0; i < NUM_SGWB_DETECTORS; ++i) {
+		gen_h[i] = XLALCreateREAL8TimeSeries(names[i], &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+		wrap_h[i] = XLALCreateREAL8TimeSeries(names[i], &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+		ref_h[i] = XLALCreateREAL8TimeSeries(names[i], &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+		XLAL_CHECK(gen_h[i] && wrap_h[i] && ref_h[i], XLAL_EFUNC);
+	}
+
+	gen = XLALSimSGWBGeneratorCreate(detectors, NUM_SGWB_DETECTORS, LENGTH, OmegaGW, H0);
+	XLAL_CHECK(gen, XLAL_EFUNC);
+
+	for (n = 0; n < XLAL_NUM_ELEM(strides); ++n) {
+		XLAL_CHECK(XLALSimSGWBGeneratorNext(gen, gen_h, strides[n], gen_rng) == 0, XLAL_EFUNC);
+		XLAL_CHECK(XLALSimSGWB(wrap_h, detectors, NUM_SGWB_DETECTORS, strides[n], OmegaGW, H0, wrap_rng) == 0, XLAL_EFUNC);
+		XLAL_CHECK(reference_sgwb(ref_h, detectors, NUM_SGWB_DETECTORS, strides[n], OmegaGW, H0, ref_rng) == 0, XLAL_EFUNC);
+		for (i = 0; i < NUM_SGWB_DETECTORS; ++i) {
+			XLAL_CHECK(compare_series("XLALSimSGWB", n, gen_h[i], wrap_h[i]) == 0, XLAL_EFUNC);
+			XLAL_CHECK(compare_series("reference sgwb", n, gen_h[i], ref_h[i]) == 0, XLAL_EFUNC);
+		}
+	}
+
+	XLALSimSGWBGeneratorDestroy(gen);
+	XLALDestroyREAL8FrequencySeries(OmegaGW);
+	for (i = 0; i < NUM_SGWB_DETECTORS; ++i) {
+		XLALDestroyREAL8TimeSeries(gen_h[i]);
+		XLALDestroyREAL8TimeSeries(wrap_h[i]);
+		XLALDestroyREAL8TimeSeries(ref_h[i]);
+	}
+	gsl_rng_free(gen_rng);
+	gsl_rng_free(wrap_rng);
+	gsl_rng_free(ref_rng);
+	return 0;
+}
+
+int main(void)
+{
+	XLAL_CHECK_MAIN(test_noise() == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_sgwb() == 0, XLAL_EFUNC);
+	LALCheckMemoryLeaks();
+	printf("PASS\n");
+	return EXIT_SUCCESS;
+}
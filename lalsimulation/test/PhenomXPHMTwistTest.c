@@ -0,0 +1,297 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Regression test of the twisting up of the IMRPhenomXPHM modes, which is
+ * done in blocks of frequencies.
+ *
+ * h+ and hx of XLALSimIMRPhenomXPHM() and the inertial-frame modes of
+ * XLALSimIMRPhenomXPHMOneMode() are compared at a few frequencies against
+ * reference values, which were generated with the former implementation that
+ * twisted up the modes one frequency bin at a time.  This is done for the MSA
+ * and the NNLO Euler angles, with and without multibanding of the modes and
+ * the angles.  XLALSimIMRPhenomXPHMFrequencySequence() is compared against
+ * XLALSimIMRPhenomXPHM() without multibanding on the same frequencies.
+ *
+ * The new and former implementations agree to a few parts in 10^15 of the
+ * largest value; multibanding changes the waveforms by parts in 10^4.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <lal/FrequencySeries.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDict.h>
+#include <lal/LALStdlib.h>
+#include <lal/Sequence.h>
+#include <lal/LALSimIMR.h>
+#include <lal/LALSimInspiralWaveformParams.h>
+
+/* largest difference from the reference values, relative to the largest reference value */
+#define REF_TOL 1.0e-7
+
+#define NFREQS 6
+#define NMODES 2
+
+/* the binary: a precessing q = 3 system with mixed in-plane spins */
+#define M1 (30.0 * LAL_MSUN_SI)
+#define M2 (10.0 * LAL_MSUN_SI)
+#define SPINS 0.4, 0.1, 0.2, -0.3, 0.2, 0.1
+#define DISTANCE (100.0e6 * LAL_PC_SI)
+#define INCLINATION 0.8
+#define PHIREF 0.3
+#define FMIN 20.0
+#define FMAX 1024.0
+#define DELTAF 0.25
+#define FREF 20.0
+
+/* frequencies (Hz) at which the waveforms are compared, from the inspiral to the ringdown */
+static const REAL8 freqs[NFREQS] = {20.25, 35.5, 60.0, 120.75, 250.0, 400.5};
+/* modes of XLALSimIMRPhenomXPHMOneMode() which are compared */
+static const INT4 modes[NMODES][2] = {{2, 2}, {3, 3}};
+
+typedef struct {
+	INT4 precVersion;			/* PhenomXPrecVersion: 223 for the MSA, 102 for the NNLO angles */
+	INT4 multibanding;			/* 0 switches off the multibanding of the modes and of the angles */
+	REAL8 hp[NFREQS][2], hc[NFREQS][2];	/* h+ and hx at freqs, as (real, imaginary) parts */
+	REAL8 hlmpos[NMODES][NFREQS][2];	/* hlmpos of XLALSimIMRPhenomXPHMOneMode() for modes */
+	REAL8 hlmneg[NMODES][NFREQS][2];	/* hlmneg of XLALSimIMRPhenomXPHMOneMode() for modes */
+} XPHMTestCase;
+
+static const XPHMTestCase cases[] = {
+	/* MSA angles, multibanding */
+	{223, 1,
+		{{-5.685948542408409e-23, 1.557647348398685e-22}, {8.642377650579023e-23, 2.473682656469253e-23},
+		 {4.538181141128386e-24, -3.242876993093993e-23}, {1.349334562288236e-23, 9.455679931080621e-24},
+		 {6.111458823528582e-24, -8.480017708163343e-24}, {6.684617326761659e-25, -5.976467272536576e-24}},
+		{{1.442904170438022e-22, 5.385893623690836e-23}, {2.378682010022172e-23, -8.701716722212109e-23},
+		 {-3.399293290640061e-23, -7.797163927723493e-24}, {9.466932888558766e-24, -1.374885243216564e-23},
+		 {-8.436803381123351e-24, -6.085657760962372e-24}, {-5.977750036830651e-24, -6.749162513565070e-25}},
+		{
+			{{-1.508610139517740e-25, -8.991158502924863e-26}, {2.342337270402886e-26, 2.860610255091943e-28},
+			 {5.849926916317111e-26, -1.044049931756276e-25}, {3.919902548489511e-26, -1.232105562292425e-26},
+			 {6.704457767047745e-27, 9.554364152531047e-27}, {5.080088901604405e-27, 9.309192744337027e-27}},
+			{{-1.610015918044132e-28, -1.777973809930351e-28}, {1.288427223498947e-29, 3.331666175608391e-28},
+			 {-4.066222768779648e-28, 3.615036783066097e-29}, {-5.096488174216376e-28, -4.538898241936570e-29},
+			 {-3.876999227134649e-28, -4.062765341846699e-29}, {4.800839992146480e-29, 2.799020257365650e-28}}
+		},
+		{
+			{{-4.762789238653907e-22, 4.279384181352122e-22}, {-2.049007680930237e-22, -2.423448044498647e-22},
+			 {1.603380973025362e-22, -1.639238090668685e-23}, {-4.645186075016696e-23, -3.888066118193034e-23},
+			 {1.898511819664233e-23, -2.074249874858081e-23}, {1.665202886376752e-23, -1.025174538539204e-23}},
+			{{-4.509450143201211e-23, 4.310880522960213e-23}, {-1.182716463592098e-23, -3.544956751217295e-23},
+			 {-2.226519819261598e-23, -3.744112220655971e-24}, {-1.935409688501233e-24, -1.161816466413419e-23},
+			 {-5.054446250362475e-24, -3.192803660897192e-24}, {3.599565892655992e-24, 1.758569797153380e-24}}
+		}
+	},
+	/* MSA angles, no multibanding */
+	{223, 0,
+		{{-5.685948542408071e-23, 1.557647348398685e-22}, {8.642377650578900e-23, 2.473682656469009e-23},
+		 {4.538181141127755e-24, -3.242876993094038e-23}, {1.349334562288244e-23, 9.455679931080652e-24},
+		 {6.114047967319945e-24, -8.476186738177309e-24}, {6.697771773604713e-25, -5.976504324979758e-24}},
+		{{1.442904170438023e-22, 5.385893623690526e-23}, {2.378682010021910e-23, -8.701716722211991e-23},
+		 {-3.399293290640107e-23, -7.797163927722860e-24}, {9.466932888558799e-24, -1.374885243216573e-23},
+		 {-8.432948066136615e-24, -6.088211050440663e-24}, {-5.977789469971350e-24, -6.762292727861608e-25}},
+		{
+			{{-1.508610139517744e-25, -8.991158502924754e-26}, {2.342337270402924e-26, 2.860610255085228e-28},
+			 {5.849926916317131e-26, -1.044049931756275e-25}, {3.919902548489511e-26, -1.232105562292425e-26},
+			 {6.704363671025870e-27, 9.554373185810000e-27}, {5.080111115342774e-27, 9.309296901626771e-27}},
+			{{-1.610015918044315e-28, -1.777973809930335e-28}, {1.288427223503337e-29, 3.331666175608317e-28},
+			 {-4.066222768779570e-28, 3.615036783068252e-29}, {-5.096488174216395e-28, -4.538898241936558e-29},
+			 {-3.876994268576970e-28, -4.062896978325345e-29}, {-1.453948994801517e-29, 2.512994211026527e-28}}
+		},
+		{
+			{{-4.762789238653972e-22, 4.279384181352058e-22}, {-2.049007680930204e-22, -2.423448044498678e-22},
+			 {1.603380973025363e-22, -1.639238090668685e-23}, {-4.645186075016696e-23, -3.888066118193034e-23},
+			 {1.898498387221843e-23, -2.074258538460435e-23}, {1.665204779586490e-23, -1.025187133908517e-23}},
+			{{-4.509450143201712e-23, 4.310880522959694e-23}, {-1.182716463591384e-23, -3.544956751217527e-23},
+			 {-2.226519819261563e-23, -3.744112220657881e-24}, {-1.935409688501557e-24, -1.161816466413415e-23},
+			 {-5.054475503013654e-24, -3.192741033259761e-24}, {3.502148859132631e-24, 1.783569156940955e-24}}
+		}
+	},
+	/* NNLO angles, multibanding */
+	{102, 1,
+		{{-5.751916180103104e-23, 1.542291262254188e-22}, {7.749688966724631e-23, 1.771024264348356e-23},
+		 {7.913234422691613e-24, -4.150346917485854e-23}, {1.551404801373492e-23, 3.903589033817073e-24},
+		 {4.037135119321299e-24, -7.147720420592936e-24}, {-9.640457281417388e-25, -3.608166889206660e-24}},
+		{{1.412767421186570e-22, 5.391821778894129e-23}, {1.492163284392025e-23, -7.536504212639706e-23},
+		 {-4.215334762580736e-23, -7.739659461002053e-24}, {3.951363699561793e-24, -1.545372104093133e-23},
+		 {-6.079253207640810e-24, -3.792599645043343e-24}, {-3.378769357295073e-24, 5.097068817279071e-25}},
+		{
+			{{-4.635280589701441e-26, 5.039069532843463e-26}, {-3.076007825916167e-26, -3.986570515905962e-26},
+			 {9.934219906900468e-26, -1.885280732762220e-26}, {6.066677956639645e-27, -6.326556602032139e-26},
+			 {-1.631760040393397e-26, -2.010769712954067e-26}, {-6.173759631234267e-27, 2.756715798764803e-27}},
+			{{-2.334574563464726e-28, 9.339657146775890e-29}, {-2.649157322273614e-28, -2.127641899591568e-28},
+			 {-4.185388702649784e-28, -9.501577232954323e-30}, {2.859637724519795e-28, -2.393504818024922e-28},
+			 {-6.264395819758321e-29, -3.905405606577464e-28}, {-7.052974009449034e-29, 1.456112737117821e-28}}
+		},
+		{
+			{{-4.728873237239017e-22, 4.322164989299009e-22}, {-2.103320789297034e-22, -2.390548039467930e-22},
+			 {1.571483113755607e-22, -9.385241943155636e-24}, {-4.469159360858027e-23, -4.012235924048681e-23},
+			 {2.217320988896205e-23, -2.027580057964162e-23}, {1.788386868866030e-23, -7.475596820835330e-24}},
+			{{-4.347568648101525e-23, 4.534294791773913e-23}, {-1.246106760312898e-23, -3.507248900257202e-23},
+			 {-2.193148739854411e-23, -3.964418428218631e-24}, {-1.159686075615705e-24, -1.061942126687285e-23},
+			 {-4.699713545563659e-24, -2.755191598329420e-24}, {3.031518534981927e-24, 3.253146039354737e-24}}
+		}
+	},
+	/* NNLO angles, no multibanding */
+	{102, 0,
+		{{-5.751916180102760e-23, 1.542291262254190e-22}, {7.749688966724537e-23, 1.771024264348019e-23},
+		 {7.913234422691234e-24, -4.150346917485913e-23}, {1.551404801373494e-23, 3.903589033817078e-24},
+		 {4.039698769949629e-24, -7.145281125870855e-24}, {-9.631921690572737e-25, -3.608342962010188e-24}},
+		{{1.412767421186572e-22, 5.391821778893815e-23}, {1.492163284391681e-23, -7.536504212639608e-23},
+		 {-4.215334762580791e-23, -7.739659461001705e-24}, {3.951363699561804e-24, -1.545372104093134e-23},
+		 {-6.076159853894759e-24, -3.795524468404253e-24}, {-3.379079218109854e-24, 5.087337520953134e-25}},
+		{
+			{{-4.635280589701454e-26, 5.039069532843623e-26}, {-3.076007825916198e-26, -3.986570515905726e-26},
+			 {9.934219906900471e-26, -1.885280732762219e-26}, {6.066677956639645e-27, -6.326556602032139e-26},
+			 {-1.631748624639158e-26, -2.010773246696366e-26}, {-6.173823521672272e-27, 2.756632229866962e-27}},
+			{{-2.334574563464634e-28, 9.339657146776020e-29}, {-2.649157322273920e-28, -2.127641899591368e-28},
+			 {-4.185388702649703e-28, -9.501577232937619e-30}, {2.859637724519808e-28, -2.393504818024936e-28},
+			 {-6.264131095345493e-29, -3.905402585561444e-28}, {-7.053141797954878e-29, 1.456120331441648e-28}}
+		},
+		{
+			{{-4.728873237239080e-22, 4.322164989298944e-22}, {-2.103320789296967e-22, -2.390548039467991e-22},
+			 {1.571483113755608e-22, -9.385241943155639e-24}, {-4.469159360858027e-23, -4.012235924048681e-23},
+			 {2.217307882554327e-23, -2.027590564431687e-23}, {1.788389913031384e-23, -7.475721414359112e-24}},
+			{{-4.347568648102055e-23, 4.534294791773414e-23}, {-1.246106760312190e-23, -3.507248900257455e-23},
+			 {-2.193148739854371e-23, -3.964418428220874e-24}, {-1.159686075615864e-24, -1.061942126687284e-23},
+			 {-4.699743140715050e-24, -2.755131947957250e-24}, {3.031529106822476e-24, 3.253136777040979e-24}}
+		}
+	}
+};
+
+static LALDict *create_params(const XPHMTestCase *c)
+{
+	LALDict *params = XLALCreateDict();
+	XLAL_CHECK_NULL(params, XLAL_EFUNC);
+	XLALSimInspiralWaveformParamsInsertPhenomXPrecVersion(params, c->precVersion);
+	if (!c->multibanding) {
+		XLALSimInspiralWaveformParamsInsertPhenomXHMThresholdMband(params, 0);
+		XLALSimInspiralWaveformParamsInsertPhenomXPHMThresholdMband(params, 0);
+	}
+	return params;
+}
+
+/* value of h at freqs[k]; a uniform series starts at h->f0, a frequency sequence holds the values at freqs */
+static COMPLEX16 value_at(const COMPLEX16FrequencySeries *h, size_t k, int uniform)
+{
+	const size_t i = uniform ? (size_t) round((freqs[k] - h->f0) / h->deltaF) : k;
+	XLAL_CHECK_VAL(NAN, i < h->data->length, XLAL_EBADLEN, "%s: no sample at %g Hz", h->name, freqs[k]);
+	return h->data->data[i];
+}
+
+/* largest difference of h at freqs from ref, relative to the largest reference value */
+static REAL8 difference(const COMPLEX16FrequencySeries *h, const REAL8 ref[NFREQS][2])
+{
+	REAL8 peak = 0, maxDiff = 0;
+	for (size_t k = 0; k < NFREQS; ++k) {
+		const COMPLEX16 r = ref[k][0] + I * ref[k][1];
+		peak = fmax(peak, cabs(r));
+		maxDiff = fmax(maxDiff, cabs(value_at(h, k, 1) - r));
+	}
+	return maxDiff / peak;
+}
+
+static int check(const char *what, const XPHMTestCase *c, REAL8 diff)
+{
+	printf("PrecVersion %d, %s: %-12s max |dh|/peak %.3g\n", c->precVersion, c->multibanding ? "multibanding" : "no multibanding", what, diff);
+	XLAL_CHECK(diff <= REF_TOL, XLAL_EFAILED, "PrecVersion %d, multibanding %d: %s differs from the reference values by %g > %g", c->precVersion, c->multibanding, what, diff, REF_TOL);
+	return 0;
+}
+
+static int test_polarizations(const XPHMTestCase *c)
+{
+	LALDict *params = create_params(c);
+	XLAL_CHECK(params, XLAL_EFUNC);
+	COMPLEX16FrequencySeries *hp = NULL, *hc = NULL;
+	int ret = XLALSimIMRPhenomXPHM(&hp, &hc, M1, M2, SPINS, DISTANCE, INCLINATION, PHIREF, FMIN, FMAX, DELTAF, FREF, params);
+	XLAL_CHECK(ret == XLAL_SUCCESS, XLAL_EFUNC, "XLALSimIMRPhenomXPHM() failed");
+
+	const REAL8 diffp = difference(hp, c->hp), diffc = difference(hc, c->hc);
+
+	/* the frequency sequence path is not multibanded, so it must reproduce the uniform grid without multibanding */
+	REAL8 diffSeqp = 0, diffSeqc = 0;
+	if (!c->multibanding) {
+		REAL8Sequence *f = XLALCreateREAL8Sequence(NFREQS);
+		XLAL_CHECK(f, XLAL_EFUNC);
+		for (size_t k = 0; k < NFREQS; ++k)
+			f->data[k] = freqs[k];
+		COMPLEX16FrequencySeries *hpSeq = NULL, *hcSeq = NULL;
+		ret = XLALSimIMRPhenomXPHMFrequencySequence(&hpSeq, &hcSeq, f, M1, M2, SPINS, DISTANCE, INCLINATION, PHIREF, FREF, params);
+		XLAL_CHECK(ret == XLAL_SUCCESS, XLAL_EFUNC, "XLALSimIMRPhenomXPHMFrequencySequence() failed");
+		REAL8 peakp = 0, peakc = 0;
+		for (size_t k = 0; k < NFREQS; ++k) {
+			peakp = fmax(peakp, cabs(value_at(hp, k, 1)));
+			peakc = fmax(peakc, cabs(value_at(hc, k, 1)));
+			diffSeqp = fmax(diffSeqp, cabs(value_at(hpSeq, k, 0) - value_at(hp, k, 1)));
+			diffSeqc = fmax(diffSeqc, cabs(value_at(hcSeq, k, 0) - value_at(hc, k, 1)));
+		}
+		diffSeqp /= peakp;
+		diffSeqc /= peakc;
+		XLALDestroyCOMPLEX16FrequencySeries(hpSeq);
+		XLALDestroyCOMPLEX16FrequencySeries(hcSeq);
+		XLALDestroyREAL8Sequence(f);
+	}
+
+	XLALDestroyCOMPLEX16FrequencySeries(hp);
+	XLALDestroyCOMPLEX16FrequencySeries(hc);
+	XLALDestroyDict(params);
+
+	XLAL_CHECK(check("h+", c, diffp) == 0, XLAL_EFUNC);
+	XLAL_CHECK(check("hx", c, diffc) == 0, XLAL_EFUNC);
+	if (!c->multibanding) {
+		XLAL_CHECK(check("h+ sequence", c, diffSeqp) == 0, XLAL_EFUNC);
+		XLAL_CHECK(check("hx sequence", c, diffSeqc) == 0, XLAL_EFUNC);
+	}
+	return 0;
+}
+
+static int test_modes(const XPHMTestCase *c)
+{
+	LALDict *params = create_params(c);
+	XLAL_CHECK(params, XLAL_EFUNC);
+	for (size_t j = 0; j < NMODES; ++j) {
+		COMPLEX16FrequencySeries *hlmpos = NULL, *hlmneg = NULL;
+		int ret = XLALSimIMRPhenomXPHMOneMode(&hlmpos, &hlmneg, modes[j][0], modes[j][1], M1, M2, SPINS, DISTANCE, PHIREF, DELTAF, FMIN, FMAX, FREF, params);
+		XLAL_CHECK(ret == XLAL_SUCCESS, XLAL_EFUNC, "XLALSimIMRPhenomXPHMOneMode() failed for mode (%d, %d)", modes[j][0], modes[j][1]);
+		const REAL8 diffpos = difference(hlmpos, c->hlmpos[j]), diffneg = difference(hlmneg, c->hlmneg[j]);
+		XLALDestroyCOMPLEX16FrequencySeries(hlmpos);
+		XLALDestroyCOMPLEX16FrequencySeries(hlmneg);
+		char what[32];
+		snprintf(what, sizeof(what), "h%d%d pos", modes[j][0], modes[j][1]);
+		XLAL_CHECK(check(what, c, diffpos) == 0, XLAL_EFUNC);
+		snprintf(what, sizeof(what), "h%d%d neg", modes[j][0], modes[j][1]);
+		XLAL_CHECK(check(what, c, diffneg) == 0, XLAL_EFUNC);
+	}
+	XLALDestroyDict(params);
+	return 0;
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+		if (test_polarizations(&cases[i]) != 0)
+			return 1;
+		if (test_modes(&cases[i]) != 0)
+			return 1;
+	}
+	LALCheckMemoryLeaks();
+	return 0;
+}
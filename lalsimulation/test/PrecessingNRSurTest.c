@@ -0,0 +1,425 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Test the packed NRSur7dq2 and NRSur7dq4 fits against the fits evaluated
+ * term by term.
+ *
+ * Randomly generated fits are always tested, together with the rejection of
+ * basis function orders out of range. If the NRSur7dq2.h5 or NRSur7dq4.h5
+ * data files can be found in $LAL_DATA_PATH, every fit of the surrogate data
+ * is tested as well.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConfig.h>
+
+#include "../lib/LALSimIMRPrecessingNRSur.c"
+
+/* Allowed difference between the packed and term-by-term fits, relative to the
+ * sum of the absolute values of the coefficients; all basis functions are
+ * bounded by 1 in the parameter ranges tested */
+#define TOLERANCE 1e-14
+
+#define NUM_POINTS 20
+
+static FitData *create_fit(int n_coefs);
+static void destroy_fit(FitData *fit);
+static VectorFitData *create_vector_fit(int vec_dim, int n_coefs, UINT4 PrecessingNRSurVersion);
+static void destroy_vector_fit(VectorFitData *fit, UINT4 PrecessingNRSurVersion);
+static void random_point(REAL8 *x, UINT4 PrecessingNRSurVersion);
+static REAL8 sum_abs_coefs(const gsl_vector *coefs, const gsl_vector_long *componentIndices, long component);
+static REAL8 NRSur7dq2_eval_vector_fit_component(const VectorFitData *data, long component, const REAL8 *x);
+static int check_fit(REAL8 fit, REAL8 ref, REAL8 scale, int k, REAL8 *maxerr);
+static int compare_dynamics_node(DynamicsNodeFitData *ds_node, PrecessingNRSurData *sur_data, REAL8 *maxerr);
+static int compare_data_piece(WaveformDataPiece *data, PrecessingNRSurData *sur_data, REAL8 *maxerr);
+static int test_random_fits(UINT4 PrecessingNRSurVersion);
+static int test_orders_out_of_range(void);
+#ifdef LAL_HDF5_ENABLED
+static int test_surrogate_data(Approximant approximant);
+#endif
+
+int main(void) {
+
+    srand(20190601);
+
+    XLAL_CHECK_MAIN(test_random_fits(0) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_random_fits(1) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_orders_out_of_range() == XLAL_SUCCESS, XLAL_EFUNC);
+
+    // The surrogate data stays loaded until exit, so check for leaks before loading it
+    LALCheckMemoryLeaks();
+
+#ifdef LAL_HDF5_ENABLED
+    XLAL_CHECK_MAIN(test_surrogate_data(NRSur7dq2) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_surrogate_data(NRSur7dq4) == XLAL_SUCCESS, XLAL_EFUNC);
+#endif
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Create a fit with random coefficients and basis function orders.
+ */
+static FitData *create_fit(int n_coefs) {
+    FitData *fit = XLALCalloc(1, sizeof(FitData));
+    XLAL_CHECK_NULL(fit != NULL, XLAL_ENOMEM);
+    fit->n_coefs = n_coefs;
+    fit->coefs = gsl_vector_alloc(n_coefs);
+    fit->basisFunctionOrders = gsl_matrix_long_alloc(n_coefs, 7);
+    for (int i=0; i < n_coefs; i++) {
+        gsl_vector_set(fit->coefs, i, 2.0 * rand() / RAND_MAX - 1.0);
+        gsl_matrix_long_set(fit->basisFunctionOrders, i, 0, rand() % NRSUR_FIT_Q_ORDERS);
+        for (int j=1; j<7; j++) {
+            gsl_matrix_long_set(fit->basisFunctionOrders, i, j, rand() % NRSUR_FIT_CHI_ORDERS);
+        }
+    }
+    return fit;
+}
+
+static void destroy_fit(FitData *fit) {
+    if (fit == NULL) return;
+    gsl_vector_free(fit->coefs);
+    gsl_matrix_long_free(fit->basisFunctionOrders);
+    XLALFree(fit);
+}
+
+/*
+ * Create a vector fit with random coefficients and basis function orders. For
+ * NRSur7dq2 the components share n_coefs terms, which may be 0; for NRSur7dq4
+ * each component is a scalar fit with n_coefs terms.
+ */
+static VectorFitData *create_vector_fit(int vec_dim, int n_coefs, UINT4 PrecessingNRSurVersion) {
+    VectorFitData *fit = XLALCalloc(1, sizeof(VectorFitData));
+    XLAL_CHECK_NULL(fit != NULL, XLAL_ENOMEM);
+    fit->vec_dim = vec_dim;
+    if (PrecessingNRSurVersion == 0) {
+        fit->n_coefs = n_coefs;
+        if (n_coefs > 0) {
+            FitData *terms = create_fit(n_coefs);
+            XLAL_CHECK_NULL(terms != NULL, XLAL_EFUNC);
+            fit->coefs = terms->coefs;
+            fit->basisFunctionOrders = terms->basisFunctionOrders;
+            XLALFree(terms);
+            fit->componentIndices = gsl_vector_long_alloc(n_coefs);
+            for (int i=0; i < n_coefs; i++) {
+                gsl_vector_long_set(fit->componentIndices, i, rand() % vec_dim);
+            }
+        }
+    } else {
+        fit->fit_data = XLALCalloc(vec_dim, sizeof(FitData *));
+        XLAL_CHECK_NULL(fit->fit_data != NULL, XLAL_ENOMEM);
+        for (int i=0; i < vec_dim; i++) {
+            fit->fit_data[i] = create_fit(n_coefs);
+            XLAL_CHECK_NULL(fit->fit_data[i] != NULL, XLAL_EFUNC);
+        }
+    }
+    return fit;
+}
+
+static void destroy_vector_fit(VectorFitData *fit, UINT4 PrecessingNRSurVersion) {
+    if (fit == NULL) return;
+    if (PrecessingNRSurVersion == 0) {
+        if (fit->coefs) gsl_vector_free(fit->coefs);
+        if (fit->basisFunctionOrders) gsl_matrix_long_free(fit->basisFunctionOrders);
+        if (fit->componentIndices) gsl_vector_long_free(fit->componentIndices);
+    } else {
+        for (int i=0; i < fit->vec_dim; i++) {
+            destroy_fit(fit->fit_data[i]);
+        }
+        XLALFree(fit->fit_data);
+    }
+    XLALFree(fit);
+}
+
+/*
+ * Draw a random mass ratio within the range of the surrogate, and two random
+ * spins with magnitudes below 0.8.
+ */
+static void random_point(REAL8 *x, UINT4 PrecessingNRSurVersion) {
+    const REAL8 q_max = (PrecessingNRSurVersion == 0) ? 2.0 : 4.0;
+    x[0] = 1.0 + (q_max - 1.0) * rand() / RAND_MAX;
+    for (int s=0; s<2; s++) {
+        REAL8 chi2;
+        do {
+            chi2 = 0.0;
+            for (int j=1; j<4; j++) {
+                x[3*s+j] = 1.6 * rand() / RAND_MAX - 0.8;
+                chi2 += x[3*s+j] * x[3*s+j];
+            }
+        } while (chi2 > 0.64);
+    }
+}
+
+/*
+ * Sum of the absolute values of the coefficients of a fit, or of one component
+ * of a NRSur7dq2 vector fit.
+ */
+static REAL8 sum_abs_coefs(const gsl_vector *coefs, const gsl_vector_long *componentIndices, long component) {
+    REAL8 sum = 0.0;
+    if (coefs == NULL) return sum;
+    for (size_t i=0; i < coefs->size; i++) {
+        if (componentIndices == NULL || gsl_vector_long_get(componentIndices, i) == component) {
+            sum += fabs(gsl_vector_get(coefs, i));
+        }
+    }
+    return sum;
+}
+
+/*
+ * Evaluate one component of a NRSur7dq2 vector fit term by term.
+ */
+static REAL8 NRSur7dq2_eval_vector_fit_component(const VectorFitData *data, long component, const REAL8 *x) {
+    REAL8 x_powers[22]; // 3 per spin component, 4 for mass ratio
+    REAL8 res = 0.0;
+
+    REAL8 q_fit = NRSUR7DQ2_Q_FIT_OFFSET + NRSUR7DQ2_Q_FIT_SLOPE*x[0];
+    for (int i=0; i<22; i++) {
+        if (i%7==0) {
+            x_powers[i] = ipow(q_fit, i/7);
+        } else {
+            x_powers[i] = ipow(x[i%7], i/7);
+        }
+    }
+
+    for (int i=0; i < data->n_coefs; i++) {
+        if (gsl_vector_long_get(data->componentIndices, i) != component) continue;
+        REAL8 prod = x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, 0)];
+        for (int j=1; j<7; j++) {
+            prod *= x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, j) + j];
+        }
+        res += gsl_vector_get(data->coefs, i) * prod;
+    }
+
+    return res;
+}
+
+/*
+ * Check a packed fit against the fit evaluated term by term.
+ */
+static int check_fit(REAL8 fit, REAL8 ref, REAL8 scale, int k, REAL8 *maxerr) {
+    if (fit == ref) return XLAL_SUCCESS;
+    const REAL8 err = fabs(fit - ref) / scale;
+    XLAL_CHECK(err <= TOLERANCE, XLAL_ETOL, "Packed fit %d = %.17g differs from fit %.17g\n", k, fit, ref);
+    *maxerr = fmax(*maxerr, err);
+    return XLAL_SUCCESS;
+}
+
+/*
+ * Compare the packed fits of a dynamics node with its fits evaluated term by
+ * term, at random points.
+ */
+static int compare_dynamics_node(DynamicsNodeFitData *ds_node, PrecessingNRSurData *sur_data, REAL8 *maxerr) {
+    const UINT4 version = sur_data->PrecessingNRSurVersion;
+    VectorFitData *vector_fits[3] = {ds_node->omega_copr_data, ds_node->chiA_dot_data, ds_node->chiB_dot_data};
+    XLAL_CHECK(ds_node->packed_data != NULL && ds_node->packed_data->n_fits == NRSUR_DS_NODE_N_FITS, XLAL_EFAILED);
+
+    for (int p=0; p < NUM_POINTS; p++) {
+        REAL8 x[7], fits[NRSUR_DS_NODE_N_FITS];
+        random_point(x, version);
+        PrecessingNRSur_eval_packed_fits(fits, ds_node->packed_data, x, sur_data);
+
+        int k = 0;
+        XLAL_CHECK(check_fit(fits[k], PrecessingNRSur_eval_fit(ds_node->omega_data, x, sur_data),
+                    sum_abs_coefs(ds_node->omega_data->coefs, NULL, 0), k, maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+        k++;
+        for (int v=0; v<3; v++) {
+            for (int i=0; i < vector_fits[v]->vec_dim; i++, k++) {
+                REAL8 ref, scale;
+                if (version == 0) {
+                    // The NRSur7dq2 chiB_dot fit of one node has no terms
+                    ref = (vector_fits[v]->n_coefs == 0) ? 0.0
+                        : NRSur7dq2_eval_vector_fit_component(vector_fits[v], i, x);
+                    scale = sum_abs_coefs(vector_fits[v]->coefs, vector_fits[v]->componentIndices, i);
+                } else {
+                    ref = PrecessingNRSur_eval_fit(vector_fits[v]->fit_data[i], x, sur_data);
+                    scale = sum_abs_coefs(vector_fits[v]->fit_data[i]->coefs, NULL, 0);
+                }
+                XLAL_CHECK(check_fit(fits[k], ref, scale, k, maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+            }
+        }
+        XLAL_CHECK(k == NRSUR_DS_NODE_N_FITS, XLAL_EFAILED);
+    }
+
+    return XLAL_SUCCESS;
+}
+
+/*
+ * Compare the packed fits of a waveform data piece with its fits evaluated
+ * term by term, each at a different random point.
+ */
+static int compare_data_piece(WaveformDataPiece *data, PrecessingNRSurData *sur_data, REAL8 *maxerr) {
+    const int n_nodes = data->n_nodes;
+    XLAL_CHECK(data->packed_fit_data != NULL && data->packed_fit_data->n_fits == n_nodes, XLAL_EFAILED);
+
+    REAL8 x[7];
+    REAL8 bfA[NRSUR_FIT_BFA_SIZE], bfB[NRSUR_FIT_BFB_SIZE];
+
+    for (int p=0; p < NUM_POINTS; p++) {
+        for (int k=0; k < n_nodes; k++) {
+            random_point(x, sur_data->PrecessingNRSurVersion);
+            PrecessingNRSur_fit_basis_products(bfA, bfB, x, sur_data->PrecessingNRSurVersion);
+            const REAL8 fit = PrecessingNRSur_sum_packed_fit(data->packed_fit_data, k, bfA, bfB);
+            const REAL8 ref = PrecessingNRSur_eval_fit(data->fit_data[k], x, sur_data);
+            XLAL_CHECK(check_fit(fit, ref, sum_abs_coefs(data->fit_data[k]->coefs, NULL, 0), k, maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+        }
+    }
+
+    return XLAL_SUCCESS;
+}
+
+/*
+ * Pack randomly generated fits for a dynamics node and a waveform data piece,
+ * and compare them with the fits evaluated term by term.
+ */
+static int test_random_fits(UINT4 PrecessingNRSurVersion) {
+    PrecessingNRSurData sur_data = { .PrecessingNRSurVersion = PrecessingNRSurVersion };
+    REAL8 maxerr = 0.0;
+
+    // Dynamics node; for NRSur7dq2, the chiB_dot fit has no terms as in one node of the data
+    DynamicsNodeFitData ds_node = { .omega_data = create_fit(60) };
+    ds_node.omega_copr_data = create_vector_fit(2, 40, PrecessingNRSurVersion);
+    ds_node.chiA_dot_data = create_vector_fit(3, 50, PrecessingNRSurVersion);
+    ds_node.chiB_dot_data = create_vector_fit(3, (PrecessingNRSurVersion == 0) ? 0 : 30, PrecessingNRSurVersion);
+    XLAL_CHECK(ds_node.omega_data && ds_node.omega_copr_data && ds_node.chiA_dot_data && ds_node.chiB_dot_data, XLAL_EFUNC);
+    XLAL_CHECK(PrecessingNRSur_PackDynamicsNode(&ds_node, PrecessingNRSurVersion) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(compare_dynamics_node(&ds_node, &sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+
+    // Waveform data piece
+    const int n_nodes = 8;
+    WaveformDataPiece data = { .n_nodes = n_nodes };
+    data.fit_data = XLALCalloc(n_nodes, sizeof(FitData *));
+    XLAL_CHECK(data.fit_data != NULL, XLAL_ENOMEM);
+    for (int k=0; k < n_nodes; k++) {
+        data.fit_data[k] = create_fit(1 + 10*k);
+        XLAL_CHECK(data.fit_data[k] != NULL, XLAL_EFUNC);
+    }
+    data.packed_fit_data = PrecessingNRSur_PackFits(data.fit_data, n_nodes);
+    XLAL_CHECK(data.packed_fit_data != NULL, XLAL_EFUNC);
+    XLAL_CHECK(compare_data_piece(&data, &sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+
+    XLALPrintInfo("%s: version %u: max relative difference %g\n", __func__, PrecessingNRSurVersion, maxerr);
+
+    PrecessingNRSur_DestroyPackedFitData(ds_node.packed_data);
+    destroy_fit(ds_node.omega_data);
+    destroy_vector_fit(ds_node.omega_copr_data, PrecessingNRSurVersion);
+    destroy_vector_fit(ds_node.chiA_dot_data, PrecessingNRSurVersion);
+    destroy_vector_fit(ds_node.chiB_dot_data, PrecessingNRSurVersion);
+    PrecessingNRSur_DestroyPackedFitData(data.packed_fit_data);
+    for (int k=0; k < n_nodes; k++) {
+        destroy_fit(data.fit_data[k]);
+    }
+    XLALFree(data.fit_data);
+
+    return XLAL_SUCCESS;
+}
+
+/*
+ * Basis function orders out of range are rejected, without leaking the
+ * partially packed fits.
+ */
+static int test_orders_out_of_range(void) {
+    const long bad_orders[2][2] = {
+        {0, NRSUR_FIT_Q_ORDERS},    // mass ratio order
+        {5, NRSUR_FIT_CHI_ORDERS},  // spin order
+    };
+    for (int b=0; b<2; b++) {
+        FitData *fit_data[3];
+        for (int k=0; k<3; k++) {
+            fit_data[k] = create_fit(10);
+            XLAL_CHECK(fit_data[k] != NULL, XLAL_EFUNC);
+        }
+        gsl_matrix_long_set(fit_data[2]->basisFunctionOrders, 7, bad_orders[b][0], bad_orders[b][1]);
+
+        PackedFitData *packed = NULL;
+        int errnum;
+        XLAL_TRY_SILENT(packed = PrecessingNRSur_PackFits(fit_data, 3), errnum);
+        XLAL_CHECK(packed == NULL && errnum != 0, XLAL_EFAILED,
+                "Order %ld of basis function %ld not rejected\n", bad_orders[b][1], bad_orders[b][0]);
+
+        for (UINT4 version=0; version<2; version++) {
+            DynamicsNodeFitData ds_node = { .omega_data = fit_data[0] };
+            ds_node.omega_copr_data = create_vector_fit(2, 10, version);
+            ds_node.chiA_dot_data = create_vector_fit(3, 10, version);
+            ds_node.chiB_dot_data = create_vector_fit(3, 10, version);
+            XLAL_CHECK(ds_node.omega_copr_data && ds_node.chiA_dot_data && ds_node.chiB_dot_data, XLAL_EFUNC);
+            gsl_matrix_long *orders = (version == 0) ? ds_node.chiA_dot_data->basisFunctionOrders
+                : ds_node.chiA_dot_data->fit_data[1]->basisFunctionOrders;
+            gsl_matrix_long_set(orders, 3, bad_orders[b][0], bad_orders[b][1]);
+
+            int retn;
+            XLAL_TRY_SILENT(retn = PrecessingNRSur_PackDynamicsNode(&ds_node, version), errnum);
+            XLAL_CHECK(retn != XLAL_SUCCESS && errnum != 0 && ds_node.packed_data == NULL, XLAL_EFAILED,
+                    "Order %ld of basis function %ld not rejected in dynamics node\n", bad_orders[b][1], bad_orders[b][0]);
+
+            destroy_vector_fit(ds_node.omega_copr_data, version);
+            destroy_vector_fit(ds_node.chiA_dot_data, version);
+            destroy_vector_fit(ds_node.chiB_dot_data, version);
+        }
+
+        for (int k=0; k<3; k++) {
+            destroy_fit(fit_data[k]);
+        }
+    }
+
+    return XLAL_SUCCESS;
+}
+
+#ifdef LAL_HDF5_ENABLED
+/*
+ * Compare every packed fit of the surrogate data with the fit evaluated term
+ * by term, if the data file can be loaded.
+ */
+static int test_surrogate_data(Approximant approximant) {
+    PrecessingNRSurData *sur_data = NULL;
+    int errnum;
+    XLAL_TRY_SILENT(sur_data = PrecessingNRSur_LoadData(approximant), errnum);
+    if (sur_data == NULL || !sur_data->setup) {
+        XLALPrintInfo("%s: could not load the data of %s; skipping\n", __func__, XLALSimInspiralGetStringFromApproximant(approximant));
+        return XLAL_SUCCESS;
+    }
+    REAL8 maxerr = 0.0;
+
+    for (size_t i=0; i < sur_data->t_ds->size; i++) {
+        XLAL_CHECK(compare_dynamics_node(sur_data->ds_node_data[i], sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC,
+                "Dynamics node %zu", i);
+    }
+    for (size_t i=0; i<3; i++) {
+        XLAL_CHECK(compare_dynamics_node(sur_data->ds_half_node_data[i], sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC,
+                "Dynamics half node %zu", i);
+    }
+
+    for (int ell_idx=0; ell_idx < sur_data->LMax-1; ell_idx++) {
+        WaveformFixedEllModeData *mode_data = sur_data->coorbital_mode_data[ell_idx];
+        XLAL_CHECK(compare_data_piece(mode_data->m0_real_data, sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+        XLAL_CHECK(compare_data_piece(mode_data->m0_imag_data, sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+        for (int m=1; m <= mode_data->ell; m++) {
+            XLAL_CHECK(compare_data_piece(mode_data->X_real_plus_data[m-1], sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+            XLAL_CHECK(compare_data_piece(mode_data->X_real_minus_data[m-1], sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+            XLAL_CHECK(compare_data_piece(mode_data->X_imag_plus_data[m-1], sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+            XLAL_CHECK(compare_data_piece(mode_data->X_imag_minus_data[m-1], sur_data, &maxerr) == XLAL_SUCCESS, XLAL_EFUNC);
+        }
+    }
+
+    XLALPrintInfo("%s: %s: max relative difference %g\n", __func__, XLALSimInspiralGetStringFromApproximant(approximant), maxerr);
+
+    return XLAL_SUCCESS;
+}
+#endif
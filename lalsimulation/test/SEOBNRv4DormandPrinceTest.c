@@ -0,0 +1,139 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Regression test of the Dormand-Prince integrator of the spin-aligned EOB
+ * models, which is selected with the EOBUseDormandPrince waveform parameter,
+ * against the default XLALAdaptiveRungeKutta4() integrator.
+ *
+ * Both integrations start from the same initial conditions and are sampled on
+ * the same time grid, so h+ and hx are compared sample by sample.  The epoch
+ * of the waveforms is set by the time at which the ringdown is attached, so
+ * comparing the epochs compares the attachment times.  The tolerances are
+ * about three times the largest differences found for these configurations.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/Date.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDict.h>
+#include <lal/LALStdlib.h>
+#include <lal/TimeSeries.h>
+#include <lal/LALSimIMR.h>
+#include <lal/LALSimInspiralWaveformParams.h>
+
+/* largest difference of h = h+ - i hx, relative to the peak of |h| */
+#define STRAIN_TOL 0.05
+/* largest 1 - |<h_RK4, h_DP>| / (|h_RK4| |h_DP|), without maximising over time or phase */
+#define MISMATCH_TOL 1.0e-5
+
+typedef struct {
+	UINT4 version;		/* SpinAlignedEOBversion */
+	REAL8 m1, m2;		/* masses in solar masses */
+	REAL8 spin1z, spin2z;	/* dimensionless spins */
+	REAL8 lambda1, lambda2;	/* quadrupolar tidal deformabilities */
+	REAL8 omega1, omega2;	/* quadrupolar f-mode frequencies */
+	REAL8 fMin;		/* starting frequency (Hz) */
+	REAL8 deltaT;		/* sampling interval (s) */
+	REAL8 epochTol;		/* largest difference of the epochs, i.e. of the attachment times, in units of the total mass */
+} EOBTestCase;
+
+static const EOBTestCase cases[] = {
+	/* SEOBNRv4, moderate spins */
+	{4, 30.0, 10.0, 0.5, -0.3, 0, 0, 0, 0, 20.0, 1.0 / 4096.0, 0.05},
+	/* SEOBNRv4, high mass ratio and spins: the largest differences */
+	{4, 50.0, 5.0, 0.9, 0.5, 0, 0, 0, 0, 15.0, 1.0 / 4096.0, 0.05},
+	/* SEOBNRv4, anti-aligned spins */
+	{4, 20.0, 15.0, -0.8, -0.8, 0, 0, 0, 0, 20.0, 1.0 / 4096.0, 0.05},
+	/* SEOBNRv4HM */
+	{41, 30.0, 10.0, 0.5, -0.3, 0, 0, 0, 0, 20.0, 1.0 / 4096.0, 0.05},
+	/* SEOBNRv2 */
+	{2, 30.0, 10.0, 0.5, -0.3, 0, 0, 0, 0, 20.0, 1.0 / 4096.0, 0.05},
+	/* SEOBNRv2T: the tidal models attach the ringdown where the stopping condition, which is
+	 * tested after every step of the integrator, first fires, so their attachment times differ more */
+	{201, 1.4, 1.3, 0.02, 0.01, 400.0, 300.0, 0.08, 0.09, 200.0, 1.0 / 16384.0, 0.3},
+};
+
+static int generate(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, const EOBTestCase *c, INT4 useDormandPrince)
+{
+	LALDict *params = XLALCreateDict();
+	XLAL_CHECK(params, XLAL_EFUNC);
+	if (c->lambda1 != 0 || c->lambda2 != 0) {
+		XLALSimInspiralWaveformParamsInsertTidalLambda1(params, c->lambda1);
+		XLALSimInspiralWaveformParamsInsertTidalLambda2(params, c->lambda2);
+		XLALSimInspiralWaveformParamsInsertTidalQuadrupolarFMode1(params, c->omega1);
+		XLALSimInspiralWaveformParamsInsertTidalQuadrupolarFMode2(params, c->omega2);
+	}
+	XLALSimInspiralWaveformParamsInsertEOBUseDormandPrince(params, useDormandPrince);
+	int ret = XLALSimIMRSpinAlignedEOBWaveform(hplus, hcross, 0.3, c->deltaT, c->m1 * LAL_MSUN_SI, c->m2 * LAL_MSUN_SI, c->fMin, 100.0e6 * LAL_PC_SI, LAL_PI / 3.0, c->spin1z, c->spin2z, c->version, params);
+	XLALDestroyDict(params);
+	XLAL_CHECK(ret == XLAL_SUCCESS, XLAL_EFUNC, "generation of version %u failed", c->version);
+	return 0;
+}
+
+static int compare(const EOBTestCase *c)
+{
+	REAL8TimeSeries *hpRK = NULL, *hcRK = NULL, *hpDP = NULL, *hcDP = NULL;
+	XLAL_CHECK(generate(&hpRK, &hcRK, c, 0) == 0, XLAL_EFUNC);
+	XLAL_CHECK(generate(&hpDP, &hcDP, c, 1) == 0, XLAL_EFUNC);
+
+	const REAL8 mTotal = (c->m1 + c->m2) * LAL_MTSUN_SI;
+	const REAL8 dEpoch = XLALGPSDiff(&hpDP->epoch, &hpRK->epoch) / mTotal;
+	const size_t nRK = hpRK->data->length, nDP = hpDP->data->length;
+	const size_t n = nRK < nDP ? nRK : nDP;
+
+	REAL8 peak = 0, maxDiff = 0, normRK = 0, normDP = 0;
+	COMPLEX16 overlap = 0;
+	for (size_t j = 0; j < n; ++j) {
+		const COMPLEX16 hRK = hpRK->data->data[j] - I * hcRK->data->data[j];
+		const COMPLEX16 hDP = hpDP->data->data[j] - I * hcDP->data->data[j];
+		XLAL_CHECK(isfinite(creal(hDP)) && isfinite(cimag(hDP)), XLAL_EFPINVAL, "version %u: Dormand-Prince waveform not finite at sample %zu", c->version, j);
+		peak = fmax(peak, cabs(hRK));
+		maxDiff = fmax(maxDiff, cabs(hRK - hDP));
+		overlap += hRK * conj(hDP);
+		normRK += creal(hRK * conj(hRK));
+		normDP += creal(hDP * conj(hDP));
+	}
+	const REAL8 mismatch = 1.0 - cabs(overlap) / sqrt(normRK * normDP);
+
+	printf("version %3u, m1 = %4.1f, m2 = %4.1f, chi1 = %+.2f, chi2 = %+.2f: length %zu/%zu, epoch difference %.3g M, max |dh|/peak %.3g, mismatch %.3g\n",
+	       c->version, c->m1, c->m2, c->spin1z, c->spin2z, nRK, nDP, dEpoch, maxDiff / peak, mismatch);
+
+	XLALDestroyREAL8TimeSeries(hpRK);
+	XLALDestroyREAL8TimeSeries(hcRK);
+	XLALDestroyREAL8TimeSeries(hpDP);
+	XLALDestroyREAL8TimeSeries(hcDP);
+
+	XLAL_CHECK(nRK <= nDP + 1 && nDP <= nRK + 1, XLAL_EFAILED, "version %u: lengths %zu and %zu differ by more than one sample", c->version, nRK, nDP);
+	XLAL_CHECK(fabs(dEpoch) <= c->epochTol, XLAL_EFAILED, "version %u: attachment times differ by %g M > %g M", c->version, dEpoch, c->epochTol);
+	XLAL_CHECK(maxDiff <= STRAIN_TOL * peak, XLAL_EFAILED, "version %u: max |dh|/peak = %g > %g", c->version, maxDiff / peak, STRAIN_TOL);
+	XLAL_CHECK(mismatch <= MISMATCH_TOL, XLAL_EFAILED, "version %u: mismatch %g > %g", c->version, mismatch, MISMATCH_TOL);
+	return 0;
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+		if (compare(&cases[i]) != 0)
+			return 1;
+	LALCheckMemoryLeaks();
+	return 0;
+}